@@ -79,6 +79,19 @@ UINT32 pdRequesterThreadNoCount = 0;			/* Counter which Create PD Requester Thre
 /* Thread Stack Size */
 const size_t    threadStackSize   = 256 * 1024;
 
+/* Real-time settings of the application threads and the TAULpdMainThread (command line -a -A -p -i -l) */
+VOS_THREAD_OPTIONS_T	appThreadOptions = {0};					/* Application threads affinity / memory options */
+VOS_THREAD_OPTIONS_T	taulThreadOptions = {0};				/* TAULpdMainThread affinity / memory options */
+VOS_THREAD_POLICY_T		rtThreadPolicy = VOS_THREAD_POLICY_OTHER;	/* Scheduling policy of all TAUL threads */
+VOS_THREAD_PRIORITY_T	rtThreadPriority = 0;					/* Scheduling priority of all TAUL threads */
+
+/* Interfaces of Subnet1 / Subnet2 watched by the link monitor (command line -n -N), empty: eth0 / eth1 */
+TRDP_LABEL_T			linkIfName1 = "";
+TRDP_LABEL_T			linkIfName2 = "";
+
+/* Both subnets update the Traffic Store, first arrival wins (command line -d) */
+BOOL8					dualSubnetReceive = FALSE;
+
 UINT32	sequenceCounter = 0;										/* MD Send Sequence Counter */
 
 
@@ -659,13 +672,14 @@ TAUL_APP_ERR_TYPE createPublisherThread (
 	publisherThreadNoCount++;
 
 	/*  Create Publisher Thread */
-	vos_err = vos_threadCreate(
+	vos_err = vos_threadCreateEx(
 				&pPublisherAppThreadHandle->applicationThreadHandle,					/* Pointer to returned thread handle */
 				publisherThreadName,						/* Pointer to name of the thread (optional) */
-				VOS_THREAD_POLICY_OTHER,					/* Scheduling policy (FIFO, Round Robin or other) */
-				0,											/* Scheduling priority (1...255 (highest), default 0) */
+				rtThreadPolicy,								/* Scheduling policy (FIFO, Round Robin or other) */
+				rtThreadPriority,							/* Scheduling priority (1...255 (highest), default 0) */
 				0,											/* Interval for cyclic threads in us (optional) */
 				threadStackSize,							/* Minimum stacksize, default 0: 16kB */
+				&appThreadOptions,							/* CPU affinity, memory locking, stack pre-fault */
 				(void *)PublisherApplication,			/* Pointer to the thread function */
 				(void *)pPublisherThreadParameter);	/* Pointer to the thread function parameters */
 	if (vos_err == VOS_NO_ERR)
@@ -783,8 +797,8 @@ TAUL_APP_ERR_TYPE PublisherApplication (PUBLISHER_THREAD_PARAMETER_T *pPublisher
 	/* Traffic Store */
 	extern			UINT8 *pTrafficStoreAddr;						/* pointer to pointer to Traffic Store Address */
 	UINT32			dstEnd = 0;
-	UINT32			trafficStoreWriteStartAddress = 0;
-	UINT32			workingWriteTrafficStoreStartAddress = 0;
+	uintptr_t		trafficStoreWriteStartAddress = 0;
+	uintptr_t		workingWriteTrafficStoreStartAddress = 0;
 	UINT8			modTrafficStore = 0;
 	UINT8			modWorkingWriteTrafficStore = 0;
 	UINT8			alignmentWorkingWriteTrafficStore = 0;
@@ -794,9 +808,9 @@ TAUL_APP_ERR_TYPE PublisherApplication (PUBLISHER_THREAD_PARAMETER_T *pPublisher
 	vos_printLog(VOS_LOG_DBG, "%s PD Publisher Start.\n", vos_getTimeStamp());
 
 	/* Get Write start Address in Traffic Store */
-	trafficStoreWriteStartAddress = (UINT32)(pTrafficStoreAddr + pPublisherThreadParameter->pPublishTelegram->pPdParameter->offset);
+	trafficStoreWriteStartAddress = (uintptr_t)(pTrafficStoreAddr + pPublisherThreadParameter->pPublishTelegram->pPdParameter->offset);
 	/* Get alignment */
-	modTrafficStore = trafficStoreWriteStartAddress % 16;
+	modTrafficStore = (UINT8)(trafficStoreWriteStartAddress % 16u);
 	/* Get write Traffic store working memory area for alignment */
 	pWorkingWirteTrafficStore = (UINT8*)vos_memAlloc(pPublisherThreadParameter->pPublishTelegram->dataset.size + 16);
 	if (pWorkingWirteTrafficStore == NULL)
@@ -810,9 +824,9 @@ TAUL_APP_ERR_TYPE PublisherApplication (PUBLISHER_THREAD_PARAMETER_T *pPublisher
 		memset(pWorkingWirteTrafficStore, 0, pPublisherThreadParameter->pPublishTelegram->dataset.size + 16);
 	}
 	/* Get Working Write start Address in Traffic Store */
-	workingWriteTrafficStoreStartAddress = (UINT32)pWorkingWirteTrafficStore;
+	workingWriteTrafficStoreStartAddress = (uintptr_t)pWorkingWirteTrafficStore;
 	/* Get alignment */
-	modWorkingWriteTrafficStore = workingWriteTrafficStoreStartAddress % 16;
+	modWorkingWriteTrafficStore = (UINT8)(workingWriteTrafficStoreStartAddress % 16u);
 	vos_printLog(VOS_LOG_DBG, "modTraffic: %u modWork: %u \n", modTrafficStore, modWorkingWriteTrafficStore);
 	/* Check alignment */
 	if (modTrafficStore >= modWorkingWriteTrafficStore)
@@ -873,27 +887,18 @@ TAUL_APP_ERR_TYPE PublisherApplication (PUBLISHER_THREAD_PARAMETER_T *pPublisher
 			vos_printLog(VOS_LOG_ERROR, "Publisher Application Create Dataset Failed. createDataset() Error: %d\n", err);
 		}
 
-		/* Get access right to Traffic Store*/
-		err = tau_ldLockTrafficStore();
+		/* Set PD Data in Traffic Store */
+		err = tau_ldWriteTrafficStore(pPublisherThreadParameter->pPublishTelegram->pPdParameter->offset,
+				pPublisherThreadParameter->pPublishTelegram->dataset.pDatasetStartAddr,
+				pPublisherThreadParameter->pPublishTelegram->dataset.size);
 		if (err == TRDP_NO_ERR)
 		{
-			/* Set PD Data in Traffic Store */
-			memcpy((void *)((int)pTrafficStoreAddr + pPublisherThreadParameter->pPublishTelegram->pPdParameter->offset),
-					pPublisherThreadParameter->pPublishTelegram->dataset.pDatasetStartAddr,
-					pPublisherThreadParameter->pPublishTelegram->dataset.size);
 			/* put count up */
 			requestCounter++;
-
-			/* Release access right to Traffic Store*/
-			err = tau_ldUnlockTrafficStore();
-			if (err != TRDP_NO_ERR)
-			{
-				vos_printLog(VOS_LOG_ERROR, "Release Traffic Store accessibility Failed\n");
-			}
 		}
 		else
 		{
-			vos_printLog(VOS_LOG_ERROR, "Get Traffic Store accessibility Failed\n");
+			vos_printLog(VOS_LOG_ERROR, "Write Traffic Store Failed\n");
 		}
 		/* Waits for a next creation cycle */
 		vos_threadDelay(pPublisherThreadParameter->pPdAppParameter->pdAppCycleTime);
@@ -950,13 +955,14 @@ TAUL_APP_ERR_TYPE createSubscriberThread (
 	subscriberThreadNoCount++;
 
 	/*  Create Subscriber Thread */
-	vos_err = vos_threadCreate(
+	vos_err = vos_threadCreateEx(
 				&pSubscriberAppThreadHandle->applicationThreadHandle,					/* Pointer to returned thread handle */
 				subscriberThreadName,					/* Pointer to name of the thread (optional) */
-				VOS_THREAD_POLICY_OTHER,					/* Scheduling policy (FIFO, Round Robin or other) */
-				0,											/* Scheduling priority (1...255 (highest), default 0) */
+				rtThreadPolicy,								/* Scheduling policy (FIFO, Round Robin or other) */
+				rtThreadPriority,							/* Scheduling priority (1...255 (highest), default 0) */
 				0,											/* Interval for cyclic threads in us (optional) */
 				threadStackSize,							/* Minimum stacksize, default 0: 16kB */
+				&appThreadOptions,							/* CPU affinity, memory locking, stack pre-fault */
 				(void *)SubscriberApplication,			/* Pointer to the thread function */
 				(void *)pSubscriberThreadParameter);	/* Pointer to the thread function parameters */
 	if (vos_err == VOS_NO_ERR)
@@ -1029,25 +1035,14 @@ TAUL_APP_ERR_TYPE SubscriberApplication (SUBSCRIBER_THREAD_PARAMETER_T *pSubscri
 			}
 		}
 
-		/* Get access right to Traffic Store*/
-    	err = tau_ldLockTrafficStore();
-    	if (err == TRDP_NO_ERR)
-    	{
-			/* Get Receive PD DataSet from Traffic Store */
-    		memcpy(pSubscriberThreadParameter->pSubscribeTelegram->dataset.pDatasetStartAddr,
-    				(void *)((int)pTrafficStoreAddr + pSubscriberThreadParameter->pSubscribeTelegram->pPdParameter->offset),
-    				pSubscriberThreadParameter->pSubscribeTelegram->dataset.size);
-			/* Release access right to Traffic Store*/
-			err = tau_ldUnlockTrafficStore();
-			if (err != TRDP_NO_ERR)
-			{
-				vos_printLog(VOS_LOG_ERROR, "Release Traffic Store accessibility Failed\n");
-			}
-    	}
-    	else
-    	{
-    		vos_printLog(VOS_LOG_ERROR, "Get Traffic Store accessibility Failed\n");
-    	}
+		/* Get Receive PD DataSet from Traffic Store */
+		err = tau_ldReadTrafficStore(pSubscriberThreadParameter->pSubscribeTelegram->pPdParameter->offset,
+				pSubscriberThreadParameter->pSubscribeTelegram->dataset.pDatasetStartAddr,
+				pSubscriberThreadParameter->pSubscribeTelegram->dataset.size);
+		if (err != TRDP_NO_ERR)
+		{
+			vos_printLog(VOS_LOG_ERROR, "Read Traffic Store Failed\n");
+		}
 
 		/* Waits for a next to Traffic Store put/get cycle */
 		vos_threadDelay(pSubscriberThreadParameter->pPdAppParameter->pdAppCycleTime);
@@ -1110,13 +1105,14 @@ TAUL_APP_ERR_TYPE createPdRequesterThread (
 	pdRequesterThreadNoCount++;
 
 	/*  Create Subscriber Thread */
-	vos_err = vos_threadCreate(
+	vos_err = vos_threadCreateEx(
 				&pPdRequesterAppThreadHandle->applicationThreadHandle,					/* Pointer to returned thread handle */
 				pdRequesterThreadName,					/* Pointer to name of the thread (optional) */
-				VOS_THREAD_POLICY_OTHER,					/* Scheduling policy (FIFO, Round Robin or other) */
-				0,											/* Scheduling priority (1...255 (highest), default 0) */
+				rtThreadPolicy,								/* Scheduling policy (FIFO, Round Robin or other) */
+				rtThreadPriority,							/* Scheduling priority (1...255 (highest), default 0) */
 				0,											/* Interval for cyclic threads in us (optional) */
 				threadStackSize,							/* Minimum stacksize, default 0: 16kB */
+				&appThreadOptions,							/* CPU affinity, memory locking, stack pre-fault */
 				(void *)PdRequesterApplication,			/* Pointer to the thread function */
 				(void *)pPdRequesterThreadParameter);	/* Pointer to the thread function parameters */
 	if (vos_err == VOS_NO_ERR)
@@ -1204,28 +1200,19 @@ TAUL_APP_ERR_TYPE PdRequesterApplication (PD_REQUESTER_THREAD_PARAMETER_T *pPdRe
 			vos_printLog(VOS_LOG_ERROR, "PD Requester Application Create Dataset Failed. createDataset() Error: %d\n", err);
 		}
 
-		/* Get access right to Traffic Store*/
-    	err = tau_lockTrafficStore();
-    	if (err == TRDP_NO_ERR)
-    	{
-    		/* Set PD Data in Traffic Store */
-			memcpy((void *)((int)pTrafficStoreAddr + pPdRequesterThreadParameter->pPdRequestTelegram->pPdParameter->offset),
-					pPdRequesterThreadParameter->pPdRequestTelegram->dataset.pDatasetStartAddr,
-					pPdRequesterThreadParameter->pPdRequestTelegram->dataset.size);
+		/* Set PD Data in Traffic Store */
+		err = tau_ldWriteTrafficStore(pPdRequesterThreadParameter->pPdRequestTelegram->pPdParameter->offset,
+				pPdRequesterThreadParameter->pPdRequestTelegram->dataset.pDatasetStartAddr,
+				pPdRequesterThreadParameter->pPdRequestTelegram->dataset.size);
+		if (err == TRDP_NO_ERR)
+		{
 			/* request count up */
 			requestCounter++;
-
-          	/* Release access right to Traffic Store*/
-    		err = tau_unlockTrafficStore();
-    		if (err != TRDP_NO_ERR)
-    		{
-    			vos_printLog(VOS_LOG_ERROR, "Release Traffic Store accessibility Failed\n");
-    		}
-    	}
-    	else
-    	{
-    		vos_printLog(VOS_LOG_ERROR, "Get Traffic Store accessibility Failed\n");
-    	}
+		}
+		else
+		{
+			vos_printLog(VOS_LOG_ERROR, "Write Traffic Store Failed\n");
+		}
 
     	/* Waits for a next creation cycle */
 		vos_threadDelay(pPdRequesterThreadParameter->pPdAppParameter->pdAppCycleTime);
@@ -1557,6 +1544,12 @@ TAUL_APP_ERR_TYPE initTaulApp (
 
 	/* Set Ladder Config */
 	ladderConfig.ownIpAddr = ownIpAddress;
+	ladderConfig.mainThreadPolicy = rtThreadPolicy;
+	ladderConfig.mainThreadPriority = rtThreadPriority;
+	ladderConfig.mainThreadOptions = taulThreadOptions;
+	vos_strncpy(ladderConfig.linkIfName1, linkIfName1, sizeof(TRDP_LABEL_T) - 1);
+	vos_strncpy(ladderConfig.linkIfName2, linkIfName2, sizeof(TRDP_LABEL_T) - 1);
+	ladderConfig.dualSubnetReceive = dualSubnetReceive;
 
 	/* Initialize TAUL */
 	err = tau_ldInit(dbgOut, &ladderConfig);
@@ -1786,6 +1779,69 @@ TAUL_APP_ERR_TYPE initTaulApp (
 int main (INT32 argc, CHAR8 *argv[])
 {
 	TAUL_APP_ERR_TYPE								err = TRDP_NO_ERR;
+	INT32											ch;
+	UINT32											uint32_value = 0;
+
+	/* Real-time options: pin application threads (-a) and TAULpdMainThread (-A) to cores, FIFO priority (-p),
+	   keep other threads off those cores (-i), lock memory and pre-fault thread stacks (-l),
+	   interfaces of the link monitor (-n -N), receive on both subnets (-d) */
+	while ((ch = getopt(argc, argv, "a:A:p:iln:N:dh?")) != -1)
+	{
+		switch (ch)
+		{
+		case 'a':
+			if (sscanf(optarg, "%x", &uint32_value) == 1)
+			{
+				appThreadOptions.cpuMask = uint32_value;
+			}
+			break;
+		case 'A':
+			if (sscanf(optarg, "%x", &uint32_value) == 1)
+			{
+				taulThreadOptions.cpuMask = uint32_value;
+			}
+			break;
+		case 'p':
+			if (sscanf(optarg, "%u", &uint32_value) == 1)
+			{
+				rtThreadPolicy = VOS_THREAD_POLICY_FIFO;
+				rtThreadPriority = (VOS_THREAD_PRIORITY_T)uint32_value;
+			}
+			break;
+		case 'i':
+			appThreadOptions.flags |= VOS_THREAD_OPT_ISOLATE;
+			taulThreadOptions.flags |= VOS_THREAD_OPT_ISOLATE;
+			break;
+		case 'l':
+			appThreadOptions.flags |= VOS_THREAD_OPT_LOCK_MEMORY;
+			taulThreadOptions.flags |= VOS_THREAD_OPT_LOCK_MEMORY;
+			appThreadOptions.stackPrefault = (UINT32)threadStackSize / 2u;
+			taulThreadOptions.stackPrefault = 64u * 1024u;
+			break;
+		case 'n':
+			vos_strncpy(linkIfName1, optarg, sizeof(TRDP_LABEL_T) - 1);
+			break;
+		case 'N':
+			vos_strncpy(linkIfName2, optarg, sizeof(TRDP_LABEL_T) - 1);
+			break;
+		case 'd':
+			dualSubnetReceive = TRUE;
+			break;
+		case 'h':
+		case '?':
+		default:
+			printf("Usage: %s [-a cpuMask] [-A cpuMask] [-p priority] [-i] [-l] [-n ifName] [-N ifName] [-d]\n", argv[0]);
+			printf("-a	application threads CPU mask (hex)\n");
+			printf("-A	TAULpdMainThread CPU mask (hex)\n");
+			printf("-p	SCHED_FIFO priority of the TAUL threads\n");
+			printf("-i	isolate: keep all other threads off these cores\n");
+			printf("-l	lock memory and pre-fault thread stacks\n");
+			printf("-n	Subnet1 interface watched for link loss (default eth0)\n");
+			printf("-N	Subnet2 interface watched for link loss (default eth1)\n");
+			printf("-d	receive on both subnets, first arrival updates the Traffic Store\n");
+			return 1;
+		}
+	}
 
 	/* Taul Application Init */
 	err = initTaulApp();
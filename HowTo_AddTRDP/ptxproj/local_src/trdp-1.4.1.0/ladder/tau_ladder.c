@@ -33,6 +33,16 @@
 #include <net/if.h>
 #endif
 #include <unistd.h>
+#ifdef __linux
+#   include <poll.h>
+#   include <limits.h>
+#   include <time.h>
+#   include <sys/socket.h>
+#   include <sys/syscall.h>
+#   include <linux/futex.h>
+#   include <linux/netlink.h>
+#   include <linux/rtnetlink.h>
+#endif
 
 #include "trdp_utils.h"
 #include "trdp_if.h"
@@ -46,14 +56,45 @@
  * DEFINES
  */
 
+/* Traffic Store sequence locks, shared with other processes mapping the Traffic Store */
+#define TAU_TS_LOAD(pSeq, order)        __atomic_load_n((pSeq), (order))
+#define TAU_TS_CAS(pSeq, pOld, new)     __atomic_compare_exchange_n((pSeq), (pOld), (new), 0, \
+                                                                    __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)
+#define TAU_TS_END(pSeq)                (void) __atomic_add_fetch((pSeq), 1u, __ATOMIC_RELEASE)
+#define TAU_TS_FENCE(order)             __atomic_thread_fence(order)
+#define TAU_TS_SPIN_LIMIT               64u         /* busy retries before the CPU is yielded */
+#define TAU_TS_POLL_INTERVAL            1000u       /* us, tau_waitTrafficStore() without futex */
+
+/* Link monitor */
+#define TAU_LINK_MSG_SIZE               8192u       /* rtnetlink receive buffer */
+#define TAU_LINK_POLL_TIMEOUT           100         /* ms, upper bound for stopping the monitor thread */
+
 /*******************************************************************************
  * TYPEDEFS
  */
 
+/* Change notification area behind the group map, the counters are futex words shared between processes */
+typedef struct
+{
+    UINT32  count[TRAFFIC_STORE_NOTIFY_GROUPS];     /* incremented by every write to a telegram of the group */
+    UINT32  waiters[TRAFFIC_STORE_NOTIFY_GROUPS];   /* consumers sleeping on count[] */
+    UINT32  countAll;                               /* incremented by every write */
+    UINT32  waitersAll;                             /* consumers of several groups, sleeping on countAll */
+} TAU_TS_NOTIFY_AREA_T;
+
 /******************************************************************************
  *   Locals
  */
 
+/* Link check */
+static int ifGetSocket = 0;                                 /* ioctl socket for SIOCGIFFLAGS */
+static CHAR8 linkIfName[2][IFNAMSIZ] = {"eth0", "eth1"};    /* interface of Subnet1, Subnet2 */
+static volatile BOOL8 linkUp[2] = {TRUE, TRUE};             /* link state pushed by the link monitor */
+static volatile BOOL8 linkMonitorRun = FALSE;               /* link monitor thread shall run */
+static volatile BOOL8 linkMonitorActive = FALSE;            /* link monitor delivers the link state */
+static BOOL8 linkDownEvent = FALSE;                         /* link lost, not yet taken by the PD main thread */
+static int linkMonitorSocket = -1;                          /* rtnetlink socket of the link monitor */
+
 /******************************************************************************
  *   Globals
  */
@@ -67,7 +108,8 @@ CHAR8 TRAFFIC_STORE[] = "/ladder_ts";                    /* Traffic Store shared
 mode_t PERMISSION     = 0666;                                /* Traffic Store permission is rw-rw-rw- */
 UINT8 *pTrafficStoreAddr;                                /* pointer to pointer to Traffic Store Address */
 VOS_SHRD_T  pTrafficStoreHandle;                        /* Pointer to Traffic Store Handle */
-UINT16 TRAFFIC_STORE_MUTEX_VALUE_AREA = 0xFF00;        /* Traffic Store mutex ID Area */
+UINT32 trafficStoreSize = TRAFFIC_STORE_SIZE;            /* Traffic Store Size (telegram data) */
+UINT32 TRAFFIC_STORE_MUTEX_VALUE_AREA = 0xFF00;        /* Traffic Store mutex ID Area */
 
 /* PDComLadderThread */
 //CHAR8 pdComLadderThreadName[] ="PDComLadderThread";        /* Thread name is PDComLadder Thread. */
@@ -92,7 +134,7 @@ TRDP_ERR_T tau_ladder_init (void)
     extern CHAR8 TRAFFIC_STORE[];                    /* Traffic Store shared memory name */
     extern VOS_SHRD_T  pTrafficStoreHandle;                /* Pointer to Traffic Store Handle */
     extern UINT8 *pTrafficStoreAddr;                /* pointer to pointer to Traffic Store Address */
-    UINT32 trafficStoreSize = TRAFFIC_STORE_SIZE;    /* Traffic Store Size : 64KB */
+    UINT32 trafficStoreSharedSize = TRAFFIC_STORE_SHARED_SIZE(trafficStoreSize);    /* Traffic Store and sequence locks */
 
 #if 0
     /* PDComLadderThread */
@@ -156,10 +198,11 @@ TRDP_ERR_T tau_ladder_init (void)
     }
 
     /* Create the Traffic Store */
-    vosErr = vos_sharedOpen(TRAFFIC_STORE, &pTrafficStoreHandle, &pTrafficStoreAddr, &trafficStoreSize);
+    vosErr = vos_sharedOpen(TRAFFIC_STORE, &pTrafficStoreHandle, &pTrafficStoreAddr, &trafficStoreSharedSize);
     if (vosErr != VOS_NO_ERR)
     {
         vos_printLog(VOS_LOG_ERROR, "TRDP Traffic Store Create failed. VOS Error: %d\n", vosErr);
+        pTrafficStoreAddr = NULL;
         ret = TRDP_MEM_ERR;
         return ret;
     }
@@ -177,7 +220,7 @@ TRDP_ERR_T tau_ladder_init (void)
     }
 */
     /* Set Traffic Store Semaphore Value */
-    memcpy((void *)((int)pTrafficStoreAddr + TRAFFIC_STORE_MUTEX_VALUE_AREA),
+    memcpy((void *)(pTrafficStoreAddr + TRAFFIC_STORE_MUTEX_VALUE_AREA),
             &pTrafficStoreMutex->mutexId,
             sizeof(pTrafficStoreMutex->mutexId));
 
@@ -236,6 +279,7 @@ TRDP_ERR_T tau_ladder_terminate (void)
         vos_printLog(VOS_LOG_ERROR, "Release Traffic Store shared memory failed\n");
         err = TRDP_MEM_ERR;
     }
+    pTrafficStoreAddr = NULL;
     tau_unlockTrafficStore();
 
     /* Delete Traffic Store Mutex */
@@ -244,6 +288,33 @@ TRDP_ERR_T tau_ladder_terminate (void)
     return err;
 }
 
+/******************************************************************************/
+/** Set the Traffic Store size, before tau_ladder_init().
+ *
+ *  @param[in]      size                Traffic Store size in bytes
+ *
+ *    @retval            TRDP_NO_ERR
+ *    @retval            TRDP_PARAM_ERR
+ *    @retval            TRDP_STATE_ERR
+ */
+TRDP_ERR_T tau_setTrafficStoreSize (
+    UINT32 size)
+{
+    if ((size < TRAFFIC_STORE_SIZE)
+        || (size > TRAFFIC_STORE_MAX_SIZE)
+        || ((size % TRAFFIC_STORE_SEQLOCK_GRANULE) != 0u))
+    {
+        vos_printLog(VOS_LOG_ERROR, "Traffic Store size %u out of range\n", size);
+        return TRDP_PARAM_ERR;
+    }
+    if (pTrafficStoreAddr != NULL)
+    {
+        return TRDP_STATE_ERR;
+    }
+    trafficStoreSize = size;
+    return TRDP_NO_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Set pdComLadderThreadStartFlag.
  *
@@ -358,52 +429,487 @@ TRDP_ERR_T  tau_unlockTrafficStore (
 }
 
 /**********************************************************************************************************************/
-/** Check Link up/down
+/** Get the sequence lock guarding a Traffic Store offset.
  *
- *  @param[in]        checkSubnetId            check Sub-network Id
- *  @param[out]        pLinkUpDown          pointer to check Sub-network Id Link Up Down TRUE:Up, FALSE:Down
+ *  @param[in]      offset              Traffic Store offset
  *
- *  @retval         TRDP_NO_ERR                no error
- *  @retval         TRDP_PARAM_ERR            parameter err
- *  @retval         TRDP_SOCK_ERR            socket err
+ *  @retval         pointer to the sequence lock in the shared Traffic Store
+ */
+static UINT32 *tau_getTrafficStoreSeqLock (
+    UINT32 offset)
+{
+    return (UINT32 *)(pTrafficStoreAddr + trafficStoreSize) + offset / TRAFFIC_STORE_SEQLOCK_GRANULE;
+}
+
+/**********************************************************************************************************************/
+/** Get the notification group map, one group number per sequence lock.
  *
+ *  @retval         pointer to the group map in the shared Traffic Store
+ */
+static UINT8 *tau_getTrafficStoreGroupMap (void)
+{
+    return (UINT8 *)tau_getTrafficStoreSeqLock(trafficStoreSize);
+}
+
+/**********************************************************************************************************************/
+/** Get the change notification area.
  *
+ *  @retval         pointer to the notification area in the shared Traffic Store
  */
-static int ifGetSocket = 0;
+static TAU_TS_NOTIFY_AREA_T *tau_getTrafficStoreNotifyArea (void)
+{
+    return (TAU_TS_NOTIFY_AREA_T *)(tau_getTrafficStoreGroupMap() + TRAFFIC_STORE_GROUP_MAP_SIZE(trafficStoreSize));
+}
 
-TRDP_ERR_T  tau_checkLinkUpDown (
-    UINT32 checkSubnetId,
-    BOOL8 *pLinkUpDown)
+/**********************************************************************************************************************/
+/** Sleep until a change counter differs from the given value, a wake up or the timeout.
+ *
+ *  @param[in]      pCount              change counter in the shared Traffic Store
+ *  @param[in]      count               value seen by the caller
+ *  @param[in]      timeout             timeout in us or TRAFFIC_STORE_WAIT_FOREVER
+ */
+static void tau_sleepTrafficStore (
+    UINT32  *pCount,
+    UINT32  count,
+    UINT32  timeout)
 {
-    struct ifreq ifRead;
-    CHAR8 SUBNETWORK_ID1_IF_NAME[] = "eth0";
-    CHAR8 SUBNETWORK_ID2_IF_NAME[] = "eth1";
+#ifdef __linux
+    struct timespec waitTime;
 
-    /* Parameter Check */
-    if (pLinkUpDown == NULL)
+    waitTime.tv_sec     = (time_t)(timeout / 1000000u);
+    waitTime.tv_nsec    = (long)(timeout % 1000000u) * 1000;
+    (void) syscall(SYS_futex, pCount, FUTEX_WAIT, count,
+                   (timeout == TRAFFIC_STORE_WAIT_FOREVER) ? NULL : &waitTime, NULL, 0);
+#else
+    (void) pCount;
+    (void) count;
+    (void) vos_threadDelay((timeout < TAU_TS_POLL_INTERVAL) ? timeout : TAU_TS_POLL_INTERVAL);
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Wake all consumers sleeping on a change counter.
+ *
+ *  @param[in]      pCount              change counter in the shared Traffic Store
+ */
+static void tau_wakeTrafficStore (
+    UINT32 *pCount)
+{
+#ifdef __linux
+    (void) syscall(SYS_futex, pCount, FUTEX_WAKE, INT_MAX, NULL, NULL, 0);
+#else
+    (void) pCount;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Count a write of a telegram and wake the consumers of its group.
+ *  The system call is made only if a consumer sleeps.
+ *
+ *  @param[in]      offset              Traffic Store offset of the telegram
+ */
+static void tau_notifyTrafficStore (
+    UINT32 offset)
+{
+    TAU_TS_NOTIFY_AREA_T    *pArea  = tau_getTrafficStoreNotifyArea();
+    UINT32                  group   = tau_getTrafficStoreGroupMap()[offset / TRAFFIC_STORE_SEQLOCK_GRANULE];
+
+    if (group >= TRAFFIC_STORE_NOTIFY_GROUPS)
+    {
+        group = 0u;
+    }
+    /* Sequentially consistent: either the waiter sees the new count or the writer sees the waiter */
+    (void) __atomic_add_fetch(&pArea->count[group], 1u, __ATOMIC_SEQ_CST);
+    (void) __atomic_add_fetch(&pArea->countAll, 1u, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&pArea->waiters[group], __ATOMIC_SEQ_CST) != 0u)
+    {
+        tau_wakeTrafficStore(&pArea->count[group]);
+    }
+    if (__atomic_load_n(&pArea->waitersAll, __ATOMIC_SEQ_CST) != 0u)
+    {
+        tau_wakeTrafficStore(&pArea->countAll);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Back off while a telegram is written by another thread or process.
+ *
+ *  @param[in,out]  pSpin               retry counter of the caller
+ */
+static void tau_backOffTrafficStore (
+    UINT32 *pSpin)
+{
+    if (++(*pSpin) >= TAU_TS_SPIN_LIMIT)
+    {
+        *pSpin = 0u;
+        (void) vos_threadDelay(0u);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Start writing a telegram in the Traffic Store.
+ *
+ *  @param[in]      offset              Traffic Store offset of the telegram
+ *
+ *  @retval         TRDP_NO_ERR            no error
+ *  @retval         TRDP_NOINIT_ERR        Traffic Store not created
+ */
+TRDP_ERR_T  tau_beginWriteTrafficStore (
+    UINT32 offset)
+{
+    UINT32  *pSeq;
+    UINT32  seq;
+    UINT32  spin = 0u;
+
+    if (pTrafficStoreAddr == NULL)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if (offset >= trafficStoreSize)
     {
-        vos_printLog(VOS_LOG_ERROR, "tau_checkLinkUpDown pLinkUpDown parameter err\n");
         return TRDP_PARAM_ERR;
     }
+    pSeq = tau_getTrafficStoreSeqLock(offset);
 
-    memset(&ifRead, 0, sizeof(ifRead));
+    /* An odd sequence marks a write in progress, telegrams sharing a lock are written one after the other */
+    for (;;)
+    {
+        seq = TAU_TS_LOAD(pSeq, __ATOMIC_RELAXED);
+        if (((seq & 1u) == 0u) && TAU_TS_CAS(pSeq, &seq, seq + 1u))
+        {
+            break;
+        }
+        tau_backOffTrafficStore(&spin);
+    }
+    /* The odd sequence must be visible before any data is changed */
+    TAU_TS_FENCE(__ATOMIC_RELEASE);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Finish writing a telegram in the Traffic Store.
+ *
+ *  @param[in]      offset              Traffic Store offset given to tau_beginWriteTrafficStore()
+ *
+ *  @retval         TRDP_NO_ERR            no error
+ *  @retval         TRDP_NOINIT_ERR        Traffic Store not created
+ */
+TRDP_ERR_T  tau_endWriteTrafficStore (
+    UINT32 offset)
+{
+    if (pTrafficStoreAddr == NULL)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if (offset >= trafficStoreSize)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    TAU_TS_END(tau_getTrafficStoreSeqLock(offset));
+    tau_notifyTrafficStore(offset);
+    return TRDP_NO_ERR;
+}
 
-    /* Check I/F setting */
-    if (checkSubnetId == SUBNET1)
+/**********************************************************************************************************************/
+/** Copy a telegram into the Traffic Store under its sequence lock.
+ *
+ *  @param[in]      offset              Traffic Store offset of the telegram
+ *  @param[in]      pData               pointer to the telegram data
+ *  @param[in]      dataSize            size of the telegram data
+ *
+ *  @retval         TRDP_NO_ERR            no error
+ *  @retval         TRDP_PARAM_ERR         parameter error
+ *  @retval         TRDP_NOINIT_ERR        Traffic Store not created
+ */
+TRDP_ERR_T  tau_writeTrafficStore (
+    UINT32      offset,
+    const UINT8 *pData,
+    UINT32      dataSize)
+{
+    TRDP_ERR_T err;
+
+    if ((pData == NULL) || (offset >= trafficStoreSize) || (dataSize > trafficStoreSize - offset))
     {
-        /* Set I/F subnet1 */
-        strncpy(ifRead.ifr_name, SUBNETWORK_ID1_IF_NAME, IFNAMSIZ-1);
+        return TRDP_PARAM_ERR;
     }
-    else if (checkSubnetId == SUBNET2)
+    err = tau_beginWriteTrafficStore(offset);
+    if (err != TRDP_NO_ERR)
     {
-        /* Set I/F subnet2 */
-        strncpy(ifRead.ifr_name, SUBNETWORK_ID2_IF_NAME, IFNAMSIZ-1);
+        return err;
     }
-    else
+    memcpy(pTrafficStoreAddr + offset, pData, dataSize);
+    return tau_endWriteTrafficStore(offset);
+}
+
+/**********************************************************************************************************************/
+/** Copy a consistent snapshot of a telegram out of the Traffic Store.
+ *
+ *  @param[in]      offset              Traffic Store offset of the telegram
+ *  @param[out]     pData               pointer to the destination buffer
+ *  @param[in]      dataSize            number of bytes to copy
+ *
+ *  @retval         TRDP_NO_ERR            no error
+ *  @retval         TRDP_PARAM_ERR         parameter error
+ *  @retval         TRDP_NOINIT_ERR        Traffic Store not created
+ */
+TRDP_ERR_T  tau_readTrafficStore (
+    UINT32  offset,
+    UINT8   *pData,
+    UINT32  dataSize)
+{
+    UINT32  *pSeq;
+    UINT32  seqBefore;
+    UINT32  spin = 0u;
+
+    if ((pData == NULL) || (offset >= trafficStoreSize) || (dataSize > trafficStoreSize - offset))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (pTrafficStoreAddr == NULL)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    pSeq = tau_getTrafficStoreSeqLock(offset);
+
+    for (;;)
+    {
+        seqBefore = TAU_TS_LOAD(pSeq, __ATOMIC_ACQUIRE);
+        if ((seqBefore & 1u) == 0u)
+        {
+            memcpy(pData, pTrafficStoreAddr + offset, dataSize);
+            /* The copy must be complete before the sequence is checked again */
+            TAU_TS_FENCE(__ATOMIC_ACQUIRE);
+            if (TAU_TS_LOAD(pSeq, __ATOMIC_RELAXED) == seqBefore)
+            {
+                return TRDP_NO_ERR;
+            }
+        }
+        tau_backOffTrafficStore(&spin);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Get the update counter of a telegram.
+ *
+ *  @param[in]      offset              Traffic Store offset of the telegram
+ *  @param[out]     pCount              update counter
+ *
+ *  @retval         TRDP_NO_ERR            no error
+ *  @retval         TRDP_PARAM_ERR         parameter error
+ *  @retval         TRDP_NOINIT_ERR        Traffic Store not created
+ */
+TRDP_ERR_T  tau_getTrafficStoreUpdateCount (
+    UINT32  offset,
+    UINT32  *pCount)
+{
+    if ((pCount == NULL) || (offset >= trafficStoreSize))
     {
-        vos_printLog(VOS_LOG_ERROR, "tau_checkLinkUpDown Check SubnetId failed\n");
         return TRDP_PARAM_ERR;
     }
+    if (pTrafficStoreAddr == NULL)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    /* Two sequence steps per write */
+    *pCount = TAU_TS_LOAD(tau_getTrafficStoreSeqLock(offset), __ATOMIC_ACQUIRE) >> 1;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Assign Traffic Store telegrams to a change notification group.
+ *
+ *  @param[in]      offset              Traffic Store offset of the telegram
+ *  @param[in]      dataSize            size of the telegram data
+ *  @param[in]      group               group number 0 .. TRAFFIC_STORE_NOTIFY_GROUPS - 1
+ *
+ *  @retval         TRDP_NO_ERR            no error
+ *  @retval         TRDP_PARAM_ERR         parameter error
+ *  @retval         TRDP_NOINIT_ERR        Traffic Store not created
+ */
+TRDP_ERR_T  tau_setTrafficStoreNotifyGroup (
+    UINT32  offset,
+    UINT32  dataSize,
+    UINT32  group)
+{
+    UINT32 first;
+    UINT32 last;
+
+    if ((group >= TRAFFIC_STORE_NOTIFY_GROUPS) || (dataSize == 0u)
+        || (offset >= trafficStoreSize) || (dataSize > trafficStoreSize - offset))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (pTrafficStoreAddr == NULL)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    first   = offset / TRAFFIC_STORE_SEQLOCK_GRANULE;
+    last    = (offset + dataSize - 1u) / TRAFFIC_STORE_SEQLOCK_GRANULE;
+    memset(tau_getTrafficStoreGroupMap() + first, (int)group, last - first + 1u);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Take the current change counters of all notification groups.
+ *
+ *  @param[out]     pNotify             change counters of the consumer
+ *
+ *  @retval         TRDP_NO_ERR            no error
+ *  @retval         TRDP_PARAM_ERR         parameter error
+ *  @retval         TRDP_NOINIT_ERR        Traffic Store not created
+ */
+TRDP_ERR_T  tau_initTrafficStoreNotify (
+    TRAFFIC_STORE_NOTIFY_T *pNotify)
+{
+    TAU_TS_NOTIFY_AREA_T    *pArea;
+    UINT32                  group;
+
+    if (pNotify == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (pTrafficStoreAddr == NULL)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    pArea = tau_getTrafficStoreNotifyArea();
+    for (group = 0u; group < TRAFFIC_STORE_NOTIFY_GROUPS; group++)
+    {
+        pNotify->count[group] = __atomic_load_n(&pArea->count[group], __ATOMIC_ACQUIRE);
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Wait until a telegram of the selected notification groups has been written.
+ *  A single group is waited for on its own change counter, several groups on the counter of all groups.
+ *
+ *  @param[in,out]  pNotify             change counters of the consumer, updated for the changed groups
+ *  @param[in]      groupMask           bit n selects group n
+ *  @param[in]      timeout             timeout in us or TRAFFIC_STORE_WAIT_FOREVER
+ *  @param[out]     pChangedMask        changed groups of groupMask, may be NULL
+ *
+ *  @retval         TRDP_NO_ERR            no error
+ *  @retval         TRDP_TIMEOUT_ERR       no change within timeout
+ *  @retval         TRDP_PARAM_ERR         parameter error
+ *  @retval         TRDP_NOINIT_ERR        Traffic Store not created
+ */
+TRDP_ERR_T  tau_waitTrafficStore (
+    TRAFFIC_STORE_NOTIFY_T  *pNotify,
+    UINT32                  groupMask,
+    UINT32                  timeout,
+    UINT32                  *pChangedMask)
+{
+    TAU_TS_NOTIFY_AREA_T    *pArea;
+    UINT32                  *pCount;
+    UINT32                  *pWaiters;
+    UINT32                  count;
+    UINT32                  changedMask;
+    UINT32                  group;
+    UINT32                  remaining = timeout;
+    VOS_TIMEVAL_T           start;
+    VOS_TIMEVAL_T           now;
+
+    if ((pNotify == NULL) || (groupMask == 0u))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (pTrafficStoreAddr == NULL)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    pArea = tau_getTrafficStoreNotifyArea();
+
+    /* Sleep on the group itself if only one is selected */
+    if ((groupMask & (groupMask - 1u)) == 0u)
+    {
+        group       = (UINT32) __builtin_ctz(groupMask);
+        pCount      = &pArea->count[group];
+        pWaiters    = &pArea->waiters[group];
+    }
+    else
+    {
+        pCount      = &pArea->countAll;
+        pWaiters    = &pArea->waitersAll;
+    }
+
+    vos_getTime(&start);
+    for (;;)
+    {
+        count       = __atomic_load_n(pCount, __ATOMIC_SEQ_CST);
+        changedMask = 0u;
+        for (group = 0u; group < TRAFFIC_STORE_NOTIFY_GROUPS; group++)
+        {
+            if (((groupMask & (1u << group)) != 0u)
+                && (__atomic_load_n(&pArea->count[group], __ATOMIC_ACQUIRE) != pNotify->count[group]))
+            {
+                pNotify->count[group] = __atomic_load_n(&pArea->count[group], __ATOMIC_ACQUIRE);
+                changedMask |= 1u << group;
+            }
+        }
+        if (changedMask != 0u)
+        {
+            if (pChangedMask != NULL)
+            {
+                *pChangedMask = changedMask;
+            }
+            return TRDP_NO_ERR;
+        }
+
+        if (timeout != TRAFFIC_STORE_WAIT_FOREVER)
+        {
+            vos_getTime(&now);
+            vos_subTime(&now, &start);
+            if (((UINT64)now.tv_sec * 1000000u + (UINT64)now.tv_usec) >= (UINT64)timeout)
+            {
+                return TRDP_TIMEOUT_ERR;
+            }
+            remaining = timeout - (UINT32)((UINT64)now.tv_sec * 1000000u + (UINT64)now.tv_usec);
+        }
+        (void) __atomic_add_fetch(pWaiters, 1u, __ATOMIC_SEQ_CST);
+        tau_sleepTrafficStore(pCount, count, remaining);
+        (void) __atomic_sub_fetch(pWaiters, 1u, __ATOMIC_SEQ_CST);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Get the interface name of a subnet.
+ *
+ *  @param[in]        subnetId            SUBNET1 or SUBNET2
+ *
+ *  @retval         index into linkIfName[] or -1 for an unknown subnet
+ */
+static INT32 tau_getLinkIndex (
+    UINT32 subnetId)
+{
+    if (subnetId == SUBNET1)
+    {
+        return 0;
+    }
+    else if (subnetId == SUBNET2)
+    {
+        return 1;
+    }
+    return -1;
+}
+
+/**********************************************************************************************************************/
+/** Ask the interface flags by ioctl.
+ *
+ *  @param[in]        pIfName              interface name
+ *  @param[out]       pLinkUpDown          TRUE: up and running, FALSE: down
+ *
+ *  @retval         TRDP_NO_ERR                no error
+ *  @retval         TRDP_SOCK_ERR            socket err
+ */
+static TRDP_ERR_T tau_getLinkFlags (
+    const CHAR8 *pIfName,
+    BOOL8       *pLinkUpDown)
+{
+    struct ifreq ifRead;
+
+    memset(&ifRead, 0, sizeof(ifRead));
+    strncpy(ifRead.ifr_name, pIfName, IFNAMSIZ-1);
 
     if (ifGetSocket <= 0)
     {
@@ -435,10 +941,48 @@ TRDP_ERR_T  tau_checkLinkUpDown (
         /* Link Down */
         *pLinkUpDown = FALSE;
     }
+    return TRDP_NO_ERR;
+}
 
-//    close(ifGetSocket);
+/**********************************************************************************************************************/
+/** Check Link up/down
+ *  While the link monitor runs, the state last reported by the kernel is returned without a system call.
+ *
+ *  @param[in]        checkSubnetId            check Sub-network Id
+ *  @param[out]        pLinkUpDown          pointer to check Sub-network Id Link Up Down TRUE:Up, FALSE:Down
+ *
+ *  @retval         TRDP_NO_ERR                no error
+ *  @retval         TRDP_PARAM_ERR            parameter err
+ *  @retval         TRDP_SOCK_ERR            socket err
+ *
+ *
+ */
+TRDP_ERR_T  tau_checkLinkUpDown (
+    UINT32 checkSubnetId,
+    BOOL8 *pLinkUpDown)
+{
+    INT32 linkIndex = tau_getLinkIndex(checkSubnetId);
 
-    return TRDP_NO_ERR;
+    /* Parameter Check */
+    if (pLinkUpDown == NULL)
+    {
+        vos_printLog(VOS_LOG_ERROR, "tau_checkLinkUpDown pLinkUpDown parameter err\n");
+        return TRDP_PARAM_ERR;
+    }
+    if (linkIndex < 0)
+    {
+        vos_printLog(VOS_LOG_ERROR, "tau_checkLinkUpDown Check SubnetId failed\n");
+        return TRDP_PARAM_ERR;
+    }
+
+    /* Link state pushed by the link monitor */
+    if (linkMonitorActive == TRUE)
+    {
+        *pLinkUpDown = linkUp[linkIndex];
+        return TRDP_NO_ERR;
+    }
+
+    return tau_getLinkFlags(linkIfName[linkIndex], pLinkUpDown);
 }
 
 /**********************************************************************************************************************/
@@ -450,6 +994,7 @@ TRDP_ERR_T  tau_checkLinkUpDown (
 
 TRDP_ERR_T  tau_closeCheckLinkUpDown (void)
 {
+    (void) tau_stopLinkMonitor();
     if (ifGetSocket)
     {
         close(ifGetSocket);
@@ -458,4 +1003,310 @@ TRDP_ERR_T  tau_closeCheckLinkUpDown (void)
     return TRDP_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Set the interface name of a subnet used for link checks.
+ *
+ *  @param[in]        subnetId            SUBNET1 or SUBNET2
+ *  @param[in]        pIfName             interface name, e.g. "eth0"
+ *
+ *  @retval         TRDP_NO_ERR                no error
+ *  @retval         TRDP_PARAM_ERR            parameter err
+ */
+TRDP_ERR_T  tau_setLinkIfName (
+    UINT32      subnetId,
+    const CHAR8 *pIfName)
+{
+    INT32 linkIndex = tau_getLinkIndex(subnetId);
+
+    if ((linkIndex < 0) || (pIfName == NULL) || (pIfName[0] == '\0') || (strlen(pIfName) >= IFNAMSIZ))
+    {
+        vos_printLog(VOS_LOG_ERROR, "tau_setLinkIfName parameter err\n");
+        return TRDP_PARAM_ERR;
+    }
+    vos_strncpy(linkIfName[linkIndex], pIfName, IFNAMSIZ - 1);
+    return TRDP_NO_ERR;
+}
+
+#ifdef __linux
+/**********************************************************************************************************************/
+/** Apply one RTM_NEWLINK/RTM_DELLINK message to the link state.
+ *  A lost link is posted to the PD main thread, which owns the network context and switches it.
+ *
+ *  @param[in]        pMsg                netlink message
+ */
+static void tau_linkMonitorUpdate (
+    const struct nlmsghdr *pMsg)
+{
+    const struct ifinfomsg  *pIfInfo = (const struct ifinfomsg *) NLMSG_DATA(pMsg);
+    const struct rtattr     *pAttr   = IFLA_RTA(pIfInfo);
+    int                     attrLen  = (int) IFLA_PAYLOAD(pMsg);
+    const CHAR8             *pIfName = NULL;
+    BOOL8                   up;
+    INT32                   linkIndex;
+
+    for (; RTA_OK(pAttr, attrLen); pAttr = RTA_NEXT(pAttr, attrLen))
+    {
+        if (pAttr->rta_type == IFLA_IFNAME)
+        {
+            pIfName = (const CHAR8 *) RTA_DATA(pAttr);
+            break;
+        }
+    }
+    if (pIfName == NULL)
+    {
+        return;
+    }
+
+    up = ((pMsg->nlmsg_type == RTM_NEWLINK)
+          && ((pIfInfo->ifi_flags & IFF_UP) == IFF_UP)
+          && ((pIfInfo->ifi_flags & IFF_RUNNING) == IFF_RUNNING)) ? TRUE : FALSE;
+
+    for (linkIndex = 0; linkIndex < 2; linkIndex++)
+    {
+        if ((strncmp(pIfName, linkIfName[linkIndex], IFNAMSIZ) != 0) || (linkUp[linkIndex] == up))
+        {
+            continue;
+        }
+        linkUp[linkIndex] = up;
+        vos_printLog(VOS_LOG_INFO, "Link %s %s\n", pIfName, (up == TRUE) ? "up" : "down");
+
+        /* Released after the link state, so the PD main thread sees the state the event was posted for */
+        if (up == FALSE)
+        {
+            __atomic_store_n(&linkDownEvent, TRUE, __ATOMIC_RELEASE);
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Link monitor thread, waits for rtnetlink link messages.
+ *
+ *  @param[in]        pArg                not used
+ */
+static void tau_linkMonitorThread (
+    void *pArg)
+{
+    UINT8           buffer[TAU_LINK_MSG_SIZE] __attribute__ ((aligned(NLMSG_ALIGNTO)));
+    struct pollfd   pfd;
+    struct nlmsghdr *pMsg;
+    int             len;
+
+    (void) pArg;
+    pfd.fd      = linkMonitorSocket;
+    pfd.events  = POLLIN;
+
+    while (linkMonitorRun == TRUE)
+    {
+        /* The timeout only bounds the time tau_stopLinkMonitor() waits for this thread */
+        if (poll(&pfd, 1, TAU_LINK_POLL_TIMEOUT) <= 0)
+        {
+            continue;
+        }
+        len = (int) recv(linkMonitorSocket, buffer, sizeof(buffer), 0);
+        if (len <= 0)
+        {
+            continue;
+        }
+        for (pMsg = (struct nlmsghdr *) buffer; NLMSG_OK(pMsg, len); pMsg = NLMSG_NEXT(pMsg, len))
+        {
+            if ((pMsg->nlmsg_type == RTM_NEWLINK) || (pMsg->nlmsg_type == RTM_DELLINK))
+            {
+                tau_linkMonitorUpdate(pMsg);
+            }
+        }
+    }
+    linkMonitorActive = FALSE;
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Take the link loss posted by the link monitor.
+ *  The caller checks the link of the receiving subnet and switches the network context itself.
+ *
+ *  @retval         TRUE                a link went down since the last call
+ *  @retval         FALSE               no link lost
+ */
+BOOL8  tau_takeLinkDownEvent (void)
+{
+#ifdef __linux
+    return __atomic_exchange_n(&linkDownEvent, FALSE, __ATOMIC_ACQUIRE);
+#else
+    return FALSE;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Start the link monitor.
+ *  A thread subscribes to rtnetlink link changes (RTMGRP_LINK) of both subnet interfaces. It keeps the link state for
+ *  tau_checkLinkUpDown() and posts each lost link for tau_takeLinkDownEvent().
+ *
+ *  @retval         TRDP_NO_ERR                no error
+ *  @retval         TRDP_SOCK_ERR            netlink not available
+ *  @retval         TRDP_THREAD_ERR            thread not started
+ */
+TRDP_ERR_T  tau_startLinkMonitor (void)
+{
+#ifdef __linux
+    struct sockaddr_nl  addr;
+    VOS_THREAD_T        thread;
+    INT32               linkIndex;
+
+    if (linkMonitorActive == TRUE)
+    {
+        return TRDP_NO_ERR;
+    }
+
+    linkMonitorSocket = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC, NETLINK_ROUTE);
+    if (linkMonitorSocket == -1)
+    {
+        vos_printLog(VOS_LOG_ERROR, "tau_startLinkMonitor netlink socket err.\n");
+        return TRDP_SOCK_ERR;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.nl_family  = AF_NETLINK;
+    addr.nl_groups  = RTMGRP_LINK;
+    if (bind(linkMonitorSocket, (struct sockaddr *) &addr, sizeof(addr)) != 0)
+    {
+        vos_printLog(VOS_LOG_ERROR, "tau_startLinkMonitor netlink bind err.\n");
+        close(linkMonitorSocket);
+        linkMonitorSocket = -1;
+        return TRDP_SOCK_ERR;
+    }
+
+    /* Subscribed first, so no change between the initial query and the first message is lost */
+    for (linkIndex = 0; linkIndex < 2; linkIndex++)
+    {
+        if (tau_getLinkFlags(linkIfName[linkIndex], (BOOL8 *) &linkUp[linkIndex]) != TRDP_NO_ERR)
+        {
+            linkUp[linkIndex] = FALSE;
+        }
+    }
+
+    linkMonitorRun      = TRUE;
+    linkMonitorActive   = TRUE;
+    if (vos_threadCreate(&thread, "LinkMonitor", VOS_THREAD_POLICY_OTHER, 0, 0u, 0u,
+                         tau_linkMonitorThread, NULL) != VOS_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_ERROR, "tau_startLinkMonitor thread create err.\n");
+        linkMonitorRun      = FALSE;
+        linkMonitorActive   = FALSE;
+        close(linkMonitorSocket);
+        linkMonitorSocket = -1;
+        return TRDP_THREAD_ERR;
+    }
+    return TRDP_NO_ERR;
+#else
+    return TRDP_SOCK_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Stop the link monitor, tau_checkLinkUpDown() asks the interface flags again.
+ *
+ *  @retval         TRDP_NO_ERR                no error
+ */
+TRDP_ERR_T  tau_stopLinkMonitor (void)
+{
+#ifdef __linux
+    UINT32 wait;
+
+    if (linkMonitorSocket == -1)
+    {
+        return TRDP_NO_ERR;
+    }
+    linkMonitorRun = FALSE;
+    for (wait = 0u; (linkMonitorActive == TRUE) && (wait < 2u * TAU_LINK_POLL_TIMEOUT); wait++)
+    {
+        (void) vos_threadDelay(1000u);
+    }
+    linkMonitorActive = FALSE;
+    close(linkMonitorSocket);
+    linkMonitorSocket = -1;
+#endif
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Check whether a telegram received on one of both subnets brings new data.
+ *  The sequence counters of both subnets are independent (drift, publishers other than TAUL), so each subnet is only
+ *  checked against its own counter. Copies are recognised by their data: the oldest update of the other subnet with
+ *  the same checksum and a copy still to come. Older updates of the other subnet are not copied any more then.
+ *
+ *  @param[in,out]    pDualRx             copy check state of the telegram, zeroed to start
+ *  @param[in]        subnetIndex         0: Subnet1, 1: Subnet2
+ *  @param[in]        seqCount            sequence counter of the telegram
+ *  @param[in]        pData               received data
+ *  @param[in]        dataSize            size of the data
+ *
+ *  @retval         TAU_DUAL_RX_UPDATE        write the Traffic Store
+ *  @retval         TAU_DUAL_RX_RESTART       write the Traffic Store, publisher restarted
+ *  @retval         TAU_DUAL_RX_REPEAT        drop, repeated on its subnet
+ *  @retval         TAU_DUAL_RX_COPY          drop, copy of the other subnet
+ */
+TAU_DUAL_RX_RESULT_T  tau_checkDualSubnetRx (
+    TAU_DUAL_RX_T   *pDualRx,
+    UINT32          subnetIndex,
+    UINT32          seqCount,
+    const UINT8     *pData,
+    UINT32          dataSize)
+{
+    TAU_DUAL_RX_RESULT_T    result = TAU_DUAL_RX_UPDATE;
+    TAU_DUAL_RX_UPDATE_T    *pUpdate;
+    INT32                   seqDiff;
+    UINT32                  crc;
+    UINT32                  oldest;
+    UINT32                  i;
+    UINT32                  j;
+
+    subnetIndex &= 1u;
+    if (pDualRx->valid[subnetIndex] == TRUE)
+    {
+        seqDiff = (INT32)(seqCount - pDualRx->lastSeqCount[subnetIndex]);
+        if ((seqDiff <= 0) && (seqDiff > -DUAL_SUBNET_SEQ_WINDOW))
+        {
+            return TAU_DUAL_RX_REPEAT;
+        }
+        if (seqDiff < 0)
+        {
+            /* Far behind: the publisher started again */
+            result = TAU_DUAL_RX_RESTART;
+        }
+    }
+    pDualRx->valid[subnetIndex]         = TRUE;
+    pDualRx->lastSeqCount[subnetIndex]  = seqCount;
+
+    crc = (pData != NULL) ? vos_crc32(INITFCS, pData, dataSize) : 0u;
+
+    /* Oldest first, each subnet delivers its telegrams in order */
+    oldest = (pDualRx->historyNext + DUAL_SUBNET_COPY_HISTORY - pDualRx->historyCount) % DUAL_SUBNET_COPY_HISTORY;
+    for (i = 0u; i < pDualRx->historyCount; i++)
+    {
+        pUpdate = &pDualRx->history[(oldest + i) % DUAL_SUBNET_COPY_HISTORY];
+        if ((pUpdate->copyPending == TRUE) && (pUpdate->subnetIndex != subnetIndex) && (pUpdate->crc == crc))
+        {
+            /* Copies of the older updates were lost on this subnet */
+            for (j = 0u; j <= i; j++)
+            {
+                pUpdate = &pDualRx->history[(oldest + j) % DUAL_SUBNET_COPY_HISTORY];
+                if (pUpdate->subnetIndex != subnetIndex)
+                {
+                    pUpdate->copyPending = FALSE;
+                }
+            }
+            return TAU_DUAL_RX_COPY;
+        }
+    }
+
+    pUpdate = &pDualRx->history[pDualRx->historyNext];
+    pUpdate->crc            = crc;
+    pUpdate->subnetIndex    = subnetIndex;
+    pUpdate->copyPending    = TRUE;
+    pDualRx->historyNext    = (pDualRx->historyNext + 1u) % DUAL_SUBNET_COPY_HISTORY;
+    if (pDualRx->historyCount < DUAL_SUBNET_COPY_HISTORY)
+    {
+        pDualRx->historyCount++;
+    }
+    return result;
+}
+
 #endif /* TRDP_OPTION_LADDER */
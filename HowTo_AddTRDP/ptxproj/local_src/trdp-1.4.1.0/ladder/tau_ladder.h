@@ -36,7 +36,20 @@ extern "C" {
 /***********************************************************************************************************************
  * DEFINES
  */
-#define TRAFFIC_STORE_SIZE 65536			/* Traffic Store Size : 64KB */
+#define TRAFFIC_STORE_SIZE 65536			/* Default and minimum Traffic Store Size : 64KB */
+#define TRAFFIC_STORE_MAX_SIZE		0x10000000u		/* Maximum Traffic Store Size : 256MB */
+#define TRAFFIC_STORE_SEQLOCK_GRANULE	16u		/* Traffic Store bytes covered by one sequence lock */
+#define TRAFFIC_STORE_SEQLOCK_COUNT(size)	((size) / TRAFFIC_STORE_SEQLOCK_GRANULE)
+#define TRAFFIC_STORE_NOTIFY_GROUPS	32u		/* Number of change notification groups */
+#define TRAFFIC_STORE_WAIT_FOREVER	0xFFFFFFFFu	/* tau_waitTrafficStore() without timeout */
+/* Notification group of each sequence lock (one byte each, padded to 32 bit) */
+#define TRAFFIC_STORE_GROUP_MAP_SIZE(size)	((TRAFFIC_STORE_SEQLOCK_COUNT(size) + 3u) & ~3u)
+/* Change counters and waiter counts of the groups, change counter and waiter count of all groups */
+#define TRAFFIC_STORE_NOTIFY_AREA_SIZE	((2u * TRAFFIC_STORE_NOTIFY_GROUPS + 2u) * (UINT32)sizeof(UINT32))
+/* Shared memory of a Traffic Store: telegram data, followed by the sequence locks, the group map and the
+   change notification area */
+#define TRAFFIC_STORE_SHARED_SIZE(size)	((size) + TRAFFIC_STORE_SEQLOCK_COUNT(size) * (UINT32)sizeof(UINT32) \
+										+ TRAFFIC_STORE_GROUP_MAP_SIZE(size) + TRAFFIC_STORE_NOTIFY_AREA_SIZE)
 #define SUBNET1	0x00000000					/* Sub-network Id1 */
 #define SUBNET2	0x00002000					/* Sub-network Id2 */
 #define NUM_ED_INTERFACES	10				/* number of End Device Interfaces */
@@ -44,6 +57,47 @@ extern "C" {
 /* SubnetId Type */
 #define SUBNETID_TYPE1				1			/* SUBNETID Type1 */
 #define SUBNETID_TYPE2				2			/* SUBNETID Type2 */
+/* Dual subnet receive */
+#define DUAL_SUBNET_SEQ_WINDOW	16				/* per subnet: older counters are repeats, beyond a restart */
+#define DUAL_SUBNET_COPY_HISTORY	16			/* updates kept to recognise the copy of the other subnet */
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Change counters of the notification groups as last seen by a Traffic Store consumer */
+typedef struct
+{
+	UINT32	count[TRAFFIC_STORE_NOTIFY_GROUPS];
+} TRAFFIC_STORE_NOTIFY_T;
+
+/** Result of the dual subnet copy check of a received telegram */
+typedef enum
+{
+	TAU_DUAL_RX_UPDATE	= 0,		/**< new data, first copy									*/
+	TAU_DUAL_RX_RESTART	= 1,		/**< new data, the sequence counter of its subnet restarted	*/
+	TAU_DUAL_RX_REPEAT	= 2,		/**< sequence counter already received on its subnet			*/
+	TAU_DUAL_RX_COPY	= 3			/**< the other subnet delivered the same update first		*/
+} TAU_DUAL_RX_RESULT_T;
+
+/** Traffic Store update remembered for the copy check */
+typedef struct
+{
+	UINT32	crc;					/**< checksum of the data									*/
+	UINT32	subnetIndex;			/**< 0: Subnet1, 1: Subnet2 delivered it first				*/
+	BOOL8	copyPending;			/**< copy of the other subnet still to come					*/
+} TAU_DUAL_RX_UPDATE_T;
+
+/** Copy check of one telegram received on both subnets.
+    The sequence counters of the two subnets are independent, copies are recognised by their data. */
+typedef struct
+{
+	BOOL8					valid[2];							/**< sequence counter of the subnet received		*/
+	UINT32					lastSeqCount[2];					/**< last sequence counter of Subnet1 / Subnet2	*/
+	TAU_DUAL_RX_UPDATE_T	history[DUAL_SUBNET_COPY_HISTORY];	/**< latest updates, ring						*/
+	UINT32					historyNext;						/**< next entry to overwrite						*/
+	UINT32					historyCount;						/**< entries in use								*/
+} TAU_DUAL_RX_T;
 
 /***********************************************************************************************************************
  * GLOBAL VARIABLES
@@ -54,7 +108,8 @@ extern CHAR8 TRAFFIC_STORE[];				/* Traffic Store shared memory name */
 extern mode_t PERMISSION	;					/* Traffic Store permission is rw-rw-rw- */
 extern UINT8 *pTrafficStoreAddr;			/* pointer to pointer to Traffic Store Address */
 extern VOS_SHRD_T  pTrafficStoreHandle;	/* Pointer to Traffic Store Handle */
-extern UINT16 TRAFFIC_STORE_MUTEX_VALUE_AREA;		/* Traffic Store mutex ID Area */
+extern UINT32 trafficStoreSize;				/* Traffic Store Size (telegram data) */
+extern UINT32 TRAFFIC_STORE_MUTEX_VALUE_AREA;		/* Traffic Store mutex ID Area */
 
 /* PDComLadderThread */
 extern CHAR8 pdComLadderThreadName[];		/* Thread name is PDComLadder Thread. */
@@ -91,6 +146,20 @@ TRDP_ERR_T tau_ladder_init (
 TRDP_ERR_T tau_ladder_terminate (
 	void);
 
+/******************************************************************************/
+/** Set the Traffic Store size, before tau_ladder_init().
+ *  All processes sharing the Traffic Store must use the same size.
+ *
+ *  @param[in]      size                Traffic Store size in bytes, multiple of TRAFFIC_STORE_SEQLOCK_GRANULE
+ *                                      between TRAFFIC_STORE_SIZE and TRAFFIC_STORE_MAX_SIZE
+ *
+ *	@retval			TRDP_NO_ERR
+ *	@retval			TRDP_PARAM_ERR		size out of range
+ *	@retval			TRDP_STATE_ERR		Traffic Store already created
+ */
+TRDP_ERR_T tau_setTrafficStoreSize (
+	UINT32 size);
+
 /**********************************************************************************************************************/
 /** Set pdComLadderThreadStartFlag.
  *
@@ -131,6 +200,8 @@ TRDP_ERR_T  tau_getNetworkContext (
 
 /**********************************************************************************************************************/
 /** Get Traffic Store accessibility.
+ *  The mutex only serialises direct access through pTrafficStoreAddr inside this process, telegram updates use
+ *  tau_writeTrafficStore() and tau_readTrafficStore().
  *
  *  @retval         TRDP_NO_ERR			no error
  *  @retval         TRDP_PARAM_ERR		parameter error
@@ -153,6 +224,132 @@ TRDP_ERR_T  tau_lockTrafficStore (
 TRDP_ERR_T  tau_unlockTrafficStore (
     void);
 
+/**********************************************************************************************************************/
+/** Start writing a telegram in the Traffic Store.
+ *  Every telegram offset is guarded by a sequence lock kept in the shared memory behind the telegram data.
+ *  Writers of different telegrams do not block each other, readers never block a writer.
+ *  The global Traffic Store mutex is not taken.
+ *
+ *  @param[in]      offset              Traffic Store offset of the telegram
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ *  @retval         TRDP_NOINIT_ERR	Traffic Store not created
+ */
+TRDP_ERR_T  tau_beginWriteTrafficStore (
+    UINT32 offset);
+
+/**********************************************************************************************************************/
+/** Finish writing a telegram in the Traffic Store, readers of the telegram see the new data from now on.
+ *  Consumers waiting for the notification group of the telegram are woken.
+ *
+ *  @param[in]      offset              Traffic Store offset given to tau_beginWriteTrafficStore()
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ *  @retval         TRDP_NOINIT_ERR	Traffic Store not created
+ */
+TRDP_ERR_T  tau_endWriteTrafficStore (
+    UINT32 offset);
+
+/**********************************************************************************************************************/
+/** Copy a telegram into the Traffic Store under its sequence lock.
+ *
+ *  @param[in]      offset              Traffic Store offset of the telegram
+ *  @param[in]      pData               pointer to the telegram data
+ *  @param[in]      dataSize            size of the telegram data
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ *  @retval         TRDP_PARAM_ERR		parameter error
+ *  @retval         TRDP_NOINIT_ERR	Traffic Store not created
+ */
+TRDP_ERR_T  tau_writeTrafficStore (
+    UINT32      offset,
+    const UINT8 *pData,
+    UINT32      dataSize);
+
+/**********************************************************************************************************************/
+/** Copy a consistent snapshot of a telegram out of the Traffic Store.
+ *  The copy is repeated while a writer updates the telegram, the writer is never blocked.
+ *
+ *  @param[in]      offset              Traffic Store offset of the telegram
+ *  @param[out]     pData               pointer to the destination buffer
+ *  @param[in]      dataSize            number of bytes to copy
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ *  @retval         TRDP_PARAM_ERR		parameter error
+ *  @retval         TRDP_NOINIT_ERR	Traffic Store not created
+ */
+TRDP_ERR_T  tau_readTrafficStore (
+    UINT32  offset,
+    UINT8   *pData,
+    UINT32  dataSize);
+
+/**********************************************************************************************************************/
+/** Get the update counter of a telegram.
+ *  The counter is incremented by every tau_endWriteTrafficStore() of the telegram (or of a telegram sharing its
+ *  sequence lock). A consumer reads a telegram again only if the counter has changed.
+ *
+ *  @param[in]      offset              Traffic Store offset of the telegram
+ *  @param[out]     pCount              update counter
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ *  @retval         TRDP_PARAM_ERR		parameter error
+ *  @retval         TRDP_NOINIT_ERR	Traffic Store not created
+ */
+TRDP_ERR_T  tau_getTrafficStoreUpdateCount (
+    UINT32  offset,
+    UINT32  *pCount);
+
+/**********************************************************************************************************************/
+/** Assign Traffic Store telegrams to a change notification group.
+ *  All telegrams are in group 0 after tau_ladder_init(). The assignment is kept in the shared Traffic Store and
+ *  holds for all processes. Telegrams sharing a sequence lock are in the same group.
+ *
+ *  @param[in]      offset              Traffic Store offset of the telegram
+ *  @param[in]      dataSize            size of the telegram data
+ *  @param[in]      group               group number 0 .. TRAFFIC_STORE_NOTIFY_GROUPS - 1
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ *  @retval         TRDP_PARAM_ERR		parameter error
+ *  @retval         TRDP_NOINIT_ERR	Traffic Store not created
+ */
+TRDP_ERR_T  tau_setTrafficStoreNotifyGroup (
+    UINT32  offset,
+    UINT32  dataSize,
+    UINT32  group);
+
+/**********************************************************************************************************************/
+/** Take the current change counters of all notification groups, start of tau_waitTrafficStore() calls.
+ *
+ *  @param[out]     pNotify             change counters of the consumer
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ *  @retval         TRDP_PARAM_ERR		parameter error
+ *  @retval         TRDP_NOINIT_ERR	Traffic Store not created
+ */
+TRDP_ERR_T  tau_initTrafficStoreNotify (
+    TRAFFIC_STORE_NOTIFY_T  *pNotify);
+
+/**********************************************************************************************************************/
+/** Wait until a telegram of the selected notification groups has been written.
+ *  Returns at once if a selected group changed since the last call. Under Linux the caller sleeps on a futex in
+ *  the shared Traffic Store and is woken by the writing process only, other systems poll every millisecond.
+ *
+ *  @param[in,out]  pNotify             change counters of the consumer, updated for the changed groups
+ *  @param[in]      groupMask           bit n selects group n
+ *  @param[in]      timeout             timeout in us or TRAFFIC_STORE_WAIT_FOREVER
+ *  @param[out]     pChangedMask        changed groups of groupMask, may be NULL
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ *  @retval         TRDP_TIMEOUT_ERR	no change within timeout
+ *  @retval         TRDP_PARAM_ERR		parameter error
+ *  @retval         TRDP_NOINIT_ERR	Traffic Store not created
+ */
+TRDP_ERR_T  tau_waitTrafficStore (
+    TRAFFIC_STORE_NOTIFY_T  *pNotify,
+    UINT32                  groupMask,
+    UINT32                  timeout,
+    UINT32                  *pChangedMask);
+
 /**********************************************************************************************************************/
 /** Check Link up/down
  *
@@ -178,6 +375,70 @@ TRDP_ERR_T  tau_checkLinkUpDown (
 
 TRDP_ERR_T  tau_closeCheckLinkUpDown (void);
 
+/**********************************************************************************************************************/
+/** Set the interface name of a subnet used for link checks (default eth0 / eth1).
+ *
+ *  @param[in]		subnetId			SUBNET1 or SUBNET2
+ *  @param[in]		pIfName				interface name
+ *
+ *  @retval         TRDP_NO_ERR				no error
+ *  @retval         TRDP_PARAM_ERR			parameter err
+ */
+TRDP_ERR_T  tau_setLinkIfName (
+	UINT32 subnetId,
+	const CHAR8 *pIfName);
+
+/**********************************************************************************************************************/
+/** Start the rtnetlink link monitor.
+ *  Link changes of both subnet interfaces are pushed by the kernel. tau_checkLinkUpDown() answers from the
+ *  pushed state, and a lost link is posted for tau_takeLinkDownEvent().
+ *
+ *  @retval         TRDP_NO_ERR				no error
+ *  @retval         TRDP_SOCK_ERR			netlink not available
+ *  @retval         TRDP_THREAD_ERR			thread not started
+ */
+TRDP_ERR_T  tau_startLinkMonitor (void);
+
+/**********************************************************************************************************************/
+/** Stop the link monitor.
+ *
+ *  @retval         TRDP_NO_ERR				no error
+ */
+TRDP_ERR_T  tau_stopLinkMonitor (void);
+
+/**********************************************************************************************************************/
+/** Take the link loss posted by the link monitor.
+ *  Only the thread owning the network context (TAULpdMainThread) takes it and switches the receive subnet.
+ *
+ *  @retval         TRUE					a link went down since the last call
+ *  @retval         FALSE					no link lost
+ */
+BOOL8  tau_takeLinkDownEvent (void);
+
+/**********************************************************************************************************************/
+/** Check whether a telegram received on one of both subnets brings new data.
+ *  Each subnet is checked against its own sequence counter. A new telegram is a copy if the other subnet delivered
+ *  an update with the same data whose copy is still to come. A subnet lagging more than DUAL_SUBNET_COPY_HISTORY
+ *  updates behind delivers its copies as updates.
+ *
+ *  @param[in,out]	pDualRx				copy check state of the telegram, zeroed to start
+ *  @param[in]		subnetIndex			0: Subnet1, 1: Subnet2
+ *  @param[in]		seqCount			sequence counter of the telegram
+ *  @param[in]		pData				received data
+ *  @param[in]		dataSize			size of the data
+ *
+ *  @retval         TAU_DUAL_RX_UPDATE		write the Traffic Store
+ *  @retval         TAU_DUAL_RX_RESTART		write the Traffic Store, publisher restarted
+ *  @retval         TAU_DUAL_RX_REPEAT		drop, repeated on its subnet
+ *  @retval         TAU_DUAL_RX_COPY		drop, copy of the other subnet
+ */
+TAU_DUAL_RX_RESULT_T  tau_checkDualSubnetRx (
+	TAU_DUAL_RX_T	*pDualRx,
+	UINT32			subnetIndex,
+	UINT32			seqCount,
+	const UINT8		*pData,
+	UINT32			dataSize);
+
 
 #ifdef __cplusplus
 }
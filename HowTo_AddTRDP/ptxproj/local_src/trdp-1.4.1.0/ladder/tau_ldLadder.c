@@ -88,8 +88,166 @@ TRDP_URI_HOST_T         IP_ADDRESS_ZERO = {"0.0.0.0"};  /* IP Address 0.0.0.0 */
 const TRDP_DEST_T       defaultDestination = {0};       /* Destination Parameter (id, SDT, URI) */
 static INT32 ts_buffer[2048/sizeof(INT32)];
 
+/* Telegram List index: comId buckets of the Telegram Lists, each bucket keeps the List order */
+static PUBLISH_TELEGRAM_T       *publishTelegramIndex[TELEGRAM_HASH_SIZE];
+static SUBSCRIBE_TELEGRAM_T     *subscribeTelegramIndex[TELEGRAM_HASH_SIZE];
+static PD_REQUEST_TELEGRAM_T    *pdRequestTelegramIndex[TELEGRAM_HASH_SIZE];
+/* PD Request schedule: earliest requestSendTime of the PD Request Telegram List, 0 to recompute */
+static TRDP_TIME_T              nextPdRequestTime = {0};
+
 /**********************************************************************************************************************/
 /** TAUL Local Function */
+/**********************************************************************************************************************/
+/** Return the index bucket of a comId
+ *
+ *  @param[in]      comId               comId
+ *
+ *  @retval         bucket number
+ */
+static UINT32 telegramHash (
+        UINT32 comId)
+{
+    /* Fibonacci hashing, consecutive comIds spread over all buckets */
+    return (comId * 2654435761u) >> (32u - TELEGRAM_HASH_BITS);
+}
+
+/**********************************************************************************************************************/
+/** Clear the Telegram List index and the PD Request schedule
+ *
+ */
+static void clearTelegramIndex (
+        void)
+{
+    memset(publishTelegramIndex, 0, sizeof(publishTelegramIndex));
+    memset(subscribeTelegramIndex, 0, sizeof(subscribeTelegramIndex));
+    memset(pdRequestTelegramIndex, 0, sizeof(pdRequestTelegramIndex));
+    nextPdRequestTime.tv_sec = 0;
+    nextPdRequestTime.tv_usec = 0;
+}
+
+/**********************************************************************************************************************/
+/** Add a Publish Telegram at end of its index bucket (Publish Telegram Mutex locked)
+ *
+ *  @param[in]      pPublishTelegram    pointer to Publish Telegram
+ *
+ */
+static void indexPublishTelegram (
+        PUBLISH_TELEGRAM_T *pPublishTelegram)
+{
+    PUBLISH_TELEGRAM_T * *ppBucket = &publishTelegramIndex[telegramHash(pPublishTelegram->comId)];
+
+    while (*ppBucket != NULL)
+    {
+        ppBucket = &(*ppBucket)->pNextHashPublishTelegram;
+    }
+    pPublishTelegram->pNextHashPublishTelegram = NULL;
+    *ppBucket = pPublishTelegram;
+}
+
+/**********************************************************************************************************************/
+/** Remove a Publish Telegram from its index bucket (Publish Telegram Mutex locked)
+ *
+ *  @param[in]      pPublishTelegram    pointer to Publish Telegram
+ *
+ */
+static void unindexPublishTelegram (
+        PUBLISH_TELEGRAM_T *pPublishTelegram)
+{
+    PUBLISH_TELEGRAM_T * *ppBucket = &publishTelegramIndex[telegramHash(pPublishTelegram->comId)];
+
+    while (*ppBucket != NULL)
+    {
+        if (*ppBucket == pPublishTelegram)
+        {
+            *ppBucket = pPublishTelegram->pNextHashPublishTelegram;
+            break;
+        }
+        ppBucket = &(*ppBucket)->pNextHashPublishTelegram;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Add a Subscribe Telegram at end of its index bucket (Subscribe Telegram Mutex locked)
+ *
+ *  @param[in]      pSubscribeTelegram  pointer to Subscribe Telegram
+ *
+ */
+static void indexSubscribeTelegram (
+        SUBSCRIBE_TELEGRAM_T *pSubscribeTelegram)
+{
+    SUBSCRIBE_TELEGRAM_T * *ppBucket = &subscribeTelegramIndex[telegramHash(pSubscribeTelegram->comId)];
+
+    while (*ppBucket != NULL)
+    {
+        ppBucket = &(*ppBucket)->pNextHashSubscribeTelegram;
+    }
+    pSubscribeTelegram->pNextHashSubscribeTelegram = NULL;
+    *ppBucket = pSubscribeTelegram;
+}
+
+/**********************************************************************************************************************/
+/** Remove a Subscribe Telegram from its index bucket (Subscribe Telegram Mutex locked)
+ *
+ *  @param[in]      pSubscribeTelegram  pointer to Subscribe Telegram
+ *
+ */
+static void unindexSubscribeTelegram (
+        SUBSCRIBE_TELEGRAM_T *pSubscribeTelegram)
+{
+    SUBSCRIBE_TELEGRAM_T * *ppBucket = &subscribeTelegramIndex[telegramHash(pSubscribeTelegram->comId)];
+
+    while (*ppBucket != NULL)
+    {
+        if (*ppBucket == pSubscribeTelegram)
+        {
+            *ppBucket = pSubscribeTelegram->pNextHashSubscribeTelegram;
+            break;
+        }
+        ppBucket = &(*ppBucket)->pNextHashSubscribeTelegram;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Add a PD Request Telegram at end of its index bucket (PD Request Telegram Mutex locked)
+ *
+ *  @param[in]      pPdRequestTelegram  pointer to PD Request Telegram
+ *
+ */
+static void indexPdRequestTelegram (
+        PD_REQUEST_TELEGRAM_T *pPdRequestTelegram)
+{
+    PD_REQUEST_TELEGRAM_T * *ppBucket = &pdRequestTelegramIndex[telegramHash(pPdRequestTelegram->comId)];
+
+    while (*ppBucket != NULL)
+    {
+        ppBucket = &(*ppBucket)->pNextHashPdRequestTelegram;
+    }
+    pPdRequestTelegram->pNextHashPdRequestTelegram = NULL;
+    *ppBucket = pPdRequestTelegram;
+}
+
+/**********************************************************************************************************************/
+/** Remove a PD Request Telegram from its index bucket (PD Request Telegram Mutex locked)
+ *
+ *  @param[in]      pPdRequestTelegram  pointer to PD Request Telegram
+ *
+ */
+static void unindexPdRequestTelegram (
+        PD_REQUEST_TELEGRAM_T *pPdRequestTelegram)
+{
+    PD_REQUEST_TELEGRAM_T * *ppBucket = &pdRequestTelegramIndex[telegramHash(pPdRequestTelegram->comId)];
+
+    while (*ppBucket != NULL)
+    {
+        if (*ppBucket == pPdRequestTelegram)
+        {
+            *ppBucket = pPdRequestTelegram->pNextHashPdRequestTelegram;
+            break;
+        }
+        ppBucket = &(*ppBucket)->pNextHashPdRequestTelegram;
+    }
+}
+
 /**********************************************************************************************************************/
 /** Append an Publish Telegram at end of List
  *
@@ -154,6 +312,9 @@ TRDP_ERR_T appendPublishTelegramList (
         }
     }
 
+    /* Index by comId */
+    indexPublishTelegram(pNewPublishTelegram);
+
     if (*ppHeadPublishTelegram == NULL)
     {
         *ppHeadPublishTelegram = pNewPublishTelegram;
@@ -218,6 +379,7 @@ TRDP_ERR_T deletePublishTelegramList (
     if (pDeletePublishTelegram == *ppHeadPublishTelegram)
     {
         *ppHeadPublishTelegram = pDeletePublishTelegram->pNextPublishTelegram;
+        unindexPublishTelegram(pDeletePublishTelegram);
         vos_memFree(pDeletePublishTelegram);
         pDeletePublishTelegram = NULL;
         /* UnLock Publish Telegram by Mutex */
@@ -232,6 +394,7 @@ TRDP_ERR_T deletePublishTelegramList (
         if (iterPublishTelegram->pNextPublishTelegram == pDeletePublishTelegram)
         {
             iterPublishTelegram->pNextPublishTelegram = pDeletePublishTelegram->pNextPublishTelegram;
+            unindexPublishTelegram(pDeletePublishTelegram);
             vos_memFree(pDeletePublishTelegram);
             pDeletePublishTelegram = NULL;
             break;
@@ -288,10 +451,10 @@ PUBLISH_TELEGRAM_T *searchPublishTelegramList (
         }
     }
 
-    /* Check PublishTelegram List Loop */
-    for (iterPublishTelegram = pHeadPublishTelegram;
+    /* Check the comId bucket of the PublishTelegram List */
+    for (iterPublishTelegram = publishTelegramIndex[telegramHash(comId)];
             iterPublishTelegram != NULL;
-            iterPublishTelegram = iterPublishTelegram->pNextPublishTelegram)
+            iterPublishTelegram = iterPublishTelegram->pNextHashPublishTelegram)
     {
         /* Publish Telegram: We match if src/dst address is zero or matches, and comId */
         if ((iterPublishTelegram->comId == comId)
@@ -376,6 +539,9 @@ TRDP_ERR_T appendSubscribeTelegramList (
         }
     }
 
+    /* Index by comId */
+    indexSubscribeTelegram(pNewSubscribeTelegram);
+
     if (*ppHeadSubscribeTelegram == NULL)
     {
         *ppHeadSubscribeTelegram = pNewSubscribeTelegram;
@@ -396,6 +562,25 @@ TRDP_ERR_T appendSubscribeTelegramList (
     return TRDP_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Drop the reference of a Subscribe Telegram to its dual subnet receive state
+ *
+ *  @param[in]      pSubscribeTelegram          pointer to Subscribe Telegram
+ *
+ */
+static void releaseRxState (
+        SUBSCRIBE_TELEGRAM_T    *pSubscribeTelegram)
+{
+    if (pSubscribeTelegram->pRxState != NULL)
+    {
+        if (--pSubscribeTelegram->pRxState->refCount == 0)
+        {
+            vos_memFree(pSubscribeTelegram->pRxState);
+        }
+        pSubscribeTelegram->pRxState = NULL;
+    }
+}
+
 /**********************************************************************************************************************/
 /** Delete an Subscribe Telegram List
  *
@@ -440,6 +625,8 @@ TRDP_ERR_T deleteSubscribeTelegramList (
     if (pDeleteSubscribeTelegram == *ppHeadSubscribeTelegram)
     {
         *ppHeadSubscribeTelegram = pDeleteSubscribeTelegram->pNextSubscribeTelegram;
+        releaseRxState(pDeleteSubscribeTelegram);
+        unindexSubscribeTelegram(pDeleteSubscribeTelegram);
         vos_memFree(pDeleteSubscribeTelegram);
         pDeleteSubscribeTelegram = NULL;
         /* UnLock Subscribe Telegram by Mutex */
@@ -454,6 +641,8 @@ TRDP_ERR_T deleteSubscribeTelegramList (
         if (iterSubscribeTelegram->pNextSubscribeTelegram == pDeleteSubscribeTelegram)
         {
             iterSubscribeTelegram->pNextSubscribeTelegram = pDeleteSubscribeTelegram->pNextSubscribeTelegram;
+            releaseRxState(pDeleteSubscribeTelegram);
+            unindexSubscribeTelegram(pDeleteSubscribeTelegram);
             vos_memFree(pDeleteSubscribeTelegram);
             pDeleteSubscribeTelegram = NULL;
             break;
@@ -508,10 +697,10 @@ SUBSCRIBE_TELEGRAM_T *searchSubscribeTelegramList (
             return NULL;
         }
     }
-    /* Check Subscribe Telegram List Loop */
-    for (iterSubscribeTelegram = pHeadSubscribeTelegram;
+    /* Check the comId bucket of the Subscribe Telegram List */
+    for (iterSubscribeTelegram = subscribeTelegramIndex[telegramHash(comId)];
             iterSubscribeTelegram != NULL;
-            iterSubscribeTelegram = iterSubscribeTelegram->pNextSubscribeTelegram)
+            iterSubscribeTelegram = iterSubscribeTelegram->pNextHashSubscribeTelegram)
     {
         /* Subscribe Telegram: We match if src/dst address is zero or matches, and comId */
         if ((iterSubscribeTelegram->comId == comId)
@@ -641,6 +830,12 @@ TRDP_ERR_T appendPdRequestTelegramList (
         }
     }
 
+    /* Index by comId */
+    indexPdRequestTelegram(pNewPdRequestTelegram);
+    /* Recompute the PD Request schedule */
+    nextPdRequestTime.tv_sec = 0;
+    nextPdRequestTime.tv_usec = 0;
+
     if (*ppHeadPdRequestTelegram == NULL)
     {
         *ppHeadPdRequestTelegram = pNewPdRequestTelegram;
@@ -705,6 +900,7 @@ TRDP_ERR_T deletePdRequestTelegramList (
     if (pDeletePdRequestTelegram == *ppHeadPdRequestTelegram)
     {
         *ppHeadPdRequestTelegram = pDeletePdRequestTelegram->pNextPdRequestTelegram;
+        unindexPdRequestTelegram(pDeletePdRequestTelegram);
         vos_memFree(pDeletePdRequestTelegram);
         pDeletePdRequestTelegram = NULL;
         /* UnLock PD Request Telegram by Mutex */
@@ -719,6 +915,7 @@ TRDP_ERR_T deletePdRequestTelegramList (
         if (iterPdRequestTelegram->pNextPdRequestTelegram == pDeletePdRequestTelegram)
         {
             iterPdRequestTelegram->pNextPdRequestTelegram = pDeletePdRequestTelegram->pNextPdRequestTelegram;
+            unindexPdRequestTelegram(pDeletePdRequestTelegram);
             vos_memFree(pDeletePdRequestTelegram);
             pDeletePdRequestTelegram = NULL;
             break;
@@ -777,10 +974,10 @@ PD_REQUEST_TELEGRAM_T *searchPdRequestTelegramList (
             return NULL;
         }
     }
-    /* Check PD Request Telegram List Loop */
-    for (iterPdRequestTelegram = pHeadPdRequestTelegram;
+    /* Check the comId bucket of the PD Request Telegram List */
+    for (iterPdRequestTelegram = pdRequestTelegramIndex[telegramHash(comId)];
             iterPdRequestTelegram != NULL;
-            iterPdRequestTelegram = iterPdRequestTelegram->pNextPdRequestTelegram)
+            iterPdRequestTelegram = iterPdRequestTelegram->pNextHashPdRequestTelegram)
     {
         /* PD Request Telegram: We match if src/dst address is zero or matches, and comId */
         if ((iterPdRequestTelegram->comId == comId)
@@ -1135,6 +1332,109 @@ TRDP_ERR_T configureTelegrams (
     return TRDP_NO_ERR;
 }
 
+/******************************************************************************/
+/** Share one receive state between the Subnet1 and Subnet2 subscription of each telegram.
+ *  Subscriptions of the same comId writing to the same Traffic Store offset form one telegram.
+ *
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_MEM_ERR
+ */
+TRDP_ERR_T configureDualSubnetReceive (
+        void)
+{
+    SUBSCRIBE_TELEGRAM_T    *iterSubscribeTelegram;
+    SUBSCRIBE_TELEGRAM_T    *iterPartner;
+    TAU_LD_RX_STATE_T       *pRxState;
+
+    for (iterSubscribeTelegram = pHeadSubscribeTelegram;
+         iterSubscribeTelegram != NULL;
+         iterSubscribeTelegram = iterSubscribeTelegram->pNextSubscribeTelegram)
+    {
+        if (iterSubscribeTelegram->pRxState != NULL)
+        {
+            continue;
+        }
+        pRxState = (TAU_LD_RX_STATE_T *)vos_memAlloc(sizeof(TAU_LD_RX_STATE_T));
+        if (pRxState == NULL)
+        {
+            vos_printLog(VOS_LOG_ERROR, "configureDualSubnetReceive() Failed. vos_memAlloc() Err\n");
+            return TRDP_MEM_ERR;
+        }
+        memset(pRxState, 0, sizeof(TAU_LD_RX_STATE_T));
+        pRxState->stats.comId = iterSubscribeTelegram->comId;
+        pRxState->stats.offset = iterSubscribeTelegram->pPdParameter->offset;
+
+        /* Partners follow in the comId bucket */
+        for (iterPartner = iterSubscribeTelegram;
+             iterPartner != NULL;
+             iterPartner = iterPartner->pNextHashSubscribeTelegram)
+        {
+            if ((iterPartner->pRxState == NULL)
+                && (iterPartner->comId == iterSubscribeTelegram->comId)
+                && (iterPartner->pPdParameter->offset == iterSubscribeTelegram->pPdParameter->offset))
+            {
+                iterPartner->pRxState = pRxState;
+                pRxState->refCount++;
+            }
+        }
+    }
+    return TRDP_NO_ERR;
+}
+
+/******************************************************************************/
+/** Decide whether a received PD updates the Traffic Store in dual subnet receive mode.
+ *  The first copy of an update wins, the copy of the other subnet is dropped (tau_checkDualSubnetRx()). A timeout is
+ *  passed on only when both subnets timed out.
+ *
+ *  @param[in]      pRxState            receive state of the telegram
+ *  @param[in]      subnetIndex         SUBNET_NO_1 or SUBNET_NO_2
+ *  @param[in]      pPDInfo             pointer to PD information
+ *  @param[in]      pData               received data
+ *  @param[in]      dataSize            size of the data
+ *
+ *  @retval         TRUE                write (or clear) the Traffic Store
+ *  @retval         FALSE               drop
+ */
+static BOOL8 acceptDualSubnetPd (
+        TAU_LD_RX_STATE_T       *pRxState,
+        UINT32                  subnetIndex,
+        const TRDP_PD_INFO_T    *pPDInfo,
+        const UINT8             *pData,
+        UINT32                  dataSize)
+{
+    if (pPDInfo->resultCode == TRDP_TIMEOUT_ERR)
+    {
+        pRxState->timedOut[subnetIndex] = TRUE;
+        if ((pRxState->timedOut[SUBNET_NO_1] == FALSE) || (pRxState->timedOut[SUBNET_NO_2] == FALSE))
+        {
+            return FALSE;
+        }
+        /* Both subnets lost: the next telegrams are accepted whatever their sequence counters */
+        memset(&pRxState->dualRx, 0, sizeof(pRxState->dualRx));
+        pRxState->stats.timeouts++;
+        return TRUE;
+    }
+
+    pRxState->timedOut[subnetIndex] = FALSE;
+    switch (tau_checkDualSubnetRx(&pRxState->dualRx, subnetIndex, pPDInfo->seqCount, pData, dataSize))
+    {
+        case TAU_DUAL_RX_COPY:
+            pRxState->stats.duplicates++;
+            return FALSE;
+        case TAU_DUAL_RX_REPEAT:
+            pRxState->stats.repeats++;
+            return FALSE;
+        case TAU_DUAL_RX_RESTART:
+            pRxState->stats.restarts++;
+            break;
+        default:
+            break;
+    }
+    pRxState->stats.updates[subnetIndex]++;
+    pRxState->stats.lastSubnet = (subnetIndex == SUBNET_NO_1) ? SUBNET1 : SUBNET2;
+    return TRUE;
+}
+
 /******************************************************************************/
 /** Size of Dataset writing in Traffic Store
  *
@@ -1660,6 +1960,17 @@ TRDP_ERR_T subscribeTelegram (
                 vos_memFree(pSubscribeTelegram);
                 return TRDP_PARAM_ERR;
             }
+            /* Received data is written to offset .. offset + size - 1 of the Traffic Store */
+            if ((pExchgPar->pPdPar == NULL)
+                || (pExchgPar->pPdPar->offset >= trafficStoreSize)
+                || (pSubscribeTelegram->dataset.size > trafficStoreSize - pExchgPar->pPdPar->offset))
+            {
+                vos_printLog(VOS_LOG_ERROR, "subscribeTelegram() Failed. comId:%d dataset size %d exceeds the Traffic Store size %d\n",
+                             pExchgPar->comId, pSubscribeTelegram->dataset.size, trafficStoreSize);
+                /* Free Subscribe Telegram */
+                vos_memFree(pSubscribeTelegram);
+                return TRDP_PARAM_ERR;
+            }
             /* Create Dataset */
             pSubscribeDataset = (UINT32 *)vos_memAlloc(pSubscribeTelegram->dataset.size);
             if (pSubscribeDataset == NULL)
@@ -2093,6 +2404,11 @@ TRDP_ERR_T pdRequestTelegram (
                 /* Set Reply ComId */
                 pPdRequestTelegram->replyComId = pTailSubscribeTelegram->comId;
             }
+            /* Set Request send cycle, the next request is due one cycle after this one */
+            pPdRequestTelegram->requestInterval.tv_sec = pPdRequestTelegram->pPdParameter->cycle / 1000000;
+            pPdRequestTelegram->requestInterval.tv_usec = pPdRequestTelegram->pPdParameter->cycle % 1000000;
+            vos_getTime(&pPdRequestTelegram->requestSendTime);
+            vos_addTime(&pPdRequestTelegram->requestSendTime, &pPdRequestTelegram->requestInterval);
             /* PD Request */
             err = tlp_request(
                     pPdRequestTelegram->appHandle,                      /* our application identifier */
@@ -2154,13 +2470,14 @@ TRDP_ERR_T tau_pd_main_proc_init (
 
     /* Init Thread */
     vos_threadInit();
-    /* Create TAULpdMainThread */
-    vosErr = vos_threadCreate(&taulPdMainThreadHandle,
+    /* Create TAULpdMainThread, pinned / real-time as configured */
+    vosErr = vos_threadCreateEx(&taulPdMainThreadHandle,
                 taulPdMainThreadName,
-                VOS_THREAD_POLICY_OTHER,
-                TAUL_PROCESS_PRIORITY,
+                taulConfig.mainThreadPolicy,
+                (taulConfig.mainThreadPriority != 0) ? taulConfig.mainThreadPriority : TAUL_PROCESS_PRIORITY,
                 0,
                 TAUL_PROCESS_THREAD_STACK_SIZE,
+                &taulConfig.mainThreadOptions,
                 (void *)TAULpdMainThread,
                 NULL);
     if (vosErr != VOS_NO_ERR)
@@ -2171,6 +2488,81 @@ TRDP_ERR_T tau_pd_main_proc_init (
     return TRDP_NO_ERR;
 }
 
+/******************************************************************************/
+/** Send the PD Requests which are due.
+ *  The PD Request Telegram List is walked only when the earliest request is due, each request carries its own
+ *  send time and cycle, and the earliest send time is recomputed on the way.
+ *
+ *  @param[in]      pNowTime            current time
+ *
+ */
+static void sendPdRequestTelegrams (
+        const TRDP_TIME_T *pNowTime)
+{
+    PD_REQUEST_TELEGRAM_T   *iterPdRequestTelegram;
+    TRDP_TIME_T             nextTime = {0};
+    TRDP_ERR_T              err = TRDP_NO_ERR;
+
+    if ((pHeadPdRequestTelegram == NULL)
+        || (pPdRequestTelegramMutex == NULL)
+        || (vos_mutexLock(pPdRequestTelegramMutex) != VOS_NO_ERR))
+    {
+        return;
+    }
+    /* Nothing due ? */
+    if (vos_cmpTime(&nextPdRequestTime, (TRDP_TIME_T *)pNowTime) > 0)
+    {
+        vos_mutexUnlock(pPdRequestTelegramMutex);
+        return;
+    }
+
+    for (iterPdRequestTelegram = pHeadPdRequestTelegram;
+         iterPdRequestTelegram != NULL;
+         iterPdRequestTelegram = iterPdRequestTelegram->pNextPdRequestTelegram)
+    {
+        /* Is Now Time send Timing ? */
+        if (vos_cmpTime(&iterPdRequestTelegram->requestSendTime, (TRDP_TIME_T *)pNowTime) < 0)
+        {
+            /* Update Request Dataset */
+            (void) tau_readTrafficStore(iterPdRequestTelegram->pPdParameter->offset,
+                                        (UINT8 *)ts_buffer,
+                                        iterPdRequestTelegram->datasetNetworkByteSize);
+            /* PD Request */
+            err = tlp_request(
+                    iterPdRequestTelegram->appHandle,
+                    iterPdRequestTelegram->subHandle,
+                    iterPdRequestTelegram->comId,
+                    iterPdRequestTelegram->etbTopoCount,
+                    iterPdRequestTelegram->opTrnTopoCount,
+                    iterPdRequestTelegram->srcIpAddr,
+                    iterPdRequestTelegram->dstIpAddr,
+                    iterPdRequestTelegram->pPdParameter->redundant,
+                    iterPdRequestTelegram->pPdParameter->flags,
+                    iterPdRequestTelegram->pSendParam,
+                    (UINT8 *)ts_buffer,
+                    iterPdRequestTelegram->datasetNetworkByteSize,
+                    iterPdRequestTelegram->replyComId,
+                    iterPdRequestTelegram->replyIpAddr);
+            if (err != TRDP_NO_ERR)
+            {
+                vos_printLog(VOS_LOG_ERROR, "TAULpdMainThread() Failed. tlp_request() Err: %d\n", err);
+            }
+            vos_printLog(VOS_LOG_DBG, "%s tlp_request()\n",
+                         (iterPdRequestTelegram->appHandle == appHandle) ? "Subnet1" : "Subnet2");
+            /* Set Request Send Time */
+            iterPdRequestTelegram->requestSendTime = *pNowTime;
+            vos_addTime(&iterPdRequestTelegram->requestSendTime, &iterPdRequestTelegram->requestInterval);
+        }
+        if ((iterPdRequestTelegram == pHeadPdRequestTelegram)
+            || (vos_cmpTime(&iterPdRequestTelegram->requestSendTime, &nextTime) < 0))
+        {
+            nextTime = iterPdRequestTelegram->requestSendTime;
+        }
+    }
+    nextPdRequestTime = nextTime;
+    vos_mutexUnlock(pPdRequestTelegramMutex);
+}
+
 /******************************************************************************/
 /** TAUL PD Main Process Thread
  *
@@ -2181,13 +2573,8 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
 {
     PD_ELE_T                    *iterPD = NULL;
     TRDP_TIME_T             nowTime = {0};
-    PD_REQUEST_TELEGRAM_T   *pUpdatePdRequestTelegram = NULL;
     TRDP_ERR_T                  err = TRDP_NO_ERR;
     UINT16                      msgTypePrNetworkByteOder = 0;
-    UINT32                      replyComIdHostByetOrder = 0;
-    UINT32                      replyIpAddrHostByteOrder = 0;
-    TRDP_TIME_T             tv_interval = {0};                              /* interval Time :timeval type */
-    TRDP_TIME_T             trdp_time_tv_interval = {0};                    /* interval Time :TRDP_TIME_T type for TRDP function */
 
     /* Check appHandle */
     while (1)
@@ -2227,6 +2614,7 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
         TRDP_TIME_T  tv2 = max_tv;
         BOOL8 linkUpDown = TRUE;                        /* Link Up Down information TRUE:Up FALSE:Down */
         UINT32 writeSubnetId;                        /* Using Traffic Store Write Sub-network Id */
+        BOOL8 linkDownEvent;                         /* Link lost, posted by the link monitor */
 
         /*
         Prepare the file descriptor set for the select call.
@@ -2289,6 +2677,10 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
         }
         rv = vos_select((int)noOfDesc + 1, &rfds, NULL, NULL, (VOS_TIME_T *)&tv);
 
+        /* Send the PD Requests which are due */
+        vos_getTime(&nowTime);
+        sendPdRequestTelegrams(&nowTime);
+
         vos_mutexLock(appHandle->mutex);
 
         /* Check PD Send Queue of appHandle1 */
@@ -2297,86 +2689,8 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
             /* Get Now Time */
             vos_getTime(&nowTime);
 
-             /* PD Request Telegram ? */
-            if (iterPD->pFrame->frameHead.msgType == msgTypePrNetworkByteOder)
-            {
-                /* Is Now Time send Timing ? */
-                if (vos_cmpTime((TRDP_TIME_T *)&iterPD->timeToGo, (TRDP_TIME_T *)&nowTime) < 0)
-                {
-                    /* PD Pull (request) ? */
-                    if (iterPD->addr.comId != TRDP_GLOBAL_STATISTICS_COMID)
-                    {
-                        /* Change Byet Order */
-                        replyComIdHostByetOrder = vos_ntohl(iterPD->pFrame->frameHead.replyComId);
-                        replyIpAddrHostByteOrder = vos_ntohl(iterPD->pFrame->frameHead.replyIpAddress);
-                        /* Get PD Request Telegram */
-                        pUpdatePdRequestTelegram = searchPdRequestTelegramList(
-                                pHeadPdRequestTelegram,
-                                iterPD->addr.comId,
-                                replyComIdHostByetOrder,
-                                iterPD->addr.srcIpAddr,
-                                iterPD->addr.destIpAddr,
-                                replyIpAddrHostByteOrder);
-                        if (pUpdatePdRequestTelegram == NULL)
-                        {
-                            vos_printLog(VOS_LOG_ERROR, "TAULpdMainThread() Failed. Get PD Request Telegram Err.\n");
-                        }
-                        else
-                        {
-                            /* First Request Send ? */
-                            if ((pUpdatePdRequestTelegram->requestSendTime.tv_sec == 0)
-                                && (pUpdatePdRequestTelegram->requestSendTime.tv_usec == 0))
-                            {
-                                /* Set now Time */
-                                vos_addTime(&pUpdatePdRequestTelegram->requestSendTime, &nowTime);
-                                /* Convert Request Send cycle time */
-                                tv_interval.tv_sec = pUpdatePdRequestTelegram->pPdParameter->cycle / 1000000;
-                                tv_interval.tv_usec = pUpdatePdRequestTelegram->pPdParameter->cycle % 1000000;
-                                trdp_time_tv_interval.tv_sec = tv_interval.tv_sec;
-                                trdp_time_tv_interval.tv_usec = tv_interval.tv_usec;
-                                /* Set Request Send Time */
-                                vos_addTime(&pUpdatePdRequestTelegram->requestSendTime, &trdp_time_tv_interval);
-                            }
-                            /* Is Now Time send Timing ? */
-                            if (vos_cmpTime((TRDP_TIME_T *)&pUpdatePdRequestTelegram->requestSendTime, (TRDP_TIME_T *)&nowTime) < 0)
-                            {
-                                /* PD Request */
-                                err = tlp_request(
-                                        appHandle,
-                                        pUpdatePdRequestTelegram->subHandle,
-                                        iterPD->addr.comId,
-                                        pUpdatePdRequestTelegram->etbTopoCount,
-                                        pUpdatePdRequestTelegram->opTrnTopoCount,
-                                        pUpdatePdRequestTelegram->srcIpAddr,
-                                        pUpdatePdRequestTelegram->dstIpAddr,
-                                        pUpdatePdRequestTelegram->pPdParameter->redundant,
-                                        pUpdatePdRequestTelegram->pPdParameter->flags,
-                                        pUpdatePdRequestTelegram->pSendParam,
-                                        (UINT8 *)((INT32) pTrafficStoreAddr + (UINT16)pUpdatePdRequestTelegram->pPdParameter->offset),
-                                        pUpdatePdRequestTelegram->datasetNetworkByteSize,
-                                        pUpdatePdRequestTelegram->replyComId,
-                                        pUpdatePdRequestTelegram->replyIpAddr);
-                                if (err != TRDP_NO_ERR)
-                                {
-                                    vos_printLog(VOS_LOG_ERROR, "TAULpdMainThread() Failed. tlp_request() Err: %d\n", err);
-                                }
-                                vos_printLog(VOS_LOG_DBG, "Subnet1 tlp_request()\n");
-                                /* Get Now Time */
-                                vos_getTime(&pUpdatePdRequestTelegram->requestSendTime);
-                                /* Convert Request Send cycle time */
-                                tv_interval.tv_sec = pUpdatePdRequestTelegram->pPdParameter->cycle / 1000000;
-                                tv_interval.tv_usec = pUpdatePdRequestTelegram->pPdParameter->cycle % 1000000;
-                                trdp_time_tv_interval.tv_sec = tv_interval.tv_sec;
-                                trdp_time_tv_interval.tv_usec = tv_interval.tv_usec;
-                                /* Set Request Send Time */
-                                vos_addTime(&pUpdatePdRequestTelegram->requestSendTime, &trdp_time_tv_interval);
-                            }
-                        }
-                    }
-                }
-            }
-            /* Publish Telegram */
-            else
+            /* Publish Telegram ? PD Requests are sent by the PD Request schedule */
+            if (iterPD->pFrame->frameHead.msgType != msgTypePrNetworkByteOder)
             {
                 /* Is Now Time send Timing ? */
                 if (vos_cmpTime((TRDP_TIME_T *)&iterPD->timeToGo, (TRDP_TIME_T *)&nowTime) < 0)
@@ -2385,11 +2699,7 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
                     if (iterPD->addr.comId != TRDP_GLOBAL_STATISTICS_COMID)
                     {
                         /* Update Publish Dataset */
-                        tau_ldLockTrafficStore();
-                        memcpy((void *)ts_buffer,
-                                 (UINT8 *)((INT32)pTrafficStoreAddr + *(UINT16*)(iterPD->pUserRef)),
-                                 2048);
-                        tau_ldUnlockTrafficStore();
+                        (void) tau_readTrafficStore(*(UINT32 *)(iterPD->pUserRef), (UINT8 *)ts_buffer, iterPD->dataSize);
                         err = tlp_put(
                                 appHandle,
                                 iterPD,
@@ -2415,82 +2725,8 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
             {
                 /* Get Now Time */
                 vos_getTime(&nowTime);
-                /* PD Request Telegram ? */
-                if (iterPD->pFrame->frameHead.msgType == msgTypePrNetworkByteOder)
-                {
-                    /* PD Pull (request) ? */
-                    if (iterPD->addr.comId != TRDP_GLOBAL_STATISTICS_COMID)
-                    {
-                        /* Change Byet Order */
-                        replyComIdHostByetOrder = vos_ntohl(iterPD->pFrame->frameHead.replyComId);
-                        replyIpAddrHostByteOrder = vos_ntohl(iterPD->pFrame->frameHead.replyIpAddress);
-                        /* Get PD Request Telegram */
-                        pUpdatePdRequestTelegram = searchPdRequestTelegramList(
-                                pHeadPdRequestTelegram,
-                                iterPD->addr.comId,
-                                replyComIdHostByetOrder,
-                                iterPD->addr.srcIpAddr,
-                                iterPD->addr.destIpAddr,
-                                replyIpAddrHostByteOrder);
-                        if (pUpdatePdRequestTelegram == NULL)
-                        {
-                            vos_printLog(VOS_LOG_ERROR, "TAULpdMainThread() Failed. Get PD Request Telegram Err.\n");
-                        }
-                        else
-                        {
-                            /* First Request Send ? */
-                            if ((pUpdatePdRequestTelegram->requestSendTime.tv_sec == 0)
-                                && (pUpdatePdRequestTelegram->requestSendTime.tv_usec == 0))
-                            {
-                                /* Set now Time */
-                                vos_addTime(&pUpdatePdRequestTelegram->requestSendTime, &nowTime);
-                                /* Convert Request Send cycle time */
-                                tv_interval.tv_sec = pUpdatePdRequestTelegram->pPdParameter->cycle / 1000000;
-                                tv_interval.tv_usec = pUpdatePdRequestTelegram->pPdParameter->cycle % 1000000;
-                                trdp_time_tv_interval.tv_sec = tv_interval.tv_sec;
-                                trdp_time_tv_interval.tv_usec = tv_interval.tv_usec;
-                                /* Set Request Send Time */
-                                vos_addTime(&pUpdatePdRequestTelegram->requestSendTime, &trdp_time_tv_interval);
-                            }
-                            /* Is Now Time send Timing ? */
-                            if (vos_cmpTime((TRDP_TIME_T *)&pUpdatePdRequestTelegram->requestSendTime, (TRDP_TIME_T *)&nowTime) < 0)
-                            {
-                                /* PD Request */
-                                err = tlp_request(
-                                        appHandle2,
-                                        pUpdatePdRequestTelegram->subHandle,
-                                        iterPD->addr.comId,
-                                        pUpdatePdRequestTelegram->etbTopoCount,
-                                        pUpdatePdRequestTelegram->opTrnTopoCount,
-                                        pUpdatePdRequestTelegram->srcIpAddr,
-                                        pUpdatePdRequestTelegram->dstIpAddr,
-                                        pUpdatePdRequestTelegram->pPdParameter->redundant,
-                                        pUpdatePdRequestTelegram->pPdParameter->flags,
-                                        pUpdatePdRequestTelegram->pSendParam,
-                                        (UINT8 *)((INT32) pTrafficStoreAddr + (UINT16)pUpdatePdRequestTelegram->pPdParameter->offset),
-                                        pUpdatePdRequestTelegram->datasetNetworkByteSize,
-                                        pUpdatePdRequestTelegram->replyComId,
-                                        pUpdatePdRequestTelegram->replyIpAddr);
-                                if (err != TRDP_NO_ERR)
-                                {
-                                    vos_printLog(VOS_LOG_ERROR, "TAULpdMainThread() Failed. tlp_request() Err: %d\n", err);
-                                }
-                                vos_printLog(VOS_LOG_DBG, "Subnet2 tlp_request()\n");
-                                /* Get Now Time */
-                                vos_getTime(&pUpdatePdRequestTelegram->requestSendTime);
-                                /* Convert Request Send cycle time */
-                                tv_interval.tv_sec = pUpdatePdRequestTelegram->pPdParameter->cycle / 1000000;
-                                tv_interval.tv_usec = pUpdatePdRequestTelegram->pPdParameter->cycle % 1000000;
-                                trdp_time_tv_interval.tv_sec = tv_interval.tv_sec;
-                                trdp_time_tv_interval.tv_usec = tv_interval.tv_usec;
-                                /* Set Request Send Time */
-                                vos_addTime(&pUpdatePdRequestTelegram->requestSendTime, &trdp_time_tv_interval);
-                            }
-                        }
-                    }
-                }
-                /* Publish Telegram */
-                else
+                /* Publish Telegram ? PD Requests are sent by the PD Request schedule */
+                if (iterPD->pFrame->frameHead.msgType != msgTypePrNetworkByteOder)
                 {
                     /* Is Now Time send Timing ? */
                     if (vos_cmpTime((TRDP_TIME_T *)&iterPD->timeToGo, (TRDP_TIME_T *)&nowTime) < 0)
@@ -2499,11 +2735,7 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
                         if (iterPD->addr.comId != TRDP_GLOBAL_STATISTICS_COMID)
                         {
                             /* Update Publish Dataset */
-                            tau_ldLockTrafficStore();
-                            memcpy((void *)ts_buffer,
-                                     (UINT8 *)((INT32)pTrafficStoreAddr + *(UINT16*)(iterPD->pUserRef)),
-                                     2048);
-                            tau_ldUnlockTrafficStore();
+                            (void) tau_readTrafficStore(*(UINT32 *)(iterPD->pUserRef), (UINT8 *)ts_buffer, iterPD->dataSize);
                             err = tlp_put(
                                     appHandle2,
                                     iterPD,
@@ -2530,8 +2762,9 @@ VOS_THREAD_FUNC_T TAULpdMainThread (
         function (in it's context and thread)!
         */
 
-        /* Don't Receive ? AND Ladder Topology */
-        if ((rv <= 0) && (appHandle2 != (TRDP_APP_SESSION_T) LADDER_TOPOLOGY_DISABLE))
+        /* Don't Receive or link lost ? AND Ladder Topology */
+        linkDownEvent = tau_takeLinkDownEvent();
+        if (((rv <= 0) || (linkDownEvent == TRUE)) && (appHandle2 != (TRDP_APP_SESSION_T) LADDER_TOPOLOGY_DISABLE))
         {
             /* Get Write Traffic Store Receive SubnetId */
             err = tau_getNetworkContext(&writeSubnetId);
@@ -2611,6 +2844,9 @@ TRDP_ERR_T tau_ldInit (
     UINT32 getNoOfIfaces = NUM_ED_INTERFACES;
     VOS_IF_REC_T ifAddressTable[NUM_ED_INTERFACES];
     TRDP_IP_ADDR_T ownIpAddress = 0;
+#ifdef XML_CONFIG_ENABLE
+    UINT32 trafficStoreSizeTAUL = 0;                                        /* Configured Traffic Store size */
+#endif
 #ifdef __linux
     CHAR8 SUBNETWORK_ID1_IF_NAME[] = "eth0";
 //#elif defined(__APPLE__)
@@ -2626,6 +2862,7 @@ TRDP_ERR_T tau_ldInit (
     pHeadPublishTelegram = NULL;
     pHeadSubscribeTelegram = NULL;
     pHeadPdRequestTelegram = NULL;
+    clearTelegramIndex();
 
     /* Clear mutex pointers */
     pPublishTelegramMutex = NULL;
@@ -2653,6 +2890,17 @@ TRDP_ERR_T tau_ldInit (
         vos_printLog(VOS_LOG_ERROR, "tau_ldInit() failed. tau_readXmlDeviceConfig() error\n");
         return err;
     }
+    /* Traffic Store size, default TRAFFIC_STORE_SIZE */
+    err = tau_readXmlTrafficStoreConfig(&xmlConfigHandle, &trafficStoreSizeTAUL);
+    if ((err == TRDP_NO_ERR) && (trafficStoreSizeTAUL != 0u))
+    {
+        err = tau_setTrafficStoreSize(trafficStoreSizeTAUL);
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_ERROR, "tau_ldInit() failed. Traffic Store size %d error\n", trafficStoreSizeTAUL);
+        return err;
+    }
 #else
     /* Set Config Parameter from Internal Config */
     err = setConfigParameterFromInternalConfig();
@@ -2809,6 +3057,22 @@ TRDP_ERR_T tau_ldInit (
         vos_printLog(VOS_LOG_ERROR, "tau_ldInit() failed. TRDP Ladder Support Initialize failed\n");
         return err;
     }
+    /* Link monitoring of both subnets, tau_checkLinkUpDown() polls the interfaces if netlink is not available */
+    if (numIfConfig >= LADDER_IF_NUMBER)
+    {
+        if (taulConfig.linkIfName1[0] != '\0')
+        {
+            (void) tau_setLinkIfName(SUBNET1, taulConfig.linkIfName1);
+        }
+        if (taulConfig.linkIfName2[0] != '\0')
+        {
+            (void) tau_setLinkIfName(SUBNET2, taulConfig.linkIfName2);
+        }
+        if (tau_startLinkMonitor() != TRDP_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_WARNING, "tau_ldInit() link monitor not started, links are polled\n");
+        }
+    }
     /* Get Telegram Loop */
     for (ifIndex = 0; ifIndex < numIfConfig; ifIndex++)
     {
@@ -2819,6 +3083,16 @@ TRDP_ERR_T tau_ldInit (
             return err;
         }
     }
+    /* Both subnets write the Traffic Store ? */
+    if ((taulConfig.dualSubnetReceive == TRUE) && (numIfConfig >= LADDER_IF_NUMBER))
+    {
+        err = configureDualSubnetReceive();
+        if (err != TRDP_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_ERROR, "tau_ldInit() failed. configureDualSubnetReceive() error.\n");
+            return err;
+        }
+    }
 
     /* main Loop */
     /* Create TAUL PD Main Thread */
@@ -3107,6 +3381,8 @@ TRDP_ERR_T tau_ldTerminate (
     {
         /* Don't Delete PD Telegram */
     }
+    /* Drop the Telegram List index */
+    clearTelegramIndex();
 
     /* Ladder Terminate */
     err =   tau_ladder_terminate();
@@ -3367,6 +3643,91 @@ TRDP_ERR_T  tau_ldUnlockTrafficStore (
     return err;
 }
 
+/**********************************************************************************************************************/
+/** Write a telegram into the Traffic Store without taking the Traffic Store mutex.
+ *
+ *  @param[in]      offset          Traffic Store offset of the telegram
+ *  @param[in]      pData           pointer to the telegram data
+ *  @param[in]      dataSize        size of the telegram data
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     Traffic Store not created
+ */
+TRDP_ERR_T  tau_ldWriteTrafficStore (
+    UINT32      offset,
+    const UINT8 *pData,
+    UINT32      dataSize)
+{
+    TRDP_ERR_T err = TRDP_NO_ERR;
+
+    err = tau_writeTrafficStore(offset, pData, dataSize);
+    if (err != TRDP_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_ERROR, "tau_ldWriteTrafficStore() failed\n");
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Read a consistent copy of a telegram from the Traffic Store without taking the Traffic Store mutex.
+ *
+ *  @param[in]      offset          Traffic Store offset of the telegram
+ *  @param[out]     pData           pointer to the destination buffer
+ *  @param[in]      dataSize        number of bytes to copy
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOINIT_ERR     Traffic Store not created
+ */
+TRDP_ERR_T  tau_ldReadTrafficStore (
+    UINT32  offset,
+    UINT8   *pData,
+    UINT32  dataSize)
+{
+    TRDP_ERR_T err = TRDP_NO_ERR;
+
+    err = tau_readTrafficStore(offset, pData, dataSize);
+    if (err != TRDP_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_ERROR, "tau_ldReadTrafficStore() failed\n");
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Get the dual subnet receive statistics of a subscribed telegram.
+ *
+ *  @param[in]      comId           subscribed comId
+ *  @param[out]     pStats          pointer to the statistics
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOSUB_ERR      comId not subscribed or dual subnet receive not enabled
+ */
+TRDP_ERR_T  tau_ldGetRedundancyStatistics (
+    UINT32                      comId,
+    TAU_LD_REDUNDANCY_STATS_T   *pStats)
+{
+    SUBSCRIBE_TELEGRAM_T *iterSubscribeTelegram;
+
+    if (pStats == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    for (iterSubscribeTelegram = subscribeTelegramIndex[telegramHash(comId)];
+         iterSubscribeTelegram != NULL;
+         iterSubscribeTelegram = iterSubscribeTelegram->pNextHashSubscribeTelegram)
+    {
+        if ((iterSubscribeTelegram->comId == comId) && (iterSubscribeTelegram->pRxState != NULL))
+        {
+            *pStats = iterSubscribeTelegram->pRxState->stats;
+            return TRDP_NO_ERR;
+        }
+    }
+    return TRDP_NOSUB_ERR;
+}
+
 /**********************************************************************************************************************/
 /** callback function PD receive
  *
@@ -3386,7 +3747,7 @@ void tau_ldRecvPdDs (
 {
     UINT32 subnetId;                            /* Using Sub-network Id */
     UINT32 displaySubnetId;                /* Using Sub-network Id for Display log */
-    UINT16 offset;                                        /* Traffic Store Offset Address */
+    UINT32 offset;                                        /* Traffic Store Offset Address */
     extern UINT8 *pTrafficStoreAddr;            /* pointer to pointer to Traffic Store Address */
 
     SUBSCRIBE_TELEGRAM_T *pSubscribeTelegram;
@@ -3404,9 +3765,21 @@ void tau_ldRecvPdDs (
 
     tau_getNetworkContext(&subnetId);
 
+    /* Dual subnet receive: both subnets write the Traffic Store, first arrival wins */
+    pSubscribeTelegram = (SUBSCRIBE_TELEGRAM_T *)pPDInfo->pUserRef;
+    if ((taulConfig.dualSubnetReceive == TRUE) && (pSubscribeTelegram != NULL) && (pSubscribeTelegram->pRxState != NULL))
+    {
+        subnetId = (argAppHandle == appHandle) ? SUBNET1 : SUBNET2;
+        if (acceptDualSubnetPd(pSubscribeTelegram->pRxState,
+                               (subnetId == SUBNET1) ? SUBNET_NO_1 : SUBNET_NO_2,
+                               pPDInfo, pData, dataSize) == FALSE)
+        {
+            return;
+        }
+    }
     /* Write received PD from using subnetwork in Traffic Store */
     /* Check Receive Socket */
-    if ((subnetId == SUBNET1) && (argAppHandle == appHandle) && ((pPDInfo->srcIpAddr & SUBNET2_NETMASK) == subnetId))
+    else if ((subnetId == SUBNET1) && (argAppHandle == appHandle) && ((pPDInfo->srcIpAddr & SUBNET2_NETMASK) == subnetId))
     {
         /* Continue Write Traffic Store process */
         ;
@@ -3441,10 +3814,10 @@ void tau_ldRecvPdDs (
         {
             /* Clear Traffic Store */
             /* Get offset Address */
-            offset = (UINT16)pSubscribeTelegram->pPdParameter->offset;
-            tau_ldLockTrafficStore();
-            memset((void *)((INT32)pTrafficStoreAddr + offset), 0, pSubscribeTelegram->dataset.size);
-            tau_ldUnlockTrafficStore();
+            offset = pSubscribeTelegram->pPdParameter->offset;
+            tau_beginWriteTrafficStore(offset);
+            memset((void *)(pTrafficStoreAddr + offset), 0, pSubscribeTelegram->dataset.size);
+            tau_endWriteTrafficStore(offset);
 
             /* Set sunbetId for display log */
             if( subnetId == SUBNET1)
@@ -3463,20 +3836,20 @@ void tau_ldRecvPdDs (
     else
     {
         /* Get offset Address */
-        offset = (UINT16)pSubscribeTelegram->pPdParameter->offset;
+        offset = pSubscribeTelegram->pPdParameter->offset;
         /* Check Marshalling Kind : Marshalling Enable */
         if ((pSubscribeTelegram->pPdParameter->flags & TRDP_FLAGS_MARSHALL) == TRDP_FLAGS_MARSHALL)
         {
             /* unmarshalling */
-            tau_ldLockTrafficStore();
+            tau_beginWriteTrafficStore(offset);
             err = tau_unmarshall(
                         &marshallConfig.pRefCon,                                        /* pointer to user context*/
                         pPDInfo->comId,                                                 /* comId */
                         pData,                                                          /* source pointer to received original message */
-                        (UINT8 *)((INT32)pTrafficStoreAddr + (INT32)offset),            /* destination pointer to a buffer for the treated message */
+                        pTrafficStoreAddr + offset,                                     /* destination pointer to a buffer for the treated message */
                         &pSubscribeTelegram->dataset.size,                              /* destination Buffer Size */
                         &pSubscribeTelegram->pDatasetDescriptor);                       /* pointer to pointer of cached dataset */
-            tau_ldUnlockTrafficStore();
+            tau_endWriteTrafficStore(offset);
             if (err != TRDP_NO_ERR)
             {
                 vos_printLog(VOS_LOG_ERROR, "tau_unmarshall returns error %d\n", err);
@@ -3486,9 +3859,11 @@ void tau_ldRecvPdDs (
         else
         {
             /* Set received PD Data in Traffic Store */
-            tau_ldLockTrafficStore();
-            memcpy((void *)((INT32)pTrafficStoreAddr + offset), pData, dataSize);
-            tau_ldUnlockTrafficStore();
+            err = tau_writeTrafficStore(offset, pData, dataSize);
+            if (err != TRDP_NO_ERR)
+            {
+                vos_printLog(VOS_LOG_ERROR, "tau_writeTrafficStore returns error %d\n", err);
+            }
         }
     }
 }
@@ -68,6 +68,8 @@ extern "C" {
 #define LADDER_IF_NUMBER			2				/* Nubmer of I/F for Ladder Support (subnet1,subnet2) */
 #define SUBNET_NO2_NETMASK		0x00002000		/* The netmask for Subnet2 */
 #define SESSION_ID_NOTHING		0				/* Session Id Nothing */
+#define TELEGRAM_HASH_BITS		8				/* Telegram List index: 2^bits comId buckets */
+#define TELEGRAM_HASH_SIZE		(1u << TELEGRAM_HASH_BITS)
 #define TAUL_PROCESS_PRIORITY	0			/* TAUL process priority */
 #define TAUL_PROCESS_THREAD_STACK_SIZE  0	/* TAUL Main Thread Stack Size (0:Default, 0!:Byte) */
 #define LADDER_TOPOLOGY_DISABLE -1            /* Not Ladder Topology */
@@ -112,6 +114,12 @@ typedef enum
 typedef struct
 {
 	TRDP_IP_ADDR_T	ownIpAddr;				/**< own IP Address  										*/
+	VOS_THREAD_POLICY_T		mainThreadPolicy;	/**< TAULpdMainThread scheduling policy (0: OTHER)			*/
+	VOS_THREAD_PRIORITY_T	mainThreadPriority;	/**< TAULpdMainThread priority (0: TAUL_PROCESS_PRIORITY)	*/
+	VOS_THREAD_OPTIONS_T	mainThreadOptions;	/**< TAULpdMainThread affinity, memory locking, stack pre-fault	*/
+	TRDP_LABEL_T			linkIfName1;		/**< Subnet1 interface for link monitoring ("": eth0)		*/
+	TRDP_LABEL_T			linkIfName2;		/**< Subnet2 interface for link monitoring ("": eth1)		*/
+	BOOL8					dualSubnetReceive;	/**< both subnets update the Traffic Store, first arrival wins	*/
 } TAU_LD_CONFIG_T;
 
 typedef struct
@@ -137,8 +145,31 @@ typedef struct PUBLISH_TELEGRAM
 	TRDP_IP_ADDR_T					dstIpAddr;						/* where to send the packet to */
 	TRDP_SEND_PARAM_T					*pSendParam;					/* optional pointer to send parameter, NULL - default parameters are used */
 	struct PUBLISH_TELEGRAM			*pNextPublishTelegram;		/* pointer to next Publish Telegram or NULL */
+	struct PUBLISH_TELEGRAM			*pNextHashPublishTelegram;	/* pointer to next Publish Telegram of the comId bucket or NULL */
 } PUBLISH_TELEGRAM_T;
 
+/** Redundant reception statistics of one Traffic Store telegram */
+typedef struct
+{
+	UINT32							comId;							/**< subscribed comId								*/
+	UINT32							offset;							/**< Traffic Store offset							*/
+	UINT32							updates[LADDER_IF_NUMBER];		/**< updates delivered first by Subnet1 / Subnet2	*/
+	UINT32							duplicates;						/**< copies dropped, the other subnet was first	*/
+	UINT32							repeats;						/**< telegrams repeated on their own subnet		*/
+	UINT32							restarts;						/**< sequence counter restarts of the publisher		*/
+	UINT32							timeouts;						/**< timeouts on both subnets						*/
+	UINT32							lastSubnet;						/**< SUBNET1 or SUBNET2 delivered the last update	*/
+} TAU_LD_REDUNDANCY_STATS_T;
+
+/* Reception state shared by the Subnet1 and Subnet2 subscription of one telegram (dual subnet receive) */
+typedef struct
+{
+	UINT32							refCount;						/* number of subscriptions sharing the state */
+	BOOL8							timedOut[LADDER_IF_NUMBER];		/* subnet reported a timeout since its last telegram */
+	TAU_DUAL_RX_T					dualRx;							/* per subnet sequence counters, latest updates */
+	TAU_LD_REDUNDANCY_STATS_T		stats;							/* statistics */
+} TAU_LD_RX_STATE_T;
+
 /* Subscribe Telegram */
 typedef struct SUBSCRIBE_TELEGRAM
 {
@@ -155,7 +186,9 @@ typedef struct SUBSCRIBE_TELEGRAM
 	UINT32                          opTrnTopoCount;			/* operational topocount, != 0 for orientation/direction sensitive communication */
 	TRDP_IP_ADDR_T					srcIpAddr;					/* IP for source filtering, set 0 if not used */
 	TRDP_IP_ADDR_T					dstIpAddr;						/* IP address to join */
+	TAU_LD_RX_STATE_T				*pRxState;						/* dual subnet receive state or NULL */
 	struct SUBSCRIBE_TELEGRAM		*pNextSubscribeTelegram;		/* pointer to next Subscribe Telegram or NULL */
+	struct SUBSCRIBE_TELEGRAM		*pNextHashSubscribeTelegram;	/* pointer to next Subscribe Telegram of the comId bucket or NULL */
 } SUBSCRIBE_TELEGRAM_T;
 
 /* PD Request Telegram */
@@ -177,7 +210,9 @@ typedef struct PD_REQUEST_TELEGRAM
 	TRDP_IP_ADDR_T					replyIpAddr;					/* IP for reply (Pull request Ip) */
 	TRDP_SEND_PARAM_T					*pSendParam;					/* optional pointer to send parameter, NULL - default parameters are used */
 	TRDP_TIME_T						requestSendTime;				/* next Request Send Timing */
+	TRDP_TIME_T						requestInterval;				/* Request send cycle */
 	struct PD_REQUEST_TELEGRAM	*pNextPdRequestTelegram;		/* pointer to next PD Request Telegram or NULL */
+	struct PD_REQUEST_TELEGRAM	*pNextHashPdRequestTelegram;	/* pointer to next PD Request Telegram of the comId bucket or NULL */
 } PD_REQUEST_TELEGRAM_T;
 
 /* comId-IP Address Handle */
@@ -338,6 +373,15 @@ TRDP_ERR_T configureTelegrams (
 		UINT32 			numExchgPar,
 		TRDP_EXCHG_PAR_T	*pExchgPar);
 
+/******************************************************************************/
+/** Share one receive state between the Subnet1 and Subnet2 subscription of each telegram (dual subnet receive).
+ *
+ *	@retval			TRDP_NO_ERR
+ *	@retval			TRDP_MEM_ERR
+ */
+TRDP_ERR_T configureDualSubnetReceive (
+		void);
+
 /******************************************************************************/
 /** Size of Dataset writing in Traffic Store
  *
@@ -654,6 +698,40 @@ TRDP_ERR_T  tau_ldLockTrafficStore (
 TRDP_ERR_T  tau_ldUnlockTrafficStore (
     void);
 
+/**********************************************************************************************************************/
+/** Write a telegram into the Traffic Store.
+ *  Each telegram is guarded by its own sequence lock, the Traffic Store mutex is not taken.
+ *
+ *  @param[in]		offset			Traffic Store offset of the telegram
+ *  @param[in]		pData			pointer to the telegram data
+ *  @param[in]		dataSize		size of the telegram data
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ *  @retval         TRDP_PARAM_ERR		parameter error
+ *  @retval         TRDP_NOINIT_ERR	Traffic Store not created
+ */
+TRDP_ERR_T  tau_ldWriteTrafficStore (
+    UINT32			offset,
+    const UINT8		*pData,
+    UINT32			dataSize);
+
+/**********************************************************************************************************************/
+/** Read a consistent copy of a telegram from the Traffic Store.
+ *  The copy is retried while the telegram is written, the receive path is never blocked by readers.
+ *
+ *  @param[in]		offset			Traffic Store offset of the telegram
+ *  @param[out]		pData			pointer to the destination buffer
+ *  @param[in]		dataSize		number of bytes to copy
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ *  @retval         TRDP_PARAM_ERR		parameter error
+ *  @retval         TRDP_NOINIT_ERR	Traffic Store not created
+ */
+TRDP_ERR_T  tau_ldReadTrafficStore (
+    UINT32			offset,
+    UINT8			*pData,
+    UINT32			dataSize);
+
 /**********************************************************************************************************************/
 /** callback function PD receive
  *
@@ -671,6 +749,20 @@ void tau_ldRecvPdDs (
     UINT8 *pData,
     UINT32 dataSize);
 
+/**********************************************************************************************************************/
+/** Get the dual subnet receive statistics of a subscribed telegram.
+ *
+ *  @param[in]		comId			subscribed comId
+ *  @param[out]		pStats			pointer to the statistics
+ *
+ *  @retval         TRDP_NO_ERR			no error
+ *  @retval         TRDP_PARAM_ERR		parameter error
+ *  @retval         TRDP_NOSUB_ERR		comId not subscribed or dual subnet receive not enabled
+ */
+TRDP_ERR_T  tau_ldGetRedundancyStatistics (
+    UINT32						comId,
+    TAU_LD_REDUNDANCY_STATS_T	*pStats);
+
 /**********************************************************************************************************************/
 /** All UnPublish
  *
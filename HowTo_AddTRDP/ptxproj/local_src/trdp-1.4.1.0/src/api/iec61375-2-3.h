@@ -109,6 +109,7 @@
 #define TRDP_MD_DEFAULT_RETRIES             2u
 #define TRDP_MD_DEFAULT_SEND_PARAM          {TRDP_MD_DEFAULT_QOS, TRDP_MD_DEFAULT_TTL, TRDP_MD_DEFAULT_RETRIES}
 #define TRDP_MD_MAX_NUM_SESSIONS            1000u
+#define TRDP_MD_DEFAULT_TCP_PIPELINE        1u                          /**< one session per TCP connection         */
 
 /**  Default PD communication parameters   */
 #define TRDP_PD_DEFAULT_QOS                 5u
@@ -0,0 +1,213 @@
+/**********************************************************************************************************************/
+/**
+ * @file            tau_cfgimg.h
+ *
+ * @brief           TRDP utility interface definitions
+ *
+ * @details         This module provides the interface to the following utilities
+ *                  - precompiled binary image of the XML configuration
+ *
+ *                  The image holds everything the tau_readXml... functions deliver for one XML configuration file:
+ *                  device settings, the telegram parameters of every configured interface, datasets and the ComId
+ *                  to dataset mapping. It is built once from the XML file (tau_buildCfgImage) and mapped at start-up
+ *                  (tau_loadCfgImage). The configuration is used in place, only the pointers inside the image are
+ *                  relocated when it is loaded.
+ *
+ *                  An image is bound to the byte order, pointer size and structure layout of the build that wrote
+ *                  it. Images of another target or stack version are rejected, the XML file must be used then.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifndef TAU_CFGIMG_H
+#define TAU_CFGIMG_H
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include "vos_types.h"
+#include "trdp_types.h"
+#include "tau_xml.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define TAU_CFG_IMAGE_MAGIC     0x47464354u     /**< "TCFG" in little endian byte order                 */
+#define TAU_CFG_IMAGE_VERSION   1u              /**< Format version, incremented on incompatible change */
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+struct TAU_CFG_IMAGE;
+
+/** Loaded configuration image handle
+ */
+typedef struct
+{
+    struct TAU_CFG_IMAGE *pImage;               /**< mapped image context */
+} TRDP_CFG_IMAGE_HANDLE_T;
+
+
+/***********************************************************************************************************************
+ * PROTOTYPES
+ */
+
+/**********************************************************************************************************************/
+/**    Write the binary image of an XML configuration.
+ *  The device configuration, the telegrams of all interfaces listed in the device configuration and the dataset
+ *  configuration are read from the XML document and written to the image file. The image is built in VOS memory,
+ *  with a memory pool it must fit into the largest block.
+ *
+ *  @param[in]      pDocHnd           Handle of the XML document prepared by tau_prepareXmlDoc
+ *  @param[in]      pImageFile        Path and filename of the image to write
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    Parameter error or image file could not be written
+ *  @retval         TRDP_MEM_ERR      out of memory
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_buildCfgImage (
+    const TRDP_XML_DOC_HANDLE_T *pDocHnd,
+    const CHAR8                 *pImageFile
+    );
+
+/**********************************************************************************************************************/
+/**    Map a configuration image and check it.
+ *  Magic, version, byte order, pointer size, structure layout, size and CRC of the image are verified.
+ *
+ *  @param[in]      pImageFile        Path and filename of the image
+ *  @param[out]     pImgHnd           Handle of the loaded image
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    File does not exist or is no valid image for this build
+ *  @retval         TRDP_CRC_ERR      Image checksum wrong
+ *  @retval         TRDP_MEM_ERR      out of memory
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_loadCfgImage (
+    const CHAR8             *pImageFile,
+    TRDP_CFG_IMAGE_HANDLE_T *pImgHnd
+    );
+
+/**********************************************************************************************************************/
+/**    Unmap a configuration image.
+ *  All pointers delivered by the tau_readCfgImage... functions become invalid.
+ *
+ *  @param[in]      pImgHnd           Handle of the loaded image
+ *
+ */
+EXT_DECL void tau_freeCfgImage (
+    TRDP_CFG_IMAGE_HANDLE_T *pImgHnd
+    );
+
+/**********************************************************************************************************************/
+/**    Device configuration parameters of a configuration image, see tau_readXmlDeviceConfig.
+ *  The com parameter and interface arrays are part of the image and must not be freed.
+ *
+ *  @param[in]      pImgHnd           Handle of the image loaded by tau_loadCfgImage
+ *  @param[out]     pMemConfig        Memory configuration
+ *  @param[out]     pDbgConfig        Debug printout configuration for application use
+ *  @param[out]     pNumComPar        Number of configured com parameters
+ *  @param[out]     ppComPar          Pointer to array of com parameters
+ *  @param[out]     pNumIfConfig      Number of configured interfaces
+ *  @param[out]     ppIfConfig        Pointer to an array of interface parameter sets
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    Parameter error
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_readCfgImageDeviceConfig (
+    const TRDP_CFG_IMAGE_HANDLE_T   *pImgHnd,
+    TRDP_MEM_CONFIG_T               *pMemConfig,
+    TRDP_DBG_CONFIG_T               *pDbgConfig,
+    UINT32                          *pNumComPar,
+    TRDP_COM_PAR_T                  * *ppComPar,
+    UINT32                          *pNumIfConfig,
+    TRDP_IF_CONFIG_T                * *ppIfConfig
+    );
+
+/**********************************************************************************************************************/
+/**    Traffic Store size of a configuration image, see tau_readXmlTrafficStoreConfig.
+ *
+ *  @param[in]      pImgHnd             Handle of the image loaded by tau_loadCfgImage
+ *  @param[out]     pTrafficStoreSize   Configured Traffic Store size in bytes
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      Parameter error
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_readCfgImageTrafficStoreConfig (
+    const TRDP_CFG_IMAGE_HANDLE_T   *pImgHnd,
+    UINT32                          *pTrafficStoreSize
+    );
+
+/**********************************************************************************************************************/
+/**    Interface parameters and telegrams of a configuration image, see tau_readXmlInterfaceConfig.
+ *  The telegram array is part of the image and must not be freed with tau_freeTelegrams.
+ *
+ *  @param[in]      pImgHnd           Handle of the image loaded by tau_loadCfgImage
+ *  @param[in]      pIfName           Interface name
+ *  @param[out]     pProcessConfig    TRDP process (session) configuration for the interface
+ *  @param[out]     pPdConfig         PD default configuration for the interface
+ *  @param[out]     pMdConfig         MD default configuration for the interface
+ *  @param[out]     pNumExchgPar      Number of configured telegrams
+ *  @param[out]     ppExchgPar        Pointer to array of telegram configurations
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    Parameter error or interface not in the image
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_readCfgImageInterfaceConfig (
+    const TRDP_CFG_IMAGE_HANDLE_T   *pImgHnd,
+    const CHAR8                     *pIfName,
+    TRDP_PROCESS_CONFIG_T           *pProcessConfig,
+    TRDP_PD_CONFIG_T                *pPdConfig,
+    TRDP_MD_CONFIG_T                *pMdConfig,
+    UINT32                          *pNumExchgPar,
+    TRDP_EXCHG_PAR_T                * *ppExchgPar
+    );
+
+/**********************************************************************************************************************/
+/**    Dataset configuration of a configuration image, see tau_readXmlDatasetConfig.
+ *  Map and datasets are part of the image and must not be freed with tau_freeXmlDatasetConfig. They are writable,
+ *  tau_initMarshall may sort them and cache dataset references in them.
+ *
+ *  @param[in]      pImgHnd           Handle of the image loaded by tau_loadCfgImage
+ *  @param[out]     pNumComId         Pointer to the number of entries in the ComId DatasetId mapping list
+ *  @param[out]     ppComIdDsIdMap    Pointer to an array of a structures of type TRDP_COMID_DSID_MAP_T
+ *  @param[out]     pNumDataset       Pointer to the number of datasets found in the configuration
+ *  @param[out]     papDataset        Pointer to an array of pointers to a structures of type TRDP_DATASET_T
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    Parameter error
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_readCfgImageDatasetConfig (
+    const TRDP_CFG_IMAGE_HANDLE_T   *pImgHnd,
+    UINT32                          *pNumComId,
+    TRDP_COMID_DSID_MAP_T           * *ppComIdDsIdMap,
+    UINT32                          *pNumDataset,
+    papTRDP_DATASET_T               papDataset
+    );
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TAU_CFGIMG_H */
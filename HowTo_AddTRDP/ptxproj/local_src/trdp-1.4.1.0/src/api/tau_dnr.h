@@ -17,6 +17,9 @@
  *
  * $Id: tau_dnr.h 1755 2018-08-07 12:10:03Z bloehr $
  *
+ *      AG 2026-10-19: tau_dnrGetInterval, tau_dnrProcess called by tlc_getInterval, tlc_process
+ *      AG 2026-10-19: tau_dnrPreResolve
+ *      AG 2026-10-19: Asynchronous resolution: tau_uri2AddrAsync, tau_dnrGetInterval, tau_dnrProcess
  *      BL 2018-08-07: Ticket #183 tau_getOwnIds moved here
  *      BL 2017-07-25: Ticket #125: tau_dnr: TCN DNS support missing
  *      BL 2015-12-14: Ticket #8: DNR client
@@ -30,6 +33,7 @@
  */
 
 #include "trdp_types.h"
+#include "tau_xml.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -60,6 +64,24 @@ typedef enum TRDP_DNR_OPTS {
     TRDP_DNR_OWN_THREAD     = 1,
     TRDP_DNR_STANDARD_DNS   = 2
 } TRDP_DNR_OPTS_T;
+
+/**********************************************************************************************************************/
+/**    Callback for the completion of an asynchronous URI resolution
+ *
+ *  @param[in]      pRefCon         user supplied context pointer
+ *  @param[in]      appHandle       Handle returned by tlc_openSession()
+ *  @param[in]      pUri            URI which was resolved
+ *  @param[in]      ipAddr          resolved IP address, VOS_INADDR_ANY on error
+ *  @param[in]      result          TRDP_NO_ERR, TRDP_UNRESOLVED_ERR or TRDP_TIMEOUT_ERR
+ *
+ *  @retval         none
+ */
+typedef void (*TRDP_DNR_CALLBACK_T)(
+    void                *pRefCon,
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pUri,
+    TRDP_IP_ADDR_T      ipAddr,
+    TRDP_ERR_T          result);
     
 /***********************************************************************************************************************
  * PROTOTYPES
@@ -110,6 +132,48 @@ EXT_DECL void tau_deInitDnr (
  */
 EXT_DECL TRDP_DNR_STATE_T tau_DNRstatus (TRDP_APP_SESSION_T  appHandle);
 
+/**********************************************************************************************************************/
+/**    Get the file descriptor and the next timeout of the resolver.
+ *  Called by tlc_getInterval once the resolver is initialised, an application only calls it to wait for the
+ *  resolver without processing the session.
+ *  With TCN-DNS it shortens the interval to zero, if a new request waits to be sent by tlc_process.
+ *  The interval is only shortened and the descriptor set only extended.
+ *
+ *  @param[in]      appHandle           Handle returned by tlc_openSession()
+ *  @param[in,out]  pInterval           Interval to the next timeout, shortened if needed
+ *  @param[in,out]  pFileDesc           Set of descriptors to wait for, the DNS socket is added
+ *  @param[in,out]  pNoDesc             Highest descriptor in the set
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      Parameter error
+ *  @retval         TRDP_NOINIT_ERR     DNR not initialised
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_dnrGetInterval (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_TIME_T         *pInterval,
+    TRDP_FDS_T          *pFileDesc,
+    INT32               *pNoDesc);
+
+/**********************************************************************************************************************/
+/**    Work loop of the resolver.
+ *  Receives DNS responses, handles the timeouts and delivers the results of finished resolutions.
+ *  Called by tlc_process once the resolver is initialised, an application only calls it to serve the resolver
+ *  without processing the session.
+ *
+ *  @param[in]      appHandle           Handle returned by tlc_openSession()
+ *  @param[in]      pRfds               Set of ready descriptors, NULL to check the DNS socket anyway
+ *  @param[in,out]  pCount              Number of ready descriptors, decremented if the DNS socket was ready
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     DNR not initialised
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_dnrProcess (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_FDS_T          *pRfds,
+    INT32               *pCount);
+
 
 /* ---------------------------------------------------------------------------- */
 
@@ -145,6 +209,80 @@ EXT_DECL TRDP_ERR_T tau_uri2Addr (
     const TRDP_URI_T     pUri);
 
 
+/**********************************************************************************************************************/
+/**    Start the resolution of a URI.
+ *  If the address is known, it is returned at once and the callback is not called. Otherwise a query is started and
+ *  the callback is called from tlc_process when it has finished.
+ *  URIs asked for while a TCN-DNS request is outstanding are sent together with the next request.
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession()
+ *  @param[out]     pAddr           Pointer to return the IP address, if known
+ *  @param[in]      pUri            Pointer to an URI or an IP Address string, NULL==own URI
+ *  @param[in]      pfCbFunction    Completion callback, NULL to only fill the cache
+ *  @param[in]      pRefCon         User context passed to the callback
+ *
+ *  @retval         TRDP_NO_ERR         address returned, no callback
+ *  @retval         TRDP_BLOCK_ERR      query started, result follows with the callback
+ *  @retval         TRDP_PARAM_ERR      Parameter error
+ *  @retval         TRDP_NOINIT_ERR     DNR not initialised
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_uri2AddrAsync (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_IP_ADDR_T      *pAddr,
+    const TRDP_URI_T    pUri,
+    TRDP_DNR_CALLBACK_T pfCbFunction,
+    void                *pRefCon);
+
+
+/**********************************************************************************************************************/
+/**    Resolve all URIs of a telegram configuration.
+ *
+ *  Resolves the destination and source URIs of the telegrams read by tau_readXmlInterfaceConfig() in one go:
+ *  TCN-DNS asks for up to 255 URIs with one request, standard DNS sends all queries in parallel.
+ *  Entries which are known and still valid are not asked for.
+ *  To be called after inauguration (topocount change), before the telegrams are published or requested again,
+ *  the following tau_uri2Addr calls are answered from the cache.
+ *  Blocks until all URIs have been resolved or the queries have timed out.
+ *
+ *  @param[in]      appHandle           Handle returned by tlc_openSession()
+ *  @param[in]      numExchgPar         Number of telegram configurations
+ *  @param[in]      pExchgPar           Array of telegram configurations
+ *  @param[out]     pNoOfUnresolved     Number of URIs which could not be resolved, may be NULL
+ *
+ *  @retval         TRDP_NO_ERR         all URIs resolved
+ *  @retval         TRDP_PARAM_ERR      Parameter error
+ *  @retval         TRDP_NOINIT_ERR     DNR not initialised
+ *  @retval         TRDP_UNRESOLVED_ERR at least one URI could not be resolved
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_dnrPreResolve (
+    TRDP_APP_SESSION_T      appHandle,
+    UINT32                  numExchgPar,
+    const TRDP_EXCHG_PAR_T  *pExchgPar,
+    UINT32                  *pNoOfUnresolved);
+
+/**********************************************************************************************************************/
+/**    Cancel pending resolutions.
+ *  The callbacks of all resolutions started with the given callback function and user context are not called.
+ *  The queries themselves are finished and their results are cached.
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession()
+ *  @param[in]      pfCbFunction    Completion callback given to tau_uri2AddrAsync
+ *  @param[in]      pRefCon         User context given to tau_uri2AddrAsync
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      Parameter error
+ *  @retval         TRDP_NOINIT_ERR     DNR not initialised
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_uri2AddrCancel (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_DNR_CALLBACK_T pfCbFunction,
+    const void          *pRefCon);
+
+
 /**********************************************************************************************************************/
 /**    Function to convert an IP address to a URI.
  *  Receives an IP-Address and translates it into the host part of the corresponding URI.
@@ -18,6 +18,8 @@
  *
  * $Id: tau_tti.h 1755 2018-08-07 12:10:03Z bloehr $
  *
+ *      AG 2026-10-19: Prefetch of the TTDB after a topology change
+ *      AG 2026-10-19: Change notification callback, consist infos returned in host byte order
  *      BL 2018-08-07: Ticket #183 tau_getOwnIds moved here
  *      BL 2016-02-18: Ticket #7: Add train topology information support
  */
@@ -49,6 +51,35 @@ extern "C" {
  * TYPEDEFS
  */
 
+/** Changes reported by the TTI change notification */
+typedef enum
+{
+    TRDP_TTI_EVENT_OP_TRN_STATE = 1,    /**< topocounts of the operational train directory state (PD 100) changed */
+    TRDP_TTI_EVENT_OP_TRN_DIR   = 2,    /**< operational train directory changed                                */
+    TRDP_TTI_EVENT_TRN_DIR      = 3,    /**< train directory changed                                            */
+    TRDP_TTI_EVENT_TRN_NET_DIR  = 4,    /**< train network directory changed                                    */
+    TRDP_TTI_EVENT_CST_INFO     = 5,    /**< consist info received or changed                                   */
+    TRDP_TTI_EVENT_TTDB_COMPLETE = 6    /**< prefetch finished, all data of the current topology is cached      */
+} TRDP_TTI_EVENT_T;
+
+/**********************************************************************************************************************/
+/**    Callback for changes of the cached train topology information
+ *
+ *  Called from within tlc_process() after the cache was updated, the getters may be called from the callback.
+ *
+ *  @param[in]      pRefCon         user supplied context pointer
+ *  @param[in]      appHandle       Handle returned by tlc_openSession()
+ *  @param[in]      event           what has changed
+ *  @param[in]      cstUUID         UUID of the consist for TRDP_TTI_EVENT_CST_INFO, NULL otherwise
+ *
+ *  @retval         none
+ */
+typedef void (*TRDP_TTI_CALLBACK_T)(
+    void                *pRefCon,
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_TTI_EVENT_T    event,
+    const TRDP_UUID_T   cstUUID);
+
 
 /***********************************************************************************************************************
  * PROTOTYPES
@@ -103,6 +134,44 @@ EXT_DECL TRDP_ERR_T tau_initTTIaccess (
 EXT_DECL void tau_deInitTTI (
     TRDP_APP_SESSION_T appHandle);
 
+/**********************************************************************************************************************/
+/**    Function to set the change notification callback
+ *
+ *  The callback is only called if the content of a directory or consist info has changed, repeated telegrams with
+ *  the same content are not reported.
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *  @param[in]      pfCbFunction    Callback for changes, NULL to remove the callback.
+ *  @param[in]      pRefCon         User context given to the callback
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  Parameter error
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_setTTIcallback (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_TTI_CALLBACK_T pfCbFunction,
+    void                *pRefCon);
+
+/**********************************************************************************************************************/
+/**    Function to enable the prefetch of the TTDB
+ *
+ *  If enabled, the operational train directory, the train directory, the train network directory and the consist
+ *  infos of all consists of the train are requested in one burst of MD requests whenever the topocounts change.
+ *  TRDP_TTI_EVENT_TTDB_COMPLETE is reported when all of them are cached for the current topocounts.
+ *  Enabling the prefetch starts a burst for the current topology.
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *  @param[in]      enable          TRUE to prefetch, FALSE to request consist infos on demand only (default)
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  Parameter error
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_setTTIprefetch (
+    TRDP_APP_SESSION_T  appHandle,
+    BOOL8               enable);
+
 /**********************************************************************************************************************/
 /**    Function to retrieve the operational train directory state.
  *
@@ -158,7 +227,9 @@ EXT_DECL TRDP_ERR_T tau_getTrDirectory (
  *
  *
  *  @param[in]      appHandle       Handle returned by tlc_openSession().
- *  @param[out]     pCstInfo        Pointer to a consist info structure to be returned.
+ *  @param[out]     pCstInfo        Pointer to a consist info structure to be returned (host byte order).
+ *                                  The lists point into the cache and stay valid until the consist info changes.
+ *                                  Of the properties only version and length are returned.
  *  @param[in]      cstUUID         UUID of the consist the consist info is rquested for.
  *
  *  @retval         TRDP_NO_ERR     no error
@@ -309,7 +380,8 @@ EXT_DECL TRDP_ERR_T tau_getVehInfo (
  *
  *
  *  @param[in]      appHandle       Handle returned by tlc_openSession().
- *  @param[out]     pCstInfo        Pointer to the consist info to be returned.
+ *  @param[out]     pCstInfo        Pointer to the consist info to be returned (host byte order).
+ *                                  The lists point into the cache and stay valid until the consist info changes.
  *  @param[in]      pCstLabel       Pointer to a consist label. NULL means own consist.
  *
  *  @retval         TRDP_NO_ERR     no error
@@ -337,7 +409,8 @@ EXT_DECL TRDP_ERR_T tau_getCstInfo (
  *                                   '00'B = not known (corrected vehicle)
  *                                   '01'B = same as operational train direction
  *                                   '10'B = inverse to operational train direction
- *  @param[in]      pVehLabel       vehLabel = NULL means own vehicle if cstLabel == NULL
+ *  @param[in]      pVehLabel       vehLabel = NULL means own vehicle if cstLabel == NULL,
+ *                                  first vehicle of the consist otherwise.
  *  @param[in]      pCstLabel       cstLabel = NULL means own consist
  *
  *  @retval         TRDP_NO_ERR     no error
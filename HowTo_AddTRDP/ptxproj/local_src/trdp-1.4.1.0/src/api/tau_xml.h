@@ -81,7 +81,7 @@ typedef struct
     UINT32              timeout;   /**< Timeout value in us, before considering received process data invalid */
     TRDP_TO_BEHAVIOR_T  toBehav;   /**< Behavior when received process data is invalid/timed out. */
     TRDP_FLAGS_T        flags;     /**< TRDP_FLAGS_MARSHALL, TRDP_FLAGS_REDUNDANT */
-    UINT16              offset;    /**< Offset-address for PD in traffic store for ladder topology */
+    UINT32              offset;    /**< Offset-address for PD in traffic store for ladder topology */
 } TRDP_PD_PAR_T;
 
 typedef struct
@@ -238,6 +238,22 @@ EXT_DECL TRDP_ERR_T tau_readXmlDeviceConfig (
     TRDP_IF_CONFIG_T            * *ppIfConfig
     );
 
+/**********************************************************************************************************************/
+/**    Function to read the Traffic Store size for ladder topology out of the XML configuration file.
+ *  The size is the traffic-store-size attribute of the device-configuration element, 0 if not configured.
+ *
+ *  @param[in]      pDocHnd             Handle of the XML document prepared by tau_prepareXmlDoc
+ *  @param[out]     pTrafficStoreSize   Configured Traffic Store size in bytes
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      Parameter error
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_readXmlTrafficStoreConfig (
+    const TRDP_XML_DOC_HANDLE_T *pDocHnd,
+    UINT32                      *pTrafficStoreSize
+    );
+
 /**********************************************************************************************************************/
 /**    Read the interface relevant telegram parameters (except data set configuration) out of the configuration file .
  *
@@ -292,6 +308,7 @@ EXT_DECL TRDP_ERR_T tau_readXmlDatasetConfig (
 /**    Function to free the memory for the DataSet configuration
  *
  *  Free the memory for the DataSet configuration which was allocated when parsing the XML configuration file.
+ *  All datasets of one configuration are released together, single datasets must not be freed.
  *
  *
  *  @param[in]      numComId            The number of entries in the ComId DatasetId mapping list
@@ -310,6 +327,8 @@ EXT_DECL void tau_freeXmlDatasetConfig (
 
 /**********************************************************************************************************************/
 /**    Free array of telegram configurations allocated by tau_readXmlInterfaceConfig
+ *
+ *  Releases the array together with all source, destination and parameter records read with it.
  *
  *  @param[in]      numExchgPar       Number of telegram configurations in the array
  *  @param[in]      pExchgPar         Pointer to array of telegram configurations
@@ -49,6 +49,12 @@ extern "C" {
 #define MD_SUPPORT  1
 #endif
 
+/** Tracepoints in tlc_process are only compiled in with TRDP_TRACE set (make TRACE=1)
+ */
+#ifndef TRDP_TRACE
+#define TRDP_TRACE  0
+#endif
+
 /***********************************************************************************************************************
  * TYPEDEFS
  */
@@ -259,6 +265,23 @@ EXT_DECL TRDP_ERR_T tlc_process (
     TRDP_FDS_T          *pRfds,
     INT32               *pCount);
 
+/**********************************************************************************************************************/
+/** Set the processing budget of tlc_process.
+ *  tlc_process always sends due PDs, supervises the PD timeouts and receives PDs. When the time spent in the call
+ *  exceeds the budget, MD sending, MD reception, MD timeouts and the statistics export are deferred to the next call
+ *  and tlc_getInterval returns a zero interval. The time spent in each phase is counted in
+ *  TRDP_STATISTICS_T.process in any case.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *  @param[in]      budget              budget in us, 0 = no budget
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_setProcessBudget (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              budget);
+
 /**********************************************************************************************************************/
 /** Get the interface address
  *
@@ -459,6 +482,10 @@ EXT_DECL TRDP_ERR_T tlp_request (
 /** Prepare for receiving PD messages.
  *  Subscribe to a specific PD ComID and source IP
  *
+ *  With TRDP_OPTION_MC_SOURCE_FILTER and a single source IP the group is joined for that source only (SSM).
+ *  The kernel applies this source filter per socket, not per group: other sockets bound to the same port
+ *  (e.g. of another session) and joined to the group for any source still receive it unfiltered.
+ *
  *  @param[in]      appHandle           the handle returned by tlc_openSession
  *  @param[out]     pSubHandle          return a handle for this subscription
  *  @param[in]      pUserRef            user supplied value returned within the info structure
@@ -579,7 +606,7 @@ EXT_DECL TRDP_ERR_T tlp_get (
  *  @param[in]      opTrnTopoCnt        operational topocount, != 0 for orientation/direction sensitive communication
  *  @param[in]      srcIpAddr           own IP address, 0 - srcIP will be set by the stack
  *  @param[in]      destIpAddr          where to send the packet to
- *  @param[in]      pktFlags            OPTIONS: TRDP_FLAGS_DEFAULT, TRDP_FLAGS_MARSHALL, TRDP_PLAGS_TCP
+ *  @param[in]      pktFlags            OPTIONS: TRDP_FLAGS_DEFAULT, TRDP_FLAGS_MARSHALL, TRDP_PLAGS_TCP, TRDP_FLAGS_STREAM
  *  @param[in]      pSendParam          optional pointer to send parameter, NULL - default parameters are used
  *  @param[in]      pData               pointer to packet data / dataset
  *  @param[in]      dataSize            size of packet data
@@ -621,7 +648,7 @@ EXT_DECL TRDP_ERR_T tlm_notify (
  *  @param[in]      opTrnTopoCnt        operational topocount, != 0 for orientation/direction sensitive communication
  *  @param[in]      srcIpAddr           own IP address, 0 - srcIP will be set by the stack
  *  @param[in]      destIpAddr          where to send the packet to
- *  @param[in]      pktFlags            OPTIONS: TRDP_FLAGS_DEFAULT, TRDP_FLAGS_MARSHALL, TRDP_PLAGS_TCP
+ *  @param[in]      pktFlags            OPTIONS: TRDP_FLAGS_DEFAULT, TRDP_FLAGS_MARSHALL, TRDP_PLAGS_TCP, TRDP_FLAGS_STREAM
  *  @param[in]      numReplies          number of expected replies, 0 if unknown
  *  @param[in]      replyTimeout        timeout for reply
  *  @param[in]      pSendParam          Pointer to send parameters, NULL to use default send parameters
@@ -709,7 +736,7 @@ EXT_DECL TRDP_ERR_T tlm_abortSession (
  *  @param[in]      srcIpAddr1          Source IP address, lower address in case of address range, set 0 if not used
  *  @param[in]      srcIpAddr2          upper address in case of address range, set to 0 if not used
  *  @param[in]      mcDestIpAddr        multicast group to listen on
- *  @param[in]      pktFlags            OPTION: TRDP_FLAGS_DEFAULT, TRDP_FLAGS_MARSHALL, TRDP_PLAGS_TCP
+ *  @param[in]      pktFlags            OPTION: TRDP_FLAGS_DEFAULT, TRDP_FLAGS_MARSHALL, TRDP_PLAGS_TCP, TRDP_FLAGS_STREAM
  *  @param[in]      srcURI              only functional group of source URI, set 0 if not used
  *  @param[in]      destURI             only functional group of destination URI, set 0 if not used
 
@@ -963,6 +990,21 @@ EXT_DECL TRDP_ERR_T tlc_getTcpListStatistics (
     UINT16                  *pNumList,
     TRDP_LIST_STATISTICS_T  *pStatistics);
 
+/**********************************************************************************************************************/
+/** Return TCP MD caller connection pool statistics.
+ *  Memory for statistics information must be provided by the user.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pStatistics         Pointer to the connection pool statistics
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ */
+EXT_DECL TRDP_ERR_T tlc_getTcpPoolStatistics (
+    TRDP_APP_SESSION_T          appHandle,
+    TRDP_TCP_POOL_STATISTICS_T  *pStatistics);
+
 #endif /* MD_SUPPORT    */
 
 /**********************************************************************************************************************/
@@ -1017,6 +1059,202 @@ EXT_DECL TRDP_ERR_T tlc_getJoinStatistics (
 EXT_DECL TRDP_ERR_T tlc_resetStatistics (
     TRDP_APP_SESSION_T appHandle);
 
+
+/**********************************************************************************************************************/
+/** Start the statistics export.
+ *  tlc_process writes a snapshot of the session statistics and of the per-ComId counters every interval into a
+ *  ring of slots in the shared memory area pKey. Monitoring processes attach to the area (vos_sharedOpen) and
+ *  read the latest snapshot with tlc_readStatisticsExport without locking the session.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pKey                name of the shared memory area
+ *  @param[in]      interval            snapshot interval in us, 0 = every tlc_process call
+ *  @param[in]      noOfSlots           number of slots in the ring (>= 2)
+ *  @param[in]      maxComIds           max. number of ComIds counted (1...65535)
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error or export already running
+ *  @retval         TRDP_MEM_ERR        out of memory or shared memory not available
+ */
+EXT_DECL TRDP_ERR_T tlc_startStatisticsExport (
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pKey,
+    UINT32              interval,
+    UINT32              noOfSlots,
+    UINT32              maxComIds);
+
+
+/**********************************************************************************************************************/
+/** Stop the statistics export and release the shared memory area.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_NODATA_ERR     export not running
+ */
+EXT_DECL TRDP_ERR_T tlc_stopStatisticsExport (
+    TRDP_APP_SESSION_T appHandle);
+
+
+/**********************************************************************************************************************/
+/** Read a snapshot from a statistics export area.
+ *  Does not need a session, the area may be mapped by another process. The snapshot is copied consistently,
+ *  the writer is never blocked.
+ *
+ *  @param[in]      pArea               start of the mapped export area
+ *  @param[in]      areaSize            size of the mapped area
+ *  @param[in,out]  pSnapshotNo         In: number of the snapshot to read, 0 = latest
+ *                                      Out: number of the snapshot read
+ *  @param[out]     pStatistics         session statistics of the snapshot
+ *  @param[in,out]  pNumComIds          In: size of pComIdStats in entries
+ *                                      Out: number of ComId counters returned
+ *  @param[out]     pComIdStats         per-ComId counters, may be NULL if *pNumComIds is 0
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error or area not (yet) initialised
+ *  @retval         TRDP_NODATA_ERR     no snapshot yet or requested snapshot already overwritten
+ *  @retval         TRDP_BLOCK_ERR      slot was rewritten while reading repeatedly, try again
+ *  @retval         TRDP_MEM_ERR        more ComId counters than requested, *pNumComIds are returned
+ */
+EXT_DECL TRDP_ERR_T tlc_readStatisticsExport (
+    const UINT8             *pArea,
+    UINT32                  areaSize,
+    UINT32                  *pSnapshotNo,
+    TRDP_STATISTICS_T       *pStatistics,
+    UINT32                  *pNumComIds,
+    TRDP_COMID_STATISTICS_T *pComIdStats);
+
+
+/**********************************************************************************************************************/
+/** Return a timing histogram of a publisher.
+ *  Needs TRDP_OPTION_HISTOGRAMS. The histograms are updated by tlc_process without locks, this function does not
+ *  lock the session either: it may be called from any thread while the publisher exists. The counts of a copy
+ *  taken during an update may differ by one.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pubHandle           the handle returned by tlp_publish
+ *  @param[in]      type                TRDP_HIST_SND_LATENESS or TRDP_HIST_CALLBACK
+ *  @param[out]     pHistogram          copy of the histogram
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOPUB_ERR      not published
+ *  @retval         TRDP_NODATA_ERR     no histograms kept (TRDP_OPTION_HISTOGRAMS not set)
+ */
+EXT_DECL TRDP_ERR_T tlc_getPubHistogram (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PUB_T          pubHandle,
+    TRDP_HIST_TYPE_T    type,
+    TRDP_HISTOGRAM_T    *pHistogram);
+
+
+/**********************************************************************************************************************/
+/** Return a timing histogram of a subscription.
+ *  Like tlc_getPubHistogram.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           the handle returned by tlp_subscribe
+ *  @param[in]      type                TRDP_HIST_RCV_INTERVAL or TRDP_HIST_CALLBACK
+ *  @param[out]     pHistogram          copy of the histogram
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOSUB_ERR      not subscribed
+ *  @retval         TRDP_NODATA_ERR     no histograms kept (TRDP_OPTION_HISTOGRAMS not set)
+ */
+EXT_DECL TRDP_ERR_T tlc_getSubsHistogram (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle,
+    TRDP_HIST_TYPE_T    type,
+    TRDP_HISTOGRAM_T    *pHistogram);
+
+
+/**********************************************************************************************************************/
+/** Return the smallest value counted in a histogram bucket.
+ *
+ *  @param[in]      bucketIdx           index of the bucket (< TRDP_HIST_BUCKETS)
+ *
+ *  @retval         value in us
+ */
+EXT_DECL UINT32 tlc_getHistogramBucketStart (
+    UINT32 bucketIdx);
+
+
+/**********************************************************************************************************************/
+/** Return a percentile of a histogram.
+ *  The result is the upper limit of the bucket holding the percentile, but not more than the largest value.
+ *
+ *  @param[in]      pHistogram          the histogram
+ *  @param[in]      permille            percentile in 1/1000 (e.g. 500 median, 999 for 99.9%)
+ *
+ *  @retval         value in us, 0 if the histogram is empty
+ */
+EXT_DECL UINT32 tlc_getHistogramPercentile (
+    const TRDP_HISTOGRAM_T  *pHistogram,
+    UINT32                  permille);
+
+#if TRDP_TRACE
+/**********************************************************************************************************************/
+/** Start tracing.
+ *  tlc_process writes an event at the begin and end of each of its phases and for every PD / MD packet sent,
+ *  received or timed out and every PD / MD callback into a ring in the shared memory area pKey. A diagnostic process
+ *  attaches to the area (vos_sharedOpen) and reads the events with tlc_readTrace without locking the session.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pKey                name of the shared memory area
+ *  @param[in]      noOfEvents          size of the ring, rounded up to a power of 2 (16...1048576)
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error or tracing already running
+ *  @retval         TRDP_MEM_ERR        out of memory or shared memory not available
+ */
+EXT_DECL TRDP_ERR_T tlc_startTrace (
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pKey,
+    UINT32              noOfEvents);
+
+/**********************************************************************************************************************/
+/** Stop tracing and remove the trace area.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_NODATA_ERR     tracing not running
+ */
+EXT_DECL TRDP_ERR_T tlc_stopTrace (
+    TRDP_APP_SESSION_T appHandle);
+
+/**********************************************************************************************************************/
+/** Read events from a trace area.
+ *  Reads the events from number *pNext on, events already overwritten are skipped and counted as lost.
+ *  Start with *pNext = 0 to read the oldest events still in the ring.
+ *
+ *  @param[in]      pArea               the trace area, attached with vos_sharedOpen
+ *  @param[in]      areaSize            size of the area
+ *  @param[in,out]  pNext               in: number of the first event to read, out: number of the next event
+ *  @param[out]     pEvents             buffer for the events
+ *  @param[in,out]  pNoOfEvents         in: size of the buffer, out: number of events read
+ *  @param[out]     pNumLost            number of events skipped, may be NULL
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error or no valid trace area
+ *  @retval         TRDP_NODATA_ERR     no new events
+ */
+EXT_DECL TRDP_ERR_T tlc_readTrace (
+    const UINT8         *pArea,
+    UINT32              areaSize,
+    UINT32              *pNext,
+    TRDP_TRACE_EVENT_T  *pEvents,
+    UINT32              *pNoOfEvents,
+    UINT32              *pNumLost);
+#endif /* TRDP_TRACE */
+
 #ifdef __cplusplus
 }
 #endif
@@ -191,6 +191,8 @@ typedef enum
 #define TRDP_FLAGS_CALLBACK     0x04u     /**< Use of callback function                                   */
 #define TRDP_FLAGS_TCP          0x08u     /**< Use TCP for message data                                   */
 #define TRDP_FLAGS_FORCE_CB     0x10u     /**< Force a callback for every received packet                 */
+#define TRDP_FLAGS_STREAM       0x20u     /**< TCP only: send user data in place (no copy), the buffer must
+                                               stay valid until the MD session is finished               */
 
 #define TRDP_INFINITE_TIMEOUT   0xffffffffu /**< Infinite reply timeout                                      */
 
@@ -426,6 +428,33 @@ typedef struct
 } TRDP_MD_STATISTICS_T;
 
 
+/** Structure containing PD receive filter statistics.
+ *  Packets dropped in user space because nobody subscribed them are counted in TRDP_PD_STATISTICS_T.numNoSubs.
+ */
+typedef struct
+{
+    UINT32  numKernelDrop;    /**< number of PD packets dropped by the kernel on PD receive sockets
+                                   (socket filter or receive buffer full) */
+    UINT32  numComIds;        /**< number of ComIds accepted by the current socket filter, 0 = no filter */
+    UINT32  numUpdate;        /**< number of socket filter updates */
+} TRDP_PD_FILTER_STATISTICS_T;
+
+#define TRDP_PROCESS_PHASES     8u      /**< number of tlc_process phases, see TRDP_TRACE_PHASE_T */
+
+/** Structure containing tlc_process timing statistics.
+ *  The time arrays are indexed by TRDP_TRACE_PHASE_T, index TRDP_TRACE_PROCESS holds tlc_process as a whole.
+ */
+typedef struct
+{
+    UINT32  budget;           /**< processing budget of tlc_process in us, 0 = none (tlc_setProcessBudget) */
+    UINT32  numCycles;        /**< number of tlc_process calls */
+    UINT32  numOverBudget;    /**< number of calls exceeding the budget */
+    UINT32  numOverrun;       /**< number of calls lasting longer than the interval returned by tlc_getInterval */
+    UINT32  numDeferred;      /**< number of calls deferring MD and statistics work to the next call */
+    UINT32  phaseTime[TRDP_PROCESS_PHASES]; /**< time spent in the phase in us (wraps) */
+    UINT32  phaseMax[TRDP_PROCESS_PHASES];  /**< longest time spent in the phase in us */
+} TRDP_PROCESS_STATISTICS_T;
+
 /** Structure containing all general memory, PD and MD statistics information. */
 typedef struct
 {
@@ -445,6 +474,9 @@ typedef struct
     TRDP_PD_STATISTICS_T    pd;           /**< pd statistics */
     TRDP_MD_STATISTICS_T    udpMd;        /**< UDP md statistics */
     TRDP_MD_STATISTICS_T    tcpMd;        /**< TCP md statistics */
+    TRDP_PD_FILTER_STATISTICS_T pdFilter; /**< pd receive filter statistics, local only:
+                                               not part of the statistics telegram */
+    TRDP_PROCESS_STATISTICS_T   process;  /**< tlc_process timing statistics, local only */
 } TRDP_STATISTICS_T;
 
 /** Table containing particular PD subscription information. */
@@ -487,6 +519,166 @@ typedef struct
     UINT32          numSessions; /**< Number of sessions  */
 } TRDP_LIST_STATISTICS_T;
 
+/** Information about the pool of TCP MD connections opened by callers */
+typedef struct
+{
+    UINT32          numOpen;        /**< Number of open connections */
+    UINT32          numIdle;        /**< Number of open connections without MD session, kept for reuse */
+    UINT32          numConnect;     /**< Number of new connections */
+    UINT32          numReuse;       /**< Number of MD sessions using an already open connection */
+    UINT32          numPipelined;   /**< Number of MD sessions sharing a connection with pending sessions */
+    UINT32          numIdleClosed;  /**< Number of connections closed after the idle connection timeout */
+} TRDP_TCP_POOL_STATISTICS_T;
+
+#define TRDP_HIST_SUB_BITS      2u                                  /**< bits of precision per power of 2 */
+#define TRDP_HIST_SUB_BUCKETS   (1u << TRDP_HIST_SUB_BITS)          /**< buckets per power of 2 */
+#define TRDP_HIST_BUCKETS       ((33u - TRDP_HIST_SUB_BITS) << TRDP_HIST_SUB_BITS)  /**< buckets up to 2^32 us */
+
+/** Kinds of timing histograms */
+typedef enum
+{
+    TRDP_HIST_RCV_INTERVAL  = 0,    /**< subscriber: time between two received packets */
+    TRDP_HIST_SND_LATENESS  = 1,    /**< publisher: cyclic packet sent later than due */
+    TRDP_HIST_CALLBACK      = 2     /**< publisher, subscriber: execution time of the user callback */
+} TRDP_HIST_TYPE_T;
+
+/** Histogram of times in us with logarithmic buckets.
+ *  Values below TRDP_HIST_SUB_BUCKETS have a bucket each, above each power of 2 is split into
+ *  TRDP_HIST_SUB_BUCKETS buckets of equal width (relative resolution 1/TRDP_HIST_SUB_BUCKETS).
+ *  tlc_getHistogramBucketStart returns the smallest value counted in a bucket.
+ */
+typedef struct
+{
+    UINT32  count;                          /**< number of values */
+    UINT32  min;                            /**< smallest value in us */
+    UINT32  max;                            /**< largest value in us */
+    UINT32  reserved;                       /**< reserved, 0 */
+    UINT32  bucket[TRDP_HIST_BUCKETS];      /**< number of values per bucket */
+} TRDP_HISTOGRAM_T;
+
+/** ComId of the histogram telegram. It is stack specific and therefore outside the ComIds reserved by
+ *  IEC 61375-2-3; define it at build time if it collides with a ComId of the application.
+ */
+#ifndef TRDP_HIST_STATISTICS_COMID
+#define TRDP_HIST_STATISTICS_COMID  0x7FFF0001u
+#endif
+
+/** Histogram telegram TRDP_HIST_STATISTICS_COMID (network byte order), the reply to a
+ *  TRDP_STATISTICS_PULL_COMID request with replyComId TRDP_HIST_STATISTICS_COMID.
+ *  The request data contains comId and role (UINT32 each, network byte order) of the wanted element.
+ */
+typedef struct
+{
+    UINT32              comId;              /**< ComId of the publisher or subscription */
+    UINT32              role;               /**< 0 = subscription, 1 = publisher */
+    UINT32              status;             /**< 0 = ok, 1 = not found, 2 = no histograms kept */
+    UINT32              reserved;           /**< reserved, 0 */
+    TRDP_HISTOGRAM_T    cycle;              /**< TRDP_HIST_RCV_INTERVAL or TRDP_HIST_SND_LATENESS */
+    TRDP_HISTOGRAM_T    callback;           /**< TRDP_HIST_CALLBACK */
+} TRDP_HIST_STATISTICS_T;
+
+/** Traffic counters of one ComId, kept while the statistics export is running */
+typedef struct
+{
+    UINT32          comId;          /**< ComId */
+    UINT32          pdNumSend;      /**< Number of sent PD packets */
+    UINT32          pdNumRcv;       /**< Number of received PD packets */
+    UINT32          pdNumMissed;    /**< Number of PD packets skipped (sequence counter gaps) */
+    UINT32          pdNumTimeout;   /**< Number of PD timeouts */
+    UINT32          mdNumSend;      /**< Number of sent MD packets (UDP and TCP) */
+    UINT32          mdNumRcv;       /**< Number of received MD packets (UDP and TCP) */
+    UINT32          mdNumTimeout;   /**< Number of MD reply and confirm timeouts */
+} TRDP_COMID_STATISTICS_T;
+
+#define TRDP_STATS_EXPORT_MAGIC     0x54535845u     /**< 'TSXE', valid export area */
+#define TRDP_STATS_EXPORT_VERSION   2u              /**< layout version of the export area */
+
+/** Header of the statistics export area (shared memory, host byte order).
+ *  The header is followed by noOfSlots slots of slotSize bytes, starting at slotOffset. Snapshot n (n >= 1) is
+ *  stored in slot (n - 1) % noOfSlots, lastSnapshot is the number of the latest complete snapshot (0 = none).
+ */
+typedef struct
+{
+    UINT32          magic;              /**< TRDP_STATS_EXPORT_MAGIC, set when the area is initialised */
+    UINT32          version;            /**< TRDP_STATS_EXPORT_VERSION */
+    UINT32          slotOffset;         /**< offset of the first slot from the start of the area */
+    UINT32          slotSize;           /**< size of one slot including its ComId counters */
+    UINT32          noOfSlots;          /**< number of slots in the ring */
+    UINT32          maxComIds;          /**< max. number of ComId counters per slot */
+    UINT32          interval;           /**< snapshot interval in us */
+    UINT32          lastSnapshot;       /**< number of the latest snapshot written, 0 = none */
+    UINT32          numComIdOverflow;   /**< number of packets not counted per ComId (ComId table full) */
+    UINT32          reserved[7];        /**< reserved, 0 */
+} TRDP_STATS_EXPORT_HDR_T;
+
+/** One slot of the statistics export ring, followed by maxComIds TRDP_COMID_STATISTICS_T */
+typedef struct
+{
+    UINT32              seq;            /**< sequence lock: odd while the slot is written */
+    UINT32              snapshotNo;     /**< number of the snapshot in this slot */
+    UINT32              noOfComIds;     /**< valid ComId counters following the slot */
+    UINT32              reserved;       /**< reserved, 0 */
+    TRDP_STATISTICS_T   stats;          /**< session statistics at the time of the snapshot */
+} TRDP_STATS_EXPORT_SLOT_T;
+
+#define TRDP_TRACE_MAGIC            0x45435254u     /**< 'TRCE', valid trace area */
+#define TRDP_TRACE_VERSION          1u              /**< layout version of the trace area */
+
+/** Phases of tlc_process marked by TRDP_TRACE_BEGIN / TRDP_TRACE_END events */
+typedef enum
+{
+    TRDP_TRACE_PROCESS      = 0,        /**< tlc_process as a whole */
+    TRDP_TRACE_PD_SEND      = 1,        /**< sending due PD */
+    TRDP_TRACE_PD_TIMEOUT   = 2,        /**< PD receive timeouts */
+    TRDP_TRACE_MD_SEND      = 3,        /**< sending pending MD */
+    TRDP_TRACE_PD_RECEIVE   = 4,        /**< PD reception */
+    TRDP_TRACE_MD_RECEIVE   = 5,        /**< MD reception */
+    TRDP_TRACE_MD_TIMEOUT   = 6,        /**< MD timeouts */
+    TRDP_TRACE_STATS        = 7         /**< statistics export */
+} TRDP_TRACE_PHASE_T;
+
+/** Types of trace events */
+typedef enum
+{
+    TRDP_TRACE_BEGIN        = 1,        /**< a phase begins, phase is set */
+    TRDP_TRACE_END          = 2,        /**< a phase ends, phase is set */
+    TRDP_TRACE_PD_SENT      = 3,        /**< PD sent, comId and size set */
+    TRDP_TRACE_PD_RECEIVED  = 4,        /**< PD received, comId and size set */
+    TRDP_TRACE_PD_TIMED_OUT = 5,        /**< PD subscription timed out, comId set */
+    TRDP_TRACE_MD_SENT      = 6,        /**< MD sent, comId and size set */
+    TRDP_TRACE_MD_RECEIVED  = 7,        /**< MD received, comId and size set */
+    TRDP_TRACE_MD_TIMED_OUT = 8,        /**< MD reply or confirm timed out, comId set */
+    TRDP_TRACE_CB_BEGIN     = 9,        /**< user callback called, comId set */
+    TRDP_TRACE_CB_END       = 10        /**< user callback returned, comId set */
+} TRDP_TRACE_TYPE_T;
+
+/** Header of the trace area (shared memory, host byte order).
+ *  The header is followed by noOfEvents events starting at eventOffset. Event n (counted from 0) is stored at
+ *  index n % noOfEvents, numEvents is the number of events written so far.
+ */
+typedef struct
+{
+    UINT32          magic;              /**< TRDP_TRACE_MAGIC, set when the area is initialised */
+    UINT32          version;            /**< TRDP_TRACE_VERSION */
+    UINT32          eventOffset;        /**< offset of the first event from the start of the area */
+    UINT32          eventSize;          /**< size of one event */
+    UINT32          noOfEvents;         /**< number of events in the ring (power of 2) */
+    UINT32          numEvents;          /**< number of events written */
+    UINT32          reserved[2];        /**< reserved, 0 */
+} TRDP_TRACE_HDR_T;
+
+/** One trace event */
+typedef struct
+{
+    UINT32          seq;                /**< number of the event + 1, 0 while it is written */
+    UINT16          type;               /**< TRDP_TRACE_TYPE_T */
+    UINT16          phase;              /**< TRDP_TRACE_PHASE_T of begin and end events */
+    UINT32          comId;              /**< ComId of packet and callback events */
+    UINT32          size;               /**< packet size of send and receive events */
+    UINT32          sec;                /**< time stamp (monotonic clock), seconds */
+    UINT32          usec;               /**< time stamp, microseconds */
+} TRDP_TRACE_EVENT_T;
+
 
 /** A table containing PD redundant group information */
 typedef struct
@@ -653,6 +845,8 @@ typedef struct
     UINT16              udpPort;                /**< Port to be used for UDP MD communication   */
     UINT16              tcpPort;                /**< Port to be used for TCP MD communication   */
     UINT32              maxNumSessions;         /**< Maximal number of replier sessions         */
+    UINT32              maxTcpPipeline;         /**< Max. number of concurrent caller sessions
+                                                     sharing one TCP connection, 1 = no pipelining */
 } TRDP_MD_CONFIG_T;
 
 
@@ -686,6 +880,15 @@ typedef struct
                                                   Default: Allow                                            */
 #define TRDP_OPTION_NO_UDP_CHK          0x10u   /**< Suppress UDP CRC generation
                                                   Default: Compute UDP CRC                                  */
+#define TRDP_OPTION_MC_SOURCE_FILTER    0x20u   /**< Join multicast groups for the subscribed source only (SSM),
+                                                  if a subscription names a single source IP
+                                                  Default: Join for any source, filter in the stack         */
+#define TRDP_OPTION_PD_KERNEL_FILTER    0x40u   /**< Attach a socket filter to the PD receive sockets which lets
+                                                  the kernel drop PD packets of not subscribed ComIds
+                                                  Default: All packets are passed to the stack              */
+#define TRDP_OPTION_HISTOGRAMS          0x80u   /**< Keep timing histograms for each publisher and subscription
+                                                  (tlc_getPubHistogram, tlc_getSubsHistogram)
+                                                  Default: OFF                                              */
 typedef UINT8 TRDP_OPTION_T;
 
 /**********************************************************************************************************************/
@@ -0,0 +1,1034 @@
+/**********************************************************************************************************************/
+/**
+ * @file            tau_cfgimg.c
+ *
+ * @brief           Precompiled binary image of the XML configuration
+ *
+ * @details         The image consists of a header, the configuration data and a relocation table. Pointers inside the
+ *                  configuration data are stored as offsets from the start of the image, the relocation table lists
+ *                  the offsets of all pointers which are not NULL. Loading maps the file copy-on-write and adds the
+ *                  mapping address to every listed pointer, no other data is touched or copied.
+ *
+ *                  Image layout:
+ *                  - TAU_CFG_IMAGE_HEADER_T
+ *                  - TAU_CFG_IMAGE_ROOT_T and all data it refers to, aligned to 8 bytes
+ *                  - relocation table (UINT32 offsets)
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#ifdef POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include "trdp_types.h"
+#include "trdp_utils.h"
+#include "vos_utils.h"
+#include "tau_xml.h"
+#include "tau_cfgimg.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define CFG_IMAGE_ALIGN         8u
+#define CFG_IMAGE_ROUND(size)   (((size) + CFG_IMAGE_ALIGN - 1u) & ~(CFG_IMAGE_ALIGN - 1u))
+#define CFG_IMAGE_INITIAL_SIZE  0x10000u        /* start size of the build buffer, doubled as needed */
+#define CFG_IMAGE_MAX_SIZE      0x7FFFFFF0u
+#define CFG_IMAGE_MAGIC_SWAPPED 0x54434647u     /* TAU_CFG_IMAGE_MAGIC as written on a host of other byte order */
+
+/***********************************************************************************************************************
+ * TYPEDEFS
+ */
+
+/** Image header, at offset 0 */
+typedef struct
+{
+    UINT32  magic;          /**< TAU_CFG_IMAGE_MAGIC, a byte swapped magic denotes an image of other byte order */
+    UINT16  version;        /**< TAU_CFG_IMAGE_VERSION */
+    UINT16  ptrSize;        /**< sizeof(void *) of the writer */
+    UINT32  layout;         /**< CRC of the structure sizes of the writer */
+    UINT32  size;           /**< size of the whole image */
+    UINT32  crc;            /**< CRC of the image following the header, before relocation */
+    UINT32  rootOffset;     /**< offset of TAU_CFG_IMAGE_ROOT_T */
+    UINT32  relocOffset;    /**< offset of the relocation table */
+    UINT32  relocCount;     /**< number of entries in the relocation table */
+} TAU_CFG_IMAGE_HEADER_T;
+
+/** Configuration of one interface */
+typedef struct
+{
+    TRDP_PROCESS_CONFIG_T   processConfig;
+    TRDP_PD_CONFIG_T        pdConfig;
+    TRDP_MD_CONFIG_T        mdConfig;
+    UINT32                  numExchgPar;
+    TRDP_EXCHG_PAR_T        *pExchgPar;
+} TAU_CFG_IMAGE_IF_T;
+
+/** Root of the configuration data */
+typedef struct
+{
+    TRDP_MEM_CONFIG_T       memConfig;
+    TRDP_DBG_CONFIG_T       dbgConfig;
+    UINT32                  trafficStoreSize;
+    UINT32                  numComPar;
+    TRDP_COM_PAR_T          *pComPar;
+    UINT32                  numIfConfig;
+    TRDP_IF_CONFIG_T        *pIfConfig;
+    TAU_CFG_IMAGE_IF_T      *pInterface;        /**< one entry per pIfConfig entry, same order */
+    UINT32                  numComId;
+    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap;
+    UINT32                  numDataset;
+    TRDP_DATASET_T          * *apDataset;
+} TAU_CFG_IMAGE_ROOT_T;
+
+/** Loaded image */
+struct TAU_CFG_IMAGE
+{
+    UINT8                       *pBase;
+    UINT32                      size;
+    BOOL8                       mapped;
+    const TAU_CFG_IMAGE_ROOT_T  *pRoot;
+};
+
+/** Image under construction, all positions are offsets because the buffer moves when it grows */
+typedef struct
+{
+    UINT8       *pBuf;
+    UINT32      size;
+    UINT32      used;
+    UINT32      *pReloc;
+    UINT32      relocSize;
+    UINT32      relocCount;
+    TRDP_ERR_T  err;
+} CFG_IMAGE_BUILD_T;
+
+/***********************************************************************************************************************
+ *  LOCAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/** Fingerprint of the structure layout, images are only valid for the same layout.
+ *
+ *  @retval         CRC over the sizes of all structures in the image
+ */
+static UINT32 cfgImageLayout (void)
+{
+    const UINT32 layout[] =
+    {
+        (UINT32) sizeof(TAU_CFG_IMAGE_HEADER_T), (UINT32) sizeof(TAU_CFG_IMAGE_ROOT_T),
+        (UINT32) sizeof(TAU_CFG_IMAGE_IF_T), (UINT32) sizeof(TRDP_EXCHG_PAR_T), (UINT32) sizeof(TRDP_PD_PAR_T),
+        (UINT32) sizeof(TRDP_MD_PAR_T), (UINT32) sizeof(TRDP_SRC_T), (UINT32) sizeof(TRDP_DEST_T),
+        (UINT32) sizeof(TRDP_SDT_PAR_T), (UINT32) sizeof(TRDP_DATASET_T), (UINT32) sizeof(TRDP_DATASET_ELEMENT_T),
+        (UINT32) sizeof(TRDP_COMID_DSID_MAP_T), (UINT32) sizeof(TRDP_COM_PAR_T), (UINT32) sizeof(TRDP_IF_CONFIG_T),
+        (UINT32) sizeof(TRDP_MEM_CONFIG_T), (UINT32) sizeof(TRDP_DBG_CONFIG_T),
+        (UINT32) sizeof(TRDP_PROCESS_CONFIG_T), (UINT32) sizeof(TRDP_PD_CONFIG_T), (UINT32) sizeof(TRDP_MD_CONFIG_T)
+    };
+
+    return vos_crc32(INITFCS, (const UINT8 *) layout, (UINT32) sizeof(layout));
+}
+
+/**********************************************************************************************************************/
+/** Allocate zeroed space in the image under construction.
+ *
+ *  @param[in]      pBuild      Image under construction
+ *  @param[in]      size        Number of bytes
+ *
+ *  @retval         offset of the space, 0 for size 0 or on error (offset 0 is the header)
+ */
+static UINT32 cfgImageAlloc (
+    CFG_IMAGE_BUILD_T   *pBuild,
+    UINT32              size)
+{
+    UINT32  offset  = pBuild->used;
+    UINT32  newSize = pBuild->size;
+    UINT8   *pNew;
+
+    if (size == 0u)
+    {
+        return 0u;
+    }
+    if (pBuild->err != TRDP_NO_ERR)
+    {
+        return 0u;
+    }
+    if (size > CFG_IMAGE_MAX_SIZE - offset)
+    {
+        pBuild->err = TRDP_MEM_ERR;
+        return 0u;
+    }
+    size = CFG_IMAGE_ROUND(size);
+    while (offset + size > newSize)
+    {
+        newSize = (newSize == 0u) ? CFG_IMAGE_INITIAL_SIZE : newSize * 2u;
+    }
+    if (newSize != pBuild->size)
+    {
+        /* No realloc in VOS: move the data into a larger block */
+        pNew = (UINT8 *) vos_memAlloc(newSize);
+        if (pNew == NULL)
+        {
+            pBuild->err = TRDP_MEM_ERR;
+            return 0u;
+        }
+        if (pBuild->pBuf != NULL)
+        {
+            memcpy(pNew, pBuild->pBuf, pBuild->size);
+            vos_memFree(pBuild->pBuf);
+        }
+        memset(pNew + pBuild->size, 0, newSize - pBuild->size);
+        pBuild->pBuf    = pNew;
+        pBuild->size    = newSize;
+    }
+    pBuild->used += size;
+    return offset;
+}
+
+/**********************************************************************************************************************/
+/** Copy data into the image under construction.
+ *
+ *  @param[in]      pBuild      Image under construction
+ *  @param[in]      pData       Data to copy, may be NULL
+ *  @param[in]      size        Number of bytes
+ *
+ *  @retval         offset of the copy, 0 if pData is NULL or on error
+ */
+static UINT32 cfgImageCopy (
+    CFG_IMAGE_BUILD_T   *pBuild,
+    const void          *pData,
+    UINT32              size)
+{
+    UINT32 offset;
+
+    if (pData == NULL)
+    {
+        return 0u;
+    }
+    offset = cfgImageAlloc(pBuild, size);
+    if (offset != 0u)
+    {
+        memcpy(pBuild->pBuf + offset, pData, size);
+    }
+    return offset;
+}
+
+/**********************************************************************************************************************/
+/** Copy a string into the image under construction.
+ *
+ *  @param[in]      pBuild      Image under construction
+ *  @param[in]      pStr        String to copy, may be NULL
+ *
+ *  @retval         offset of the copy, 0 if pStr is NULL or on error
+ */
+static UINT32 cfgImageString (
+    CFG_IMAGE_BUILD_T   *pBuild,
+    const CHAR8         *pStr)
+{
+    return (pStr == NULL) ? 0u : cfgImageCopy(pBuild, pStr, (UINT32) strlen(pStr) + 1u);
+}
+
+/**********************************************************************************************************************/
+/** Set a pointer in the image under construction and list it in the relocation table.
+ *
+ *  @param[in]      pBuild      Image under construction
+ *  @param[in]      field       Offset of the pointer
+ *  @param[in]      target      Offset it points to, 0 for NULL
+ *
+ */
+static void cfgImageSetPtr (
+    CFG_IMAGE_BUILD_T   *pBuild,
+    UINT32              field,
+    UINT32              target)
+{
+    UINT32      *pNew;
+    UINT32      newSize;
+    uintptr_t   value = (uintptr_t) target;
+
+    if ((pBuild->err != TRDP_NO_ERR) || (field == 0u))
+    {
+        return;
+    }
+    memcpy(pBuild->pBuf + field, &value, sizeof(value));
+    if (target == 0u)
+    {
+        return;
+    }
+    if (pBuild->relocCount == pBuild->relocSize)
+    {
+        newSize = (pBuild->relocSize == 0u) ? 1024u : 2u * pBuild->relocSize;
+        pNew    = (UINT32 *) vos_memAlloc(newSize * (UINT32) sizeof(UINT32));
+        if (pNew == NULL)
+        {
+            pBuild->err = TRDP_MEM_ERR;
+            return;
+        }
+        if (pBuild->pReloc != NULL)
+        {
+            memcpy(pNew, pBuild->pReloc, pBuild->relocCount * sizeof(UINT32));
+            vos_memFree(pBuild->pReloc);
+        }
+        pBuild->pReloc      = pNew;
+        pBuild->relocSize   = newSize;
+    }
+    pBuild->pReloc[pBuild->relocCount++] = field;
+}
+
+/**********************************************************************************************************************/
+/** Copy a telegram parameter set with everything it refers to into the image under construction.
+ *
+ *  @param[in]      pBuild      Image under construction
+ *  @param[in]      exchg       Offset of the TRDP_EXCHG_PAR_T in the image
+ *  @param[in]      pExchgPar   Telegram parameters read from XML
+ *
+ */
+static void cfgImageTelegram (
+    CFG_IMAGE_BUILD_T       *pBuild,
+    UINT32                  exchg,
+    const TRDP_EXCHG_PAR_T  *pExchgPar)
+{
+    UINT32  array;
+    UINT32  item;
+    UINT32  i;
+
+    if (exchg == 0u)
+    {
+        return;
+    }
+    memcpy(pBuild->pBuf + exchg, pExchgPar, sizeof(TRDP_EXCHG_PAR_T));
+    cfgImageSetPtr(pBuild, exchg + offsetof(TRDP_EXCHG_PAR_T, pMdPar),
+                   cfgImageCopy(pBuild, pExchgPar->pMdPar, sizeof(TRDP_MD_PAR_T)));
+    cfgImageSetPtr(pBuild, exchg + offsetof(TRDP_EXCHG_PAR_T, pPdPar),
+                   cfgImageCopy(pBuild, pExchgPar->pPdPar, sizeof(TRDP_PD_PAR_T)));
+
+    array = (pExchgPar->pDest == NULL) ? 0u : cfgImageAlloc(pBuild, pExchgPar->destCnt * sizeof(TRDP_DEST_T));
+    cfgImageSetPtr(pBuild, exchg + offsetof(TRDP_EXCHG_PAR_T, pDest), array);
+    for (i = 0u; (array != 0u) && (i < pExchgPar->destCnt) && (pBuild->err == TRDP_NO_ERR); i++)
+    {
+        const TRDP_DEST_T *pDest = &pExchgPar->pDest[i];
+
+        item = array + i * (UINT32) sizeof(TRDP_DEST_T);
+        memcpy(pBuild->pBuf + item, pDest, sizeof(TRDP_DEST_T));
+        cfgImageSetPtr(pBuild, item + offsetof(TRDP_DEST_T, pSdtPar),
+                       cfgImageCopy(pBuild, pDest->pSdtPar, sizeof(TRDP_SDT_PAR_T)));
+        cfgImageSetPtr(pBuild, item + offsetof(TRDP_DEST_T, pUriUser),
+                       cfgImageCopy(pBuild, pDest->pUriUser, sizeof(TRDP_URI_USER_T)));
+        cfgImageSetPtr(pBuild, item + offsetof(TRDP_DEST_T, pUriHost),
+                       cfgImageString(pBuild, (const CHAR8 *) pDest->pUriHost));
+    }
+
+    array = (pExchgPar->pSrc == NULL) ? 0u : cfgImageAlloc(pBuild, pExchgPar->srcCnt * sizeof(TRDP_SRC_T));
+    cfgImageSetPtr(pBuild, exchg + offsetof(TRDP_EXCHG_PAR_T, pSrc), array);
+    for (i = 0u; (array != 0u) && (i < pExchgPar->srcCnt) && (pBuild->err == TRDP_NO_ERR); i++)
+    {
+        const TRDP_SRC_T *pSrc = &pExchgPar->pSrc[i];
+
+        item = array + i * (UINT32) sizeof(TRDP_SRC_T);
+        memcpy(pBuild->pBuf + item, pSrc, sizeof(TRDP_SRC_T));
+        cfgImageSetPtr(pBuild, item + offsetof(TRDP_SRC_T, pSdtPar),
+                       cfgImageCopy(pBuild, pSrc->pSdtPar, sizeof(TRDP_SDT_PAR_T)));
+        cfgImageSetPtr(pBuild, item + offsetof(TRDP_SRC_T, pUriUser),
+                       cfgImageCopy(pBuild, pSrc->pUriUser, sizeof(TRDP_URI_USER_T)));
+        cfgImageSetPtr(pBuild, item + offsetof(TRDP_SRC_T, pUriHost1),
+                       cfgImageString(pBuild, (const CHAR8 *) pSrc->pUriHost1));
+        cfgImageSetPtr(pBuild, item + offsetof(TRDP_SRC_T, pUriHost2),
+                       cfgImageString(pBuild, (const CHAR8 *) pSrc->pUriHost2));
+    }
+}
+
+/**********************************************************************************************************************/
+/** Read the interface configurations out of the XML document into the image under construction.
+ *
+ *  @param[in]      pBuild      Image under construction
+ *  @param[in]      root        Offset of the TAU_CFG_IMAGE_ROOT_T in the image
+ *  @param[in]      pDocHnd     Handle of the XML document
+ *  @param[in]      numIfConfig Number of interfaces
+ *  @param[in]      pIfConfig   Interfaces read from XML
+ *
+ */
+static void cfgImageInterfaces (
+    CFG_IMAGE_BUILD_T           *pBuild,
+    UINT32                      root,
+    const TRDP_XML_DOC_HANDLE_T *pDocHnd,
+    UINT32                      numIfConfig,
+    const TRDP_IF_CONFIG_T      *pIfConfig)
+{
+    TAU_CFG_IMAGE_IF_T  ifCfg;
+    TRDP_EXCHG_PAR_T    *pExchgPar;
+    UINT32              interfaces;
+    UINT32              exchg;
+    UINT32              i, j;
+    TRDP_ERR_T          err;
+
+    interfaces = cfgImageAlloc(pBuild, numIfConfig * sizeof(TAU_CFG_IMAGE_IF_T));
+    cfgImageSetPtr(pBuild, root + offsetof(TAU_CFG_IMAGE_ROOT_T, pInterface), interfaces);
+    for (i = 0u; (i < numIfConfig) && (pBuild->err == TRDP_NO_ERR); i++)
+    {
+        memset(&ifCfg, 0, sizeof(ifCfg));
+        pExchgPar = NULL;
+        err = tau_readXmlInterfaceConfig(pDocHnd, pIfConfig[i].ifName, &ifCfg.processConfig, &ifCfg.pdConfig,
+                                         &ifCfg.mdConfig, &ifCfg.numExchgPar, &pExchgPar);
+        if (err != TRDP_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_ERROR, "Reading interface %s failed (%d)\n", pIfConfig[i].ifName, err);
+            pBuild->err = err;
+            break;
+        }
+        /* Callbacks and references are application specific */
+        ifCfg.pdConfig.pfCbFunction = NULL;
+        ifCfg.pdConfig.pRefCon      = NULL;
+        ifCfg.mdConfig.pfCbFunction = NULL;
+        ifCfg.mdConfig.pRefCon      = NULL;
+        ifCfg.pExchgPar = NULL;
+        memcpy(pBuild->pBuf + interfaces + i * sizeof(TAU_CFG_IMAGE_IF_T), &ifCfg, sizeof(ifCfg));
+
+        exchg = (pExchgPar == NULL) ? 0u : cfgImageAlloc(pBuild, ifCfg.numExchgPar * sizeof(TRDP_EXCHG_PAR_T));
+        cfgImageSetPtr(pBuild,
+                       interfaces + i * (UINT32) sizeof(TAU_CFG_IMAGE_IF_T) + offsetof(TAU_CFG_IMAGE_IF_T, pExchgPar),
+                       exchg);
+        for (j = 0u; (exchg != 0u) && (j < ifCfg.numExchgPar); j++)
+        {
+            cfgImageTelegram(pBuild, exchg + j * (UINT32) sizeof(TRDP_EXCHG_PAR_T), &pExchgPar[j]);
+        }
+        tau_freeTelegrams(ifCfg.numExchgPar, pExchgPar);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Read the dataset configuration out of the XML document into the image under construction.
+ *
+ *  @param[in]      pBuild      Image under construction
+ *  @param[in]      root        Offset of the TAU_CFG_IMAGE_ROOT_T in the image
+ *  @param[in]      pDocHnd     Handle of the XML document
+ *
+ */
+static void cfgImageDatasets (
+    CFG_IMAGE_BUILD_T           *pBuild,
+    UINT32                      root,
+    const TRDP_XML_DOC_HANDLE_T *pDocHnd)
+{
+    TAU_CFG_IMAGE_ROOT_T    *pRoot;
+    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap  = NULL;
+    TRDP_DATASET_T          * *apDataset    = NULL;
+    UINT32                  numComId        = 0u;
+    UINT32                  numDataset      = 0u;
+    UINT32                  array;
+    UINT32                  dataset;
+    UINT32                  element;
+    UINT32                  i, j;
+    TRDP_ERR_T              err;
+
+    err = tau_readXmlDatasetConfig(pDocHnd, &numComId, &pComIdDsIdMap, &numDataset, &apDataset);
+    if (err != TRDP_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_ERROR, "Reading dataset configuration failed (%d)\n", err);
+        pBuild->err = err;
+        return;
+    }
+
+    array = cfgImageCopy(pBuild, pComIdDsIdMap, numComId * sizeof(TRDP_COMID_DSID_MAP_T));
+    cfgImageSetPtr(pBuild, root + offsetof(TAU_CFG_IMAGE_ROOT_T, pComIdDsIdMap), array);
+
+    array = (apDataset == NULL) ? 0u : cfgImageAlloc(pBuild, numDataset * sizeof(TRDP_DATASET_T *));
+    cfgImageSetPtr(pBuild, root + offsetof(TAU_CFG_IMAGE_ROOT_T, apDataset), array);
+    for (i = 0u; (array != 0u) && (i < numDataset) && (pBuild->err == TRDP_NO_ERR); i++)
+    {
+        dataset = cfgImageCopy(pBuild, apDataset[i],
+                               sizeof(TRDP_DATASET_T) + apDataset[i]->numElement * sizeof(TRDP_DATASET_ELEMENT_T));
+        cfgImageSetPtr(pBuild, array + i * (UINT32) sizeof(TRDP_DATASET_T *), dataset);
+        for (j = 0u; (dataset != 0u) && (j < apDataset[i]->numElement); j++)
+        {
+            element = dataset + (UINT32) (sizeof(TRDP_DATASET_T) + j * sizeof(TRDP_DATASET_ELEMENT_T));
+            cfgImageSetPtr(pBuild, element + offsetof(TRDP_DATASET_ELEMENT_T, name),
+                           cfgImageString(pBuild, apDataset[i]->pElement[j].name));
+            cfgImageSetPtr(pBuild, element + offsetof(TRDP_DATASET_ELEMENT_T, unit),
+                           cfgImageString(pBuild, apDataset[i]->pElement[j].unit));
+            cfgImageSetPtr(pBuild, element + offsetof(TRDP_DATASET_ELEMENT_T, pCachedDS), 0u);
+        }
+    }
+    if (pBuild->err == TRDP_NO_ERR)
+    {
+        pRoot = (TAU_CFG_IMAGE_ROOT_T *) (pBuild->pBuf + root);
+        pRoot->numComId     = numComId;
+        pRoot->numDataset   = numDataset;
+    }
+    tau_freeXmlDatasetConfig(numComId, pComIdDsIdMap, numDataset, apDataset);
+}
+
+/**********************************************************************************************************************/
+/** Free the arrays delivered by tau_readXmlDeviceConfig.
+ *
+ *  @param[in]      pComPar     Com parameters, may be NULL
+ *  @param[in]      pIfConfig   Interface parameters, may be NULL
+ *
+ */
+static void cfgImageFreeDevice (
+    TRDP_COM_PAR_T      *pComPar,
+    TRDP_IF_CONFIG_T    *pIfConfig)
+{
+    if (pComPar != NULL)
+    {
+        vos_memFree(pComPar);
+    }
+    if (pIfConfig != NULL)
+    {
+        vos_memFree(pIfConfig);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Write the finished image to a file, replacing an existing image only when the new one is complete.
+ *
+ *  @param[in]      pBuild      Image under construction, header and relocation table included
+ *  @param[in]      pImageFile  Path and filename of the image
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    file could not be written
+ */
+static TRDP_ERR_T cfgImageWrite (
+    const CFG_IMAGE_BUILD_T *pBuild,
+    const CHAR8             *pImageFile)
+{
+    CHAR8   tmpName[TRDP_MAX_FILE_NAME_LEN + 8u];
+    FILE    *outfile;
+    int     written;
+
+    (void) vos_snprintf(tmpName, sizeof(tmpName), "%s.tmp", pImageFile);
+    outfile = fopen(tmpName, "wb");
+    if (outfile == NULL)
+    {
+        vos_printLog(VOS_LOG_ERROR, "Image file %s could not be created\n", tmpName);
+        return TRDP_PARAM_ERR;
+    }
+    written = (fwrite(pBuild->pBuf, 1u, pBuild->used, outfile) == pBuild->used);
+    if ((fclose(outfile) != 0) || (written == 0) || (rename(tmpName, pImageFile) != 0))
+    {
+        vos_printLog(VOS_LOG_ERROR, "Image file %s could not be written\n", pImageFile);
+        (void) remove(tmpName);
+        return TRDP_PARAM_ERR;
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Check an image and relocate its pointers to the load address.
+ *
+ *  @param[in]      pBase       Start of the image in memory, writable
+ *  @param[in]      size        Size of the image file
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    no valid image for this build
+ *  @retval         TRDP_CRC_ERR      checksum wrong
+ */
+static TRDP_ERR_T cfgImageRelocate (
+    UINT8   *pBase,
+    UINT32  size)
+{
+    const TAU_CFG_IMAGE_HEADER_T    *pHeader = (const TAU_CFG_IMAGE_HEADER_T *) pBase;
+    const UINT32                    *pReloc;
+    uintptr_t                       value;
+    UINT32                          i;
+
+    if (size < sizeof(TAU_CFG_IMAGE_HEADER_T))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "Configuration image too short\n");
+        return TRDP_PARAM_ERR;
+    }
+    if (pHeader->magic != TAU_CFG_IMAGE_MAGIC)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, (pHeader->magic == CFG_IMAGE_MAGIC_SWAPPED) ?
+                        "Configuration image of other byte order\n" : "No configuration image\n");
+        return TRDP_PARAM_ERR;
+    }
+    if ((pHeader->version != TAU_CFG_IMAGE_VERSION)
+        || (pHeader->ptrSize != sizeof(void *))
+        || (pHeader->layout != cfgImageLayout()))
+    {
+        vos_printLog(VOS_LOG_ERROR, "Configuration image version %u not compatible with this build\n",
+                     (unsigned int) pHeader->version);
+        return TRDP_PARAM_ERR;
+    }
+    if ((pHeader->size != size)
+        || (pHeader->rootOffset < sizeof(TAU_CFG_IMAGE_HEADER_T))
+        || (pHeader->relocOffset < sizeof(TAU_CFG_IMAGE_ROOT_T))
+        || (pHeader->rootOffset > pHeader->relocOffset - sizeof(TAU_CFG_IMAGE_ROOT_T))
+        || (pHeader->relocOffset > size)
+        || (pHeader->relocCount > (size - pHeader->relocOffset) / sizeof(UINT32)))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "Configuration image truncated or corrupted\n");
+        return TRDP_PARAM_ERR;
+    }
+    if (vos_crc32(INITFCS, pBase + sizeof(TAU_CFG_IMAGE_HEADER_T), size - (UINT32) sizeof(TAU_CFG_IMAGE_HEADER_T))
+        != pHeader->crc)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "Configuration image CRC error\n");
+        return TRDP_CRC_ERR;
+    }
+
+    /* Every listed pointer must lie in the data part and point into it */
+    pReloc = (const UINT32 *) (pBase + pHeader->relocOffset);
+    for (i = 0u; i < pHeader->relocCount; i++)
+    {
+        if ((pReloc[i] < pHeader->rootOffset)
+            || (pReloc[i] > pHeader->relocOffset - sizeof(uintptr_t))
+            || ((pReloc[i] % sizeof(uintptr_t)) != 0u))
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "Configuration image relocation error\n");
+            return TRDP_PARAM_ERR;
+        }
+        memcpy(&value, pBase + pReloc[i], sizeof(value));
+        if ((value < pHeader->rootOffset) || (value >= pHeader->relocOffset))
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "Configuration image relocation error\n");
+            return TRDP_PARAM_ERR;
+        }
+        value += (uintptr_t) pBase;
+        memcpy(pBase + pReloc[i], &value, sizeof(value));
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Release the memory of an image.
+ *
+ *  @param[in]      pImage      Loaded image
+ *
+ */
+static void cfgImageRelease (
+    struct TAU_CFG_IMAGE *pImage)
+{
+#ifdef POSIX
+    if (pImage->mapped == TRUE)
+    {
+        (void) munmap(pImage->pBase, pImage->size);
+    }
+    else
+#endif
+    if (pImage->pBase != NULL)
+    {
+        vos_memFree(pImage->pBase);
+    }
+    vos_memFree(pImage);
+}
+
+/***********************************************************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+/**********************************************************************************************************************/
+/**    Write the binary image of an XML configuration.
+ *
+ *  @param[in]      pDocHnd           Handle of the XML document prepared by tau_prepareXmlDoc
+ *  @param[in]      pImageFile        Path and filename of the image to write
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    Parameter error or image file could not be written
+ *  @retval         TRDP_MEM_ERR      out of memory
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_buildCfgImage (
+    const TRDP_XML_DOC_HANDLE_T *pDocHnd,
+    const CHAR8                 *pImageFile)
+{
+    CFG_IMAGE_BUILD_T       build;
+    TAU_CFG_IMAGE_ROOT_T    *pRoot;
+    TAU_CFG_IMAGE_HEADER_T  *pHeader;
+    TRDP_COM_PAR_T          *pComPar    = NULL;
+    TRDP_IF_CONFIG_T        *pIfConfig  = NULL;
+    TRDP_MEM_CONFIG_T       memConfig;
+    TRDP_DBG_CONFIG_T       dbgConfig;
+    UINT32                  numComPar   = 0u;
+    UINT32                  numIfConfig = 0u;
+    UINT32                  trafficStoreSize = 0u;
+    UINT32                  root;
+    UINT32                  reloc;
+    UINT32                  relocCount;
+    TRDP_ERR_T              err;
+
+    if ((pDocHnd == NULL) || (pImageFile == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    memset(&memConfig, 0, sizeof(memConfig));
+    memset(&dbgConfig, 0, sizeof(dbgConfig));
+    err = tau_readXmlDeviceConfig(pDocHnd, &memConfig, &dbgConfig, &numComPar, &pComPar, &numIfConfig, &pIfConfig);
+    if (err == TRDP_NO_ERR)
+    {
+        err = tau_readXmlTrafficStoreConfig(pDocHnd, &trafficStoreSize);
+    }
+    if (err != TRDP_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_ERROR, "Reading device configuration failed (%d)\n", err);
+        cfgImageFreeDevice(pComPar, pIfConfig);
+        return err;
+    }
+
+    memset(&build, 0, sizeof(build));
+    (void) cfgImageAlloc(&build, sizeof(TAU_CFG_IMAGE_HEADER_T));
+    root = cfgImageAlloc(&build, sizeof(TAU_CFG_IMAGE_ROOT_T));
+    if (root != 0u)
+    {
+        pRoot = (TAU_CFG_IMAGE_ROOT_T *) (build.pBuf + root);
+        pRoot->memConfig        = memConfig;
+        pRoot->memConfig.p      = NULL;
+        pRoot->dbgConfig        = dbgConfig;
+        pRoot->trafficStoreSize = trafficStoreSize;
+        pRoot->numComPar        = numComPar;
+        pRoot->numIfConfig      = numIfConfig;
+    }
+    cfgImageSetPtr(&build, root + offsetof(TAU_CFG_IMAGE_ROOT_T, pComPar),
+                   cfgImageCopy(&build, pComPar, numComPar * sizeof(TRDP_COM_PAR_T)));
+    cfgImageSetPtr(&build, root + offsetof(TAU_CFG_IMAGE_ROOT_T, pIfConfig),
+                   cfgImageCopy(&build, pIfConfig, numIfConfig * sizeof(TRDP_IF_CONFIG_T)));
+    if ((build.err == TRDP_NO_ERR) && (numIfConfig > 0u))
+    {
+        cfgImageInterfaces(&build, root, pDocHnd, numIfConfig, pIfConfig);
+    }
+    if (build.err == TRDP_NO_ERR)
+    {
+        cfgImageDatasets(&build, root, pDocHnd);
+    }
+    cfgImageFreeDevice(pComPar, pIfConfig);
+
+    /* Relocation table and header close the image */
+    relocCount  = build.relocCount;
+    reloc       = cfgImageCopy(&build, build.pReloc, relocCount * sizeof(UINT32));
+    if ((build.err == TRDP_NO_ERR) && ((reloc != 0u) || (relocCount == 0u)))
+    {
+        if (relocCount == 0u)
+        {
+            reloc = build.used;
+        }
+        pHeader = (TAU_CFG_IMAGE_HEADER_T *) build.pBuf;
+        pHeader->magic          = TAU_CFG_IMAGE_MAGIC;
+        pHeader->version        = TAU_CFG_IMAGE_VERSION;
+        pHeader->ptrSize        = (UINT16) sizeof(void *);
+        pHeader->layout         = cfgImageLayout();
+        pHeader->size           = build.used;
+        pHeader->rootOffset     = root;
+        pHeader->relocOffset    = reloc;
+        pHeader->relocCount     = relocCount;
+        pHeader->crc            = vos_crc32(INITFCS, build.pBuf + sizeof(TAU_CFG_IMAGE_HEADER_T),
+                                            build.used - (UINT32) sizeof(TAU_CFG_IMAGE_HEADER_T));
+        err = cfgImageWrite(&build, pImageFile);
+    }
+    else
+    {
+        err = (build.err != TRDP_NO_ERR) ? build.err : TRDP_MEM_ERR;
+    }
+    if (build.pBuf != NULL)
+    {
+        vos_memFree(build.pBuf);
+    }
+    if (build.pReloc != NULL)
+    {
+        vos_memFree(build.pReloc);
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/**    Map a configuration image and check it.
+ *
+ *  @param[in]      pImageFile        Path and filename of the image
+ *  @param[out]     pImgHnd           Handle of the loaded image
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    File does not exist or is no valid image for this build
+ *  @retval         TRDP_CRC_ERR      Image checksum wrong
+ *  @retval         TRDP_MEM_ERR      out of memory
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_loadCfgImage (
+    const CHAR8             *pImageFile,
+    TRDP_CFG_IMAGE_HANDLE_T *pImgHnd)
+{
+    struct TAU_CFG_IMAGE    *pImage;
+    TRDP_ERR_T              err;
+
+    if ((pImageFile == NULL) || (pImgHnd == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    pImgHnd->pImage = NULL;
+    pImage = (struct TAU_CFG_IMAGE *) vos_memAlloc(sizeof(struct TAU_CFG_IMAGE));
+    if (pImage == NULL)
+    {
+        return TRDP_MEM_ERR;
+    }
+
+#ifdef POSIX
+    {
+        struct stat fileStat;
+        void        *pMap;
+        int         fd = open(pImageFile, O_RDONLY);
+
+        if ((fd == -1) || (fstat(fd, &fileStat) == -1)
+            || (fileStat.st_size < (off_t) sizeof(TAU_CFG_IMAGE_HEADER_T))
+            || (fileStat.st_size > (off_t) CFG_IMAGE_MAX_SIZE))
+        {
+            vos_printLog(VOS_LOG_ERROR, "Configuration image %s not readable\n", pImageFile);
+            if (fd != -1)
+            {
+                (void) close(fd);
+            }
+            vos_memFree(pImage);
+            return TRDP_PARAM_ERR;
+        }
+        /* Copy on write: only the pages holding relocated pointers are copied */
+        pMap = mmap(NULL, (size_t) fileStat.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        (void) close(fd);
+        if (pMap == MAP_FAILED)
+        {
+            vos_memFree(pImage);
+            return TRDP_MEM_ERR;
+        }
+        pImage->pBase   = (UINT8 *) pMap;
+        pImage->size    = (UINT32) fileStat.st_size;
+        pImage->mapped  = TRUE;
+    }
+#else
+    {
+        FILE    *infile = fopen(pImageFile, "rb");
+        long    size    = -1L;
+
+        if ((infile == NULL) || (fseek(infile, 0L, SEEK_END) != 0) || ((size = ftell(infile)) < 0L)
+            || (fseek(infile, 0L, SEEK_SET) != 0) || (size < (long) sizeof(TAU_CFG_IMAGE_HEADER_T))
+            || (size > (long) CFG_IMAGE_MAX_SIZE))
+        {
+            vos_printLog(VOS_LOG_ERROR, "Configuration image %s not readable\n", pImageFile);
+            if (infile != NULL)
+            {
+                (void) fclose(infile);
+            }
+            vos_memFree(pImage);
+            return TRDP_PARAM_ERR;
+        }
+        pImage->pBase   = (UINT8 *) vos_memAlloc((UINT32) size);
+        pImage->size    = (UINT32) size;
+        pImage->mapped  = FALSE;
+        if ((pImage->pBase == NULL) || (fread(pImage->pBase, 1u, (size_t) size, infile) != (size_t) size))
+        {
+            (void) fclose(infile);
+            cfgImageRelease(pImage);
+            return TRDP_MEM_ERR;
+        }
+        (void) fclose(infile);
+    }
+#endif
+
+    err = cfgImageRelocate(pImage->pBase, pImage->size);
+    if (err != TRDP_NO_ERR)
+    {
+        cfgImageRelease(pImage);
+        return err;
+    }
+    pImage->pRoot = (const TAU_CFG_IMAGE_ROOT_T *)
+        (pImage->pBase + ((const TAU_CFG_IMAGE_HEADER_T *) pImage->pBase)->rootOffset);
+    pImgHnd->pImage = pImage;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Unmap a configuration image.
+ *
+ *  @param[in]      pImgHnd           Handle of the loaded image
+ *
+ */
+EXT_DECL void tau_freeCfgImage (
+    TRDP_CFG_IMAGE_HANDLE_T *pImgHnd)
+{
+    if ((pImgHnd != NULL) && (pImgHnd->pImage != NULL))
+    {
+        cfgImageRelease(pImgHnd->pImage);
+        pImgHnd->pImage = NULL;
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Device configuration parameters of a configuration image.
+ *
+ *  @param[in]      pImgHnd           Handle of the image loaded by tau_loadCfgImage
+ *  @param[out]     pMemConfig        Memory configuration
+ *  @param[out]     pDbgConfig        Debug printout configuration for application use
+ *  @param[out]     pNumComPar        Number of configured com parameters
+ *  @param[out]     ppComPar          Pointer to array of com parameters
+ *  @param[out]     pNumIfConfig      Number of configured interfaces
+ *  @param[out]     ppIfConfig        Pointer to an array of interface parameter sets
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    Parameter error
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_readCfgImageDeviceConfig (
+    const TRDP_CFG_IMAGE_HANDLE_T   *pImgHnd,
+    TRDP_MEM_CONFIG_T               *pMemConfig,
+    TRDP_DBG_CONFIG_T               *pDbgConfig,
+    UINT32                          *pNumComPar,
+    TRDP_COM_PAR_T                  * *ppComPar,
+    UINT32                          *pNumIfConfig,
+    TRDP_IF_CONFIG_T                * *ppIfConfig)
+{
+    const TAU_CFG_IMAGE_ROOT_T *pRoot;
+
+    if ((pImgHnd == NULL) || (pImgHnd->pImage == NULL) || (pNumComPar == NULL) || (ppComPar == NULL)
+        || (pNumIfConfig == NULL) || (ppIfConfig == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    pRoot = pImgHnd->pImage->pRoot;
+    if (pMemConfig != NULL)
+    {
+        *pMemConfig = pRoot->memConfig;
+    }
+    if (pDbgConfig != NULL)
+    {
+        *pDbgConfig = pRoot->dbgConfig;
+    }
+    *pNumComPar     = pRoot->numComPar;
+    *ppComPar       = pRoot->pComPar;
+    *pNumIfConfig   = pRoot->numIfConfig;
+    *ppIfConfig     = pRoot->pIfConfig;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Traffic Store size of a configuration image.
+ *
+ *  @param[in]      pImgHnd             Handle of the image loaded by tau_loadCfgImage
+ *  @param[out]     pTrafficStoreSize   Configured Traffic Store size in bytes
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      Parameter error
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_readCfgImageTrafficStoreConfig (
+    const TRDP_CFG_IMAGE_HANDLE_T   *pImgHnd,
+    UINT32                          *pTrafficStoreSize)
+{
+    if ((pImgHnd == NULL) || (pImgHnd->pImage == NULL) || (pTrafficStoreSize == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    *pTrafficStoreSize = pImgHnd->pImage->pRoot->trafficStoreSize;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Interface parameters and telegrams of a configuration image.
+ *
+ *  @param[in]      pImgHnd           Handle of the image loaded by tau_loadCfgImage
+ *  @param[in]      pIfName           Interface name
+ *  @param[out]     pProcessConfig    TRDP process (session) configuration for the interface
+ *  @param[out]     pPdConfig         PD default configuration for the interface
+ *  @param[out]     pMdConfig         MD default configuration for the interface
+ *  @param[out]     pNumExchgPar      Number of configured telegrams
+ *  @param[out]     ppExchgPar        Pointer to array of telegram configurations
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    Parameter error or interface not in the image
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_readCfgImageInterfaceConfig (
+    const TRDP_CFG_IMAGE_HANDLE_T   *pImgHnd,
+    const CHAR8                     *pIfName,
+    TRDP_PROCESS_CONFIG_T           *pProcessConfig,
+    TRDP_PD_CONFIG_T                *pPdConfig,
+    TRDP_MD_CONFIG_T                *pMdConfig,
+    UINT32                          *pNumExchgPar,
+    TRDP_EXCHG_PAR_T                * *ppExchgPar)
+{
+    const TAU_CFG_IMAGE_ROOT_T  *pRoot;
+    const TAU_CFG_IMAGE_IF_T    *pInterface;
+    UINT32                      i;
+
+    if ((pImgHnd == NULL) || (pImgHnd->pImage == NULL) || (pIfName == NULL) || (pNumExchgPar == NULL)
+        || (ppExchgPar == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    pRoot = pImgHnd->pImage->pRoot;
+    for (i = 0u; i < pRoot->numIfConfig; i++)
+    {
+        if (vos_strnicmp(pRoot->pIfConfig[i].ifName, pIfName, TRDP_MAX_LABEL_LEN) == 0)
+        {
+            break;
+        }
+    }
+    if (i == pRoot->numIfConfig)
+    {
+        vos_printLog(VOS_LOG_ERROR, "Interface %s not in configuration image\n", pIfName);
+        return TRDP_PARAM_ERR;
+    }
+    pInterface = &pRoot->pInterface[i];
+    if (pProcessConfig != NULL)
+    {
+        *pProcessConfig = pInterface->processConfig;
+    }
+    if (pPdConfig != NULL)
+    {
+        *pPdConfig = pInterface->pdConfig;
+    }
+    if (pMdConfig != NULL)
+    {
+        *pMdConfig = pInterface->mdConfig;
+    }
+    *pNumExchgPar   = pInterface->numExchgPar;
+    *ppExchgPar     = pInterface->pExchgPar;
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Dataset configuration of a configuration image.
+ *
+ *  @param[in]      pImgHnd           Handle of the image loaded by tau_loadCfgImage
+ *  @param[out]     pNumComId         Pointer to the number of entries in the ComId DatasetId mapping list
+ *  @param[out]     ppComIdDsIdMap    Pointer to an array of a structures of type TRDP_COMID_DSID_MAP_T
+ *  @param[out]     pNumDataset       Pointer to the number of datasets found in the configuration
+ *  @param[out]     papDataset        Pointer to an array of pointers to a structures of type TRDP_DATASET_T
+ *
+ *  @retval         TRDP_NO_ERR       no error
+ *  @retval         TRDP_PARAM_ERR    Parameter error
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_readCfgImageDatasetConfig (
+    const TRDP_CFG_IMAGE_HANDLE_T   *pImgHnd,
+    UINT32                          *pNumComId,
+    TRDP_COMID_DSID_MAP_T           * *ppComIdDsIdMap,
+    UINT32                          *pNumDataset,
+    papTRDP_DATASET_T               papDataset)
+{
+    const TAU_CFG_IMAGE_ROOT_T *pRoot;
+
+    if ((pImgHnd == NULL) || (pImgHnd->pImage == NULL) || (pNumComId == NULL) || (ppComIdDsIdMap == NULL)
+        || (pNumDataset == NULL) || (papDataset == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    pRoot = pImgHnd->pImage->pRoot;
+    *pNumComId      = pRoot->numComId;
+    *ppComIdDsIdMap = pRoot->pComIdDsIdMap;
+    *pNumDataset    = pRoot->numDataset;
+    *papDataset     = pRoot->apDataset;
+    return TRDP_NO_ERR;
+}
@@ -4,7 +4,19 @@
  *
  * @brief           Functions for domain name resolution
  *
- * @details
+ * @details         The resolver keeps a cache of URI to IP address mappings. It is hashed by URI (case insensitive)
+ *                  and by IP address for the reverse lookup and grows with the number of entries.
+ *                  An entry is valid as long as its topocounts match the session (TCN-DNS) or its TTL has not
+ *                  expired (standard DNS). Hosts file entries never expire.
+ *
+ *                  Queries are sent asynchronously: TCN-DNS requests are MD requests handled by tlc_process,
+ *                  standard DNS queries use one non-blocking UDP socket served by tau_dnrGetInterval() and
+ *                  tau_dnrProcess(). tau_initDnr hooks both into tlc_getInterval() and tlc_process() of the
+ *                  session, so the process loop of the application drives the resolver without further calls.
+ *                  Only one TCN-DNS request is outstanding at a time, URIs asked for meanwhile are collected and
+ *                  sent with the next request.
+ *                  All resolver data is protected by the session mutex, which is also held by tlc_process while
+ *                  the MD callbacks are executed.
  *
  * @note            Project: TCNOpen TRDP prototype stack
  *
@@ -16,6 +28,9 @@
  *
  * $Id: tau_dnr.c 1799 2018-11-09 13:51:12Z bloehr $
  *
+ *      AG 2026-10-19: Resolver driven by tlc_getInterval and tlc_process once initialised
+ *      AG 2026-10-19: tau_dnrPreResolve: batch resolution of the configured URIs
+ *      AG 2026-10-19: Asynchronous resolution, hashed cache with TTL and reverse index
  *      BL 2018-08-07: Ticket #183 tau_getOwnIds declared but not defined
  *      BL 2018-08-06: Ticket #210 IF condition for DNS Options incorrect in tau_uri2Addr()
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
@@ -43,6 +58,7 @@
 #include "trdp_if_light.h"
 #include "vos_mem.h"
 #include "vos_sock.h"
+#include "vos_thread.h"
 
 
 /***********************************************************************************************************************
@@ -50,46 +66,87 @@
  */
 
 #define TAU_MAX_HOSTS_LINE_LENGTH   120u
-#define TAU_MAX_NO_CACHE_ENTRY      50u
-#define TAU_MAX_NO_IF               4u      /**< Default interface should be in the first 4 */
+#define TAU_DNR_INITIAL_BUCKETS     64u     /**< Initial size of the hash tables, must be a power of 2           */
+#define TAU_DNR_MAX_BUCKETS         8192u   /**< The hash tables are not grown beyond this size                  */
+#define TAU_MAX_TCN_URI_CNT         255u    /**< Max. number of URIs in one TCN-DNS request                      */
 #define TAU_MAX_DNS_BUFFER_SIZE     1500u   /* if this doesn't suffice, we need to allocate it */
-#define TAU_MAX_NAME_SIZE           256u    /* Allocated on stack */
 #define TAU_DNS_TIME_OUT_LONG       10u     /**< Timeout in seconds for DNS server reply, if no hosts file provided   */
 #define TAU_DNS_TIME_OUT_SHORT      1u      /**< Timeout in seconds for DNS server reply, if hosts file was provided  */
+#define TAU_DNS_MIN_TTL             1u      /**< [s] Lower limit for the TTL of a DNS answer                     */
+#define TAU_DNS_TYPE_A              1u
+#define TAU_DNS_CLASS_IN            1u
+#define TAU_TCN_DNS_MARGIN_US       1000000u    /**< [us] Added to the MD reply timeout before a request is aborted */
+#define TAU_DNR_POLL_US             100000u     /**< [us] Max. select time while tau_uri2Addr waits              */
 
 /***********************************************************************************************************************
  * TYPEDEFS
  */
 
+/** Query state of a cache entry */
+typedef enum
+{
+    TAU_DNR_IDLE        = 0,        /**< no query running                                   */
+    TAU_DNR_QUEUED      = 1,        /**< to be sent with the next TCN-DNS request           */
+    TAU_DNR_QUERYING    = 2         /**< query sent, waiting for the reply                  */
+} TAU_DNR_QUERY_STATE_T;
+
 typedef struct tau_dnr_cache
 {
-    CHAR8           uri[TRDP_MAX_URI_HOST_LEN];
-    TRDP_IP_ADDR_T  ipAddr;
-    UINT32          etbTopoCnt;
-    UINT32          opTrnTopoCnt;
-    BOOL8           fixedEntry;
+    struct tau_dnr_cache    *pNext;         /**< next entry in the URI hash bucket                  */
+    struct tau_dnr_cache    *pNextAddr;     /**< next entry in the address hash bucket              */
+    struct tau_dnr_cache    *pNextBusy;     /**< next queued or querying entry                      */
+    CHAR8                   uri[TRDP_MAX_URI_HOST_LEN];
+    TRDP_IP_ADDR_T          ipAddr;
+    UINT32                  etbTopoCnt;
+    UINT32                  opTrnTopoCnt;
+    TRDP_TIME_T             validUntil;     /**< expiry of a DNS answer, zero: no TTL               */
+    TRDP_TIME_T             queryTimeout;   /**< standard DNS: timeout of the running query         */
+    TRDP_ERR_T              result;         /**< result of the last query                           */
+    UINT16                  queryId;        /**< standard DNS: ID of the running query              */
+    UINT8                   state;          /**< TAU_DNR_QUERY_STATE_T                              */
+    BOOL8                   fixedEntry;
 } TAU_DNR_ENTRY_T;
 
+/** Resolution waiting for a callback */
+typedef struct tau_dnr_pending
+{
+    struct tau_dnr_pending  *pNext;
+    TAU_DNR_ENTRY_T         *pEntry;        /**< cache entry to be resolved                         */
+    TRDP_DNR_CALLBACK_T     pfCbFunction;   /**< NULL if cancelled                                  */
+    void                    *pRefCon;
+} TAU_DNR_PENDING_T;
+
 typedef struct tau_dnr_data
 {
-    TRDP_IP_ADDR_T  dnsIpAddr;                      /**< IP address of the resolver                 */
-    UINT16          dnsPort;                        /**< 53 for standard DNS or 17225 for TCN-DNS   */
-    UINT8           timeout;                        /**< timeout for requests (in seconds)          */
-    TRDP_DNR_OPTS_T useTCN_DNS;                     /**< how to use TCN DNR                         */
-    UINT32          noOfCachedEntries;              /**< no of items currently in the cache         */
-    TAU_DNR_ENTRY_T cache[TAU_MAX_NO_CACHE_ENTRY];  /**< if != 0 use TCN DNS as resolver            */
+    TRDP_IP_ADDR_T      dnsIpAddr;                  /**< IP address of the resolver                 */
+    UINT16              dnsPort;                    /**< 53 for standard DNS or 17225 for TCN-DNS   */
+    UINT8               timeout;                    /**< timeout for requests (in seconds)          */
+    TRDP_DNR_OPTS_T     useTCN_DNS;                 /**< how to use TCN DNR                         */
+    UINT32              noOfCachedEntries;          /**< no of items currently in the cache         */
+    UINT32              noOfBuckets;                /**< size of both hash tables                   */
+    TAU_DNR_ENTRY_T     **ppUriHash;                /**< cache entries hashed by URI                */
+    TAU_DNR_ENTRY_T     **ppAddrHash;               /**< resolved cache entries hashed by address   */
+    TAU_DNR_ENTRY_T     *pBusy;                     /**< queued and querying entries                */
+    TAU_DNR_PENDING_T   *pPending;                  /**< resolutions waiting for their callback     */
+    SOCKET              dnsSock;                    /**< standard DNS: socket for all queries       */
+    UINT16              nextQueryId;                /**< standard DNS: ID of the next query         */
+    BOOL8               tcnRequestActive;           /**< TCN-DNS: request outstanding               */
+    BOOL8               tcnRequestQueued;           /**< TCN-DNS: request not yet sent by tlc_process */
+    TRDP_UUID_T         tcnSessionId;               /**< TCN-DNS: MD session of the request         */
+    TRDP_TIME_T         tcnRequestTimeout;          /**< TCN-DNS: abort the request after this time */
+    UINT8               tcnBuffer[sizeof(TRDP_DNS_REQUEST_T)];  /**< TCN-DNS: request telegram      */
 } TAU_DNR_DATA_T;
 
-typedef struct tau_dnr_query
+/** Completion context of the blocking tau_uri2Addr and tau_dnrPreResolve */
+typedef struct tau_dnr_wait
 {
-    UINT16  id;
-    UINT16  param;
-    UINT16  noOfQueries;
-    UINT16  noOfReplies;
-    UINT16  noOfAuth;
-    UINT16  noOfAddInfo;
-    UINT8   data[1];
-} TAU_DNR_QUERY_T;
+    VOS_SEMA_T      sema;
+    BOOL8           done;
+    TRDP_IP_ADDR_T  ipAddr;
+    TRDP_ERR_T      result;
+    UINT32          noOfOpen;           /**< batch: resolutions not finished yet    */
+    UINT32          noOfUnresolved;     /**< batch: resolutions failed              */
+} TAU_DNR_WAIT_T;
 
 /* Constant sized fields of the resource record structure */
 #if (defined (WIN32) || defined (WIN64))
@@ -121,27 +178,12 @@ typedef struct DNS_HEADER
 #pragma pack(pop)
 #endif
 
-
-/* Pointers to resource record contents */
-typedef struct RES_RECORD
-{
-    unsigned char   *name;
-    TAU_R_DATA_T    *resource;
-    unsigned char   *rdata;
-} TAU_RES_RECORD_T;
-
-
-/* Constant sized fields of query structure */
-typedef struct QUESTION
-{
-    UINT16  qtype;
-    UINT16  qclass;
-} TAU_DNR_QUEST_T;
-
 /***********************************************************************************************************************
  *   Locals
  */
 
+static TRDP_ERR_T sendTCNrequest (TRDP_APP_SESSION_T appHandle, TAU_DNR_DATA_T *pDNR);
+
 
 #pragma mark ----------------------- Local -----------------------------
 
@@ -150,122 +192,414 @@ typedef struct QUESTION
  */
 
 /**********************************************************************************************************************/
-/**    Function to read and convert a resource from the DNS response
+/** Case insensitive hash of a URI (FNV-1a)
+ *
+ *  @param[in]      pUri            Pointer to host name
+ *
+ *  @retval         hash value
+ */
+static UINT32 hashUri (const CHAR8 *pUri)
+{
+    UINT32  hash = 2166136261u;
+    UINT32  i;
+
+    for (i = 0u; (i < TRDP_MAX_URI_HOST_LEN) && (pUri[i] != '\0'); i++)
+    {
+        hash ^= (UINT32) tolower((unsigned char) pUri[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/**********************************************************************************************************************/
+/** Hash of an IP address
+ *
+ *  @param[in]      ipAddr          IP address
+ *
+ *  @retval         hash value
+ */
+static UINT32 hashAddr (TRDP_IP_ADDR_T ipAddr)
+{
+    return (ipAddr * 2654435761u) ^ (ipAddr >> 16u);
+}
+
+/**********************************************************************************************************************/
+/** Find the cache entry of a URI
+ *
+ *  @param[in]      pDNR            Pointer to dnr data
+ *  @param[in]      pUri            Pointer to host name
  *
- *  @param[in]      pReader         Pointer to current read position
- *  @param[in]      pBuffer         Pointer to start of packet buffer
- *  @param[out]     pCount          Pointer to return skip in read position
- *  @param[in]      pNameBuffer     Pointer to a 256 Byte buffer to copy the result to
+ *  @retval         pointer to the entry or NULL
+ */
+static TAU_DNR_ENTRY_T *cacheFind (
+    const TAU_DNR_DATA_T    *pDNR,
+    const CHAR8             *pUri)
+{
+    TAU_DNR_ENTRY_T *pEntry = pDNR->ppUriHash[hashUri(pUri) & (pDNR->noOfBuckets - 1u)];
+
+    while ((pEntry != NULL) && (vos_strnicmp(pEntry->uri, pUri, TRDP_MAX_URI_HOST_LEN) != 0))
+    {
+        pEntry = pEntry->pNext;
+    }
+    return pEntry;
+}
+
+/**********************************************************************************************************************/
+/** Insert an entry into the address index
  *
- *  @retval         pointer to returned resource string
+ *  @param[in]      pDNR            Pointer to dnr data
+ *  @param[in]      pEntry          Cache entry with an address
  */
-static CHAR8 *readName (UINT8 *pReader, UINT8 *pBuffer, UINT32 *pCount, CHAR8 *pNameBuffer)
+static void cacheLinkAddr (
+    TAU_DNR_DATA_T  *pDNR,
+    TAU_DNR_ENTRY_T *pEntry)
 {
-    CHAR8           *pName  = pNameBuffer;
-    unsigned int    p       = 0u;
-    unsigned int    jumped  = 0u;
-    unsigned int    offset;
-    int             i;
-    int             j;
+    TAU_DNR_ENTRY_T **ppBucket = &pDNR->ppAddrHash[hashAddr(pEntry->ipAddr) & (pDNR->noOfBuckets - 1u)];
 
-    *pCount     = 1;
-    pName[0]    = '\0';
+    pEntry->pNextAddr   = *ppBucket;
+    *ppBucket           = pEntry;
+}
+
+/**********************************************************************************************************************/
+/** Change the address of a cache entry and keep the address index up to date
+ *
+ *  @param[in]      pDNR            Pointer to dnr data
+ *  @param[in]      pEntry          Cache entry
+ *  @param[in]      ipAddr          New address, VOS_INADDR_ANY if unknown
+ */
+static void cacheSetAddr (
+    TAU_DNR_DATA_T  *pDNR,
+    TAU_DNR_ENTRY_T *pEntry,
+    TRDP_IP_ADDR_T  ipAddr)
+{
+    TAU_DNR_ENTRY_T **ppIter;
 
-    /* read the names in 3www6newtec2de0 format */
-    while ((*pReader != 0u) && (p < (TAU_MAX_NAME_SIZE - 1u)))
+    if (pEntry->ipAddr == ipAddr)
+    {
+        return;
+    }
+    if (pEntry->ipAddr != VOS_INADDR_ANY)
     {
-        if (*pReader >= 192u)
+        for (ppIter = &pDNR->ppAddrHash[hashAddr(pEntry->ipAddr) & (pDNR->noOfBuckets - 1u)];
+             *ppIter != NULL;
+             ppIter = &(*ppIter)->pNextAddr)
         {
-            offset  = (*pReader) * 256u + *(pReader + 1u) - 49152u;        /* 49152 = 11000000 00000000 ;) */
-            pReader = pBuffer + offset - 1u;
-            jumped  = 1u;                                /* we have jumped to another location so counting wont go up!
-                                                           */
+            if (*ppIter == pEntry)
+            {
+                *ppIter = pEntry->pNextAddr;
+                break;
+            }
         }
-        else
+    }
+    pEntry->ipAddr      = ipAddr;
+    pEntry->pNextAddr   = NULL;
+    if (ipAddr != VOS_INADDR_ANY)
+    {
+        cacheLinkAddr(pDNR, pEntry);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Allocate both hash tables with the given size and move all entries into them
+ *
+ *  @param[in]      pDNR            Pointer to dnr data
+ *  @param[in]      noOfBuckets     New table size, power of 2
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_MEM_ERR    out of memory, the old tables are kept
+ */
+static TRDP_ERR_T cacheResize (
+    TAU_DNR_DATA_T  *pDNR,
+    UINT32          noOfBuckets)
+{
+    TAU_DNR_ENTRY_T **ppOldUriHash  = pDNR->ppUriHash;
+    TAU_DNR_ENTRY_T **ppOldAddrHash = pDNR->ppAddrHash;
+    UINT32          oldBuckets      = pDNR->noOfBuckets;
+    TAU_DNR_ENTRY_T *pEntry;
+    TAU_DNR_ENTRY_T **ppBucket;
+    UINT32          i;
+
+    pDNR->ppUriHash     = (TAU_DNR_ENTRY_T * *) vos_memAlloc(noOfBuckets * sizeof(TAU_DNR_ENTRY_T *));
+    pDNR->ppAddrHash    = (TAU_DNR_ENTRY_T * *) vos_memAlloc(noOfBuckets * sizeof(TAU_DNR_ENTRY_T *));
+    if ((pDNR->ppUriHash == NULL) || (pDNR->ppAddrHash == NULL))
+    {
+        if (pDNR->ppUriHash != NULL)
         {
-            pName[p++] = (CHAR8) *pReader;
+            vos_memFree(pDNR->ppUriHash);
         }
+        if (pDNR->ppAddrHash != NULL)
+        {
+            vos_memFree(pDNR->ppAddrHash);
+        }
+        pDNR->ppUriHash     = ppOldUriHash;
+        pDNR->ppAddrHash    = ppOldAddrHash;
+        return TRDP_MEM_ERR;
+    }
+    pDNR->noOfBuckets = noOfBuckets;
 
-        pReader = pReader + 1u;
-
-        if (jumped == 0u)
+    for (i = 0u; i < oldBuckets; i++)
+    {
+        while (ppOldUriHash[i] != NULL)
         {
-            *pCount = *pCount + 1u;                  /* if we havent jumped to another location then we can count up */
+            pEntry          = ppOldUriHash[i];
+            ppOldUriHash[i] = pEntry->pNext;
+            ppBucket        = &pDNR->ppUriHash[hashUri(pEntry->uri) & (noOfBuckets - 1u)];
+            pEntry->pNext   = *ppBucket;
+            *ppBucket       = pEntry;
+            pEntry->pNextAddr = NULL;
+            if (pEntry->ipAddr != VOS_INADDR_ANY)
+            {
+                cacheLinkAddr(pDNR, pEntry);
+            }
         }
     }
+    if (ppOldUriHash != NULL)
+    {
+        vos_memFree(ppOldUriHash);
+        vos_memFree(ppOldAddrHash);
+    }
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Add an empty entry for a URI to the cache, the tables grow if the load factor exceeds 1
+ *
+ *  @param[in]      pDNR            Pointer to dnr data
+ *  @param[in]      pUri            Pointer to host name
+ *
+ *  @retval         pointer to the new entry or NULL
+ */
+static TAU_DNR_ENTRY_T *cacheAdd (
+    TAU_DNR_DATA_T  *pDNR,
+    const CHAR8     *pUri)
+{
+    TAU_DNR_ENTRY_T *pEntry;
+    TAU_DNR_ENTRY_T **ppBucket;
 
-    pName[p] = '\0';                                 /* string complete */
+    if ((pDNR->noOfCachedEntries >= pDNR->noOfBuckets) && (pDNR->noOfBuckets < TAU_DNR_MAX_BUCKETS))
+    {
+        if (cacheResize(pDNR, pDNR->noOfBuckets * 2u) != TRDP_NO_ERR)
+        {
+            vos_printLog(VOS_LOG_WARNING, "DNR cache not grown (%u entries)\n", pDNR->noOfCachedEntries);
+        }
+    }
 
-    if (jumped == 1u)
+    pEntry = (TAU_DNR_ENTRY_T *) vos_memAlloc(sizeof(TAU_DNR_ENTRY_T));
+    if (pEntry == NULL)
     {
-        *pCount = *pCount + 1u;                      /* number of steps we actually moved forward in the packet */
+        return NULL;
     }
+    vos_strncpy(pEntry->uri, pUri, TRDP_MAX_URI_HOST_LEN - 1u);
+    pEntry->result  = TRDP_UNRESOLVED_ERR;
+    ppBucket        = &pDNR->ppUriHash[hashUri(pEntry->uri) & (pDNR->noOfBuckets - 1u)];
+    pEntry->pNext   = *ppBucket;
+    *ppBucket       = pEntry;
+    pDNR->noOfCachedEntries++;
+    return pEntry;
+}
 
-    /* now convert 3www6newtec2de0 to www.newtec.de */
+/**********************************************************************************************************************/
+/** Release all cache entries and the hash tables
+ *
+ *  @param[in]      pDNR            Pointer to dnr data
+ */
+static void cacheFree (
+    TAU_DNR_DATA_T *pDNR)
+{
+    TAU_DNR_ENTRY_T *pEntry;
+    UINT32          i;
 
-    for (i = 0; (i < (int)strlen((const char *)pName)) && (i < (int)(TAU_MAX_NAME_SIZE - 1u)); i++)
+    if (pDNR->ppUriHash != NULL)
     {
-        p = (unsigned int) pName[i];    /*lint !e571 Suspicious cast? Not clear! */
-        for (j = 0; j < (int)p; j++)
+        for (i = 0u; i < pDNR->noOfBuckets; i++)
         {
-            pName[i]    = pName[i + 1];
-            i           = i + 1;
+            while (pDNR->ppUriHash[i] != NULL)
+            {
+                pEntry = pDNR->ppUriHash[i];
+                pDNR->ppUriHash[i] = pEntry->pNext;
+                vos_memFree(pEntry);
+            }
         }
-        pName[i] = '.';
+        vos_memFree(pDNR->ppUriHash);
+        vos_memFree(pDNR->ppAddrHash);
     }
+    pDNR->ppUriHash         = NULL;
+    pDNR->ppAddrHash        = NULL;
+    pDNR->pBusy             = NULL;
+    pDNR->noOfBuckets       = 0u;
+    pDNR->noOfCachedEntries = 0u;
+}
 
-    pName[i - 1] = '\0'; /* remove the last dot */
-
-    return pName;
+/**********************************************************************************************************************/
+/** Check if a cache entry can be used
+ *
+ *  @param[in]      appHandle       Session context
+ *  @param[in]      pEntry          Cache entry
+ *  @param[in]      pNow            Current time
+ *
+ *  @retval         TRUE            address valid
+ */
+static BOOL8 cacheEntryValid (
+    TRDP_APP_SESSION_T      appHandle,
+    const TAU_DNR_ENTRY_T   *pEntry,
+    const TRDP_TIME_T       *pNow)
+{
+    if (pEntry->fixedEntry == TRUE)
+    {
+        return TRUE;
+    }
+    if ((pEntry->ipAddr == VOS_INADDR_ANY) || (pEntry->state != (UINT8) TAU_DNR_IDLE))
+    {
+        return FALSE;
+    }
+    if (((pEntry->validUntil.tv_sec != 0) || (pEntry->validUntil.tv_usec != 0)) &&
+        (vos_cmpTime(&pEntry->validUntil, pNow) < 0))
+    {
+        return FALSE;                                                           /* TTL expired              */
+    }
+    /* Do the topocounts match or do we not care? */
+    return (((appHandle->etbTopoCnt == 0u) || (pEntry->etbTopoCnt == appHandle->etbTopoCnt)) &&
+            ((appHandle->opTrnTopoCnt == 0u) || (pEntry->opTrnTopoCnt == appHandle->opTrnTopoCnt))) ? TRUE : FALSE;
 }
 
 /**********************************************************************************************************************/
-/** Function to convert www.newtec.de to 3www6newtec2de0
+/** Put an entry into the list of queued and querying entries
  *
- *  @param[in]      pDns            Pointer to destination position
- *  @param[in]      pHost           Pointer to source string
+ *  @param[in]      pDNR            Pointer to dnr data
+ *  @param[in]      pEntry          Cache entry
+ *  @param[in]      state           TAU_DNR_QUEUED or TAU_DNR_QUERYING
+ */
+static void busyAdd (
+    TAU_DNR_DATA_T          *pDNR,
+    TAU_DNR_ENTRY_T         *pEntry,
+    TAU_DNR_QUERY_STATE_T   state)
+{
+    if (pEntry->state == (UINT8) TAU_DNR_IDLE)
+    {
+        pEntry->pNextBusy   = pDNR->pBusy;
+        pDNR->pBusy         = pEntry;
+    }
+    pEntry->state = (UINT8) state;
+}
+
+/**********************************************************************************************************************/
+/** Remove all entries which became idle from the list of queued and querying entries
  *
- *  @retval         none
+ *  @param[in]      pDNR            Pointer to dnr data
  */
-static void changetoDnsNameFormat (UINT8 *pDns, CHAR8 *pHost)
+static void busyCleanup (
+    TAU_DNR_DATA_T *pDNR)
 {
-    int lock = 0, i;
+    TAU_DNR_ENTRY_T **ppIter = &pDNR->pBusy;
 
-    vos_strncat(pHost, TRDP_MAX_URI_HOST_LEN, ".");
+    while (*ppIter != NULL)
+    {
+        if ((*ppIter)->state == (UINT8) TAU_DNR_IDLE)
+        {
+            TAU_DNR_ENTRY_T *pEntry = *ppIter;
+            *ppIter = pEntry->pNextBusy;
+            pEntry->pNextBusy = NULL;
+        }
+        else
+        {
+            ppIter = &(*ppIter)->pNextBusy;
+        }
+    }
+}
 
-    for (i = 0; i < (int)strlen((char *)pHost); i++)
+/**********************************************************************************************************************/
+/** Finish all running queries, entries which were not answered get the given result
+ *
+ *  @param[in]      pDNR            Pointer to dnr data
+ *  @param[in]      result          Result for the unanswered entries
+ */
+static void busyFinish (
+    TAU_DNR_DATA_T  *pDNR,
+    TRDP_ERR_T      result)
+{
+    TAU_DNR_ENTRY_T *pEntry;
+
+    for (pEntry = pDNR->pBusy; pEntry != NULL; pEntry = pEntry->pNextBusy)
     {
-        if (pHost[i] == '.')
+        if (pEntry->state == (UINT8) TAU_DNR_QUERYING)
         {
-            *pDns++ = (UINT8) (i - lock);
-            for (; lock < i; lock++)
-            {
-                *pDns++ = (UINT8) pHost[lock];
-            }
-            lock++;
+            pEntry->state   = (UINT8) TAU_DNR_IDLE;
+            pEntry->result  = result;
         }
     }
-    *pDns++ = '\0';
+    busyCleanup(pDNR);
 }
 
-static int compareURI ( const void *arg1, const void *arg2 )
+/**********************************************************************************************************************/
+/** Deliver the results of all pending resolutions whose query has finished.
+ *  The callbacks are executed with the session mutex held.
+ *
+ *  @param[in]      appHandle       Session context
+ *  @param[in]      pDNR            Pointer to dnr data
+ */
+static void completePending (
+    TRDP_APP_SESSION_T  appHandle,
+    TAU_DNR_DATA_T      *pDNR)
 {
-    return vos_strnicmp((const CHAR8 *)arg1, (const CHAR8 *)arg2, TRDP_MAX_URI_HOST_LEN);
+    TAU_DNR_PENDING_T   *pDone  = NULL;
+    TAU_DNR_PENDING_T   **ppIter = &pDNR->pPending;
+    TAU_DNR_PENDING_T   *pPending;
+
+    /* Unlink first, the callbacks may start new resolutions */
+    while (*ppIter != NULL)
+    {
+        pPending = *ppIter;
+        if (pPending->pEntry->state == (UINT8) TAU_DNR_IDLE)
+        {
+            *ppIter         = pPending->pNext;
+            pPending->pNext = pDone;
+            pDone           = pPending;
+        }
+        else
+        {
+            ppIter = &pPending->pNext;
+        }
+    }
+    while (pDone != NULL)
+    {
+        pPending    = pDone;
+        pDone       = pPending->pNext;
+        if (pPending->pfCbFunction != NULL)
+        {
+            if (pPending->pEntry->result == TRDP_NO_ERR)
+            {
+                pPending->pfCbFunction(pPending->pRefCon, appHandle, pPending->pEntry->uri,
+                                       pPending->pEntry->ipAddr, TRDP_NO_ERR);
+            }
+            else
+            {
+                pPending->pfCbFunction(pPending->pRefCon, appHandle, pPending->pEntry->uri,
+                                       VOS_INADDR_ANY, pPending->pEntry->result);
+            }
+        }
+        vos_memFree(pPending);
+    }
 }
 
 static void printDNRcache (TAU_DNR_DATA_T *pDNR)
 {
-    UINT32 i;
-    for (i = 0u; i < pDNR->noOfCachedEntries; i++)
-    {
-        vos_printLog(VOS_LOG_DBG, "%03u:\t%0u.%0u.%0u.%0u\t%s\t(topo: 0x%08x/0x%08x)\n", i,
-                     pDNR->cache[i].ipAddr >> 24u,
-                     (pDNR->cache[i].ipAddr >> 16u) & 0xFFu,
-                     (pDNR->cache[i].ipAddr >> 8u) & 0xFFu,
-                     pDNR->cache[i].ipAddr & 0xFFu,
-                     pDNR->cache[i].uri,
-                     pDNR->cache[i].etbTopoCnt,
-                     pDNR->cache[i].opTrnTopoCnt);
+    TAU_DNR_ENTRY_T *pEntry;
+    UINT32          i;
+    UINT32          n = 0u;
+
+    for (i = 0u; i < pDNR->noOfBuckets; i++)
+    {
+        for (pEntry = pDNR->ppUriHash[i]; pEntry != NULL; pEntry = pEntry->pNext)
+        {
+            vos_printLog(VOS_LOG_DBG, "%03u:\t%0u.%0u.%0u.%0u\t%s\t(topo: 0x%08x/0x%08x)\n", n++,
+                         pEntry->ipAddr >> 24u,
+                         (pEntry->ipAddr >> 16u) & 0xFFu,
+                         (pEntry->ipAddr >> 8u) & 0xFFu,
+                         pEntry->ipAddr & 0xFFu,
+                         pEntry->uri,
+                         pEntry->etbTopoCnt,
+                         pEntry->opTrnTopoCnt);
+        }
     }
 }
 
@@ -291,14 +625,17 @@ static TRDP_ERR_T readHostsFile (
     if (fp != NULL)
     {
         /* while not end of file */
-        while ((!feof(fp)) && (pDNR->noOfCachedEntries < TAU_MAX_NO_CACHE_ENTRY))
+        while (!feof(fp))
         {
             /* get a line from the file */
             if (fgets(line, TAU_MAX_HOSTS_LINE_LENGTH, fp) != NULL)
             {
-                UINT32  start       = 0u;
-                UINT32  l_index       = 0u;
-                UINT32  maxIndex    = (UINT32) strlen(line);
+                UINT32          start       = 0u;
+                UINT32          l_index     = 0u;
+                UINT32          maxIndex    = (UINT32) strlen(line);
+                TRDP_IP_ADDR_T  ipAddr;
+                CHAR8           uri[TRDP_MAX_URI_HOST_LEN];
+                TAU_DNR_ENTRY_T *pEntry;
 
                 /* Skip empty lines, comment lines */
                 if (line[l_index] == '#' ||
@@ -309,9 +646,9 @@ static TRDP_ERR_T readHostsFile (
                 }
 
                 /* Try to get IP */
-                pDNR->cache[pDNR->noOfCachedEntries].ipAddr = vos_dottedIP(&line[l_index]);
+                ipAddr = vos_dottedIP(&line[l_index]);
 
-                if (pDNR->cache[pDNR->noOfCachedEntries].ipAddr == VOS_INADDR_ANY)
+                if (ipAddr == VOS_INADDR_ANY)
                 {
                     continue;
                 }
@@ -335,22 +672,32 @@ static TRDP_ERR_T readHostsFile (
                 {
                     l_index++;
                 }
-                if (l_index < maxIndex)
+                /* skip invalid entries */
+                if ((l_index >= maxIndex) || (l_index == start))
                 {
-                    vos_strncpy(pDNR->cache[pDNR->noOfCachedEntries].uri, &line[start], l_index - start);
+                    continue;
                 }
-                /* increment only if entry is valid */
-                if (strlen(pDNR->cache[pDNR->noOfCachedEntries].uri) > 0u)
+                memset(uri, 0, sizeof(uri));
+                vos_strncpy(uri, &line[start], ((l_index - start) < TRDP_MAX_URI_HOST_LEN) ?
+                            (l_index - start) : (TRDP_MAX_URI_HOST_LEN - 1u));
+
+                pEntry = cacheFind(pDNR, uri);
+                if (pEntry == NULL)
                 {
-                    pDNR->cache[pDNR->noOfCachedEntries].etbTopoCnt     = 0u;
-                    pDNR->cache[pDNR->noOfCachedEntries].opTrnTopoCnt   = 0u;
-                    pDNR->cache[pDNR->noOfCachedEntries].fixedEntry     = TRUE;
-                    pDNR->noOfCachedEntries++;
+                    pEntry = cacheAdd(pDNR, uri);
+                    if (pEntry == NULL)
+                    {
+                        break;
+                    }
                 }
+                cacheSetAddr(pDNR, pEntry, ipAddr);
+                pEntry->etbTopoCnt      = 0u;
+                pEntry->opTrnTopoCnt    = 0u;
+                pEntry->result          = TRDP_NO_ERR;
+                pEntry->fixedEntry      = TRUE;
             }
         }
         vos_printLog(VOS_LOG_DBG, "readHostsFile: %d entries processed\n", pDNR->noOfCachedEntries);
-        vos_qsort(pDNR->cache, pDNR->noOfCachedEntries, sizeof(TAU_DNR_ENTRY_T), compareURI);
         fclose(fp);
         printDNRcache(pDNR);
         err = TRDP_NO_ERR;
@@ -363,354 +710,329 @@ static TRDP_ERR_T readHostsFile (
 }
 
 /**********************************************************************************************************************/
-/**    create and send a DNS query
+/** Function to convert www.newtec.de to 3www6newtec2de0
  *
- *  @param[in]      sock            Socket descriptor
- *  @param[in]      pUri            Pointer to host name
- *  @param[in]      id              ID to identify reply
- *  @param[in]      pSize           Last entry which was invalid, can be NULL
+ *  @param[in]      pDns            Pointer to destination position
+ *  @param[in]      pHost           Pointer to source string
+ *
+ *  @retval         none
+ */
+static void changetoDnsNameFormat (UINT8 *pDns, CHAR8 *pHost)
+{
+    int lock = 0, i;
+
+    vos_strncat(pHost, TRDP_MAX_URI_HOST_LEN, ".");
+
+    for (i = 0; i < (int)strlen((char *)pHost); i++)
+    {
+        if (pHost[i] == '.')
+        {
+            *pDns++ = (UINT8) (i - lock);
+            for (; lock < i; lock++)
+            {
+                *pDns++ = (UINT8) pHost[lock];
+            }
+            lock++;
+        }
+    }
+    *pDns++ = '\0';
+}
+
+/**********************************************************************************************************************/
+/**    create and send a DNS query for a cache entry
+ *  The socket is opened with the first query. The entry is queued as querying on success.
+ *
+ *  @param[in]      pDNR            Pointer to dnr data
+ *  @param[in]      pEntry          Cache entry to resolve
  *
  *  @retval         TRDP_NO_ERR     no error
  *  @retval         TRDP_PARAM_ERR  Parameter error
- *  @retval         TRDP_INIT_ERR   initialisation error
+ *  @retval         TRDP_SOCK_ERR   socket error
  *
  */
 static TRDP_ERR_T createSendQuery (
     TAU_DNR_DATA_T  *pDNR,
-    SOCKET           sock,
-    const CHAR8     *pUri,
-    UINT16          id,
-    UINT32          *pSize)
+    TAU_DNR_ENTRY_T *pEntry)
 {
-    CHAR8               strBuf[TRDP_MAX_URI_HOST_LEN];      /* conversion enlarges this buffer */
+    CHAR8               strBuf[TRDP_MAX_URI_HOST_LEN + 1u];     /* conversion enlarges this buffer */
     UINT8               packetBuffer[TAU_MAX_DNS_BUFFER_SIZE + 1u];
     UINT8               *pBuf;
     TAU_DNS_HEADER_T    *pHeader = (TAU_DNS_HEADER_T *) packetBuffer;
     UINT32              size;
     TRDP_ERR_T          err;
+    TRDP_TIME_T         timeout = {0, 0};
 
-    if ((pUri == NULL) || (strlen(pUri) == 0u) || (pSize == NULL))
+    if (strlen(pEntry->uri) == 0u)
     {
         vos_printLogStr(VOS_LOG_ERROR, "createSendQuery has no search string\n");
         return TRDP_PARAM_ERR;
     }
 
+    if (pDNR->dnsSock == VOS_INVALID_SOCKET)
+    {
+        VOS_SOCK_OPT_T opts;
+
+        memset(&opts, 0, sizeof(opts));
+        opts.nonBlocking = TRUE;
+        if (vos_sockOpenUDP(&pDNR->dnsSock, &opts) != VOS_NO_ERR)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "createSendQuery failed to open socket\n");
+            pDNR->dnsSock = VOS_INVALID_SOCKET;
+            return TRDP_SOCK_ERR;
+        }
+    }
+
     memset(packetBuffer, 0, TAU_MAX_DNS_BUFFER_SIZE);
 
-    pHeader->id         = vos_htons(id);
+    pEntry->queryId     = pDNR->nextQueryId++;
+    pHeader->id         = vos_htons(pEntry->queryId);
     pHeader->param1     = 0x1u;              /* Recursion desired */
     pHeader->param2     = 0x0u;              /* all zero */
     pHeader->q_count    = vos_htons(1);
 
     pBuf = (UINT8 *) (pHeader + 1);
 
-    vos_strncpy((char *)strBuf, pUri, TRDP_MAX_URI_HOST_LEN-1);
+    memset(strBuf, 0, sizeof(strBuf));
+    vos_strncpy((char *)strBuf, pEntry->uri, TRDP_MAX_URI_HOST_LEN - 1u);
     changetoDnsNameFormat(pBuf, strBuf);
 
-    *pSize = (UINT32) strlen((char *)strBuf) + 1u;
-
-    pBuf    += *pSize;
+    pBuf    += strlen((char *)strBuf) + 1u;
     *pBuf++ = 0u;                /* Query type 'A'   */
-    *pBuf++ = 1u;
-    *pBuf++ = 0u;                /* Query class ?   */
-    *pBuf++ = 1u;
+    *pBuf++ = TAU_DNS_TYPE_A;
+    *pBuf++ = 0u;                /* Query class 'IN' */
+    *pBuf++ = TAU_DNS_CLASS_IN;
     size    = (UINT32) (pBuf - packetBuffer);
-    *pSize  += 4u;               /* add query type and class size! */
 
     /* send the query */
-    err = (TRDP_ERR_T) vos_sockSendUDP(sock, packetBuffer, &size, pDNR->dnsIpAddr, pDNR->dnsPort);
+    err = (TRDP_ERR_T) vos_sockSendUDP(pDNR->dnsSock, packetBuffer, &size, pDNR->dnsIpAddr, pDNR->dnsPort);
     if (err != TRDP_NO_ERR)
     {
         vos_printLogStr(VOS_LOG_ERROR, "createSendQuery failed to sent a query!\n");
         return err;
     }
+
+    vos_getTime(&pEntry->queryTimeout);
+    timeout.tv_sec = pDNR->timeout;
+    vos_addTime(&pEntry->queryTimeout, &timeout);
+    busyAdd(pDNR, pEntry, TAU_DNR_QUERYING);
     return err;
 }
 
 /**********************************************************************************************************************/
-static void parseResponse (
-    UINT8           *pPacket,
-    UINT32          size,
-    UINT16          id,
-    UINT32          querySize,
-    TRDP_IP_ADDR_T  *pIP_addr)
+/** Skip a (possibly compressed) name in a DNS message
+ *
+ *  @param[in]      pPacket         Pointer to start of packet buffer
+ *  @param[in]      size            Size of the packet
+ *  @param[in]      offset          Offset of the name
+ *
+ *  @retval         offset behind the name, 0 if the name is malformed
+ */
+static UINT32 skipName (
+    const UINT8 *pPacket,
+    UINT32      size,
+    UINT32      offset)
 {
-    TAU_DNS_HEADER_T *dns = (TAU_DNS_HEADER_T *) pPacket;
-    UINT8   *pReader;
-    UINT32  i;
-    UINT32  skip;
-    CHAR8   name[256];
-    TAU_RES_RECORD_T answers[20] /*, auth[20], addit[20]*/;    /* the replies from the DNS server */
-
-    size = size;
-    id = id;
-
-    /* move ahead of the dns header and the query field */
-    pReader = pPacket + sizeof(TAU_DNS_HEADER_T) + querySize;
-
-    vos_printLogStr(VOS_LOG_DBG, "The response contains : \n");
-    vos_printLog(VOS_LOG_DBG, " %d Questions.\n", vos_ntohs(dns->q_count));
-    vos_printLog(VOS_LOG_DBG, " %d Answers.\n", vos_ntohs(dns->ans_count));
-    vos_printLog(VOS_LOG_DBG, " %d Authoritative Servers.\n", vos_ntohs(dns->auth_count));
-    vos_printLog(VOS_LOG_DBG, " %d Additional records.\n", vos_ntohs(dns->add_count));
-
-    /* reading answers */
-
-    for (i = 0u; i < vos_ntohs(dns->ans_count); i++)
+    while (offset < size)
     {
-        (void) readName(pReader, pPacket, &skip, name);     /*lint !e920 cast to void */
-        pReader += skip;
-
-        answers[i].resource = (TAU_R_DATA_T *)(pReader);
-        pReader = pReader + sizeof(TAU_R_DATA_T);
-
-        if (vos_ntohs(answers[i].resource->type) == 1u) /* if its an ipv4 address */
+        if (pPacket[offset] == 0u)
         {
-            if (vos_ntohs(answers[i].resource->data_len) != 4u)
-            {
-                vos_printLog(VOS_LOG_ERROR,
-                             "*** DNS server promised IPv4 address, but returned %d Bytes!!!\n",
-                             vos_ntohs(answers[i].resource->data_len));
-                *pIP_addr = VOS_INADDR_ANY;
-            }
-
-            *pIP_addr = (TRDP_IP_ADDR_T) ((pReader[0] << 24u) | (pReader[1] << 16u) | (pReader[2] << 8u) | pReader[3]);
-            vos_printLog(VOS_LOG_INFO, "%s -> 0x%08x\n", name, *pIP_addr);
-
-            pReader = pReader + vos_ntohs(answers[i].resource->data_len);
-
+            return offset + 1u;
         }
-        else
+        if (pPacket[offset] >= 192u)                /* compression pointer ends the name */
         {
-            answers[i].rdata = (UINT8 *) readName(pReader, pPacket, &skip, name);
-            pReader += skip;
+            return (offset + 2u <= size) ? offset + 2u : 0u;
         }
-
+        offset += pPacket[offset] + 1u;
     }
-#if 0   /* Will we ever need more? Just in case... */
+    return 0u;
+}
+
+/**********************************************************************************************************************/
+/** Get the first IPv4 address and its TTL from a DNS response
+ *
+ *  @param[in]      pPacket         Pointer to the received packet
+ *  @param[in]      size            Size of the packet
+ *  @param[out]     pId             Query ID
+ *  @param[out]     pIpAddr         Resolved address
+ *  @param[out]     pTtl            TTL of the answer in seconds
+ *
+ *  @retval         TRDP_NO_ERR         address found
+ *  @retval         TRDP_UNRESOLVED_ERR name error or no address in the answer
+ *  @retval         TRDP_PACKET_ERR     no valid response
+ */
+static TRDP_ERR_T parseResponse (
+    const UINT8     *pPacket,
+    UINT32          size,
+    UINT16          *pId,
+    TRDP_IP_ADDR_T  *pIpAddr,
+    UINT32          *pTtl)
+{
+    const TAU_DNS_HEADER_T  *pHeader = (const TAU_DNS_HEADER_T *) pPacket;
+    TAU_R_DATA_T            resource;
+    UINT32                  offset = sizeof(TAU_DNS_HEADER_T);
+    UINT32                  i;
 
-    /* read authorities */
-    for (i = 0; i < vos_ntohs(dns->auth_count); i++)
+    if ((size < sizeof(TAU_DNS_HEADER_T)) || ((pHeader->param1 & 0x80u) == 0u))
     {
-        auth[i].name    = (UINT8 *) readName(pReader, pPacket, &skip, name);
-        pReader         += skip;
+        return TRDP_PACKET_ERR;
+    }
+    *pId = vos_ntohs(pHeader->id);
 
-        auth[i].resource = (struct R_DATA *)(pReader);
-        pReader += sizeof(struct R_DATA);
+    vos_printLog(VOS_LOG_DBG, "DNS response %u: %d questions, %d answers\n",
+                 *pId, vos_ntohs(pHeader->q_count), vos_ntohs(pHeader->ans_count));
 
-        auth[i].rdata   = (UINT8 *) readName(pReader, pPacket, &skip, name);
-        pReader         += skip;
+    if ((pHeader->param2 & 0x0Fu) != 0u)       /* response code, e.g. name error */
+    {
+        return TRDP_UNRESOLVED_ERR;
     }
 
-    /* read additional */
-    for (i = 0; i < vos_ntohs(dns->add_count); i++)
+    /* move ahead of the query fields */
+    for (i = 0u; i < vos_ntohs(pHeader->q_count); i++)
     {
-        addit[i].name   = (UINT8 *) readName(pReader, pPacket, &skip, name);
-        pReader         += skip;
-
-        addit[i].resource = (struct R_DATA *)(pReader);
-        pReader += sizeof(struct R_DATA);
-
-        if (vos_ntohs(addit[i].resource->type) == 1)
+        offset = skipName(pPacket, size, offset);
+        if ((offset == 0u) || (offset + 4u > size))
         {
-            int j;
-            addit[i].rdata = (UINT8 *)vos_memAlloc(vos_ntohs(addit[i].resource->data_len));
-            for (j = 0; j < vos_ntohs(addit[i].resource->data_len); j++)
-            {
-                addit[i].rdata[j] = pReader[j];
-            }
-
-            addit[i].rdata[vos_ntohs(addit[i].resource->data_len)] = '\0';
-            pReader += vos_ntohs(addit[i].resource->data_len);
-
-        }
-        else
-        {
-            addit[i].rdata  = (UINT8 *) readName(pReader, pPacket, &skip, name);
-            pReader         += skip;
+            return TRDP_PACKET_ERR;
         }
+        offset += 4u;                           /* query type and class */
     }
 
-    /* print answers */
-    for (i = 0; i < vos_ntohs(dns->ans_count); i++)
+    /* reading answers */
+    for (i = 0u; i < vos_ntohs(pHeader->ans_count); i++)
     {
-        /* printf("\nAnswer : %d",i+1); */
-        vos_printLog(VOS_LOG_DBG, "Name : %s ", answers[i].name);
-
-        if (vos_ntohs(answers[i].resource->type) == 1) /* IPv4 address */
+        offset = skipName(pPacket, size, offset);
+        if ((offset == 0u) || (offset + sizeof(TAU_R_DATA_T) > size))
         {
-            vos_printLog(VOS_LOG_DBG, "has IPv4 address : %s", vos_ipDotted(*(UINT32 *)answers[i].rdata));
+            return TRDP_PACKET_ERR;
         }
-        if (vos_ntohs(answers[i].resource->type) == 5) /* Canonical name for an alias */
+        memcpy(&resource, pPacket + offset, sizeof(TAU_R_DATA_T));
+        offset += sizeof(TAU_R_DATA_T);
+        if (offset + vos_ntohs(resource.data_len) > size)
         {
-            vos_printLog(VOS_LOG_DBG, "has alias name : %s", answers[i].rdata);
+            return TRDP_PACKET_ERR;
         }
-
-        printf("\n");
-    }
-
-    /* print authorities */
-    for (i = 0; i < vos_ntohs(dns->auth_count); i++)
-    {
-        /* printf("\nAuthorities : %d",i+1); */
-        vos_printLog(VOS_LOG_DBG, "Name : %s ", auth[i].name);
-        if (vos_ntohs(auth[i].resource->type) == 2)
+        if ((vos_ntohs(resource.type) == TAU_DNS_TYPE_A) && (vos_ntohs(resource.rclass) == TAU_DNS_CLASS_IN))
         {
-            vos_printLog(VOS_LOG_DBG, "has authoritative nameserver : %s", auth[i].rdata);
-        }
-        vos_printLog(VOS_LOG_DBG, "\n");
-    }
-
-    /* print additional resource records */
-    for (i = 0; i < vos_ntohs(dns->add_count); i++)
-    {
-        /* printf("\nAdditional : %d",i+1); */
-        vos_printLog(VOS_LOG_DBG, "Name : %s ", addit[i].name);
-        if (vos_ntohs(addit[i].resource->type) == 1)
-        {
-            vos_printLog(VOS_LOG_DBG, "has IPv4 address : %s", vos_ipDotted(*(UINT32 *)addit[i].rdata));
+            if (vos_ntohs(resource.data_len) != 4u)
+            {
+                vos_printLog(VOS_LOG_ERROR,
+                             "*** DNS server promised IPv4 address, but returned %d Bytes!!!\n",
+                             vos_ntohs(resource.data_len));
+                return TRDP_PACKET_ERR;
+            }
+            *pIpAddr = ((TRDP_IP_ADDR_T) pPacket[offset] << 24u) | ((TRDP_IP_ADDR_T) pPacket[offset + 1u] << 16u) |
+                       ((TRDP_IP_ADDR_T) pPacket[offset + 2u] << 8u) | (TRDP_IP_ADDR_T) pPacket[offset + 3u];
+            *pTtl = vos_ntohl(resource.ttl);
+            return TRDP_NO_ERR;
         }
-        vos_printLog(VOS_LOG_DBG, "\n");
+        offset += vos_ntohs(resource.data_len);     /* e.g. canonical name for an alias */
     }
-#endif
-
+    return TRDP_UNRESOLVED_ERR;
 }
 
 /**********************************************************************************************************************/
-/**    Query the DNS server for the addresses
+/**    Read all DNS responses available on the socket and update the cache
  *
- *  @param[in]      appHandle           Handle returned by tlc_openSession()
- *  @param[in]      pTemp               Last entry which was invalid, can be NULL
- *  @param[in]      pUri                Pointer to host name
- *
- *  @retval         TRDP_NO_ERR     no error
- *  @retval         TRDP_PARAM_ERR  Parameter error
- *  @retval         TRDP_INIT_ERR   initialisation error
+ *  @param[in]      appHandle           Session context
+ *  @param[in]      pDNR                Pointer to dnr data
  *
  */
-static void updateDNSentry (
+static void receiveDNSresponses (
     TRDP_APP_SESSION_T  appHandle,
-    TAU_DNR_ENTRY_T     *pTemp,
-    const CHAR8         *pUri)
+    TAU_DNR_DATA_T      *pDNR)
 {
-    SOCKET          my_socket;
-    VOS_ERR_T       err;
     UINT8           packetBuffer[TAU_MAX_DNS_BUFFER_SIZE];
     UINT32          size;
-    UINT32          querySize;
-    VOS_SOCK_OPT_T  opts;
-    UINT16          id      = (UINT16) (((UINT16) appHandle) & 0xFFFFu);   /*lint !e507 
-                                                                           size incomatibility,
-                                                                           converting 4 byte pointer to 2 byte integral */
-    TAU_DNR_DATA_T  *pDNR   = (TAU_DNR_DATA_T *) appHandle->pUser;
-    TRDP_IP_ADDR_T  ip_addr = VOS_INADDR_ANY;
-
-    memset(&opts, 0, sizeof(opts));
-
-    err = vos_sockOpenUDP(&my_socket, &opts);
-
-    if (err != VOS_NO_ERR)
-    {
-        vos_printLogStr(VOS_LOG_ERROR, "updateDNSentry failed to open socket\n");
-        return;
-    }
-
-    err = (VOS_ERR_T) createSendQuery(pDNR, my_socket, pUri, id, &querySize);
-
-    if (err != VOS_NO_ERR)
-    {
-        goto exit;
-    }
+    TRDP_IP_ADDR_T  srcIpAddr;
+    UINT16          srcPort;
+    UINT16          id;
+    TRDP_IP_ADDR_T  ipAddr  = VOS_INADDR_ANY;
+    UINT32          ttl     = 0u;
+    TRDP_ERR_T      err;
+    TAU_DNR_ENTRY_T *pEntry;
+    TRDP_TIME_T     expiry  = {0, 0};
 
-    /* wait for reply */
     for (;; )
     {
-        VOS_FDS_T   rfds;
-        TRDP_TIME_T tv;
-        int         rv;
-
-        tv.tv_sec   = pDNR->timeout;
-        tv.tv_usec  = 0;
-
-        FD_ZERO(&rfds);
-        FD_SET(my_socket, &rfds);      /*lint !e573 !e505
-                                         signed/unsigned division in macro / 
-                                         Redundant left argument to comma */
-        rv = vos_select(my_socket + 1, &rfds, NULL, NULL, &tv);
-
-        if (rv > 0 && FD_ISSET(my_socket, &rfds))      /*lint !e573 !e505
-                                                         signed/unsigned division in macro / 
-                                                         Redundant left argument to comma */
+        size = TAU_MAX_DNS_BUFFER_SIZE;
+        if ((vos_sockReceiveUDP(pDNR->dnsSock, packetBuffer, &size, &srcIpAddr, &srcPort, NULL, FALSE) != VOS_NO_ERR)
+            || (size == 0u))
         {
-            /* Clear our packet buffer  */
-            memset(packetBuffer, 0, TAU_MAX_DNS_BUFFER_SIZE);
-            size = TAU_MAX_DNS_BUFFER_SIZE;
-
-            /* Get what was announced */
-            (void) vos_sockReceiveUDP(my_socket, packetBuffer, &size, &pDNR->dnsIpAddr, &pDNR->dnsPort, NULL, FALSE);
-
-            FD_CLR(my_socket, &rfds); /*lint !e573 !e502 !e505 Signed/unsigned mix in std-header */
-
-            if (size == 0u)
-            {
-                continue;       /* Try again, if there was no data */
-            }
+            break;
+        }
+        if ((srcIpAddr != pDNR->dnsIpAddr) || (srcPort != pDNR->dnsPort))
+        {
+            continue;
+        }
 
-            /*  Get and convert response */
-            parseResponse(packetBuffer, size, id, querySize, &ip_addr);
+        err = parseResponse(packetBuffer, size, &id, &ipAddr, &ttl);
+        if (err == TRDP_PACKET_ERR)
+        {
+            continue;
+        }
 
-            if ((pTemp != NULL) &&
-                (ip_addr != VOS_INADDR_ANY) &&
-                (pTemp->fixedEntry == FALSE))
+        /* Find the query */
+        for (pEntry = pDNR->pBusy; pEntry != NULL; pEntry = pEntry->pNextBusy)
+        {
+            if ((pEntry->state == (UINT8) TAU_DNR_QUERYING) && (pEntry->queryId == id))
             {
-                /* Overwrite outdated entry */
-                pTemp->ipAddr       = ip_addr;
-                pTemp->etbTopoCnt   = appHandle->etbTopoCnt;
-                pTemp->opTrnTopoCnt = appHandle->opTrnTopoCnt;
                 break;
             }
-            else /* It's a new one, update our cache */
-            {
-                UINT32 cacheEntry = pDNR->noOfCachedEntries;
+        }
+        if (pEntry == NULL)
+        {
+            continue;                           /* late or duplicate response */
+        }
 
-                if (cacheEntry >= TAU_MAX_NO_CACHE_ENTRY)   /* Cache is full! */
-                {
-                    cacheEntry = 0u;                        /* Overwrite first */
-                    // tbd: cacheEntry = cacheGetOldest();
-                }
-                else
-                {
-                    pDNR->noOfCachedEntries++;
-                }
+        pEntry->state   = (UINT8) TAU_DNR_IDLE;
+        pEntry->result  = err;
+        if ((err == TRDP_NO_ERR) && (pEntry->fixedEntry == FALSE))
+        {
+            vos_printLog(VOS_LOG_INFO, "%s -> 0x%08x (ttl %u s)\n", pEntry->uri, ipAddr, ttl);
+            cacheSetAddr(pDNR, pEntry, ipAddr);
+            pEntry->etbTopoCnt      = appHandle->etbTopoCnt;
+            pEntry->opTrnTopoCnt    = appHandle->opTrnTopoCnt;
+            vos_getTime(&pEntry->validUntil);
+            expiry.tv_sec = (ttl < TAU_DNS_MIN_TTL) ? TAU_DNS_MIN_TTL : ttl;
+            vos_addTime(&pEntry->validUntil, &expiry);
+        }
+    }
+    busyCleanup(pDNR);
+}
 
-                /* Position found, store everything */
-                vos_strncpy(pDNR->cache[cacheEntry].uri, pUri, TRDP_MAX_URI_HOST_LEN-1);
-                pDNR->cache[cacheEntry].ipAddr          = ip_addr;
-                pDNR->cache[cacheEntry].etbTopoCnt      = appHandle->etbTopoCnt;
-                pDNR->cache[cacheEntry].opTrnTopoCnt    = appHandle->opTrnTopoCnt;
-                pDNR->cache[cacheEntry].fixedEntry      = FALSE;
+/**********************************************************************************************************************/
+/**    Finish the DNS queries without response
+ *
+ *  @param[in]      pDNR                Pointer to dnr data
+ *  @param[in]      pNow                Current time
+ *
+ */
+static void checkDNStimeouts (
+    TAU_DNR_DATA_T      *pDNR,
+    const TRDP_TIME_T   *pNow)
+{
+    TAU_DNR_ENTRY_T *pEntry;
 
-                /* Sort the entries to get faster hits  */
-                vos_qsort(pDNR->cache, pDNR->noOfCachedEntries, sizeof(TAU_DNR_ENTRY_T), compareURI);
-                break;
-            }
-        }
-        else
+    for (pEntry = pDNR->pBusy; pEntry != NULL; pEntry = pEntry->pNextBusy)
+    {
+        if ((pEntry->state == (UINT8) TAU_DNR_QUERYING) && (vos_cmpTime(&pEntry->queryTimeout, pNow) < 0))
         {
-            break;
+            vos_printLog(VOS_LOG_WARNING, "DNS query for %s timed out!\n", pEntry->uri);
+            pEntry->state   = (UINT8) TAU_DNR_IDLE;
+            pEntry->result  = TRDP_TIMEOUT_ERR;
         }
     }
-
-exit:
-    (void) vos_sockClose(my_socket);
-    return;
+    busyCleanup(pDNR);
 }
 
 /**********************************************************************************************************************/
 /**    Build the request payload
+ *  All queued entries are requested first, remaining space is used to refresh outdated entries.
+ *  The requested entries are marked as querying.
  *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession()
  *  @param[in]      pDNR            Reference Context
- *  @param[in]      pRequest        Handle returned by tlc_openSession()
+ *  @param[in]      pRequest        Request telegram
  *  @param[out]     pSize           Pointer to Message Info
  *
  */
@@ -720,79 +1042,68 @@ static void buildRequest (
     TRDP_DNS_REQUEST_T  *pRequest,
     UINT32              *pSize)
 {
-    UINT32  cacheEntry;
+    TAU_DNR_ENTRY_T *pEntry;
+    TRDP_TIME_T     now;
+    UINT32          i;
 
     /* Prepare header */
     memset(pRequest, 0u, sizeof(TRDP_DNS_REQUEST_T));  /*  pRequest->tcnUriCnt = 0; */
     pRequest->version.ver = 1u;
     vos_strncpy(pRequest->deviceName, appHandle->stats.hostName, TRDP_MAX_LABEL_LEN-1);
-    pRequest->etbTopoCnt = appHandle->etbTopoCnt;
-    pRequest->opTrnTopoCnt = appHandle->opTrnTopoCnt;
+    pRequest->etbTopoCnt = vos_htonl(appHandle->etbTopoCnt);
+    pRequest->opTrnTopoCnt = vos_htonl(appHandle->opTrnTopoCnt);
     pRequest->etbId = 255u;            /* don't care */
 
-    /* Walk over the cache entries */
-    for (cacheEntry = 0u; (cacheEntry < pDNR->noOfCachedEntries) && (pRequest->tcnUriCnt < 255u); cacheEntry++)
+    /* The URIs asked for */
+    for (pEntry = pDNR->pBusy;
+         (pEntry != NULL) && (pRequest->tcnUriCnt < TAU_MAX_TCN_URI_CNT);
+         pEntry = pEntry->pNextBusy)
     {
-        /* Needs update? No, if it is a fixed entry (hostsfile) or it is a consist local adress */
-        if ((pDNR->cache[cacheEntry].fixedEntry == TRUE) ||
-            ((pDNR->cache[cacheEntry].ipAddr != 0u) &&
-             (pDNR->cache[cacheEntry].etbTopoCnt == 0u) && (pDNR->cache[cacheEntry].opTrnTopoCnt == 0u)))
-        {
-            continue;
-        }
-        /* Needs update? Only when there is no address or the topocounts do not match */
-        else if ((pDNR->cache[cacheEntry].ipAddr == 0u) ||
-            ((pDNR->cache[cacheEntry].etbTopoCnt != appHandle->etbTopoCnt) ||
-            (pDNR->cache[cacheEntry].opTrnTopoCnt != appHandle->opTrnTopoCnt)))
+        if (pEntry->state == (UINT8) TAU_DNR_QUEUED)
         {
             /* Make sure the string is not longer than 79 chars (+ trailing zero) */
-            vos_strncpy(pRequest->tcnUriList[pRequest->tcnUriCnt].tcnUriStr, pDNR->cache[cacheEntry].uri, TRDP_MAX_URI_HOST_LEN-1);
+            vos_strncpy(pRequest->tcnUriList[pRequest->tcnUriCnt].tcnUriStr, pEntry->uri, TRDP_MAX_URI_HOST_LEN-1);
             pRequest->tcnUriCnt++;
+            pEntry->state = (UINT8) TAU_DNR_QUERYING;
         }
     }
-    /* tbd: add SDT trailer
-       TRDP_ETB_CTRL_VDP_T   *pSafetyTrail = (TRDP_ETB_CTRL_VDP_T*)&pRequest->tcnUriList[pRequest->tcnUriCnt];
-       sdt_validate(pRequest, pSafetyTrail);
-     */
-    *pSize = sizeof(TRDP_DNS_REQUEST_T) - (255u - pRequest->tcnUriCnt) * sizeof(TCN_URI_T);
-}
-
-/**********************************************************************************************************************/
-/**    Add an entry to the DNS cache to be resolved
- *
- *  @param[in]      appHandle       Session context
- *  @param[in]      pDNR            DNR context
- *  @param[in]      pURI            URI to add
- *
- *
- */
-static void addEntry (
-    TRDP_APP_SESSION_T  appHandle,
-    TAU_DNR_DATA_T      *pDNR,
-    const CHAR8         *pURI)
-{
-    /* It's a new one, update our cache */
-    UINT32 cacheEntry = pDNR->noOfCachedEntries;
-
-    if (cacheEntry >= TAU_MAX_NO_CACHE_ENTRY)   /* Cache is full! */
+    if (pRequest->tcnUriCnt == 0u)
     {
-        cacheEntry = 0u;                        /* Overwrite first */
-        // tbd: cacheEntry = cacheGetOldest();
+        *pSize = 0u;
+        return;
     }
-    else
+
+    /* Walk over the cache entries */
+    vos_getTime(&now);
+    for (i = 0u; (i < pDNR->noOfBuckets) && (pRequest->tcnUriCnt < TAU_MAX_TCN_URI_CNT); i++)
     {
-        pDNR->noOfCachedEntries++;
+        for (pEntry = pDNR->ppUriHash[i];
+             (pEntry != NULL) && (pRequest->tcnUriCnt < TAU_MAX_TCN_URI_CNT);
+             pEntry = pEntry->pNext)
+        {
+            /* Needs update? No, if it is a fixed entry (hostsfile), a consist local adress or in a query */
+            if ((pEntry->state != (UINT8) TAU_DNR_IDLE) ||
+                (pEntry->fixedEntry == TRUE) ||
+                ((pEntry->ipAddr != 0u) && (pEntry->etbTopoCnt == 0u) && (pEntry->opTrnTopoCnt == 0u)))
+            {
+                continue;
+            }
+            /* Needs update? Only when there is no address or the topocounts do not match */
+            if ((pEntry->ipAddr == 0u) ||
+                (pEntry->etbTopoCnt != appHandle->etbTopoCnt) ||
+                (pEntry->opTrnTopoCnt != appHandle->opTrnTopoCnt))
+            {
+                vos_strncpy(pRequest->tcnUriList[pRequest->tcnUriCnt].tcnUriStr, pEntry->uri, TRDP_MAX_URI_HOST_LEN-1);
+                pRequest->tcnUriCnt++;
+                busyAdd(pDNR, pEntry, TAU_DNR_QUERYING);
+            }
+        }
     }
-
-    /* Position found, store everything */
-    vos_strncpy(pDNR->cache[cacheEntry].uri, pURI, TRDP_MAX_URI_HOST_LEN-1);
-    pDNR->cache[cacheEntry].ipAddr          = 0u;
-    pDNR->cache[cacheEntry].etbTopoCnt      = appHandle->etbTopoCnt;
-    pDNR->cache[cacheEntry].opTrnTopoCnt    = appHandle->opTrnTopoCnt;
-    pDNR->cache[cacheEntry].fixedEntry      = FALSE;
-
-    /* Sort the entries to get faster hits  */
-    vos_qsort(pDNR->cache, pDNR->noOfCachedEntries, sizeof(TAU_DNR_ENTRY_T), compareURI);
+    /* tbd: add SDT trailer
+       TRDP_ETB_CTRL_VDP_T   *pSafetyTrail = (TRDP_ETB_CTRL_VDP_T*)&pRequest->tcnUriList[pRequest->tcnUriCnt];
+       sdt_validate(pRequest, pSafetyTrail);
+     */
+    *pSize = sizeof(TRDP_DNS_REQUEST_T) - (TAU_MAX_TCN_URI_CNT - pRequest->tcnUriCnt) * sizeof(TCN_URI_T);
 }
 
 /**********************************************************************************************************************/
@@ -812,44 +1123,53 @@ static void parseUpdateTCNResponse (
     UINT32  i;
     TAU_DNR_ENTRY_T *pTemp;
 
-    size = size;
+    if ((size < sizeof(TRDP_DNS_REPLY_T) - TAU_MAX_TCN_URI_CNT * sizeof(TCN_URI_T) - sizeof(TRDP_ETB_CTRL_VDP_T)) ||
+        (size < sizeof(TRDP_DNS_REPLY_T) - (TAU_MAX_TCN_URI_CNT - pReply->tcnUriCnt) * sizeof(TCN_URI_T)
+         - sizeof(TRDP_ETB_CTRL_VDP_T)))
+    {
+        vos_printLog(VOS_LOG_WARNING, "TCN-DNS reply too short (%u Bytes)\n", size);
+        return;
+    }
+    if (pReply->dnsStatus != 0)
+    {
+        vos_printLog(VOS_LOG_WARNING, "TCN-DNS server status %d\n", pReply->dnsStatus);
+    }
 
     for (i = 0u; i < pReply->tcnUriCnt; i++)
     {
+        pReply->tcnUriList[i].tcnUriStr[sizeof(pReply->tcnUriList[i].tcnUriStr) - 1u] = '\0';
+        pTemp = cacheFind(pDNR, pReply->tcnUriList[i].tcnUriStr);
+        if ((pTemp == NULL) || (pTemp->state != (UINT8) TAU_DNR_QUERYING))
+        {
+            vos_printLog(VOS_LOG_INFO, "%s was not asked for!\n", pReply->tcnUriList[i].tcnUriStr);
+            continue;
+        }
+        pTemp->state = (UINT8) TAU_DNR_IDLE;
         if (pReply->tcnUriList[i].resolvState != -1)
         {
-            pTemp = (TAU_DNR_ENTRY_T *) vos_bsearch(pReply->tcnUriList[i].tcnUriStr,
-                                                pDNR->cache, pDNR->noOfCachedEntries, sizeof(TAU_DNR_ENTRY_T),
-                                                compareURI);
-            if (pTemp != NULL)
+            /* Position found, store everything */
+            cacheSetAddr(pDNR, pTemp, vos_ntohl(pReply->tcnUriList[i].tcnUriIpAddr));
+            pTemp->etbTopoCnt      = vos_ntohl(pReply->etbTopoCnt);
+            pTemp->opTrnTopoCnt    = vos_ntohl(pReply->opTrnTopoCnt);
+            vos_clearTime(&pTemp->validUntil);
+            pTemp->result          = TRDP_NO_ERR;
+            if (pTemp->ipAddr == VOS_INADDR_ANY)
             {
-                /* Position found, store everything */
-                vos_strncpy(pTemp->uri, pReply->tcnUriList[i].tcnUriStr, TRDP_MAX_URI_HOST_LEN-1);
-                pTemp->ipAddr          = vos_ntohl(pReply->tcnUriList[i].tcnUriIpAddr);
-                pTemp->etbTopoCnt      = vos_ntohl(pReply->etbTopoCnt);
-                pTemp->opTrnTopoCnt    = vos_ntohl(pReply->opTrnTopoCnt);
-                pTemp->fixedEntry      = FALSE;
-                if (pTemp->ipAddr == VOS_INADDR_ANY)
-                {
-                    vos_printLog(VOS_LOG_WARNING, "%s resolved to INADDR_ANY\n", pReply->tcnUriList[i].tcnUriStr);
-                }
-            }
-            else
-            {
-                vos_printLog(VOS_LOG_INFO, "%s was not asked for!\n", pReply->tcnUriList[i].tcnUriStr);
+                vos_printLog(VOS_LOG_WARNING, "%s resolved to INADDR_ANY\n", pReply->tcnUriList[i].tcnUriStr);
+                pTemp->result = TRDP_UNRESOLVED_ERR;
             }
         }
         else
         {
             vos_printLog(VOS_LOG_WARNING, "%s could not be resolved\n", pReply->tcnUriList[i].tcnUriStr);
+            pTemp->result = TRDP_UNRESOLVED_ERR;
         }
     }
-    /* Sort the entries to get faster hits  */
-    vos_qsort(pDNR->cache, pDNR->noOfCachedEntries, sizeof(TAU_DNR_ENTRY_T), compareURI);
 }
 
 /**********************************************************************************************************************/
 /**    MD Callback for the TCN-DNS Reply
+ *  Called by tlc_process with the reply or with the timeout of the request.
  *
  *  @param[in]      pRefCon             Reference Context
  *  @param[in]      appHandle           Handle returned by tlc_openSession()
@@ -866,129 +1186,264 @@ static void dnrMDCallback (
     UINT8                   *pData,
     UINT32                  dataSize)
 {
+    TAU_DNR_DATA_T *pDNR;
 
     if ((appHandle == NULL) ||
-         (pData == NULL) ||
-         (dataSize == 0u) ||
          (pMsg == NULL))
     {
          return;
     }
 
     pRefCon = pRefCon;
+    pDNR    = (TAU_DNR_DATA_T *) appHandle->pUser;
+
+    /* Is it the reply to our outstanding request? */
+    if ((pDNR == NULL) ||
+        (pDNR->tcnRequestActive == FALSE) ||
+        (memcmp(pMsg->sessionId, pDNR->tcnSessionId, sizeof(TRDP_UUID_T)) != 0))
+    {
+        return;
+    }
 
     /* we await TCN-DNS reply */
     if ((pMsg->comId == TCN_DNS_REP_COMID) &&
-        (pMsg->resultCode == TRDP_NO_ERR))
+        (pMsg->resultCode == TRDP_NO_ERR) &&
+        (pData != NULL))
     {
-        VOS_SEMA_T      *pDnsSema = (VOS_SEMA_T*) pMsg->pUserRef;
-
         /* tbd: Is packet valid? */
         // if (sdt_isvalid(appHandle, pData, dataSize)) ...
 
         /* update the cache */
-        parseUpdateTCNResponse((TAU_DNR_DATA_T *) appHandle->pUser, (TRDP_DNS_REPLY_T *)pData, dataSize);
-
-        (void) vos_semaGive(*pDnsSema);
+        parseUpdateTCNResponse(pDNR, (TRDP_DNS_REPLY_T *)pData, dataSize);
+        busyFinish(pDNR, TRDP_UNRESOLVED_ERR);
     }
     else
     {
         vos_printLog(VOS_LOG_WARNING, "dnrMDCallback error (resultCode = %d)\n", pMsg->resultCode);
+        busyFinish(pDNR, TRDP_TIMEOUT_ERR);
     }
+    pDNR->tcnRequestActive = FALSE;
+
+    completePending(appHandle, pDNR);
+
+    /* Send what was asked for in the meantime */
+    (void) sendTCNrequest(appHandle, pDNR);
 }
 
 /**********************************************************************************************************************/
-/**    Query the TCN-DNS server for the addresses
+/**    Send a TCN-DNS request for the queued entries, if no request is outstanding
  *
  *  @param[in]      appHandle           Handle returned by tlc_openSession()
- *  @param[in]      pTemp               Last entry which was invalid, can be NULL
- *  @param[in]      pUri                Pointer to host name
+ *  @param[in]      pDNR                DNR context
  *
  *  @retval         TRDP_NO_ERR     no error
- *  @retval         TRDP_PARAM_ERR  Parameter error
- *  @retval         TRDP_INIT_ERR   initialisation error
+ *  @retval         TRDP_xxx_ERR    from tlm_request, the queued entries have failed
  *
  */
-static void updateTCNDNSentry (
+static TRDP_ERR_T sendTCNrequest (
     TRDP_APP_SESSION_T  appHandle,
-    TAU_DNR_ENTRY_T     *pTemp,
-    const CHAR8         *pUri)
+    TAU_DNR_DATA_T      *pDNR)
 {
-    TRDP_ERR_T      err;
-    UINT32          querySize;
-    TAU_DNR_DATA_T  *pDNR   = (TAU_DNR_DATA_T *) appHandle->pUser;
-    VOS_SEMA_T      dnsSema;
-    unsigned int    i;
-
-    static UINT8 sTCN_DNS_Buffer[sizeof(TRDP_DNS_REQUEST_T)];
-
-    TRDP_DNS_REQUEST_T  *pDNS_REQ = (TRDP_DNS_REQUEST_T *)sTCN_DNS_Buffer;
-    TRDP_UUID_T         sessionId;
-
-    /* Create semaphore */
-    err = (TRDP_ERR_T) vos_semaCreate(&dnsSema, VOS_SEMA_EMPTY);
+    TRDP_ERR_T  err;
+    UINT32      querySize;
+    TRDP_TIME_T timeout = {0, 0};
 
-    if (err != TRDP_NO_ERR)
+    if (pDNR->tcnRequestActive == TRUE)
     {
-        vos_printLogStr(VOS_LOG_ERROR, "updateTCNDNSentry failed to get semaphore\n");
-        return;
+        return TRDP_NO_ERR;
     }
 
-    /* Is this URI already in the cache? If not, add it! Eventually remove the oldest  */
-
-    if (pTemp == NULL)
-    {
-        addEntry(appHandle, pDNR, pUri);
-    }
     /* build the request telegram with all possible outdated entries */
-
-    buildRequest(appHandle, pDNR, pDNS_REQ, &querySize);
-
+    buildRequest(appHandle, pDNR, (TRDP_DNS_REQUEST_T *) pDNR->tcnBuffer, &querySize);
     if (querySize == 0u)
     {
-        vos_printLogStr(VOS_LOG_ERROR, "updateTCNDNSentry failed to send request\n");
-        goto exit;
+        return TRDP_NO_ERR;
     }
-    /* send the MD request */
 
-    err = tlm_request(appHandle, &dnsSema, dnrMDCallback, &sessionId, TCN_DNS_REQ_COMID,  /*lint !e545 suspicious use of & parameter 4 */
+    /* send the MD request */
+    pDNR->tcnRequestActive = TRUE;
+    err = tlm_request(appHandle, pDNR, dnrMDCallback, &pDNR->tcnSessionId, TCN_DNS_REQ_COMID,
                         0u, 0u,
                         VOS_INADDR_ANY, pDNR->dnsIpAddr,
                         TRDP_FLAGS_CALLBACK,
                         1u,
                         TCN_DNS_REQ_TO_US,
                         NULL,
-                        sTCN_DNS_Buffer,
+                        pDNR->tcnBuffer,
                         querySize,
                         NULL,
                         NULL);
     if (err != TRDP_NO_ERR)
     {
-        vos_printLogStr(VOS_LOG_ERROR, "updateTCNDNSentry failed to send request\n");
-        goto exit;
+        vos_printLogStr(VOS_LOG_ERROR, "sendTCNrequest failed to send request\n");
+        pDNR->tcnRequestActive = FALSE;
+        busyFinish(pDNR, err);
+        return err;
     }
 
-    /* how do we get the reply? */
-    if (pDNR->useTCN_DNS == TRDP_DNR_OWN_THREAD)
+    /* tlc_getInterval does not know about it, the next interval must be zero */
+    pDNR->tcnRequestQueued = TRUE;
+
+    /* Safety net, if the MD layer does not report the reply timeout */
+    vos_getTime(&pDNR->tcnRequestTimeout);
+    timeout.tv_sec  = (TCN_DNS_REQ_TO_US + TAU_TCN_DNS_MARGIN_US) / 1000000u;
+    timeout.tv_usec = (TCN_DNS_REQ_TO_US + TAU_TCN_DNS_MARGIN_US) % 1000000u;
+    vos_addTime(&pDNR->tcnRequestTimeout, &timeout);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Abort a TCN-DNS request which was not finished by the MD layer in time
+ *
+ *  @param[in]      appHandle           Handle returned by tlc_openSession()
+ *  @param[in]      pDNR                DNR context
+ *  @param[in]      pNow                Current time
+ *
+ */
+static void checkTCNtimeout (
+    TRDP_APP_SESSION_T  appHandle,
+    TAU_DNR_DATA_T      *pDNR,
+    const TRDP_TIME_T   *pNow)
+{
+    if ((pDNR->tcnRequestActive == TRUE) && (vos_cmpTime(&pDNR->tcnRequestTimeout, pNow) < 0))
     {
-        /* we must call tlc_process on our own, if we run single threaded */
+        vos_printLogStr(VOS_LOG_WARNING, "TCN-DNS request timed out!\n");
+        pDNR->tcnRequestActive = FALSE;
+        (void) tlm_abortSession(appHandle, &pDNR->tcnSessionId);
+        busyFinish(pDNR, TRDP_TIMEOUT_ERR);
+    }
+}
 
-        (void) tlc_process(appHandle, NULL, NULL);   /* force sending message data */
+/**********************************************************************************************************************/
+/**    Callback of the blocking tau_uri2Addr
+ *
+ *  @param[in]      pRefCon             Wait context
+ *  @param[in]      appHandle           Handle returned by tlc_openSession()
+ *  @param[in]      pUri                Resolved URI
+ *  @param[in]      ipAddr              Resolved address
+ *  @param[in]      result              Result of the resolution
+ *
+ */
+static void dnrWaitCallback (
+    void                *pRefCon,
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pUri,
+    TRDP_IP_ADDR_T      ipAddr,
+    TRDP_ERR_T          result)
+{
+    TAU_DNR_WAIT_T *pWait = (TAU_DNR_WAIT_T *) pRefCon;
+
+    appHandle       = appHandle;
+    pUri            = pUri;
+    pWait->ipAddr   = ipAddr;
+    pWait->result   = result;
+    pWait->done     = TRUE;
+    vos_semaGive(pWait->sema);
+}
 
-        for (i = 0; i < 2; i++)
-        {
+/**********************************************************************************************************************/
+/**    Callback of the blocking tau_dnrPreResolve
+ *
+ *  @param[in]      pRefCon             Wait context
+ *  @param[in]      appHandle           Handle returned by tlc_openSession()
+ *  @param[in]      pUri                Resolved URI
+ *  @param[in]      ipAddr              Resolved address
+ *  @param[in]      result              Result of the resolution
+ *
+ */
+static void dnrBatchCallback (
+    void                *pRefCon,
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pUri,
+    TRDP_IP_ADDR_T      ipAddr,
+    TRDP_ERR_T          result)
+{
+    TAU_DNR_WAIT_T *pWait = (TAU_DNR_WAIT_T *) pRefCon;
+
+    appHandle   = appHandle;
+    ipAddr      = ipAddr;
+    if (result != TRDP_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_WARNING, "%s not resolved (%d)\n", pUri, result);
+        pWait->noOfUnresolved++;
+    }
+    if (pWait->noOfOpen > 0u)
+    {
+        pWait->noOfOpen--;
+    }
+    if (pWait->noOfOpen == 0u)
+    {
+        pWait->done = TRUE;
+        vos_semaGive(pWait->sema);
+    }
+}
 
-            /* switch context for the reply */
+/**********************************************************************************************************************/
+/**    Wait until a resolution started by tau_uri2Addr or tau_dnrPreResolve has finished
+ *  In TRDP_DNR_COMMON_THREAD mode tlc_process is called by another thread, otherwise the session (TCN-DNS, with the
+ *  resolver) or the resolver alone (standard DNS) is processed here.
+ *
+ *  @param[in]      appHandle           Handle returned by tlc_openSession()
+ *  @param[in]      pDNR                DNR context
+ *  @param[in]      pfCbFunction        Callback of the resolution, cancelled on timeout
+ *  @param[in]      pWait               Wait context
+ *  @param[in]      noOfRequests        Number of TCN-DNS requests needed for the resolution
+ *
+ */
+static void waitForResolution (
+    TRDP_APP_SESSION_T  appHandle,
+    TAU_DNR_DATA_T      *pDNR,
+    TRDP_DNR_CALLBACK_T pfCbFunction,
+    TAU_DNR_WAIT_T      *pWait,
+    UINT32              noOfRequests)
+{
+    const TRDP_TIME_T   max_tv  = {0, TAU_DNR_POLL_US};
+    TRDP_TIME_T         deadline;
+    TRDP_TIME_T         now;
+    TRDP_TIME_T         timeout = {0, 0};
 
-            TRDP_FDS_T          rfds;
-            INT32               noDesc;
-            TRDP_TIME_T         tv = {0, 0};
-            const TRDP_TIME_T   max_tv  = {0, 100000};
-            INT32               rv;
+    /* A TCN-DNS request may have to wait for the outstanding one */
+    if (pDNR->useTCN_DNS != TRDP_DNR_STANDARD_DNS)
+    {
+        timeout.tv_sec = (noOfRequests + 1u) * (TCN_DNS_REQ_TO_US + TAU_TCN_DNS_MARGIN_US) / 1000000u;
+    }
+    else
+    {
+        timeout.tv_sec = pDNR->timeout + 1;
+    }
+    vos_getTime(&deadline);
+    vos_addTime(&deadline, &timeout);
+
+    if (pDNR->useTCN_DNS == TRDP_DNR_OWN_THREAD)
+    {
+        (void) tlc_process(appHandle, NULL, NULL);   /* force sending message data */
+    }
+
+    do
+    {
+        if (pDNR->useTCN_DNS == TRDP_DNR_COMMON_THREAD)
+        {
+            /* There is a communication thread running. Just go to sleep and wait for the semaphore! */
+            (void) vos_semaTake(pWait->sema, TAU_DNR_POLL_US);
+        }
+        else
+        {
+            /* we must call tlc_process on our own, if we run single threaded */
+            TRDP_FDS_T  rfds;
+            INT32       noDesc  = 0;
+            TRDP_TIME_T tv      = max_tv;
+            INT32       rv;
 
             FD_ZERO(&rfds);
 
-            (void) tlc_getInterval(appHandle, &tv, &rfds, &noDesc);
+            if (pDNR->useTCN_DNS == TRDP_DNR_OWN_THREAD)
+            {
+                (void) tlc_getInterval(appHandle, &tv, &rfds, &noDesc);
+            }
+            else
+            {
+                (void) tau_dnrGetInterval(appHandle, &tv, &rfds, &noDesc);
+            }
 
             if (vos_cmpTime(&tv, &max_tv) > 0)
             {
@@ -997,42 +1452,141 @@ static void updateTCNDNSentry (
 
             rv = vos_select(noDesc + 1, &rfds, NULL, NULL, &tv);
 
-            (void) tlc_process(appHandle, &rfds, &rv);
-
-            /* wait 1s for the reply */
-
-            if (vos_semaTake(dnsSema, TCN_DNS_REQ_TO_US) == VOS_NO_ERR)
+            if (pDNR->useTCN_DNS == TRDP_DNR_OWN_THREAD)
             {
-                /* reply arrived */
-                break;
+                (void) tlc_process(appHandle, &rfds, &rv);
             }
             else
             {
-                /* reply timed out */
-                vos_printLogStr(VOS_LOG_WARNING, "TCN-DNS request timed out!\n");
-                continue;
+                (void) tau_dnrProcess(appHandle, &rfds, &rv);
             }
         }
+        vos_getTime(&now);
+    }
+    while ((pWait->done == FALSE) && (vos_cmpTime(&now, &deadline) < 0));
+
+    if (pWait->done == FALSE)
+    {
+        (void) tau_uri2AddrCancel(appHandle, pfCbFunction, pWait);
+        if (pWait->done == FALSE)
+        {
+            pWait->result = TRDP_TIMEOUT_ERR;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Look up a URI in the cache and queue or send the query, if it is not known.
+ *  TCN-DNS requests are not sent here, the caller must call sendTCNrequest. The session mutex must be held.
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession()
+ *  @param[in]      pDNR            DNR context
+ *  @param[out]     pAddr           Pointer to return the IP address, if known
+ *  @param[in]      pUri            Pointer to an URI
+ *  @param[in]      pfCbFunction    Completion callback, NULL to only fill the cache
+ *  @param[in]      pRefCon         User context passed to the callback
+ *
+ *  @retval         TRDP_NO_ERR         address returned, no callback
+ *  @retval         TRDP_BLOCK_ERR      query started, result follows with the callback
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *
+ */
+static TRDP_ERR_T startResolution (
+    TRDP_APP_SESSION_T  appHandle,
+    TAU_DNR_DATA_T      *pDNR,
+    TRDP_IP_ADDR_T      *pAddr,
+    const CHAR8         *pUri,
+    TRDP_DNR_CALLBACK_T pfCbFunction,
+    void                *pRefCon)
+{
+    TAU_DNR_ENTRY_T     *pEntry;
+    TAU_DNR_PENDING_T   *pPending = NULL;
+    TRDP_TIME_T         now;
+    TRDP_ERR_T          err = TRDP_BLOCK_ERR;
+
+    /* Look inside the cache    */
+    vos_getTime(&now);
+    pEntry = cacheFind(pDNR, pUri);
+    if ((pEntry != NULL) && (cacheEntryValid(appHandle, pEntry, &now) == TRUE))
+    {
+        *pAddr = pEntry->ipAddr;
+        return TRDP_NO_ERR;
+    }
+
+    /* address is not known or out of date (topocounts differ, TTL expired)  */
+    if (pEntry == NULL)
+    {
+        pEntry = cacheAdd(pDNR, pUri);
+    }
+    if (pfCbFunction != NULL)
+    {
+        pPending = (TAU_DNR_PENDING_T *) vos_memAlloc(sizeof(TAU_DNR_PENDING_T));
     }
-    else /* We can assume that there is a communication thread running. Just go to sleep and wait for the semaphore! */
+    if ((pEntry == NULL) || ((pfCbFunction != NULL) && (pPending == NULL)))
     {
-        if (vos_semaTake(dnsSema, TCN_DNS_REQ_TO_US) == VOS_NO_ERR)
+        err = TRDP_MEM_ERR;
+    }
+    else if (pEntry->state == (UINT8) TAU_DNR_IDLE)
+    {
+        if (pDNR->useTCN_DNS != TRDP_DNR_STANDARD_DNS)
         {
-            /* reply arrived */
+            busyAdd(pDNR, pEntry, TAU_DNR_QUEUED);
         }
         else
         {
-            vos_printLogStr(VOS_LOG_WARNING, "TCN-DNS request timed out!\n");
-            /* reply timed out */
+            err = createSendQuery(pDNR, pEntry);
+            err = (err == TRDP_NO_ERR) ? TRDP_BLOCK_ERR : err;
         }
     }
-
-    /* kill the session to avoid dangeling semaphore */
-    (void) tlm_abortSession(appHandle, &sessionId); /*lint !e545 suspicious use of & parameter 2 */
-
-exit:
-    vos_semaDelete(dnsSema);
-    return;
+    if ((err == TRDP_BLOCK_ERR) && (pPending != NULL))
+    {
+        pPending->pEntry        = pEntry;
+        pPending->pfCbFunction  = pfCbFunction;
+        pPending->pRefCon       = pRefCon;
+        pPending->pNext         = pDNR->pPending;
+        pDNR->pPending          = pPending;
+    }
+    else if (pPending != NULL)
+    {
+        vos_memFree(pPending);
+    }
+
+    *pAddr = VOS_INADDR_ANY;
+    return err;
+}
+
+/**********************************************************************************************************************/
+/**    Start the resolution of one configured URI of tau_dnrPreResolve
+ *  Empty URIs and IP addresses are skipped. The session mutex must be held.
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession()
+ *  @param[in]      pDNR            DNR context
+ *  @param[in]      pWait           Batch wait context
+ *  @param[in]      pUriHost        Configured URI host part, may be NULL
+ *
+ */
+static void startBatchResolution (
+    TRDP_APP_SESSION_T      appHandle,
+    TAU_DNR_DATA_T          *pDNR,
+    TAU_DNR_WAIT_T          *pWait,
+    const TRDP_URI_HOST_T   *pUriHost)
+{
+    TRDP_IP_ADDR_T  ipAddr;
+    TRDP_ERR_T      err;
+
+    if ((pUriHost == NULL) || ((*pUriHost)[0] == '\0') || (vos_dottedIP(*pUriHost) != VOS_INADDR_ANY))
+    {
+        return;
+    }
+    err = startResolution(appHandle, pDNR, &ipAddr, *pUriHost, dnrBatchCallback, pWait);
+    if (err == TRDP_BLOCK_ERR)
+    {
+        pWait->noOfOpen++;
+    }
+    else if (err != TRDP_NO_ERR)
+    {
+        pWait->noOfUnresolved++;
+    }
 }
 
 #pragma mark ----------------------- Public -----------------------------
@@ -1051,6 +1605,7 @@ exit:
  *  3. TRDP_DNR_STANDARD_DNS
  *      Use standard DNS instead of TCN-DNS.
  *  Default dnsPort (= 0) for TCN-DNS is 17225, for standard DNS it is 53.
+ *  In all modes the resolver is processed by tlc_getInterval() and tlc_process() of the session from now on.
  *
  *  @param[in]      appHandle       Handle returned by tlc_openSession().
  *  @param[in]      dnsIpAddr       DNS/ECSP IP address.
@@ -1071,6 +1626,7 @@ EXT_DECL TRDP_ERR_T tau_initDnr (
 {
     TRDP_ERR_T      err = TRDP_NO_ERR;
     TAU_DNR_DATA_T  *pDNR;      /**< default DNR/ECSP settings  */
+    TRDP_TIME_T     now;
 
     if (appHandle == NULL)
     {
@@ -1083,10 +1639,16 @@ EXT_DECL TRDP_ERR_T tau_initDnr (
         return TRDP_MEM_ERR;
     }
 
-    /* save to application session */
-    appHandle->pUser = pDNR;
+    if (cacheResize(pDNR, TAU_DNR_INITIAL_BUCKETS) != TRDP_NO_ERR)
+    {
+        vos_memFree(pDNR);
+        return TRDP_MEM_ERR;
+    }
 
     pDNR->dnsIpAddr     = (dnsIpAddr == 0u) ? 0x0a000001u : dnsIpAddr;
+    pDNR->dnsSock       = VOS_INVALID_SOCKET;
+    vos_getTime(&now);
+    pDNR->nextQueryId   = (UINT16) (now.tv_usec & 0xFFFF);
 
     /* Set default ports */
     if (dnsOptions == TRDP_DNR_STANDARD_DNS)
@@ -1108,14 +1670,26 @@ EXT_DECL TRDP_ERR_T tau_initDnr (
     }
     else
     {
-        pDNR->noOfCachedEntries = 0u;
         pDNR->timeout = TAU_DNS_TIME_OUT_LONG;
     }
+
+    /* save to application session */
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        cacheFree(pDNR);
+        vos_memFree(pDNR);
+        return TRDP_MUTEX_ERR;
+    }
+    appHandle->pUser            = pDNR;
+    appHandle->pfUserInterval   = tau_dnrGetInterval;
+    appHandle->pfUserProcess    = tau_dnrProcess;
+    (void) vos_mutexUnlock(appHandle->mutex);
     return err;
 }
 
 /**********************************************************************************************************************/
 /**    Function to deinit DNR
+ *  A TCN-DNS request is aborted, pending resolutions are dropped without calling their callbacks.
  *
  *  @param[in]      appHandle           Handle returned by tlc_openSession()
  *
@@ -1126,11 +1700,38 @@ EXT_DECL TRDP_ERR_T tau_initDnr (
 EXT_DECL void tau_deInitDnr (
     TRDP_APP_SESSION_T appHandle)
 {
+    TAU_DNR_DATA_T      *pDNR;
+    TAU_DNR_PENDING_T   *pPending;
 
     if (appHandle != NULL && appHandle->pUser != NULL)
     {
-        vos_memFree(appHandle->pUser);
-        appHandle->pUser = NULL;
+        if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+        {
+            return;
+        }
+        pDNR = (TAU_DNR_DATA_T *) appHandle->pUser;
+        appHandle->pUser            = NULL;
+        appHandle->pfUserInterval   = NULL;
+        appHandle->pfUserProcess    = NULL;
+        if (pDNR->tcnRequestActive == TRUE)
+        {
+            /* kill the session to avoid a dangling callback */
+            (void) tlm_abortSession(appHandle, &pDNR->tcnSessionId);
+        }
+        (void) vos_mutexUnlock(appHandle->mutex);
+
+        if (pDNR->dnsSock != VOS_INVALID_SOCKET)
+        {
+            (void) vos_sockClose(pDNR->dnsSock);
+        }
+        while (pDNR->pPending != NULL)
+        {
+            pPending        = pDNR->pPending;
+            pDNR->pPending  = pPending->pNext;
+            vos_memFree(pPending);
+        }
+        cacheFree(pDNR);
+        vos_memFree(pDNR);
     }
 }
 
@@ -1168,6 +1769,170 @@ EXT_DECL TRDP_DNR_STATE_T tau_DNRstatus (
     return TRDP_DNR_NOT_AVAILABLE;
 }
 
+/**********************************************************************************************************************/
+/**    Get the file descriptor and the next timeout of the resolver.
+ *  Called by tlc_getInterval once the resolver is initialised, an application only calls it to wait for the
+ *  resolver without processing the session.
+ *  With TCN-DNS it shortens the interval to zero, if a new request waits to be sent by tlc_process.
+ *  The interval is only shortened and the descriptor set only extended.
+ *
+ *  @param[in]      appHandle           Handle returned by tlc_openSession()
+ *  @param[in,out]  pInterval           Interval to the next timeout, shortened if needed
+ *  @param[in,out]  pFileDesc           Set of descriptors to wait for, the DNS socket is added
+ *  @param[in,out]  pNoDesc             Highest descriptor in the set
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      Parameter error
+ *  @retval         TRDP_NOINIT_ERR     DNR not initialised
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_dnrGetInterval (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_TIME_T         *pInterval,
+    TRDP_FDS_T          *pFileDesc,
+    INT32               *pNoDesc)
+{
+    TAU_DNR_DATA_T  *pDNR;
+    TAU_DNR_ENTRY_T *pEntry;
+    TRDP_TIME_T     next     = {0, 0};
+    TRDP_TIME_T     now;
+    BOOL8           timerSet = FALSE;
+
+    if ((appHandle == NULL) || (pInterval == NULL) || (pFileDesc == NULL) || (pNoDesc == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+    pDNR = (TAU_DNR_DATA_T *) appHandle->pUser;
+    if (pDNR == NULL)
+    {
+        (void) vos_mutexUnlock(appHandle->mutex);
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (pDNR->dnsSock != VOS_INVALID_SOCKET)
+    {
+        FD_SET(pDNR->dnsSock, pFileDesc);   /*lint !e573 !e505
+                                              signed/unsigned division in macro /
+                                              Redundant left argument to comma */
+        if (pDNR->dnsSock > *pNoDesc)
+        {
+            *pNoDesc = (INT32) pDNR->dnsSock;
+        }
+    }
+
+    /* Earliest timeout */
+    if (pDNR->tcnRequestQueued == TRUE)
+    {
+        /* the request will be sent by the next tlc_process */
+        pDNR->tcnRequestQueued  = FALSE;
+        timerSet                = TRUE;
+    }
+    else if (pDNR->tcnRequestActive == TRUE)
+    {
+        next        = pDNR->tcnRequestTimeout;
+        timerSet    = TRUE;
+    }
+    for (pEntry = pDNR->pBusy; pEntry != NULL; pEntry = pEntry->pNextBusy)
+    {
+        if ((pEntry->state == (UINT8) TAU_DNR_QUERYING) &&
+            (pDNR->useTCN_DNS == TRDP_DNR_STANDARD_DNS) &&
+            ((timerSet == FALSE) || (vos_cmpTime(&pEntry->queryTimeout, &next) < 0)))
+        {
+            next        = pEntry->queryTimeout;
+            timerSet    = TRUE;
+        }
+    }
+    if (timerSet == TRUE)
+    {
+        vos_getTime(&now);
+        if (vos_cmpTime(&next, &now) > 0)
+        {
+            vos_subTime(&next, &now);
+        }
+        else
+        {
+            vos_clearTime(&next);
+        }
+        if (vos_cmpTime(&next, pInterval) < 0)
+        {
+            *pInterval = next;
+        }
+    }
+    (void) vos_mutexUnlock(appHandle->mutex);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Work loop of the resolver.
+ *  Receives DNS responses, handles the timeouts and delivers the results of finished resolutions.
+ *  Called by tlc_process once the resolver is initialised, an application only calls it to serve the resolver
+ *  without processing the session.
+ *
+ *  @param[in]      appHandle           Handle returned by tlc_openSession()
+ *  @param[in]      pRfds               Set of ready descriptors, NULL to check the DNS socket anyway
+ *  @param[in,out]  pCount              Number of ready descriptors, decremented if the DNS socket was ready
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     DNR not initialised
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_dnrProcess (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_FDS_T          *pRfds,
+    INT32               *pCount)
+{
+    TAU_DNR_DATA_T  *pDNR;
+    TRDP_TIME_T     now;
+
+    if (appHandle == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+    pDNR = (TAU_DNR_DATA_T *) appHandle->pUser;
+    if (pDNR == NULL)
+    {
+        (void) vos_mutexUnlock(appHandle->mutex);
+        return TRDP_NOINIT_ERR;
+    }
+
+    if ((pDNR->dnsSock != VOS_INVALID_SOCKET) &&
+        ((pRfds == NULL) || (FD_ISSET(pDNR->dnsSock, pRfds))))  /*lint !e573 !e505
+                                                                   signed/unsigned division in macro /
+                                                                   Redundant left argument to comma */
+    {
+        if ((pRfds != NULL) && (pCount != NULL) && (*pCount > 0))
+        {
+            FD_CLR(pDNR->dnsSock, pRfds);       /*lint !e573 !e502 !e505 Signed/unsigned mix in std-header */
+            (*pCount)--;
+        }
+        receiveDNSresponses(appHandle, pDNR);
+    }
+
+    vos_getTime(&now);
+    if (pDNR->useTCN_DNS == TRDP_DNR_STANDARD_DNS)
+    {
+        checkDNStimeouts(pDNR, &now);
+        completePending(appHandle, pDNR);
+    }
+    else
+    {
+        checkTCNtimeout(appHandle, pDNR, &now);
+        completePending(appHandle, pDNR);
+        (void) sendTCNrequest(appHandle, pDNR);
+    }
+
+    (void) vos_mutexUnlock(appHandle->mutex);
+    return TRDP_NO_ERR;
+}
+
 /* ------------------------------------------------------------------------------------------------------------------ */
 
 /**********************************************************************************************************************/
@@ -1214,13 +1979,130 @@ EXT_DECL TRDP_IP_ADDR_T tau_getOwnAddr (
     return VOS_INADDR_ANY;
 }
 
+/**********************************************************************************************************************/
+/**    Start the resolution of a URI.
+ *  If the address is known, it is returned at once and the callback is not called. Otherwise a query is started and
+ *  the callback is called from tlc_process when it has finished.
+ *  URIs asked for while a TCN-DNS request is outstanding are sent together with the next request.
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession()
+ *  @param[out]     pAddr           Pointer to return the IP address, if known
+ *  @param[in]      pUri            Pointer to an URI or an IP Address string, NULL==own URI
+ *  @param[in]      pfCbFunction    Completion callback, NULL to only fill the cache
+ *  @param[in]      pRefCon         User context passed to the callback
+ *
+ *  @retval         TRDP_NO_ERR         address returned, no callback
+ *  @retval         TRDP_BLOCK_ERR      query started, result follows with the callback
+ *  @retval         TRDP_PARAM_ERR      Parameter error
+ *  @retval         TRDP_NOINIT_ERR     DNR not initialised
+ *  @retval         TRDP_MEM_ERR        out of memory
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_uri2AddrAsync (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_IP_ADDR_T      *pAddr,
+    const TRDP_URI_T    pUri,
+    TRDP_DNR_CALLBACK_T pfCbFunction,
+    void                *pRefCon)
+{
+    TAU_DNR_DATA_T  *pDNR;
+    TRDP_ERR_T      err;
+
+    if (appHandle == NULL ||
+        pAddr == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    /* If no URI given, we return our own address   */
+    if (pUri == NULL)
+    {
+        *pAddr = tau_getOwnAddr(appHandle);
+        return TRDP_NO_ERR;
+    }
+
+    /* Check for dotted IP address  */
+    if ((*pAddr = vos_dottedIP(pUri)) != VOS_INADDR_ANY)
+    {
+        return TRDP_NO_ERR;
+    }
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+    pDNR = (TAU_DNR_DATA_T *) appHandle->pUser;
+    if (pDNR == NULL)
+    {
+        (void) vos_mutexUnlock(appHandle->mutex);
+        return TRDP_NOINIT_ERR;
+    }
+
+    err = startResolution(appHandle, pDNR, pAddr, pUri, pfCbFunction, pRefCon);
+    if ((err == TRDP_BLOCK_ERR) && (pDNR->useTCN_DNS != TRDP_DNR_STANDARD_DNS))
+    {
+        (void) sendTCNrequest(appHandle, pDNR);
+
+        /* A failed request is reported to the callback */
+        completePending(appHandle, pDNR);
+    }
+    (void) vos_mutexUnlock(appHandle->mutex);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/**    Cancel pending resolutions.
+ *  The callbacks of all resolutions started with the given callback function and user context are not called.
+ *  The queries themselves are finished and their results are cached.
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession()
+ *  @param[in]      pfCbFunction    Completion callback given to tau_uri2AddrAsync
+ *  @param[in]      pRefCon         User context given to tau_uri2AddrAsync
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      Parameter error
+ *  @retval         TRDP_NOINIT_ERR     DNR not initialised
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_uri2AddrCancel (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_DNR_CALLBACK_T pfCbFunction,
+    const void          *pRefCon)
+{
+    TAU_DNR_DATA_T      *pDNR;
+    TAU_DNR_PENDING_T   *pPending;
 
+    if ((appHandle == NULL) || (pfCbFunction == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+    pDNR = (TAU_DNR_DATA_T *) appHandle->pUser;
+    if (pDNR == NULL)
+    {
+        (void) vos_mutexUnlock(appHandle->mutex);
+        return TRDP_NOINIT_ERR;
+    }
+    for (pPending = pDNR->pPending; pPending != NULL; pPending = pPending->pNext)
+    {
+        if ((pPending->pfCbFunction == pfCbFunction) && (pPending->pRefCon == pRefCon))
+        {
+            pPending->pfCbFunction = NULL;
+        }
+    }
+    (void) vos_mutexUnlock(appHandle->mutex);
+    return TRDP_NO_ERR;
+}
 
 /**********************************************************************************************************************/
 /**    Function to convert a URI to an IP address.
  *
  *  Receives an URI as input variable and translates this URI to an IP-Address.
  *  The URI may specify either a unicast or a multicast IP-Address.
+ *  Blocks until the resolution has finished, see tau_uri2AddrAsync for the non-blocking variant.
  *
  *  @param[in]      appHandle       Handle returned by tlc_openSession()
  *  @param[out]     pAddr           Pointer to return the IP address
@@ -1238,7 +2120,8 @@ EXT_DECL TRDP_ERR_T tau_uri2Addr (
     const TRDP_URI_T    pUri)
 {
     TAU_DNR_DATA_T  *pDNR;
-    TAU_DNR_ENTRY_T *pTemp;
+    TAU_DNR_WAIT_T  wait;
+    TRDP_ERR_T      err;
     int i;
 
     if (appHandle == NULL ||
@@ -1247,51 +2130,141 @@ EXT_DECL TRDP_ERR_T tau_uri2Addr (
         return TRDP_PARAM_ERR;
     }
 
-    /* If no URI given, we return our own address   */
-    if (pUri == NULL)
+    pDNR = (TAU_DNR_DATA_T *) appHandle->pUser;
+
+    /* Create semaphore */
+    if (vos_semaCreate(&wait.sema, VOS_SEMA_EMPTY) != VOS_NO_ERR)
     {
-        *pAddr = tau_getOwnAddr(appHandle);
-        return TRDP_NO_ERR;
+        vos_printLogStr(VOS_LOG_ERROR, "tau_uri2Addr failed to get semaphore\n");
+        return TRDP_SEMA_ERR;
     }
 
-    pDNR = (TAU_DNR_DATA_T *) appHandle->pUser;
+    /* A timed out query is repeated once */
+    for (i = 0; i < 2; ++i)
+    {
+        wait.done   = FALSE;
+        wait.result = TRDP_UNRESOLVED_ERR;
+        err = tau_uri2AddrAsync(appHandle, pAddr, pUri, dnrWaitCallback, &wait);
+        if (err != TRDP_BLOCK_ERR)
+        {
+            break;
+        }
+        waitForResolution(appHandle, pDNR, dnrWaitCallback, &wait, 1u);
+        if (wait.result == TRDP_NO_ERR)
+        {
+            *pAddr  = wait.ipAddr;
+            err     = TRDP_NO_ERR;
+            break;
+        }
+        *pAddr  = VOS_INADDR_ANY;
+        err     = TRDP_UNRESOLVED_ERR;
+        if (wait.result != TRDP_TIMEOUT_ERR)
+        {
+            break;
+        }
+    }
 
-    /* Check for dotted IP address  */
-    if ((*pAddr = vos_dottedIP(pUri)) != VOS_INADDR_ANY)
+    vos_semaDelete(wait.sema);
+    return err;
+}
+
+/**********************************************************************************************************************/
+/**    Resolve all URIs of a telegram configuration.
+ *
+ *  Resolves the destination and source URIs of the telegrams read by tau_readXmlInterfaceConfig() in one go:
+ *  TCN-DNS asks for up to 255 URIs with one request, standard DNS sends all queries in parallel.
+ *  Entries which are known and still valid are not asked for.
+ *  To be called after inauguration (topocount change), before the telegrams are published or requested again,
+ *  the following tau_uri2Addr calls are answered from the cache.
+ *  Blocks until all URIs have been resolved or the queries have timed out.
+ *
+ *  @param[in]      appHandle           Handle returned by tlc_openSession()
+ *  @param[in]      numExchgPar         Number of telegram configurations
+ *  @param[in]      pExchgPar           Array of telegram configurations
+ *  @param[out]     pNoOfUnresolved     Number of URIs which could not be resolved, may be NULL
+ *
+ *  @retval         TRDP_NO_ERR         all URIs resolved
+ *  @retval         TRDP_PARAM_ERR      Parameter error
+ *  @retval         TRDP_NOINIT_ERR     DNR not initialised
+ *  @retval         TRDP_UNRESOLVED_ERR at least one URI could not be resolved
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_dnrPreResolve (
+    TRDP_APP_SESSION_T      appHandle,
+    UINT32                  numExchgPar,
+    const TRDP_EXCHG_PAR_T  *pExchgPar,
+    UINT32                  *pNoOfUnresolved)
+{
+    TAU_DNR_DATA_T  *pDNR;
+    TAU_DNR_WAIT_T  wait;
+    UINT32          noOfQueries;
+    UINT32          i;
+    UINT32          j;
+
+    if ((appHandle == NULL) || ((numExchgPar > 0u) && (pExchgPar == NULL)))
     {
-        return TRDP_NO_ERR;
+        return TRDP_PARAM_ERR;
     }
-    /* Look inside the cache    */
-    for (i = 0; i < 2; ++i)
+
+    memset(&wait, 0, sizeof(wait));
+    if (vos_semaCreate(&wait.sema, VOS_SEMA_EMPTY) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "tau_dnrPreResolve failed to get semaphore\n");
+        return TRDP_SEMA_ERR;
+    }
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_semaDelete(wait.sema);
+        return TRDP_MUTEX_ERR;
+    }
+    pDNR = (TAU_DNR_DATA_T *) appHandle->pUser;
+    if (pDNR == NULL)
+    {
+        (void) vos_mutexUnlock(appHandle->mutex);
+        vos_semaDelete(wait.sema);
+        return TRDP_NOINIT_ERR;
+    }
+
+    /* Queue all unknown or outdated URIs, nothing is sent before the loop has finished */
+    for (i = 0u; i < numExchgPar; i++)
     {
-        pTemp = (TAU_DNR_ENTRY_T *) vos_bsearch(pUri, pDNR->cache, pDNR->noOfCachedEntries, sizeof(TAU_DNR_ENTRY_T),
-                                                compareURI);
-        if ((pTemp != NULL) &&
-            ((pTemp->fixedEntry == TRUE) ||
-             (pTemp->etbTopoCnt == appHandle->etbTopoCnt) ||                    /* Do the topocounts match? */
-             (pTemp->opTrnTopoCnt == appHandle->opTrnTopoCnt) ||
-             ((appHandle->etbTopoCnt == 0u) && (appHandle->opTrnTopoCnt == 0u))   /* Or do we not care?       */
-            ))
+        for (j = 0u; (j < pExchgPar[i].destCnt) && (pExchgPar[i].pDest != NULL); j++)
         {
-            *pAddr = pTemp->ipAddr;
-            return TRDP_NO_ERR;
+            startBatchResolution(appHandle, pDNR, &wait, pExchgPar[i].pDest[j].pUriHost);
         }
-        else    /* address is not known or out of date (topocounts differ)  */
+        for (j = 0u; (j < pExchgPar[i].srcCnt) && (pExchgPar[i].pSrc != NULL); j++)
         {
-            if (pDNR->useTCN_DNS != TRDP_DNR_STANDARD_DNS)
-            {
-                updateTCNDNSentry(appHandle, pTemp, pUri);   /* Update everything, at least this URI */
-            }
-            else
-            {
-                updateDNSentry(appHandle, pTemp, pUri);
-            }
-            /* try resolving again... */
+            startBatchResolution(appHandle, pDNR, &wait, pExchgPar[i].pSrc[j].pUriHost1);
+            startBatchResolution(appHandle, pDNR, &wait, pExchgPar[i].pSrc[j].pUriHost2);
         }
     }
+    noOfQueries = wait.noOfOpen;
+    if (pDNR->useTCN_DNS != TRDP_DNR_STANDARD_DNS)
+    {
+        (void) sendTCNrequest(appHandle, pDNR);
+        completePending(appHandle, pDNR);
+    }
+    wait.done = (wait.noOfOpen == 0u) ? TRUE : FALSE;
+    (void) vos_mutexUnlock(appHandle->mutex);
 
-    *pAddr = VOS_INADDR_ANY;
-    return TRDP_UNRESOLVED_ERR;
+    vos_printLog(VOS_LOG_INFO, "tau_dnrPreResolve: %u URIs to resolve\n", noOfQueries);
+    if (wait.done == FALSE)
+    {
+        waitForResolution(appHandle, pDNR, dnrBatchCallback, &wait,
+                          (noOfQueries + TAU_MAX_TCN_URI_CNT - 1u) / TAU_MAX_TCN_URI_CNT);
+        if (wait.done == FALSE)
+        {
+            /* The cancelled resolutions have timed out */
+            wait.noOfUnresolved += wait.noOfOpen;
+        }
+    }
+
+    vos_semaDelete(wait.sema);
+    if (pNoOfUnresolved != NULL)
+    {
+        *pNoOfUnresolved = wait.noOfUnresolved;
+    }
+    return (wait.noOfUnresolved == 0u) ? TRDP_NO_ERR : TRDP_UNRESOLVED_ERR;
 }
 
 
@@ -1315,32 +2288,51 @@ EXT_DECL TRDP_ERR_T tau_addr2Uri (
     TRDP_URI_HOST_T     pUri,
     TRDP_IP_ADDR_T      addr)
 {
-    TAU_DNR_DATA_T *pDNR;
+    TAU_DNR_DATA_T  *pDNR;
+    TAU_DNR_ENTRY_T *pEntry;
+    TRDP_ERR_T      err = TRDP_UNRESOLVED_ERR;
+    TRDP_TIME_T     now;
+
     if ((appHandle == NULL) || (pUri == NULL))
     {
         return TRDP_PARAM_ERR;
     }
 
-    pDNR = (TAU_DNR_DATA_T *) appHandle->pUser;
-
     if (addr != VOS_INADDR_ANY)
     {
-        UINT32 i;
-        for (i = 0u; i < pDNR->noOfCachedEntries; ++i)
+        if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
         {
-            if ((pDNR->cache[i].ipAddr == addr) &&
-                ((appHandle->etbTopoCnt == 0u) || (pDNR->cache[i].etbTopoCnt == appHandle->etbTopoCnt)) &&
-                ((appHandle->opTrnTopoCnt == 0u) || (pDNR->cache[i].opTrnTopoCnt == appHandle->opTrnTopoCnt)))
+            return TRDP_MUTEX_ERR;
+        }
+        pDNR = (TAU_DNR_DATA_T *) appHandle->pUser;
+        if (pDNR == NULL)
+        {
+            (void) vos_mutexUnlock(appHandle->mutex);
+            return TRDP_NOINIT_ERR;
+        }
+        vos_getTime(&now);
+        for (pEntry = pDNR->ppAddrHash[hashAddr(addr) & (pDNR->noOfBuckets - 1u)];
+             pEntry != NULL;
+             pEntry = pEntry->pNextAddr)
+        {
+            if ((pEntry->ipAddr == addr) &&
+                ((pEntry->fixedEntry == TRUE) ||
+                 (((appHandle->etbTopoCnt == 0u) || (pEntry->etbTopoCnt == appHandle->etbTopoCnt)) &&
+                  ((appHandle->opTrnTopoCnt == 0u) || (pEntry->opTrnTopoCnt == appHandle->opTrnTopoCnt)) &&
+                  (((pEntry->validUntil.tv_sec == 0) && (pEntry->validUntil.tv_usec == 0)) ||
+                   (vos_cmpTime(&pEntry->validUntil, &now) >= 0)))))
             {
-                vos_strncpy(pUri, pDNR->cache[i].uri, TRDP_MAX_URI_HOST_LEN - 1);
-                return TRDP_NO_ERR;
+                vos_strncpy(pUri, pEntry->uri, TRDP_MAX_URI_HOST_LEN - 1);
+                err = TRDP_NO_ERR;
+                break;
             }
         }
+        (void) vos_mutexUnlock(appHandle->mutex);
         /* address not in cache: Make reverse request */
         /* tbd */
 
     }
-    return TRDP_UNRESOLVED_ERR;
+    return err;
 }
 
 /* ---------------------------------------------------------------------------- */
@@ -6,13 +6,20 @@
  *
  * @details         The TTI subsystem maintains a pointer to the TAU_TTDB struct in the TRDP session struct.
  *                  That TAU_TTDB struct keeps the subscription and listener handles, the current TTDB directories and
- *                  a pointer list to consist infos (in network format). On init, most TTDB data is requested from the
- *                  ECSP plus the own consist info.
- *                  This data is automatically updated if an inauguration is detected. Additional consist infos are
- *                  requested on demand, only.
+ *                  the cache of consist infos. On init, most TTDB data is requested from the ECSP plus the own
+ *                  consist info.
+ *                  Received telegrams are converted to host byte order once, when they are stored. The consist
+ *                  infos are hashed by label and UUID, their vehicles by label. The small number and UUID indexes
+ *                  of the directories are rebuilt whenever a directory changes.
+ *                  This data is automatically updated if an inauguration is detected. Consist infos which did not
+ *                  change (same cstTopoCnt) are kept, additional consist infos are requested on demand, only.
  *                  Because of the asynchronous behavior of the TTI subsystem, most functions in tau_tti.c may return
  *                  TRDP_NODATA_ERR on first invocation.
- *                  They should be called again after 1...3 seconds (3s is the timeout for most MD replies).
+ *                  They should be called again after 1...3 seconds (3s is the timeout for most MD replies), or when
+ *                  the change notification set by tau_setTTIcallback reports the data.
+ *                  With tau_setTTIprefetch, all directories and the consist infos of the whole train are requested
+ *                  right after a topology change instead, as many at once as there are request slots. Each reply
+ *                  continues the burst until everything is cached and TRDP_TTI_EVENT_TTDB_COMPLETE is reported.
  *
  *
  * @note            Project: TCNOpen TRDP prototype stack
@@ -25,6 +32,8 @@
  *
  * $Id: tau_tti.c 1755 2018-08-07 12:10:03Z bloehr $
  *
+ *      AG 2026-10-19: Prefetch of all TTDB data in one burst of requests after a topology change
+ *      AG 2026-10-19: Indexed host order cache, change notification, non-blocking and de-duplicated requests
  *      BL 2018-08-07: Ticket #183 tau_getOwnIds declared but not defined
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
  *      BL 2017-11-28: Ticket #180 Filtering rules for DestinationURI does not follow the standard
@@ -44,6 +53,7 @@
 
 #include <string.h>
 #include <stdio.h>
+#include <ctype.h>
 
 #include "trdp_if_light.h"
 #include "trdp_utils.h"
@@ -58,48 +68,314 @@
  * DEFINES
  */
 
-#define TTI_CACHED_CONSISTS  8u             /**< We hold this number of consist infos (ca. 105kB) */
+#define TTI_CACHED_CONSISTS     8u      /**< Consist infos requested on reception of the train directory          */
+#define TTI_MAX_CACHED_CST      TRDP_MAX_CST_CNT    /**< Max. number of consist infos in the cache                */
+#define TTI_CST_BUCKETS         64u     /**< Consist label and UUID hash tables, must be a power of 2               */
+#define TTI_VEH_BUCKETS         256u    /**< Vehicle label hash table, must be a power of 2                         */
+#define TTI_DIR_INDEX_SIZE      128u    /**< Open addressed directory indexes, power of 2 > TRDP_MAX_CST_CNT        */
+#define TTI_MAX_REQUESTS        16u     /**< Max. number of outstanding TTDB requests                               */
+#define TTI_REQ_GUARD_S         30u     /**< [s] A request slot is reused after this time even without reply        */
+#define TTI_PREFETCH_RETRIES    3u      /**< Failed requests repeated per prefetch burst                            */
+
+#define TTI_ALIGN(size)         (((size) + 7u) & ~7u)
+
+/* Sizes of the TTDB telegram parts on the wire */
+#define TTI_OP_TRN_DIR_HDR_SIZE 8u      /**< up to and including opCstCnt                                           */
+#define TTI_TRN_DIR_HDR_SIZE    4u      /**< up to and including cstCnt                                             */
+#define TTI_NET_DIR_HDR_SIZE    4u      /**< up to and including entryCnt                                           */
+#define TTI_LIST_HDR_SIZE       4u      /**< reserved and count of a consist info list                              */
+#define TTI_CST_HDR_SIZE        76u     /**< consist info up to and including the length of cstProp                 */
+#define TTI_CST_PROP_LEN_OFFS   74u     /**< offset of the length of cstProp                                        */
+#define TTI_ETB_SIZE            4u
+#define TTI_VEH_HDR_SIZE        40u     /**< vehicle info up to and including the length of vehProp                 */
+#define TTI_VEH_PROP_LEN_OFFS   38u
+#define TTI_FCT_SIZE            24u
+#define TTI_CLTR_CST_SIZE       20u
+#define TTI_STATUS_INFO_MIN_SIZE    (sizeof(TRDP_OP_TRAIN_DIR_STATUS_INFO_T) - sizeof(TRDP_ETB_CTRL_VDP_T))
 
 /***********************************************************************************************************************
  * TYPEDEFS
  */
 
+struct tau_tti_cst;
+
+/** Vehicle label index node, part of the consist info allocation */
+typedef struct tau_tti_veh_node
+{
+    struct tau_tti_veh_node *pNext;         /**< next node in the hash bucket                       */
+    struct tau_tti_cst      *pCst;          /**< consist the vehicle belongs to                     */
+    UINT32                  vehIdx;         /**< index into the vehicle list of the consist         */
+} TAU_TTI_VEH_NODE_T;
+
+/** Cached consist info. The lists of cstInfo, the vehicle nodes and the received telegram follow in one block */
+typedef struct tau_tti_cst
+{
+    struct tau_tti_cst  *pNextByLabel;      /**< next entry in the label hash bucket                */
+    struct tau_tti_cst  *pNextByUUID;       /**< next entry in the UUID hash bucket                 */
+    TRDP_CONSIST_INFO_T cstInfo;            /**< host byte order, the lists point into this block   */
+    TAU_TTI_VEH_NODE_T  *pVehNodes;         /**< vehCnt vehicle index nodes                         */
+    UINT32              netSize;            /**< size of the received telegram                      */
+    UINT8               *pNetData;          /**< received telegram, to detect changes               */
+} TAU_TTI_CST_T;
+
+/** Parameters of a TTDB request */
+typedef struct
+{
+    UINT32          comId;                  /**< request ComId                                      */
+    const CHAR8     *pUri;                  /**< destination (ECSP)                                 */
+    UINT32          timeout;                /**< [ms] reply timeout                                 */
+} TAU_TTI_REQ_PAR_T;
+
+/** Outstanding TTDB request */
+typedef struct
+{
+    UINT32          comId;                  /**< request ComId, 0 if the slot is free               */
+    TRDP_UUID_T     cstUUID;                /**< consist requested by TTDB_STAT_CST_REQ_COMID       */
+    TRDP_TIME_T     timeout;                /**< slot is reused after this time                     */
+    BOOL8           waitForAddr;            /**< sent when the URI of the ECSP is resolved          */
+} TAU_TTI_REQ_T;
+
 typedef struct TAU_TTDB
 {
     TRDP_SUB_T                      pd100SubHandle;
     TRDP_LIS_T                      md101Listener;
     TRDP_LIS_T                      md102Listener;
+    VOS_SEMA_T                      userAction;     /**< given on inauguration                              */
+    TRDP_TTI_CALLBACK_T             pfCbChange;     /**< change notification                                */
+    void                            *pCbRefCon;
     TRDP_OP_TRAIN_DIR_STATUS_INFO_T opTrnState;
     TRDP_OP_TRAIN_DIR_T             opTrnDir;
     TRDP_TRAIN_DIR_T                trnDir;
+    UINT32                          trnDirEtbTopoCnt;                   /**< etbTopoCnt at reception of trnDir  */
     TRDP_TRAIN_NET_DIR_T            trnNetDir;
+    UINT8                           opCstByNo[TRDP_MAX_CST_CNT + 1u];   /**< opCstNo -> opCstList index + 1      */
+    UINT8                           opVehByCstNo[TRDP_MAX_CST_CNT + 1u];/**< opCstNo -> first opVehList index + 1*/
+    UINT8                           opCstByUUID[TTI_DIR_INDEX_SIZE];    /**< opCstList index + 1                 */
+    UINT8                           opVehByLabel[TTI_DIR_INDEX_SIZE];   /**< opVehList index + 1                 */
+    UINT8                           trnCstByNo[TRDP_MAX_CST_CNT + 1u];  /**< trnCstNo -> cstList index + 1       */
+    UINT8                           trnCstByUUID[TTI_DIR_INDEX_SIZE];   /**< cstList index + 1                   */
     UINT32                          noOfCachedCst;
-    UINT32                          cstSize[TRDP_MAX_CST_CNT];
-    TRDP_CONSIST_INFO_T             *cstInfo[TRDP_MAX_CST_CNT];
+    TAU_TTI_CST_T                   *pCstByLabel[TTI_CST_BUCKETS];
+    TAU_TTI_CST_T                   *pCstByUUID[TTI_CST_BUCKETS];
+    TAU_TTI_VEH_NODE_T              *pVehByLabel[TTI_VEH_BUCKETS];
+    TAU_TTI_REQ_T                   req[TTI_MAX_REQUESTS];
+    BOOL8                           inNotify;           /**< change notification running, do not send     */
+    BOOL8                           prefetch;           /**< prefetch enabled by tau_setTTIprefetch        */
+    BOOL8                           prefetchActive;     /**< burst running, not complete yet               */
+    UINT8                           prefetchRetries;    /**< failed requests repeated by this burst        */
+    UINT32                          prefetchDirs;       /**< directories requested, bit per sTtiReqPar entry */
+    UINT32                          noOfPrefetchedCst;
+    TRDP_UUID_T                     prefetchedCst[TRDP_MAX_CST_CNT];    /**< consist infos requested        */
 } TAU_TTDB_T;
 
 /***********************************************************************************************************************
  *   Locals
  */
 
-static void ttiRequestTTDBdata (TRDP_APP_SESSION_T  appHandle,
-                                UINT32              comID,
-                                const TRDP_UUID_T   cstUUID);
+static const TAU_TTI_REQ_PAR_T sTtiReqPar[] =
+{
+    {TTDB_OP_DIR_INFO_REQ_COMID, TTDB_OP_DIR_INFO_REQ_URI, TTDB_OP_DIR_INFO_REQ_TO},
+    {TTDB_TRN_DIR_REQ_COMID, TTDB_TRN_DIR_REQ_URI, TTDB_TRN_DIR_REQ_TO},
+    {TTDB_STAT_CST_REQ_COMID, TTDB_STAT_CST_REQ_URI, TTDB_STAT_CST_REQ_TO},
+    {TTDB_NET_DIR_REQ_COMID, TTDB_NET_DIR_REQ_URI, TTDB_NET_DIR_REQ_TO},
+    {TTDB_READ_CMPLT_REQ_COMID, TTDB_READ_CMPLT_REQ_URI, TTDB_READ_CMPLT_REQ_TO}
+};
+
+static BOOL8 ttiRequestTTDBdata (TRDP_APP_SESSION_T  appHandle,
+                                 UINT32              comID,
+                                 const TRDP_UUID_T   cstUUID);
+static void ttiStartPrefetch (TRDP_APP_SESSION_T appHandle);
+static void ttiPrefetch (TRDP_APP_SESSION_T appHandle);
 
-static void ttiGetUUIDfromLabel (
-                          TRDP_APP_SESSION_T  appHandle,
-                          TRDP_UUID_T         cstUUID,
-                          const TRDP_LABEL_T  cstLabel);
+/**********************************************************************************************************************/
+/*  Wire access and hashing                                                                                           */
+/**********************************************************************************************************************/
 
-static TRDP_IP_ADDR_T ipFromURI (
-    TRDP_APP_SESSION_T  appHandle,
-    TRDP_URI_HOST_T     uri)
+static UINT16 ttiGet16 (const UINT8 *pData)
+{
+    return (UINT16) (((UINT16) pData[0] << 8u) | pData[1]);
+}
+
+static UINT32 ttiGet32 (const UINT8 *pData)
+{
+    return ((UINT32) pData[0] << 24u) | ((UINT32) pData[1] << 16u) | ((UINT32) pData[2] << 8u) | pData[3];
+}
+
+/** Case insensitive hash of a label (FNV-1a) */
+static UINT32 ttiHashLabel (const CHAR8 *pLabel)
+{
+    UINT32  hash = 2166136261u;
+    UINT32  i;
+
+    for (i = 0u; (i < TRDP_MAX_LABEL_LEN) && (pLabel[i] != '\0'); i++)
+    {
+        hash    ^= (UINT32) tolower((unsigned char) pLabel[i]);
+        hash    *= 16777619u;
+    }
+    return hash;
+}
+
+/** Hash of a UUID (FNV-1a) */
+static UINT32 ttiHashUUID (const UINT8 *pUUID)
+{
+    UINT32  hash = 2166136261u;
+    UINT32  i;
+
+    for (i = 0u; i < sizeof(TRDP_UUID_T); i++)
+    {
+        hash    ^= pUUID[i];
+        hash    *= 16777619u;
+    }
+    return hash;
+}
+
+static BOOL8 ttiLabelEqual (const CHAR8 *pLabel1, const CHAR8 *pLabel2)
+{
+    return (vos_strnicmp(pLabel1, pLabel2, sizeof(TRDP_NET_LABEL_T)) == 0) ? TRUE : FALSE;
+}
+
+static BOOL8 ttiIsNullUUID (const UINT8 *pUUID)
+{
+    UINT32 i;
+
+    for (i = 0u; i < sizeof(TRDP_UUID_T); i++)
+    {
+        if (pUUID[i] != 0u)
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/*  Directory indexes                                                                                                 */
+/**********************************************************************************************************************/
+
+/** Insert an entry number into an open addressed index */
+static void ttiIndexAdd (
+    UINT8   *pIndex,
+    UINT32  hash,
+    UINT32  entry)
+{
+    UINT32 i = hash & (TTI_DIR_INDEX_SIZE - 1u);
+
+    while (pIndex[i] != 0u)
+    {
+        i = (i + 1u) & (TTI_DIR_INDEX_SIZE - 1u);
+    }
+    pIndex[i] = (UINT8) (entry + 1u);
+}
+
+/** Rebuild the indexes of the operational train directory */
+static void ttiBuildOpIndex (
+    TAU_TTDB_T *pTTDB)
+{
+    UINT32 i;
+
+    memset(pTTDB->opCstByNo, 0, sizeof(pTTDB->opCstByNo));
+    memset(pTTDB->opVehByCstNo, 0, sizeof(pTTDB->opVehByCstNo));
+    memset(pTTDB->opCstByUUID, 0, sizeof(pTTDB->opCstByUUID));
+    memset(pTTDB->opVehByLabel, 0, sizeof(pTTDB->opVehByLabel));
+
+    for (i = 0u; i < pTTDB->opTrnDir.opCstCnt; i++)
+    {
+        UINT8 opCstNo = pTTDB->opTrnDir.opCstList[i].opCstNo;
+
+        if (opCstNo <= TRDP_MAX_CST_CNT)
+        {
+            pTTDB->opCstByNo[opCstNo] = (UINT8) (i + 1u);
+        }
+        ttiIndexAdd(pTTDB->opCstByUUID, ttiHashUUID(pTTDB->opTrnDir.opCstList[i].cstUUID), i);
+    }
+    for (i = 0u; i < pTTDB->opTrnDir.opVehCnt; i++)
+    {
+        UINT8 opCstNo = pTTDB->opTrnDir.opVehList[i].ownOpCstNo;
+
+        if ((opCstNo <= TRDP_MAX_CST_CNT) && (pTTDB->opVehByCstNo[opCstNo] == 0u))
+        {
+            pTTDB->opVehByCstNo[opCstNo] = (UINT8) (i + 1u);
+        }
+        ttiIndexAdd(pTTDB->opVehByLabel, ttiHashLabel(pTTDB->opTrnDir.opVehList[i].vehId), i);
+    }
+}
+
+/** Rebuild the indexes of the train directory */
+static void ttiBuildTrnIndex (
+    TAU_TTDB_T *pTTDB)
+{
+    UINT32 i;
+
+    memset(pTTDB->trnCstByNo, 0, sizeof(pTTDB->trnCstByNo));
+    memset(pTTDB->trnCstByUUID, 0, sizeof(pTTDB->trnCstByUUID));
+
+    for (i = 0u; i < pTTDB->trnDir.cstCnt; i++)
+    {
+        UINT8 trnCstNo = pTTDB->trnDir.cstList[i].trnCstNo;
+
+        if (trnCstNo <= TRDP_MAX_CST_CNT)
+        {
+            pTTDB->trnCstByNo[trnCstNo] = (UINT8) (i + 1u);
+        }
+        ttiIndexAdd(pTTDB->trnCstByUUID, ttiHashUUID(pTTDB->trnDir.cstList[i].cstUUID), i);
+    }
+}
+
+static const TRDP_OP_VEHICLE_T *ttiOpVehByLabel (
+    const TAU_TTDB_T    *pTTDB,
+    const CHAR8         *pLabel)
+{
+    UINT32 i = ttiHashLabel(pLabel) & (TTI_DIR_INDEX_SIZE - 1u);
+
+    while (pTTDB->opVehByLabel[i] != 0u)
+    {
+        const TRDP_OP_VEHICLE_T *pVeh = &pTTDB->opTrnDir.opVehList[pTTDB->opVehByLabel[i] - 1u];
+
+        if (ttiLabelEqual(pVeh->vehId, pLabel) == TRUE)
+        {
+            return pVeh;
+        }
+        i = (i + 1u) & (TTI_DIR_INDEX_SIZE - 1u);
+    }
+    return NULL;
+}
+
+static const TRDP_OP_CONSIST_T *ttiOpCstByUUID (
+    const TAU_TTDB_T    *pTTDB,
+    const UINT8         *pUUID)
+{
+    UINT32 i = ttiHashUUID(pUUID) & (TTI_DIR_INDEX_SIZE - 1u);
+
+    while (pTTDB->opCstByUUID[i] != 0u)
+    {
+        const TRDP_OP_CONSIST_T *pOpCst = &pTTDB->opTrnDir.opCstList[pTTDB->opCstByUUID[i] - 1u];
+
+        if (memcmp(pOpCst->cstUUID, pUUID, sizeof(TRDP_UUID_T)) == 0)
+        {
+            return pOpCst;
+        }
+        i = (i + 1u) & (TTI_DIR_INDEX_SIZE - 1u);
+    }
+    return NULL;
+}
+
+static const TRDP_CONSIST_T *ttiTrnCstByUUID (
+    const TAU_TTDB_T    *pTTDB,
+    const UINT8         *pUUID)
 {
-    TRDP_IP_ADDR_T ipAddr = VOS_INADDR_ANY;
+    UINT32 i = ttiHashUUID(pUUID) & (TTI_DIR_INDEX_SIZE - 1u);
 
-    (void) tau_uri2Addr(appHandle, &ipAddr, uri);
+    while (pTTDB->trnCstByUUID[i] != 0u)
+    {
+        const TRDP_CONSIST_T *pTrnCst = &pTTDB->trnDir.cstList[pTTDB->trnCstByUUID[i] - 1u];
 
-    return ipAddr;
+        if (memcmp(pTrnCst->cstUUID, pUUID, sizeof(TRDP_UUID_T)) == 0)
+        {
+            return pTrnCst;
+        }
+        i = (i + 1u) & (TTI_DIR_INDEX_SIZE - 1u);
+    }
+    return NULL;
 }
 
 /**********************************************************************************************************************/
@@ -109,49 +385,429 @@ static TRDP_IP_ADDR_T ipFromURI (
  *      Note: The first vehicle in a consist has the same ID as the consist it is belonging to (5.3.3.2.5)
  */
 static void ttiGetUUIDfromLabel (
-    TRDP_APP_SESSION_T  appHandle,
+    const TAU_TTDB_T    *pTTDB,
     TRDP_UUID_T         cstUUID,
-    const TRDP_LABEL_T  cstLabel)
+    const CHAR8         *pCstLabel)
 {
-    UINT32  i;
-    UINT32  j;
+    const TRDP_OP_VEHICLE_T *pVeh = ttiOpVehByLabel(pTTDB, pCstLabel);
+
+    if ((pVeh != NULL) &&
+        (pVeh->ownOpCstNo <= TRDP_MAX_CST_CNT) &&
+        (pTTDB->opCstByNo[pVeh->ownOpCstNo] != 0u))
+    {
+        memcpy(cstUUID, pTTDB->opTrnDir.opCstList[pTTDB->opCstByNo[pVeh->ownOpCstNo] - 1u].cstUUID,
+               sizeof(TRDP_UUID_T));
+        return;
+    }
+    /* not found    */
+    memset(cstUUID, 0, sizeof(TRDP_UUID_T));
+}
+
+/** Return the UUID of the own consist, NULL if still unknown */
+static const UINT8 *ttiOwnCstUUID (
+    const TAU_TTDB_T *pTTDB)
+{
+    UINT8 ownTrnCstNo = pTTDB->opTrnState.ownTrnCstNo;
+
+    if ((ownTrnCstNo == 0u) || (ownTrnCstNo > TRDP_MAX_CST_CNT))
+    {
+        return NULL;
+    }
+    if (pTTDB->trnCstByNo[ownTrnCstNo] != 0u)
+    {
+        return pTTDB->trnDir.cstList[pTTDB->trnCstByNo[ownTrnCstNo] - 1u].cstUUID;
+    }
+    if (ownTrnCstNo <= pTTDB->trnNetDir.entryCnt)
+    {
+        return pTTDB->trnNetDir.trnNetDir[ownTrnCstNo - 1u].cstUUID;
+    }
+    return NULL;
+}
+
+/**********************************************************************************************************************/
+/*  Consist info cache                                                                                                */
+/**********************************************************************************************************************/
+
+static TAU_TTI_CST_T *ttiCstByUUID (
+    const TAU_TTDB_T    *pTTDB,
+    const UINT8         *pUUID)
+{
+    TAU_TTI_CST_T *pCst = pTTDB->pCstByUUID[ttiHashUUID(pUUID) & (TTI_CST_BUCKETS - 1u)];
+
+    while ((pCst != NULL) && (memcmp(pCst->cstInfo.cstUUID, pUUID, sizeof(TRDP_UUID_T)) != 0))
+    {
+        pCst = pCst->pNextByUUID;
+    }
+    return pCst;
+}
+
+static TAU_TTI_CST_T *ttiCstByLabel (
+    const TAU_TTDB_T    *pTTDB,
+    const CHAR8         *pLabel)
+{
+    TAU_TTI_CST_T *pCst = pTTDB->pCstByLabel[ttiHashLabel(pLabel) & (TTI_CST_BUCKETS - 1u)];
+
+    while ((pCst != NULL) && (ttiLabelEqual(pCst->cstInfo.cstId, pLabel) == FALSE))
+    {
+        pCst = pCst->pNextByLabel;
+    }
+    return pCst;
+}
+
+static const TRDP_VEHICLE_INFO_T *ttiVehByLabel (
+    const TAU_TTDB_T    *pTTDB,
+    const TAU_TTI_CST_T *pCst,
+    const CHAR8         *pLabel)
+{
+    const TAU_TTI_VEH_NODE_T *pNode = pTTDB->pVehByLabel[ttiHashLabel(pLabel) & (TTI_VEH_BUCKETS - 1u)];
+
+    for (; pNode != NULL; pNode = pNode->pNext)
+    {
+        if ((pNode->pCst == pCst) &&
+            (ttiLabelEqual(pCst->cstInfo.pVehInfoList[pNode->vehIdx].vehId, pLabel) == TRUE))
+        {
+            return &pCst->cstInfo.pVehInfoList[pNode->vehIdx];
+        }
+    }
+    return NULL;
+}
+
+static void ttiCstLink (
+    TAU_TTDB_T      *pTTDB,
+    TAU_TTI_CST_T   *pCst)
+{
+    UINT32 bucket;
+    UINT32 i;
+
+    bucket = ttiHashLabel(pCst->cstInfo.cstId) & (TTI_CST_BUCKETS - 1u);
+    pCst->pNextByLabel          = pTTDB->pCstByLabel[bucket];
+    pTTDB->pCstByLabel[bucket]  = pCst;
+
+    bucket = ttiHashUUID(pCst->cstInfo.cstUUID) & (TTI_CST_BUCKETS - 1u);
+    pCst->pNextByUUID           = pTTDB->pCstByUUID[bucket];
+    pTTDB->pCstByUUID[bucket]   = pCst;
+
+    for (i = 0u; i < pCst->cstInfo.vehCnt; i++)
+    {
+        bucket = ttiHashLabel(pCst->cstInfo.pVehInfoList[i].vehId) & (TTI_VEH_BUCKETS - 1u);
+        pCst->pVehNodes[i].pNext    = pTTDB->pVehByLabel[bucket];
+        pTTDB->pVehByLabel[bucket]  = &pCst->pVehNodes[i];
+    }
+    pTTDB->noOfCachedCst++;
+}
+
+static void ttiCstUnlink (
+    TAU_TTDB_T      *pTTDB,
+    TAU_TTI_CST_T   *pCst)
+{
+    TAU_TTI_CST_T       **ppCst;
+    TAU_TTI_VEH_NODE_T  **ppNode;
+    UINT32              i;
+
+    for (ppCst = &pTTDB->pCstByLabel[ttiHashLabel(pCst->cstInfo.cstId) & (TTI_CST_BUCKETS - 1u)];
+         *ppCst != NULL;
+         ppCst = &(*ppCst)->pNextByLabel)
+    {
+        if (*ppCst == pCst)
+        {
+            *ppCst = pCst->pNextByLabel;
+            break;
+        }
+    }
+    for (ppCst = &pTTDB->pCstByUUID[ttiHashUUID(pCst->cstInfo.cstUUID) & (TTI_CST_BUCKETS - 1u)];
+         *ppCst != NULL;
+         ppCst = &(*ppCst)->pNextByUUID)
+    {
+        if (*ppCst == pCst)
+        {
+            *ppCst = pCst->pNextByUUID;
+            break;
+        }
+    }
+    for (i = 0u; i < pCst->cstInfo.vehCnt; i++)
+    {
+        for (ppNode = &pTTDB->pVehByLabel[ttiHashLabel(pCst->cstInfo.pVehInfoList[i].vehId) &
+                                          (TTI_VEH_BUCKETS - 1u)];
+             *ppNode != NULL;
+             ppNode = &(*ppNode)->pNext)
+        {
+            if (*ppNode == &pCst->pVehNodes[i])
+            {
+                *ppNode = pCst->pVehNodes[i].pNext;
+                break;
+            }
+        }
+    }
+    pTTDB->noOfCachedCst--;
+}
 
-    /* Search the vehicles in the OP_TRAIN_DIR for a matching vehID */
+/** Remove all cached consist infos matching the filter, NULL removes all */
+static void ttiCstDrop (
+    TAU_TTDB_T  *pTTDB,
+    BOOL8 (*pfFilter)(const TAU_TTDB_T *pTTDB, const TAU_TTI_CST_T *pCst),
+    UINT32      maxCount)
+{
+    UINT32          i;
+    TAU_TTI_CST_T   *pCst;
+    TAU_TTI_CST_T   *pNext;
 
-    for (i = 0u; i < appHandle->pTTDB->opTrnDir.opVehCnt; i++)
+    for (i = 0u; (i < TTI_CST_BUCKETS) && (maxCount > 0u); i++)
     {
-        if (vos_strnicmp(appHandle->pTTDB->opTrnDir.opVehList[i].vehId, cstLabel, sizeof(TRDP_NET_LABEL_T)) == 0)
+        for (pCst = pTTDB->pCstByUUID[i]; (pCst != NULL) && (maxCount > 0u); pCst = pNext)
         {
-            /* vehicle found, is it the first in the consist?   */
-            UINT8 opCstNo = appHandle->pTTDB->opTrnDir.opVehList[i].ownOpCstNo;
-            for (j = 0u; j < appHandle->pTTDB->opTrnDir.opCstCnt; j++)
+            pNext = pCst->pNextByUUID;
+            if ((pfFilter == NULL) || (pfFilter(pTTDB, pCst) == TRUE))
             {
-                if (opCstNo == appHandle->pTTDB->opTrnDir.opCstList[j].opCstNo)
-                {
-                    memcpy(cstUUID, appHandle->pTTDB->opTrnDir.opCstList[j].cstUUID, sizeof(TRDP_UUID_T));
-                    return;
-                }
+                ttiCstUnlink(pTTDB, pCst);
+                vos_memFree(pCst);
+                maxCount--;
             }
         }
     }
-    /* not found    */
-    memset(cstUUID, 0, sizeof(TRDP_UUID_T));
 }
 
-static BOOL8   ttiIsOwnCstInfo (
+/** Filter for consist infos not or no longer matching the train directory */
+static BOOL8 ttiCstOutdated (
+    const TAU_TTDB_T    *pTTDB,
+    const TAU_TTI_CST_T *pCst)
+{
+    const TRDP_CONSIST_T *pTrnCst = ttiTrnCstByUUID(pTTDB, pCst->cstInfo.cstUUID);
+
+    return ((pTrnCst == NULL) ||
+            ((pTrnCst->cstTopoCnt != 0u) && (pTrnCst->cstTopoCnt != pCst->cstInfo.cstTopoCnt))) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/**    Convert a received consist info into the host order cache representation
+ *
+ *  The telegram has variable size lists, they are checked against the received size.
+ *
+ *  @param[in]      pData           Pointer to the network buffer.
+ *  @param[in]      dataSize        Size of the received data
+ *
+ *  @retval         new cache entry (not linked)
+ *  @retval         NULL            invalid telegram or out of memory
+ *
+ */
+static TAU_TTI_CST_T *ttiParseCstInfo (
+    const UINT8 *pData,
+    UINT32      dataSize)
+{
+    TAU_TTI_CST_T   *pCst;
+    UINT8           *pMem;
+    UINT32          pos;
+    UINT32          etbPos, vehPos, fctPos, cltrPos;
+    UINT16          etbCnt, vehCnt, fctCnt, cltrCstCnt;
+    UINT32          size;
+    UINT32          i;
+
+    /* Walk through the lists to validate the telegram size */
+    if (dataSize < TTI_CST_HDR_SIZE)
+    {
+        return NULL;
+    }
+    pos = TTI_CST_HDR_SIZE + ttiGet16(&pData[TTI_CST_PROP_LEN_OFFS]);
+    if (pos + TTI_LIST_HDR_SIZE > dataSize)
+    {
+        return NULL;
+    }
+    etbCnt  = ttiGet16(&pData[pos + 2u]);
+    etbPos  = pos + TTI_LIST_HDR_SIZE;
+    pos     = etbPos + etbCnt * TTI_ETB_SIZE;
+    if (pos + TTI_LIST_HDR_SIZE > dataSize)
+    {
+        return NULL;
+    }
+    vehCnt  = ttiGet16(&pData[pos + 2u]);
+    vehPos  = pos + TTI_LIST_HDR_SIZE;
+    pos     = vehPos;
+    for (i = 0u; i < vehCnt; i++)
+    {
+        if (pos + TTI_VEH_HDR_SIZE > dataSize)
+        {
+            return NULL;
+        }
+        pos += TTI_VEH_HDR_SIZE + ttiGet16(&pData[pos + TTI_VEH_PROP_LEN_OFFS]);
+    }
+    if (pos + TTI_LIST_HDR_SIZE > dataSize)
+    {
+        return NULL;
+    }
+    fctCnt  = ttiGet16(&pData[pos + 2u]);
+    fctPos  = pos + TTI_LIST_HDR_SIZE;
+    pos     = fctPos + fctCnt * TTI_FCT_SIZE;
+    if (pos + TTI_LIST_HDR_SIZE > dataSize)
+    {
+        return NULL;
+    }
+    cltrCstCnt  = ttiGet16(&pData[pos + 2u]);
+    cltrPos     = pos + TTI_LIST_HDR_SIZE;
+    pos         = cltrPos + cltrCstCnt * TTI_CLTR_CST_SIZE;
+    if (pos + sizeof(UINT32) > dataSize)
+    {
+        return NULL;
+    }
+    pos += sizeof(UINT32);              /* cstTopoCnt */
+
+    /* One block for the entry, the lists, the vehicle nodes and the telegram */
+    size = TTI_ALIGN(sizeof(TAU_TTI_CST_T)) +
+        TTI_ALIGN(etbCnt * sizeof(TRDP_ETB_INFO_T)) +
+        TTI_ALIGN(vehCnt * sizeof(TRDP_VEHICLE_INFO_T)) +
+        TTI_ALIGN(fctCnt * sizeof(TRDP_FUNCTION_INFO_T)) +
+        TTI_ALIGN(cltrCstCnt * sizeof(TRDP_CLTR_CST_INFO_T)) +
+        TTI_ALIGN(vehCnt * sizeof(TAU_TTI_VEH_NODE_T)) +
+        pos;
+    pMem = (UINT8 *) vos_memAlloc(size);
+    if (pMem == NULL)
+    {
+        return NULL;
+    }
+    pCst    = (TAU_TTI_CST_T *) pMem;
+    pMem    += TTI_ALIGN(sizeof(TAU_TTI_CST_T));
+
+    /* Header */
+    pCst->cstInfo.version.ver   = pData[0];
+    pCst->cstInfo.version.rel   = pData[1];
+    pCst->cstInfo.cstClass      = pData[2];
+    memcpy(pCst->cstInfo.cstId, &pData[4], sizeof(TRDP_NET_LABEL_T));
+    memcpy(pCst->cstInfo.cstType, &pData[20], sizeof(TRDP_NET_LABEL_T));
+    memcpy(pCst->cstInfo.cstOwner, &pData[36], sizeof(TRDP_NET_LABEL_T));
+    memcpy(pCst->cstInfo.cstUUID, &pData[52], sizeof(TRDP_UUID_T));
+    pCst->cstInfo.cstProp.ver.ver   = pData[72];
+    pCst->cstInfo.cstProp.ver.rel   = pData[73];
+    pCst->cstInfo.cstProp.len       = ttiGet16(&pData[TTI_CST_PROP_LEN_OFFS]);
+    pCst->cstInfo.cstProp.prop[0]   = (pCst->cstInfo.cstProp.len > 0u) ? pData[TTI_CST_HDR_SIZE] : 0u;
+
+    /* ETB list */
+    pCst->cstInfo.etbCnt        = etbCnt;
+    pCst->cstInfo.pEtbInfoList  = (etbCnt > 0u) ? (TRDP_ETB_INFO_T *) pMem : NULL;
+    pMem += TTI_ALIGN(etbCnt * sizeof(TRDP_ETB_INFO_T));
+    for (i = 0u; i < etbCnt; i++)
+    {
+        const UINT8 *pEtb = &pData[etbPos + i * TTI_ETB_SIZE];
+
+        pCst->cstInfo.pEtbInfoList[i].etbId = pEtb[0];
+        pCst->cstInfo.pEtbInfoList[i].cnCnt = pEtb[1];
+    }
+
+    /* Vehicle list */
+    pCst->cstInfo.vehCnt        = vehCnt;
+    pCst->cstInfo.pVehInfoList  = (vehCnt > 0u) ? (TRDP_VEHICLE_INFO_T *) pMem : NULL;
+    pMem += TTI_ALIGN(vehCnt * sizeof(TRDP_VEHICLE_INFO_T));
+    for (i = 0u, pos = vehPos; i < vehCnt; i++)
+    {
+        TRDP_VEHICLE_INFO_T *pVeh = &pCst->cstInfo.pVehInfoList[i];
+
+        memcpy(pVeh->vehId, &pData[pos], sizeof(TRDP_NET_LABEL_T));
+        memcpy(pVeh->vehType, &pData[pos + 16u], sizeof(TRDP_NET_LABEL_T));
+        pVeh->vehOrient     = pData[pos + 32u];
+        pVeh->cstVehNo      = pData[pos + 33u];
+        pVeh->tractVeh      = pData[pos + 34u];
+        pVeh->vehProp.ver.ver   = pData[pos + 36u];
+        pVeh->vehProp.ver.rel   = pData[pos + 37u];
+        pVeh->vehProp.len       = ttiGet16(&pData[pos + TTI_VEH_PROP_LEN_OFFS]);
+        pVeh->vehProp.prop[0]   = (pVeh->vehProp.len > 0u) ? pData[pos + TTI_VEH_HDR_SIZE] : 0u;
+        pos += TTI_VEH_HDR_SIZE + pVeh->vehProp.len;
+    }
+
+    /* Function list */
+    pCst->cstInfo.fctCnt        = fctCnt;
+    pCst->cstInfo.pFctInfoList  = (fctCnt > 0u) ? (TRDP_FUNCTION_INFO_T *) pMem : NULL;
+    pMem += TTI_ALIGN(fctCnt * sizeof(TRDP_FUNCTION_INFO_T));
+    for (i = 0u; i < fctCnt; i++)
+    {
+        const UINT8             *pFctData   = &pData[fctPos + i * TTI_FCT_SIZE];
+        TRDP_FUNCTION_INFO_T    *pFct       = &pCst->cstInfo.pFctInfoList[i];
+
+        memcpy(pFct->fctName, pFctData, sizeof(TRDP_NET_LABEL_T));
+        pFct->fctId     = ttiGet16(&pFctData[16]);
+        pFct->grp       = pFctData[18];
+        pFct->cstVehNo  = pFctData[20];
+        pFct->etbId     = pFctData[21];
+        pFct->cnId      = pFctData[22];
+    }
+
+    /* Closed train consist list */
+    pCst->cstInfo.cltrCstCnt        = cltrCstCnt;
+    pCst->cstInfo.pCltrCstInfoList  = (cltrCstCnt > 0u) ? (TRDP_CLTR_CST_INFO_T *) pMem : NULL;
+    pMem += TTI_ALIGN(cltrCstCnt * sizeof(TRDP_CLTR_CST_INFO_T));
+    for (i = 0u; i < cltrCstCnt; i++)
+    {
+        const UINT8 *pCltr = &pData[cltrPos + i * TTI_CLTR_CST_SIZE];
+
+        memcpy(pCst->cstInfo.pCltrCstInfoList[i].cltrCstUUID, pCltr, sizeof(TRDP_UUID_T));
+        pCst->cstInfo.pCltrCstInfoList[i].cltrCstOrient = pCltr[16];
+        pCst->cstInfo.pCltrCstInfoList[i].cltrCstNo     = pCltr[17];
+    }
+    pos = cltrPos + cltrCstCnt * TTI_CLTR_CST_SIZE;
+    pCst->cstInfo.cstTopoCnt = ttiGet32(&pData[pos]);
+    pos += sizeof(UINT32);
+
+    /* Vehicle index nodes, linked later */
+    pCst->pVehNodes = (TAU_TTI_VEH_NODE_T *) pMem;
+    pMem += TTI_ALIGN(vehCnt * sizeof(TAU_TTI_VEH_NODE_T));
+    for (i = 0u; i < vehCnt; i++)
+    {
+        pCst->pVehNodes[i].pCst     = pCst;
+        pCst->pVehNodes[i].vehIdx   = i;
+    }
+
+    /* Keep the telegram to detect changes */
+    pCst->netSize   = pos;
+    pCst->pNetData  = pMem;
+    memcpy(pCst->pNetData, pData, pos);
+    return pCst;
+}
+
+/** Return the own function (device) in the given consist, derived from our IP address */
+static const TRDP_FUNCTION_INFO_T *ttiOwnFct (
     TRDP_APP_SESSION_T  appHandle,
-    TRDP_CONSIST_INFO_T *pTelegram)
+    const TAU_TTI_CST_T *pCst)
 {
-    UINT32 i;
-    for (i = 0u; i < appHandle->pTTDB->opTrnDir.opCstCnt; i++)
+    /* deduct our device / function ID from our IP address */
+    UINT16  ownIP = (UINT16) (appHandle->realIP & 0x00000FFF);
+    UINT32  i;
+
+    /* Problem: What if it is not set? Default interface is 0! */
+    for (i = 0u; i < pCst->cstInfo.fctCnt; i++)
     {
-        if (appHandle->pTTDB->opTrnState.ownTrnCstNo == appHandle->pTTDB->opTrnDir.opCstList[i].trnCstNo)
+        if (ownIP == pCst->cstInfo.pFctInfoList[i].fctId)
         {
-            return memcmp(appHandle->pTTDB->opTrnDir.opCstList[i].cstUUID, pTelegram->cstUUID,
-                          sizeof(TRDP_UUID_T)) == 0u;
+            return &pCst->cstInfo.pFctInfoList[i];
         }
     }
-    return FALSE;
+    return NULL;
+}
+
+/** Return the vehicle hosting our device, or the first vehicle of a foreign consist */
+static const TRDP_VEHICLE_INFO_T *ttiOwnVeh (
+    TRDP_APP_SESSION_T  appHandle,
+    const TAU_TTI_CST_T *pCst)
+{
+    const TRDP_FUNCTION_INFO_T *pFct = ttiOwnFct(appHandle, pCst);
+
+    if ((pFct != NULL) && (pFct->cstVehNo > 0u) && (pFct->cstVehNo <= pCst->cstInfo.vehCnt))
+    {
+        return &pCst->cstInfo.pVehInfoList[pFct->cstVehNo - 1u];
+    }
+    return (pCst->cstInfo.vehCnt > 0u) ? &pCst->cstInfo.pVehInfoList[0] : NULL;
+}
+
+/**********************************************************************************************************************/
+/** Call the change notification of the application */
+static void ttiNotify (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_TTI_EVENT_T    event,
+    const TRDP_UUID_T   cstUUID)
+{
+    TAU_TTDB_T *pTTDB = appHandle->pTTDB;
+
+    if ((pTTDB->pfCbChange != NULL) && (pTTDB->inNotify == FALSE))
+    {
+        pTTDB->inNotify = TRUE;
+        pTTDB->pfCbChange(pTTDB->pCbRefCon, appHandle, event, cstUUID);
+        pTTDB->inNotify = FALSE;
+    }
 }
 
 /**********************************************************************************************************************/
@@ -175,14 +831,15 @@ static void ttiPDCallback (
     UINT8                   *pData,
     UINT32                  dataSize)
 {
-    int         changed         = 0;
-    VOS_SEMA_T  waitForInaug    = (VOS_SEMA_T) pMsg->pUserRef;
+    int         changed = 0;
+    TAU_TTDB_T  *pTTDB  = appHandle->pTTDB;
 
     pRefCon = pRefCon;
 
-    if (pMsg->comId == TTDB_STATUS_COMID)
+    if ((pMsg->comId == TTDB_STATUS_COMID) && (pTTDB != NULL))
     {
         if ((pMsg->resultCode == TRDP_NO_ERR) &&
+            (dataSize >= TTI_STATUS_INFO_MIN_SIZE) &&
             (dataSize <= sizeof(TRDP_OP_TRAIN_DIR_STATUS_INFO_T)))
         {
             TRDP_OP_TRAIN_DIR_STATUS_INFO_T *pTelegram = (TRDP_OP_TRAIN_DIR_STATUS_INFO_T *) pData;
@@ -193,42 +850,42 @@ static void ttiPDCallback (
             if (crc != vos_ntohl(pTelegram->state.crc))
             {
                 vos_printLog(VOS_LOG_ERROR, "CRC error of received operational status info (%08x != %08x)!\n",
-                             crc, vos_ntohl(pTelegram->state.crc))
-                    (void) tlc_setOpTrainTopoCount(appHandle, 0);
+                             crc, vos_ntohl(pTelegram->state.crc));
+                (void) tlc_setOpTrainTopoCount(appHandle, 0);
                 return;
             }
 
             /* Store the state locally */
-            memcpy(&appHandle->pTTDB->opTrnState, &pTelegram->state,
-                   (sizeof(TRDP_OP_TRAIN_DIR_STATE_T) < dataSize) ? sizeof(TRDP_OP_TRAIN_DIR_STATE_T) : dataSize);
+            memset(&pTTDB->opTrnState, 0, sizeof(TRDP_OP_TRAIN_DIR_STATUS_INFO_T));
+            memcpy(&pTTDB->opTrnState, pTelegram, dataSize);
 
             /* unmarshall manually:   */
-            appHandle->pTTDB->opTrnState.etbTopoCnt         = vos_ntohl(pTelegram->etbTopoCnt);
-            appHandle->pTTDB->opTrnState.state.opTrnTopoCnt = vos_ntohl(pTelegram->state.opTrnTopoCnt);
-            appHandle->pTTDB->opTrnState.state.crc = vos_ntohl(pTelegram->state.crc);
-
-            /* vos_printLog(VOS_LOG_INFO, "---> Operational status info received on %p\n", appHandle); */
+            pTTDB->opTrnState.etbTopoCnt            = vos_ntohl(pTelegram->etbTopoCnt);
+            pTTDB->opTrnState.state.opTrnTopoCnt    = vos_ntohl(pTelegram->state.opTrnTopoCnt);
+            pTTDB->opTrnState.state.crc             = vos_ntohl(pTelegram->state.crc);
+            pTTDB->opTrnState.safetyTrail.safeSeqCount  = vos_ntohl(pTTDB->opTrnState.safetyTrail.safeSeqCount);
+            pTTDB->opTrnState.safetyTrail.safetyCode    = vos_ntohl(pTTDB->opTrnState.safetyTrail.safetyCode);
 
             /* Has the etbTopoCnt changed? */
-            if (appHandle->etbTopoCnt != appHandle->pTTDB->opTrnState.etbTopoCnt)
+            if (appHandle->etbTopoCnt != pTTDB->opTrnState.etbTopoCnt)
             {
                 vos_printLog(VOS_LOG_INFO, "ETB topocount changed (old: 0x%08x, new: 0x%08x) on %p!\n",
-                             appHandle->etbTopoCnt, appHandle->pTTDB->opTrnState.etbTopoCnt, (void*) appHandle);
+                             appHandle->etbTopoCnt, pTTDB->opTrnState.etbTopoCnt, (void *) appHandle);
                 changed++;
-                (void) tlc_setETBTopoCount(appHandle, appHandle->pTTDB->opTrnState.etbTopoCnt);
+                (void) tlc_setETBTopoCount(appHandle, pTTDB->opTrnState.etbTopoCnt);
             }
 
-            if (appHandle->opTrnTopoCnt != appHandle->pTTDB->opTrnState.state.opTrnTopoCnt)
+            if (appHandle->opTrnTopoCnt != pTTDB->opTrnState.state.opTrnTopoCnt)
             {
                 changed++;
-                (void) tlc_setOpTrainTopoCount(appHandle, appHandle->pTTDB->opTrnState.state.opTrnTopoCnt);
+                (void) tlc_setOpTrainTopoCount(appHandle, pTTDB->opTrnState.state.opTrnTopoCnt);
             }
 
         }
         else if (pMsg->resultCode == TRDP_TIMEOUT_ERR )
         {
             vos_printLog(VOS_LOG_ERROR, "---> Operational status info timed out! Invalidating topocounts on %p!\n",
-                         (void*)appHandle);
+                         (void *)appHandle);
 
             if (appHandle->etbTopoCnt != 0u)
             {
@@ -244,157 +901,451 @@ static void ttiPDCallback (
         else
         {
             vos_printLog(VOS_LOG_INFO, "---> Unsolicited msg received on %p!\n",
-                         (void*)appHandle);
+                         (void *)appHandle);
         }
-        if ((changed > 0) && (waitForInaug != NULL))
+        if (changed > 0)
         {
-            vos_semaGive(waitForInaug);
+            if (pTTDB->userAction != NULL)
+            {
+                vos_semaGive(pTTDB->userAction);
+            }
+            ttiNotify(appHandle, TRDP_TTI_EVENT_OP_TRN_STATE, NULL);
+            ttiStartPrefetch(appHandle);
+        }
+        else
+        {
+            ttiPrefetch(appHandle);
         }
     }
 }
 
 /**********************************************************************************************************************/
 /*  Functions to convert TTDB network packets into local (static) representation                                      */
+/*  They return the number of bytes used, 0 if the telegram is invalid                                                */
 /**********************************************************************************************************************/
-static void ttiStoreOpTrnDir (
+static UINT32 ttiStoreOpTrnDir (
     TRDP_APP_SESSION_T  appHandle,
-    UINT8               *pData)
+    const UINT8         *pData,
+    UINT32              dataSize)
 {
-    TRDP_OP_TRAIN_DIR_T *pTelegram = (TRDP_OP_TRAIN_DIR_T *) pData;
-    UINT32 size;
+    TAU_TTDB_T          *pTTDB = appHandle->pTTDB;
+    TRDP_OP_TRAIN_DIR_T opTrnDir;
+    UINT32              cstSize;
+    UINT32              vehPos;
+    UINT32              vehSize;
 
     /* we have to unpack the data, copy up to OP_CONSIST */
-    if (pTelegram->opCstCnt > TRDP_MAX_CST_CNT)
+    if (dataSize < TTI_OP_TRN_DIR_HDR_SIZE)
+    {
+        return 0u;
+    }
+    memset(&opTrnDir, 0, sizeof(opTrnDir));
+    memcpy(&opTrnDir, pData, TTI_OP_TRN_DIR_HDR_SIZE);
+    if (opTrnDir.opCstCnt > TRDP_MAX_CST_CNT)
     {
         vos_printLog(VOS_LOG_ERROR, "Max count of consists of received operational dir exceeded (%d)!\n",
-                     pTelegram->opCstCnt);
-        return;
+                     opTrnDir.opCstCnt);
+        return 0u;
     }
 
-    /* 8 Bytes up to opCstCnt plus number of Consists  */
-    size = 8 + pTelegram->opCstCnt * sizeof(TRDP_OP_CONSIST_T);
-    memcpy(&appHandle->pTTDB->opTrnDir, pData, size);
-    pData   += size + 3;            /* jump to cnt  */
-    size    = *pData++ *sizeof(TRDP_OP_VEHICLE_T) + sizeof(UINT32); /* copy opTrnTopoCnt as well    */
-    memcpy(&appHandle->pTTDB->opTrnDir, pData, size);
+    /* 8 Bytes up to opCstCnt plus number of Consists, 4 Bytes up to opVehCnt  */
+    cstSize = opTrnDir.opCstCnt * sizeof(TRDP_OP_CONSIST_T);
+    vehPos  = TTI_OP_TRN_DIR_HDR_SIZE + cstSize + 4u;
+    if (dataSize < vehPos)
+    {
+        return 0u;
+    }
+    memcpy(opTrnDir.opCstList, &pData[TTI_OP_TRN_DIR_HDR_SIZE], cstSize);
+    opTrnDir.opVehCnt = pData[vehPos - 1u];
+    if (opTrnDir.opVehCnt > TRDP_MAX_VEH_CNT)
+    {
+        vos_printLog(VOS_LOG_ERROR, "Max count of vehicles of received operational dir exceeded (%d)!\n",
+                     opTrnDir.opVehCnt);
+        return 0u;
+    }
+    vehSize = opTrnDir.opVehCnt * sizeof(TRDP_OP_VEHICLE_T);
+    if (dataSize < vehPos + vehSize + sizeof(UINT32))
+    {
+        return 0u;
+    }
+    memcpy(opTrnDir.opVehList, &pData[vehPos], vehSize);
 
     /* unmarshall manually and update the opTrnTopoCount   */
-    appHandle->pTTDB->opTrnDir.opTrnTopoCnt = vos_ntohl(appHandle->pTTDB->opTrnDir.opTrnTopoCnt);
-    (void) tlc_setOpTrainTopoCount(appHandle, appHandle->pTTDB->opTrnDir.opTrnTopoCnt);
+    opTrnDir.opTrnTopoCnt = ttiGet32(&pData[vehPos + vehSize]);
+    (void) tlc_setOpTrainTopoCount(appHandle, opTrnDir.opTrnTopoCnt);
+
+    if (memcmp(&opTrnDir, &pTTDB->opTrnDir, sizeof(opTrnDir)) != 0)
+    {
+        pTTDB->opTrnDir = opTrnDir;
+        ttiBuildOpIndex(pTTDB);
+        ttiNotify(appHandle, TRDP_TTI_EVENT_OP_TRN_DIR, NULL);
+    }
+    return vehPos + vehSize + sizeof(UINT32);
 }
 
-static void ttiStoreTrnDir (
+static UINT32 ttiStoreTrnDir (
     TRDP_APP_SESSION_T  appHandle,
-    UINT8               *pData)
+    const UINT8         *pData,
+    UINT32              dataSize)
 {
-    TRDP_TRAIN_DIR_T *pTelegram = (TRDP_TRAIN_DIR_T *) pData;
-    UINT32 size, i;
+    TAU_TTDB_T          *pTTDB = appHandle->pTTDB;
+    TRDP_TRAIN_DIR_T    trnDir;
+    UINT32              size, i;
 
     /* we have to unpack the data, copy up to CONSIST */
-    if (pTelegram->cstCnt > TRDP_MAX_CST_CNT)
+    if (dataSize < TTI_TRN_DIR_HDR_SIZE)
+    {
+        return 0u;
+    }
+    memset(&trnDir, 0, sizeof(trnDir));
+    memcpy(&trnDir, pData, TTI_TRN_DIR_HDR_SIZE);
+    if (trnDir.cstCnt > TRDP_MAX_CST_CNT)
     {
         vos_printLog(VOS_LOG_ERROR, "Max count of consists of received train dir exceeded (%d)!\n",
-                     pTelegram->cstCnt);
-        return;
+                     trnDir.cstCnt);
+        return 0u;
     }
 
     /* 4 Bytes up to cstCnt plus number of Consists  */
-    size = 4 + pTelegram->cstCnt * sizeof(TRDP_CONSIST_T);
-    memcpy(&appHandle->pTTDB->trnDir, pData, size);
-    pData += size;              /* jump to trnTopoCount  */
+    size = trnDir.cstCnt * sizeof(TRDP_CONSIST_T);
+    if (dataSize < TTI_TRN_DIR_HDR_SIZE + size + sizeof(UINT32))
+    {
+        return 0u;
+    }
+    memcpy(trnDir.cstList, &pData[TTI_TRN_DIR_HDR_SIZE], size);
 
-    /* unmarshall manually and update the trnTopoCount   */
-    appHandle->pTTDB->trnDir.trnTopoCnt = vos_ntohl((*(UINT32 *)pData));   /* copy trnTopoCnt as well    */
+    /* unmarshall manually: trnTopoCount and the consist topoCnts    */
+    trnDir.trnTopoCnt = ttiGet32(&pData[TTI_TRN_DIR_HDR_SIZE + size]);
+    for (i = 0u; i < trnDir.cstCnt; i++)
+    {
+        trnDir.cstList[i].cstTopoCnt = vos_ntohl(trnDir.cstList[i].cstTopoCnt);
+        trnDir.cstList[i].reserved01 = vos_ntohs(trnDir.cstList[i].reserved01);
+    }
 
-    /* swap the consist topoCnts    */
-    for (i = 0; i < appHandle->pTTDB->trnDir.cstCnt; i++)
+    pTTDB->trnDirEtbTopoCnt = appHandle->etbTopoCnt;
+    if (memcmp(&trnDir, &pTTDB->trnDir, sizeof(trnDir)) != 0)
     {
-        appHandle->pTTDB->trnDir.cstList[i].cstTopoCnt = vos_ntohl(appHandle->pTTDB->trnDir.cstList[i].cstTopoCnt);
+        pTTDB->trnDir = trnDir;
+        ttiBuildTrnIndex(pTTDB);
+
+        /* Keep the consist infos which did not change */
+        ttiCstDrop(pTTDB, ttiCstOutdated, TTI_MAX_CACHED_CST);
+        ttiNotify(appHandle, TRDP_TTI_EVENT_TRN_DIR, NULL);
     }
+    return TTI_TRN_DIR_HDR_SIZE + size + sizeof(UINT32);
 }
 
-static void ttiStoreTrnNetDir (
+static UINT32 ttiStoreTrnNetDir (
     TRDP_APP_SESSION_T  appHandle,
-    UINT8               *pData)
+    const UINT8         *pData,
+    UINT32              dataSize)
 {
-    TRDP_TRAIN_NET_DIR_T *pTelegram = (TRDP_TRAIN_NET_DIR_T *) pData;
-    UINT32 size, i;
+    TAU_TTDB_T              *pTTDB = appHandle->pTTDB;
+    TRDP_TRAIN_NET_DIR_T    trnNetDir;
+    UINT32                  size, i;
 
     /* we have to unpack the data, copy up to CONSIST */
-
-    appHandle->pTTDB->trnNetDir.reserved01  = 0;
-    appHandle->pTTDB->trnNetDir.entryCnt    = vos_ntohs(pTelegram->entryCnt);
-    if (appHandle->pTTDB->trnNetDir.entryCnt > TRDP_MAX_CST_CNT)
+    if (dataSize < TTI_NET_DIR_HDR_SIZE)
+    {
+        return 0u;
+    }
+    memset(&trnNetDir, 0, sizeof(trnNetDir));
+    trnNetDir.entryCnt = ttiGet16(&pData[2]);
+    if (trnNetDir.entryCnt > TRDP_MAX_CST_CNT)
     {
         vos_printLog(VOS_LOG_ERROR, "Max count of consists of received train net dir exceeded (%d)!\n",
-                     vos_ntohs(appHandle->pTTDB->trnNetDir.entryCnt));
-        return;
+                     trnNetDir.entryCnt);
+        return 0u;
     }
 
-    /* 4 Bytes up to cstCnt plus number of Consists  */
-    size = appHandle->pTTDB->trnNetDir.entryCnt * sizeof(TRDP_TRAIN_NET_DIR_ENTRY_T);
-    memcpy(&appHandle->pTTDB->trnNetDir.trnNetDir[0], pData, size);
-    pData += 4 + size;              /* jump to etbTopoCnt  */
+    /* 4 Bytes up to entryCnt plus number of Consists  */
+    size = trnNetDir.entryCnt * sizeof(TRDP_TRAIN_NET_DIR_ENTRY_T);
+    if (dataSize < TTI_NET_DIR_HDR_SIZE + size + sizeof(UINT32))
+    {
+        return 0u;
+    }
+    memcpy(trnNetDir.trnNetDir, &pData[TTI_NET_DIR_HDR_SIZE], size);
 
-    /* unmarshall manually and update the etbTopoCount   */
-    appHandle->pTTDB->trnNetDir.etbTopoCnt = vos_ntohl((*(UINT32 *)pData));   /* copy etbTopoCnt as well    */
+    /* unmarshall manually: etbTopoCount and the consist network properties    */
+    trnNetDir.etbTopoCnt = ttiGet32(&pData[TTI_NET_DIR_HDR_SIZE + size]);
+    for (i = 0u; i < trnNetDir.entryCnt; i++)
+    {
+        trnNetDir.trnNetDir[i].cstNetProp = vos_ntohl(trnNetDir.trnNetDir[i].cstNetProp);
+    }
 
-    /* swap the consist network properties    */
-    for (i = 0; i < appHandle->pTTDB->trnNetDir.entryCnt; i++)
+    if (memcmp(&trnNetDir, &pTTDB->trnNetDir, sizeof(trnNetDir)) != 0)
     {
-        appHandle->pTTDB->trnNetDir.trnNetDir[i].cstNetProp = vos_ntohl(
-                appHandle->pTTDB->trnNetDir.trnNetDir[i].cstNetProp);
+        pTTDB->trnNetDir = trnNetDir;
+        ttiNotify(appHandle, TRDP_TTI_EVENT_TRN_NET_DIR, NULL);
+    }
+    return TTI_NET_DIR_HDR_SIZE + size + sizeof(UINT32);
+}
+
+/**********************************************************************************************************************/
+/**    Store the reply to the read complete request
+ *  The operational train directory state is followed by the three variable size directories.
+ */
+static void ttiStoreReadComplete (
+    TRDP_APP_SESSION_T  appHandle,
+    const UINT8         *pData,
+    UINT32              dataSize)
+{
+    TAU_TTDB_T  *pTTDB = appHandle->pTTDB;
+    UINT32      crc;
+    UINT32      pos;
+    UINT32      used;
+    UINT32      opTrnTopoCnt;
+
+    if (dataSize < sizeof(TRDP_OP_TRAIN_DIR_STATE_T))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "Invalid read complete reply received!\n");
+        return;
+    }
+
+    /* Handle the op_state, check the crc (as for PD 100):   */
+    crc = vos_sc32(0xFFFFFFFFu, pData, sizeof(TRDP_OP_TRAIN_DIR_STATE_T) - 4);
+    if (crc != ttiGet32(&pData[sizeof(TRDP_OP_TRAIN_DIR_STATE_T) - 4]))
+    {
+        vos_printLog(VOS_LOG_ERROR, "CRC error of received operational status info (%08x != %08x)!\n",
+                     crc, ttiGet32(&pData[sizeof(TRDP_OP_TRAIN_DIR_STATE_T) - 4]));
+        (void) tlc_setOpTrainTopoCount(appHandle, 0);
+        return;
+    }
+    opTrnTopoCnt = pTTDB->opTrnState.state.opTrnTopoCnt;
+    memcpy(&pTTDB->opTrnState.state, pData, sizeof(TRDP_OP_TRAIN_DIR_STATE_T));
+
+    /* unmarshall manually:   */
+    pTTDB->opTrnState.state.opTrnTopoCnt    = ttiGet32(&pData[sizeof(TRDP_OP_TRAIN_DIR_STATE_T) - 8]);
+    pTTDB->opTrnState.state.crc             = crc;
+    (void) tlc_setOpTrainTopoCount(appHandle, pTTDB->opTrnState.state.opTrnTopoCnt);
+    if (opTrnTopoCnt != pTTDB->opTrnState.state.opTrnTopoCnt)
+    {
+        ttiNotify(appHandle, TRDP_TTI_EVENT_OP_TRN_STATE, NULL);
+    }
+
+    /* handle the other parts of the message    */
+    pos     = sizeof(TRDP_OP_TRAIN_DIR_STATE_T);
+    used    = ttiStoreOpTrnDir(appHandle, &pData[pos], dataSize - pos);
+    if (used > 0u)
+    {
+        pos     += used;
+        used    = ttiStoreTrnDir(appHandle, &pData[pos], dataSize - pos);
+    }
+    if (used > 0u)
+    {
+        pos     += used;
+        used    = ttiStoreTrnNetDir(appHandle, &pData[pos], dataSize - pos);
+    }
+    if (used == 0u)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "Invalid read complete reply received!\n");
     }
 }
 
 /***********************************************************************************************************************
- * Find an appropriate location to store the received consist info
+ * Replace or add the received consist info in the cache
  */
 static void ttiStoreCstInfo (
     TRDP_APP_SESSION_T  appHandle,
-    UINT8               *pData,
+    const UINT8         *pData,
     UINT32              dataSize)
 {
-    TRDP_CONSIST_INFO_T *pTelegram = (TRDP_CONSIST_INFO_T *) pData;
-    UINT32 curEntry = 0;
+    TAU_TTDB_T      *pTTDB = appHandle->pTTDB;
+    TAU_TTI_CST_T   *pNew;
+    TAU_TTI_CST_T   *pOld;
+
+    pNew = ttiParseCstInfo(pData, dataSize);
+    if (pNew == NULL)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "Consist info could not be stored!\n");
+        return;
+    }
 
-    if (ttiIsOwnCstInfo(appHandle, pTelegram) == TRUE)
+    pOld = ttiCstByUUID(pTTDB, pNew->cstInfo.cstUUID);
+    if (pOld != NULL)
     {
-        if (appHandle->pTTDB->cstInfo[curEntry] != NULL)
+        if ((pOld->netSize == pNew->netSize) &&
+            (memcmp(pOld->pNetData, pNew->pNetData, pNew->netSize) == 0))
         {
-            vos_memFree(appHandle->pTTDB->cstInfo[curEntry]);
-            appHandle->pTTDB->cstInfo[curEntry] = NULL;
+            vos_memFree(pNew);          /* unchanged */
+            return;
         }
+        ttiCstUnlink(pTTDB, pOld);
+        vos_memFree(pOld);
     }
-    else
+    else if (pTTDB->noOfCachedCst >= TTI_MAX_CACHED_CST)
     {
-        UINT32 l_index;
-        curEntry = 1;
-        /* check if already loaded */
-        for (l_index = 1; l_index < TRDP_MAX_CST_CNT; l_index++)
+        /* Make room by removing a consist which is not part of the train */
+        ttiCstDrop(pTTDB, ttiCstOutdated, 1u);
+        if (pTTDB->noOfCachedCst >= TTI_MAX_CACHED_CST)
         {
-            if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-                appHandle->pTTDB->cstInfo[l_index]->cstTopoCnt != 0 &&
-                memcmp(appHandle->pTTDB->cstInfo[l_index]->cstUUID, pTelegram->cstUUID, sizeof(TRDP_UUID_T)) == 0)
-            {
-                vos_memFree(appHandle->pTTDB->cstInfo[l_index]);
-                appHandle->pTTDB->cstInfo[l_index] = NULL;
-                curEntry = l_index;
-                break;
-            }
+            vos_printLogStr(VOS_LOG_ERROR, "Consist info cache full!\n");
+            vos_memFree(pNew);
+            return;
+        }
+    }
+    ttiCstLink(pTTDB, pNew);
+    ttiNotify(appHandle, TRDP_TTI_EVENT_CST_INFO, pNew->cstInfo.cstUUID);
+}
+
+/**********************************************************************************************************************/
+/*  Requests                                                                                                          */
+/**********************************************************************************************************************/
+
+static const TAU_TTI_REQ_PAR_T *ttiReqPar (
+    UINT32 comId)
+{
+    UINT32 i;
+
+    for (i = 0u; i < sizeof(sTtiReqPar) / sizeof(sTtiReqPar[0]); i++)
+    {
+        if (sTtiReqPar[i].comId == comId)
+        {
+            return &sTtiReqPar[i];
         }
     }
-    appHandle->pTTDB->cstInfo[curEntry] = (TRDP_CONSIST_INFO_T *) vos_memAlloc(dataSize);
-    if (appHandle->pTTDB->cstInfo[curEntry] == NULL)
+    return NULL;
+}
+
+/** Find the request slot given as user reference of a MD request */
+static TAU_TTI_REQ_T *ttiRequestSlot (
+    TAU_TTDB_T  *pTTDB,
+    const void  *pUserRef)
+{
+    UINT32 i;
+
+    for (i = 0u; i < TTI_MAX_REQUESTS; i++)
+    {
+        if (pUserRef == (const void *) &pTTDB->req[i])
+        {
+            return &pTTDB->req[i];
+        }
+    }
+    return NULL;
+}
+
+/** Number of request slots not in use */
+static UINT32 ttiFreeRequests (
+    const TAU_TTDB_T *pTTDB)
+{
+    UINT32  i;
+    UINT32  cnt = 0u;
+
+    for (i = 0u; i < TTI_MAX_REQUESTS; i++)
+    {
+        if (pTTDB->req[i].comId == 0u)
+        {
+            cnt++;
+        }
+    }
+    return cnt;
+}
+
+/** Allow the prefetch burst to repeat a failed request */
+static void ttiPrefetchRetry (
+    TAU_TTDB_T          *pTTDB,
+    const TAU_TTI_REQ_T *pReq)
+{
+    UINT32 i;
+
+    if ((pTTDB->prefetchActive == FALSE) || (pTTDB->prefetchRetries >= TTI_PREFETCH_RETRIES))
+    {
+        return;
+    }
+    pTTDB->prefetchRetries++;
+    if (pReq->comId != TTDB_STAT_CST_REQ_COMID)
     {
-        vos_printLogStr(VOS_LOG_ERROR, "Consist info could not be stored!");
+        pTTDB->prefetchDirs &= ~(1u << (UINT32) (ttiReqPar(pReq->comId) - sTtiReqPar));
         return;
     }
+    for (i = 0u; i < pTTDB->noOfPrefetchedCst; i++)
+    {
+        if (memcmp(pTTDB->prefetchedCst[i], pReq->cstUUID, sizeof(TRDP_UUID_T)) == 0)
+        {
+            pTTDB->noOfPrefetchedCst--;
+            memcpy(pTTDB->prefetchedCst[i], pTTDB->prefetchedCst[pTTDB->noOfPrefetchedCst], sizeof(TRDP_UUID_T));
+            break;
+        }
+    }
+}
+
+static void ttiMDCallback (void                    *pRefCon,
+                           TRDP_APP_SESSION_T      appHandle,
+                           const TRDP_MD_INFO_T    *pMsg,
+                           UINT8                   *pData,
+                           UINT32                  dataSize);
 
-    /* We do not convert but just copy the consist info slot   */
+/** Send the request of a slot to the ECSP */
+static BOOL8 ttiSendRequest (
+    TRDP_APP_SESSION_T  appHandle,
+    TAU_TTI_REQ_T       *pReq,
+    TRDP_IP_ADDR_T      ecspIpAddr)
+{
+    const TAU_TTI_REQ_PAR_T *pPar   = ttiReqPar(pReq->comId);
+    UINT8                   param   = 0u;       /* ETB0 */
+    const UINT8             *pParam = &param;
+    UINT32                  size    = sizeof(param);
+    TRDP_ERR_T              err;
 
-    memcpy(appHandle->pTTDB->cstInfo[curEntry], pTelegram, dataSize);
-    appHandle->pTTDB->cstSize[curEntry] = dataSize;
+    if (pReq->comId == TTDB_STAT_CST_REQ_COMID)
+    {
+        pParam  = pReq->cstUUID;
+        size    = sizeof(TRDP_UUID_T);
+    }
+    err = tlm_request(appHandle, pReq, ttiMDCallback, NULL, pReq->comId, appHandle->etbTopoCnt,
+                      appHandle->opTrnTopoCnt, 0u, ecspIpAddr, TRDP_FLAGS_CALLBACK, 1u,
+                      pPar->timeout * 1000u, NULL, pParam, size, NULL, NULL);
+    if (err != TRDP_NO_ERR)
+    {
+        vos_printLog(VOS_LOG_ERROR, "TTDB request %u failed (Err: %d)\n", pReq->comId, err);
+        pReq->comId = 0u;
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/**    Completion of the ECSP address resolution, send the requests waiting for it
+ *
+ *  @param[in]      pRefCon         TTDB of the session
+ *  @param[in]      appHandle       Handle returned by tlc_openSession()
+ *  @param[in]      pUri            URI which was resolved
+ *  @param[in]      ipAddr          resolved IP address
+ *  @param[in]      result          result of the resolution
+ *
+ *  @retval         none
+ */
+static void ttiDnrCallback (
+    void                *pRefCon,
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pUri,
+    TRDP_IP_ADDR_T      ipAddr,
+    TRDP_ERR_T          result)
+{
+    TAU_TTDB_T  *pTTDB = (TAU_TTDB_T *) pRefCon;
+    UINT32      i;
+
+    for (i = 0u; i < TTI_MAX_REQUESTS; i++)
+    {
+        TAU_TTI_REQ_T *pReq = &pTTDB->req[i];
+
+        if ((pReq->comId != 0u) &&
+            (pReq->waitForAddr == TRUE) &&
+            (vos_strnicmp(ttiReqPar(pReq->comId)->pUri, pUri, TRDP_MAX_URI_HOST_LEN) == 0))
+        {
+            pReq->waitForAddr = FALSE;
+            if (result == TRDP_NO_ERR)
+            {
+                (void) ttiSendRequest(appHandle, pReq, ipAddr);
+            }
+            else
+            {
+                vos_printLog(VOS_LOG_ERROR, "TTDB request %u: %s not resolved (Err: %d)\n",
+                             pReq->comId, pUri, result);
+                pReq->comId = 0u;
+            }
+        }
+    }
 }
 
 /**********************************************************************************************************************/
@@ -418,170 +1369,403 @@ static void ttiMDCallback (
     UINT8                   *pData,
     UINT32                  dataSize)
 {
-    VOS_SEMA_T waitForInaug = (VOS_SEMA_T) pRefCon;
+    TAU_TTDB_T      *pTTDB = appHandle->pTTDB;
+    TAU_TTI_REQ_T   *pReq;
+
+    pRefCon = pRefCon;
+
+    if (pTTDB == NULL)
+    {
+        return;
+    }
+
+    /* Reply or timeout of one of our requests */
+    pReq = ttiRequestSlot(pTTDB, pMsg->pUserRef);
+
+    if ((pMsg->resultCode != TRDP_NO_ERR) || (pData == NULL))
+    {
+        vos_printLog(VOS_LOG_INFO, "TTDB telegram %u not received (Err: %d)\n", pMsg->comId, pMsg->resultCode);
+        if (pReq != NULL)
+        {
+            ttiPrefetchRetry(pTTDB, pReq);
+            pReq->comId = 0u;
+        }
+        ttiPrefetch(appHandle);
+        return;
+    }
+    if (pReq != NULL)
+    {
+        pReq->comId = 0u;
+    }
 
     if (pMsg->comId == TTDB_OP_DIR_INFO_COMID ||      /* TTDB notification */
         pMsg->comId == TTDB_OP_DIR_INFO_REP_COMID)
     {
-        if (pMsg->resultCode == TRDP_NO_ERR &&
-            dataSize <= sizeof(TRDP_OP_TRAIN_DIR_T))
+        if (ttiStoreOpTrnDir(appHandle, pData, dataSize) == 0u)
         {
-            ttiStoreOpTrnDir(appHandle, pData);
-            if (waitForInaug != NULL)
+            vos_printLogStr(VOS_LOG_ERROR, "Invalid operational train directory received!\n");
+        }
+        else
+        {
+            if (pTTDB->userAction != NULL)
+            {
+                vos_semaGive(pTTDB->userAction);       /* Signal new inauguration    */
+            }
+            if (pMsg->comId == TTDB_OP_DIR_INFO_COMID)
             {
-                vos_semaGive(waitForInaug);           /* Signal new inauguration    */
+                ttiStartPrefetch(appHandle);
             }
         }
     }
     else if (pMsg->comId == TTDB_TRN_DIR_REP_COMID)
     {
-        if (pMsg->resultCode == TRDP_NO_ERR &&
-            dataSize <= sizeof(TRDP_TRAIN_DIR_T))
+        if (ttiStoreTrnDir(appHandle, pData, dataSize) == 0u)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "Invalid train directory received!\n");
+        }
+        else
         {
             UINT32 i;
-            ttiStoreTrnDir(appHandle, pData);
-            /* Request consist infos now (fill cache)   */
-            for (i = 0; i < TTI_CACHED_CONSISTS; i++)
+
+            /* Request missing or changed consist infos now (fill cache)   */
+            for (i = 0u; (i < pTTDB->trnDir.cstCnt) && (i < TTI_CACHED_CONSISTS); i++)
             {
-                /* invalidate entry */
-                if (appHandle->pTTDB->cstInfo[i] != NULL)
+                if (pTTDB->trnDir.cstList[i].cstTopoCnt == 0u)
                 {
-                    vos_memFree(appHandle->pTTDB->cstInfo[i]);
-                    appHandle->pTTDB->cstInfo[i] = NULL;
+                    break;  /* no of available consists reached   */
                 }
-                ;
-            }
-            for (i = 0; i < TTI_CACHED_CONSISTS; i++)
-            {
-                if (appHandle->pTTDB->trnDir.cstList[i].cstTopoCnt == 0)
+                if (ttiCstByUUID(pTTDB, pTTDB->trnDir.cstList[i].cstUUID) == NULL)
                 {
-                    break;  /* no of available consists reached   */
+                    (void) ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, pTTDB->trnDir.cstList[i].cstUUID);
                 }
-                ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, appHandle->pTTDB->trnDir.cstList[i].cstUUID);
             }
         }
     }
     else if (pMsg->comId == TTDB_NET_DIR_REP_COMID)
     {
-        if (pMsg->resultCode == TRDP_NO_ERR &&
-            dataSize <= sizeof(TRDP_TRAIN_NET_DIR_T))
+        if (ttiStoreTrnNetDir(appHandle, pData, dataSize) == 0u)
         {
-            ttiStoreTrnNetDir(appHandle, pData);
+            vos_printLogStr(VOS_LOG_ERROR, "Invalid train network directory received!\n");
         }
     }
     else if (pMsg->comId == TTDB_READ_CMPLT_REP_COMID)
     {
-        if (pMsg->resultCode == TRDP_NO_ERR &&
-            dataSize <= sizeof(TRDP_READ_COMPLETE_REPLY_T))
+        ttiStoreReadComplete(appHandle, pData, dataSize);
+    }
+    else if (pMsg->comId == TTDB_STAT_CST_REP_COMID)
+    {
+        ttiStoreCstInfo(appHandle, pData, dataSize);
+    }
+
+    /* Continue a running prefetch burst with the slot just released */
+    ttiPrefetch(appHandle);
+}
+
+/**********************************************************************************************************************/
+/**    Function to request TTDB data from ECSP
+ *
+ *  Request update of our data store. A request is not repeated while the same one is outstanding. The request is
+ *  queued only, it is sent with the next tlc_process() call.
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *  @param[in]      comID           Communication ID of request
+ *  @param[in]      cstUUID         Pointer to the additional info
+ *
+ *  @retval         TRUE            request queued
+ *  @retval         FALSE           request outstanding, waiting for the ECSP address or failed
+ *
+ */
+static BOOL8 ttiRequestTTDBdata (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              comID,
+    const TRDP_UUID_T   cstUUID)
+{
+    TAU_TTDB_T          *pTTDB = appHandle->pTTDB;
+    TAU_TTI_REQ_T       *pFree = NULL;
+    const TRDP_TIME_T   guard  = {TTI_REQ_GUARD_S, 0};
+    TRDP_TIME_T         now;
+    TRDP_IP_ADDR_T      ecspIpAddr = VOS_INADDR_ANY;
+    TRDP_ERR_T          err;
+    UINT32              i;
+
+    if (ttiReqPar(comID) == NULL)
+    {
+        return FALSE;
+    }
+
+    vos_getTime(&now);
+    for (i = 0u; i < TTI_MAX_REQUESTS; i++)
+    {
+        TAU_TTI_REQ_T *pReq = &pTTDB->req[i];
+
+        if ((pReq->comId != 0u) && (vos_cmpTime(&pReq->timeout, &now) < 0))
         {
-            TRDP_READ_COMPLETE_REPLY_T *pTelegram = (TRDP_READ_COMPLETE_REPLY_T *) pData;
-            UINT32 crc;
+            pReq->comId = 0u;           /* reply lost */
+        }
+        if ((pReq->comId == comID) &&
+            ((comID != TTDB_STAT_CST_REQ_COMID) || (memcmp(pReq->cstUUID, cstUUID, sizeof(TRDP_UUID_T)) == 0)))
+        {
+            return FALSE;               /* already asked for */
+        }
+        if ((pReq->comId == 0u) && (pFree == NULL))
+        {
+            pFree = pReq;
+        }
+    }
+    if (pFree == NULL)
+    {
+        vos_printLog(VOS_LOG_WARNING, "TTDB request %u dropped, too many outstanding requests\n", comID);
+        return FALSE;
+    }
+
+    pFree->comId = comID;
+    if (cstUUID != NULL)
+    {
+        memcpy(pFree->cstUUID, cstUUID, sizeof(TRDP_UUID_T));
+    }
+    else
+    {
+        memset(pFree->cstUUID, 0, sizeof(TRDP_UUID_T));
+    }
+    pFree->timeout = now;
+    vos_addTime(&pFree->timeout, &guard);
 
-            /* Handle the op_state  */
+    /* The resolution may complete (and fail) within this call */
+    pFree->waitForAddr = TRUE;
+    err = tau_uri2AddrAsync(appHandle, &ecspIpAddr, ttiReqPar(comID)->pUri, ttiDnrCallback, pTTDB);
+    if (err == TRDP_NO_ERR)
+    {
+        pFree->waitForAddr = FALSE;
+        return ttiSendRequest(appHandle, pFree, ecspIpAddr);
+    }
+    if (err != TRDP_BLOCK_ERR)
+    {
+        vos_printLog(VOS_LOG_ERROR, "TTDB request %u: %s not resolved (Err: %d)\n",
+                     comID, ttiReqPar(comID)->pUri, err);
+        pFree->comId = 0u;
+    }
+    return FALSE;
+}
 
-            /* check the crc:   */
-            crc = vos_crc32(0xFFFFFFFF, (const UINT8 *) &pTelegram->state, dataSize - 4);
-            if (crc != MAKE_LE(pTelegram->state.crc))
+/**********************************************************************************************************************/
+/**    Request TTDB data on behalf of the application and send it immediately
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *  @param[in]      comID           Communication ID of request
+ *  @param[in]      cstUUID         Pointer to the additional info
+ *
+ */
+static void ttiDemandTTDBdata (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              comID,
+    const TRDP_UUID_T   cstUUID)
+{
+    if ((ttiRequestTTDBdata(appHandle, comID, cstUUID) == TRUE) &&
+        (appHandle->pTTDB->inNotify == FALSE))
+    {
+        /* Make sure the request is sent (not from within tlc_process, i.e. the change notification): */
+        (void) tlc_process(appHandle, NULL, NULL);
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Request an item of the prefetch burst, once per burst
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *  @param[in]      comID           Communication ID of request
+ *  @param[in]      cstUUID         Consist for TTDB_STAT_CST_REQ_COMID, NULL otherwise
+ *
+ */
+static void ttiPrefetchItem (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              comID,
+    const TRDP_UUID_T   cstUUID)
+{
+    TAU_TTDB_T  *pTTDB = appHandle->pTTDB;
+    UINT32      i;
+
+    if (ttiFreeRequests(pTTDB) == 0u)
+    {
+        return;                         /* continued when a reply releases a slot */
+    }
+    if (comID == TTDB_STAT_CST_REQ_COMID)
+    {
+        for (i = 0u; i < pTTDB->noOfPrefetchedCst; i++)
+        {
+            if (memcmp(pTTDB->prefetchedCst[i], cstUUID, sizeof(TRDP_UUID_T)) == 0)
             {
-                vos_printLog(VOS_LOG_ERROR, "CRC error of received operational status info (%08x != %08x)!\n",
-                             crc, vos_ntohl(pTelegram->state.crc))
-                    (void) tlc_setOpTrainTopoCount(appHandle, 0);
                 return;
             }
-            memcpy(&appHandle->pTTDB->opTrnState.state, &pTelegram->state,
-                   (dataSize > sizeof(TRDP_OP_TRAIN_DIR_STATE_T)) ? sizeof(TRDP_OP_TRAIN_DIR_STATE_T) : dataSize);
+        }
+        if (pTTDB->noOfPrefetchedCst >= TRDP_MAX_CST_CNT)
+        {
+            return;
+        }
+        memcpy(pTTDB->prefetchedCst[pTTDB->noOfPrefetchedCst++], cstUUID, sizeof(TRDP_UUID_T));
+    }
+    else
+    {
+        UINT32 bit = 1u << (UINT32) (ttiReqPar(comID) - sTtiReqPar);
 
-            /* unmarshall manually:   */
-            appHandle->pTTDB->opTrnState.state.opTrnTopoCnt = vos_ntohl(pTelegram->state.opTrnTopoCnt);
-            (void) tlc_setOpTrainTopoCount(appHandle, appHandle->pTTDB->opTrnState.state.opTrnTopoCnt);
-            appHandle->pTTDB->opTrnState.state.crc = MAKE_LE(pTelegram->state.crc);
-
-            /* handle the other parts of the message    */
-            ttiStoreOpTrnDir(appHandle, (UINT8 *) &pTelegram->opTrnDir);
-            ttiStoreTrnDir(appHandle, (UINT8 *) &pTelegram->trnDir);
-            ttiStoreTrnNetDir(appHandle, (UINT8 *) &pTelegram->trnNetDir);
+        if ((pTTDB->prefetchDirs & bit) != 0u)
+        {
+            return;
         }
+        pTTDB->prefetchDirs |= bit;
     }
-    else if (pMsg->comId == TTDB_STAT_CST_REP_COMID)
+    (void) ttiRequestTTDBdata(appHandle, comID, cstUUID);
+}
+
+/**********************************************************************************************************************/
+/**    Continue the prefetch burst
+ *
+ *  Request everything not cached for the current topocounts yet, as long as request slots are free. The requests
+ *  are sent together with the next tlc_process() call. If nothing is missing, the burst is complete.
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *
+ */
+static void ttiPrefetch (
+    TRDP_APP_SESSION_T appHandle)
+{
+    TAU_TTDB_T  *pTTDB      = appHandle->pTTDB;
+    BOOL8       complete    = TRUE;
+    UINT32      i;
+
+    /* A notification (MD 101) may precede the status info of the new topology (PD 100), requests sent in between
+       would carry the old etbTopoCnt */
+    if ((pTTDB->prefetchActive == FALSE) ||
+        (appHandle->etbTopoCnt == 0u) ||
+        (appHandle->opTrnTopoCnt == 0u) ||
+        (pTTDB->opTrnState.etbTopoCnt != appHandle->etbTopoCnt) ||
+        (pTTDB->opTrnState.state.opTrnTopoCnt != appHandle->opTrnTopoCnt))
     {
+        return;                         /* wait for valid topocounts */
+    }
 
-        if (pMsg->resultCode == TRDP_NO_ERR &&
-            dataSize <= sizeof(TRDP_CONSIST_INFO_T))
+    if ((pTTDB->opTrnDir.opCstCnt == 0u) || (pTTDB->opTrnDir.opTrnTopoCnt != appHandle->opTrnTopoCnt))
+    {
+        ttiPrefetchItem(appHandle, TTDB_OP_DIR_INFO_REQ_COMID, NULL);
+        complete = FALSE;
+    }
+    else
+    {
+        for (i = 0u; i < pTTDB->opTrnDir.opCstCnt; i++)
         {
-            /* find a free place in the cache, or overwrite oldest entry   */
-            ttiStoreCstInfo(appHandle, pData, dataSize);
+            const UINT8 *pUUID = pTTDB->opTrnDir.opCstList[i].cstUUID;
+
+            if ((ttiIsNullUUID(pUUID) == FALSE) && (ttiCstByUUID(pTTDB, pUUID) == NULL))
+            {
+                ttiPrefetchItem(appHandle, TTDB_STAT_CST_REQ_COMID, pUUID);
+                complete = FALSE;
+            }
         }
     }
+
+    if ((pTTDB->trnDir.cstCnt == 0u) || (pTTDB->trnDirEtbTopoCnt != appHandle->etbTopoCnt))
+    {
+        ttiPrefetchItem(appHandle, TTDB_TRN_DIR_REQ_COMID, NULL);
+        complete = FALSE;
+    }
+    else
+    {
+        for (i = 0u; (i < pTTDB->trnDir.cstCnt) && (pTTDB->trnDir.cstList[i].cstTopoCnt != 0u); i++)
+        {
+            if (ttiCstByUUID(pTTDB, pTTDB->trnDir.cstList[i].cstUUID) == NULL)
+            {
+                ttiPrefetchItem(appHandle, TTDB_STAT_CST_REQ_COMID, pTTDB->trnDir.cstList[i].cstUUID);
+                complete = FALSE;
+            }
+        }
+    }
+
+    if ((pTTDB->trnNetDir.entryCnt == 0u) || (pTTDB->trnNetDir.etbTopoCnt != appHandle->etbTopoCnt))
+    {
+        ttiPrefetchItem(appHandle, TTDB_NET_DIR_REQ_COMID, NULL);
+        complete = FALSE;
+    }
+
+    if (complete == TRUE)
+    {
+        pTTDB->prefetchActive = FALSE;
+        vos_printLog(VOS_LOG_INFO, "TTDB prefetch complete (etbTopoCnt 0x%08x, opTrnTopoCnt 0x%08x)\n",
+                     appHandle->etbTopoCnt, appHandle->opTrnTopoCnt);
+        ttiNotify(appHandle, TRDP_TTI_EVENT_TTDB_COMPLETE, NULL);
+    }
 }
 
 /**********************************************************************************************************************/
-/**    Function to request TTDB data from ECSP
+/**    Start a prefetch burst for the current topocounts, if enabled
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
  *
- *  Request update of our data store
+ */
+static void ttiStartPrefetch (
+    TRDP_APP_SESSION_T appHandle)
+{
+    TAU_TTDB_T *pTTDB = appHandle->pTTDB;
+
+    if (pTTDB->prefetch == TRUE)
+    {
+        pTTDB->prefetchActive       = TRUE;
+        pTTDB->prefetchRetries      = 0u;
+        pTTDB->prefetchDirs         = 0u;
+        pTTDB->noOfPrefetchedCst    = 0u;
+        ttiPrefetch(appHandle);
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Find a cached consist info, request it if it is missing. The session mutex must be held.
  *
  *  @param[in]      appHandle       Handle returned by tlc_openSession().
- *  @param[in]      comID           Communication ID of request
- *  @param[in]      cstUUID         Pointer to the additional info
+ *  @param[in]      pCstLabel       Pointer to a consist label. NULL means own consist.
  *
- *  @retval         none
+ *  @retval         cached consist info
+ *  @retval         NULL            not available (yet)
  *
  */
-static void ttiRequestTTDBdata (
-    TRDP_APP_SESSION_T  appHandle,
-    UINT32              comID,
-    const TRDP_UUID_T   cstUUID)
+static const TAU_TTI_CST_T *ttiFindCst (
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pCstLabel)
 {
-    switch (comID)
-    {
-       case TTDB_OP_DIR_INFO_REQ_COMID:
-       {
-           UINT8 param = 0;
-           (void) tlm_request(appHandle, NULL, ttiMDCallback, NULL, TTDB_OP_DIR_INFO_REQ_COMID, appHandle->etbTopoCnt,
-                              appHandle->opTrnTopoCnt, 0, ipFromURI(appHandle,
-                                                                    TTDB_OP_DIR_INFO_REQ_URI), TRDP_FLAGS_CALLBACK, 1,
-                              TTDB_OP_DIR_INFO_REQ_TO, NULL, &param, sizeof(param), NULL, NULL);
-           /* Make sure the request is sent: */
-       }
-       break;
-       case TTDB_TRN_DIR_REQ_COMID:
-       {
-           UINT8 param = 0;         /* ETB0 */
-           (void) tlm_request(appHandle, NULL, ttiMDCallback, NULL, TTDB_TRN_DIR_REQ_COMID, appHandle->etbTopoCnt,
-                              appHandle->opTrnTopoCnt, 0, ipFromURI(appHandle,
-                                                                    TTDB_TRN_DIR_REQ_URI), TRDP_FLAGS_CALLBACK, 1,
-                              TTDB_TRN_DIR_REQ_TO, NULL, &param, sizeof(param), NULL, NULL);
-       }
-       break;
-       case TTDB_NET_DIR_REQ_COMID:
-       {
-           UINT8 param = 0;         /* ETB0 */
-           (void) tlm_request(appHandle, NULL, ttiMDCallback, NULL, TTDB_NET_DIR_REQ_COMID, appHandle->etbTopoCnt,
-                              appHandle->opTrnTopoCnt, 0, ipFromURI(appHandle,
-                                                                    TTDB_NET_DIR_REQ_URI), TRDP_FLAGS_CALLBACK, 1,
-                              TTDB_NET_DIR_REQ_TO, NULL, &param, sizeof(param), NULL, NULL);
-       }
-       break;
-       case TTDB_READ_CMPLT_REQ_COMID:
-       {
-           UINT8 param = 0;         /* ETB0 */
-           (void) tlm_request(appHandle, NULL, ttiMDCallback, NULL, TTDB_READ_CMPLT_REQ_COMID, appHandle->etbTopoCnt,
-                              appHandle->opTrnTopoCnt, 0, ipFromURI(appHandle,
-                                                                    TTDB_READ_CMPLT_REQ_URI), TRDP_FLAGS_CALLBACK, 1,
-                              TTDB_READ_CMPLT_REQ_TO, NULL, &param, sizeof(param), NULL, NULL);
-       }
-       break;
-       case TTDB_STAT_CST_REQ_COMID:
-       {
-           (void) tlm_request(appHandle, NULL, ttiMDCallback, NULL, TTDB_STAT_CST_REQ_COMID, appHandle->etbTopoCnt,
-                              appHandle->opTrnTopoCnt, 0, ipFromURI(appHandle,
-                                                                    TTDB_STAT_CST_REQ_URI), TRDP_FLAGS_CALLBACK, 1,
-                              TTDB_STAT_CST_REQ_TO, NULL, cstUUID, sizeof(TRDP_UUID_T), NULL, NULL);
-       }
-       break;
-
-    }
-    /* Make sure the request is sent: */
-    (void) tlc_process(appHandle, NULL, NULL);
+    TAU_TTDB_T      *pTTDB = appHandle->pTTDB;
+    TAU_TTI_CST_T   *pCst;
+    TRDP_UUID_T     cstUUID;
+    const UINT8     *pUUID;
+
+    if (pCstLabel == NULL)
+    {
+        pUUID = ttiOwnCstUUID(pTTDB);
+        if (pUUID == NULL)
+        {
+            ttiDemandTTDBdata(appHandle, TTDB_NET_DIR_REQ_COMID, NULL);
+            return NULL;
+        }
+        pCst = ttiCstByUUID(pTTDB, pUUID);
+    }
+    else
+    {
+        pCst = ttiCstByLabel(pTTDB, pCstLabel);
+        if (pCst == NULL)
+        {
+            ttiGetUUIDfromLabel(pTTDB, cstUUID, pCstLabel);
+            if (ttiIsNullUUID(cstUUID) == TRUE)
+            {
+                if (pTTDB->opTrnDir.opCstCnt == 0u)
+                {
+                    ttiDemandTTDBdata(appHandle, TTDB_OP_DIR_INFO_REQ_COMID, NULL);
+                }
+                return NULL;
+            }
+        }
+        pUUID = cstUUID;
+    }
+    if (pCst == NULL)    /* not found, get it and return directly */
+    {
+        ttiDemandTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, pUUID);
+    }
+    return pCst;
 }
 
 #pragma mark ----------------------- Public -----------------------------
@@ -623,6 +1807,7 @@ EXT_DECL TRDP_ERR_T tau_initTTIaccess (
     {
         return TRDP_MEM_ERR;
     }
+    appHandle->pTTDB->userAction = userAction;
 
     /*  subscribe to PD 100 */
 
@@ -638,6 +1823,7 @@ EXT_DECL TRDP_ERR_T tau_initTTIaccess (
                       TRDP_TO_SET_TO_ZERO) != TRDP_NO_ERR)
     {
         vos_memFree(appHandle->pTTDB);
+        appHandle->pTTDB = NULL;
         return TRDP_INIT_ERR;
     }
 
@@ -645,7 +1831,7 @@ EXT_DECL TRDP_ERR_T tau_initTTIaccess (
 
     if (tlm_addListener(appHandle,
                         &appHandle->pTTDB->md101Listener,
-                        userAction,
+                        NULL,
                         ttiMDCallback,
                         TRUE,
                         TTDB_OP_DIR_INFO_COMID,
@@ -655,7 +1841,9 @@ EXT_DECL TRDP_ERR_T tau_initTTIaccess (
                         vos_dottedIP(TTDB_OP_DIR_INFO_IP),
                         TRDP_FLAGS_CALLBACK, NULL, NULL) != TRDP_NO_ERR)
     {
+        (void) tlp_unsubscribe(appHandle, appHandle->pTTDB->pd100SubHandle);
         vos_memFree(appHandle->pTTDB);
+        appHandle->pTTDB = NULL;
         return TRDP_INIT_ERR;
     }
     return TRDP_NO_ERR;
@@ -675,20 +1863,80 @@ EXT_DECL void tau_deInitTTI (
 {
     if (appHandle->pTTDB != NULL)
     {
-        UINT32 i;
-        for (i = 0; i < appHandle->pTTDB->noOfCachedCst; i++)
+        TAU_TTDB_T *pTTDB = appHandle->pTTDB;
+
+        (void) tau_uri2AddrCancel(appHandle, ttiDnrCallback, pTTDB);
+        if (vos_mutexLock(appHandle->mutex) == VOS_NO_ERR)
         {
-            if (appHandle->pTTDB->cstInfo[i] != NULL)
-            {
-                vos_memFree(appHandle->pTTDB->cstInfo[i]);
-                appHandle->pTTDB->cstInfo[i] = NULL;
-            }
+            ttiCstDrop(pTTDB, NULL, TTI_MAX_CACHED_CST);
+            appHandle->pTTDB = NULL;
+            (void) vos_mutexUnlock(appHandle->mutex);
         }
-        (void) tlm_delListener(appHandle, appHandle->pTTDB->md101Listener);
-        (void) tlp_unsubscribe(appHandle, appHandle->pTTDB->pd100SubHandle);
-        vos_memFree(appHandle->pTTDB);
-        appHandle->pTTDB = NULL;
+        (void) tlm_delListener(appHandle, pTTDB->md101Listener);
+        (void) tlp_unsubscribe(appHandle, pTTDB->pd100SubHandle);
+        vos_memFree(pTTDB);
+    }
+}
+
+/**********************************************************************************************************************/
+/**    Function to set the change notification callback
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *  @param[in]      pfCbFunction    Callback for changes, NULL to remove the callback.
+ *  @param[in]      pRefCon         User context given to the callback
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  Parameter error
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_setTTIcallback (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_TTI_CALLBACK_T pfCbFunction,
+    void                *pRefCon)
+{
+    if (appHandle == NULL ||
+        appHandle->pTTDB == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+    appHandle->pTTDB->pfCbChange    = pfCbFunction;
+    appHandle->pTTDB->pCbRefCon     = pRefCon;
+    (void) vos_mutexUnlock(appHandle->mutex);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/**    Function to enable the prefetch of the TTDB
+ *
+ *  @param[in]      appHandle       Handle returned by tlc_openSession().
+ *  @param[in]      enable          TRUE to request all TTDB data after each topology change
+ *
+ *  @retval         TRDP_NO_ERR     no error
+ *  @retval         TRDP_PARAM_ERR  Parameter error
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_setTTIprefetch (
+    TRDP_APP_SESSION_T  appHandle,
+    BOOL8               enable)
+{
+    if (appHandle == NULL ||
+        appHandle->pTTDB == NULL)
+    {
+        return TRDP_PARAM_ERR;
     }
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
+    appHandle->pTTDB->prefetch          = enable;
+    appHandle->pTTDB->prefetchActive    = FALSE;
+    ttiStartPrefetch(appHandle);
+    (void) vos_mutexUnlock(appHandle->mutex);
+    return TRDP_NO_ERR;
 }
 
 /**********************************************************************************************************************/
@@ -709,26 +1957,36 @@ EXT_DECL TRDP_ERR_T tau_getOpTrDirectory (
     TRDP_OP_TRAIN_DIR_STATE_T   *pOpTrnDirState,
     TRDP_OP_TRAIN_DIR_T         *pOpTrnDir)
 {
+    TRDP_ERR_T err = TRDP_NO_ERR;
+
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL)
     {
         return TRDP_PARAM_ERR;
     }
-    if (appHandle->pTTDB->opTrnDir.opCstCnt == 0 ||
-        appHandle->pTTDB->opTrnDir.opTrnTopoCnt != appHandle->opTrnTopoCnt)     /* need update? */
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
     {
-        ttiRequestTTDBdata(appHandle, TTDB_OP_DIR_INFO_REQ_COMID, NULL);
-        return TRDP_NODATA_ERR;
+        return TRDP_MUTEX_ERR;
     }
-    if (pOpTrnDirState != NULL)
+    if (appHandle->pTTDB->opTrnDir.opCstCnt == 0 ||
+        appHandle->pTTDB->opTrnDir.opTrnTopoCnt != appHandle->opTrnTopoCnt)     /* need update? */
     {
-        *pOpTrnDirState = appHandle->pTTDB->opTrnState.state;
+        ttiDemandTTDBdata(appHandle, TTDB_OP_DIR_INFO_REQ_COMID, NULL);
+        err = TRDP_NODATA_ERR;
     }
-    if (pOpTrnDir != NULL)
+    else
     {
-        *pOpTrnDir = appHandle->pTTDB->opTrnDir;
+        if (pOpTrnDirState != NULL)
+        {
+            *pOpTrnDirState = appHandle->pTTDB->opTrnState.state;
+        }
+        if (pOpTrnDir != NULL)
+        {
+            *pOpTrnDir = appHandle->pTTDB->opTrnDir;
+        }
     }
-    return TRDP_NO_ERR;
+    (void) vos_mutexUnlock(appHandle->mutex);
+    return err;
 }
 
 /**********************************************************************************************************************/
@@ -753,7 +2011,12 @@ EXT_DECL TRDP_ERR_T tau_getOpTrnDirectoryStatusInfo (
     {
         return TRDP_PARAM_ERR;
     }
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
     *pOpTrnDirStatusInfo = appHandle->pTTDB->opTrnState;
+    (void) vos_mutexUnlock(appHandle->mutex);
     return TRDP_NO_ERR;
 }
 
@@ -774,20 +2037,30 @@ EXT_DECL TRDP_ERR_T tau_getTrDirectory (
     TRDP_APP_SESSION_T  appHandle,
     TRDP_TRAIN_DIR_T    *pTrnDir)
 {
+    TRDP_ERR_T err = TRDP_NO_ERR;
+
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL ||
         pTrnDir == NULL)
     {
         return TRDP_PARAM_ERR;
     }
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
     if (appHandle->pTTDB->trnDir.cstCnt == 0 ||
-        appHandle->pTTDB->trnDir.trnTopoCnt != appHandle->etbTopoCnt)     /* need update? */
+        appHandle->pTTDB->trnDirEtbTopoCnt != appHandle->etbTopoCnt)     /* need update? */
     {
-        ttiRequestTTDBdata(appHandle, TTDB_TRN_DIR_REQ_COMID, NULL);
-        return TRDP_NODATA_ERR;
+        ttiDemandTTDBdata(appHandle, TTDB_TRN_DIR_REQ_COMID, NULL);
+        err = TRDP_NODATA_ERR;
     }
-    *pTrnDir = appHandle->pTTDB->trnDir;
-    return TRDP_NO_ERR;
+    else
+    {
+        *pTrnDir = appHandle->pTTDB->trnDir;
+    }
+    (void) vos_mutexUnlock(appHandle->mutex);
+    return err;
 }
 
 
@@ -796,11 +2069,13 @@ EXT_DECL TRDP_ERR_T tau_getTrDirectory (
  *
  *
  *  @param[in]      appHandle       Handle returned by tlc_openSession().
- *  @param[out]     pCstInfo        Pointer to a consist info structure to be returned.
- *  @param[in]      cstUUID         UUID of the consist the consist info is rquested for.
+ *  @param[out]     pCstInfo        Pointer to a consist info structure to be returned (host byte order).
+ *                                  The lists point into the cache and stay valid until the consist info changes.
+ *  @param[in]      cstUUID         UUID of the consist the consist info is rquested for. NULL means own consist.
  *
  *  @retval         TRDP_NO_ERR     no error
  *  @retval         TRDP_PARAM_ERR  Parameter error
+ *  @retval         TRDP_NODATA_ERR Try later
  *
  */
 EXT_DECL TRDP_ERR_T tau_getStaticCstInfo (
@@ -808,41 +2083,39 @@ EXT_DECL TRDP_ERR_T tau_getStaticCstInfo (
     TRDP_CONSIST_INFO_T *pCstInfo,
     TRDP_UUID_T const   cstUUID)
 {
-    UINT32 l_index;
+    const TAU_TTI_CST_T *pCst;
+    TRDP_ERR_T          err = TRDP_NODATA_ERR;
+
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL ||
         pCstInfo == NULL)
     {
         return TRDP_PARAM_ERR;
     }
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
 
     if (cstUUID == NULL)
     {
-        l_index = 0;
+        pCst = ttiFindCst(appHandle, NULL);
     }
     else
     {
-        /* find the consist in our cache list */
-        for (l_index = 0; l_index < TTI_CACHED_CONSISTS; l_index++)
+        pCst = ttiCstByUUID(appHandle->pTTDB, cstUUID);
+        if (pCst == NULL)   /* not found, get it and return directly */
         {
-            if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-                memcmp(appHandle->pTTDB->cstInfo[l_index]->cstUUID, cstUUID, sizeof(TRDP_UUID_T)) == 0)
-            {
-                break;
-            }
+            ttiDemandTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, cstUUID);
         }
     }
-    if (l_index < TTI_CACHED_CONSISTS &&
-        appHandle->pTTDB->cstInfo[l_index] != NULL)
-    {
-        memcpy(pCstInfo, appHandle->pTTDB->cstInfo[l_index], appHandle->pTTDB->cstSize[l_index]);
-    }
-    else    /* not found, get it and return directly */
+    if (pCst != NULL)
     {
-        ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, cstUUID);
-        return TRDP_NODATA_ERR;
+        *pCstInfo   = pCst->cstInfo;
+        err         = TRDP_NO_ERR;
     }
-    return TRDP_NO_ERR;
+    (void) vos_mutexUnlock(appHandle->mutex);
+    return err;
 }
 
 
@@ -872,6 +2145,10 @@ EXT_DECL TRDP_ERR_T tau_getTTI (
     {
         return TRDP_PARAM_ERR;
     }
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
 
     if (pOpTrnDirState != NULL)
     {
@@ -889,6 +2166,7 @@ EXT_DECL TRDP_ERR_T tau_getTTI (
     {
         *pTrnNetDir = appHandle->pTTDB->trnNetDir;
     }
+    (void) vos_mutexUnlock(appHandle->mutex);
     return TRDP_NO_ERR;
 }
 
@@ -909,21 +2187,30 @@ EXT_DECL TRDP_ERR_T tau_getTrnCstCnt (
     TRDP_APP_SESSION_T  appHandle,
     UINT16              *pTrnCstCnt)
 {
+    TRDP_ERR_T err = TRDP_NO_ERR;
+
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL ||
         pTrnCstCnt == NULL)
     {
         return TRDP_PARAM_ERR;
     }
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
     if (appHandle->pTTDB->trnDir.cstCnt == 0 ||
-        appHandle->pTTDB->opTrnState.etbTopoCnt != appHandle->etbTopoCnt)     /* need update? */
+        appHandle->pTTDB->trnDirEtbTopoCnt != appHandle->etbTopoCnt)     /* need update? */
     {
-        ttiRequestTTDBdata(appHandle, TTDB_TRN_DIR_REQ_COMID, NULL);
-        return TRDP_NODATA_ERR;
+        ttiDemandTTDBdata(appHandle, TTDB_TRN_DIR_REQ_COMID, NULL);
+        err = TRDP_NODATA_ERR;
     }
-
-    *pTrnCstCnt = appHandle->pTTDB->trnDir.cstCnt;
-    return TRDP_NO_ERR;
+    else
+    {
+        *pTrnCstCnt = appHandle->pTTDB->trnDir.cstCnt;
+    }
+    (void) vos_mutexUnlock(appHandle->mutex);
+    return err;
 }
 
 
@@ -943,22 +2230,30 @@ EXT_DECL TRDP_ERR_T tau_getTrnVehCnt (
     TRDP_APP_SESSION_T  appHandle,
     UINT16              *pTrnVehCnt)
 {
+    TRDP_ERR_T err = TRDP_NO_ERR;
+
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL ||
         pTrnVehCnt == NULL)
     {
         return TRDP_PARAM_ERR;
     }
-
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
     if (appHandle->pTTDB->trnDir.cstCnt == 0 ||
-        appHandle->pTTDB->opTrnState.etbTopoCnt != appHandle->etbTopoCnt)     /* need update? */
+        appHandle->pTTDB->trnDirEtbTopoCnt != appHandle->etbTopoCnt)     /* need update? */
     {
-        ttiRequestTTDBdata(appHandle, TTDB_TRN_DIR_REQ_COMID, NULL);
-        return TRDP_NODATA_ERR;
+        ttiDemandTTDBdata(appHandle, TTDB_TRN_DIR_REQ_COMID, NULL);
+        err = TRDP_NODATA_ERR;
     }
-
-    *pTrnVehCnt = appHandle->pTTDB->opTrnDir.opVehCnt;
-    return TRDP_NO_ERR;
+    else
+    {
+        *pTrnVehCnt = appHandle->pTTDB->opTrnDir.opVehCnt;
+    }
+    (void) vos_mutexUnlock(appHandle->mutex);
+    return err;
 }
 
 
@@ -980,42 +2275,27 @@ EXT_DECL TRDP_ERR_T tau_getCstVehCnt (
     UINT16              *pCstVehCnt,
     const TRDP_LABEL_T  pCstLabel)
 {
-    UINT32 l_index;
+    const TAU_TTI_CST_T *pCst;
+    TRDP_ERR_T          err = TRDP_NODATA_ERR;
+
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL ||
         pCstVehCnt == NULL)
     {
         return TRDP_PARAM_ERR;
     }
-
-    if (pCstLabel == NULL)
-    {
-        l_index = 0;
-    }
-    else
-    {
-        /* find the consist in our cache list */
-        for (l_index = 0; l_index < TTI_CACHED_CONSISTS; l_index++)
-        {
-            if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-                vos_strnicmp(appHandle->pTTDB->cstInfo[l_index]->cstId, pCstLabel, sizeof(TRDP_NET_LABEL_T)) == 0)
-            {
-                break;
-            }
-        }
-    }
-    if (l_index < TTI_CACHED_CONSISTS)
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
     {
-        *pCstVehCnt = vos_ntohs(appHandle->pTTDB->cstInfo[l_index]->vehCnt);
+        return TRDP_MUTEX_ERR;
     }
-    else    /* not found, get it and return directly */
+    pCst = ttiFindCst(appHandle, pCstLabel);
+    if (pCst != NULL)
     {
-        TRDP_UUID_T cstUUID;
-        ttiGetUUIDfromLabel(appHandle, cstUUID, pCstLabel);
-        ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, cstUUID);
-        return TRDP_NODATA_ERR;
+        *pCstVehCnt = pCst->cstInfo.vehCnt;
+        err         = TRDP_NO_ERR;
     }
-    return TRDP_NO_ERR;
+    (void) vos_mutexUnlock(appHandle->mutex);
+    return err;
 }
 
 
@@ -1029,6 +2309,7 @@ EXT_DECL TRDP_ERR_T tau_getCstVehCnt (
  *
  *  @retval         TRDP_NO_ERR     no error
  *  @retval         TRDP_PARAM_ERR  Parameter error
+ *  @retval         TRDP_NODATA_ERR Try again
  *
  */
 EXT_DECL TRDP_ERR_T tau_getCstFctCnt (
@@ -1036,42 +2317,27 @@ EXT_DECL TRDP_ERR_T tau_getCstFctCnt (
     UINT16              *pCstFctCnt,
     const TRDP_LABEL_T  pCstLabel)
 {
-    UINT32 l_index;
+    const TAU_TTI_CST_T *pCst;
+    TRDP_ERR_T          err = TRDP_NODATA_ERR;
+
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL ||
         pCstFctCnt == NULL)
     {
         return TRDP_PARAM_ERR;
     }
-
-    if (pCstLabel == NULL)
-    {
-        l_index = 0;
-    }
-    else
-    {
-        /* find the consist in our cache list */
-        for (l_index = 0; l_index < TTI_CACHED_CONSISTS; l_index++)
-        {
-            if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-                vos_strnicmp(appHandle->pTTDB->cstInfo[l_index]->cstId, pCstLabel, sizeof(TRDP_NET_LABEL_T)) == 0)
-            {
-                break;
-            }
-        }
-    }
-    if (l_index < TTI_CACHED_CONSISTS)
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
     {
-        *pCstFctCnt = vos_ntohs(appHandle->pTTDB->cstInfo[l_index]->fctCnt);
+        return TRDP_MUTEX_ERR;
     }
-    else    /* not found, get it and return directly */
+    pCst = ttiFindCst(appHandle, pCstLabel);
+    if (pCst != NULL)
     {
-        TRDP_UUID_T cstUUID;
-        ttiGetUUIDfromLabel(appHandle, cstUUID, pCstLabel);
-        ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, cstUUID);
-        return TRDP_NODATA_ERR;
+        *pCstFctCnt = pCst->cstInfo.fctCnt;
+        err         = TRDP_NO_ERR;
     }
-    return TRDP_NO_ERR;
+    (void) vos_mutexUnlock(appHandle->mutex);
+    return err;
 }
 
 
@@ -1089,6 +2355,7 @@ EXT_DECL TRDP_ERR_T tau_getCstFctCnt (
  *
  *  @retval         TRDP_NO_ERR     no error
  *  @retval         TRDP_PARAM_ERR  Parameter error
+ *  @retval         TRDP_NODATA_ERR Try again
  *
  */
 EXT_DECL TRDP_ERR_T tau_getCstFctInfo (
@@ -1097,7 +2364,9 @@ EXT_DECL TRDP_ERR_T tau_getCstFctInfo (
     const TRDP_LABEL_T      pCstLabel,
     UINT16                  maxFctCnt)
 {
-    UINT32 l_index, l_index2;
+    const TAU_TTI_CST_T *pCst;
+    TRDP_ERR_T          err = TRDP_NODATA_ERR;
+
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL ||
         pFctInfo == NULL ||
@@ -1105,40 +2374,23 @@ EXT_DECL TRDP_ERR_T tau_getCstFctInfo (
     {
         return TRDP_PARAM_ERR;
     }
-
-    if (pCstLabel == NULL)
-    {
-        l_index = 0;
-    }
-    else
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
     {
-        /* find the consist in our cache list */
-        for (l_index = 0; l_index < TTI_CACHED_CONSISTS; l_index++)
-        {
-            if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-                vos_strnicmp(appHandle->pTTDB->cstInfo[l_index]->cstId, pCstLabel, sizeof(TRDP_NET_LABEL_T)) == 0)
-            {
-                break;
-            }
-        }
+        return TRDP_MUTEX_ERR;
     }
-    if (l_index < TTI_CACHED_CONSISTS)
+    pCst = ttiFindCst(appHandle, pCstLabel);
+    if (pCst != NULL)
     {
-        for (l_index2 = 0; l_index2 < vos_ntohs(appHandle->pTTDB->cstInfo[l_index]->fctCnt) &&
-             l_index2 < maxFctCnt; ++l_index2)
+        if (pCst->cstInfo.fctCnt > 0u)
         {
-            pFctInfo[l_index2]        = appHandle->pTTDB->cstInfo[l_index]->pFctInfoList[l_index2];
-            pFctInfo[l_index2].fctId  = vos_ntohs(pFctInfo[l_index2].fctId);
+            memcpy(pFctInfo, pCst->cstInfo.pFctInfoList,
+                   ((pCst->cstInfo.fctCnt < maxFctCnt) ? pCst->cstInfo.fctCnt : maxFctCnt) *
+                   sizeof(TRDP_FUNCTION_INFO_T));
         }
+        err = TRDP_NO_ERR;
     }
-    else    /* not found, get it and return directly */
-    {
-        TRDP_UUID_T cstUUID;
-        ttiGetUUIDfromLabel(appHandle, cstUUID, pCstLabel);
-        ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, cstUUID);
-        return TRDP_NODATA_ERR;
-    }
-    return TRDP_NO_ERR;
+    (void) vos_mutexUnlock(appHandle->mutex);
+    return err;
 }
 
 
@@ -1152,7 +2404,8 @@ EXT_DECL TRDP_ERR_T tau_getCstFctInfo (
  *  @param[in]      pCstLabel       Pointer to a consist label. NULL means own consist.
  *
  *  @retval         TRDP_NO_ERR     no error
- *  @retval         TRDP_PARAM_ERR  Parameter error
+ *  @retval         TRDP_PARAM_ERR  Parameter error, vehicle not part of the consist
+ *  @retval         TRDP_NODATA_ERR Try again
  *
  */
 EXT_DECL TRDP_ERR_T tau_getVehInfo (
@@ -1161,50 +2414,43 @@ EXT_DECL TRDP_ERR_T tau_getVehInfo (
     const TRDP_LABEL_T  pVehLabel,
     const TRDP_LABEL_T  pCstLabel)
 {
-    UINT32 l_index, l_index2;
+    const TAU_TTI_CST_T         *pCst;
+    const TRDP_VEHICLE_INFO_T   *pVeh;
+    TRDP_ERR_T                  err = TRDP_NODATA_ERR;
+
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL ||
         pVehInfo == NULL)
     {
         return TRDP_PARAM_ERR;
     }
-
-    if (pCstLabel == NULL)
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
     {
-        l_index = 0;
+        return TRDP_MUTEX_ERR;
     }
-    else
+    pCst = ttiFindCst(appHandle, pCstLabel);
+    if (pCst != NULL)
     {
-        /* find the consist in our cache list */
-        for (l_index = 0; l_index < TTI_CACHED_CONSISTS; l_index++)
+        if (pVehLabel == NULL)
         {
-            if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-                vos_strnicmp(appHandle->pTTDB->cstInfo[l_index]->cstId, pCstLabel, sizeof(TRDP_NET_LABEL_T)) == 0)
-            {
-                break;
-            }
+            pVeh = ttiOwnVeh(appHandle, pCst);
         }
-    }
-    if (l_index < TTI_CACHED_CONSISTS)
-    {
-        for (l_index2 = 0; l_index2 < vos_ntohs(appHandle->pTTDB->cstInfo[l_index]->vehCnt); ++l_index2)
+        else
         {
-            if (pVehLabel == NULL ||
-                vos_strnicmp(pVehLabel, appHandle->pTTDB->cstInfo[l_index]->pVehInfoList[l_index2].vehId,
-                             sizeof(TRDP_NET_LABEL_T)) == 0)
-            {
-                *pVehInfo = appHandle->pTTDB->cstInfo[l_index]->pVehInfoList[l_index2];
-            }
+            pVeh = ttiVehByLabel(appHandle->pTTDB, pCst, pVehLabel);
+        }
+        if (pVeh != NULL)
+        {
+            *pVehInfo   = *pVeh;
+            err         = TRDP_NO_ERR;
+        }
+        else
+        {
+            err = TRDP_PARAM_ERR;
         }
     }
-    else    /* not found, get it and return directly */
-    {
-        TRDP_UUID_T cstUUID;
-        ttiGetUUIDfromLabel(appHandle, cstUUID, pCstLabel);
-        ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, cstUUID);
-        return TRDP_NODATA_ERR;
-    }
-    return TRDP_NO_ERR;
+    (void) vos_mutexUnlock(appHandle->mutex);
+    return err;
 }
 
 
@@ -1213,11 +2459,13 @@ EXT_DECL TRDP_ERR_T tau_getVehInfo (
  *
  *
  *  @param[in]      appHandle       Handle returned by tlc_openSession().
- *  @param[out]     pCstInfo        Pointer to the consist info to be returned.
+ *  @param[out]     pCstInfo        Pointer to the consist info to be returned (host byte order).
+ *                                  The lists point into the cache and stay valid until the consist info changes.
  *  @param[in]      pCstLabel       Pointer to a consist label. NULL means own consist.
  *
  *  @retval         TRDP_NO_ERR     no error
  *  @retval         TRDP_PARAM_ERR  Parameter error
+ *  @retval         TRDP_NODATA_ERR Try again
  *
  */
 EXT_DECL TRDP_ERR_T tau_getCstInfo (
@@ -1225,45 +2473,27 @@ EXT_DECL TRDP_ERR_T tau_getCstInfo (
     TRDP_CONSIST_INFO_T *pCstInfo,
     const TRDP_LABEL_T  pCstLabel)
 {
-    UINT32 l_index;
+    const TAU_TTI_CST_T *pCst;
+    TRDP_ERR_T          err = TRDP_NODATA_ERR;
+
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL ||
         pCstInfo == NULL)
     {
         return TRDP_PARAM_ERR;
     }
-
-    if (pCstLabel == NULL)
-    {
-        l_index = 0;
-    }
-    else
-    {
-        /* find the consist in our cache list */
-        for (l_index = 0; l_index < TTI_CACHED_CONSISTS; l_index++)
-        {
-            if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-                vos_strnicmp(appHandle->pTTDB->cstInfo[l_index]->cstId, pCstLabel, sizeof(TRDP_NET_LABEL_T)) == 0)
-            {
-                break;
-            }
-        }
-    }
-    if (l_index < TTI_CACHED_CONSISTS)
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
     {
-        *pCstInfo           = *appHandle->pTTDB->cstInfo[l_index];
-        pCstInfo->etbCnt    = vos_ntohs(pCstInfo->etbCnt);
-        pCstInfo->vehCnt    = vos_ntohs(pCstInfo->vehCnt);
-        pCstInfo->fctCnt    = vos_ntohs(pCstInfo->fctCnt);
+        return TRDP_MUTEX_ERR;
     }
-    else    /* not found, get it and return directly */
+    pCst = ttiFindCst(appHandle, pCstLabel);
+    if (pCst != NULL)
     {
-        TRDP_UUID_T cstUUID;
-        ttiGetUUIDfromLabel(appHandle, cstUUID, pCstLabel);
-        ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, cstUUID);
-        return TRDP_NODATA_ERR;
+        *pCstInfo   = pCst->cstInfo;
+        err         = TRDP_NO_ERR;
     }
-    return TRDP_NO_ERR;
+    (void) vos_mutexUnlock(appHandle->mutex);
+    return err;
 }
 
 
@@ -1282,11 +2512,13 @@ EXT_DECL TRDP_ERR_T tau_getCstInfo (
  *                                   '00'B = not known (corrected vehicle)
  *                                   '01'B = same as operational train direction
  *                                   '10'B = inverse to operational train direction
- *  @param[in]      pVehLabel       vehLabel = NULL means own vehicle if cstLabel == NULL, currently ignored.
+ *  @param[in]      pVehLabel       vehLabel = NULL means own vehicle if cstLabel == NULL,
+ *                                  first vehicle of the consist otherwise.
  *  @param[in]      pCstLabel       cstLabel = NULL means own consist
  *
  *  @retval         TRDP_NO_ERR     no error
  *  @retval         TRDP_PARAM_ERR  Parameter error
+ *  @retval         TRDP_NODATA_ERR Try again
  *
  */
 EXT_DECL TRDP_ERR_T tau_getVehOrient (
@@ -1296,7 +2528,11 @@ EXT_DECL TRDP_ERR_T tau_getVehOrient (
     TRDP_LABEL_T        pVehLabel,
     TRDP_LABEL_T        pCstLabel)
 {
-    UINT32 l_index, l_index2, l_index3;
+    const TAU_TTI_CST_T     *pCst;
+    const TRDP_OP_CONSIST_T *pOpCst;
+    const TRDP_OP_VEHICLE_T *pOpVeh = NULL;
+    TAU_TTDB_T              *pTTDB;
+    TRDP_ERR_T              err = TRDP_NODATA_ERR;
 
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL ||
@@ -1306,59 +2542,49 @@ EXT_DECL TRDP_ERR_T tau_getVehOrient (
         return TRDP_PARAM_ERR;
     }
 
-    pVehLabel = pVehLabel;
-
     *pVehOrient = 0;
     *pCstOrient = 0;
 
-    if (pCstLabel == NULL)
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
     {
-        l_index = 0;
+        return TRDP_MUTEX_ERR;
     }
-    else
+    pTTDB   = appHandle->pTTDB;
+    pCst    = ttiFindCst(appHandle, pCstLabel);
+    if (pCst != NULL)
     {
-        /* find the consist in our cache list */
-        for (l_index = 0; l_index < TTI_CACHED_CONSISTS; l_index++)
+        err     = TRDP_NO_ERR;
+        pOpCst  = ttiOpCstByUUID(pTTDB, pCst->cstInfo.cstUUID);
+        if (pOpCst != NULL)
         {
-            if (appHandle->pTTDB->cstInfo[l_index] != NULL &&
-                vos_strnicmp(appHandle->pTTDB->cstInfo[l_index]->cstId, pCstLabel, sizeof(TRDP_NET_LABEL_T)) == 0)
-            {
-                break;
-            }
-        }
-    }
-    if (l_index < TTI_CACHED_CONSISTS)
-    {
-        /* Search the vehicles in the OP_TRAIN_DIR for a matching vehID */
+            /* consist found   */
+            *pCstOrient = pOpCst->opCstOrient;
 
-        for (l_index2 = 0; l_index2 < appHandle->pTTDB->opTrnDir.opCstCnt; l_index2++)
-        {
-            if (vos_strnicmp((CHAR8 *) appHandle->pTTDB->opTrnDir.opCstList[l_index2].cstUUID,
-                             (CHAR8 *) appHandle->pTTDB->cstInfo[l_index]->cstUUID, sizeof(TRDP_UUID_T)) == 0)
+            if ((pVehLabel == NULL) && (pCstLabel == NULL))
             {
-                /* consist found   */
-                *pCstOrient = appHandle->pTTDB->opTrnDir.opCstList[l_index2].opCstOrient;
+                const TRDP_VEHICLE_INFO_T *pVeh = ttiOwnVeh(appHandle, pCst);
 
-                for (l_index3 = 0; l_index3 < appHandle->pTTDB->opTrnDir.opVehCnt; l_index3++)
+                if (pVeh != NULL)
                 {
-                    if (appHandle->pTTDB->opTrnDir.opVehList[l_index3].ownOpCstNo ==
-                        appHandle->pTTDB->opTrnDir.opCstList[l_index2].opCstNo)
-                    {
-                        *pVehOrient = appHandle->pTTDB->opTrnDir.opVehList[l_index3].vehOrient;
-                        return TRDP_NO_ERR;
-                    }
+                    pOpVeh = ttiOpVehByLabel(pTTDB, pVeh->vehId);
                 }
             }
+            else if (pVehLabel != NULL)
+            {
+                pOpVeh = ttiOpVehByLabel(pTTDB, pVehLabel);
+            }
+            else if ((pOpCst->opCstNo <= TRDP_MAX_CST_CNT) && (pTTDB->opVehByCstNo[pOpCst->opCstNo] != 0u))
+            {
+                pOpVeh = &pTTDB->opTrnDir.opVehList[pTTDB->opVehByCstNo[pOpCst->opCstNo] - 1u];
+            }
+            if ((pOpVeh != NULL) && (pOpVeh->ownOpCstNo == pOpCst->opCstNo))
+            {
+                *pVehOrient = pOpVeh->vehOrient;
+            }
         }
     }
-    else    /* not found, get it and return directly */
-    {
-        TRDP_UUID_T cstUUID;
-        ttiGetUUIDfromLabel(appHandle, cstUUID, pCstLabel);
-        ttiRequestTTDBdata(appHandle, TTDB_STAT_CST_REQ_COMID, cstUUID);
-        return TRDP_NODATA_ERR;
-    }
-    return TRDP_NO_ERR;
+    (void) vos_mutexUnlock(appHandle->mutex);
+    return err;
 }
 
 /**********************************************************************************************************************/
@@ -1382,62 +2608,58 @@ EXT_DECL TRDP_ERR_T tau_getOwnIds (
     TRDP_LABEL_T        *pVehId,
     TRDP_LABEL_T        *pCstId)
 {
+    const TAU_TTI_CST_T         *pCst;
+    const TRDP_FUNCTION_INFO_T  *pFct;
+    TRDP_ERR_T                  err = TRDP_NODATA_ERR;
+
     if (appHandle == NULL ||
         appHandle->pTTDB == NULL)
     {
         return TRDP_PARAM_ERR;
     }
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_MUTEX_ERR;
+    }
     /* if not already there, get the network directory */
     if ((appHandle->pTTDB->trnNetDir.entryCnt == 0) ||
         (appHandle->pTTDB->opTrnState.ownTrnCstNo == 0))            /* from PD 100  */
     {    /* not found, get it and return immediately */
-        ttiRequestTTDBdata(appHandle, TTDB_NET_DIR_REQ_COMID, NULL);
-       return TRDP_NODATA_ERR;
-    }
-
-    /* if not already there, get the consist info for our consist */
-    if (appHandle->pTTDB->noOfCachedCst == 0)                 /* own Consist info  */
-    {    /* not found, get it and return immediately */
-        ttiRequestTTDBdata(appHandle, TRDP_TTDB_STATIC_CST_INF_REQ_COMID,
-                           appHandle->pTTDB->trnNetDir.trnNetDir[appHandle->pTTDB->opTrnState.ownTrnCstNo - 1].cstUUID);
+        ttiDemandTTDBdata(appHandle, TTDB_NET_DIR_REQ_COMID, NULL);
+        (void) vos_mutexUnlock(appHandle->mutex);
         return TRDP_NODATA_ERR;
     }
 
-    /* here we should have all the infos we need to fullfill the request */
-
-    if (pDevId != NULL)
+    /* if not already there, get the consist info for our consist */
+    pCst = ttiFindCst(appHandle, NULL);
+    if (pCst != NULL)
     {
-        unsigned int index;
-        /* deduct our device / function ID from our IP address */
-        UINT16  ownIP = (UINT16) (appHandle->realIP & 0x00000FFF);
-        /* Problem: What if it is not set? Default interface is 0! */
-
-        /* we traverse the consist info's functions */
-        for (index = 0; index < appHandle->pTTDB->cstInfo[0]->fctCnt; index++)
+        /* here we should have all the infos we need to fullfill the request */
+        pFct = ttiOwnFct(appHandle, pCst);
+        if (pFct != NULL)
         {
-            if (ownIP == appHandle->pTTDB->cstInfo[0]->pFctInfoList[index].fctId)
+            /* Get the name */
+            if (pDevId != NULL)
             {
-                /* Get the name */
-                if (pDevId != NULL)
-                {
-                    memcpy(pDevId, appHandle->pTTDB->cstInfo[0]->pFctInfoList[index].fctName, TRDP_MAX_LABEL_LEN);
-                }
+                memcpy(pDevId, pFct->fctName, TRDP_MAX_LABEL_LEN);
+                (*pDevId)[TRDP_MAX_LABEL_LEN] = '\0';
+            }
 
-                /* Get the vehicle name this device is in */
-                if (pVehId != NULL)
-                {
-                    UINT8 vehNo = appHandle->pTTDB->cstInfo[0]->pFctInfoList[index].cstVehNo;
-                    memcpy(pVehId, appHandle->pTTDB->cstInfo[0]->pVehInfoList[vehNo].vehId, TRDP_MAX_LABEL_LEN);
-                }
-                break;
+            /* Get the vehicle name this device is in */
+            if ((pVehId != NULL) && (pFct->cstVehNo > 0u) && (pFct->cstVehNo <= pCst->cstInfo.vehCnt))
+            {
+                memcpy(pVehId, pCst->cstInfo.pVehInfoList[pFct->cstVehNo - 1u].vehId, TRDP_MAX_LABEL_LEN);
+                (*pVehId)[TRDP_MAX_LABEL_LEN] = '\0';
             }
         }
+        /* Get the consist label (UIC identifier) */
+        if (pCstId != NULL)
+        {
+            memcpy(pCstId, pCst->cstInfo.cstId, TRDP_MAX_LABEL_LEN);
+            (*pCstId)[TRDP_MAX_LABEL_LEN] = '\0';
+        }
+        err = TRDP_NO_ERR;
     }
-    /* Get the consist label (UIC identifier) */
-    if (pCstId != NULL)
-    {
-        memcpy(pCstId, appHandle->pTTDB->cstInfo[0]->cstId, TRDP_MAX_LABEL_LEN);
-    }
-    return TRDP_NO_ERR;
+    (void) vos_mutexUnlock(appHandle->mutex);
+    return err;
 }
-
@@ -16,6 +16,7 @@
  *
  * $Id: tau_xml.c 1770 2018-10-29 10:49:08Z s-bender $
  *
+ *      AG 2026-10-19: Telegrams, datasets and parameter lists are read in one pass into growing arrays
  *      SB 2018-10-29: Ticket #214 Incorrect parsing of <source> and <destination> elements
  *      BL 2018-10-01: Some default attribute values for com-parameter tag were missing
  *      BL 2018-09-05: Ticket #211 XML handling: Dataset Name should be stored in TRDP_DATASET_ELEMENT_T
@@ -37,6 +38,7 @@
 /*******************************************************************************
  * INCLUDES
  */
+#include <stddef.h>
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -193,6 +195,7 @@ static void setDefaultInterfaceValues (
         pMdConfig->tcpPort              = TRDP_MD_TCP_PORT;
         pMdConfig->udpPort              = TRDP_MD_UDP_PORT;
         pMdConfig->maxNumSessions       = TRDP_MD_MAX_NUM_SESSIONS;
+        pMdConfig->maxTcpPipeline       = TRDP_MD_DEFAULT_TCP_PIPELINE;
     }
 }
 
@@ -242,17 +245,88 @@ static void dbgPrint (UINT32 num, TRDP_EXCHG_PAR_T *pArray)
 }
 #endif
 
+/*
+ * Append a zeroed item to an array allocated from an arena, the capacity is doubled when the array is full.
+ * headSize bytes in front of the items are kept, e.g. the dataset in front of its elements.
+ */
+static void *appendArenaItem (
+    XML_ARENA_T *pArena,
+    BOOL8       isRoot,
+    void        * *ppArray,
+    UINT32      headSize,
+    UINT32      itemSize,
+    UINT32      *pCount,
+    UINT32      *pCapacity)
+{
+    if (*pCount == *pCapacity)
+    {
+        UINT32  capacity    = (*pCapacity == 0u) ? 1u : 2u * *pCapacity;
+        UINT32  oldSize     = (*ppArray == NULL) ? 0u : headSize + *pCapacity * itemSize;
+        void    *pArray;
+
+        if (isRoot)
+        {
+            pArray = trdp_XMLArenaGrowRoot(pArena, *ppArray, oldSize, headSize + capacity * itemSize);
+        }
+        else
+        {
+            pArray = trdp_XMLArenaGrow(pArena, *ppArray, oldSize, headSize + capacity * itemSize);
+        }
+        if (pArray == NULL)
+        {
+            vos_printLog(VOS_LOG_ERROR, "%lu Bytes failed to allocate while reading XML configuration!\n",
+                         (unsigned long) (headSize + capacity * itemSize));
+            return NULL;
+        }
+        *ppArray    = pArray;
+        *pCapacity  = capacity;
+    }
+    return (UINT8 *) *ppArray + headSize + (*pCount)++ * itemSize;
+}
+
+/*
+ * Append a zeroed item to an array allocated by vos_memAlloc, the capacity is doubled when the array is full.
+ */
+static void *appendMemItem (
+    void    * *ppArray,
+    UINT32  itemSize,
+    UINT32  *pCount,
+    UINT32  *pCapacity)
+{
+    if (*pCount == *pCapacity)
+    {
+        UINT32  capacity    = (*pCapacity == 0u) ? 1u : 2u * *pCapacity;
+        void    *pArray     = vos_memAlloc(capacity * itemSize);
+
+        if (pArray == NULL)
+        {
+            vos_printLog(VOS_LOG_ERROR, "%lu Bytes failed to allocate while reading XML configuration!\n",
+                         (unsigned long) (capacity * itemSize));
+            return NULL;
+        }
+        if (*ppArray != NULL)
+        {
+            memcpy(pArray, *ppArray, *pCount * itemSize);
+            vos_memFree(*ppArray);
+        }
+        *ppArray    = pArray;
+        *pCapacity  = capacity;
+    }
+    return (UINT8 *) *ppArray + (*pCount)++ * itemSize;
+}
+
 /**********************************************************************************************************************/
 static TRDP_ERR_T readTelegramDef (
     XML_HANDLE_T        *pXML,
+    XML_ARENA_T         *pArena,
     TRDP_EXCHG_PAR_T    *pExchgParam)
 {
     CHAR8       tag[MAX_TAG_LEN];
     CHAR8       attribute[MAX_TOK_LEN];
     CHAR8       value[MAX_TOK_LEN];
     UINT32      valueInt;
-    UINT32      countSrc;
-    UINT32      countDst;
+    UINT32      capacitySrc = 0u;
+    UINT32      capacityDst = 0u;
     TRDP_SRC_T  *pSrc;
     TRDP_DEST_T *pDest;
     XML_TOKEN_T token;
@@ -297,19 +371,13 @@ static TRDP_ERR_T readTelegramDef (
         }
     }
 
-    /* find out how many sources are defined before hand */
-    countSrc    = (UINT32) trdp_XMLCountStartTag(pXML, "source");
-    pSrc        = NULL;
-    countDst    = (UINT32) trdp_XMLCountStartTag(pXML, "destination");
-    pDest       = NULL;
-
     /* Iterate thru <telegram> */
 
     while (trdp_XMLSeekStartTagAny(pXML, tag, MAX_TAG_LEN) == 0)
     {
         if (vos_strnicmp(tag, "md-parameter", MAX_TAG_LEN) == 0)
         {
-            pExchgParam->pMdPar = (TRDP_MD_PAR_T *) vos_memAlloc(sizeof(TRDP_MD_PAR_T));
+            pExchgParam->pMdPar = (TRDP_MD_PAR_T *) trdp_XMLArenaAlloc(pArena, sizeof(TRDP_MD_PAR_T));
 
             if (pExchgParam->pMdPar != NULL)
             {
@@ -364,7 +432,7 @@ static TRDP_ERR_T readTelegramDef (
         }
         else if (vos_strnicmp(tag, "pd-parameter", MAX_TAG_LEN) == 0)
         {
-            pExchgParam->pPdPar = (TRDP_PD_PAR_T *) vos_memAlloc(sizeof(TRDP_PD_PAR_T));
+            pExchgParam->pPdPar = (TRDP_PD_PAR_T *) trdp_XMLArenaAlloc(pArena, sizeof(TRDP_PD_PAR_T));
 
             if (pExchgParam->pPdPar != NULL)
             {
@@ -416,29 +484,21 @@ static TRDP_ERR_T readTelegramDef (
                     }
                     else if (vos_strnicmp(attribute, "offset-address", MAX_TOK_LEN) == 0)
                     {
-                        pExchgParam->pPdPar->offset = (UINT16) valueInt;
+                        pExchgParam->pPdPar->offset = (UINT32) valueInt;
                     }
                 }
             }
         }
         else if (vos_strnicmp(tag, "source", MAX_TAG_LEN) == 0)
         {
-            if (countSrc > 0u)
+            pSrc = (TRDP_SRC_T *) appendArenaItem(pArena, FALSE, (void * *) &pExchgParam->pSrc, 0u,
+                                                  (UINT32) sizeof(TRDP_SRC_T), &pExchgParam->srcCnt, &capacitySrc);
+            if (pSrc == NULL)
             {
-                pExchgParam->pSrc = (TRDP_SRC_T *)vos_memAlloc(countSrc * sizeof(TRDP_SRC_T));
-
-                if (pExchgParam->pSrc == NULL)
-                {
-                    vos_printLog(VOS_LOG_ERROR, "%lu Bytes failed to allocate while reading XML source definitions!\n",
-                                 (unsigned long) (countSrc * sizeof(TRDP_SRC_T)));
-                    return TRDP_MEM_ERR;
-                }
-                pExchgParam->srcCnt = countSrc;
-                countSrc    = 0u;
-                pSrc        = pExchgParam->pSrc;
+                return TRDP_MEM_ERR;
             }
 
-            while ((token = trdp_XMLGetAttribute(pXML, attribute, &valueInt, value)) == TOK_ATTRIBUTE && pSrc != NULL)
+            while ((token = trdp_XMLGetAttribute(pXML, attribute, &valueInt, value)) == TOK_ATTRIBUTE)
             {
                 if (vos_strnicmp(attribute, "id", MAX_TOK_LEN) == 0)
                 {
@@ -449,7 +509,7 @@ static TRDP_ERR_T readTelegramDef (
                     char *p = strchr(value, '@');   /* Get host part only */
                     if (p != NULL)
                     {
-                        pSrc->pUriUser = (TRDP_URI_USER_T *) vos_memAlloc(TRDP_MAX_URI_USER_LEN + 1u);
+                        pSrc->pUriUser = (TRDP_URI_USER_T *) trdp_XMLArenaAlloc(pArena, TRDP_MAX_URI_USER_LEN + 1u);
                         if (pSrc->pUriUser == NULL)
                         {
                             vos_printLog(VOS_LOG_ERROR,
@@ -457,7 +517,8 @@ static TRDP_ERR_T readTelegramDef (
                                          (unsigned int) (TRDP_MAX_URI_USER_LEN + 1u));
                             return TRDP_MEM_ERR;
                         }
-                        memcpy(pSrc->pUriUser, p, p - value);  /* Trailing zero by vos_memAlloc    */
+                        memcpy(pSrc->pUriUser, value, ((p - value) < (ptrdiff_t) TRDP_MAX_URI_USER_LEN) ?
+                               (size_t) (p - value) : TRDP_MAX_URI_USER_LEN);  /* Trailing zero by the arena */
                         p++;
                     }
                     else
@@ -465,7 +526,7 @@ static TRDP_ERR_T readTelegramDef (
                         p = value;
                     }
 
-                    pSrc->pUriHost1 = (TRDP_URI_HOST_T *) vos_memAlloc((UINT32)strlen(p) + 1u);
+                    pSrc->pUriHost1 = (TRDP_URI_HOST_T *) trdp_XMLArenaStrDup(pArena, p);
                     if (pSrc->pUriHost1 == NULL)
                     {
                         vos_printLog(VOS_LOG_ERROR,
@@ -473,14 +534,13 @@ static TRDP_ERR_T readTelegramDef (
                                      (unsigned long) (strlen(p) + 1u));
                         return TRDP_MEM_ERR;
                     }
-                    vos_strncpy((char *)pSrc->pUriHost1, p, (UINT32) strlen(p) + 1u);
                 }
                 else if (vos_strnicmp(attribute, "uri2", MAX_TOK_LEN) == 0)
                 {
                     char *p = strchr(value, '@');   /* Get host part only */
                     p = (p == NULL) ? value : p + 1;
 
-                    pSrc->pUriHost2 = (TRDP_URI_HOST_T *) vos_memAlloc((UINT32) strlen(p) + 1u);
+                    pSrc->pUriHost2 = (TRDP_URI_HOST_T *) trdp_XMLArenaStrDup(pArena, p);
                     if (pSrc->pUriHost2 == NULL)
                     {
                         vos_printLog(VOS_LOG_ERROR,
@@ -488,7 +548,6 @@ static TRDP_ERR_T readTelegramDef (
                                      (unsigned long) (strlen(p) + 1u));
                         return TRDP_MEM_ERR;
                     }
-                    vos_strncpy((char *)pSrc->pUriHost2, p, (UINT32)  strlen(p) + 1u);
                 }
             }
             if (token == TOK_CLOSE_EMPTY || token == TOK_CLOSE)
@@ -496,11 +555,9 @@ static TRDP_ERR_T readTelegramDef (
             else
             {
                 trdp_XMLEnter(pXML);
-                if (trdp_XMLCountStartTag(pXML, "sdt-parameter") > 0 &&
-                    trdp_XMLSeekStartTag(pXML, "sdt-parameter") == 0 &&
-                    pSrc != NULL)
+                if (trdp_XMLSeekStartTag(pXML, "sdt-parameter") == 0)
                 {
-                    pSrc->pSdtPar = (TRDP_SDT_PAR_T *)vos_memAlloc(sizeof(TRDP_SDT_PAR_T));
+                    pSrc->pSdtPar = (TRDP_SDT_PAR_T *)trdp_XMLArenaAlloc(pArena, sizeof(TRDP_SDT_PAR_T));
 
                     if (pSrc->pSdtPar == NULL)
                     {
@@ -547,29 +604,17 @@ static TRDP_ERR_T readTelegramDef (
                 }
                 trdp_XMLLeave(pXML);
             }
-            if (pSrc != NULL)
-            {
-                pSrc++;
-            }
         }
         else if (vos_strnicmp(tag, "destination", MAX_TAG_LEN) == 0)
         {
-            if (countDst > 0u)
+            pDest = (TRDP_DEST_T *) appendArenaItem(pArena, FALSE, (void * *) &pExchgParam->pDest, 0u,
+                                                    (UINT32) sizeof(TRDP_DEST_T), &pExchgParam->destCnt, &capacityDst);
+            if (pDest == NULL)
             {
-                pExchgParam->pDest = (TRDP_DEST_T *)vos_memAlloc(countDst * sizeof(TRDP_DEST_T));
-
-                if (pExchgParam->pDest == NULL)
-                {
-                    vos_printLog(VOS_LOG_ERROR, "%lu Bytes failed to allocate while reading XML source definitions!\n",
-                                 (unsigned long) (countDst * sizeof(TRDP_DEST_T)));
-                    return TRDP_MEM_ERR;
-                }
-                pExchgParam->destCnt = countDst;
-                countDst    = 0u;
-                pDest       = pExchgParam->pDest;
+                return TRDP_MEM_ERR;
             }
 
-            while ((token = trdp_XMLGetAttribute(pXML, attribute, &valueInt, value)) == TOK_ATTRIBUTE && pDest != NULL)
+            while ((token = trdp_XMLGetAttribute(pXML, attribute, &valueInt, value)) == TOK_ATTRIBUTE)
             {
                 if (vos_strnicmp(attribute, "id", MAX_TOK_LEN) == 0)
                 {
@@ -580,7 +625,7 @@ static TRDP_ERR_T readTelegramDef (
                     char *p = strchr(value, '@');   /* Get host part only */
                     if (p != NULL)
                     {
-                        pDest->pUriUser = (TRDP_URI_USER_T *) vos_memAlloc(TRDP_MAX_URI_USER_LEN + 1u);
+                        pDest->pUriUser = (TRDP_URI_USER_T *) trdp_XMLArenaAlloc(pArena, TRDP_MAX_URI_USER_LEN + 1u);
                         if (pDest->pUriUser == NULL)
                         {
                             vos_printLog(VOS_LOG_ERROR,
@@ -588,7 +633,8 @@ static TRDP_ERR_T readTelegramDef (
                                          (unsigned int) (TRDP_MAX_URI_USER_LEN + 1));
                             return TRDP_MEM_ERR;
                         }
-                        memcpy(pDest->pUriUser, p, p - value);  /* Trailing zero by vos_memAlloc    */
+                        memcpy(pDest->pUriUser, value, ((p - value) < (ptrdiff_t) TRDP_MAX_URI_USER_LEN) ?
+                               (size_t) (p - value) : TRDP_MAX_URI_USER_LEN);  /* Trailing zero by the arena */
                         p++;
                     }
                     else
@@ -596,7 +642,7 @@ static TRDP_ERR_T readTelegramDef (
                         p = value;
                     }
 
-                    pDest->pUriHost = (TRDP_URI_HOST_T *) vos_memAlloc((UINT32) strlen(p) + 1u);
+                    pDest->pUriHost = (TRDP_URI_HOST_T *) trdp_XMLArenaStrDup(pArena, p);
                     if (pDest->pUriHost == NULL)
                     {
                         vos_printLog(VOS_LOG_ERROR,
@@ -604,7 +650,6 @@ static TRDP_ERR_T readTelegramDef (
                                      (unsigned long) (strlen(p) + 1u));
                         return TRDP_MEM_ERR;
                     }
-                    vos_strncpy((char *)pDest->pUriHost, p, (UINT32) strlen(p) + 1u);
                 }
             }
             if (token == TOK_CLOSE_EMPTY || token == TOK_CLOSE)
@@ -612,11 +657,9 @@ static TRDP_ERR_T readTelegramDef (
             else
             {
                 trdp_XMLEnter(pXML);
-                if (trdp_XMLCountStartTag(pXML, "sdt-parameter") > 0 &&
-                    trdp_XMLSeekStartTag(pXML, "sdt-parameter") == 0 &&
-                    pDest != NULL)
+                if (trdp_XMLSeekStartTag(pXML, "sdt-parameter") == 0)
                 {
-                    pDest->pSdtPar = (TRDP_SDT_PAR_T *)vos_memAlloc(sizeof(TRDP_SDT_PAR_T));
+                    pDest->pSdtPar = (TRDP_SDT_PAR_T *)trdp_XMLArenaAlloc(pArena, sizeof(TRDP_SDT_PAR_T));
 
                     if (pDest->pSdtPar == NULL)
                     {
@@ -663,10 +706,6 @@ static TRDP_ERR_T readTelegramDef (
                 }
                 trdp_XMLLeave(pXML);
             }
-            if (pDest != NULL)
-            {
-                pDest++;
-            }
         }
     }
     return TRDP_NO_ERR;
@@ -676,85 +715,43 @@ static TRDP_ERR_T readTelegramDef (
 static TRDP_ERR_T readXmlDatasetMap (
     XML_HANDLE_T            *pXML,
     UINT32                  *pNumComId,
-    TRDP_COMID_DSID_MAP_T   * *ppComIdDsIdMap)
+    TRDP_COMID_DSID_MAP_T   * *ppComIdDsIdMap,
+    UINT32                  *pCapacity)
 {
     /* CHAR8   tag[MAX_TAG_LEN]; */
     CHAR8   attribute[MAX_TOK_LEN];
     CHAR8   value[MAX_TOK_LEN];
     UINT32  valueInt;
-    UINT32  count   = 0;
-    UINT32  idx     = 0;
-
-    trdp_XMLRewind(pXML);
 
     trdp_XMLEnter(pXML);
 
-    if (trdp_XMLSeekStartTag(pXML, "device") == 0) /* Optional */
+    while (trdp_XMLSeekStartTag(pXML, "bus-interface") == 0)
     {
         trdp_XMLEnter(pXML);
-
-        if (trdp_XMLSeekStartTag(pXML, "bus-interface-list") == 0)
+        while (trdp_XMLSeekStartTag(pXML, "telegram") == 0)
         {
-            trdp_XMLEnter(pXML);
-
-            while (trdp_XMLSeekStartTag(pXML, "bus-interface") == 0)
-            {
-                trdp_XMLEnter(pXML);
-                count += (UINT32) trdp_XMLCountStartTag(pXML, "telegram");
-                trdp_XMLLeave(pXML);
-            }
-            trdp_XMLLeave(pXML);
-        }
+            TRDP_COMID_DSID_MAP_T *pMap;
 
-        if (count > 0u)
-        {
-            *ppComIdDsIdMap = (TRDP_COMID_DSID_MAP_T *) vos_memAlloc(count * sizeof(TRDP_COMID_DSID_MAP_T));
-            if (*ppComIdDsIdMap == NULL)
+            pMap = (TRDP_COMID_DSID_MAP_T *) appendMemItem((void * *) ppComIdDsIdMap,
+                                                           (UINT32) sizeof(TRDP_COMID_DSID_MAP_T),
+                                                           pNumComId, pCapacity);
+            if (pMap == NULL)
             {
-                vos_printLog(VOS_LOG_ERROR, "%lu Bytes failed to allocate while creating XML dataset map!\n",
-                             (unsigned long) (count * sizeof(TRDP_COMID_DSID_MAP_T)));
                 return TRDP_MEM_ERR;
             }
-            *pNumComId = count;
-        }
-    }
-
-    trdp_XMLLeave(pXML);
-
-    trdp_XMLRewind(pXML);
-
-    trdp_XMLEnter(pXML);
-
-    if (trdp_XMLSeekStartTag(pXML, "device") == 0) /* Optional */
-    {
-        trdp_XMLEnter(pXML);
-
-        if (trdp_XMLSeekStartTag(pXML, "bus-interface-list") == 0)
-        {
-            trdp_XMLEnter(pXML);
-
-            while (trdp_XMLSeekStartTag(pXML, "bus-interface") == 0)
+            while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
             {
-                trdp_XMLEnter(pXML);
-                while (trdp_XMLSeekStartTag(pXML, "telegram") == 0)
+                if (vos_strnicmp(attribute, "com-id", MAX_TOK_LEN) == 0)
                 {
-                    while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
-                    {
-                        if (vos_strnicmp(attribute, "com-id", MAX_TOK_LEN) == 0)
-                        {
-                            (*ppComIdDsIdMap)[idx].comId = valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "data-set-id", MAX_TOK_LEN) == 0)
-                        {
-                            (*ppComIdDsIdMap)[idx].datasetId = valueInt;
-                        }
-                    }
-                    idx++;
+                    pMap->comId = valueInt;
+                }
+                else if (vos_strnicmp(attribute, "data-set-id", MAX_TOK_LEN) == 0)
+                {
+                    pMap->datasetId = valueInt;
                 }
-                trdp_XMLLeave(pXML);
             }
-            trdp_XMLLeave(pXML);
         }
+        trdp_XMLLeave(pXML);
     }
     trdp_XMLLeave(pXML);
     return TRDP_NO_ERR;
@@ -764,124 +761,113 @@ static TRDP_ERR_T readXmlDatasetMap (
 /**********************************************************************************************************************/
 static TRDP_ERR_T readXmlDatasets (
     XML_HANDLE_T        *pXML,
+    XML_ARENA_T         * *ppArena,
     UINT32              *pNumDataset,
-    papTRDP_DATASET_T   papDataset)
+    papTRDP_DATASET_T   papDataset,
+    UINT32              *pCapacity)
 {
     /* CHAR8   tag[MAX_TAG_LEN]; */
-    CHAR8   attribute[MAX_TOK_LEN];
-    CHAR8   value[MAX_TOK_LEN];
-    UINT32  valueInt;
-
-    trdp_XMLRewind(pXML);
+    CHAR8       attribute[MAX_TOK_LEN];
+    CHAR8       value[MAX_TOK_LEN];
+    UINT32      valueInt;
+    XML_TOKEN_T token;
 
     trdp_XMLEnter(pXML);
 
-    if (trdp_XMLSeekStartTag(pXML, "device") == 0) /* Optional */
+    /* Read the datasets, all of them are allocated from the arena of the array of pointers */
+    while (trdp_XMLSeekStartTag(pXML, "data-set") == 0)
     {
-        trdp_XMLEnter(pXML);
+        TRDP_DATASET_T  * *ppDataset;
+        TRDP_DATASET_T  *pDataset;
+        UINT32          numElement      = 0u;
+        UINT32          capacityElement = 0u;
 
-        if (trdp_XMLSeekStartTag(pXML, "data-set-list") == 0)
+        if (*ppArena == NULL)
         {
-            UINT32  count = 0;
-            UINT32  idx;
-
-            trdp_XMLEnter(pXML);
-
-            count = (UINT32) trdp_XMLCountStartTag(pXML, "data-set");
+            *ppArena = trdp_XMLArenaCreate();
+        }
+        ppDataset = (TRDP_DATASET_T * *) appendArenaItem(*ppArena, TRUE, (void * *) papDataset, 0u,
+                                                         (UINT32) sizeof(TRDP_DATASET_T *), pNumDataset, pCapacity);
+        if (ppDataset == NULL)
+        {
+            return TRDP_MEM_ERR;
+        }
+        pDataset = (TRDP_DATASET_T *) trdp_XMLArenaAlloc(*ppArena, (UINT32) sizeof(TRDP_DATASET_T));
+        if (pDataset == NULL)
+        {
+            vos_printLog(VOS_LOG_ERROR, "%lu Bytes failed to allocate while reading XML dataset definitions!\n",
+                         (unsigned long) sizeof(TRDP_DATASET_T));
+            return TRDP_MEM_ERR;
+        }
 
-            /* Allocate an array of pointers */
-            *papDataset = (apTRDP_DATASET_T) vos_memAlloc(count * sizeof(apTRDP_DATASET_T));
+        while ((token = trdp_XMLGetAttribute(pXML, attribute, &valueInt, value)) == TOK_ATTRIBUTE)
+        {
+            if (vos_strnicmp(attribute, "id", MAX_TOK_LEN) == 0)
+            {
+                pDataset->id = valueInt;
+            }
+        }
 
-            if (papDataset == NULL)
+        trdp_XMLEnter(pXML);
+        while ((token != TOK_CLOSE_EMPTY) && (trdp_XMLSeekStartTag(pXML, "element") == 0))
+        {
+            /* The elements follow the dataset, which moves while they are appended */
+            TRDP_DATASET_ELEMENT_T *pElement = (TRDP_DATASET_ELEMENT_T *) appendArenaItem(
+                    *ppArena, FALSE, (void * *) &pDataset, (UINT32) offsetof(TRDP_DATASET_T, pElement),
+                    (UINT32) sizeof(TRDP_DATASET_ELEMENT_T), &numElement, &capacityElement);
+            if (pElement == NULL)
             {
-                vos_printLog(VOS_LOG_ERROR, "%lu Bytes failed to allocate while reading XML telegram definitions!\n",
-                             (unsigned long) (count * sizeof(apTRDP_DATASET_T)));
                 return TRDP_MEM_ERR;
             }
 
-            *pNumDataset = count;
-
-            /* Read the interface params */
-            for (idx = 0; idx < *pNumDataset && trdp_XMLSeekStartTag(pXML, "data-set") == 0; idx++)
+            pElement->size = 1;   /* default  */
+            while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
             {
-                UINT32 i = 0u;
-                trdp_XMLEnter(pXML);
-                count = (UINT32) trdp_XMLCountStartTag(pXML, "element");
-
-                /* Allocate the dataset element */
-                (*papDataset)[idx] =
-                    (TRDP_DATASET_T *)vos_memAlloc(count * sizeof(TRDP_DATASET_ELEMENT_T) + sizeof(TRDP_DATASET_T));
-
-                if ((*papDataset)[idx] == NULL)
+                if (vos_strnicmp(attribute, "type", MAX_TOK_LEN) == 0)
                 {
-                    vos_printLog(VOS_LOG_ERROR,
-                                 "%lu Bytes failed to allocate while reading XML telegram definitions!\n",
-                                 (unsigned long) (count * sizeof(TRDP_DATASET_ELEMENT_T) + sizeof(TRDP_DATASET_T)));
-                    return TRDP_MEM_ERR;
+                    if (valueInt == 0)
+                    {
+                        pElement->type = string2type(value);
+                    }
+                    else
+                    {
+                        pElement->type = valueInt;
+                    }
                 }
-
-                while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
+                else if (vos_strnicmp(attribute, "array-size", MAX_TOK_LEN) == 0)
                 {
-                    if (vos_strnicmp(attribute, "id", MAX_TOK_LEN) == 0)
+                    pElement->size = valueInt;
+                }
+                else if (vos_strnicmp(attribute, "unit", MAX_TOK_LEN) == 0)
+                {
+                    pElement->unit = trdp_XMLArenaStrDup(*ppArena, value);
+                    if (pElement->unit == NULL)
                     {
-                        (*papDataset)[idx]->id = valueInt;
+                        return TRDP_MEM_ERR;
                     }
                 }
-
-                while (trdp_XMLSeekStartTag(pXML, "element") == 0)
+                else if (vos_strnicmp(attribute, "name", MAX_TOK_LEN) == 0)
                 {
-                    (*papDataset)[idx]->pElement[i].size = 1;   /* default  */
-                    while (trdp_XMLGetAttribute(pXML, attribute, &valueInt, value) == TOK_ATTRIBUTE)
+                    pElement->name = trdp_XMLArenaStrDup(*ppArena, value);
+                    if (pElement->name == NULL)
                     {
-                        if (vos_strnicmp(attribute, "type", MAX_TOK_LEN) == 0)
-                        {
-                            if (valueInt == 0)
-                            {
-                                (*papDataset)[idx]->pElement[i].type = string2type(value);
-                            }
-                            else
-                            {
-                                (*papDataset)[idx]->pElement[i].type = valueInt;
-                            }
-                        }
-                        else if (vos_strnicmp(attribute, "array-size", MAX_TOK_LEN) == 0)
-                        {
-                            (*papDataset)[idx]->pElement[i].size = valueInt;
-                        }
-                        else if (vos_strnicmp(attribute, "unit", MAX_TOK_LEN) == 0)
-                        {
-                            (*papDataset)[idx]->pElement[i].unit = (CHAR8 *) vos_memAlloc((UINT32) strlen(value) + 1u);
-                            if ((*papDataset)[idx]->pElement[i].unit == NULL)
-                            {
-                                return TRDP_MEM_ERR;
-                            }
-                            vos_strncpy((*papDataset)[idx]->pElement[i].unit, value, (UINT32) strlen(value) + 1u);
-                        }
-                        else if (vos_strnicmp(attribute, "name", MAX_TOK_LEN) == 0)
-                        {
-                            (*papDataset)[idx]->pElement[i].name = (CHAR8 *) vos_memAlloc((UINT32) strlen(value) + 1u);
-                            if ((*papDataset)[idx]->pElement[i].name == NULL)
-                            {
-                                return TRDP_MEM_ERR;
-                            }
-                            vos_strncpy((*papDataset)[idx]->pElement[i].name, value, (UINT32) strlen(value) + 1u);
-                        }
-                        else if (vos_strnicmp(attribute, "scale", MAX_TOK_LEN) == 0)
-                        {
-                            (*papDataset)[idx]->pElement[i].scale = (REAL32) strtod(value, NULL);
-                        }
-                        else if (vos_strnicmp(attribute, "offset", MAX_TOK_LEN) == 0)
-                        {
-                            (*papDataset)[idx]->pElement[i].offset = (INT32) valueInt;
-                        }
+                        return TRDP_MEM_ERR;
                     }
-                    (*papDataset)[idx]->numElement++;
-                    i++;
                 }
-                trdp_XMLLeave(pXML);
+                else if (vos_strnicmp(attribute, "scale", MAX_TOK_LEN) == 0)
+                {
+                    pElement->scale = (REAL32) strtod(value, NULL);
+                }
+                else if (vos_strnicmp(attribute, "offset", MAX_TOK_LEN) == 0)
+                {
+                    pElement->offset = (INT32) valueInt;
+                }
             }
         }
         trdp_XMLLeave(pXML);
+
+        pDataset->numElement    = (UINT16) numElement;
+        *ppDataset              = pDataset;
     }
     trdp_XMLLeave(pXML);
     return TRDP_NO_ERR;
@@ -993,6 +979,7 @@ EXT_DECL TRDP_ERR_T tau_readXmlInterfaceConfig (
     CHAR8       value[MAX_TOK_LEN];
     UINT32      valueInt;
     TRDP_ERR_T  result = TRDP_NO_ERR;
+    XML_ARENA_T *pArena = NULL;
 
     /*  Check parameters    */
     if (!pDocHnd || !pIfName || !pNumExchgPar || !ppExchgPar)
@@ -1047,7 +1034,7 @@ EXT_DECL TRDP_ERR_T tau_readXmlInterfaceConfig (
 
                 while (trdp_XMLSeekStartTag(pDocHnd->pXmlDocument, "bus-interface") == 0)
                 {
-                    UINT32 idx = 0, count = 0;
+                    UINT32 capacity = 0u;
 
                     /* find the interface, if its name was supplied, otherwise take the first one which was defined */
                     if (pIfName != NULL && strlen(pIfName))
@@ -1067,24 +1054,13 @@ EXT_DECL TRDP_ERR_T tau_readXmlInterfaceConfig (
                         }
                     }
 
-                    trdp_XMLEnter(pDocHnd->pXmlDocument);
-
-                    /* find out how many telegrams are defined before hand */
-
-                    count = (UINT32) trdp_XMLCountStartTag(pDocHnd->pXmlDocument, "telegram");
+                    /* The telegrams of a later matching interface replace those read before */
+                    trdp_XMLArenaFree(pArena);
+                    pArena          = NULL;
+                    *pNumExchgPar   = 0u;
+                    *ppExchgPar     = NULL;
 
-                    if (count > 0u)
-                    {
-                        *ppExchgPar = (TRDP_EXCHG_PAR_T *)vos_memAlloc(count * sizeof(TRDP_EXCHG_PAR_T));
-
-                        if (*ppExchgPar == NULL)
-                        {
-                            vos_printLog(VOS_LOG_ERROR,
-                                         "%lu Bytes failed to allocate while reading XML telegram definitions!\n",
-                                         (unsigned long) (count * sizeof(TRDP_EXCHG_PAR_T)));
-                            return TRDP_MEM_ERR;
-                        }
-                    }
+                    trdp_XMLEnter(pDocHnd->pXmlDocument);
 
                     while (trdp_XMLSeekStartTagAny(pDocHnd->pXmlDocument, tag, MAX_TAG_LEN) == 0)
                     {
@@ -1197,6 +1173,10 @@ EXT_DECL TRDP_ERR_T tau_readXmlInterfaceConfig (
                                 {
                                     pMdConfig->maxNumSessions = valueInt;
                                 }
+                                else if (vos_strnicmp(attribute, "tcp-pipeline", MAX_TOK_LEN) == 0)
+                                {
+                                    pMdConfig->maxTcpPipeline = valueInt;
+                                }
                                 else if (vos_strnicmp(attribute, "confirm-timeout", MAX_TOK_LEN) == 0)
                                 {
                                     pMdConfig->confirmTimeout = valueInt;
@@ -1241,23 +1221,41 @@ EXT_DECL TRDP_ERR_T tau_readXmlInterfaceConfig (
                                 }
                             }
                         }
-                        /* read the n-th telegram / exchange parameters */
-                        if (count > 0u && count > idx && vos_strnicmp(tag, "telegram", MAX_TAG_LEN) == 0)
+                        /* read the next telegram / exchange parameters */
+                        if (vos_strnicmp(tag, "telegram", MAX_TAG_LEN) == 0)
                         {
-                            trdp_XMLEnter(pDocHnd->pXmlDocument);
-                            result = readTelegramDef(pDocHnd->pXmlDocument, &(*ppExchgPar)[idx]);
+                            TRDP_EXCHG_PAR_T *pExchgPar;
+
+                            /* All telegram parameters are allocated from the arena of the array */
+                            if (pArena == NULL)
+                            {
+                                pArena = trdp_XMLArenaCreate();
+                            }
+                            pExchgPar = (TRDP_EXCHG_PAR_T *) appendArenaItem(pArena, TRUE, (void * *) ppExchgPar, 0u,
+                                                                             (UINT32) sizeof(TRDP_EXCHG_PAR_T),
+                                                                             pNumExchgPar, &capacity);
+                            if (pExchgPar == NULL)
+                            {
+                                result = TRDP_MEM_ERR;
+                            }
+                            else
+                            {
+                                trdp_XMLEnter(pDocHnd->pXmlDocument);
+                                result = readTelegramDef(pDocHnd->pXmlDocument, pArena, pExchgPar);
 #ifdef LIST_EXCH_PARAMS
-                            dbgPrint(1, &(*ppExchgPar)[idx]);
+                                dbgPrint(1, pExchgPar);
 #endif
-                            trdp_XMLLeave(pDocHnd->pXmlDocument);
+                                trdp_XMLLeave(pDocHnd->pXmlDocument);
+                            }
                             if (result != TRDP_NO_ERR)
                             {
+                                trdp_XMLArenaFree(pArena);
+                                *pNumExchgPar   = 0u;
+                                *ppExchgPar     = NULL;
                                 return result;
                             }
-                            idx++;
                         }
                     }
-                    *pNumExchgPar = count;
                 }
                 trdp_XMLLeave(pDocHnd->pXmlDocument);
             }
@@ -1280,86 +1278,19 @@ EXT_DECL void tau_freeTelegrams (
     UINT32              numExchgPar,
     TRDP_EXCHG_PAR_T    *pExchgPar)
 {
-    UINT32  idxEP;
-    UINT32  i;
-
     /*  Check parameters    */
     if (numExchgPar == 0u || pExchgPar == NULL)
     {
         return;
     }
 
-    /*  Iterate over all exchange parameters    */
-    for (idxEP = 0u; idxEP < numExchgPar; idxEP++)
+    /*  All telegram parameters are in the arena of the array   */
+    if (trdp_XMLArenaOfRoot(pExchgPar) == NULL)
     {
-        /*  Free MD and PD parameters   */
-        if (pExchgPar[idxEP].pMdPar)
-        {
-            vos_memFree(pExchgPar[idxEP].pMdPar);
-        }
-
-        if (pExchgPar[idxEP].pPdPar)
-        {
-            vos_memFree(pExchgPar[idxEP].pPdPar);
-        }
-
-        /*  vos_memFree array of destinations  */
-        if (pExchgPar[idxEP].destCnt)
-        {
-            /*  Iterate ove all destinations    */
-            for (i = 0u; i < pExchgPar[idxEP].destCnt; i++)
-            {
-                /*  vos_free URIs   */
-                if (pExchgPar[idxEP].pDest[i].pUriHost)
-                {
-                    vos_memFree(pExchgPar[idxEP].pDest[i].pUriHost);
-                }
-                if (pExchgPar[idxEP].pDest[i].pUriUser)
-                {
-                    vos_memFree(pExchgPar[idxEP].pDest[i].pUriUser);
-                }
-                /*  Free SDT parameters */
-                if (pExchgPar[idxEP].pDest[i].pSdtPar)
-                {
-                    vos_memFree(pExchgPar[idxEP].pDest[i].pSdtPar);
-                }
-            }
-            /*  Free destinations array  */
-            vos_memFree(pExchgPar[idxEP].pDest);
-        }
-        /*  Free array of sources  */
-        if (pExchgPar[idxEP].srcCnt)
-        {
-            /*  Iterate over all sources    */
-            for (i = 0u; i < pExchgPar[idxEP].srcCnt; i++)
-            {
-                /*  Free URIs   */
-                if (pExchgPar[idxEP].pSrc[i].pUriHost1)
-                {
-                    vos_memFree(pExchgPar[idxEP].pSrc[i].pUriHost1);
-                }
-                if (pExchgPar[idxEP].pSrc[i].pUriHost2)
-                {
-                    vos_memFree(pExchgPar[idxEP].pSrc[i].pUriHost2);
-                }
-                if (pExchgPar[idxEP].pSrc[i].pUriUser)
-                {
-                    vos_memFree(pExchgPar[idxEP].pSrc[i].pUriUser);
-                }
-                /*  Free SDT parameters */
-                if (pExchgPar[idxEP].pSrc[i].pSdtPar)
-                {
-                    vos_memFree(pExchgPar[idxEP].pSrc[i].pSdtPar);
-                }
-            }
-            /*  Free sources array  */
-            vos_memFree(pExchgPar[idxEP].pSrc);
-        }
-
+        vos_printLogStr(VOS_LOG_ERROR, "tau_freeTelegrams: array not allocated by tau_readXmlInterfaceConfig\n");
+        return;
     }
-
-    /*  Free array of TRDP_EXCHG_PAR_T structures   */
-    vos_memFree(pExchgPar);
+    trdp_XMLArenaFree(trdp_XMLArenaOfRoot(pExchgPar));
 }
 
 /**********************************************************************************************************************/
@@ -1393,6 +1324,8 @@ EXT_DECL TRDP_ERR_T tau_readXmlDeviceConfig (
     CHAR8   attribute[MAX_TOK_LEN];
     CHAR8   value[MAX_TOK_LEN];
     UINT32  valueInt;
+    UINT32  capacityComPar      = 0u;
+    UINT32  capacityIfConfig    = 0u;
 
     trdp_XMLRewind(pDocHnd->pXmlDocument);
 
@@ -1411,7 +1344,7 @@ EXT_DECL TRDP_ERR_T tau_readXmlDeviceConfig (
             if (vos_strnicmp(tag, "device-configuration", MAX_TAG_LEN) == 0)
             {
                 /* Get attribute data */
-                if (trdp_XMLGetAttribute(pDocHnd->pXmlDocument, attribute, &valueInt, value) == TOK_ATTRIBUTE)
+                while (trdp_XMLGetAttribute(pDocHnd->pXmlDocument, attribute, &valueInt, value) == TOK_ATTRIBUTE)
                 {
                     if (vos_strnicmp(attribute, "memory-size", MAX_TOK_LEN) == 0)
                     {
@@ -1491,44 +1424,41 @@ EXT_DECL TRDP_ERR_T tau_readXmlDeviceConfig (
             }
             else if (vos_strnicmp(tag, "com-parameter-list", MAX_TAG_LEN) == 0)
             {
-                UINT32 count = 0u;
                 trdp_XMLEnter(pDocHnd->pXmlDocument);
 
-                count = (UINT32) trdp_XMLCountStartTag(pDocHnd->pXmlDocument, "com-parameter");
-
-                *ppComPar = (TRDP_COM_PAR_T *)vos_memAlloc(count * sizeof(TRDP_COM_PAR_T));
-
-                if (*ppComPar != NULL)
+                /* Read the com params */
+                while (trdp_XMLSeekStartTag(pDocHnd->pXmlDocument, "com-parameter") == 0)
                 {
-                    UINT32 i;
-                    *pNumComPar = count;
-
-                    /* Read the com params */
-                    for (i = 0u; i < count && trdp_XMLSeekStartTag(pDocHnd->pXmlDocument, "com-parameter") == 0; i++)
+                    TRDP_COM_PAR_T *pComPar = (TRDP_COM_PAR_T *) appendMemItem((void * *) ppComPar,
+                                                                               (UINT32) sizeof(TRDP_COM_PAR_T),
+                                                                               pNumComPar, &capacityComPar);
+                    if (pComPar == NULL)
                     {
-                        /* Set some defaults */
-                        (*ppComPar)[i].sendParam.ttl = TRDP_MD_DEFAULT_TTL;
-                        (*ppComPar)[i].sendParam.retries = TRDP_MD_DEFAULT_RETRIES;
+                        return TRDP_MEM_ERR;
+                    }
 
-                        while (trdp_XMLGetAttribute(pDocHnd->pXmlDocument, attribute, &valueInt,
-                                                    value) == TOK_ATTRIBUTE)
+                    /* Set some defaults */
+                    pComPar->sendParam.ttl      = TRDP_MD_DEFAULT_TTL;
+                    pComPar->sendParam.retries  = TRDP_MD_DEFAULT_RETRIES;
+
+                    while (trdp_XMLGetAttribute(pDocHnd->pXmlDocument, attribute, &valueInt,
+                                                value) == TOK_ATTRIBUTE)
+                    {
+                        if (vos_strnicmp(attribute, "id", MAX_TOK_LEN) == 0)
                         {
-                            if (vos_strnicmp(attribute, "id", MAX_TOK_LEN) == 0)
-                            {
-                                (*ppComPar)[i].id = valueInt;
-                            }
-                            else if (vos_strnicmp(attribute, "qos", MAX_TOK_LEN) == 0)
-                            {
-                                (*ppComPar)[i].sendParam.qos = (UINT8) valueInt;
-                            }
-                            else if (vos_strnicmp(attribute, "ttl", MAX_TOK_LEN) == 0)
-                            {
-                                (*ppComPar)[i].sendParam.ttl = (UINT8) valueInt;
-                            }
-                            else if (vos_strnicmp(attribute, "retries", MAX_TOK_LEN) == 0)
-                            {
-                                (*ppComPar)[i].sendParam.retries = (UINT8) valueInt;
-                            }
+                            pComPar->id = valueInt;
+                        }
+                        else if (vos_strnicmp(attribute, "qos", MAX_TOK_LEN) == 0)
+                        {
+                            pComPar->sendParam.qos = (UINT8) valueInt;
+                        }
+                        else if (vos_strnicmp(attribute, "ttl", MAX_TOK_LEN) == 0)
+                        {
+                            pComPar->sendParam.ttl = (UINT8) valueInt;
+                        }
+                        else if (vos_strnicmp(attribute, "retries", MAX_TOK_LEN) == 0)
+                        {
+                            pComPar->sendParam.retries = (UINT8) valueInt;
                         }
                     }
                 }
@@ -1536,40 +1466,37 @@ EXT_DECL TRDP_ERR_T tau_readXmlDeviceConfig (
             }
             else if (vos_strnicmp(tag, "bus-interface-list", MAX_TAG_LEN) == 0)
             {
-                UINT32 count = 0u;
                 trdp_XMLEnter(pDocHnd->pXmlDocument);
 
-                count = (UINT32) trdp_XMLCountStartTag(pDocHnd->pXmlDocument, "bus-interface");
-
-                *ppIfConfig = (TRDP_IF_CONFIG_T *)vos_memAlloc(count * sizeof(TRDP_IF_CONFIG_T));
-
-                if (*ppIfConfig != NULL)
+                /* Read the interface params */
+                while (trdp_XMLSeekStartTag(pDocHnd->pXmlDocument, "bus-interface") == 0)
                 {
-                    UINT32 i;
-                    *pNumIfConfig = count;
+                    TRDP_IF_CONFIG_T *pIfConfig = (TRDP_IF_CONFIG_T *) appendMemItem((void * *) ppIfConfig,
+                                                                                     (UINT32) sizeof(TRDP_IF_CONFIG_T),
+                                                                                     pNumIfConfig, &capacityIfConfig);
+                    if (pIfConfig == NULL)
+                    {
+                        return TRDP_MEM_ERR;
+                    }
 
-                    /* Read the interface params */
-                    for (i = 0u; i < count && trdp_XMLSeekStartTag(pDocHnd->pXmlDocument, "bus-interface") == 0; i++)
+                    while (trdp_XMLGetAttribute(pDocHnd->pXmlDocument, attribute, &valueInt,
+                                                value) == TOK_ATTRIBUTE)
                     {
-                        while (trdp_XMLGetAttribute(pDocHnd->pXmlDocument, attribute, &valueInt,
-                                                    value) == TOK_ATTRIBUTE)
+                        if (vos_strnicmp(attribute, "network-id", MAX_TOK_LEN) == 0)
                         {
-                            if (vos_strnicmp(attribute, "network-id", MAX_TOK_LEN) == 0)
-                            {
-                                (*ppIfConfig)[i].networkId = (UINT8) valueInt;
-                            }
-                            else if (vos_strnicmp(attribute, "name", MAX_TOK_LEN) == 0)
-                            {
-                                vos_strncpy((*ppIfConfig)[i].ifName, value, TRDP_MAX_LABEL_LEN);
-                            }
-                            else if (vos_strnicmp(attribute, "host-ip", MAX_TOK_LEN) == 0)
-                            {
-                                (*ppIfConfig)[i].hostIp = vos_dottedIP(value);
-                            }
-                            else if (vos_strnicmp(attribute, "leader-ip", MAX_TOK_LEN) == 0)
-                            {
-                                (*ppIfConfig)[i].leaderIp = vos_dottedIP(value);
-                            }
+                            pIfConfig->networkId = (UINT8) valueInt;
+                        }
+                        else if (vos_strnicmp(attribute, "name", MAX_TOK_LEN) == 0)
+                        {
+                            vos_strncpy(pIfConfig->ifName, value, TRDP_MAX_LABEL_LEN);
+                        }
+                        else if (vos_strnicmp(attribute, "host-ip", MAX_TOK_LEN) == 0)
+                        {
+                            pIfConfig->hostIp = vos_dottedIP(value);
+                        }
+                        else if (vos_strnicmp(attribute, "leader-ip", MAX_TOK_LEN) == 0)
+                        {
+                            pIfConfig->leaderIp = vos_dottedIP(value);
                         }
                     }
                 }
@@ -1584,6 +1511,55 @@ EXT_DECL TRDP_ERR_T tau_readXmlDeviceConfig (
     return TRDP_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/**    Function to read the Traffic Store size for ladder topology out of the XML configuration file.
+ *  The size is the traffic-store-size attribute of the device-configuration element, 0 if not configured.
+ *
+ *  @param[in]      pDocHnd             Handle of the XML document prepared by tau_prepareXmlDoc
+ *  @param[out]     pTrafficStoreSize   Configured Traffic Store size in bytes
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      Parameter error
+ *
+ */
+EXT_DECL TRDP_ERR_T tau_readXmlTrafficStoreConfig (
+    const TRDP_XML_DOC_HANDLE_T *pDocHnd,
+    UINT32                      *pTrafficStoreSize
+    )
+{
+    CHAR8   attribute[MAX_TOK_LEN];
+    CHAR8   value[MAX_TOK_LEN];
+    UINT32  valueInt;
+
+    if ((pDocHnd == NULL) || (pTrafficStoreSize == NULL))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    *pTrafficStoreSize = 0u;
+
+    trdp_XMLRewind(pDocHnd->pXmlDocument);
+    trdp_XMLEnter(pDocHnd->pXmlDocument);
+
+    if (trdp_XMLSeekStartTag(pDocHnd->pXmlDocument, "device") == 0)
+    {
+        trdp_XMLEnter(pDocHnd->pXmlDocument);
+        if (trdp_XMLSeekStartTag(pDocHnd->pXmlDocument, "device-configuration") == 0)
+        {
+            while (trdp_XMLGetAttribute(pDocHnd->pXmlDocument, attribute, &valueInt, value) == TOK_ATTRIBUTE)
+            {
+                if (vos_strnicmp(attribute, "traffic-store-size", MAX_TOK_LEN) == 0)
+                {
+                    *pTrafficStoreSize = valueInt;
+                }
+            }
+        }
+        trdp_XMLLeave(pDocHnd->pXmlDocument);
+    }
+
+    trdp_XMLLeave(pDocHnd->pXmlDocument);
+
+    return TRDP_NO_ERR;
+}
 
 /**********************************************************************************************************************/
 /**    Function to read the DataSet configuration out of the XML configuration file.
@@ -1608,10 +1584,53 @@ EXT_DECL TRDP_ERR_T tau_readXmlDatasetConfig (
     apTRDP_DATASET_T            *apDataset
     )
 {
-    TRDP_ERR_T err = readXmlDatasetMap(pDocHnd->pXmlDocument, pNumComId, ppComIdDsIdMap);
-    if (err == TRDP_NO_ERR)
+    CHAR8       tag[MAX_TAG_LEN];
+    TRDP_ERR_T  err             = TRDP_NO_ERR;
+    XML_ARENA_T *pArena         = NULL;
+    UINT32      capacityMap     = 0u;
+    UINT32      capacityDataset = 0u;
+
+    *pNumComId      = 0u;
+    *ppComIdDsIdMap = NULL;
+    *pNumDataset    = 0u;
+    *apDataset      = NULL;
+
+    trdp_XMLRewind(pDocHnd->pXmlDocument);
+
+    trdp_XMLEnter(pDocHnd->pXmlDocument);
+
+    if (trdp_XMLSeekStartTag(pDocHnd->pXmlDocument, "device") == 0) /* Optional */
     {
-        err = readXmlDatasets(pDocHnd->pXmlDocument, pNumDataset, apDataset);
+        trdp_XMLEnter(pDocHnd->pXmlDocument);
+
+        /* The ComId map and the datasets are read in one pass thru <device> */
+        while ((err == TRDP_NO_ERR) &&
+               (trdp_XMLSeekStartTagAny(pDocHnd->pXmlDocument, tag, MAX_TAG_LEN) == 0))
+        {
+            if (vos_strnicmp(tag, "bus-interface-list", MAX_TAG_LEN) == 0)
+            {
+                err = readXmlDatasetMap(pDocHnd->pXmlDocument, pNumComId, ppComIdDsIdMap, &capacityMap);
+            }
+            else if (vos_strnicmp(tag, "data-set-list", MAX_TAG_LEN) == 0)
+            {
+                err = readXmlDatasets(pDocHnd->pXmlDocument, &pArena, pNumDataset, apDataset, &capacityDataset);
+            }
+        }
+        trdp_XMLLeave(pDocHnd->pXmlDocument);
+    }
+    trdp_XMLLeave(pDocHnd->pXmlDocument);
+
+    if (err != TRDP_NO_ERR)
+    {
+        if (*ppComIdDsIdMap != NULL)
+        {
+            vos_memFree(*ppComIdDsIdMap);
+        }
+        trdp_XMLArenaFree(pArena);
+        *pNumComId      = 0u;
+        *ppComIdDsIdMap = NULL;
+        *pNumDataset    = 0u;
+        *apDataset      = NULL;
     }
     return err;
 }
@@ -1636,9 +1655,6 @@ EXT_DECL void tau_freeXmlDatasetConfig (
     UINT32                  numDataset,
     TRDP_DATASET_T          * *ppDataset)
 {
-    UINT32  i;
-    UINT32  j;
-
     /*  Mapping between ComId and DatasetId   */
     if (numComId > 0u && pComIdDsIdMap != NULL)
     {
@@ -1646,28 +1662,9 @@ EXT_DECL void tau_freeXmlDatasetConfig (
         pComIdDsIdMap = NULL;
     }
 
-    /*  Dataset definitions   */
+    /*  Dataset definitions, all in the arena of the pointer array   */
     if (numDataset > 0u && ppDataset != NULL)
     {
-        for (i = 0u; i < numDataset; ++i)
-        {
-            for (j = 0u; j < ppDataset[i]->numElement; ++j)
-            {
-                if (ppDataset[i]->pElement[j].unit != NULL)
-                {
-                    vos_memFree(ppDataset[i]->pElement[j].unit);
-                    ppDataset[i]->pElement[j].unit = NULL;
-                }
-                if (ppDataset[i]->pElement[j].name != NULL)
-                {
-                    vos_memFree(ppDataset[i]->pElement[j].name);
-                    ppDataset[i]->pElement[j].name = NULL;
-                }
-            }
-            vos_memFree(ppDataset[i]);
-            ppDataset[i] = NULL;
-        }
-        vos_memFree(ppDataset);
-        ppDataset = NULL;
+        trdp_XMLArenaFree(trdp_XMLArenaOfRoot(ppDataset));
     }
 }
@@ -16,6 +16,14 @@
  *
  * $Id: trdp_if.c 1789 2018-11-09 08:15:22Z ahweiss $
  *
+ *      AG 2026-10-19: Hooks of a higher layer (resolver) in tlc_getInterval and tlc_process
+ *      AG 2026-10-19: Histogram telegram ComId TRDP_HIST_STATISTICS_COMID moved out of the IEC reserved range
+ *      AG 2026-10-19: Time accounting of the tlc_process phases, processing budget (tlc_setProcessBudget)
+ *      AG 2026-10-19: Tracepoints at the phases of tlc_process (TRDP_TRACE), tlc_startTrace
+ *      AG 2026-10-19: Timing histograms (TRDP_OPTION_HISTOGRAMS), histogram telegram ComId 42
+ *      AG 2026-10-19: Statistics export (tlc_startStatisticsExport), numPub/numSubs counted on (un)publish/subscribe
+ *      AG 2026-10-18: PD socket filter for subscribed ComIds (TRDP_OPTION_PD_KERNEL_FILTER)
+ *      AG 2026-10-18: Reference counted MC joins, source specific multicast (TRDP_OPTION_MC_SOURCE_FILTER)
  *      BL 2018-10-09: Ticket #213 ComId 31 subscription removed (<-- undone!)
  *      BL 2018-06-29: Default settings handling / compiler warnings
  *      SW 2018-06-26: Ticket #205 tlm_addListener() does not acknowledge TRDP_FLAGS_DEFAULT flag
@@ -78,6 +86,7 @@
 #include "trdp_utils.h"
 #include "trdp_pdcom.h"
 #include "trdp_stats.h"
+#include "trdp_trace.h"
 #include "vos_sock.h"
 #include "vos_mem.h"
 #include "vos_utils.h"
@@ -110,6 +119,107 @@ static BOOL8 sInited = FALSE;
 BOOL8 trdp_isValidSession (TRDP_APP_SESSION_T pSessionHandle);
 TRDP_APP_SESSION_T *trdp_sessionQueue (void);
 
+/**********************************************************************************************************************/
+/** Source a multicast subscription joins its group for
+ *  With TRDP_OPTION_MC_SOURCE_FILTER set, a subscription of a single publisher joins the group for this source
+ *  only, datagrams of other publishers are then dropped by the network stack already.
+ *
+ *  @param[in]    appHandle             session handle
+ *  @param[in]    mcGroup               subscribed multicast group or 0
+ *  @param[in]    srcIpAddr1            subscribed source or lower address of range
+ *  @param[in]    srcIpAddr2            upper address of range or 0
+ *
+ *  @retval       source IP             join for this source only
+ *  @retval       VOS_INADDR_ANY        join for any source
+ */
+static TRDP_IP_ADDR_T trdp_mcSourceFilter (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_IP_ADDR_T      mcGroup,
+    TRDP_IP_ADDR_T      srcIpAddr1,
+    TRDP_IP_ADDR_T      srcIpAddr2)
+{
+    if (((appHandle->option & TRDP_OPTION_MC_SOURCE_FILTER) != 0u) &&
+        (mcGroup != VOS_INADDR_ANY) &&
+        (srcIpAddr1 != VOS_INADDR_ANY) &&
+        ((srcIpAddr2 == VOS_INADDR_ANY) || (srcIpAddr2 == srcIpAddr1)))
+    {
+        return srcIpAddr1;
+    }
+    return VOS_INADDR_ANY;
+}
+
+/**********************************************************************************************************************/
+/** Microseconds between two points in time
+ *
+ *  @param[in]    pFrom                 earlier time
+ *  @param[in]    pTo                   later time
+ *
+ *  @retval       time difference in us
+ */
+static UINT32 trdp_usBetween (
+    const TRDP_TIME_T   *pFrom,
+    const TRDP_TIME_T   *pTo)
+{
+    TRDP_TIME_T diff = *pTo;
+
+    vos_subTime(&diff, pFrom);
+    return (UINT32) diff.tv_sec * 1000000u + (UINT32) diff.tv_usec;
+}
+
+/**********************************************************************************************************************/
+/** Account the time spent in a phase of tlc_process
+ *
+ *  @param[in]    appHandle             session handle
+ *  @param[in]    phase                 TRDP_TRACE_PHASE_T of the phase just finished
+ *  @param[in,out] pPhaseStart          start of the phase, set to the current time
+ */
+static void trdp_processPhase (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              phase,
+    TRDP_TIME_T         *pPhaseStart)
+{
+    TRDP_TIME_T now;
+    UINT32      time;
+
+    vos_getTime(&now);
+    time = trdp_usBetween(pPhaseStart, &now);
+    appHandle->stats.process.phaseTime[phase] += time;
+    if (time > appHandle->stats.process.phaseMax[phase])
+    {
+        appHandle->stats.process.phaseMax[phase] = time;
+    }
+    *pPhaseStart = now;
+}
+
+/**********************************************************************************************************************/
+/** Check if the remaining work of tlc_process is to be deferred to the next call
+ *  Work deferred in the previous call is not deferred again, so that MD and statistics are not starved by a
+ *  budget too small for the load.
+ *
+ *  @param[in]    appHandle             session handle
+ *  @param[in]    mayDefer              FALSE if the previous call deferred work
+ *  @param[in]    pStart                start of tlc_process
+ *  @param[in]    pNow                  current time
+ *
+ *  @retval       TRUE                  skip the phase
+ *  @retval       FALSE                 process the phase
+ */
+static BOOL8 trdp_processDefer (
+    TRDP_APP_SESSION_T  appHandle,
+    BOOL8               mayDefer,
+    const TRDP_TIME_T   *pStart,
+    const TRDP_TIME_T   *pNow)
+{
+    if (mayDefer &&
+        !appHandle->deferred &&
+        (appHandle->stats.process.budget != 0u) &&
+        (trdp_usBetween(pStart, pNow) > appHandle->stats.process.budget))
+    {
+        appHandle->deferred = TRUE;
+    }
+    return appHandle->deferred;
+}
+
 /***********************************************************************************************************************
  * GLOBAL FUNCTIONS
  */
@@ -340,6 +450,7 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
     pSession->mdDefault.sendParam.ttl       = TRDP_MD_DEFAULT_TTL;
     pSession->mdDefault.sendParam.retries   = TRDP_MD_DEFAULT_RETRIES;
     pSession->mdDefault.maxNumSessions      = TRDP_MD_MAX_NUM_SESSIONS;
+    pSession->mdDefault.maxTcpPipeline      = TRDP_MD_DEFAULT_TCP_PIPELINE;
     pSession->tcpFd.listen_sd               = VOS_INVALID_SOCKET;
 
 #endif
@@ -364,7 +475,15 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
     vos_getTime(&pSession->initTime);
 
     /*    Clear the socket pool    */
-    trdp_initSockets(pSession->iface);
+    ret = trdp_initSockets(pSession);
+
+    if (ret != TRDP_NO_ERR)
+    {
+        vos_mutexDelete(pSession->mutex);
+        vos_memFree(pSession);
+        vos_printLogStr(VOS_LOG_ERROR, "Out of memory!\n");
+        return ret;
+    }
 
 #if MD_SUPPORT
     /* Initialize pointers to Null in the incomplete message structure */
@@ -416,7 +535,7 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
                               TRDP_FLAGS_NONE,          /*    No callbacks                  */
                               NULL,                     /*    default qos and ttl           */
                               NULL,                     /*    initial data                  */
-                              sizeof(TRDP_STATISTICS_T));
+                              TRDP_STATISTICS_PACKET_SIZE);
             if ((ret == TRDP_SOCK_ERR) &&
                 (ownIpAddr == VOS_INADDR_ANY))          /*  do not wait if own IP was set (but invalid)    */
             {
@@ -428,6 +547,14 @@ EXT_DECL TRDP_ERR_T tlc_openSession (
             }
         }
 
+        /*  Publish the histogram packet, it is pulled with our request packet    */
+        if ((ret == TRDP_NO_ERR) && ((pSession->option & TRDP_OPTION_HISTOGRAMS) != 0u))
+        {
+            ret = tlp_publish(pSession, &dummyPubHndl, NULL, NULL,
+                              TRDP_HIST_STATISTICS_COMID, 0u, 0u, 0u, 0u, 0u, 0u, TRDP_FLAGS_NONE, NULL, NULL,
+                              sizeof(TRDP_HIST_STATISTICS_T));
+        }
+
         /*  Subscribe our request packet   */
         if (ret == TRDP_NO_ERR)
         {
@@ -649,6 +776,12 @@ EXT_DECL TRDP_ERR_T tlc_configSession (
             pSession->mdDefault.maxNumSessions = pMdDefault->maxNumSessions;
         }
 
+        if ((pSession->mdDefault.maxTcpPipeline == TRDP_MD_DEFAULT_TCP_PIPELINE) &&
+            (pMdDefault->maxTcpPipeline != 0u))
+        {
+            pSession->mdDefault.maxTcpPipeline = pMdDefault->maxTcpPipeline;
+        }
+
     }
 
 #endif
@@ -730,6 +863,10 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
             {
 
                 /*    Release all allocated sockets and memory    */
+                trdp_releaseStatsExport(pSession);
+#if TRDP_TRACE
+                trdp_releaseTrace(pSession);
+#endif
                 vos_memFree(pSession->pNewFrame);
 
                 while (pSession->pSndQueue != NULL)
@@ -737,16 +874,17 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                     PD_ELE_T *pNext = pSession->pSndQueue->pNext;
 
                     /*  UnPublish our packets   */
-                    trdp_releaseSocket(appHandle->iface, pSession->pSndQueue->socketIdx, 0, FALSE, VOS_INADDR_ANY);
+                    trdp_releaseSocket(appHandle, pSession->pSndQueue->socketIdx, 0, FALSE, VOS_INADDR_ANY);
 
                     if (pSession->pSndQueue->pSeqCntList != NULL)
                     {
                         vos_memFree(pSession->pSndQueue->pSeqCntList);
                     }
                     vos_memFree(pSession->pSndQueue->pFrame);
+                    trdp_releaseHist(pSession, pSession->pSndQueue);
 
                     /*    Only close socket if not used anymore    */
-                    trdp_releaseSocket(pSession->iface, pSession->pSndQueue->socketIdx, 0, FALSE, VOS_INADDR_ANY);
+                    trdp_releaseSocket(pSession, pSession->pSndQueue->socketIdx, 0, FALSE, VOS_INADDR_ANY);
 
                     vos_memFree(pSession->pSndQueue);
                     pSession->pSndQueue = pNext;
@@ -758,7 +896,7 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
 
                     /*  UnPublish our statistics packet   */
                     /*    Only close socket if not used anymore    */
-                    trdp_releaseSocket(pSession->iface, pSession->pRcvQueue->socketIdx, 0, FALSE, VOS_INADDR_ANY);
+                    trdp_releaseSocket(pSession, pSession->pRcvQueue->socketIdx, 0, FALSE, VOS_INADDR_ANY);
                     if (pSession->pRcvQueue->pSeqCntList != NULL)
                     {
                         vos_memFree(pSession->pRcvQueue->pSeqCntList);
@@ -767,6 +905,7 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                     {
                         vos_memFree(pSession->pRcvQueue->pFrame);
                     }
+                    trdp_releaseHist(pSession, pSession->pRcvQueue);
                     vos_memFree(pSession->pRcvQueue);
                     pSession->pRcvQueue = pNext;
                 }
@@ -788,7 +927,7 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                     MD_ELE_T *pNext = pSession->pMDSndQueue->pNext;
 
                     /*    Only close socket if not used anymore    */
-                    trdp_releaseSocket(pSession->iface,
+                    trdp_releaseSocket(pSession,
                                        pSession->pMDSndQueue->socketIdx,
                                        pSession->mdDefault.connectTimeout,
                                        FALSE,
@@ -802,7 +941,7 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                     MD_ELE_T *pNext = pSession->pMDRcvQueue->pNext;
 
                     /*    Only close socket if not used anymore    */
-                    trdp_releaseSocket(pSession->iface,
+                    trdp_releaseSocket(pSession,
                                        pSession->pMDRcvQueue->socketIdx,
                                        pSession->mdDefault.connectTimeout,
                                        FALSE,
@@ -818,7 +957,7 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                     /*    Only close socket if not used anymore    */
                     if (pSession->pMDListenQueue->socketIdx != -1)
                     {
-                        trdp_releaseSocket(pSession->iface,
+                        trdp_releaseSocket(pSession,
                                            pSession->pMDListenQueue->socketIdx,
                                            pSession->mdDefault.connectTimeout,
                                            FALSE,
@@ -839,6 +978,9 @@ EXT_DECL TRDP_ERR_T tlc_closeSession (
                     vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
                 }
 
+                /*    Close the remaining (idle TCP) sockets and free the socket pool    */
+                trdp_freeSockets(pSession);
+
                 vos_mutexDelete(pSession->mutex);
                 vos_memFree(pSession);
             }
@@ -907,44 +1049,15 @@ EXT_DECL TRDP_ERR_T tlc_terminate (void)
 EXT_DECL TRDP_ERR_T tlc_reinitSession (
     TRDP_APP_SESSION_T appHandle)
 {
-    PD_ELE_T    *iterPD;
-
-    TRDP_ERR_T  ret;
+    TRDP_ERR_T ret;
 
     if (trdp_isValidSession(appHandle))
     {
         ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
         if (ret == TRDP_NO_ERR)
         {
-            /*    Walk over the registered PDs */
-            for (iterPD = appHandle->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
-            {
-                if (iterPD->privFlags & TRDP_MC_JOINT &&
-                    iterPD->socketIdx != -1)
-                {
-                    /*    Join the MC group again    */
-                    ret = (TRDP_ERR_T) vos_sockJoinMC(appHandle->iface[iterPD->socketIdx].sock,
-                                                      iterPD->addr.mcGroup,
-                                                      appHandle->realIP);
-                }
-            }
-#if MD_SUPPORT
-            {
-                MD_ELE_T *iterMD;
-                /*    Walk over the registered MDs */
-                for (iterMD = appHandle->pMDRcvQueue; iterMD != NULL; iterMD = iterMD->pNext )
-                {
-                    if (iterMD->privFlags & TRDP_MC_JOINT &&
-                        iterMD->socketIdx != -1)
-                    {
-                        /*    Join the MC group again    */
-                        ret = (TRDP_ERR_T) vos_sockJoinMC(appHandle->iface[iterMD->socketIdx].sock,
-                                                          iterMD->addr.mcGroup,
-                                                          appHandle->realIP);
-                    }
-                }
-            }
-#endif
+            /*    Join all MC groups of the socket pool again    */
+            ret = trdp_mcRejoin(appHandle);
             if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
             {
                 vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
@@ -1331,7 +1444,7 @@ EXT_DECL TRDP_ERR_T tlp_publish (
 
                 /*    Get a socket    */
                 ret = trdp_requestSocket(
-                        appHandle->iface,
+                        appHandle,
                         appHandle->pdDefault.port,
                         (pSendParam != NULL) ? pSendParam : &appHandle->pdDefault.sendParam,
                         srcIpAddr,
@@ -1432,6 +1545,8 @@ EXT_DECL TRDP_ERR_T tlp_publish (
 
             /*    Insert at front    */
             trdp_queueInsFirst(&appHandle->pSndQueue, pNewElement);
+            appHandle->stats.pd.numPub++;
+            trdp_initHist(appHandle, pNewElement);
 
             *pPubHandle = (TRDP_PUB_T) pNewElement;
 
@@ -1563,13 +1678,15 @@ TRDP_ERR_T  tlp_unpublish (
     {
         /*    Remove from queue?    */
         trdp_queueDelElement(&appHandle->pSndQueue, pElement);
-        trdp_releaseSocket(appHandle->iface, pElement->socketIdx, 0u, FALSE, VOS_INADDR_ANY);
+        appHandle->stats.pd.numPub--;
+        trdp_releaseSocket(appHandle, pElement->socketIdx, 0u, FALSE, VOS_INADDR_ANY);
         pElement->magic = 0u;
         if (pElement->pSeqCntList != NULL)
         {
             vos_memFree(pElement->pSeqCntList);
         }
         vos_memFree(pElement->pFrame);
+        trdp_releaseHist(appHandle, pElement);
         vos_memFree(pElement);
 
         /* Re-compute distribution times */
@@ -1696,6 +1813,7 @@ EXT_DECL TRDP_ERR_T tlc_getInterval (
 #if MD_SUPPORT
                 trdp_mdCheckPending(appHandle, pFileDesc, pNoDesc);
 #endif
+                trdp_statsCheckPending(appHandle);
 
                 /*    if next job time is known, return the time-out value to the caller   */
                 if (timerisset(&appHandle->nextJob) &&
@@ -1715,6 +1833,21 @@ EXT_DECL TRDP_ERR_T tlc_getInterval (
                     pInterval->tv_usec  = 0;                                /* Application should limit this    */
                 }
 
+                /*    Work deferred by the process budget is done immediately   */
+                if (appHandle->deferred)
+                {
+                    vos_clearTime(pInterval);
+                }
+
+#if MD_SUPPORT
+                /*    Descriptors and timeouts of the resolver, if initialised   */
+                if (appHandle->pfUserInterval != NULL)
+                {
+                    (void) appHandle->pfUserInterval(appHandle, pInterval, pFileDesc, pNoDesc);
+                }
+#endif
+                appHandle->lastInterval = *pInterval;
+
                 if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
                 {
                     vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
@@ -1745,6 +1878,10 @@ EXT_DECL TRDP_ERR_T tlc_process (
 {
     TRDP_ERR_T  result = TRDP_NO_ERR;
     TRDP_ERR_T  err;
+    TRDP_TIME_T start;
+    TRDP_TIME_T phaseStart;
+    UINT32      time;
+    BOOL8       mayDefer;
 
     if (!trdp_isValidSession(appHandle))
     {
@@ -1757,13 +1894,21 @@ EXT_DECL TRDP_ERR_T tlc_process (
     }
     else
     {
+        TRDP_TRACE_PHASE(appHandle, TRDP_TRACE_BEGIN, TRDP_TRACE_PROCESS);
         vos_clearTime(&appHandle->nextJob);
+        vos_getTime(&start);
+        phaseStart  = start;
+        mayDefer    = !appHandle->deferred;
+        appHandle->deferred = FALSE;
 
         /******************************************************
          Find and send the packets which have to be sent next:
          ******************************************************/
 
+        TRDP_TRACE_PHASE(appHandle, TRDP_TRACE_BEGIN, TRDP_TRACE_PD_SEND);
         err = trdp_pdSendQueued(appHandle);
+        TRDP_TRACE_PHASE(appHandle, TRDP_TRACE_END, TRDP_TRACE_PD_SEND);
+        trdp_processPhase(appHandle, TRDP_TRACE_PD_SEND, &phaseStart);
 
         if (err != TRDP_NO_ERR)
         {
@@ -1775,22 +1920,34 @@ EXT_DECL TRDP_ERR_T tlc_process (
         /******************************************************
          Find packets which are pending/overdue
          ******************************************************/
+        TRDP_TRACE_PHASE(appHandle, TRDP_TRACE_BEGIN, TRDP_TRACE_PD_TIMEOUT);
         trdp_pdHandleTimeOuts(appHandle);
+        TRDP_TRACE_PHASE(appHandle, TRDP_TRACE_END, TRDP_TRACE_PD_TIMEOUT);
+        trdp_processPhase(appHandle, TRDP_TRACE_PD_TIMEOUT, &phaseStart);
 
 #if MD_SUPPORT
 
-        err = trdp_mdSend(appHandle);
-        if (err != TRDP_NO_ERR)
+        /******************************************************
+         MD and statistics are deferred if the budget is exceeded
+         ******************************************************/
+        if (!trdp_processDefer(appHandle, mayDefer, &start, &phaseStart))
         {
-            if (err == TRDP_IO_ERR)
+            TRDP_TRACE_PHASE(appHandle, TRDP_TRACE_BEGIN, TRDP_TRACE_MD_SEND);
+            err = trdp_mdSend(appHandle);
+            TRDP_TRACE_PHASE(appHandle, TRDP_TRACE_END, TRDP_TRACE_MD_SEND);
+            trdp_processPhase(appHandle, TRDP_TRACE_MD_SEND, &phaseStart);
+            if (err != TRDP_NO_ERR)
             {
-                vos_printLogStr(VOS_LOG_INFO, "trdp_mdSend() incomplete \n");
+                if (err == TRDP_IO_ERR)
+                {
+                    vos_printLogStr(VOS_LOG_INFO, "trdp_mdSend() incomplete \n");
 
-            }
-            else
-            {
-                result = err;
-                vos_printLog(VOS_LOG_ERROR, "trdp_mdSend() failed (Err: %d)\n", err);
+                }
+                else
+                {
+                    result = err;
+                    vos_printLog(VOS_LOG_ERROR, "trdp_mdSend() failed (Err: %d)\n", err);
+                }
             }
         }
 
@@ -1799,7 +1956,10 @@ EXT_DECL TRDP_ERR_T tlc_process (
         /******************************************************
          Find packets which are to be received
          ******************************************************/
+        TRDP_TRACE_PHASE(appHandle, TRDP_TRACE_BEGIN, TRDP_TRACE_PD_RECEIVE);
         err = trdp_pdCheckListenSocks(appHandle, pRfds, pCount);
+        TRDP_TRACE_PHASE(appHandle, TRDP_TRACE_END, TRDP_TRACE_PD_RECEIVE);
+        trdp_processPhase(appHandle, TRDP_TRACE_PD_RECEIVE, &phaseStart);
         if (err != TRDP_NO_ERR)
         {
             /*  We do not break here */
@@ -1808,12 +1968,67 @@ EXT_DECL TRDP_ERR_T tlc_process (
 
 #if MD_SUPPORT
 
-        trdp_mdCheckListenSocks(appHandle, pRfds, pCount);
+        if (!trdp_processDefer(appHandle, mayDefer, &start, &phaseStart))
+        {
+            TRDP_TRACE_PHASE(appHandle, TRDP_TRACE_BEGIN, TRDP_TRACE_MD_RECEIVE);
+            trdp_mdCheckListenSocks(appHandle, pRfds, pCount);
+
+            /*  Replies and timeouts of the resolver, if initialised   */
+            if (appHandle->pfUserProcess != NULL)
+            {
+                (void) appHandle->pfUserProcess(appHandle, pRfds, pCount);
+            }
+            TRDP_TRACE_PHASE(appHandle, TRDP_TRACE_END, TRDP_TRACE_MD_RECEIVE);
+            trdp_processPhase(appHandle, TRDP_TRACE_MD_RECEIVE, &phaseStart);
+        }
 
-        trdp_mdCheckTimeouts(appHandle);
+        if (!trdp_processDefer(appHandle, mayDefer, &start, &phaseStart))
+        {
+            TRDP_TRACE_PHASE(appHandle, TRDP_TRACE_BEGIN, TRDP_TRACE_MD_TIMEOUT);
+            trdp_mdCheckTimeouts(appHandle);
+            TRDP_TRACE_PHASE(appHandle, TRDP_TRACE_END, TRDP_TRACE_MD_TIMEOUT);
+            trdp_processPhase(appHandle, TRDP_TRACE_MD_TIMEOUT, &phaseStart);
+        }
 
 #endif
 
+        /******************************************************
+         Publish a statistics snapshot, if due
+         ******************************************************/
+        if (!trdp_processDefer(appHandle, mayDefer, &start, &phaseStart))
+        {
+            TRDP_TRACE_PHASE(appHandle, TRDP_TRACE_BEGIN, TRDP_TRACE_STATS);
+            trdp_exportStats(appHandle);
+            TRDP_TRACE_PHASE(appHandle, TRDP_TRACE_END, TRDP_TRACE_STATS);
+            trdp_processPhase(appHandle, TRDP_TRACE_STATS, &phaseStart);
+        }
+
+        /******************************************************
+         Account the whole call
+         ******************************************************/
+        time = trdp_usBetween(&start, &phaseStart);
+        appHandle->stats.process.numCycles++;
+        appHandle->stats.process.phaseTime[TRDP_TRACE_PROCESS] += time;
+        if (time > appHandle->stats.process.phaseMax[TRDP_TRACE_PROCESS])
+        {
+            appHandle->stats.process.phaseMax[TRDP_TRACE_PROCESS] = time;
+        }
+        if ((appHandle->stats.process.budget != 0u) && (time > appHandle->stats.process.budget))
+        {
+            appHandle->stats.process.numOverBudget++;
+        }
+        if (appHandle->deferred)
+        {
+            appHandle->stats.process.numDeferred++;
+        }
+        if (timerisset(&appHandle->lastInterval) &&
+            (time > (UINT32) appHandle->lastInterval.tv_sec * 1000000u + (UINT32) appHandle->lastInterval.tv_usec))
+        {
+            appHandle->stats.process.numOverrun++;
+        }
+        vos_clearTime(&appHandle->lastInterval);
+        TRDP_TRACE_PHASE(appHandle, TRDP_TRACE_END, TRDP_TRACE_PROCESS);
+
         if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
         {
             vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
@@ -1823,6 +2038,36 @@ EXT_DECL TRDP_ERR_T tlc_process (
     return result;
 }
 
+/**********************************************************************************************************************/
+/** Set the processing budget of tlc_process.
+ *
+ *  @param[in]      appHandle           The handle returned by tlc_openSession
+ *  @param[in]      budget              budget in us, 0 = no budget
+ *
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ */
+EXT_DECL TRDP_ERR_T tlc_setProcessBudget (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              budget)
+{
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    appHandle->stats.process.budget = budget;
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+    return TRDP_NO_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Initiate sending PD messages (PULL).
  *  Send a PD request message
@@ -1942,7 +2187,7 @@ EXT_DECL TRDP_ERR_T tlp_request (
             else
             {
                 /*    Get a socket    */
-                ret = trdp_requestSocket(appHandle->iface,
+                ret = trdp_requestSocket(appHandle,
                                          appHandle->pdDefault.port,
                                          (pSendParam != NULL) ? pSendParam : &appHandle->pdDefault.sendParam,
                                          srcIpAddr,
@@ -2032,6 +2277,10 @@ EXT_DECL TRDP_ERR_T tlp_request (
 /** Prepare for receiving PD messages.
  *  Subscribe to a specific PD ComID and source IP.
  *
+ *  With TRDP_OPTION_MC_SOURCE_FILTER and a single source IP the group is joined for that source only (SSM).
+ *  The kernel applies this source filter per socket, not per group: other sockets bound to the same port
+ *  (e.g. of another session) and joined to the group for any source still receive it unfiltered.
+ *
  *  @param[in]      appHandle           the handle returned by tlc_openSession
  *  @param[out]     pSubHandle          return a handle for this subscription
  *  @param[in]      pUserRef            user supplied value returned within the info structure
@@ -2070,6 +2319,7 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
     TRDP_TIME_T         now;
     TRDP_ERR_T          ret = TRDP_NO_ERR;
     TRDP_ADDRESSES_T    subHandle;
+    TRDP_IP_ADDR_T      mcSource;
     INT32 lIndex;
 
     /*    Check params    */
@@ -2114,6 +2364,7 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
     {
         subHandle.mcGroup = 0u;
     }
+    mcSource = trdp_mcSourceFilter(appHandle, subHandle.mcGroup, srcIpAddr1, srcIpAddr2);
 
     /*    Get the current time    */
     vos_getTime(&now);
@@ -2129,7 +2380,7 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
         subHandle.etbTopoCnt    = etbTopoCnt;
 
         /*    Find a (new) socket    */
-        ret = trdp_requestSocket(appHandle->iface,
+        ret = trdp_requestSocket(appHandle,
                                  appHandle->pdDefault.port,
                                  &appHandle->pdDefault.sendParam,
                                  appHandle->realIP,
@@ -2139,7 +2390,7 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
                                  TRUE,
                                  -1,
                                  &lIndex,
-                                 0u);
+                                 mcSource);
 
         if (ret == TRDP_NO_ERR)
         {
@@ -2153,7 +2404,6 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
             if (newPD == NULL)
             {
                 ret = TRDP_MEM_ERR;
-                trdp_releaseSocket(appHandle->iface, lIndex, 0u, FALSE, VOS_INADDR_ANY);
             }
             else
             {
@@ -2172,6 +2422,10 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
                     {
                         newPD->addr.mcGroup = destIpAddr;
                         newPD->privFlags    |= TRDP_MC_JOINT;
+                        if (mcSource != VOS_INADDR_ANY)
+                        {
+                            newPD->privFlags |= TRDP_MC_SSM;
+                        }
                     }
                     else
                     {
@@ -2210,10 +2464,21 @@ EXT_DECL TRDP_ERR_T tlp_subscribe (
 
                     /*  append this subscription to our receive queue */
                     trdp_queueAppLast(&appHandle->pRcvQueue, newPD);
+                    appHandle->stats.pd.numSubs++;
+                    trdp_initHist(appHandle, newPD);
 
                     *pSubHandle = (TRDP_SUB_T) newPD;
+
+                    /*  let the kernel pass the new ComId  */
+                    trdp_pdUpdateFilter(appHandle);
                 }
             }
+
+            if (ret != TRDP_NO_ERR)
+            {
+                trdp_mcLeave(appHandle, lIndex, subHandle.mcGroup, mcSource);
+                trdp_releaseSocket(appHandle, lIndex, 0u, FALSE, VOS_INADDR_ANY);
+            }
         } /*lint !e438 unused newPD */
     }
 
@@ -2264,15 +2529,17 @@ EXT_DECL TRDP_ERR_T tlp_unsubscribe (
     ret = (TRDP_ERR_T) vos_mutexLock(appHandle->mutex);
     if (ret == TRDP_NO_ERR)
     {
-        TRDP_IP_ADDR_T mcGroup = pElement->addr.mcGroup;
         /*    Remove from queue?    */
         trdp_queueDelElement(&appHandle->pRcvQueue, pElement);
-        /*    if we subscribed to an MC-group, check if anyone else did too: */
-        if (mcGroup != VOS_INADDR_ANY)
+        appHandle->stats.pd.numSubs--;
+        /*    if we subscribed to an MC-group, drop our membership (left if nobody else uses it): */
+        if (pElement->addr.mcGroup != VOS_INADDR_ANY)
         {
-            mcGroup = trdp_findMCjoins(appHandle, mcGroup);
+            trdp_mcLeave(appHandle, pElement->socketIdx, pElement->addr.mcGroup,
+                         (pElement->privFlags & TRDP_MC_SSM) ? pElement->addr.srcIpAddr : VOS_INADDR_ANY);
         }
-        trdp_releaseSocket(appHandle->iface, pElement->socketIdx, 0u, FALSE, mcGroup);
+        trdp_releaseSocket(appHandle, pElement->socketIdx, 0u, FALSE, VOS_INADDR_ANY);
+        trdp_pdUpdateFilter(appHandle);
         pElement->magic = 0u;
         if (pElement->pFrame != NULL)
         {
@@ -2282,6 +2549,7 @@ EXT_DECL TRDP_ERR_T tlp_unsubscribe (
         {
             vos_memFree(pElement->pSeqCntList);
         }
+        trdp_releaseHist(appHandle, pElement);
         vos_memFree(pElement);
         ret = TRDP_NO_ERR;
         if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
@@ -2321,7 +2589,9 @@ EXT_DECL TRDP_ERR_T tlp_resubscribe (
     TRDP_IP_ADDR_T      srcIpAddr2,
     TRDP_IP_ADDR_T      destIpAddr)
 {
-    TRDP_ERR_T ret = TRDP_NO_ERR;
+    TRDP_ERR_T      ret = TRDP_NO_ERR;
+    TRDP_IP_ADDR_T  oldMcGroup;
+    TRDP_IP_ADDR_T  oldMcSource;
 
     /*    Check params    */
 
@@ -2342,6 +2612,9 @@ EXT_DECL TRDP_ERR_T tlp_resubscribe (
     }
 
     /*  Change the addressing item   */
+    oldMcGroup  = subHandle->addr.mcGroup;
+    oldMcSource = (subHandle->privFlags & TRDP_MC_SSM) ? subHandle->addr.srcIpAddr : VOS_INADDR_ANY;
+
     subHandle->addr.srcIpAddr   = srcIpAddr1;
     subHandle->addr.srcIpAddr2  = srcIpAddr2;
     subHandle->addr.destIpAddr  = destIpAddr;
@@ -2351,13 +2624,18 @@ EXT_DECL TRDP_ERR_T tlp_resubscribe (
 
     if (vos_isMulticast(destIpAddr))
     {
+        TRDP_IP_ADDR_T mcSource = trdp_mcSourceFilter(appHandle, destIpAddr, srcIpAddr1, srcIpAddr2);
+
         /* For multicast subscriptions, we might need to change the socket joins */
-        if (subHandle->addr.mcGroup != destIpAddr)
+        if ((oldMcGroup != destIpAddr) || (oldMcSource != mcSource))
         {
             /*  Find the correct socket
              Release old usage first, we unsubscribe to the former MC group, because it is not valid anymore */
-            trdp_releaseSocket(appHandle->iface, subHandle->socketIdx, 0u, FALSE, subHandle->addr.mcGroup);
-            ret = trdp_requestSocket(appHandle->iface,
+            trdp_mcLeave(appHandle, subHandle->socketIdx, oldMcGroup, oldMcSource);
+            trdp_releaseSocket(appHandle, subHandle->socketIdx, 0u, FALSE, VOS_INADDR_ANY);
+            subHandle->addr.mcGroup = 0u;
+            subHandle->privFlags    &= (TRDP_PRIV_FLAGS_T) ~(TRDP_MC_JOINT | TRDP_MC_SSM);
+            ret = trdp_requestSocket(appHandle,
                                      appHandle->pdDefault.port,
                                      &appHandle->pdDefault.sendParam,
                                      appHandle->realIP,
@@ -2367,7 +2645,7 @@ EXT_DECL TRDP_ERR_T tlp_resubscribe (
                                      TRUE,
                                      -1,
                                      &subHandle->socketIdx,
-                                     0u);
+                                     mcSource);
             if (ret != TRDP_NO_ERR)
             {
                 /* This is a critical error: We must unsubscribe! */
@@ -2377,16 +2655,22 @@ EXT_DECL TRDP_ERR_T tlp_resubscribe (
             else
             {
                 subHandle->addr.mcGroup = destIpAddr;
+                subHandle->privFlags    |= TRDP_MC_JOINT;
+                if (mcSource != VOS_INADDR_ANY)
+                {
+                    subHandle->privFlags |= TRDP_MC_SSM;
+                }
+                /*  the socket might be a new one */
+                trdp_pdUpdateFilter(appHandle);
             }
         }
-        else
-        {
-            subHandle->addr.mcGroup = destIpAddr;
-        }
     }
     else
     {
+        /* No multicast anymore, drop the former membership */
+        trdp_mcLeave(appHandle, subHandle->socketIdx, oldMcGroup, oldMcSource);
         subHandle->addr.mcGroup = 0u;
+        subHandle->privFlags    &= (TRDP_PRIV_FLAGS_T) ~(TRDP_MC_JOINT | TRDP_MC_SSM);
     }
 
     if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
@@ -2808,7 +3092,7 @@ EXT_DECL TRDP_ERR_T  tlm_addListener (
                 {
                     /* socket to receive UDP MD */
                     errv = trdp_requestSocket(
-                            appHandle->iface,
+                            appHandle,
                             appHandle->mdDefault.udpPort,
                             &appHandle->mdDefault.sendParam,
                             appHandle->realIP,
@@ -2931,16 +3215,12 @@ TRDP_ERR_T tlm_delListener (
             /* cleanup instance */
             if (pDelete->socketIdx != -1)
             {
-                TRDP_IP_ADDR_T mcGroup = VOS_INADDR_ANY;
-                if (pDelete->addr.mcGroup != VOS_INADDR_ANY)
-                {
-                    mcGroup = trdp_findMCjoins(appHandle, pDelete->addr.mcGroup);
-                }
-                trdp_releaseSocket(appHandle->iface,
+                /* the MC group is left, if nobody else uses it on this socket */
+                trdp_releaseSocket(appHandle,
                                    pDelete->socketIdx,
                                    appHandle->mdDefault.connectTimeout,
                                    FALSE,
-                                   mcGroup);
+                                   pDelete->addr.mcGroup);
             }
             /* free memory space for element */
             vos_memFree(pDelete);
@@ -3020,8 +3300,8 @@ EXT_DECL TRDP_ERR_T tlm_readdListener (
             pListener->addr.mcGroup != mcDestIpAddr)                /* nor if there's no change in group */
         {
             /*  Find the correct socket    */
-            trdp_releaseSocket(appHandle->iface, pListener->socketIdx, 0u, FALSE, mcDestIpAddr);
-            ret = trdp_requestSocket(appHandle->iface,
+            trdp_releaseSocket(appHandle, pListener->socketIdx, 0u, FALSE, pListener->addr.mcGroup);
+            ret = trdp_requestSocket(appHandle,
                                      appHandle->mdDefault.udpPort,
                                      &appHandle->mdDefault.sendParam,
                                      appHandle->realIP,
@@ -19,6 +19,12 @@
  *
  * $Id: trdp_mdcom.c 1807 2018-11-15 12:56:26Z railroad-mike $
  *
+ *      AG 2026-10-19: trdp_mdReply: request buffer freed after the reply data is copied (reply with request data)
+ *      AG 2026-10-19: Tracepoints for MD send, receive, timeout and callbacks (TRDP_TRACE)
+ *      AG 2026-10-19: Per-ComId counters for the statistics export
+ *      AG 2026-10-18: Socket index lookup by descriptor via the socket pool hash index
+ *      AG 2026-10-18: TCP MD: caller connection pool with pipelining (maxTcpPipeline) and pool statistics
+ *      AG 2026-10-18: TCP MD: TRDP_FLAGS_STREAM sends user data in place, received data is read into its final buffer
  *      BL 2018-11-07: Ticket #185 MD reply: Infinite timeout wrong handled
  *      BL 2018-11-07: Ticket #220 Message Data - Different behaviour UDP & TCP
  *      BL 2018-11-06: for-loops limited to sCurrentMaxSocketCnt instead VOS_MAX_SOCKET_CNT
@@ -65,6 +71,8 @@
 #include "trdp_if.h"
 #include "trdp_utils.h"
 #include "trdp_mdcom.h"
+#include "trdp_stats.h"
+#include "trdp_trace.h"
 
 
 /***********************************************************************************************************************
@@ -140,6 +148,10 @@ static TRDP_ERR_T   trdp_mdRecvPacket (TRDP_SESSION_PT  appHandle,
 static TRDP_ERR_T   trdp_mdRecv (TRDP_SESSION_PT    appHandle,
                                  UINT32             sockIndex);
 
+static UINT32       trdp_mdStreamSetup (TRDP_APP_SESSION_T  appHandle,
+                                        MD_ELE_T            *pElement,
+                                        const UINT8         *pData,
+                                        UINT32              dataSize);
 static void         trdp_mdDetailSenderPacket (const TRDP_MSG_T         msgType,
                                                const INT32              replyStatus,
                                                const UINT32             mdTimeOut,
@@ -156,6 +168,10 @@ static TRDP_ERR_T   trdp_mdSendME (TRDP_SESSION_PT  appHandle,
                                    MD_HEADER_T      *pH,
                                    INT32            replyStatus);
 
+static SOCKET       trdp_mdPooledSocket (TRDP_APP_SESSION_T         appHandle,
+                                         const TRDP_SEND_PARAM_T    *pSendParam,
+                                         TRDP_IP_ADDR_T             srcIpAddr,
+                                         TRDP_IP_ADDR_T             destIpAddr);
 static TRDP_ERR_T   trdp_mdConnectSocket (TRDP_APP_SESSION_T        appHandle,
                                           const TRDP_SEND_PARAM_T   *pSendParam,
                                           TRDP_IP_ADDR_T            srcIpAddr,
@@ -357,12 +373,14 @@ static void trdp_mdInvokeCallback (const MD_ELE_T           *pMdItem,
         theMessage.etbTopoCnt   = vos_ntohl(pMdItem->pPacket->frameHead.etbTopoCnt);
         theMessage.opTrnTopoCnt = vos_ntohl(pMdItem->pPacket->frameHead.opTrnTopoCnt);
         theMessage.srcIpAddr    = pMdItem->addr.srcIpAddr;
+        TRDP_TRACE_EVENT(appHandle, TRDP_TRACE_CB_BEGIN, theMessage.comId, 0u);
         pMdItem->pfCbFunction(
             appHandle->mdDefault.pRefCon,
             appHandle,
             &theMessage,
-            (UINT8 *)(pMdItem->pPacket->data),
+            (pMdItem->pStreamData != NULL) ? (UINT8 *) pMdItem->pStreamData : (UINT8 *)(pMdItem->pPacket->data),
             vos_ntohl(pMdItem->pPacket->frameHead.datasetLength));
+        TRDP_TRACE_EVENT(appHandle, TRDP_TRACE_CB_END, theMessage.comId, 0u);
     }
     else
     {
@@ -371,12 +389,14 @@ static void trdp_mdInvokeCallback (const MD_ELE_T           *pMdItem,
         theMessage.opTrnTopoCnt = pMdItem->addr.opTrnTopoCnt;
         theMessage.srcIpAddr    = 0u;
         /*in case of any detected turbulence return a zero buffer*/
+        TRDP_TRACE_EVENT(appHandle, TRDP_TRACE_CB_BEGIN, theMessage.comId, 0u);
         pMdItem->pfCbFunction(
             appHandle->mdDefault.pRefCon,
             appHandle,
             &theMessage,
             (UINT8 *)NULL,
             0u);
+        TRDP_TRACE_EVENT(appHandle, TRDP_TRACE_CB_END, theMessage.comId, 0u);
     }
 }
 
@@ -424,6 +444,8 @@ static BOOL8 trdp_mdTimeOutStateHandler ( MD_ELE_T *pElement, TRDP_SESSION_PT ap
                *pResult = TRDP_REPLYTO_ERR;
 
                appHandle->stats.tcpMd.numReplyTimeout++;
+               TRDP_STATS_COMID_ADD(appHandle, pElement->addr.comId, mdNumTimeout, 1u);
+               TRDP_TRACE_EVENT(appHandle, TRDP_TRACE_MD_TIMED_OUT, pElement->addr.comId, 0u);
            }
            else
            {
@@ -472,6 +494,8 @@ static BOOL8 trdp_mdTimeOutStateHandler ( MD_ELE_T *pElement, TRDP_SESSION_PT ap
                    }
                    /* Statistics */
                    appHandle->stats.udpMd.numReplyTimeout++;
+                   TRDP_STATS_COMID_ADD(appHandle, pElement->addr.comId, mdNumTimeout, 1u);
+                   TRDP_TRACE_EVENT(appHandle, TRDP_TRACE_MD_TIMED_OUT, pElement->addr.comId, 0u);
                }
 
                /* Manage send Confirm if no repetition */
@@ -507,10 +531,14 @@ static BOOL8 trdp_mdTimeOutStateHandler ( MD_ELE_T *pElement, TRDP_SESSION_PT ap
            if ((pElement->pktFlags & TRDP_FLAGS_TCP) != 0 )
            {
                appHandle->stats.tcpMd.numConfirmTimeout++;
+               TRDP_STATS_COMID_ADD(appHandle, pElement->addr.comId, mdNumTimeout, 1u);
+               TRDP_TRACE_EVENT(appHandle, TRDP_TRACE_MD_TIMED_OUT, pElement->addr.comId, 0u);
            }
            else
            {
                appHandle->stats.udpMd.numConfirmTimeout++;
+               TRDP_STATS_COMID_ADD(appHandle, pElement->addr.comId, mdNumTimeout, 1u);
+               TRDP_TRACE_EVENT(appHandle, TRDP_TRACE_MD_TIMED_OUT, pElement->addr.comId, 0u);
            }
            break;
        case TRDP_ST_TX_REPLY_RECEIVED:
@@ -602,6 +630,7 @@ static MD_ELE_T *trdp_mdHandleConfirmReply (TRDP_APP_SESSION_T appHandle, MD_HEA
             }
             /* and get the newly received data  */
             iterMD->pPacket     = appHandle->pMDRcvEle->pPacket;
+            iterMD->pStreamData = NULL;
             iterMD->dataSize    = vos_ntohl(pMdItemHeader->datasetLength);
             iterMD->grossSize   = appHandle->pMDRcvEle->grossSize;
 
@@ -707,7 +736,7 @@ static void trdp_mdCloseSessions (
     /* Check all the sockets */
     if (checkAllSockets == TRUE)
     {
-        trdp_releaseSocket(appHandle->iface, TRDP_INVALID_SOCKET_INDEX, 0, checkAllSockets, VOS_INADDR_ANY);
+        trdp_releaseSocket(appHandle, TRDP_INVALID_SOCKET_INDEX, 0, checkAllSockets, VOS_INADDR_ANY);
     }
 
     iterMD = appHandle->pMDSndQueue;
@@ -716,7 +745,7 @@ static void trdp_mdCloseSessions (
     {
         if (TRUE == iterMD->morituri)
         {
-            trdp_releaseSocket(appHandle->iface, iterMD->socketIdx, appHandle->mdDefault.connectTimeout,
+            trdp_releaseSocket(appHandle, iterMD->socketIdx, appHandle->mdDefault.connectTimeout,
                                FALSE, VOS_INADDR_ANY);
             trdp_MDqueueDelElement(&appHandle->pMDSndQueue, iterMD);
             vos_printLog(VOS_LOG_INFO, "Freeing %s MD caller session '%02x%02x%02x%02x%02x%02x%02x%02x'\n",
@@ -741,7 +770,7 @@ static void trdp_mdCloseSessions (
         {
             if (0 != (iterMD->pktFlags & TRDP_FLAGS_TCP))
             {
-                trdp_releaseSocket(appHandle->iface, iterMD->socketIdx, appHandle->mdDefault.connectTimeout,
+                trdp_releaseSocket(appHandle, iterMD->socketIdx, appHandle->mdDefault.connectTimeout,
                                    FALSE, VOS_INADDR_ANY);
             }
             trdp_MDqueueDelElement(&appHandle->pMDRcvQueue, iterMD);
@@ -766,6 +795,7 @@ static void trdp_mdCloseSessions (
                      "Replacing the old socket by the new one (New Socket: %d, Index: %d)\n",
                      (int) newSocket, (int) socketIndex);
 
+        trdp_unindexSocket(appHandle, socketIndex);
         appHandle->iface[socketIndex].sock = newSocket;
         appHandle->iface[socketIndex].rcvMostly = TRUE;
         appHandle->iface[socketIndex].tcpParams.notSend     = FALSE;
@@ -775,6 +805,7 @@ static void trdp_mdCloseSessions (
         appHandle->iface[socketIndex].tcpParams.addFileDesc = TRUE;
         appHandle->iface[socketIndex].tcpParams.connectionTimeout.tv_sec    = 0u;
         appHandle->iface[socketIndex].tcpParams.connectionTimeout.tv_usec   = 0;
+        trdp_indexSocket(appHandle, socketIndex);
     }
 }
 
@@ -979,7 +1010,41 @@ static TRDP_ERR_T  trdp_mdSendPacket (SOCKET    mdSock,
 
         pElement->sendSize = pElement->grossSize - tmpSndSize;
 
-        err = vos_sockSendTCP(mdSock, ((UINT8 *)&pElement->pPacket->frameHead) + tmpSndSize, &pElement->sendSize);
+        if (pElement->pStreamData != NULL)
+        {
+            /* Header, user data and padding are gathered from their own buffers, continue after the part
+               already sent */
+            static const UINT8  cPadding[4u];
+            VOS_IOVEC_T         ioVec[3u];
+            UINT32              ioVecCnt = 0u;
+            UINT32              offset   = tmpSndSize;
+            UINT32              i;
+
+            ioVec[0u].pBuffer   = (const UINT8 *)&pElement->pPacket->frameHead;
+            ioVec[0u].size      = sizeof(MD_HEADER_T);
+            ioVec[1u].pBuffer   = pElement->pStreamData;
+            ioVec[1u].size      = pElement->dataSize;
+            ioVec[2u].pBuffer   = cPadding;
+            ioVec[2u].size      = pElement->grossSize - sizeof(MD_HEADER_T) - pElement->dataSize;
+
+            for (i = 0u; i < 3u; i++)
+            {
+                if (offset >= ioVec[i].size)
+                {
+                    offset -= ioVec[i].size;
+                    continue;
+                }
+                ioVec[ioVecCnt].pBuffer = ioVec[i].pBuffer + offset;
+                ioVec[ioVecCnt].size    = ioVec[i].size - offset;
+                ioVecCnt++;
+                offset = 0u;
+            }
+            err = vos_sockSendTCPv(mdSock, ioVec, ioVecCnt, &pElement->sendSize);
+        }
+        else
+        {
+            err = vos_sockSendTCP(mdSock, ((UINT8 *)&pElement->pPacket->frameHead) + tmpSndSize, &pElement->sendSize);
+        }
         pElement->sendSize = tmpSndSize + pElement->sendSize;
     }
     else
@@ -1034,17 +1099,12 @@ static TRDP_ERR_T  trdp_mdSendPacket (SOCKET    mdSock,
 static TRDP_ERR_T trdp_mdRecvTCPPacket (TRDP_SESSION_PT appHandle, SOCKET mdSock, MD_ELE_T *pElement)
 {
     /* TCP receiver */
-    TRDP_ERR_T  err = TRDP_NO_ERR;
-    UINT32      size = 0u;                       /* Size of the all data read until now */
-    UINT32      dataSize        = 0u;            /* The pending data to read */
-    UINT32      socketIndex     = 0u;
-    UINT32      readSize        = 0u;            /* All the data read in this cycle (Header + Data) */
-    UINT32      readDataSize    = 0u;            /* All the data part read in this cycle (Data) */
-    BOOL8       noDataToRead    = FALSE;
-    UINT32      storedDataSize  = 0u;
-
-    /* Initialize to 0 the stored header size*/
-    UINT32      storedHeader = 0;
+    TRDP_ERR_T  err         = TRDP_NO_ERR;
+    UINT32      size        = 0u;               /* Size of the message read until now (Header + Data) */
+    UINT32      msgSize     = 0u;               /* Size of the complete message, known after the header */
+    UINT32      readSize    = 0u;               /* All the data read in this cycle (Header + Data) */
+    INT32       socketIndex;
+    MD_ELE_T    *pPending   = NULL;
 
     /* Initialize to 0 the pElement->dataSize
      * Once it is known, the message complete data size will be saved*/
@@ -1054,278 +1114,160 @@ static TRDP_ERR_T trdp_mdRecvTCPPacket (TRDP_SESSION_PT appHandle, SOCKET mdSock
     pElement->addr.destIpAddr = appHandle->realIP;
 
     /* Find the socket index */
-    for ( socketIndex = 0u; socketIndex < (UINT32)trdp_getCurrentMaxSocketCnt(); socketIndex++ )
-    {
-        if ( appHandle->iface[socketIndex].sock == mdSock )
-        {
-            break;
-        }
-    }
+    socketIndex = trdp_findSocketIndex(appHandle, mdSock);
 
-    if ( socketIndex >= (UINT32)trdp_getCurrentMaxSocketCnt() )
+    if ( socketIndex == TRDP_INVALID_SOCKET_INDEX )
     {
         vos_printLogStr(VOS_LOG_ERROR, "trdp_mdRecvPacket - Socket index out of range\n");
         return TRDP_UNKNOWN_ERR;
     }
 
-    /* Read Header */
-    if ((appHandle->uncompletedTCP[socketIndex] == NULL)
-        || ((appHandle->uncompletedTCP[socketIndex] != NULL)
-            && (appHandle->uncompletedTCP[socketIndex]->grossSize < sizeof(MD_HEADER_T))))
+    /* Continue an uncompleted message: its buffer already holds the part received before.
+       The buffers are swapped, the unused receive buffer is kept as spare in the uncompleted element. */
+    pPending = appHandle->uncompletedTCP[socketIndex];
+    if ( pPending != NULL )
     {
-        if ( appHandle->uncompletedTCP[socketIndex] == NULL )
-        {
-            readSize = sizeof(MD_HEADER_T);
-        }
-        else
-        {
-            /* If we have read some data before, read the rest */
-            readSize        = sizeof(MD_HEADER_T) - appHandle->uncompletedTCP[socketIndex]->grossSize;
-            storedHeader    = appHandle->uncompletedTCP[socketIndex]->grossSize;
-        }
-
-        if ( readSize > 0u )
-        {
-            err = (TRDP_ERR_T) vos_sockReceiveTCP(mdSock,
-                                                  ((UINT8 *)&pElement->pPacket->frameHead) + storedHeader,
-                                                  &readSize);
-
-            /* Add the read data size to the size read before */
-            size = storedHeader + readSize;
+        MD_PACKET_T *pSpare = pElement->pPacket;
 
-            if ( err == TRDP_NO_ERR
-                 && (appHandle->uncompletedTCP[socketIndex] != NULL)
-                 && (size >= sizeof(MD_HEADER_T))
-                 && appHandle->uncompletedTCP[socketIndex]->pPacket != NULL )     /* BL: Prevent NULL pointer access */
-            {
-                if ( trdp_mdCheck(appHandle, &pElement->pPacket->frameHead, size, CHECK_HEADER_ONLY) == TRDP_NO_ERR )
-                {
-                    /* Uncompleted Header, completed. Save some parameters in the uncompletedTCP structure */
-                    appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead.datasetLength =
-                        pElement->pPacket->frameHead.datasetLength;
-                    appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead.frameCheckSum =
-                        pElement->pPacket->frameHead.frameCheckSum;
-                }
-                else
-                {
-                    vos_printLogStr(VOS_LOG_INFO, "TCP MD header check failed\n");
-                    return TRDP_NODATA_ERR;
-                }
-            }
-        }
+        pElement->pPacket   = pPending->pPacket;
+        pPending->pPacket   = pSpare;
+        size = pPending->grossSize;
     }
 
-    /* Read Data */
-    if ((size >= sizeof(MD_HEADER_T))
-        || ((appHandle->uncompletedTCP[socketIndex] != NULL)
-            && (appHandle->uncompletedTCP[socketIndex]->grossSize >= sizeof(MD_HEADER_T))))
+    /* Read the header exactly, not to consume the beginning of a following message */
+    if ( size < sizeof(MD_HEADER_T))
     {
-        if ( appHandle->uncompletedTCP[socketIndex] == NULL || appHandle->uncompletedTCP[socketIndex]->pPacket == NULL )
-        {
-            /* Get the rest of the message length */
-            dataSize = vos_ntohl(pElement->pPacket->frameHead.datasetLength);
-
-            readDataSize        = trdp_packetSizeMD(dataSize - sizeof(MD_HEADER_T));
-            pElement->grossSize = trdp_packetSizeMD(dataSize);
-            pElement->dataSize  = dataSize;
-            dataSize = pElement->grossSize - sizeof(MD_HEADER_T);
-        }
-        else
-        {
-            /* Calculate the data size that is pending to read */
-            dataSize = vos_ntohl(appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead.datasetLength);
-
-            pElement->dataSize  = dataSize;
-            pElement->grossSize = trdp_packetSizeMD(dataSize);
+        readSize = sizeof(MD_HEADER_T) - size;
+        err = (TRDP_ERR_T) vos_sockReceiveTCP(mdSock,
+                                              ((UINT8 *)&pElement->pPacket->frameHead) + size,
+                                              &readSize);
+        size += readSize;
 
-            size = appHandle->uncompletedTCP[socketIndex]->grossSize + readSize;
-            dataSize        = dataSize - (size - sizeof(MD_HEADER_T));
-            readDataSize    = dataSize; /* trdp_packetSizeMD(dataSize); */
-        }
-
-        /* If all the Header is read, check if more memory is needed */
-        if ( size >= sizeof(MD_HEADER_T))
+        if ((err == TRDP_NO_ERR) && (size == sizeof(MD_HEADER_T)))
         {
-            if ( trdp_packetSizeMD(pElement->dataSize) > cMinimumMDSize )
+            if ( trdp_mdCheck(appHandle, &pElement->pPacket->frameHead, size, CHECK_HEADER_ONLY) != TRDP_NO_ERR )
             {
-                /* we have to allocate a bigger buffer */
-                MD_PACKET_T *pBigData = (MD_PACKET_T *) vos_memAlloc(trdp_packetSizeMD(pElement->dataSize));
-                if ( pBigData == NULL )
+                /* Do not trust the announced length, trdp_mdRecvPacket() checks the header again and counts the
+                   error */
+                vos_printLogStr(VOS_LOG_INFO, "TCP MD header check failed\n");
+                err = TRDP_NO_ERR;
+                msgSize = size;
+            }
+            else
+            {
+                msgSize = trdp_packetSizeMD(vos_ntohl(pElement->pPacket->frameHead.datasetLength));
+
+                /* The final size is known now: get a buffer for the complete message once and
+                   receive the data directly into it. Only the header needs to be copied. */
+                if ( msgSize > cMinimumMDSize )
                 {
-                    return TRDP_MEM_ERR;
+                    MD_PACKET_T *pBigData = (MD_PACKET_T *) vos_memAlloc(msgSize);
+                    if ( pBigData == NULL )
+                    {
+                        err = TRDP_MEM_ERR;
+                    }
+                    else
+                    {
+                        memcpy(&pBigData->frameHead, &pElement->pPacket->frameHead, sizeof(MD_HEADER_T));
+                        vos_memFree(pElement->pPacket);
+                        pElement->pPacket = pBigData;
+                    }
                 }
-                /*  Swap the pointers ...  */
-                memcpy(((UINT8 *)&pBigData->frameHead) + storedHeader,
-                       ((UINT8 *)&pElement->pPacket->frameHead) + storedHeader,
-                       readSize);
-
-                vos_memFree(pElement->pPacket);
-                pElement->pPacket = pBigData;
             }
         }
+    }
+    else
+    {
+        msgSize = trdp_packetSizeMD(vos_ntohl(pElement->pPacket->frameHead.datasetLength));
+    }
 
-        if ( readDataSize > 0u )
-        {
-            err = (TRDP_ERR_T) vos_sockReceiveTCP(mdSock,
-                                                  ((UINT8 *)&pElement->pPacket->frameHead) + size,
-                                                  &readDataSize);
-
-            /* Add the read data size */
-            size = size + readDataSize;
+    /* Read Data */
+    if ((err == TRDP_NO_ERR) && (size >= sizeof(MD_HEADER_T)) && (size < msgSize))
+    {
+        UINT32 readDataSize = msgSize - size;
 
-            /* Add the read Data size to the size read during this cycle */
-            readSize = readSize + readDataSize;
-        }
+        err = (TRDP_ERR_T) vos_sockReceiveTCP(mdSock,
+                                              ((UINT8 *)&pElement->pPacket->frameHead) + size,
+                                              &readDataSize);
+        size        += readDataSize;
+        readSize    += readDataSize;
     }
-    pElement->grossSize = size;
 
-    /* If the Header is incomplete, the data size will be "0". Otherwise it will be calculated. */
     switch ( err )
     {
-       case TRDP_NODATA_ERR:
-           vos_printLog(VOS_LOG_INFO, "vos_sockReceiveTCP - No data at socket %d\n", (int) mdSock);
-           return TRDP_NODATA_ERR;
+       case TRDP_NO_ERR:
        case TRDP_BLOCK_ERR:
-           if (((pElement->pktFlags & TRDP_FLAGS_TCP) != 0) && (readSize == 0u))
-           {
-               return TRDP_BLOCK_ERR;
-           }
            break;
-       case TRDP_NO_ERR:
+       case TRDP_NODATA_ERR:
+           vos_printLog(VOS_LOG_INFO, "vos_sockReceiveTCP - No data at socket %d\n", (int) mdSock);
            break;
        default:
            vos_printLog(VOS_LOG_ERROR, "vos_sockReceiveTCP failed (Err: %d, Socket: %d)\n", err, (int) mdSock);
-           return err;
+           break;
     }
-    /* All the data (Header + Data) stored in the uncompletedTCP[] array */
-    /* Check if it's necessary to read some data */
-    if ( pElement->grossSize == sizeof(MD_HEADER_T))
+
+    if ((err != TRDP_NO_ERR) && (err != TRDP_BLOCK_ERR))
     {
-        if ( dataSize == 0u )
+        /* The connection is lost or out of sync, drop the uncompleted message */
+        if ( pPending != NULL )
         {
-            noDataToRead = TRUE;
+            vos_memFree(pPending->pPacket);
+            vos_memFree(pPending);
+            appHandle->uncompletedTCP[socketIndex] = NULL;
         }
+        return err;
     }
 
-    /* Compare if all the data has been read */
-    if (((pElement->grossSize < sizeof(MD_HEADER_T)) && (readDataSize == 0u))
-        ||
-        ((noDataToRead == FALSE) && (readDataSize != dataSize)))
+    if ((size < sizeof(MD_HEADER_T)) || (size < msgSize))
     {
         /* Uncompleted message received */
-
-        if ( appHandle->uncompletedTCP[socketIndex] == NULL )
+        if ( size == 0u )
         {
-            /* It is the first loop, no data stored yet. Allocate memory for the message */
-            appHandle->uncompletedTCP[socketIndex] = (MD_ELE_T *) vos_memAlloc(sizeof(MD_ELE_T));
+            return TRDP_BLOCK_ERR;
+        }
 
-            if ( appHandle->uncompletedTCP[socketIndex] == NULL )
+        if ( pPending == NULL )
+        {
+            /* It is the first loop, keep the buffer until the rest of the message arrives */
+            pPending = (MD_ELE_T *) vos_memAlloc(sizeof(MD_ELE_T));
+            if ( pPending == NULL )
             {
-                /* vos_memDelete(NULL); */
                 vos_printLogStr(VOS_LOG_ERROR, "vos_memAlloc() failed\n");
                 return TRDP_MEM_ERR;
             }
-
-            /* Check the memory that is needed */
-            if ( trdp_packetSizeMD(pElement->dataSize) < cMinimumMDSize )
-            {
-                /* Allocate the cMinimumMDSize memory at least for now*/
-                appHandle->uncompletedTCP[socketIndex]->pPacket = (MD_PACKET_T *) vos_memAlloc(cMinimumMDSize);
-            }
-            else
-            {
-                /* Allocate the dataSize memory */
-                /* we have to allocate a bigger buffer */
-                appHandle->uncompletedTCP[socketIndex]->pPacket =
-                    (MD_PACKET_T *) vos_memAlloc(trdp_packetSizeMD(pElement->dataSize));
-            }
-
-            if ( appHandle->uncompletedTCP[socketIndex]->pPacket == NULL )
-            {
-                return TRDP_MEM_ERR;
-            }
-
-            storedDataSize = 0;
+            appHandle->uncompletedTCP[socketIndex] = pPending;
         }
-        else
-        {
-            /* Get the size that have been already stored in the uncompletedTCP[] */
-            storedDataSize = appHandle->uncompletedTCP[socketIndex]->grossSize;
 
-            if ((storedDataSize < sizeof(MD_HEADER_T))
-                && (pElement->grossSize > sizeof(MD_HEADER_T)))
-            {
-                if ( trdp_packetSizeMD(pElement->dataSize) > cMinimumMDSize )
-                {
-                    /* we have to allocate a bigger buffer */
-                    MD_PACKET_T *pBigData = (MD_PACKET_T *) vos_memAlloc(trdp_packetSizeMD(pElement->dataSize));
-                    if ( pBigData == NULL )
-                    {
-                        return TRDP_MEM_ERR;
-                    }
-
-                    /* Copy the data to the pBigData->frameHead */
-                    memcpy(((UINT8 *)&pBigData->frameHead),
-                           ((UINT8 *)&pElement->pPacket->frameHead),
-                           storedDataSize);
+        /* Hand the message buffer over, the receive element gets the spare buffer (if any) back */
+        {
+            MD_PACKET_T *pSpare = pPending->pPacket;
 
-                    /*  Swap the pointers ...  */
-                    vos_memFree(appHandle->uncompletedTCP[socketIndex]->pPacket);
-                    appHandle->uncompletedTCP[socketIndex]->pPacket = pBigData;
-                }
-            }
+            pPending->pPacket   = pElement->pPacket;
+            pPending->grossSize = size;
+            pElement->pPacket   = pSpare;
         }
 
-        if ( readSize > 0u )
-        {
-            /* Copy the read data in the uncompletedTCP[] */
-            memcpy(((UINT8 *)&appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead) + storedDataSize,
-                   ((UINT8 *)&pElement->pPacket->frameHead) + storedDataSize, readSize);
-            appHandle->uncompletedTCP[socketIndex]->grossSize   = pElement->grossSize;
-            appHandle->uncompletedTCP[socketIndex]->dataSize    = readDataSize;
-        }
-        else
+        if ( readSize == 0u )
         {
-            vos_printLog(VOS_LOG_DBG, "Received TCP - readSize = 0 (Socket: %d)\n", (int) mdSock);
-            return TRDP_PARAM_ERR;
+            return TRDP_BLOCK_ERR;
         }
-
         return TRDP_PACKET_ERR;
     }
-    else
+
+    /* Complete message */
+    if ( pPending != NULL )
     {
-        /* Complete message */
-        /* All data is read. Save all the data and copy to the pElement to continue */
-        if ( appHandle->uncompletedTCP[socketIndex] != NULL )
+        if ( pPending->pPacket != NULL )
         {
-            /* Add the received information and copy all the data to the pElement */
-            storedDataSize = appHandle->uncompletedTCP[socketIndex]->grossSize;
-
-            if ((readSize > 0u) &&
-                appHandle->uncompletedTCP[socketIndex]->pPacket != NULL )
-            {
-                /* Copy the read data in the uncompletedTCP[] */
-                memcpy(((UINT8 *)&appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead) + storedDataSize,
-                       ((UINT8 *)&pElement->pPacket->frameHead) + storedDataSize, readSize);
-
-                /* Copy all the uncompletedTCP data to the pElement */
-                memcpy(((UINT8 *)&pElement->pPacket->frameHead),
-                       ((UINT8 *)&appHandle->uncompletedTCP[socketIndex]->pPacket->frameHead), pElement->grossSize);
-
-                /* Disallocate the memory */
-                /* 1st free data buffer - independant pointer */
-                vos_memFree(appHandle->uncompletedTCP[socketIndex]->pPacket);
-                /* 2nd free socket element */
-                vos_memFree(appHandle->uncompletedTCP[socketIndex]);
-                appHandle->uncompletedTCP[socketIndex] = NULL;
-            }
-            else
-            {
-                vos_printLog(VOS_LOG_DBG, "vos_sockReceiveTCP - readSize = 0 (Socket: %d)\n", (int) mdSock);
-                return TRDP_PARAM_ERR;
-            }
+            vos_memFree(pPending->pPacket);
         }
+        vos_memFree(pPending);
+        appHandle->uncompletedTCP[socketIndex] = NULL;
     }
+
+    pElement->grossSize = size;
+    pElement->dataSize  = vos_ntohl(pElement->pPacket->frameHead.datasetLength);
+
     return TRDP_NO_ERR;
 }
 
@@ -1486,6 +1428,9 @@ static TRDP_ERR_T  trdp_mdRecvPacket (
     {
        case TRDP_NO_ERR:
            pElementStatistics->numRcv++;
+           TRDP_STATS_COMID_ADD(appHandle, vos_ntohl(pElement->pPacket->frameHead.comId), mdNumRcv, 1u);
+           TRDP_TRACE_EVENT(appHandle, TRDP_TRACE_MD_RECEIVED, vos_ntohl(pElement->pPacket->frameHead.comId),
+                            pElement->grossSize);
            break;
        case TRDP_CRC_ERR:
            pElementStatistics->numCrcErr++;
@@ -2328,6 +2273,8 @@ TRDP_ERR_T  trdp_mdSend (
                             /* increment transmission counter for UDP */
                             appHandle->stats.udpMd.numSend++;
                         }
+                        TRDP_STATS_COMID_ADD(appHandle, iterMD->addr.comId, mdNumSend, 1u);
+                        TRDP_TRACE_EVENT(appHandle, TRDP_TRACE_MD_SENT, iterMD->addr.comId, iterMD->grossSize);
 
                         if (nextstate == TRDP_ST_RX_REPLYQUERY_W4C)
                         {
@@ -2380,7 +2327,9 @@ TRDP_ERR_T  trdp_mdSend (
                     }
                     else
                     {
-                        if (result == TRDP_IO_ERR)
+                        /* A TCP connection still being established or a full send buffer blocks: retry later */
+                        if ((result == TRDP_IO_ERR)
+                            || ((result == TRDP_BLOCK_ERR) && ((iterMD->pktFlags & TRDP_FLAGS_TCP) != 0)))
                         {
                             /* Send uncompleted */
                             if ((iterMD->pktFlags & TRDP_FLAGS_TCP) != 0)
@@ -2473,7 +2422,7 @@ void trdp_mdCheckPending (
         }
     }
 
-    for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(); lIndex++)
+    for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(appHandle); lIndex++)
     {
         if ((appHandle->iface[lIndex].sock != VOS_INVALID_SOCKET)
             && (appHandle->iface[lIndex].type == TRDP_SOCK_MD_TCP)
@@ -2613,7 +2562,7 @@ void  trdp_mdCheckListenSocks (
         }
 
         /* scan for sockets */
-        for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(); lIndex++)
+        for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(appHandle); lIndex++)
         {
             if (appHandle->iface[lIndex].sock != VOS_INVALID_SOCKET &&
                 appHandle->iface[lIndex].type != TRDP_SOCK_PD
@@ -2744,7 +2693,7 @@ void  trdp_mdCheckListenSocks (
                     INT32   socketIndex;
                     BOOL8   socketFound = FALSE;
 
-                    for (socketIndex = 0; socketIndex < trdp_getCurrentMaxSocketCnt(); socketIndex++)
+                    for (socketIndex = 0; socketIndex < trdp_getCurrentMaxSocketCnt(appHandle); socketIndex++)
                     {
                         if ((appHandle->iface[socketIndex].sock != VOS_INVALID_SOCKET)
                             && (appHandle->iface[socketIndex].type == TRDP_SOCK_MD_TCP)
@@ -2793,7 +2742,7 @@ void  trdp_mdCheckListenSocks (
                            session instantiated. The socket/connection will be closed when the session has finished.
                          */
                         err = trdp_requestSocket(
-                                appHandle->iface,
+                                appHandle,
                                 appHandle->mdDefault.tcpPort,
                                 &appHandle->mdDefault.sendParam,
                                 appHandle->realIP,
@@ -2825,7 +2774,7 @@ void  trdp_mdCheckListenSocks (
     /* Check Receive Data (UDP & TCP) */
     /*  Loop through the socket list and check readiness
         (but only while there are ready descriptors left) */
-    for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(); lIndex++)
+    for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(appHandle); lIndex++)
     {
         if (appHandle->iface[lIndex].sock != VOS_INVALID_SOCKET &&
             appHandle->iface[lIndex].type != TRDP_SOCK_PD &&
@@ -2955,7 +2904,7 @@ void  trdp_mdCheckTimeouts (
     {
         INT32 lIndex;
 
-        for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(); lIndex++)
+        for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(appHandle); lIndex++)
         {
             if ((appHandle->iface[lIndex].sock != VOS_INVALID_SOCKET)
                 && (appHandle->iface[lIndex].type == TRDP_SOCK_MD_TCP)
@@ -2968,6 +2917,7 @@ void  trdp_mdCheckTimeouts (
                 {
                     vos_printLog(VOS_LOG_INFO, "The socket (Num = %d) TIMEOUT\n", (int) appHandle->iface[lIndex].sock);
                     appHandle->iface[lIndex].tcpParams.morituri = TRUE;
+                    appHandle->tcpPoolStats.numIdleClosed++;
                 }
             }
         }
@@ -2977,7 +2927,7 @@ void  trdp_mdCheckTimeouts (
     {
         INT32 lIndex;
 
-        for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(); lIndex++)
+        for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(appHandle); lIndex++)
         {
             if ((appHandle->iface[lIndex].sock != VOS_INVALID_SOCKET)
                 && (appHandle->iface[lIndex].type == TRDP_SOCK_MD_TCP)
@@ -3019,6 +2969,53 @@ void  trdp_mdCheckTimeouts (
 
 
 
+/**********************************************************************************************************************/
+/** Find an open TCP connection to the given corner in the caller connection pool.
+ *  Connections are keyed by the corner IP and port; idle connections (kept until the connection timeout) are preferred.
+ *  A connection still in use is shared, if the configured pipelining depth (maxTcpPipeline) allows it.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pSendParam          send parameters of the new session
+ *  @param[in]      srcIpAddr           own IP address
+ *  @param[in]      destIpAddr          IP address of the other corner
+ *
+ *  @retval         socket of the connection to use or VOS_INVALID_SOCKET
+ */
+static SOCKET trdp_mdPooledSocket (TRDP_APP_SESSION_T       appHandle,
+                                   const TRDP_SEND_PARAM_T  *pSendParam,
+                                   TRDP_IP_ADDR_T           srcIpAddr,
+                                   TRDP_IP_ADDR_T           destIpAddr)
+{
+    TRDP_IP_ADDR_T  bindAddr    = vos_determineBindAddr(srcIpAddr, 0u, FALSE);
+    SOCKET          sock        = VOS_INVALID_SOCKET;
+    INT16           minUsage    = 0;
+    INT32           lIndex;
+
+    for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(appHandle); lIndex++)
+    {
+        const TRDP_SOCKETS_T *pIface = &appHandle->iface[lIndex];
+
+        if ((pIface->sock != VOS_INVALID_SOCKET)
+            && (pIface->type == TRDP_SOCK_MD_TCP)
+            && (pIface->rcvMostly == FALSE)
+            && (pIface->tcpParams.cornerIp == destIpAddr)
+            && (pIface->tcpParams.cornerPort == appHandle->mdDefault.tcpPort)
+            && (pIface->tcpParams.morituri == FALSE)
+            && (pIface->tcpParams.sendNotOk == FALSE)
+            && (pIface->bindAddr == bindAddr)
+            && (pIface->sendParam.qos == pSendParam->qos)
+            && (pIface->sendParam.ttl == pSendParam->ttl)
+            && ((UINT32) pIface->usage < appHandle->mdDefault.maxTcpPipeline)
+            && ((sock == VOS_INVALID_SOCKET) || (pIface->usage < minUsage)))
+        {
+            /* take the least used connection */
+            sock        = pIface->sock;
+            minUsage    = pIface->usage;
+        }
+    }
+    return sock;
+}
+
 /**********************************************************************************************************************/
 /*reply side functions*/
 static TRDP_ERR_T trdp_mdConnectSocket (TRDP_APP_SESSION_T      appHandle,
@@ -3034,16 +3031,18 @@ static TRDP_ERR_T trdp_mdConnectSocket (TRDP_APP_SESSION_T      appHandle,
     {
         if ( pSenderElement->socketIdx == TRDP_INVALID_SOCKET_INDEX )
         {
-            /* socket to send TCP MD for request or notify only */
-            err = trdp_requestSocket(appHandle->iface,
+            const TRDP_SEND_PARAM_T *pParam = (pSendParam != NULL) ? pSendParam : (&appHandle->mdDefault.sendParam);
+            TRDP_SOCKETS_T          *pIface;
+
+            /* socket to send TCP MD for request or notify only, take an open connection from the pool if possible */
+            err = trdp_requestSocket(appHandle,
                                      appHandle->mdDefault.tcpPort,
-                                     (pSendParam != NULL) ?
-                                     pSendParam : (&appHandle->mdDefault.sendParam),
+                                     pParam,
                                      srcIpAddr, 0, /* no TCP multicast possible */
                                      TRDP_SOCK_MD_TCP,
                                      TRDP_OPTION_NONE,
                                      FALSE,
-                                     VOS_INVALID_SOCKET,
+                                     trdp_mdPooledSocket(appHandle, pParam, srcIpAddr, destIpAddr),
                                      &pSenderElement->socketIdx,
                                      destIpAddr);
 
@@ -3052,10 +3051,31 @@ static TRDP_ERR_T trdp_mdConnectSocket (TRDP_APP_SESSION_T      appHandle,
                 /* Error getting socket, exit function */
                 return err;
             }
-        }
 
+            pIface = &appHandle->iface[pSenderElement->socketIdx];
+
+            if ( pIface->tcpParams.cornerPort == 0u )
+            {
+                /* A new connection, do connect() */
+                pIface->tcpParams.cornerPort = appHandle->mdDefault.tcpPort;
+                pSenderElement->tcpParameters.doConnect = TRUE;
+                appHandle->tcpPoolStats.numConnect++;
+            }
+            else
+            {
+                /* The connection is in use again, stop its idle timeout */
+                pIface->tcpParams.connectionTimeout.tv_sec  = 0;
+                pIface->tcpParams.connectionTimeout.tv_usec = 0;
+                pSenderElement->tcpParameters.doConnect     = FALSE;
+                appHandle->tcpPoolStats.numReuse++;
+                if ( pIface->usage > 1 )
+                {
+                    appHandle->tcpPoolStats.numPipelined++;
+                }
+            }
+        }
         /* In the case that it is the first connection, do connect() */
-        if ( appHandle->iface[pSenderElement->socketIdx].usage > 1 )
+        else if ( appHandle->iface[pSenderElement->socketIdx].usage > 1 )
         {
             pSenderElement->tcpParameters.doConnect = FALSE;
         }
@@ -3070,7 +3090,7 @@ static TRDP_ERR_T trdp_mdConnectSocket (TRDP_APP_SESSION_T      appHandle,
               && TRDP_INVALID_SOCKET_INDEX == pSenderElement->socketIdx )
     {
         /* socket to send UDP MD */
-        err = trdp_requestSocket(appHandle->iface,
+        err = trdp_requestSocket(appHandle,
                                  appHandle->mdDefault.udpPort,
                                  (pSendParam != NULL) ?
                                  pSendParam : (&appHandle->mdDefault.sendParam),
@@ -3091,6 +3111,37 @@ static TRDP_ERR_T trdp_mdConnectSocket (TRDP_APP_SESSION_T      appHandle,
     return err;
 }
 
+/**********************************************************************************************************************/
+/** Decide whether the user data of a TCP message is sent in place.
+ *  Streaming is used for TCP messages flagged with TRDP_FLAGS_STREAM which are not marshalled. The packet buffer then
+ *  only needs to hold the header, header and user data are gathered by trdp_mdSendPacket().
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_init
+ *  @param[in,out]  pElement            MD element to be sent (pktFlags, grossSize set)
+ *  @param[in]      pData               pointer to packet data / dataset
+ *  @param[in]      dataSize            size of packet data
+ *
+ *  @retval         size of the packet buffer to allocate
+ */
+static UINT32 trdp_mdStreamSetup (TRDP_APP_SESSION_T    appHandle,
+                                  MD_ELE_T              *pElement,
+                                  const UINT8           *pData,
+                                  UINT32                dataSize)
+{
+    pElement->pStreamData = NULL;
+
+    if (((pElement->pktFlags & TRDP_FLAGS_STREAM) != 0)
+        && ((pElement->pktFlags & TRDP_FLAGS_TCP) != 0)
+        && !(((pElement->pktFlags & TRDP_FLAGS_MARSHALL) != 0) && (appHandle->marshall.pfCbMarshall != NULL))
+        && (pData != NULL)
+        && (dataSize > 0u))
+    {
+        pElement->pStreamData = pData;
+        return sizeof(MD_HEADER_T);
+    }
+    return pElement->grossSize;
+}
+
 /**********************************************************************************************************************/
 /** Details and finally enqueues a TRDP message.
  *
@@ -3153,7 +3204,8 @@ static void trdp_mdDetailSenderPacket (const TRDP_MSG_T         msgType,
         memset((CHAR8 *) pSenderElement->pPacket->frameHead.destinationURI, 0, TRDP_MAX_URI_USER_LEN);
         memcpy((CHAR8 *) pSenderElement->pPacket->frameHead.destinationURI, destURI, strlen((char *)destURI));
     }
-    if ( pData != NULL )
+    /* Streamed user data is sent in place by trdp_mdSendPacket() */
+    if ((pData != NULL) && (pSenderElement->pStreamData == NULL))
     {
         if (pSenderElement->pktFlags & TRDP_FLAGS_MARSHALL &&
             appHandle->marshall.pfCbMarshall != NULL)
@@ -3294,13 +3346,12 @@ TRDP_ERR_T trdp_mdReply (const TRDP_MSG_T           msgType,
                                             pSenderElement);
                 if ( errv == TRDP_NO_ERR )
                 {
-                    if ( NULL != pSenderElement->pPacket )
-                    {
-                        vos_memFree(pSenderElement->pPacket);
-                        pSenderElement->pPacket = NULL;
-                    }
+                    /* The request buffer is freed after the reply is copied: pData may point into it (echo)  */
+                    MD_PACKET_T *pRequest = pSenderElement->pPacket;
+
                     /* allocate a buffer for the data   */
-                    pSenderElement->pPacket = (MD_PACKET_T *) vos_memAlloc(pSenderElement->grossSize);
+                    pSenderElement->pPacket = (MD_PACKET_T *) vos_memAlloc(
+                            trdp_mdStreamSetup(appHandle, pSenderElement, pData, dataSize));
                     if ( NULL == pSenderElement->pPacket )
                     {
                         vos_memFree(pSenderElement);
@@ -3322,6 +3373,10 @@ TRDP_ERR_T trdp_mdReply (const TRDP_MSG_T           msgType,
                                                   pSenderElement);
                         errv = TRDP_NO_ERR;
                     }
+                    if ( NULL != pRequest )
+                    {
+                        vos_memFree(pRequest);
+                    }
                 }
                 /*intentionally no else here*/
             }
@@ -3515,7 +3570,8 @@ TRDP_ERR_T trdp_mdCall (
                 pSenderElement->pPacket = NULL;
             }
             /* allocate a buffer for the data   */
-            pSenderElement->pPacket = (MD_PACKET_T *) vos_memAlloc(pSenderElement->grossSize);
+            pSenderElement->pPacket = (MD_PACKET_T *) vos_memAlloc(
+                    trdp_mdStreamSetup(appHandle, pSenderElement, pData, dataSize));
             if ( NULL == pSenderElement->pPacket )
             {
                 vos_memFree(pSenderElement);
@@ -3618,6 +3674,7 @@ TRDP_ERR_T trdp_mdConfirm (
 
             pSenderElement->dataSize        = 0u;
             pSenderElement->grossSize       = trdp_packetSizeMD(0u);
+            pSenderElement->pStreamData     = NULL;
             pSenderElement->addr.comId      = 0u;
             pSenderElement->addr.srcIpAddr  = srcIpAddr;
             pSenderElement->addr.destIpAddr = destIpAddr;
@@ -16,6 +16,10 @@
  *
  * $Id: trdp_pdcom.c 1789 2018-11-09 08:15:22Z ahweiss $
  *
+ *      AG 2026-10-19: Tracepoints for PD send, receive, timeout and callbacks (TRDP_TRACE)
+ *      AG 2026-10-19: Timing histograms: receive interval, send lateness and callback duration
+ *      AG 2026-10-19: Per-ComId counters for the statistics export, numMissed counted on reception
+ *      AG 2026-10-18: Socket filter for subscribed ComIds (TRDP_OPTION_PD_KERNEL_FILTER), count numNoSubs
  *      BL 2018-10-29: Ticket #217 PD Pull requests must be subscribed for
  *      BL 2018-08-07: Ticket #207 tlp_put() and variable dataSize
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
@@ -65,6 +69,7 @@
 #include "trdp_pdcom.h"
 #include "trdp_if.h"
 #include "trdp_stats.h"
+#include "trdp_trace.h"
 #include "vos_sock.h"
 #include "vos_mem.h"
 
@@ -85,6 +90,32 @@
  *   Locals
  */
 
+/******************************************************************************/
+/** Compare two ComIds (for vos_qsort)
+ *
+ *  @param[in]      pArg1               pointer to first ComId
+ *  @param[in]      pArg2               pointer to second ComId
+ *
+ *  @retval         -1 if arg1 < arg2, 0 if equal, 1 if arg1 > arg2
+ */
+static int trdp_pdCompareComId (
+    const void  *pArg1,
+    const void  *pArg2)
+{
+    if (*(const UINT32 *)pArg1 < *(const UINT32 *)pArg2)
+    {
+        return -1;
+    }
+    else if (*(const UINT32 *)pArg1 > *(const UINT32 *)pArg2)
+    {
+        return 1;
+    }
+    else
+    {
+        return 0;
+    }
+}
+
 
 /******************************************************************************/
 /** Initialize/construct the packet
@@ -359,18 +390,29 @@ TRDP_ERR_T  trdp_pdSendQueued (
                         theMessage.pUserRef     = iterPD->pUserRef; /* User reference given with the local subscribe? */
                         theMessage.resultCode   = err;
 
+                        TRDP_TRACE_EVENT(appHandle, TRDP_TRACE_CB_BEGIN, theMessage.comId, 0u);
+                        trdp_histCallbackStart(appHandle, iterPD);
                         iterPD->pfCbFunction(appHandle->pdDefault.pRefCon,
                                                        appHandle,
                                                        &theMessage,
                                                        iterPD->pFrame->data,
                                                        vos_ntohl(iterPD->pFrame->frameHead.datasetLength));
+                        trdp_histCallbackEnd(appHandle);
+                        TRDP_TRACE_EVENT(appHandle, TRDP_TRACE_CB_END, theMessage.comId, 0u);
                     }
                     /* We pass the error to the application, but we keep on going    */
                     result = trdp_pdSend(appHandle->iface[iterPD->socketIdx].sock, iterPD, appHandle->pdDefault.port);
                     if (result == TRDP_NO_ERR)
                     {
                         appHandle->stats.pd.numSend++;
+                        TRDP_STATS_COMID_ADD(appHandle, iterPD->addr.comId, pdNumSend, 1u);
+                        TRDP_TRACE_EVENT(appHandle, TRDP_TRACE_PD_SENT, iterPD->addr.comId, iterPD->grossSize);
                         iterPD->numRxTx++;
+                        if (timerisset(&iterPD->interval) &&            /*  cyclic send, not a PULL reply  */
+                            !timercmp(&iterPD->timeToGo, &now, >))
+                        {
+                            trdp_histSent(iterPD);
+                        }
                     }
                     else
                     {
@@ -408,7 +450,7 @@ TRDP_ERR_T  trdp_pdSendQueued (
             {
                 PD_ELE_T *pTemp;
                 /* Decrease the socket ref */
-                trdp_releaseSocket(appHandle->iface, iterPD->socketIdx, 0u, FALSE, VOS_INADDR_ANY);
+                trdp_releaseSocket(appHandle, iterPD->socketIdx, 0u, FALSE, VOS_INADDR_ANY);
                 /* Save next element */
                 pTemp = iterPD->pNext;
                 /* Remove current element */
@@ -460,6 +502,7 @@ TRDP_ERR_T  trdp_pdReceive (
     UINT32              recSize         = TRDP_MAX_PD_PACKET_SIZE;
     int                 informUser      = FALSE;
     TRDP_ADDRESSES_T    subAddresses    = { 0u, 0u, 0u, 0u, 0u, 0u, 0u};
+    TRDP_TIME_T         now;
 
     /*  Get the packet from the wire:  */
     err = (TRDP_ERR_T) vos_sockReceiveUDP(sock,
@@ -482,6 +525,7 @@ TRDP_ERR_T  trdp_pdReceive (
     {
        case TRDP_NO_ERR:
            appHandle->stats.pd.numRcv++;
+           TRDP_STATS_COMID_ADD(appHandle, vos_ntohl(pNewFrameHead->comId), pdNumRcv, 1u);
            break;
        case TRDP_CRC_ERR:
            appHandle->stats.pd.numCrcErr++;
@@ -520,6 +564,7 @@ TRDP_ERR_T  trdp_pdReceive (
         vos_printLog(VOS_LOG_INFO, "No subscription (SrcIp: %s comId %u)\n", vos_ipDotted(subAddresses.srcIpAddr),
                         vos_ntohl(pNewFrame->frameHead.comId));
         */
+        appHandle->stats.pd.numNoSubs++;
         err = TRDP_NOSUB_ERR;
     }
     else
@@ -534,6 +579,8 @@ TRDP_ERR_T  trdp_pdReceive (
                                    pExistingElement->addr.opTrnTopoCnt))
         {
             UINT32 newSeqCnt = vos_ntohl(pNewFrameHead->sequenceCounter);
+            UINT32 missed;
+
             /* Save the source IP address of the received packet */
             pExistingElement->lastSrcIP = subAddresses.srcIpAddr;
             /* Save the real destination of the received packet (own IP or MC group) */
@@ -564,11 +611,21 @@ TRDP_ERR_T  trdp_pdReceive (
 
             if ((newSeqCnt > 0u) && (newSeqCnt > (pExistingElement->curSeqCnt + 1u)))
             {
-                pExistingElement->numMissed += newSeqCnt - pExistingElement->curSeqCnt - 1u;
+                missed = newSeqCnt - pExistingElement->curSeqCnt - 1u;
             }
             else if (pExistingElement->curSeqCnt > newSeqCnt)
             {
-                pExistingElement->numMissed += UINT32_MAX - pExistingElement->curSeqCnt + newSeqCnt;
+                missed = UINT32_MAX - pExistingElement->curSeqCnt + newSeqCnt;
+            }
+            else
+            {
+                missed = 0u;
+            }
+            if (missed != 0u)
+            {
+                pExistingElement->numMissed     += missed;
+                appHandle->stats.pd.numMissed   += missed;
+                TRDP_STATS_COMID_ADD(appHandle, pExistingElement->addr.comId, pdNumMissed, missed);
             }
 
             /* Store last received sequence counter here, too (pd_get et. al. may access it).   */
@@ -595,11 +652,14 @@ TRDP_ERR_T  trdp_pdReceive (
             }
 
             /*  Get the current time and compute the next time this packet should be received.  */
-            vos_getTime(&pExistingElement->timeToGo);
+            vos_getTime(&now);
+            trdp_histReceived(pExistingElement, &now);
+            pExistingElement->timeToGo = now;
             vos_addTime(&pExistingElement->timeToGo, &pExistingElement->interval);
 
             /*  Update some statistics  */
             pExistingElement->numRxTx++;
+            TRDP_TRACE_EVENT(appHandle, TRDP_TRACE_PD_RECEIVED, pExistingElement->addr.comId, recSize);
             pExistingElement->lastErr   = TRDP_NO_ERR;
             pExistingElement->privFlags =
                 (TRDP_PRIV_FLAGS_T) (pExistingElement->privFlags & ~(TRDP_PRIV_FLAGS_T)TRDP_TIMED_OUT);
@@ -620,7 +680,25 @@ TRDP_ERR_T  trdp_pdReceive (
             if (vos_ntohs(pNewFrameHead->msgType) == (UINT16) TRDP_MSG_PR)
             {
                 /*  Handle statistics request  */
-                if (vos_ntohl(pNewFrameHead->comId) == TRDP_STATISTICS_PULL_COMID)
+                if ((vos_ntohl(pNewFrameHead->comId) == TRDP_STATISTICS_PULL_COMID) &&
+                    (vos_ntohl(pNewFrameHead->replyComId) == TRDP_HIST_STATISTICS_COMID))
+                {
+                    pPulledElement = trdp_queueFindComId(appHandle->pSndQueue, TRDP_HIST_STATISTICS_COMID);
+                    if (pPulledElement != NULL)
+                    {
+                        pPulledElement->addr.destIpAddr = vos_ntohl(pNewFrameHead->replyIpAddress);
+
+                        trdp_pdInit(pPulledElement, TRDP_MSG_PP, appHandle->etbTopoCnt, appHandle->opTrnTopoCnt, 0u, 0u);
+
+                        trdp_pdPrepareHist(appHandle, pPulledElement, pExistingElement->pFrame->data,
+                                           pExistingElement->dataSize);
+                    }
+                    else
+                    {
+                        vos_printLogStr(VOS_LOG_ERROR, "Histogram request failed, TRDP_OPTION_HISTOGRAMS not set!\n");
+                    }
+                }
+                else if (vos_ntohl(pNewFrameHead->comId) == TRDP_STATISTICS_PULL_COMID)
                 {
                     pPulledElement = trdp_queueFindComId(appHandle->pSndQueue, TRDP_GLOBAL_STATISTICS_COMID);
                     if (pPulledElement != NULL)
@@ -708,11 +786,15 @@ TRDP_ERR_T  trdp_pdReceive (
             theMessage.pUserRef     = pExistingElement->pUserRef; /* User reference given with the local subscribe? */
             theMessage.resultCode   = err;
 
+            TRDP_TRACE_EVENT(appHandle, TRDP_TRACE_CB_BEGIN, theMessage.comId, 0u);
+            trdp_histCallbackStart(appHandle, pExistingElement);
             pExistingElement->pfCbFunction(appHandle->pdDefault.pRefCon,
                                            appHandle,
                                            &theMessage,
                                            pExistingElement->pFrame->data,
                                            vos_ntohl(pExistingElement->pFrame->frameHead.datasetLength));
+            trdp_histCallbackEnd(appHandle);
+            TRDP_TRACE_EVENT(appHandle, TRDP_TRACE_CB_END, theMessage.comId, 0u);
         }
     }
     return err;
@@ -801,6 +883,8 @@ void trdp_pdHandleTimeOuts (
         {
             /*  Update some statistics  */
             appHandle->stats.pd.numTimeout++;
+            TRDP_STATS_COMID_ADD(appHandle, iterPD->addr.comId, pdNumTimeout, 1u);
+            TRDP_TRACE_EVENT(appHandle, TRDP_TRACE_PD_TIMED_OUT, iterPD->addr.comId, 0u);
             iterPD->lastErr = TRDP_TIMEOUT_ERR;
 
             /* Packet is late! We inform the user about this:    */
@@ -823,19 +907,27 @@ void trdp_pdHandleTimeOuts (
                     theMessage.replyComId   = vos_ntohl(iterPD->pFrame->frameHead.replyComId);
                     theMessage.replyIpAddr  = vos_ntohl(iterPD->pFrame->frameHead.replyIpAddress);
 
+                    TRDP_TRACE_EVENT(appHandle, TRDP_TRACE_CB_BEGIN, theMessage.comId, 0u);
+                    trdp_histCallbackStart(appHandle, iterPD);
                     iterPD->pfCbFunction(appHandle->pdDefault.pRefCon,
                                          appHandle,
                                          &theMessage,
                                          iterPD->pFrame->data,
                                          iterPD->dataSize);
+                    trdp_histCallbackEnd(appHandle);
+                    TRDP_TRACE_EVENT(appHandle, TRDP_TRACE_CB_END, theMessage.comId, 0u);
                 }
                 else
                 {
+                    TRDP_TRACE_EVENT(appHandle, TRDP_TRACE_CB_BEGIN, theMessage.comId, 0u);
+                    trdp_histCallbackStart(appHandle, iterPD);
                     iterPD->pfCbFunction(appHandle->pdDefault.pRefCon,
                                          appHandle,
                                          &theMessage,
                                          NULL,
                                          iterPD->dataSize);
+                    trdp_histCallbackEnd(appHandle);
+                    TRDP_TRACE_EVENT(appHandle, TRDP_TRACE_CB_END, theMessage.comId, 0u);
                 }
             }
 
@@ -1169,3 +1261,87 @@ TRDP_ERR_T  trdp_pdDistribute (
 
     return TRDP_NO_ERR;
 }
+
+/******************************************************************************/
+/** Update the socket filters of the PD receive sockets
+ *  With TRDP_OPTION_PD_KERNEL_FILTER set, the kernel passes only PD packets of subscribed ComIds to the stack.
+ *  Must be called whenever subscriptions or PD receive sockets were added or removed.
+ *  If a filter cannot be set, all packets are passed and filtered by the stack as before.
+ *
+ *  @param[in]      appHandle           session pointer
+ */
+void    trdp_pdUpdateFilter (
+    TRDP_SESSION_PT appHandle)
+{
+    PD_ELE_T    *iterPD;
+    UINT32      *pComIds    = NULL;
+    UINT32      noOfComIds  = 0u;
+    UINT32      i, j;
+    INT32       lIndex;
+    BOOL8       failed      = FALSE;
+
+    if ((appHandle->option & TRDP_OPTION_PD_KERNEL_FILTER) == 0u)
+    {
+        return;
+    }
+
+    /*  Collect the subscribed ComIds, sorted and unique   */
+    for (iterPD = appHandle->pRcvQueue; iterPD != NULL; iterPD = iterPD->pNext)
+    {
+        noOfComIds++;
+    }
+
+    if (noOfComIds > 0u)
+    {
+        pComIds = (UINT32 *) vos_memAlloc(noOfComIds * sizeof(UINT32));
+        if (pComIds == NULL)
+        {
+            noOfComIds  = 0u;
+            failed      = TRUE;
+        }
+        else
+        {
+            for (i = 0u, iterPD = appHandle->pRcvQueue; iterPD != NULL; i++, iterPD = iterPD->pNext)
+            {
+                pComIds[i] = iterPD->addr.comId;
+            }
+            vos_qsort(pComIds, noOfComIds, sizeof(UINT32), trdp_pdCompareComId);
+            for (i = 1u, j = 0u; i < noOfComIds; i++)
+            {
+                if (pComIds[i] != pComIds[j])
+                {
+                    pComIds[++j] = pComIds[i];
+                }
+            }
+            noOfComIds = j + 1u;
+        }
+    }
+
+    for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(appHandle); lIndex++)
+    {
+        if ((appHandle->iface[lIndex].sock != VOS_INVALID_SOCKET)
+            && (appHandle->iface[lIndex].type == TRDP_SOCK_PD)
+            && (appHandle->iface[lIndex].rcvMostly == TRUE)
+            && (vos_sockSetFilter(appHandle->iface[lIndex].sock, (UINT32) offsetof(PD_HEADER_T, comId),
+                                  pComIds, noOfComIds) != VOS_NO_ERR))
+        {
+            /*  Pass everything rather than losing subscribed packets */
+            (void) vos_sockSetFilter(appHandle->iface[lIndex].sock, 0u, NULL, 0u);
+            failed = TRUE;
+        }
+    }
+
+    if (failed == TRUE)
+    {
+        vos_printLogStr(VOS_LOG_WARNING, "PD socket filter not set, filtering in the stack\n");
+        noOfComIds = 0u;
+    }
+
+    appHandle->pdFilterCnt = noOfComIds;
+    appHandle->stats.pdFilter.numUpdate++;
+
+    if (pComIds != NULL)
+    {
+        vos_memFree(pComIds);
+    }
+}
@@ -16,6 +16,7 @@
  *
  * $Id: trdp_pdcom.h 1740 2018-06-20 16:03:12Z bloehr $
  *
+ *      AG 2026-10-18: trdp_pdUpdateFilter (TRDP_OPTION_PD_KERNEL_FILTER)
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
  *      BL 2014-07-14: Ticket #46: Protocol change: operational topocount needed
  *                     Ticket #47: Protocol change: no FCS for data part of telegrams
@@ -101,4 +102,7 @@ TRDP_ERR_T  trdp_pdCheckListenSocks (
 TRDP_ERR_T trdp_pdDistribute (
     PD_ELE_T *pSndQueue);
 
+void        trdp_pdUpdateFilter (
+    TRDP_SESSION_PT appHandle);
+
 #endif
@@ -37,6 +37,8 @@
  * INCLUDES
  */
 
+#include <stddef.h>
+
 #include "trdp_types.h"
 #include "vos_thread.h"
 #include "vos_sock.h"
@@ -65,6 +67,9 @@
 
 #define TRDP_IF_WAIT_FOR_READY              120u    /**< 120 seconds (120 tries each second to bind to an IP address) */
 
+/** Size of the statistics telegram, the local only members at the end of TRDP_STATISTICS_T are not sent   */
+#define TRDP_STATISTICS_PACKET_SIZE         ((UINT32) offsetof(TRDP_STATISTICS_T, pdFilter))
+
 /***********************************************************************************************************************
  * TYPEDEFS
  */
@@ -103,6 +108,7 @@ typedef enum
 #define TRDP_PULL_SUB           0x10u       /**< if set, its a PULL subscription                        */
 #define TRDP_REDUNDANT          0x20u       /**< if set, packet should not be sent (redundant)          */
 #define TRDP_CHECK_COMID        0x40u       /**< if set, do filter comId (addListener)                  */
+#define TRDP_MC_SSM             0x80u       /**< if set, MC group was joined for srcIpAddr only (SSM)   */
 
 typedef UINT8   TRDP_PRIV_FLAGS_T;
 
@@ -145,6 +151,8 @@ typedef struct
 typedef struct TRDP_SOCKET_TCP
 {
     TRDP_IP_ADDR_T  cornerIp;                           /**< The other TCP corner Ip                      */
+    UINT16          cornerPort;                         /**< The other TCP corner port, 0 if not connected
+                                                             by us                                        */
     BOOL8           notSend;                            /**< If the message has been sent uncompleted     */
     TRDP_TIME_T     connectionTimeout;                  /**< TCP socket connection Timeout                */
     BOOL8           sendNotOk;                          /**< The sending timeout will be start            */
@@ -154,6 +162,26 @@ typedef struct TRDP_SOCKET_TCP
 }TRDP_SOCKET_TCP_T;
 
 
+/** Source of a source specific multicast membership    */
+typedef struct TRDP_MC_SOURCE
+{
+    struct TRDP_MC_SOURCE   *pNext;             /**< next source of the same membership                     */
+    TRDP_IP_ADDR_T          srcIp;              /**< source address                                         */
+    UINT32                  refCnt;             /**< No. of users filtering for this source                 */
+} TRDP_MC_SOURCE_T;
+
+/** Multicast membership of a socket, one per socket and group    */
+typedef struct TRDP_MC_JOIN
+{
+    struct TRDP_MC_JOIN     *pNextInBucket;     /**< next membership with the same hash                     */
+    struct TRDP_MC_JOIN     *pNextOfSocket;     /**< next membership of the same socket                     */
+    INT32                   sockIdx;            /**< index into the socket list                             */
+    TRDP_IP_ADDR_T          mcGroup;            /**< joined multicast group                                 */
+    TRDP_IP_ADDR_T          ifaceIp;            /**< interface the group was joined on                      */
+    UINT32                  anyRefCnt;          /**< No. of users accepting any source                      */
+    TRDP_MC_SOURCE_T        *pSources;          /**< sources joined for source specific users               */
+} TRDP_MC_JOIN_T;
+
 /** Socket item    */
 typedef struct TRDP_SOCKETS
 {
@@ -164,7 +192,13 @@ typedef struct TRDP_SOCKETS
     BOOL8               rcvMostly;                       /**< Used for receiving                          */
     INT16               usage;                           /**< No. of current users of this socket         */
     TRDP_SOCKET_TCP_T   tcpParams;                       /**< Params used for TCP                         */
-    TRDP_IP_ADDR_T      mcGroups[VOS_MAX_MULTICAST_CNT]; /**< List of multicast addresses for this socket */
+    TRDP_MC_JOIN_T      *pMcJoins;                       /**< Multicast groups joined on this socket      */
+    UINT32              keyHash;                         /**< Hash of the socket parameters when indexed  */
+    SOCKET              hashedSock;                      /**< Indexed descriptor, VOS_INVALID_SOCKET if
+                                                              not indexed                                 */
+    INT32               nextByKey;                       /**< Next index with same parameter hash or -1   */
+    INT32               nextBySock;                      /**< Next index with same descriptor hash or -1  */
+    UINT32              numDrops;                        /**< Kernel drop count at last statistics update */
 } TRDP_SOCKETS_T;
 
 #if (defined (WIN32) || defined (WIN64))
@@ -225,6 +259,16 @@ typedef struct
 #pragma pack(pop)
 #endif
 
+#define TRDP_HIST_IDX_CYCLE     0u      /**< receive interval (subscriber) or send lateness (publisher) */
+#define TRDP_HIST_IDX_CALLBACK  1u      /**< callback execution time */
+
+/** Timing histograms of a publisher or subscriber (TRDP_OPTION_HISTOGRAMS)    */
+typedef struct PD_HIST
+{
+    TRDP_TIME_T         lastRcv;                /**< time of the last reception                             */
+    TRDP_HISTOGRAM_T    hist[2];                /**< indexed by TRDP_HIST_IDX_...                           */
+} PD_HIST_T;
+
 /** Queue element for PD packets to send or receive    */
 typedef struct PD_ELE
 {
@@ -256,6 +300,7 @@ typedef struct PD_ELE
     const void          *pUserRef;              /**< from subscribe()                                       */
     TRDP_PD_CALLBACK_T  pfCbFunction;           /**< Pointer to PD callback function                        */
     PD_PACKET_T         *pFrame;                /**< header ... data + FCS...                               */
+    PD_HIST_T           *pHist;                 /**< timing histograms or NULL                              */
 } PD_ELE_T, *TRDP_PUB_PT, *TRDP_SUB_PT;
 
 #if MD_SUPPORT
@@ -316,6 +361,8 @@ typedef struct MD_ELE
     TRDP_MD_CALLBACK_T  pfCbFunction;           /**< Pointer to MD callback function                        */
     MD_PACKET_T         *pPacket;               /**< Packet header in network byte order                    */
                                                 /**< data ready to be sent (with CRCs)                      */
+    const UINT8         *pStreamData;           /**< user data sent in place (TRDP_FLAGS_STREAM) or NULL,
+                                                     pPacket then holds the header only                     */
 } MD_ELE_T;
 
 /**    TCP file descriptor parameters   */
@@ -328,6 +375,21 @@ typedef struct
 #endif
 
 struct TAU_TTDB;
+struct TRDP_STATS_EXPORT;
+struct TRDP_TRACE_RING;
+
+/** Descriptors and timeouts of a higher layer (e.g. the resolver), added by tlc_getInterval */
+typedef TRDP_ERR_T (*TRDP_USER_INTERVAL_T)(
+    struct TRDP_SESSION *appHandle,
+    TRDP_TIME_T         *pInterval,
+    TRDP_FDS_T          *pFileDesc,
+    INT32               *pNoDesc);
+
+/** Work of a higher layer (e.g. the resolver), done by tlc_process */
+typedef TRDP_ERR_T (*TRDP_USER_PROCESS_T)(
+    struct TRDP_SESSION *appHandle,
+    TRDP_FDS_T          *pRfds,
+    INT32               *pCount);
 
 /** Session/application variables store */
 typedef struct TRDP_SESSION
@@ -339,27 +401,47 @@ typedef struct TRDP_SESSION
     UINT32                  etbTopoCnt;         /**< current valid topocount or zero                        */
     UINT32                  opTrnTopoCnt;       /**< current valid topocount or zero                        */
     TRDP_TIME_T             nextJob;            /**< Store for next select interval                         */
+    TRDP_TIME_T             lastInterval;       /**< Interval last returned by tlc_getInterval              */
+    BOOL8                   deferred;           /**< MD and statistics work deferred by the process budget  */
     TRDP_PRINT_DBG_T        pPrintDebugString;  /**< Pointer to function to print debug information         */
     TRDP_MARSHALL_CONFIG_T  marshall;           /**< Marshalling(unMarshalling configuration                */
     TRDP_PD_CONFIG_T        pdDefault;          /**< Default configuration for process data                 */
     TRDP_MEM_CONFIG_T       memConfig;          /**< Internal memory handling configuration                 */
     TRDP_OPTION_T           option;             /**< Stack behavior options                                 */
-    TRDP_SOCKETS_T          iface[VOS_MAX_SOCKET_CNT];  /**< Collection of sockets to use                   */
+    TRDP_SOCKETS_T          *iface;             /**< Collection of sockets to use, grows on demand          */
+    INT32                   ifaceSize;          /**< No. of allocated entries in iface[]                    */
+    INT32                   ifaceCnt;           /**< Highest used index in iface[] + 1                      */
+    INT32                   *pSockKeyIndex;     /**< Hash buckets of iface[] by socket parameters           */
+    INT32                   *pSockFdIndex;      /**< Hash buckets of iface[] by socket descriptor           */
+    UINT32                  sockIndexSize;      /**< No. of hash buckets (power of 2)                       */
+    TRDP_MC_JOIN_T          * *pMcJoinIndex;    /**< Hash buckets of multicast memberships (socket, group)  */
+    UINT32                  mcJoinIndexSize;    /**< No. of membership hash buckets (power of 2)            */
+    UINT32                  mcJoinCnt;          /**< No. of multicast memberships of all sockets            */
     PD_ELE_T                *pSndQueue;         /**< pointer to first element of send queue                 */
     PD_ELE_T                *pRcvQueue;         /**< pointer to first element of rcv queue                  */
     PD_PACKET_T             *pNewFrame;         /**< pointer to received PD frame                           */
     TRDP_TIME_T             initTime;           /**< initialization time of session                         */
     TRDP_STATISTICS_T       stats;              /**< statistics of this session                             */
+    UINT32                  pdFilterCnt;        /**< No. of ComIds passed by the PD socket filters, 0 = none */
+    struct TRDP_STATS_EXPORT *pStatsExport;     /**< statistics export and per-ComId counters, NULL = off   */
+    PD_HIST_T               *pCbHist;           /**< histograms of the element whose callback is running    */
+    TRDP_TIME_T             cbStart;            /**< start time of that callback                            */
+#if TRDP_TRACE
+    struct TRDP_TRACE_RING  *pTrace;            /**< trace ring, NULL = off                                 */
+#endif
 #if MD_SUPPORT
     struct TAU_TTDB         *pTTDB;             /**< session related TTDB data                              */
     void                    *pUser;             /**< space for higher layer data                            */
+    TRDP_USER_INTERVAL_T    pfUserInterval;     /**< higher layer hook of tlc_getInterval, NULL = none      */
+    TRDP_USER_PROCESS_T     pfUserProcess;      /**< higher layer hook of tlc_process, NULL = none          */
     TRDP_TCP_FD_T           tcpFd;              /**< TCP file descriptor parameters                         */
     TRDP_MD_CONFIG_T        mdDefault;          /**< Default configuration for message data                 */
     MD_LIS_ELE_T            *pMDListenQueue;    /**< pointer to first element of listeners queue            */
     MD_ELE_T                *pMDSndQueue;       /**< pointer to first element of send MD queue (caller)     */
     MD_ELE_T                *pMDRcvQueue;       /**< pointer to first element of recv MD queue (replier)    */
     MD_ELE_T                *pMDRcvEle;         /**< pointer to received MD element                         */
-    MD_ELE_T                *uncompletedTCP[VOS_MAX_SOCKET_CNT];     /**< uncompleted TCP messages buffer   */
+    MD_ELE_T                * *uncompletedTCP;  /**< uncompleted TCP messages buffer, one per iface[] entry */
+    TRDP_TCP_POOL_STATISTICS_T  tcpPoolStats;   /**< statistics of the TCP caller connection pool           */
 #endif
 } TRDP_SESSION_T, *TRDP_SESSION_PT;
 
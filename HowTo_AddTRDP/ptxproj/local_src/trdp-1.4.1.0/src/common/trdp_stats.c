@@ -16,6 +16,9 @@
  *
  * $Id: trdp_stats.c 1740 2018-06-20 16:03:12Z bloehr $
  *
+ *      AG 2026-10-19: Processing budget survives tlc_resetStatistics
+ *      AG 2026-10-19: Timing histograms per publisher and subscription (TRDP_OPTION_HISTOGRAMS)
+ *      AG 2026-10-19: Statistics export into a shared memory ring, per-ComId counters, counts kept incrementally
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
  *      BL 2017-11-17: superfluous session->redID replaced by sndQueue->redId
  *      BL 2017-05-22: Ticket #122: Addendum for 64Bit compatibility (VOS_TIME_T -> VOS_TIMEVAL_T)
@@ -38,17 +41,41 @@
 #include "trdp_if.h"
 #include "trdp_private.h"
 #include "trdp_pdcom.h"
+#include "trdp_utils.h"
 #include "vos_mem.h"
 #include "vos_thread.h"
+#include "vos_shared_mem.h"
 
 /*******************************************************************************
  * DEFINES
  */
 
+#define TRDP_STATS_EXPORT_ALIGN     8u      /**< alignment of the slots in the export area */
+#define TRDP_STATS_EXPORT_RETRIES   8u      /**< reader retries on a slot being rewritten */
+#define TRDP_STATS_HASH_MULT        2654435761u
+
 /*******************************************************************************
  * TYPEDEFS
  */
 
+/** Session private part of the statistics export */
+struct TRDP_STATS_EXPORT
+{
+    VOS_SHRD_T              handle;         /**< shared memory handle */
+    UINT8                   *pArea;         /**< mapped export area */
+    UINT32                  areaSize;       /**< size of the mapped area */
+    TRDP_STATS_EXPORT_HDR_T *pHdr;          /**< header at the start of the area */
+    VOS_TIMEVAL_T           interval;       /**< snapshot interval, 0 = every tlc_process */
+    VOS_TIMEVAL_T           nextSnapshot;   /**< time of the next snapshot */
+    UINT32                  snapshotNo;     /**< number of the last snapshot written */
+    UINT32                  maxComIds;      /**< capacity of pComIds */
+    UINT32                  noOfComIds;     /**< used entries of pComIds */
+    UINT32                  numOverflow;    /**< packets not counted, pComIds full */
+    UINT32                  hashMask;       /**< size of pHash - 1 */
+    UINT16                  *pHash;         /**< open addressed ComId index: index into pComIds + 1, 0 = free */
+    TRDP_COMID_STATISTICS_T *pComIds;       /**< per-ComId counters in order of first use */
+};
+
 /******************************************************************************
  *   Locals
  */
@@ -102,16 +129,54 @@ void trdp_initStats (
 EXT_DECL TRDP_ERR_T tlc_resetStatistics (
     TRDP_APP_SESSION_T appHandle)
 {
-    TIMEDATE32 tempTime;
+    TIMEDATE32  tempTime;
+    UINT32      numSubs, numPub, numUdpList, numTcpList, budget;
 
     if (!trdp_isValidSession(appHandle))
     {
         return TRDP_NOINIT_ERR;
     }
 
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
     tempTime = appHandle->stats.upTime;
+    numSubs  = appHandle->stats.pd.numSubs;
+    numPub   = appHandle->stats.pd.numPub;
+    numUdpList  = appHandle->stats.udpMd.numList;
+    numTcpList  = appHandle->stats.tcpMd.numList;
+    budget      = appHandle->stats.process.budget;
     memset(&appHandle->stats, 0, sizeof(TRDP_STATISTICS_T));
+    /*  Gauges are maintained incrementally and survive the reset   */
     appHandle->stats.upTime = tempTime;
+    appHandle->stats.pd.numSubs     = numSubs;
+    appHandle->stats.pd.numPub      = numPub;
+    appHandle->stats.udpMd.numList  = numUdpList;
+    appHandle->stats.tcpMd.numList  = numTcpList;
+    appHandle->stats.process.budget = budget;
+#if MD_SUPPORT
+    memset(&appHandle->tcpPoolStats, 0, sizeof(TRDP_TCP_POOL_STATISTICS_T));
+#endif
+    if (appHandle->pStatsExport != NULL)
+    {
+        UINT32 i;
+
+        for (i = 0u; i < appHandle->pStatsExport->noOfComIds; i++)
+        {
+            UINT32 comId = appHandle->pStatsExport->pComIds[i].comId;
+
+            memset(&appHandle->pStatsExport->pComIds[i], 0, sizeof(TRDP_COMID_STATISTICS_T));
+            appHandle->pStatsExport->pComIds[i].comId = comId;
+        }
+        appHandle->pStatsExport->numOverflow = 0u;
+    }
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
 
     return TRDP_NO_ERR;
 }
@@ -349,6 +414,53 @@ EXT_DECL TRDP_ERR_T tlc_getTcpListStatistics (
     *pNumList = lIndex;
     return TRDP_NO_ERR;
 }
+
+/**********************************************************************************************************************/
+/** Return TCP MD caller connection pool statistics.
+ *  Memory for statistics information must be provided by the user.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[out]     pStatistics         Pointer to the connection pool statistics
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ */
+EXT_DECL TRDP_ERR_T tlc_getTcpPoolStatistics (
+    TRDP_APP_SESSION_T          appHandle,
+    TRDP_TCP_POOL_STATISTICS_T  *pStatistics)
+{
+    INT32 lIndex;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (pStatistics == NULL)
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    *pStatistics            = appHandle->tcpPoolStats;
+    pStatistics->numOpen    = 0u;
+    pStatistics->numIdle    = 0u;
+
+    /*  Count the connections opened by us (caller side)  */
+    for (lIndex = 0; lIndex < trdp_getCurrentMaxSocketCnt(appHandle); lIndex++)
+    {
+        if ((appHandle->iface[lIndex].sock != VOS_INVALID_SOCKET)
+            && (appHandle->iface[lIndex].type == TRDP_SOCK_MD_TCP)
+            && (appHandle->iface[lIndex].rcvMostly == FALSE))
+        {
+            pStatistics->numOpen++;
+            if (appHandle->iface[lIndex].usage == 0)
+            {
+                pStatistics->numIdle++;
+            }
+        }
+    }
+    return TRDP_NO_ERR;
+}
 #endif
 
 /**********************************************************************************************************************/
@@ -453,8 +565,7 @@ EXT_DECL TRDP_ERR_T tlc_getJoinStatistics (
 void    trdp_UpdateStats (
     TRDP_APP_SESSION_T appHandle)
 {
-    PD_ELE_T        *iter;
-    UINT16          lIndex, llIndex;
+    INT32           sIndex;
     VOS_ERR_T       ret;
     VOS_TIMEVAL_T   temp, temp2;
     TIMEDATE32      diff;
@@ -487,36 +598,26 @@ void    trdp_UpdateStats (
         vos_printLog(VOS_LOG_ERROR, "vos_memCount() failed (Err: %d)\n", ret);
     }
 
-    appHandle->stats.pd.numMissed = 0u;
-
-    /*  Count our subscriptions */
-    for (lIndex = 0u, iter = appHandle->pRcvQueue; iter != NULL; lIndex++, iter = iter->pNext)
-    {
-        appHandle->stats.pd.numMissed += iter->numMissed;
-    }
+    /*  numSubs, numPub and numMissed are counted where subscriptions, publishers and gaps come and go  */
 
-    appHandle->stats.pd.numSubs = lIndex;
+    /*  Count our joins (one per socket and group) */
+    appHandle->stats.numJoin = appHandle->mcJoinCnt;
 
-    /*  Count our publishers */
-    for (lIndex = 0u, iter = appHandle->pSndQueue; iter != NULL; lIndex++, iter = iter->pNext)
+    /*  Add the packets the kernel dropped on our PD receive sockets since the last update */
+    for (sIndex = 0; sIndex < trdp_getCurrentMaxSocketCnt(appHandle); sIndex++)
     {
-        ;
-    }
+        UINT32 drops;
 
-    appHandle->stats.pd.numPub = lIndex;
-
-    /*  Count our joins */
-    appHandle->stats.numJoin = 0u;
-    for (lIndex = 0u; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
-    {
-        for (llIndex = 0u; llIndex < VOS_MAX_MULTICAST_CNT; llIndex++)
+        if ((appHandle->iface[sIndex].sock != VOS_INVALID_SOCKET)
+            && (appHandle->iface[sIndex].type == TRDP_SOCK_PD)
+            && (appHandle->iface[sIndex].rcvMostly == TRUE)
+            && (vos_sockGetDrops(appHandle->iface[sIndex].sock, &drops) == VOS_NO_ERR))
         {
-            if (appHandle->iface[lIndex].mcGroups[llIndex] != 0u)
-            {
-                appHandle->stats.numJoin++;
-            }
+            appHandle->stats.pdFilter.numKernelDrop += drops - appHandle->iface[sIndex].numDrops;
+            appHandle->iface[sIndex].numDrops = drops;
         }
     }
+    appHandle->stats.pdFilter.numComIds = appHandle->pdFilterCnt;
 
 }
 
@@ -615,8 +716,851 @@ void    trdp_pdPrepareStats (
     pData->tcpMd.numReplyTimeout    = vos_htonl(appHandle->stats.tcpMd.numReplyTimeout);
     pData->tcpMd.numConfirmTimeout  = vos_htonl(appHandle->stats.tcpMd.numConfirmTimeout);
     pData->tcpMd.numSend            = vos_htonl(appHandle->stats.tcpMd.numSend);
-    pPacket->dataSize = sizeof(TRDP_STATISTICS_T);
+    pPacket->dataSize = TRDP_STATISTICS_PACKET_SIZE;
+
+    /* mark the data as valid */
+    pPacket->privFlags = (TRDP_PRIV_FLAGS_T) (pPacket->privFlags & ~(TRDP_PRIV_FLAGS_T)TRDP_INVALID_DATA);
+}
+
+/**********************************************************************************************************************/
+/** Return the counters of a ComId, add the ComId on first use.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      comId               ComId to count
+ *  @retval         pointer to the counters or NULL if the export is off or the table is full
+ */
+TRDP_COMID_STATISTICS_T *trdp_getComIdStats (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              comId)
+{
+    struct TRDP_STATS_EXPORT    *pExp = appHandle->pStatsExport;
+    UINT32                      slot;
+
+    if (pExp == NULL)
+    {
+        return NULL;
+    }
+
+    for (slot = (comId * TRDP_STATS_HASH_MULT) & pExp->hashMask;
+         pExp->pHash[slot] != 0u;
+         slot = (slot + 1u) & pExp->hashMask)
+    {
+        if (pExp->pComIds[pExp->pHash[slot] - 1u].comId == comId)
+        {
+            return &pExp->pComIds[pExp->pHash[slot] - 1u];
+        }
+    }
+
+    if (pExp->noOfComIds >= pExp->maxComIds)
+    {
+        pExp->numOverflow++;
+        return NULL;
+    }
+    pExp->pComIds[pExp->noOfComIds].comId = comId;
+    pExp->noOfComIds++;
+    pExp->pHash[slot] = (UINT16) pExp->noOfComIds;
+    return &pExp->pComIds[pExp->noOfComIds - 1u];
+}
+
+/**********************************************************************************************************************/
+/** Shorten the time until the next job to the next statistics snapshot.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ */
+void trdp_statsCheckPending (
+    TRDP_APP_SESSION_T appHandle)
+{
+    struct TRDP_STATS_EXPORT *pExp = appHandle->pStatsExport;
+
+    if ((pExp != NULL)
+        && timerisset(&pExp->interval)
+        && (!timerisset(&appHandle->nextJob) || timercmp(&pExp->nextSnapshot, &appHandle->nextJob, <)))
+    {
+        appHandle->nextJob = pExp->nextSnapshot;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Write a statistics snapshot into the export ring, if it is due.
+ *  Called by tlc_process with the session locked, this is the only writer of the export area.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ */
+void trdp_exportStats (
+    TRDP_APP_SESSION_T appHandle)
+{
+    struct TRDP_STATS_EXPORT    *pExp = appHandle->pStatsExport;
+    TRDP_STATS_EXPORT_SLOT_T    *pSlot;
+    VOS_TIMEVAL_T               now;
+    UINT32                      seq;
+
+    if (pExp == NULL)
+    {
+        return;
+    }
+
+    vos_getTime(&now);
+    if (timerisset(&pExp->nextSnapshot) && timercmp(&now, &pExp->nextSnapshot, <))
+    {
+        return;
+    }
+    if (timerisset(&pExp->interval))
+    {
+        vos_addTime(&pExp->nextSnapshot, &pExp->interval);
+        if (timercmp(&pExp->nextSnapshot, &now, <))
+        {
+            /*  We were late, do not catch up with a burst of snapshots */
+            pExp->nextSnapshot = now;
+            vos_addTime(&pExp->nextSnapshot, &pExp->interval);
+        }
+    }
+
+    trdp_UpdateStats(appHandle);
+    appHandle->stats.timeStamp.tv_sec   = (UINT32) now.tv_sec;
+    appHandle->stats.timeStamp.tv_usec  = (INT32) now.tv_usec;
+
+    pExp->snapshotNo++;
+    if (pExp->snapshotNo == 0u)
+    {
+        pExp->snapshotNo = 1u;      /* 0 means 'no snapshot' to the readers */
+    }
+    pSlot = (TRDP_STATS_EXPORT_SLOT_T *) (pExp->pArea + pExp->pHdr->slotOffset
+                                          + ((pExp->snapshotNo - 1u) % pExp->pHdr->noOfSlots) * pExp->pHdr->slotSize);
+
+    /*  Sequence lock: odd while the slot is written    */
+    seq = pSlot->seq;
+    TRDP_STATS_STORE(&pSlot->seq, seq + 1u, TRDP_STATS_MO_RELAXED);
+    TRDP_STATS_FENCE(TRDP_STATS_MO_RELEASE);
+
+    pSlot->snapshotNo   = pExp->snapshotNo;
+    pSlot->noOfComIds   = pExp->noOfComIds;
+    pSlot->stats        = appHandle->stats;
+    memcpy(pSlot + 1, pExp->pComIds, pExp->noOfComIds * sizeof(TRDP_COMID_STATISTICS_T));
+
+    TRDP_STATS_STORE(&pSlot->seq, seq + 2u, TRDP_STATS_MO_RELEASE);
+
+    pExp->pHdr->numComIdOverflow = pExp->numOverflow;
+    TRDP_STATS_STORE(&pExp->pHdr->lastSnapshot, pExp->snapshotNo, TRDP_STATS_MO_RELEASE);
+}
+
+/**********************************************************************************************************************/
+/** Release the statistics export of a session.
+ *  The area is marked invalid for readers still attached to it.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ */
+void trdp_releaseStatsExport (
+    TRDP_APP_SESSION_T appHandle)
+{
+    struct TRDP_STATS_EXPORT *pExp = appHandle->pStatsExport;
+
+    if (pExp == NULL)
+    {
+        return;
+    }
+    appHandle->pStatsExport = NULL;
+
+    TRDP_STATS_STORE(&pExp->pHdr->magic, 0u, TRDP_STATS_MO_RELEASE);
+    if (vos_sharedClose(pExp->handle, pExp->pArea) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_WARNING, "vos_sharedClose() failed\n");
+    }
+    vos_memFree(pExp->pComIds);
+    vos_memFree(pExp->pHash);
+    vos_memFree(pExp);
+}
+
+/**********************************************************************************************************************/
+/** Start the statistics export.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pKey                name of the shared memory area
+ *  @param[in]      interval            snapshot interval in us, 0 = every tlc_process call
+ *  @param[in]      noOfSlots           number of slots in the ring (>= 2)
+ *  @param[in]      maxComIds           max. number of ComIds counted (1...65535)
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error or export already running
+ *  @retval         TRDP_MEM_ERR        out of memory or shared memory not available
+ */
+EXT_DECL TRDP_ERR_T tlc_startStatisticsExport (
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pKey,
+    UINT32              interval,
+    UINT32              noOfSlots,
+    UINT32              maxComIds)
+{
+    TRDP_ERR_T                  err = TRDP_NO_ERR;
+    struct TRDP_STATS_EXPORT    *pExp;
+    UINT32                      hashSize;
+    UINT32                      slotOffset;
+    UINT32                      slotSize;
+    UINT64                      areaSize;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if ((pKey == NULL) || (noOfSlots < 2u) || (maxComIds == 0u) || (maxComIds > 0xFFFFu))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    slotOffset  = (UINT32) ((sizeof(TRDP_STATS_EXPORT_HDR_T) + TRDP_STATS_EXPORT_ALIGN - 1u)
+                            & ~(TRDP_STATS_EXPORT_ALIGN - 1u));
+    slotSize    = (UINT32) ((sizeof(TRDP_STATS_EXPORT_SLOT_T) + maxComIds * sizeof(TRDP_COMID_STATISTICS_T)
+                             + TRDP_STATS_EXPORT_ALIGN - 1u) & ~(TRDP_STATS_EXPORT_ALIGN - 1u));
+    areaSize    = (UINT64) slotOffset + (UINT64) noOfSlots * slotSize;
+    if (areaSize > 0x7FFFFFFFu)
+    {
+        return TRDP_PARAM_ERR;
+    }
+    for (hashSize = 1u; hashSize < 2u * maxComIds; hashSize <<= 1)
+    {
+        ;
+    }
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (appHandle->pStatsExport != NULL)
+    {
+        err = TRDP_PARAM_ERR;
+    }
+    else
+    {
+        pExp = (struct TRDP_STATS_EXPORT *) vos_memAlloc(sizeof(struct TRDP_STATS_EXPORT));
+        if (pExp == NULL)
+        {
+            err = TRDP_MEM_ERR;
+        }
+        else
+        {
+            pExp->pHash     = (UINT16 *) vos_memAlloc(hashSize * sizeof(UINT16));
+            pExp->pComIds   = (TRDP_COMID_STATISTICS_T *) vos_memAlloc(maxComIds * sizeof(TRDP_COMID_STATISTICS_T));
+            pExp->areaSize  = (UINT32) areaSize;
+            if ((pExp->pHash == NULL) || (pExp->pComIds == NULL)
+                || (vos_sharedOpen(pKey, &pExp->handle, &pExp->pArea, &pExp->areaSize) != VOS_NO_ERR))
+            {
+                vos_printLog(VOS_LOG_ERROR, "Statistics export %s: no memory\n", pKey);
+                if (pExp->pHash != NULL)
+                {
+                    vos_memFree(pExp->pHash);
+                }
+                if (pExp->pComIds != NULL)
+                {
+                    vos_memFree(pExp->pComIds);
+                }
+                vos_memFree(pExp);
+                err = TRDP_MEM_ERR;
+            }
+            else
+            {
+                pExp->maxComIds         = maxComIds;
+                pExp->hashMask          = hashSize - 1u;
+                pExp->interval.tv_sec   = interval / 1000000u;
+                pExp->interval.tv_usec  = (INT32) (interval % 1000000u);
+                vos_getTime(&pExp->nextSnapshot);
+
+                /*  An area left behind by an earlier exporter is reinitialised, readers wait for the magic    */
+                pExp->pHdr = (TRDP_STATS_EXPORT_HDR_T *) pExp->pArea;
+                TRDP_STATS_STORE(&pExp->pHdr->magic, 0u, TRDP_STATS_MO_RELEASE);
+                memset(pExp->pArea + sizeof(UINT32), 0, pExp->areaSize - sizeof(UINT32));
+                pExp->pHdr->version     = TRDP_STATS_EXPORT_VERSION;
+                pExp->pHdr->slotOffset  = slotOffset;
+                pExp->pHdr->slotSize    = slotSize;
+                pExp->pHdr->noOfSlots   = noOfSlots;
+                pExp->pHdr->maxComIds   = maxComIds;
+                pExp->pHdr->interval    = interval;
+                TRDP_STATS_STORE(&pExp->pHdr->magic, TRDP_STATS_EXPORT_MAGIC, TRDP_STATS_MO_RELEASE);
+
+                appHandle->pStatsExport = pExp;
+            }
+        }
+    }
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Stop the statistics export and release the shared memory area.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_NODATA_ERR     export not running
+ */
+EXT_DECL TRDP_ERR_T tlc_stopStatisticsExport (
+    TRDP_APP_SESSION_T appHandle)
+{
+    TRDP_ERR_T err = TRDP_NO_ERR;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (appHandle->pStatsExport == NULL)
+    {
+        err = TRDP_NODATA_ERR;
+    }
+    else
+    {
+        trdp_releaseStatsExport(appHandle);
+    }
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Read a snapshot from a statistics export area.
+ *
+ *  @param[in]      pArea               start of the mapped export area
+ *  @param[in]      areaSize            size of the mapped area
+ *  @param[in,out]  pSnapshotNo         In: number of the snapshot to read, 0 = latest
+ *                                      Out: number of the snapshot read
+ *  @param[out]     pStatistics         session statistics of the snapshot
+ *  @param[in,out]  pNumComIds          In: size of pComIdStats in entries
+ *                                      Out: number of ComId counters returned
+ *  @param[out]     pComIdStats         per-ComId counters, may be NULL if *pNumComIds is 0
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error or area not (yet) initialised
+ *  @retval         TRDP_NODATA_ERR     no snapshot yet or requested snapshot already overwritten
+ *  @retval         TRDP_BLOCK_ERR      slot was rewritten while reading repeatedly, try again
+ *  @retval         TRDP_MEM_ERR        more ComId counters than requested, *pNumComIds are returned
+ */
+EXT_DECL TRDP_ERR_T tlc_readStatisticsExport (
+    const UINT8             *pArea,
+    UINT32                  areaSize,
+    UINT32                  *pSnapshotNo,
+    TRDP_STATISTICS_T       *pStatistics,
+    UINT32                  *pNumComIds,
+    TRDP_COMID_STATISTICS_T *pComIdStats)
+{
+    const TRDP_STATS_EXPORT_HDR_T   *pHdr = (const TRDP_STATS_EXPORT_HDR_T *) pArea;
+    const TRDP_STATS_EXPORT_SLOT_T  *pSlot;
+    UINT32  slotOffset, slotSize, noOfSlots, maxComIds;
+    UINT32  retries;
+
+    if ((pArea == NULL) || (pSnapshotNo == NULL) || (pStatistics == NULL) || (pNumComIds == NULL)
+        || ((pComIdStats == NULL) && (*pNumComIds != 0u))
+        || (areaSize < sizeof(TRDP_STATS_EXPORT_HDR_T))
+        || (TRDP_STATS_LOAD(&pHdr->magic, TRDP_STATS_MO_ACQUIRE) != TRDP_STATS_EXPORT_MAGIC)
+        || (pHdr->version != TRDP_STATS_EXPORT_VERSION))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    slotOffset  = pHdr->slotOffset;
+    slotSize    = pHdr->slotSize;
+    noOfSlots   = pHdr->noOfSlots;
+    maxComIds   = pHdr->maxComIds;
+    if ((noOfSlots == 0u)
+        || (slotOffset < sizeof(TRDP_STATS_EXPORT_HDR_T))
+        || (slotSize < sizeof(TRDP_STATS_EXPORT_SLOT_T) + (UINT64) maxComIds * sizeof(TRDP_COMID_STATISTICS_T))
+        || ((UINT64) slotOffset + (UINT64) noOfSlots * slotSize > areaSize))
+    {
+        return TRDP_PARAM_ERR;
+    }
+
+    for (retries = 0u; retries < TRDP_STATS_EXPORT_RETRIES; retries++)
+    {
+        UINT32  last    = TRDP_STATS_LOAD(&pHdr->lastSnapshot, TRDP_STATS_MO_ACQUIRE);
+        UINT32  wanted  = (*pSnapshotNo == 0u) ? last : *pSnapshotNo;
+        UINT32  seq1, seq2, snapshotNo, noOfComIds;
+
+        if ((last == 0u) || (wanted == 0u) || ((last - wanted) >= noOfSlots))
+        {
+            return TRDP_NODATA_ERR;
+        }
+        pSlot = (const TRDP_STATS_EXPORT_SLOT_T *) (pArea + slotOffset + ((wanted - 1u) % noOfSlots) * slotSize);
+
+        seq1 = TRDP_STATS_LOAD(&pSlot->seq, TRDP_STATS_MO_ACQUIRE);
+        if ((seq1 & 1u) != 0u)
+        {
+            continue;
+        }
+        snapshotNo  = pSlot->snapshotNo;
+        noOfComIds  = pSlot->noOfComIds;
+        if (noOfComIds > maxComIds)
+        {
+            noOfComIds = maxComIds;     /* torn read, rejected below */
+        }
+        *pStatistics = pSlot->stats;
+        if (*pNumComIds != 0u)
+        {
+            memcpy(pComIdStats, pSlot + 1,
+                   ((noOfComIds < *pNumComIds) ? noOfComIds : *pNumComIds) * sizeof(TRDP_COMID_STATISTICS_T));
+        }
+        TRDP_STATS_FENCE(TRDP_STATS_MO_ACQUIRE);
+        seq2 = TRDP_STATS_LOAD(&pSlot->seq, TRDP_STATS_MO_RELAXED);
+        if (seq1 != seq2)
+        {
+            continue;
+        }
+        if (snapshotNo != wanted)
+        {
+            if (*pSnapshotNo != 0u)
+            {
+                return TRDP_NODATA_ERR;     /* overwritten meanwhile */
+            }
+            continue;
+        }
+
+        *pSnapshotNo = snapshotNo;
+        if (noOfComIds > *pNumComIds)
+        {
+            return TRDP_MEM_ERR;
+        }
+        *pNumComIds = noOfComIds;
+        return TRDP_NO_ERR;
+    }
+    return TRDP_BLOCK_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Return the histogram bucket of a value.
+ *
+ *  @param[in]      value               time in us
+ *  @retval         bucket index
+ */
+static UINT32 trdp_histBucket (
+    UINT32 value)
+{
+    UINT32 exp = 31u;
+
+    if (value < TRDP_HIST_SUB_BUCKETS)
+    {
+        return value;
+    }
+#if defined(__GNUC__) || defined(__clang__)
+    exp = 31u - (UINT32) __builtin_clz(value);
+#else
+    while ((value & (1u << exp)) == 0u)
+    {
+        exp--;
+    }
+#endif
+    return ((exp - TRDP_HIST_SUB_BITS + 1u) << TRDP_HIST_SUB_BITS)
+           + ((value >> (exp - TRDP_HIST_SUB_BITS)) & (TRDP_HIST_SUB_BUCKETS - 1u));
+}
+
+/**********************************************************************************************************************/
+/** Add a time difference to a histogram.
+ *  Only tlc_process writes the histograms, readers copy them without lock.
+ *
+ *  @param[in]      pHist               the histogram
+ *  @param[in]      pLater              end of the interval
+ *  @param[in]      pEarlier            start of the interval, a negative interval counts as 0
+ */
+static void trdp_histAdd (
+    TRDP_HISTOGRAM_T    *pHist,
+    const TRDP_TIME_T   *pLater,
+    const TRDP_TIME_T   *pEarlier)
+{
+    TRDP_TIME_T diff    = *pLater;
+    UINT32      value   = 0u;
+    UINT32      count   = TRDP_STATS_LOAD(&pHist->count, TRDP_STATS_MO_RELAXED);
+    UINT32      *pBucket;
+
+    if (vos_cmpTime(pLater, pEarlier) > 0)
+    {
+        vos_subTime(&diff, pEarlier);
+        value = ((UINT32) diff.tv_sec >= 4294u) ? 0xFFFFFFFFu
+            : (UINT32) diff.tv_sec * 1000000u + (UINT32) diff.tv_usec;
+    }
+    if ((count == 0u) || (value < pHist->min))
+    {
+        TRDP_STATS_STORE(&pHist->min, value, TRDP_STATS_MO_RELAXED);
+    }
+    if (value > pHist->max)
+    {
+        TRDP_STATS_STORE(&pHist->max, value, TRDP_STATS_MO_RELAXED);
+    }
+    pBucket = &pHist->bucket[trdp_histBucket(value)];
+    TRDP_STATS_STORE(pBucket, *pBucket + 1u, TRDP_STATS_MO_RELAXED);
+    TRDP_STATS_STORE(&pHist->count, count + 1u, TRDP_STATS_MO_RELEASE);
+}
+
+/**********************************************************************************************************************/
+/** Copy a histogram while it may be updated.
+ *
+ *  @param[out]     pDest               the copy
+ *  @param[in]      pSrc                the histogram
+ */
+static void trdp_histCopy (
+    TRDP_HISTOGRAM_T        *pDest,
+    const TRDP_HISTOGRAM_T  *pSrc)
+{
+    UINT32 i;
+
+    pDest->count    = TRDP_STATS_LOAD(&pSrc->count, TRDP_STATS_MO_ACQUIRE);
+    pDest->min      = TRDP_STATS_LOAD(&pSrc->min, TRDP_STATS_MO_RELAXED);
+    pDest->max      = TRDP_STATS_LOAD(&pSrc->max, TRDP_STATS_MO_RELAXED);
+    pDest->reserved = 0u;
+    for (i = 0u; i < TRDP_HIST_BUCKETS; i++)
+    {
+        pDest->bucket[i] = TRDP_STATS_LOAD(&pSrc->bucket[i], TRDP_STATS_MO_RELAXED);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Allocate the histograms of a new publisher or subscription, if the session keeps them.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pElement            the publisher or subscription
+ */
+void trdp_initHist (
+    TRDP_APP_SESSION_T  appHandle,
+    PD_ELE_T            *pElement)
+{
+    if ((appHandle->option & TRDP_OPTION_HISTOGRAMS) != 0u)
+    {
+        pElement->pHist = (PD_HIST_T *) vos_memAlloc(sizeof(PD_HIST_T));
+        if (pElement->pHist == NULL)
+        {
+            vos_printLog(VOS_LOG_WARNING, "No histograms for ComId %u, out of memory\n", pElement->addr.comId);
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Release the histograms of a publisher or subscription.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pElement            the publisher or subscription
+ */
+void trdp_releaseHist (
+    TRDP_APP_SESSION_T  appHandle,
+    PD_ELE_T            *pElement)
+{
+    if (pElement->pHist != NULL)
+    {
+        if (appHandle->pCbHist == pElement->pHist)
+        {
+            appHandle->pCbHist = NULL;      /* removed by its own callback */
+        }
+        vos_memFree(pElement->pHist);
+        pElement->pHist = NULL;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Count the interval since the last reception of a subscription.
+ *
+ *  @param[in]      pElement            the subscription
+ *  @param[in]      pNow                time of the reception
+ */
+void trdp_histReceived (
+    PD_ELE_T            *pElement,
+    const TRDP_TIME_T   *pNow)
+{
+    if (pElement->pHist != NULL)
+    {
+        if (timerisset(&pElement->pHist->lastRcv))
+        {
+            trdp_histAdd(&pElement->pHist->hist[TRDP_HIST_IDX_CYCLE], pNow, &pElement->pHist->lastRcv);
+        }
+        pElement->pHist->lastRcv = *pNow;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Count how late a cyclic packet was sent, before its next send time is computed.
+ *
+ *  @param[in]      pElement            the publisher
+ */
+void trdp_histSent (
+    PD_ELE_T *pElement)
+{
+    TRDP_TIME_T now;
+
+    if (pElement->pHist != NULL)
+    {
+        vos_getTime(&now);
+        trdp_histAdd(&pElement->pHist->hist[TRDP_HIST_IDX_CYCLE], &now, &pElement->timeToGo);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Note the start of a user callback.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pElement            the publisher or subscription whose callback is called
+ */
+void trdp_histCallbackStart (
+    TRDP_APP_SESSION_T  appHandle,
+    PD_ELE_T            *pElement)
+{
+    appHandle->pCbHist = pElement->pHist;
+    if (pElement->pHist != NULL)
+    {
+        vos_getTime(&appHandle->cbStart);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Count the execution time of a user callback.
+ *  The element may have been removed by the callback, its histograms are found through the session.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ */
+void trdp_histCallbackEnd (
+    TRDP_APP_SESSION_T appHandle)
+{
+    TRDP_TIME_T now;
+
+    if (appHandle->pCbHist != NULL)
+    {
+        vos_getTime(&now);
+        trdp_histAdd(&appHandle->pCbHist->hist[TRDP_HIST_IDX_CALLBACK], &now, &appHandle->cbStart);
+        appHandle->pCbHist = NULL;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Fill the histogram packet
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in,out]  pPacket             pointer to the packet to fill
+ *  @param[in]      pRequest            data of the pull request: ComId and role of the wanted element
+ *  @param[in]      size                size of the request data
+ */
+void trdp_pdPrepareHist (
+    TRDP_APP_SESSION_T  appHandle,
+    PD_ELE_T            *pPacket,
+    const UINT8         *pRequest,
+    UINT32              size)
+{
+    TRDP_HIST_STATISTICS_T  *pData;
+    PD_ELE_T                *iter   = NULL;
+    UINT32                  comId   = 0u;
+    UINT32                  role    = 0u;
+    UINT32                  i, j;
+
+    if ((pPacket == NULL) || (appHandle == NULL))
+    {
+        return;
+    }
+
+    /*  The request may be unaligned    */
+    if (size >= 2u * sizeof(UINT32))
+    {
+        memcpy(&comId, pRequest, sizeof(UINT32));
+        memcpy(&role, pRequest + sizeof(UINT32), sizeof(UINT32));
+        comId   = vos_ntohl(comId);
+        role    = vos_ntohl(role);
+    }
+    for (iter = (role == 1u) ? appHandle->pSndQueue : appHandle->pRcvQueue; iter != NULL; iter = iter->pNext)
+    {
+        if ((iter->addr.comId == comId) && (iter->magic == ((role == 1u) ? TRDP_MAGIC_PUB_HNDL_VALUE
+                                                                         : TRDP_MAGIC_SUB_HNDL_VALUE)))
+        {
+            break;
+        }
+    }
+
+    pData = (TRDP_HIST_STATISTICS_T *) pPacket->pFrame->data;
+    memset(pData, 0, sizeof(TRDP_HIST_STATISTICS_T));
+    pData->comId    = vos_htonl(comId);
+    pData->role     = vos_htonl(role);
+    if (iter == NULL)
+    {
+        pData->status = vos_htonl(1u);
+    }
+    else if (iter->pHist == NULL)
+    {
+        pData->status = vos_htonl(2u);
+    }
+    else
+    {
+        TRDP_HISTOGRAM_T *pDest[2];
+
+        pDest[TRDP_HIST_IDX_CYCLE]      = &pData->cycle;
+        pDest[TRDP_HIST_IDX_CALLBACK]   = &pData->callback;
+        for (i = 0u; i < 2u; i++)
+        {
+            pDest[i]->count = vos_htonl(iter->pHist->hist[i].count);
+            pDest[i]->min   = vos_htonl(iter->pHist->hist[i].min);
+            pDest[i]->max   = vos_htonl(iter->pHist->hist[i].max);
+            for (j = 0u; j < TRDP_HIST_BUCKETS; j++)
+            {
+                pDest[i]->bucket[j] = vos_htonl(iter->pHist->hist[i].bucket[j]);
+            }
+        }
+    }
+    pPacket->dataSize = sizeof(TRDP_HIST_STATISTICS_T);
 
     /* mark the data as valid */
     pPacket->privFlags = (TRDP_PRIV_FLAGS_T) (pPacket->privFlags & ~(TRDP_PRIV_FLAGS_T)TRDP_INVALID_DATA);
 }
+
+/**********************************************************************************************************************/
+/** Return a timing histogram of a publisher or subscription.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pElement            the publisher or subscription
+ *  @param[in]      magic               handle magic of the role
+ *  @param[in]      cycleType           histogram type stored at TRDP_HIST_IDX_CYCLE for the role
+ *  @param[in]      type                requested histogram type
+ *  @param[out]     pHistogram          copy of the histogram
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOPUB_ERR      wrong handle
+ *  @retval         TRDP_NODATA_ERR     no histograms kept
+ */
+static TRDP_ERR_T trdp_getHistogram (
+    TRDP_APP_SESSION_T  appHandle,
+    const PD_ELE_T      *pElement,
+    UINT32              magic,
+    TRDP_HIST_TYPE_T    cycleType,
+    TRDP_HIST_TYPE_T    type,
+    TRDP_HISTOGRAM_T    *pHistogram)
+{
+    const PD_HIST_T *pHist;
+
+    if ((pElement == NULL) || (pHistogram == NULL) || ((type != cycleType) && (type != TRDP_HIST_CALLBACK)))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if (pElement->magic != magic)
+    {
+        return (magic == TRDP_MAGIC_PUB_HNDL_VALUE) ? TRDP_NOPUB_ERR : TRDP_NOSUB_ERR;
+    }
+    pHist = pElement->pHist;
+    if (pHist == NULL)
+    {
+        return TRDP_NODATA_ERR;
+    }
+    trdp_histCopy(pHistogram, &pHist->hist[(type == TRDP_HIST_CALLBACK) ? TRDP_HIST_IDX_CALLBACK : TRDP_HIST_IDX_CYCLE]);
+    return TRDP_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Return a timing histogram of a publisher.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pubHandle           the handle returned by tlp_publish
+ *  @param[in]      type                TRDP_HIST_SND_LATENESS or TRDP_HIST_CALLBACK
+ *  @param[out]     pHistogram          copy of the histogram
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOPUB_ERR      not published
+ *  @retval         TRDP_NODATA_ERR     no histograms kept (TRDP_OPTION_HISTOGRAMS not set)
+ */
+EXT_DECL TRDP_ERR_T tlc_getPubHistogram (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_PUB_T          pubHandle,
+    TRDP_HIST_TYPE_T    type,
+    TRDP_HISTOGRAM_T    *pHistogram)
+{
+    return trdp_getHistogram(appHandle, pubHandle, TRDP_MAGIC_PUB_HNDL_VALUE, TRDP_HIST_SND_LATENESS, type,
+                             pHistogram);
+}
+
+/**********************************************************************************************************************/
+/** Return a timing histogram of a subscription.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      subHandle           the handle returned by tlp_subscribe
+ *  @param[in]      type                TRDP_HIST_RCV_INTERVAL or TRDP_HIST_CALLBACK
+ *  @param[out]     pHistogram          copy of the histogram
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error
+ *  @retval         TRDP_NOSUB_ERR      not subscribed
+ *  @retval         TRDP_NODATA_ERR     no histograms kept (TRDP_OPTION_HISTOGRAMS not set)
+ */
+EXT_DECL TRDP_ERR_T tlc_getSubsHistogram (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_SUB_T          subHandle,
+    TRDP_HIST_TYPE_T    type,
+    TRDP_HISTOGRAM_T    *pHistogram)
+{
+    return trdp_getHistogram(appHandle, subHandle, TRDP_MAGIC_SUB_HNDL_VALUE, TRDP_HIST_RCV_INTERVAL, type,
+                             pHistogram);
+}
+
+/**********************************************************************************************************************/
+/** Return the smallest value counted in a histogram bucket.
+ *
+ *  @param[in]      bucketIdx           index of the bucket (< TRDP_HIST_BUCKETS)
+ *  @retval         value in us
+ */
+EXT_DECL UINT32 tlc_getHistogramBucketStart (
+    UINT32 bucketIdx)
+{
+    UINT32 exp;
+
+    if (bucketIdx < TRDP_HIST_SUB_BUCKETS)
+    {
+        return bucketIdx;
+    }
+    if (bucketIdx >= TRDP_HIST_BUCKETS)
+    {
+        return 0xFFFFFFFFu;
+    }
+    exp = (bucketIdx >> TRDP_HIST_SUB_BITS) + TRDP_HIST_SUB_BITS - 1u;
+    return (TRDP_HIST_SUB_BUCKETS + (bucketIdx & (TRDP_HIST_SUB_BUCKETS - 1u))) << (exp - TRDP_HIST_SUB_BITS);
+}
+
+/**********************************************************************************************************************/
+/** Return a percentile of a histogram.
+ *
+ *  @param[in]      pHistogram          the histogram
+ *  @param[in]      permille            percentile in 1/1000 (e.g. 500 median, 999 for 99.9%)
+ *  @retval         value in us, 0 if the histogram is empty
+ */
+EXT_DECL UINT32 tlc_getHistogramPercentile (
+    const TRDP_HISTOGRAM_T  *pHistogram,
+    UINT32                  permille)
+{
+    UINT64  rank;
+    UINT64  sum = 0u;
+    UINT32  i;
+
+    if ((pHistogram == NULL) || (pHistogram->count == 0u))
+    {
+        return 0u;
+    }
+    if (permille > 1000u)
+    {
+        permille = 1000u;
+    }
+    rank = ((UINT64) pHistogram->count * permille + 999u) / 1000u;
+    if (rank == 0u)
+    {
+        return pHistogram->min;
+    }
+    for (i = 0u; i < TRDP_HIST_BUCKETS; i++)
+    {
+        sum += pHistogram->bucket[i];
+        if (sum >= rank)
+        {
+            UINT32 limit = tlc_getHistogramBucketStart(i + 1u) - 1u;
+
+            return (limit < pHistogram->max) ? ((limit > pHistogram->min) ? limit : pHistogram->min)
+                   : pHistogram->max;
+        }
+    }
+    return pHistogram->max;
+}
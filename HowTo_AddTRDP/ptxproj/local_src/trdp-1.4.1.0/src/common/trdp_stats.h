@@ -34,6 +34,35 @@
  * DEFINES
  */
 
+/*  Export and trace areas are shared with other processes: sequence numbers are accessed atomically   */
+#if defined(__GNUC__) || defined(__clang__)
+#define TRDP_STATS_LOAD(p, mo)      __atomic_load_n((p), (mo))
+#define TRDP_STATS_STORE(p, v, mo)  __atomic_store_n((p), (v), (mo))
+#define TRDP_STATS_FENCE(mo)        __atomic_thread_fence(mo)
+#define TRDP_STATS_MO_RELAXED       __ATOMIC_RELAXED
+#define TRDP_STATS_MO_ACQUIRE       __ATOMIC_ACQUIRE
+#define TRDP_STATS_MO_RELEASE       __ATOMIC_RELEASE
+#else
+#define TRDP_STATS_LOAD(p, mo)      (*(volatile const UINT32 *)(p))
+#define TRDP_STATS_STORE(p, v, mo)  (*(volatile UINT32 *)(p) = (v))
+#define TRDP_STATS_FENCE(mo)
+#define TRDP_STATS_MO_RELAXED       0
+#define TRDP_STATS_MO_ACQUIRE       0
+#define TRDP_STATS_MO_RELEASE       0
+#endif
+
+/** Add n to a per-ComId counter (member of TRDP_COMID_STATISTICS_T), only while the statistics export runs */
+#define TRDP_STATS_COMID_ADD(appHandle, comId, counter, n)                                 \
+    {                                                                                       \
+        if ((appHandle)->pStatsExport != NULL)                                              \
+        {                                                                                   \
+            TRDP_COMID_STATISTICS_T *pComIdStats_ = trdp_getComIdStats((appHandle), (comId));   \
+            if (pComIdStats_ != NULL)                                                       \
+            {                                                                               \
+                pComIdStats_->counter += (n);                                               \
+            }                                                                               \
+        }                                                                                   \
+    }
 
 /*******************************************************************************
  * TYPEDEFS
@@ -46,6 +75,17 @@
 
 void    trdp_initStats(TRDP_APP_SESSION_T appHandle);
 void    trdp_pdPrepareStats (TRDP_APP_SESSION_T appHandle, PD_ELE_T *pPacket);
+TRDP_COMID_STATISTICS_T *trdp_getComIdStats (TRDP_APP_SESSION_T appHandle, UINT32 comId);
+void    trdp_exportStats (TRDP_APP_SESSION_T appHandle);
+void    trdp_statsCheckPending (TRDP_APP_SESSION_T appHandle);
+void    trdp_releaseStatsExport (TRDP_APP_SESSION_T appHandle);
+void    trdp_initHist (TRDP_APP_SESSION_T appHandle, PD_ELE_T *pElement);
+void    trdp_releaseHist (TRDP_APP_SESSION_T appHandle, PD_ELE_T *pElement);
+void    trdp_histReceived (PD_ELE_T *pElement, const TRDP_TIME_T *pNow);
+void    trdp_histSent (PD_ELE_T *pElement);
+void    trdp_histCallbackStart (TRDP_APP_SESSION_T appHandle, PD_ELE_T *pElement);
+void    trdp_histCallbackEnd (TRDP_APP_SESSION_T appHandle);
+void    trdp_pdPrepareHist (TRDP_APP_SESSION_T appHandle, PD_ELE_T *pPacket, const UINT8 *pRequest, UINT32 size);
 
 
 #endif
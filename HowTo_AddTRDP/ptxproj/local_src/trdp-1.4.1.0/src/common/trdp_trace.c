@@ -0,0 +1,336 @@
+/******************************************************************************/
+/**
+ * @file            trdp_trace.c
+ *
+ * @brief           Tracepoints in the TRDP work loop
+ *
+ * @details         The events are written into a ring in a shared memory area. There is one writer, tlc_process
+ *                  holding the session mutex; readers in other processes use the sequence number of each event
+ *                  to detect events overwritten while they were copied.
+ *                  Compiled with TRDP_TRACE set only (make TRACE=1).
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/*******************************************************************************
+ * INCLUDES
+ */
+
+#include <string.h>
+
+#include "trdp_if_light.h"
+
+#if TRDP_TRACE
+
+#include "trdp_trace.h"
+#include "trdp_if.h"
+#include "trdp_stats.h"
+#include "trdp_utils.h"
+#include "vos_mem.h"
+#include "vos_thread.h"
+#include "vos_shared_mem.h"
+
+/*******************************************************************************
+ * DEFINES
+ */
+
+#define TRDP_TRACE_MIN_EVENTS   16u
+#define TRDP_TRACE_MAX_EVENTS   0x100000u
+
+/*******************************************************************************
+ * TYPEDEFS
+ */
+
+/** Trace ring of a session */
+struct TRDP_TRACE_RING
+{
+    VOS_SHRD_T          handle;         /**< shared memory handle */
+    UINT8               *pArea;         /**< start of the trace area */
+    UINT32              areaSize;       /**< size of the trace area */
+    TRDP_TRACE_HDR_T    *pHdr;          /**< header at the start of the area */
+    TRDP_TRACE_EVENT_T  *pEvents;       /**< the ring */
+    UINT32              mask;           /**< noOfEvents - 1 */
+    UINT32              numEvents;      /**< events written */
+};
+
+/******************************************************************************
+ *   Globals
+ */
+
+/**********************************************************************************************************************/
+/** Write an event into the trace ring.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession, tracing running
+ *  @param[in]      type                TRDP_TRACE_TYPE_T
+ *  @param[in]      phase               TRDP_TRACE_PHASE_T of begin and end events
+ *  @param[in]      comId               ComId of packet and callback events
+ *  @param[in]      size                packet size
+ */
+void trdp_traceRecord (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              type,
+    UINT32              phase,
+    UINT32              comId,
+    UINT32              size)
+{
+    struct TRDP_TRACE_RING   *pTrace = appHandle->pTrace;
+    TRDP_TRACE_EVENT_T  *pEvent = &pTrace->pEvents[pTrace->numEvents & pTrace->mask];
+    TRDP_TIME_T         now;
+
+    vos_getTime(&now);
+
+    TRDP_STATS_STORE(&pEvent->seq, 0u, TRDP_STATS_MO_RELAXED);
+    TRDP_STATS_FENCE(TRDP_STATS_MO_RELEASE);
+    pEvent->type    = (UINT16) type;
+    pEvent->phase   = (UINT16) phase;
+    pEvent->comId   = comId;
+    pEvent->size    = size;
+    pEvent->sec     = (UINT32) now.tv_sec;
+    pEvent->usec    = (UINT32) now.tv_usec;
+    TRDP_STATS_STORE(&pEvent->seq, pTrace->numEvents + 1u, TRDP_STATS_MO_RELEASE);
+    pTrace->numEvents++;
+    TRDP_STATS_STORE(&pTrace->pHdr->numEvents, pTrace->numEvents, TRDP_STATS_MO_RELEASE);
+}
+
+/**********************************************************************************************************************/
+/** Stop tracing, release the shared memory area.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ */
+void trdp_releaseTrace (
+    TRDP_APP_SESSION_T appHandle)
+{
+    struct TRDP_TRACE_RING *pTrace = appHandle->pTrace;
+
+    if (pTrace == NULL)
+    {
+        return;
+    }
+    appHandle->pTrace = NULL;
+
+    TRDP_STATS_STORE(&pTrace->pHdr->magic, 0u, TRDP_STATS_MO_RELEASE);
+    if (vos_sharedClose(pTrace->handle, pTrace->pArea) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_WARNING, "vos_sharedClose() failed\n");
+    }
+    vos_memFree(pTrace);
+}
+
+/**********************************************************************************************************************/
+/** Start tracing.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      pKey                name of the shared memory area
+ *  @param[in]      noOfEvents          size of the ring, rounded up to a power of 2
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_PARAM_ERR      parameter error or tracing already running
+ *  @retval         TRDP_MEM_ERR        out of memory or shared memory not available
+ */
+EXT_DECL TRDP_ERR_T tlc_startTrace (
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pKey,
+    UINT32              noOfEvents)
+{
+    TRDP_ERR_T          err     = TRDP_NO_ERR;
+    struct TRDP_TRACE_RING   *pTrace;
+    UINT32              ringSize;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if ((pKey == NULL) || (noOfEvents == 0u) || (noOfEvents > TRDP_TRACE_MAX_EVENTS))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    for (ringSize = TRDP_TRACE_MIN_EVENTS; ringSize < noOfEvents; ringSize <<= 1)
+    {
+        ;
+    }
+
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (appHandle->pTrace != NULL)
+    {
+        err = TRDP_PARAM_ERR;
+    }
+    else
+    {
+        pTrace = (struct TRDP_TRACE_RING *) vos_memAlloc(sizeof(struct TRDP_TRACE_RING));
+        if (pTrace == NULL)
+        {
+            err = TRDP_MEM_ERR;
+        }
+        else
+        {
+            pTrace->areaSize = sizeof(TRDP_TRACE_HDR_T) + ringSize * sizeof(TRDP_TRACE_EVENT_T);
+            if (vos_sharedOpen(pKey, &pTrace->handle, &pTrace->pArea, &pTrace->areaSize) != VOS_NO_ERR)
+            {
+                vos_printLog(VOS_LOG_ERROR, "Trace %s: no memory\n", pKey);
+                vos_memFree(pTrace);
+                err = TRDP_MEM_ERR;
+            }
+            else
+            {
+                pTrace->mask    = ringSize - 1u;
+                pTrace->pHdr    = (TRDP_TRACE_HDR_T *) pTrace->pArea;
+                pTrace->pEvents = (TRDP_TRACE_EVENT_T *) (pTrace->pArea + sizeof(TRDP_TRACE_HDR_T));
+
+                /*  An area left behind by an earlier session is reinitialised, readers wait for the magic    */
+                TRDP_STATS_STORE(&pTrace->pHdr->magic, 0u, TRDP_STATS_MO_RELEASE);
+                memset(pTrace->pArea + sizeof(UINT32), 0, pTrace->areaSize - sizeof(UINT32));
+                pTrace->pHdr->version       = TRDP_TRACE_VERSION;
+                pTrace->pHdr->eventOffset   = sizeof(TRDP_TRACE_HDR_T);
+                pTrace->pHdr->eventSize     = sizeof(TRDP_TRACE_EVENT_T);
+                pTrace->pHdr->noOfEvents    = ringSize;
+                TRDP_STATS_STORE(&pTrace->pHdr->magic, TRDP_TRACE_MAGIC, TRDP_STATS_MO_RELEASE);
+
+                appHandle->pTrace = pTrace;
+            }
+        }
+    }
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Stop tracing and remove the trace area.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_NOINIT_ERR     handle invalid
+ *  @retval         TRDP_NODATA_ERR     tracing not running
+ */
+EXT_DECL TRDP_ERR_T tlc_stopTrace (
+    TRDP_APP_SESSION_T appHandle)
+{
+    TRDP_ERR_T err = TRDP_NO_ERR;
+
+    if (!trdp_isValidSession(appHandle))
+    {
+        return TRDP_NOINIT_ERR;
+    }
+    if (vos_mutexLock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        return TRDP_NOINIT_ERR;
+    }
+
+    if (appHandle->pTrace == NULL)
+    {
+        err = TRDP_NODATA_ERR;
+    }
+    else
+    {
+        trdp_releaseTrace(appHandle);
+    }
+
+    if (vos_mutexUnlock(appHandle->mutex) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_INFO, "vos_mutexUnlock() failed\n");
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Read events from a trace area.
+ *
+ *  @param[in]      pArea               the trace area, attached with vos_sharedOpen
+ *  @param[in]      areaSize            size of the area
+ *  @param[in,out]  pNext               in: number of the first event to read, out: number of the next event
+ *  @param[out]     pEvents             buffer for the events
+ *  @param[in,out]  pNoOfEvents         in: size of the buffer, out: number of events read
+ *  @param[out]     pNumLost            number of events skipped, may be NULL
+ *  @retval         TRDP_NO_ERR         no error
+ *  @retval         TRDP_PARAM_ERR      parameter error or no valid trace area
+ *  @retval         TRDP_NODATA_ERR     no new events
+ */
+EXT_DECL TRDP_ERR_T tlc_readTrace (
+    const UINT8         *pArea,
+    UINT32              areaSize,
+    UINT32              *pNext,
+    TRDP_TRACE_EVENT_T  *pEvents,
+    UINT32              *pNoOfEvents,
+    UINT32              *pNumLost)
+{
+    const TRDP_TRACE_HDR_T      *pHdr = (const TRDP_TRACE_HDR_T *) pArea;
+    const TRDP_TRACE_EVENT_T    *pRing;
+    UINT32                      noOfEvents;
+    UINT32                      written;
+    UINT32                      next    = 0u;
+    UINT32                      lost    = 0u;
+    UINT32                      count   = 0u;
+
+    if ((pArea == NULL) || (pNext == NULL) || (pEvents == NULL) || (pNoOfEvents == NULL)
+        || (areaSize < sizeof(TRDP_TRACE_HDR_T))
+        || (TRDP_STATS_LOAD(&pHdr->magic, TRDP_STATS_MO_ACQUIRE) != TRDP_TRACE_MAGIC)
+        || (pHdr->version != TRDP_TRACE_VERSION)
+        || (pHdr->eventSize != sizeof(TRDP_TRACE_EVENT_T))
+        || (pHdr->noOfEvents == 0u) || ((pHdr->noOfEvents & (pHdr->noOfEvents - 1u)) != 0u)
+        || (pHdr->eventOffset < sizeof(TRDP_TRACE_HDR_T))
+        || (((UINT64) pHdr->noOfEvents * sizeof(TRDP_TRACE_EVENT_T) + pHdr->eventOffset) > areaSize))
+    {
+        return TRDP_PARAM_ERR;
+    }
+    noOfEvents  = pHdr->noOfEvents;
+    pRing       = (const TRDP_TRACE_EVENT_T *) (pArea + pHdr->eventOffset);
+    written     = TRDP_STATS_LOAD(&pHdr->numEvents, TRDP_STATS_MO_ACQUIRE);
+
+    /*  Event n is stored at index n % noOfEvents with seq n + 1, the ring holds the last noOfEvents events   */
+    next = *pNext;
+    if ((written - next) > noOfEvents)
+    {
+        lost = written - noOfEvents - next;
+        next = written - noOfEvents;
+    }
+
+    while ((count < *pNoOfEvents) && (next != written))
+    {
+        const TRDP_TRACE_EVENT_T *pEvent = &pRing[next & (noOfEvents - 1u)];
+
+        if (TRDP_STATS_LOAD(&pEvent->seq, TRDP_STATS_MO_ACQUIRE) == next + 1u)
+        {
+            pEvents[count] = *pEvent;
+            TRDP_STATS_FENCE(TRDP_STATS_MO_ACQUIRE);
+            if (TRDP_STATS_LOAD(&pEvent->seq, TRDP_STATS_MO_RELAXED) == next + 1u)
+            {
+                count++;
+            }
+            else
+            {
+                lost++;
+            }
+        }
+        else
+        {
+            lost++;                                 /* overwritten meanwhile */
+        }
+        next++;
+    }
+
+    *pNext          = next;
+    *pNoOfEvents    = count;
+    if (pNumLost != NULL)
+    {
+        *pNumLost = lost;
+    }
+    return ((count == 0u) && (lost == 0u)) ? TRDP_NODATA_ERR : TRDP_NO_ERR;
+}
+
+#endif /* TRDP_TRACE */
@@ -0,0 +1,77 @@
+/******************************************************************************/
+/**
+ * @file            trdp_trace.h
+ *
+ * @brief           Tracepoints in the TRDP work loop
+ *
+ * @details         Built in with TRDP_TRACE set only, otherwise the tracepoints expand to nothing.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+
+#ifndef TRDP_TRACE_H
+#define TRDP_TRACE_H
+
+/*******************************************************************************
+ * INCLUDES
+ */
+
+#include "trdp_if_light.h"
+#include "trdp_private.h"
+
+/*******************************************************************************
+ * DEFINES
+ */
+
+#if TRDP_TRACE
+
+/** Mark begin (TRDP_TRACE_BEGIN) or end (TRDP_TRACE_END) of a phase of tlc_process */
+#define TRDP_TRACE_PHASE(appHandle, type, phase)                                \
+    {                                                                           \
+        if ((appHandle)->pTrace != NULL)                                        \
+        {                                                                       \
+            trdp_traceRecord((appHandle), (type), (phase), 0u, 0u);             \
+        }                                                                       \
+    }
+
+/** Record a packet or callback event */
+#define TRDP_TRACE_EVENT(appHandle, type, comId, size)                          \
+    {                                                                           \
+        if ((appHandle)->pTrace != NULL)                                        \
+        {                                                                       \
+            trdp_traceRecord((appHandle), (type), 0u, (comId), (size));         \
+        }                                                                       \
+    }
+
+#else
+
+#define TRDP_TRACE_PHASE(appHandle, type, phase)
+#define TRDP_TRACE_EVENT(appHandle, type, comId, size)
+
+#endif
+
+/*******************************************************************************
+ * TYPEDEFS
+ */
+
+
+/*******************************************************************************
+ * GLOBAL FUNCTIONS
+ */
+
+#if TRDP_TRACE
+void    trdp_traceRecord (TRDP_APP_SESSION_T appHandle, UINT32 type, UINT32 phase, UINT32 comId, UINT32 size);
+void    trdp_releaseTrace (TRDP_APP_SESSION_T appHandle);
+#endif
+
+#endif
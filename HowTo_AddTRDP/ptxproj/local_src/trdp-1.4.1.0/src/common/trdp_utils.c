@@ -16,6 +16,9 @@
  *
  * $Id: trdp_utils.c 1789 2018-11-09 08:15:22Z ahweiss $
  *
+ *      AG 2026-10-19: trdp_mcRejoin drops each membership before adding it again, reports any failed join
+ *      AG 2026-10-18: Reference counted, hash indexed multicast joins without per socket limit, optional SSM
+ *      AG 2026-10-18: Socket pool per session, growing on demand, hash indexed by parameters and descriptor
  *      BL 2018-11-06: for-loops limited to sCurrentMaxSocketCnt instead VOS_MAX_SOCKET_CNT
  *      BL 2018-11-06: Ticket #219: PD Sequence Counter is not synched correctly
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
@@ -49,6 +52,10 @@
  * DEFINES
  */
 
+#define TRDP_SOCK_HASH_INIT     0x811C9DC5u     /**< FNV offset basis used as hash seed  */
+#define TRDP_SOCK_HASH_PRIME    0x01000193u     /**< FNV prime                           */
+#define TRDP_MC_JOIN_INDEX_SIZE 64u             /**< initial no. of MC membership buckets */
+
 /***********************************************************************************************************************
  * TYPEDEFS
  */
@@ -56,31 +63,45 @@
 /***********************************************************************************************************************
  *   Locals
  */
-static INT32 sCurrentMaxSocketCnt = 0;
 
 /***********************************************************************************************************************
  *   Local Functions
  */
-static void     printSocketUsage (TRDP_SOCKETS_T iface[]);
-static BOOL8    trdp_SockIsJoined (const TRDP_IP_ADDR_T mcList[VOS_MAX_MULTICAST_CNT],
-                                   TRDP_IP_ADDR_T       mcGroup);
-static BOOL8    trdp_SockAddJoin (TRDP_IP_ADDR_T    mcList[VOS_MAX_MULTICAST_CNT],
-                                  TRDP_IP_ADDR_T    mcGroup);
-static BOOL8    trdp_SockDelJoin (TRDP_IP_ADDR_T    mcList[VOS_MAX_MULTICAST_CNT],
-                                  TRDP_IP_ADDR_T    mcGroup);
+static void     printSocketUsage (TRDP_APP_SESSION_T appHandle);
+static UINT32   trdp_sockHashMix (UINT32    hash,
+                                  UINT32    value);
+static UINT32   trdp_sockKeyHash (TRDP_IP_ADDR_T    bindAddr,
+                                  TRDP_SOCK_TYPE_T  type,
+                                  UINT8             qos,
+                                  UINT8             ttl,
+                                  BOOL8             rcvMostly,
+                                  TRDP_IP_ADDR_T    cornerIp);
+static UINT32   trdp_sockFdHash (SOCKET sock);
+static TRDP_ERR_T trdp_growSockets (TRDP_APP_SESSION_T  appHandle,
+                                    INT32               newSize);
+static UINT32   trdp_mcJoinHash (INT32          lIndex,
+                                 TRDP_IP_ADDR_T mcGroup);
+static TRDP_MC_JOIN_T * *trdp_mcFindJoin (TRDP_APP_SESSION_T    appHandle,
+                                          INT32                 lIndex,
+                                          TRDP_IP_ADDR_T        mcGroup);
+static TRDP_ERR_T trdp_mcGrowIndex (TRDP_APP_SESSION_T appHandle);
+static void     trdp_mcFreeJoin (TRDP_APP_SESSION_T appHandle,
+                                 TRDP_MC_JOIN_T     *pJoin);
 
 /**********************************************************************************************************************/
 /** Debug socket usage output
  *
- *  @param[in]      iface            List of sockets
+ *  @param[in]      appHandle        session with the list of sockets
  *
  */
 static void printSocketUsage (
-    TRDP_SOCKETS_T iface[])
+    TRDP_APP_SESSION_T appHandle)
 {
-    INT32 lIndex = 0;
+    const TRDP_SOCKETS_T    *iface  = appHandle->iface;
+    INT32                   lIndex  = 0;
+
     vos_printLogStr(VOS_LOG_DBG, "------- Socket usage -------\n");
-    for (lIndex = 0; lIndex < sCurrentMaxSocketCnt; lIndex++)
+    for (lIndex = 0; lIndex < appHandle->ifaceCnt; lIndex++)
     {
         if (iface[lIndex].sock == -1)
         {
@@ -98,80 +119,303 @@ static void printSocketUsage (
 }
 
 /**********************************************************************************************************************/
-/** Check if a mc group is in the list
+/** Mix a value into a socket index hash
  *
- *  @param[in]      mcList              List of multicast groups
- *  @param[in]      mcGroup             multicast group
+ *  @param[in]      hash            hash so far
+ *  @param[in]      value           value to add
  *
- *  @retval         1           if found
- *                  0           if not found
+ *  @retval         new hash value
  */
-static BOOL8 trdp_SockIsJoined (
-    const TRDP_IP_ADDR_T    mcList[VOS_MAX_MULTICAST_CNT],
-    TRDP_IP_ADDR_T          mcGroup)
+static UINT32 trdp_sockHashMix (
+    UINT32  hash,
+    UINT32  value)
 {
-    int i = 0;
+    hash    ^= value;
+    hash    *= TRDP_SOCK_HASH_PRIME;
+    hash    ^= hash >> 16;
+    return hash;
+}
 
-    for (i = 0; i < VOS_MAX_MULTICAST_CNT && mcList[i] != mcGroup; i++)
+/**********************************************************************************************************************/
+/** Hash of a multicast membership
+ *
+ *  @param[in]      lIndex          index of the socket
+ *  @param[in]      mcGroup         multicast group
+ *
+ *  @retval         hash value
+ */
+static UINT32 trdp_mcJoinHash (
+    INT32           lIndex,
+    TRDP_IP_ADDR_T  mcGroup)
+{
+    return trdp_sockHashMix(trdp_sockHashMix(TRDP_SOCK_HASH_INIT, (UINT32) lIndex), mcGroup);
+}
+
+/**********************************************************************************************************************/
+/** Find the multicast membership of a socket
+ *
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
+ *  @param[in]      lIndex          index of the socket
+ *  @param[in]      mcGroup         multicast group
+ *
+ *  @retval         link to the membership, link at the end of the bucket if not found
+ *                  NULL if there is no index yet
+ */
+static TRDP_MC_JOIN_T * *trdp_mcFindJoin (
+    TRDP_APP_SESSION_T  appHandle,
+    INT32               lIndex,
+    TRDP_IP_ADDR_T      mcGroup)
+{
+    TRDP_MC_JOIN_T * *ppJoin;
+
+    if (appHandle->pMcJoinIndex == NULL)
     {
-        ;
+        return NULL;
     }
 
-    return i < VOS_MAX_MULTICAST_CNT;
+    ppJoin = &appHandle->pMcJoinIndex[trdp_mcJoinHash(lIndex, mcGroup) & (appHandle->mcJoinIndexSize - 1u)];
+    while ((*ppJoin != NULL) && (((*ppJoin)->sockIdx != lIndex) || ((*ppJoin)->mcGroup != mcGroup)))
+    {
+        ppJoin = &(*ppJoin)->pNextInBucket;
+    }
+    return ppJoin;
 }
 
 /**********************************************************************************************************************/
-/** Add mc group to the list
+/** Enlarge the multicast membership index
  *
- *  @param[in]      mcList          List of multicast groups
- *  @param[in]      mcGroup         multicast group
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
  *
- *  @retval         1           if added
- *                  0           if list is full
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_MEM_ERR
  */
-static BOOL8 trdp_SockAddJoin (
-    TRDP_IP_ADDR_T  mcList[VOS_MAX_MULTICAST_CNT],
-    TRDP_IP_ADDR_T  mcGroup)
+static TRDP_ERR_T trdp_mcGrowIndex (
+    TRDP_APP_SESSION_T appHandle)
 {
-    int i = 0;
+    UINT32          newSize = (appHandle->mcJoinIndexSize == 0u) ? TRDP_MC_JOIN_INDEX_SIZE :
+                              (appHandle->mcJoinIndexSize << 1);
+    TRDP_MC_JOIN_T  * *pNewIndex;
+    TRDP_MC_JOIN_T  *pJoin;
+    TRDP_MC_JOIN_T  *pNext;
+    UINT32          bucket;
+
+    pNewIndex = (TRDP_MC_JOIN_T * *) vos_memAlloc(newSize * sizeof(TRDP_MC_JOIN_T *));
+    if (pNewIndex == NULL)
+    {
+        vos_printLog(VOS_LOG_ERROR, "Multicast membership index cannot be enlarged to %u entries\n", newSize);
+        return TRDP_MEM_ERR;
+    }
 
-    for (i = 0; i < VOS_MAX_MULTICAST_CNT; i++)
+    for (bucket = 0u; bucket < appHandle->mcJoinIndexSize; bucket++)
     {
-        if (0 == mcList[i] || mcGroup == mcList[i])
+        for (pJoin = appHandle->pMcJoinIndex[bucket]; pJoin != NULL; pJoin = pNext)
         {
-            mcList[i] = mcGroup;
-            return TRUE;
+            UINT32 newBucket = trdp_mcJoinHash(pJoin->sockIdx, pJoin->mcGroup) & (newSize - 1u);
+
+            pNext = pJoin->pNextInBucket;
+            pJoin->pNextInBucket    = pNewIndex[newBucket];
+            pNewIndex[newBucket]    = pJoin;
         }
     }
 
-    return FALSE;
+    if (appHandle->pMcJoinIndex != NULL)
+    {
+        vos_memFree(appHandle->pMcJoinIndex);
+    }
+    appHandle->pMcJoinIndex     = pNewIndex;
+    appHandle->mcJoinIndexSize  = newSize;
+    return TRDP_NO_ERR;
 }
 
 /**********************************************************************************************************************/
-/** remove mc group from the list
+/** Remove a multicast membership from the index and from its socket, free it
+ *  The network stack is not touched.
  *
- *  @param[in]      mcList        List of multicast groups
- *  @param[in]      mcGroup         multicast group
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
+ *  @param[in]      pJoin           membership to remove
+ */
+static void trdp_mcFreeJoin (
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_MC_JOIN_T      *pJoin)
+{
+    TRDP_MC_JOIN_T * *ppJoin = trdp_mcFindJoin(appHandle, pJoin->sockIdx, pJoin->mcGroup);
+
+    if ((ppJoin != NULL) && (*ppJoin == pJoin))
+    {
+        *ppJoin = pJoin->pNextInBucket;
+    }
+
+    for (ppJoin = &appHandle->iface[pJoin->sockIdx].pMcJoins;
+         (*ppJoin != NULL) && (*ppJoin != pJoin);
+         ppJoin = &(*ppJoin)->pNextOfSocket)
+    {
+        ;
+    }
+    if (*ppJoin == pJoin)
+    {
+        *ppJoin = pJoin->pNextOfSocket;
+    }
+
+    while (pJoin->pSources != NULL)
+    {
+        TRDP_MC_SOURCE_T *pNext = pJoin->pSources->pNext;
+
+        vos_memFree(pJoin->pSources);
+        pJoin->pSources = pNext;
+    }
+    vos_memFree(pJoin);
+    appHandle->mcJoinCnt--;
+}
+
+/**********************************************************************************************************************/
+/** Hash of the parameters a socket is shared by
  *
- *  @retval         1           if deleted
- *                  0           was not in list
+ *  @param[in]      bindAddr        interface the socket is bound to
+ *  @param[in]      type            PD, MD/UDP, MD/TCP
+ *  @param[in]      qos             QoS of the socket
+ *  @param[in]      ttl             TTL of the socket
+ *  @param[in]      rcvMostly       primarily used for receiving
+ *  @param[in]      cornerIp        other TCP corner (0 for UDP)
+ *
+ *  @retval         hash value
  */
-static BOOL8 trdp_SockDelJoin (
-    TRDP_IP_ADDR_T  mcList[VOS_MAX_MULTICAST_CNT],
-    TRDP_IP_ADDR_T  mcGroup)
+static UINT32 trdp_sockKeyHash (
+    TRDP_IP_ADDR_T      bindAddr,
+    TRDP_SOCK_TYPE_T    type,
+    UINT8               qos,
+    UINT8               ttl,
+    BOOL8               rcvMostly,
+    TRDP_IP_ADDR_T      cornerIp)
 {
-    int i = 0;
+    UINT32 hash = TRDP_SOCK_HASH_INIT;
 
-    for (i = 0; i < VOS_MAX_MULTICAST_CNT; i++)
+    hash    = trdp_sockHashMix(hash, bindAddr);
+    hash    = trdp_sockHashMix(hash, ((UINT32) type << 24) | ((UINT32) qos << 16) | ((UINT32) ttl << 8) |
+                               (UINT32) rcvMostly);
+    hash    = trdp_sockHashMix(hash, (type == TRDP_SOCK_MD_TCP) ? cornerIp : 0u);
+    return hash;
+}
+
+/**********************************************************************************************************************/
+/** Hash of a socket descriptor
+ *
+ *  @param[in]      sock            socket descriptor
+ *
+ *  @retval         hash value
+ */
+static UINT32 trdp_sockFdHash (
+    SOCKET sock)
+{
+    return trdp_sockHashMix(TRDP_SOCK_HASH_INIT, (UINT32) sock);
+}
+
+/**********************************************************************************************************************/
+/** Enlarge the socket pool of a session
+ *  The socket entries (and the uncompleted TCP messages) are moved to a larger table, the hash indexes are rebuilt.
+ *  Socket indexes stay valid.
+ *
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
+ *  @param[in]      newSize         new number of entries
+ *
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_MEM_ERR
+ */
+static TRDP_ERR_T trdp_growSockets (
+    TRDP_APP_SESSION_T  appHandle,
+    INT32               newSize)
+{
+    TRDP_SOCKETS_T  *pNewIface;
+    INT32           *pNewKeyIndex;
+    INT32           *pNewFdIndex;
+    UINT32          newIndexSize = 1u;
+    INT32           lIndex;
+#if MD_SUPPORT
+    MD_ELE_T        * *pNewUncompleted;
+#endif
+
+    while (newIndexSize < (UINT32) newSize)
+    {
+        newIndexSize <<= 1;
+    }
+
+    pNewIface       = (TRDP_SOCKETS_T *) vos_memAlloc((UINT32) newSize * sizeof(TRDP_SOCKETS_T));
+    pNewKeyIndex    = (INT32 *) vos_memAlloc(newIndexSize * sizeof(INT32));
+    pNewFdIndex     = (INT32 *) vos_memAlloc(newIndexSize * sizeof(INT32));
+#if MD_SUPPORT
+    pNewUncompleted = (MD_ELE_T * *) vos_memAlloc((UINT32) newSize * sizeof(MD_ELE_T *));
+    if (pNewUncompleted == NULL)
+    {
+        newIndexSize = 0u;
+    }
+#endif
+    if ((pNewIface == NULL) || (pNewKeyIndex == NULL) || (pNewFdIndex == NULL) || (newIndexSize == 0u))
     {
-        if (mcGroup == mcList[i])
+        vos_printLog(VOS_LOG_ERROR, "Socket pool cannot be enlarged to %d entries\n", newSize);
+        if (pNewIface != NULL)
+        {
+            vos_memFree(pNewIface);
+        }
+        if (pNewKeyIndex != NULL)
+        {
+            vos_memFree(pNewKeyIndex);
+        }
+        if (pNewFdIndex != NULL)
+        {
+            vos_memFree(pNewFdIndex);
+        }
+#if MD_SUPPORT
+        if (pNewUncompleted != NULL)
         {
-            mcList[i] = 0;
-            return TRUE;
+            vos_memFree(pNewUncompleted);
         }
+#endif
+        return TRDP_MEM_ERR;
+    }
+
+    if (appHandle->iface != NULL)
+    {
+        memcpy(pNewIface, appHandle->iface, (UINT32) appHandle->ifaceSize * sizeof(TRDP_SOCKETS_T));
+        vos_memFree(appHandle->iface);
+        vos_memFree(appHandle->pSockKeyIndex);
+        vos_memFree(appHandle->pSockFdIndex);
+#if MD_SUPPORT
+        memcpy(pNewUncompleted, appHandle->uncompletedTCP, (UINT32) appHandle->ifaceSize * sizeof(MD_ELE_T *));
+        vos_memFree(appHandle->uncompletedTCP);
+#endif
     }
 
-    return FALSE;
+    for (lIndex = appHandle->ifaceSize; lIndex < newSize; lIndex++)
+    {
+        pNewIface[lIndex].sock          = VOS_INVALID_SOCKET;
+        pNewIface[lIndex].hashedSock    = VOS_INVALID_SOCKET;
+    }
+
+    appHandle->iface            = pNewIface;
+    appHandle->ifaceSize        = newSize;
+    appHandle->pSockKeyIndex    = pNewKeyIndex;
+    appHandle->pSockFdIndex     = pNewFdIndex;
+    appHandle->sockIndexSize    = newIndexSize;
+#if MD_SUPPORT
+    appHandle->uncompletedTCP   = pNewUncompleted;
+#endif
+
+    /*  Rebuild the hash indexes for the new number of buckets  */
+    for (lIndex = 0; lIndex < (INT32) newIndexSize; lIndex++)
+    {
+        pNewKeyIndex[lIndex]    = TRDP_INVALID_SOCKET_INDEX;
+        pNewFdIndex[lIndex]     = TRDP_INVALID_SOCKET_INDEX;
+    }
+    for (lIndex = 0; lIndex < appHandle->ifaceCnt; lIndex++)
+    {
+        if (pNewIface[lIndex].hashedSock != VOS_INVALID_SOCKET)
+        {
+            pNewIface[lIndex].hashedSock = VOS_INVALID_SOCKET;
+            trdp_indexSocket(appHandle, lIndex);
+        }
+    }
+
+    vos_printLog(VOS_LOG_INFO, "Socket pool enlarged to %d entries\n", newSize);
+    return TRDP_NO_ERR;
 }
 
 
@@ -179,50 +423,392 @@ static BOOL8 trdp_SockDelJoin (
  *   Globals
  */
 
-INT32 trdp_getCurrentMaxSocketCnt()
+/**********************************************************************************************************************/
+/** Return the largest number of the socket index
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *
+ *  @return      maxSocketCount
+ */
+INT32 trdp_getCurrentMaxSocketCnt (
+    TRDP_APP_SESSION_T appHandle)
 {
-    return sCurrentMaxSocketCnt;
+    return appHandle->ifaceCnt;
 }
 
 /**********************************************************************************************************************/
-/** Check an MC group not used by other sockets / subscribers/ listeners
+/** Add a socket entry to the hash indexes of the socket pool
+ *  The entry is found by its parameters and by its descriptor afterwards.
  *
  *  @param[in]      appHandle           the handle returned by tlc_openSession
- *  @param[in]      mcGroup             multicast group to look for
+ *  @param[in]      lIndex              index of the socket entry
+ */
+void trdp_indexSocket (
+    TRDP_APP_SESSION_T  appHandle,
+    INT32               lIndex)
+{
+    TRDP_SOCKETS_T  *pIface = &appHandle->iface[lIndex];
+    UINT32          bucket;
+
+    if ((pIface->sock == VOS_INVALID_SOCKET) || (pIface->hashedSock != VOS_INVALID_SOCKET))
+    {
+        return;
+    }
+
+    pIface->keyHash     = trdp_sockKeyHash(pIface->bindAddr, pIface->type, pIface->sendParam.qos,
+                                           pIface->sendParam.ttl, pIface->rcvMostly, pIface->tcpParams.cornerIp);
+    pIface->hashedSock  = pIface->sock;
+
+    bucket = pIface->keyHash & (appHandle->sockIndexSize - 1u);
+    pIface->nextByKey = appHandle->pSockKeyIndex[bucket];
+    appHandle->pSockKeyIndex[bucket] = lIndex;
+
+    bucket = trdp_sockFdHash(pIface->sock) & (appHandle->sockIndexSize - 1u);
+    pIface->nextBySock = appHandle->pSockFdIndex[bucket];
+    appHandle->pSockFdIndex[bucket] = lIndex;
+}
+
+/**********************************************************************************************************************/
+/** Remove a socket entry from the hash indexes of the socket pool
+ *  Must be called before the descriptor or the parameters of the entry are changed.
  *
- *  @retval         multi cast group if unused
- *                  VOS_INADDR_ANY if used
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      lIndex              index of the socket entry
  */
-TRDP_IP_ADDR_T trdp_findMCjoins (
+void trdp_unindexSocket (
     TRDP_APP_SESSION_T  appHandle,
-    TRDP_IP_ADDR_T      mcGroup)
+    INT32               lIndex)
 {
-    int         used = FALSE;
-    PD_ELE_T    *pIter;
-    for (pIter = appHandle->pRcvQueue; pIter != NULL; pIter = pIter->pNext)
+    TRDP_SOCKETS_T  *pIface = &appHandle->iface[lIndex];
+    INT32           *pLink;
+
+    if (pIface->hashedSock == VOS_INVALID_SOCKET)
     {
-        if ((pIter->addr.mcGroup != VOS_INADDR_ANY) &&
-            (pIter->addr.mcGroup == mcGroup))
+        return;
+    }
+
+    pLink = &appHandle->pSockKeyIndex[pIface->keyHash & (appHandle->sockIndexSize - 1u)];
+    while ((*pLink != TRDP_INVALID_SOCKET_INDEX) && (*pLink != lIndex))
+    {
+        pLink = &appHandle->iface[*pLink].nextByKey;
+    }
+    if (*pLink == lIndex)
+    {
+        *pLink = pIface->nextByKey;
+    }
+
+    pLink = &appHandle->pSockFdIndex[trdp_sockFdHash(pIface->hashedSock) & (appHandle->sockIndexSize - 1u)];
+    while ((*pLink != TRDP_INVALID_SOCKET_INDEX) && (*pLink != lIndex))
+    {
+        pLink = &appHandle->iface[*pLink].nextBySock;
+    }
+    if (*pLink == lIndex)
+    {
+        *pLink = pIface->nextBySock;
+    }
+
+    pIface->hashedSock = VOS_INVALID_SOCKET;
+}
+
+/**********************************************************************************************************************/
+/** Find the socket pool entry of a socket descriptor
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      sock                socket descriptor to look for
+ *
+ *  @retval         index of the socket entry or TRDP_INVALID_SOCKET_INDEX
+ */
+INT32 trdp_findSocketIndex (
+    TRDP_APP_SESSION_T  appHandle,
+    SOCKET              sock)
+{
+    INT32 lIndex;
+
+    if ((sock == VOS_INVALID_SOCKET) || (appHandle->pSockFdIndex == NULL))
+    {
+        return TRDP_INVALID_SOCKET_INDEX;
+    }
+
+    for (lIndex = appHandle->pSockFdIndex[trdp_sockFdHash(sock) & (appHandle->sockIndexSize - 1u)];
+         lIndex != TRDP_INVALID_SOCKET_INDEX;
+         lIndex = appHandle->iface[lIndex].nextBySock)
+    {
+        if ((appHandle->iface[lIndex].hashedSock == sock) && (appHandle->iface[lIndex].sock == sock))
         {
-            used = TRUE;
-            break;
+            return lIndex;
+        }
+    }
+    return TRDP_INVALID_SOCKET_INDEX;
+}
+
+/**********************************************************************************************************************/
+/** Join a multicast group on a socket of the pool
+ *  Memberships are reference counted per socket and group. The network stack is only asked to join if this is the
+ *  first user of the group on that socket (or of the source, for source specific users).
+ *  As long as any user accepts all sources, the group is joined for any source. Otherwise it is joined for the
+ *  sources of the source specific users only, and datagrams of other publishers are dropped by the network stack.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      lIndex              index of the socket
+ *  @param[in]      mcGroup             multicast group to join
+ *  @param[in]      srcIp               source to receive the group from, VOS_INADDR_ANY for any source
+ *  @param[in]      ifaceIp             interface to join on
+ *
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_MEM_ERR
+ *  @retval         TRDP_SOCK_ERR       group could not be joined
+ */
+TRDP_ERR_T trdp_mcJoin (
+    TRDP_APP_SESSION_T  appHandle,
+    INT32               lIndex,
+    TRDP_IP_ADDR_T      mcGroup,
+    TRDP_IP_ADDR_T      srcIp,
+    TRDP_IP_ADDR_T      ifaceIp)
+{
+    TRDP_SOCKETS_T      *pIface = &appHandle->iface[lIndex];
+    TRDP_MC_JOIN_T      * *ppJoin;
+    TRDP_MC_JOIN_T      *pJoin;
+    TRDP_MC_SOURCE_T    *pSrc   = NULL;
+    VOS_ERR_T           err     = VOS_NO_ERR;
+
+    if ((appHandle->mcJoinCnt >= appHandle->mcJoinIndexSize) &&
+        (trdp_mcGrowIndex(appHandle) != TRDP_NO_ERR))
+    {
+        return TRDP_MEM_ERR;
+    }
+
+    ppJoin  = trdp_mcFindJoin(appHandle, lIndex, mcGroup);
+    pJoin   = *ppJoin;
+    if (pJoin == NULL)
+    {
+        pJoin = (TRDP_MC_JOIN_T *) vos_memAlloc(sizeof(TRDP_MC_JOIN_T));
+        if (pJoin == NULL)
+        {
+            return TRDP_MEM_ERR;
         }
+        pJoin->sockIdx          = lIndex;
+        pJoin->mcGroup          = mcGroup;
+        pJoin->ifaceIp          = ifaceIp;
+        *ppJoin                 = pJoin;
+        pJoin->pNextOfSocket    = pIface->pMcJoins;
+        pIface->pMcJoins        = pJoin;
+        appHandle->mcJoinCnt++;
     }
-    #if MD_SUPPORT
+
+    if (srcIp == VOS_INADDR_ANY)
     {
-        MD_LIS_ELE_T *pMDIter;
-        for (pMDIter = appHandle->pMDListenQueue; pMDIter != NULL; pMDIter = pMDIter->pNext)
+        if (pJoin->anyRefCnt == 0u)
         {
-            if ((pMDIter->addr.mcGroup != VOS_INADDR_ANY) &&
-                (pMDIter->addr.mcGroup == mcGroup))
+            /*  Source filters must be dropped before the group can be joined for any source  */
+            for (pSrc = pJoin->pSources; pSrc != NULL; pSrc = pSrc->pNext)
             {
-                used = TRUE;
-                break;
+                (void) vos_sockLeaveSourceMC(pIface->sock, mcGroup, pSrc->srcIp, pJoin->ifaceIp);
+            }
+            err = vos_sockJoinMC(pIface->sock, mcGroup, pJoin->ifaceIp);
+            if (err != VOS_NO_ERR)
+            {
+                for (pSrc = pJoin->pSources; pSrc != NULL; pSrc = pSrc->pNext)
+                {
+                    (void) vos_sockJoinSourceMC(pIface->sock, mcGroup, pSrc->srcIp, pJoin->ifaceIp);
+                }
+            }
+        }
+        if (err == VOS_NO_ERR)
+        {
+            pJoin->anyRefCnt++;
+        }
+    }
+    else
+    {
+        for (pSrc = pJoin->pSources; (pSrc != NULL) && (pSrc->srcIp != srcIp); pSrc = pSrc->pNext)
+        {
+            ;
+        }
+        if (pSrc == NULL)
+        {
+            pSrc = (TRDP_MC_SOURCE_T *) vos_memAlloc(sizeof(TRDP_MC_SOURCE_T));
+            if (pSrc == NULL)
+            {
+                err = VOS_MEM_ERR;
+            }
+            else
+            {
+                /*  Any source membership includes this source already  */
+                if (pJoin->anyRefCnt == 0u)
+                {
+                    err = vos_sockJoinSourceMC(pIface->sock, mcGroup, srcIp, pJoin->ifaceIp);
+                }
+                if (err != VOS_NO_ERR)
+                {
+                    vos_memFree(pSrc);
+                    pSrc = NULL;
+                }
+                else
+                {
+                    pSrc->srcIp     = srcIp;
+                    pSrc->pNext     = pJoin->pSources;
+                    pJoin->pSources = pSrc;
+                }
+            }
+        }
+        if (pSrc != NULL)
+        {
+            pSrc->refCnt++;
+        }
+    }
+
+    /*  Forget a membership which could not be established  */
+    if ((pJoin->anyRefCnt == 0u) && (pJoin->pSources == NULL))
+    {
+        trdp_mcFreeJoin(appHandle, pJoin);
+    }
+
+    return (TRDP_ERR_T) err;
+}
+
+/**********************************************************************************************************************/
+/** Leave a multicast group on a socket of the pool
+ *  The network stack is only asked to leave if this was the last user of the group (or of the source).
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      lIndex              index of the socket
+ *  @param[in]      mcGroup             multicast group to leave
+ *  @param[in]      srcIp               source the group was joined for, VOS_INADDR_ANY for any source
+ */
+void trdp_mcLeave (
+    TRDP_APP_SESSION_T  appHandle,
+    INT32               lIndex,
+    TRDP_IP_ADDR_T      mcGroup,
+    TRDP_IP_ADDR_T      srcIp)
+{
+    TRDP_MC_JOIN_T * *ppJoin = trdp_mcFindJoin(appHandle, lIndex, mcGroup);
+    TRDP_MC_JOIN_T      *pJoin;
+    TRDP_MC_SOURCE_T    * *ppSrc;
+    SOCKET              sock;
+
+    if ((ppJoin == NULL) || (*ppJoin == NULL))
+    {
+        return;
+    }
+    pJoin   = *ppJoin;
+    sock    = appHandle->iface[lIndex].sock;
+
+    if (srcIp == VOS_INADDR_ANY)
+    {
+        if (pJoin->anyRefCnt == 0u)
+        {
+            return;
+        }
+        pJoin->anyRefCnt--;
+        if (pJoin->anyRefCnt == 0u)
+        {
+            TRDP_MC_SOURCE_T *pSrc;
+
+            if (vos_sockLeaveMC(sock, mcGroup, pJoin->ifaceIp) != VOS_NO_ERR)
+            {
+                vos_printLogStr(VOS_LOG_WARNING, "trdp_sockLeaveMC() failed!\n");
+            }
+            /*  Source specific users remain: filter for their sources again  */
+            for (pSrc = pJoin->pSources; pSrc != NULL; pSrc = pSrc->pNext)
+            {
+                (void) vos_sockJoinSourceMC(sock, mcGroup, pSrc->srcIp, pJoin->ifaceIp);
+            }
+        }
+    }
+    else
+    {
+        for (ppSrc = &pJoin->pSources; (*ppSrc != NULL) && ((*ppSrc)->srcIp != srcIp); ppSrc = &(*ppSrc)->pNext)
+        {
+            ;
+        }
+        if (*ppSrc == NULL)
+        {
+            return;
+        }
+        (*ppSrc)->refCnt--;
+        if ((*ppSrc)->refCnt == 0u)
+        {
+            TRDP_MC_SOURCE_T *pSrc = *ppSrc;
+
+            if (pJoin->anyRefCnt == 0u)
+            {
+                (void) vos_sockLeaveSourceMC(sock, mcGroup, srcIp, pJoin->ifaceIp);
+            }
+            *ppSrc = pSrc->pNext;
+            vos_memFree(pSrc);
+        }
+    }
+
+    if ((pJoin->anyRefCnt == 0u) && (pJoin->pSources == NULL))
+    {
+        trdp_mcFreeJoin(appHandle, pJoin);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Forget all multicast memberships of a socket
+ *  To be called when the socket is closed, which leaves its groups anyway.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *  @param[in]      lIndex              index of the socket
+ */
+void trdp_mcDropJoins (
+    TRDP_APP_SESSION_T  appHandle,
+    INT32               lIndex)
+{
+    while (appHandle->iface[lIndex].pMcJoins != NULL)
+    {
+        trdp_mcFreeJoin(appHandle, appHandle->iface[lIndex].pMcJoins);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Join all multicast memberships of the socket pool again (e.g. after a link down/up event)
+ *
+ *  Each membership is dropped before it is added again: the kernel may still hold it, and only a new join
+ *  sends a fresh IGMP report to the switches.
+ *
+ *  @param[in]      appHandle           the handle returned by tlc_openSession
+ *
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_SOCK_ERR       at least one group could not be joined
+ */
+TRDP_ERR_T trdp_mcRejoin (
+    TRDP_APP_SESSION_T appHandle)
+{
+    TRDP_ERR_T          ret = TRDP_NO_ERR;
+    TRDP_MC_JOIN_T      *pJoin;
+    TRDP_MC_SOURCE_T    *pSrc;
+    UINT32              bucket;
+
+    for (bucket = 0u; bucket < appHandle->mcJoinIndexSize; bucket++)
+    {
+        for (pJoin = appHandle->pMcJoinIndex[bucket]; pJoin != NULL; pJoin = pJoin->pNextInBucket)
+        {
+            SOCKET sock = appHandle->iface[pJoin->sockIdx].sock;
+
+            if (pJoin->anyRefCnt != 0u)
+            {
+                (void) vos_sockLeaveMC(sock, pJoin->mcGroup, pJoin->ifaceIp);
+                if (vos_sockJoinMC(sock, pJoin->mcGroup, pJoin->ifaceIp) != VOS_NO_ERR)
+                {
+                    ret = TRDP_SOCK_ERR;
+                }
+            }
+            else
+            {
+                for (pSrc = pJoin->pSources; pSrc != NULL; pSrc = pSrc->pNext)
+                {
+                    (void) vos_sockLeaveSourceMC(sock, pJoin->mcGroup, pSrc->srcIp, pJoin->ifaceIp);
+                    if (vos_sockJoinSourceMC(sock, pJoin->mcGroup, pSrc->srcIp, pJoin->ifaceIp) != VOS_NO_ERR)
+                    {
+                        ret = TRDP_SOCK_ERR;
+                    }
+                }
             }
         }
     }
-    #endif
-    return (used == TRUE) ? VOS_INADDR_ANY : mcGroup;
+    return ret;
 }
 
 /**********************************************************************************************************************/
@@ -590,7 +1176,7 @@ void trdp_initUncompletedTCP (TRDP_APP_SESSION_T appHandle)
 {
     int lIndex;
     /* Initialize the pointers to Null */
-    for (lIndex = 0; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
+    for (lIndex = 0; lIndex < appHandle->ifaceSize; lIndex++)
     {
         appHandle->uncompletedTCP[lIndex] = NULL;
     }
@@ -651,28 +1237,84 @@ void    trdp_queueInsFirst (
 
 /**********************************************************************************************************************/
 /** Handle the socket pool: Initialize it
+ *  The pool starts with VOS_MAX_SOCKET_CNT entries and is enlarged when needed.
+ *
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
  *
- *  @param[in]      iface          pointer to the socket pool
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_MEM_ERR
  */
-void trdp_initSockets (TRDP_SOCKETS_T iface[])
+TRDP_ERR_T trdp_initSockets (TRDP_APP_SESSION_T appHandle)
 {
-    int lIndex;
-    /* Clear the socket pool */
-    for (lIndex = 0; lIndex < VOS_MAX_SOCKET_CNT; lIndex++)
+    appHandle->iface            = NULL;
+    appHandle->ifaceSize        = 0;
+    appHandle->ifaceCnt         = 0;
+    appHandle->pSockKeyIndex    = NULL;
+    appHandle->pSockFdIndex     = NULL;
+    appHandle->sockIndexSize    = 0u;
+    appHandle->pMcJoinIndex     = NULL;
+    appHandle->mcJoinIndexSize  = 0u;
+    appHandle->mcJoinCnt        = 0u;
+#if MD_SUPPORT
+    appHandle->uncompletedTCP   = NULL;
+#endif
+    return trdp_growSockets(appHandle, VOS_MAX_SOCKET_CNT);
+}
+
+/**********************************************************************************************************************/
+/** Handle the socket pool: Close all sockets still open and free the pool
+ *
+ *  @param[in]      appHandle       the handle returned by tlc_openSession
+ */
+void trdp_freeSockets (TRDP_APP_SESSION_T appHandle)
+{
+    INT32 lIndex;
+
+    if (appHandle->iface == NULL)
+    {
+        return;
+    }
+
+    for (lIndex = 0; lIndex < appHandle->ifaceCnt; lIndex++)
+    {
+        trdp_mcDropJoins(appHandle, lIndex);
+        if (appHandle->iface[lIndex].sock != VOS_INVALID_SOCKET)
+        {
+            (void) vos_sockClose(appHandle->iface[lIndex].sock);
+            appHandle->iface[lIndex].sock = VOS_INVALID_SOCKET;
+        }
+    }
+
+    if (appHandle->pMcJoinIndex != NULL)
     {
-        iface[lIndex].sock = VOS_INVALID_SOCKET;
+        vos_memFree(appHandle->pMcJoinIndex);
     }
+    vos_memFree(appHandle->iface);
+    vos_memFree(appHandle->pSockKeyIndex);
+    vos_memFree(appHandle->pSockFdIndex);
+#if MD_SUPPORT
+    vos_memFree(appHandle->uncompletedTCP);
+    appHandle->uncompletedTCP = NULL;
+#endif
+    appHandle->iface            = NULL;
+    appHandle->pSockKeyIndex    = NULL;
+    appHandle->pSockFdIndex     = NULL;
+    appHandle->ifaceSize        = 0;
+    appHandle->ifaceCnt         = 0;
+    appHandle->pMcJoinIndex     = NULL;
+    appHandle->mcJoinIndexSize  = 0u;
 }
 
 /**********************************************************************************************************************/
 /** Handle the socket pool: Request a socket from our socket pool
- *  First we loop through the socket pool and check if there is already a socket
- *  which would suit us. If a multicast group should be joined, we do that on an otherwise suitable socket - up to 20
- *  multicast goups can be joined per socket.
+ *  First we look up the socket pool (hashed by the socket parameters) and check if there is already a socket
+ *  which would suit us. If a multicast group should be joined, we do that on an otherwise suitable socket - there
+ *  is no limit on the number of groups joined per socket.
  *  If a socket for multicast publishing is requested, we also use the source IP to determine the interface for outgoing
  *  multicast traffic.
+ *  If the pool is full, it is enlarged.
  *
- *  @param[in,out]  iface           socket pool
+ *  @param[in,out]  appHandle       session with the socket pool
  *  @param[in]      port            port to use
  *  @param[in]      params          parameters to use
  *  @param[in]      srcIP           IP to bind to (0 = any address)
@@ -682,13 +1324,15 @@ void trdp_initSockets (TRDP_SOCKETS_T iface[])
  *  @param[in]      rcvMostly       primarily used for receiving (tbd: bind on sender, too?)
  *  @param[out]     useSocket       socket to use, do not open a new one
  *  @param[out]     pIndex          returned index of socket pool
- *  @param[in]      cornerIp        only used for receiving
+ *  @param[in]      cornerIp        TCP: other corner (only used for receiving),
+ *                                  UDP: source to join mcGroup for (0 = any source)
  *
  *  @retval         TRDP_NO_ERR
  *  @retval         TRDP_PARAM_ERR
+ *  @retval         TRDP_MEM_ERR
  */
 TRDP_ERR_T  trdp_requestSocket (
-    TRDP_SOCKETS_T          iface[],
+    TRDP_APP_SESSION_T      appHandle,
     UINT16                  port,
     const TRDP_SEND_PARAM_T *params,
     TRDP_IP_ADDR_T          srcIP,
@@ -701,37 +1345,40 @@ TRDP_ERR_T  trdp_requestSocket (
     TRDP_IP_ADDR_T          cornerIp)
 {
     VOS_SOCK_OPT_T  sock_options;
+    TRDP_SOCKETS_T  *iface;
     INT32           lIndex;
-    INT32           emptySockIdx = -1;  /* was emptySock, renamed to avoid confusion */
     TRDP_ERR_T      err         = TRDP_NO_ERR;
     TRDP_IP_ADDR_T  bindAddr    = vos_determineBindAddr(srcIP, mcGroup, rcvMostly);
 
     memset(&sock_options, 0, sizeof(sock_options));
 
-    if (iface == NULL || params == NULL || pIndex == NULL)
+    if (appHandle == NULL || appHandle->iface == NULL || params == NULL || pIndex == NULL)
     {
         return TRDP_PARAM_ERR;
     }
 
-    /*  We loop through the table of open/used sockets,
-     if we find a usable one (with the same socket options) we take it.
-     if we search for a multicast group enabled socket, we also search the list of mc groups (max. 20)
-     and possibly add that group, if everything else fits.
-     We remember already closed sockets on the way to be able to fill up gaps  */
+    iface = appHandle->iface;
 
-    for (lIndex = 0; lIndex < sCurrentMaxSocketCnt; lIndex++)
+    /*  Check if the wanted socket is already in our list; if yes, increment usage */
+    lIndex = trdp_findSocketIndex(appHandle, useSocket);
+    if (lIndex != TRDP_INVALID_SOCKET_INDEX)
     {
-        /*  Check if the wanted socket is already in our list; if yes, increment usage */
-        if (useSocket != VOS_INVALID_SOCKET &&
-            useSocket == iface[lIndex].sock)
-        {
-            /* Use that socket */
-            *pIndex = lIndex;
-            iface[lIndex].usage++;
-            err = TRDP_NO_ERR;
-            goto err_exit;
-        }
-        else if ((iface[lIndex].sock != VOS_INVALID_SOCKET)
+        /* Use that socket */
+        *pIndex = lIndex;
+        iface[lIndex].usage++;
+        return TRDP_NO_ERR;
+    }
+
+    /*  We look up the open/used sockets with the same socket options,
+     if we find a usable one we take it.
+     if we search for a multicast group enabled socket, we join that group on it, if everything else fits.  */
+
+    for (lIndex = appHandle->pSockKeyIndex[trdp_sockKeyHash(bindAddr, type, params->qos, params->ttl, rcvMostly,
+                                                            cornerIp) & (appHandle->sockIndexSize - 1u)];
+         lIndex != TRDP_INVALID_SOCKET_INDEX;
+         lIndex = iface[lIndex].nextByKey)
+    {
+        if ((iface[lIndex].sock != VOS_INVALID_SOCKET)
                  && (iface[lIndex].bindAddr == bindAddr)
                  && (iface[lIndex].type == type)
                  && (iface[lIndex].sendParam.qos == params->qos)
@@ -740,25 +1387,12 @@ TRDP_ERR_T  trdp_requestSocket (
                  && ((type != TRDP_SOCK_MD_TCP)
                      || ((type == TRDP_SOCK_MD_TCP) && (iface[lIndex].tcpParams.cornerIp == cornerIp) && (iface[lIndex].usage == 0))))
         {
-            /*  Did this socket join the required multicast group?  */
-            if (mcGroup != 0 && trdp_SockIsJoined(iface[lIndex].mcGroups, mcGroup) == FALSE)
+            /*  Join the required multicast group (again), if the socket is used for receiving  */
+            if ((mcGroup != 0u) && (rcvMostly == TRUE) &&
+                (trdp_mcJoin(appHandle, lIndex, mcGroup, (type != TRDP_SOCK_MD_TCP) ? cornerIp : 0u,
+                             srcIP) != TRDP_NO_ERR))
             {
-                /*  No, but can we add it? */
-                if (trdp_SockAddJoin(iface[lIndex].mcGroups, mcGroup) == FALSE)
-                {
-                    continue;   /* No, socket cannot join more MC groups */
-                }
-                else
-                {
-                    if (vos_sockJoinMC(iface[lIndex].sock, mcGroup, srcIP) != VOS_NO_ERR)
-                    {
-                        if (trdp_SockDelJoin(iface[lIndex].mcGroups, mcGroup) == FALSE)
-                        {
-                            vos_printLogStr(VOS_LOG_ERROR, "trdp_SockDelJoin() failed!\n");
-                        }
-                        continue;   /* No, socket cannot join more MC groups */
-                    }
-                }
+                continue;   /* No, socket cannot join this MC group */
             }
 
 /* add_start TOSHIBA 0306 */
@@ -784,30 +1418,41 @@ TRDP_ERR_T  trdp_requestSocket (
             {
                 iface[lIndex].usage++;
             }
+            else if ((mcGroup != 0u) && (rcvMostly == TRUE))
+            {
+                trdp_mcLeave(appHandle, lIndex, mcGroup, (type != TRDP_SOCK_MD_TCP) ? cornerIp : 0u);
+            }
 
-            goto err_exit;
-        }
-        else if ((iface[lIndex].sock == VOS_INVALID_SOCKET) && (emptySockIdx == -1))
-        {
-            /* Remember the first empty slot */
-            emptySockIdx = lIndex;
+            return err;
         }
     }
 
-    /* Not found, create a new socket entry */
-    if (lIndex < VOS_MAX_SOCKET_CNT)
+    /* Not found, find an empty slot to fill up gaps */
+    for (lIndex = 0; lIndex < appHandle->ifaceCnt; lIndex++)
     {
-        if ((emptySockIdx != -1)
-            && (lIndex != emptySockIdx))
+        if (iface[lIndex].sock == VOS_INVALID_SOCKET)
         {
-            lIndex = emptySockIdx;
+            break;
         }
-        else
+    }
+
+    /* No gap, enlarge the pool if it is full */
+    if (lIndex >= appHandle->ifaceSize)
+    {
+        err = trdp_growSockets(appHandle, 2 * appHandle->ifaceSize);
+        iface = appHandle->iface;
+    }
+
+    /* Create a new socket entry */
+    if (err == TRDP_NO_ERR)
+    {
+        if (lIndex >= appHandle->ifaceCnt)
         {
-            sCurrentMaxSocketCnt = lIndex + 1;
+            appHandle->ifaceCnt = lIndex + 1;
         }
 
         iface[lIndex].sock          = VOS_INVALID_SOCKET;
+        iface[lIndex].hashedSock    = VOS_INVALID_SOCKET;
         iface[lIndex].bindAddr      = bindAddr /* was srcIP (ID #125) */;
         iface[lIndex].type          = type;
         iface[lIndex].sendParam.qos = params->qos;
@@ -815,7 +1460,8 @@ TRDP_ERR_T  trdp_requestSocket (
         iface[lIndex].rcvMostly     = rcvMostly;
         iface[lIndex].tcpParams.connectionTimeout.tv_sec    = 0;
         iface[lIndex].tcpParams.connectionTimeout.tv_usec   = 0;
-        iface[lIndex].tcpParams.cornerIp    = cornerIp;
+        iface[lIndex].tcpParams.cornerIp    = (type == TRDP_SOCK_MD_TCP) ? cornerIp : 0u;
+        iface[lIndex].tcpParams.cornerPort  = 0u;
         iface[lIndex].tcpParams.sendNotOk   = FALSE;
         iface[lIndex].usage = 0;
         iface[lIndex].tcpParams.notSend     = FALSE;
@@ -834,7 +1480,8 @@ TRDP_ERR_T  trdp_requestSocket (
             iface[lIndex].tcpParams.addFileDesc = FALSE;
         }
 
-        memset(iface[lIndex].mcGroups, 0, sizeof(iface[lIndex].mcGroups));
+        iface[lIndex].pMcJoins = NULL;
+        iface[lIndex].numDrops = 0u;
 
         /* if a socket descriptor was supplied, take that one (for the TCP connection)   */
         if (useSocket != VOS_INVALID_SOCKET)
@@ -842,7 +1489,9 @@ TRDP_ERR_T  trdp_requestSocket (
             iface[lIndex].sock  = useSocket;
             iface[lIndex].usage = 1;         /* Mark as used */
             *pIndex = lIndex;
-            goto err_exit;
+            trdp_indexSocket(appHandle, lIndex);
+            printSocketUsage(appHandle);
+            return TRDP_NO_ERR;
         }
 
         sock_options.qos    = params->qos;
@@ -890,21 +1539,13 @@ TRDP_ERR_T  trdp_requestSocket (
 
                        if (0 != mcGroup)
                        {
-
-                           err = (TRDP_ERR_T) vos_sockJoinMC(iface[lIndex].sock, mcGroup, srcIP);
+                           err = trdp_mcJoin(appHandle, lIndex, mcGroup, cornerIp, srcIP);
                            if (err != TRDP_NO_ERR)
                            {
                                vos_printLog(VOS_LOG_ERROR, "vos_sockJoinMC() for UDP rcv failed! (Err: %d)\n", err);
                                *pIndex = TRDP_INVALID_SOCKET_INDEX;
                                break;
                            }
-                           else
-                           {
-                               if (trdp_SockAddJoin(iface[lIndex].mcGroups, mcGroup) == FALSE)
-                               {
-                                   vos_printLogStr(VOS_LOG_ERROR, "trdp_SockAddJoin() failed!\n");
-                               }
-                           }
                        }
                    }
                    else if (iface[lIndex].bindAddr != 0)
@@ -950,17 +1591,15 @@ TRDP_ERR_T  trdp_requestSocket (
         if (err != TRDP_NO_ERR)
         {
             /* Release socket in case of error */
-            trdp_releaseSocket(iface, lIndex, 0, FALSE, VOS_INADDR_ANY);
+            trdp_releaseSocket(appHandle, lIndex, 0, FALSE, VOS_INADDR_ANY);
+        }
+        else
+        {
+            trdp_indexSocket(appHandle, lIndex);
         }
-    }
-    else
-    {
-        err = TRDP_MEM_ERR;
-    }
-
-err_exit:
 
-    printSocketUsage(iface);
+        printSocketUsage(appHandle);
+    }
 
     return err;
 }
@@ -969,36 +1608,41 @@ err_exit:
 /**********************************************************************************************************************/
 /** Handle the socket pool: if a received TCP socket is unused, the socket connection timeout is started.
  *  In Udp, Release a socket from our socket pool
- *  @param[in,out]  iface           socket pool
+ *  @param[in,out]  appHandle       session with the socket pool
  *  @param[in]      lIndex          index of socket to release
  *  @param[in]      connectTimeout  time out
  *  @param[in]      checkAll        release all TCP pending sockets
- *  @param[in]      mcGroupUsed     release MC group subscription
+ *  @param[in]      mcGroupUsed     release MC group subscription (any source), see trdp_mcLeave()
  *
  */
 void  trdp_releaseSocket (
-    TRDP_SOCKETS_T  iface[],
-    INT32           lIndex,
-    UINT32          connectTimeout,
-    BOOL8           checkAll,
-    TRDP_IP_ADDR_T  mcGroupUsed)
+    TRDP_APP_SESSION_T  appHandle,
+    INT32               lIndex,
+    UINT32              connectTimeout,
+    BOOL8               checkAll,
+    TRDP_IP_ADDR_T      mcGroupUsed)
 {
-    TRDP_ERR_T err = TRDP_PARAM_ERR;
+    TRDP_ERR_T      err = TRDP_PARAM_ERR;
+    TRDP_SOCKETS_T  *iface;
 
-    if (iface == NULL)
+    if (appHandle == NULL || appHandle->iface == NULL)
     {
         return;
     }
 
+    iface = appHandle->iface;
+
 #if MD_SUPPORT
     if (checkAll == TRUE)
     {
         /* Check all the sockets */
         /* Close the morituri = TRUE sockets */
-        for (lIndex = 0; lIndex < sCurrentMaxSocketCnt; lIndex++)
+        for (lIndex = 0; lIndex < appHandle->ifaceCnt; lIndex++)
         {
             if (iface[lIndex].tcpParams.morituri == TRUE)
             {
+                trdp_unindexSocket(appHandle, lIndex);
+
                 vos_printLog(VOS_LOG_INFO, "The socket (Num = %d) will be closed\n", (int) iface[lIndex].sock);
 
                 err = (TRDP_ERR_T) vos_sockClose(iface[lIndex].sock);
@@ -1019,6 +1663,7 @@ void  trdp_releaseSocket (
                 iface[lIndex].type      = (TRDP_SOCK_TYPE_T) 0;
                 iface[lIndex].rcvMostly = FALSE;
                 iface[lIndex].tcpParams.cornerIp = 0;
+                iface[lIndex].tcpParams.cornerPort  = 0u;
                 iface[lIndex].tcpParams.connectionTimeout.tv_sec    = 0;
                 iface[lIndex].tcpParams.connectionTimeout.tv_usec   = 0;
                 iface[lIndex].tcpParams.addFileDesc = FALSE;
@@ -1045,6 +1690,8 @@ void  trdp_releaseSocket (
                 iface[lIndex].usage <= 0)
             {
                 /* Close that socket, nobody uses it anymore */
+                trdp_unindexSocket(appHandle, lIndex);
+                trdp_mcDropJoins(appHandle, lIndex);
                 err = (TRDP_ERR_T) vos_sockClose(iface[lIndex].sock);
                 if (err != TRDP_NO_ERR)
                 {
@@ -1058,19 +1705,8 @@ void  trdp_releaseSocket (
             }
             else if (mcGroupUsed != VOS_INADDR_ANY) /* Check for MC usage (close socket will unjoin MC anyway) */
             {
-                /* remove MC group from socket list:
-                    we do that only if the caller is the only user of this MC group on this socket! */
-                if (trdp_SockDelJoin(iface[lIndex].mcGroups, mcGroupUsed) == FALSE)
-                {
-                    vos_printLogStr(VOS_LOG_WARNING, "trdp_sockDelJoin() failed!\n");
-                }
-                else    /* and unjoin MC group */
-                {
-                   if (vos_sockLeaveMC(iface[lIndex].sock, mcGroupUsed, iface[lIndex].bindAddr) != VOS_NO_ERR)
-                   {
-                      vos_printLogStr(VOS_LOG_WARNING, "trdp_sockLeaveMC() failed!\n");
-                   }
-                }
+                /* drop our reference, the group is left if nobody else uses it on this socket */
+                trdp_mcLeave(appHandle, lIndex, mcGroupUsed, VOS_INADDR_ANY);
             }
             else
             {}
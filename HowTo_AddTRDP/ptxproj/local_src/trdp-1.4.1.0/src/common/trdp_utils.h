@@ -16,6 +16,8 @@
  *
  * $Id: trdp_utils.h 1779 2018-11-07 09:49:55Z bloehr $
  *
+ *      AG 2026-10-18: Reference counted, hash indexed multicast joins without per socket limit, optional SSM
+ *      AG 2026-10-18: Socket pool per session, growing on demand, hash indexed by parameters and descriptor
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
  *      BL 2017-11-28: Ticket #180 Filtering rules for DestinationURI does not follow the standard
  *      BL 2017-11-15: Ticket #1   Unjoin on unsubscribe/delListener (finally ;-)
@@ -98,21 +100,73 @@ void        trdp_MDqueueInsFirst (
 
 /*********************************************************************************************************************/
 /** Return the largest number of the socket index
+ *
+ *  @param[in]      appHandle          session handle
  *
  *  @return      maxSocketCount
  */
 
-INT32 trdp_getCurrentMaxSocketCnt(void);
+INT32 trdp_getCurrentMaxSocketCnt(
+    TRDP_APP_SESSION_T appHandle);
 
 
 /*********************************************************************************************************************/
 /** Handle the socket pool: Initialize it
+ *  The pool starts with VOS_MAX_SOCKET_CNT entries and is enlarged when needed.
+ *
+ *  @param[in]      appHandle          session handle
+ *
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_MEM_ERR
+ */
+
+TRDP_ERR_T trdp_initSockets(
+    TRDP_APP_SESSION_T appHandle);
+
+/*********************************************************************************************************************/
+/** Handle the socket pool: Close all sockets still open and free the pool
+ *
+ *  @param[in]      appHandle          session handle
+ */
+
+void trdp_freeSockets(
+    TRDP_APP_SESSION_T appHandle);
+
+/*********************************************************************************************************************/
+/** Find the socket pool entry of a socket descriptor
+ *
+ *  @param[in]      appHandle          session handle
+ *  @param[in]      sock               socket descriptor to look for
+ *
+ *  @retval         index of the socket entry or TRDP_INVALID_SOCKET_INDEX
+ */
+
+INT32 trdp_findSocketIndex(
+    TRDP_APP_SESSION_T  appHandle,
+    SOCKET              sock);
+
+/*********************************************************************************************************************/
+/** Add a socket entry to the hash indexes of the socket pool
+ *
+ *  @param[in]      appHandle          session handle
+ *  @param[in]      lIndex             index of the socket entry
+ */
+
+void trdp_indexSocket(
+    TRDP_APP_SESSION_T  appHandle,
+    INT32               lIndex);
+
+/*********************************************************************************************************************/
+/** Remove a socket entry from the hash indexes of the socket pool.
+ *  Must be called before the descriptor or the parameters of the entry are changed.
  *
- *  @param[in]      iface          pointer to the socket pool
+ *  @param[in]      appHandle          session handle
+ *  @param[in]      lIndex             index of the socket entry
  */
 
-void trdp_initSockets(
-    TRDP_SOCKETS_T iface[]);
+void trdp_unindexSocket(
+    TRDP_APP_SESSION_T  appHandle,
+    INT32               lIndex);
 
 
 /**********************************************************************************************************************/
@@ -142,27 +196,73 @@ void trdp_resetSequenceCounter (
     TRDP_MSG_T      msgType);
 
 /**********************************************************************************************************************/
-/** Check an MC group not used by other sockets / subscribers/ listeners
+/** Join a multicast group on a socket of the pool (reference counted).
+ *
+ *  @param[in]      appHandle          session handle
+ *  @param[in]      lIndex             index of the socket
+ *  @param[in]      mcGroup            multicast group to join
+ *  @param[in]      srcIp              source to receive the group from, VOS_INADDR_ANY for any source
+ *  @param[in]      ifaceIp            interface to join on
  *
- *  @param[in]      appHandle           the handle returned by tlc_openSession
- *  @param[in]      mcGroup             multicast group to look for
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_MEM_ERR
+ *  @retval         TRDP_SOCK_ERR      group could not be joined
+ */
+
+TRDP_ERR_T trdp_mcJoin(
+    TRDP_APP_SESSION_T  appHandle,
+    INT32               lIndex,
+    TRDP_IP_ADDR_T      mcGroup,
+    TRDP_IP_ADDR_T      srcIp,
+    TRDP_IP_ADDR_T      ifaceIp);
+
+/**********************************************************************************************************************/
+/** Leave a multicast group on a socket of the pool (reference counted).
  *
- *  @retval         multi cast group if unused
- *                  VOS_INADDR_ANY if used
+ *  @param[in]      appHandle          session handle
+ *  @param[in]      lIndex             index of the socket
+ *  @param[in]      mcGroup            multicast group to leave
+ *  @param[in]      srcIp              source the group was joined for, VOS_INADDR_ANY for any source
  */
-TRDP_IP_ADDR_T trdp_findMCjoins(
+
+void trdp_mcLeave(
     TRDP_APP_SESSION_T  appHandle,
-    TRDP_IP_ADDR_T      mcGroup);
+    INT32               lIndex,
+    TRDP_IP_ADDR_T      mcGroup,
+    TRDP_IP_ADDR_T      srcIp);
+
+/**********************************************************************************************************************/
+/** Forget all multicast memberships of a socket which is closed.
+ *
+ *  @param[in]      appHandle          session handle
+ *  @param[in]      lIndex             index of the socket
+ */
+
+void trdp_mcDropJoins(
+    TRDP_APP_SESSION_T  appHandle,
+    INT32               lIndex);
+
+/**********************************************************************************************************************/
+/** Join all multicast memberships of the socket pool again.
+ *
+ *  @param[in]      appHandle          session handle
+ *
+ *  @retval         TRDP_NO_ERR
+ *  @retval         TRDP_SOCK_ERR      a group could not be joined
+ */
+
+TRDP_ERR_T trdp_mcRejoin(
+    TRDP_APP_SESSION_T appHandle);
 
 /**********************************************************************************************************************/
 /** Handle the socket pool: Request a socket from our socket pool
  *  First we loop through the socket pool and check if there is already a socket
- *  which would suit us. If a multicast group should be joined, we do that on an otherwise suitable socket - up to 20
- *  multicast goups can be joined per socket.
+ *  which would suit us. If a multicast group should be joined, we do that on an otherwise suitable socket - there
+ *  is no limit on the number of groups joined per socket.
  *  If a socket for multicast publishing is requested, we also use the source IP to determine the interface for outgoing
  *  multicast traffic.
  *
- *  @param[in,out]  iface           socket pool
+ *  @param[in,out]  appHandle       session with the socket pool
  *  @param[in]      port            port to use
  *  @param[in]      params          parameters to use
  *  @param[in]      srcIP           IP to bind to (0 = any address)
@@ -172,14 +272,16 @@ TRDP_IP_ADDR_T trdp_findMCjoins(
  *  @param[in]      rcvMostly       only used for receiving
  *  @param[out]     useSocket       socket to use, do not open a new one
  *  @param[out]     pIndex          returned index of socket pool
- *  @param[in]      cornerIp        only used for receiving
+ *  @param[in]      cornerIp        TCP: other corner (only used for receiving),
+ *                                  UDP: source to join mcGroup for (0 = any source)
  *
  *  @retval         TRDP_NO_ERR
  *  @retval         TRDP_PARAM_ERR
+ *  @retval         TRDP_MEM_ERR
  */
 
 TRDP_ERR_T trdp_requestSocket(
-    TRDP_SOCKETS_T iface[],
+    TRDP_APP_SESSION_T appHandle,
     UINT16 port,
     const TRDP_SEND_PARAM_T * params,
     TRDP_IP_ADDR_T srcIP,
@@ -194,16 +296,16 @@ TRDP_ERR_T trdp_requestSocket(
 /*********************************************************************************************************************/
 /** Handle the socket pool: Release a socket from our socket pool
  *
- *  @param[in,out]  iface           socket pool
+ *  @param[in,out]  appHandle       session with the socket pool
  *  @param[in]      lIndex          index of socket to release
  *  @param[in]      connectTimeout  timeout value
  *  @param[in]      checkAll        release all TCP pending sockets
- *  @param[in]      mcGroupUsed     release MC group subscription
+ *  @param[in]      mcGroupUsed     release MC group subscription (any source), see trdp_mcLeave()
  *
  */
 
 void trdp_releaseSocket(
-    TRDP_SOCKETS_T iface[],
+    TRDP_APP_SESSION_T appHandle,
     INT32 lIndex,
     UINT32 connectTimeout,
     BOOL8 checkAll,
@@ -4,8 +4,8 @@
  *
  * @brief           Simple XML parser
  *
- * @details         Hint: Missing optional elements must be handled using the count-function, otherwise following
- *                           elements will be following ignored!
+ * @details         Hint: Seeking a missing optional element skips all following elements on its level. Elements
+ *                           in any order are read with trdp_XMLSeekStartTagAny.
  *
  * @note            Project: TCNOpen TRDP prototype stack
  *
@@ -16,6 +16,7 @@
  *
  * $Id: trdp_xml.c 1778 2018-11-07 08:31:57Z s-bender $
  *
+ *      AG 2026-10-19: Arena allocations and root objects can grow, trdp_XMLCountStartTag removed
  *      SB 2018-11-07: Ticket #221 readXmlDatasets failed 
  *      BL 2016-07-06: Ticket #122 64Bit compatibility (+ compiler warnings)
  *      BL 2016-02-24: missing include (thanks to Robert)
@@ -30,21 +31,113 @@
 #include <stdlib.h>
 #include <string.h>
 #include <sys/types.h>
+#ifdef POSIX
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 #include "trdp_xml.h"
+#include "vos_mem.h"
 
 /***********************************************************************************************************************
  * DEFINES
  */
 
+#define XML_ARENA_MAGIC     0x41524E41u     /* 'ARNA' */
+#define XML_ARENA_ALIGN     8u
+#define XML_ARENA_ROUND(size)   (((size) + XML_ARENA_ALIGN - 1u) & ~(XML_ARENA_ALIGN - 1u))
+#define XML_ARENA_CHUNK_DATA(pChunk)    ((UINT8 *) (pChunk) + XML_ARENA_ROUND((UINT32) sizeof(XML_ARENA_CHUNK_T)))
+/* Offset of the root object from its header */
+#define XML_ARENA_ROOT_OFFSET   XML_ARENA_ROUND((UINT32) sizeof(XML_ARENA_ROOT_T))
+
 /***********************************************************************************************************************
  * TYPEDEFS
  */
 
+/* Header in front of the root object of an arena */
+typedef struct XML_ARENA_ROOT
+{
+    UINT32      magic;
+    XML_ARENA_T *pArena;
+} XML_ARENA_ROOT_T;
+
 /***********************************************************************************************************************
 *  LOCAL FUNCTIONS
 */
 
+/**********************************************************************************************************************/
+/** Check for end of file, TRUE after a read past the end (like feof).
+ *
+ *  @param[in]      pXML        Pointer to local data
+ *
+ *  @retval         TRUE        end of file
+ */
+static INLINE BOOL8 trdp_XMLEof (
+    const XML_HANDLE_T *pXML)
+{
+    return pXML->eof;
+}
+
+/**********************************************************************************************************************/
+/** Read the next character out of the file buffer.
+ *
+ *  @param[in]      pXML        Pointer to local data
+ *
+ *  @retval         character or EOF
+ */
+static INLINE int trdp_XMLGetChar (
+    XML_HANDLE_T *pXML)
+{
+    if (pXML->pos >= pXML->size)
+    {
+        pXML->eof = TRUE;
+        return EOF;
+    }
+    return (int) pXML->pBuffer[pXML->pos++];
+}
+
+/**********************************************************************************************************************/
+/** Push back the last character read (like ungetc).
+ *
+ *  @param[in]      pXML        Pointer to local data
+ *  @param[in]      ch          character returned by trdp_XMLGetChar
+ */
+static INLINE void trdp_XMLUngetChar (
+    XML_HANDLE_T    *pXML,
+    int             ch)
+{
+    if ((ch != EOF) && (pXML->pos > 0u))
+    {
+        pXML->pos--;
+        pXML->eof = FALSE;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Allocate a chunk of an arena.
+ *
+ *  @param[in]      size        usable size of the chunk
+ *
+ *  @retval         chunk or NULL
+ */
+static XML_ARENA_CHUNK_T *trdp_XMLArenaChunk (
+    UINT32 size)
+{
+    XML_ARENA_CHUNK_T *pChunk;
+
+    size    = (size < XML_ARENA_CHUNK_SIZE) ? XML_ARENA_CHUNK_SIZE : XML_ARENA_ROUND(size);
+    pChunk  = (XML_ARENA_CHUNK_T *) vos_memAlloc(XML_ARENA_ROUND((UINT32) sizeof(XML_ARENA_CHUNK_T)) + size);
+    if (pChunk != NULL)
+    {
+        pChunk->size    = size;
+        pChunk->used    = 0u;
+        pChunk->pNext   = NULL;
+    }
+    return pChunk;
+}
+
 /***********************************************************************************************************************
 NAME:       trdp_XMLNextToken
 ABSTRACT:   Returns next XML token.
@@ -71,14 +164,14 @@ static XML_TOKEN_T trdp_XMLNextToken (
     for (;;)
     {
         /* Skip whitespace */
-        while (!feof(pXML->infile) && (ch = fgetc(pXML->infile)) <= ' ') /*lint !e160 Lint objects a GNU warning
+        while (!trdp_XMLEof(pXML) && (ch = trdp_XMLGetChar(pXML)) <= ' ') /*lint !e160 Lint objects a GNU warning
                                                                            suppression macro - OK */
         {
             ;
         }
 
         /* Check for EOF */
-        if (feof(pXML->infile)) /*lint !e611 Lint for VxWorks gets lost in macro defintions*/
+        if (trdp_XMLEof(pXML)) /*lint !e611 Lint for VxWorks gets lost in macro defintions*/
         {
             return TOK_EOF;
         }
@@ -87,7 +180,7 @@ static XML_TOKEN_T trdp_XMLNextToken (
         if (ch == '"')
         {
             p = pXML->tokenValue;
-            while (!feof(pXML->infile) && (ch = fgetc(pXML->infile)) != '"') /*lint !e160 Lint objects a GNU warning
+            while (!trdp_XMLEof(pXML) && (ch = trdp_XMLGetChar(pXML)) != '"') /*lint !e160 Lint objects a GNU warning
                                                                                suppression macro - OK */
             {
                 if (p < (pXML->tokenValue + MAX_TOK_LEN - 1))
@@ -102,22 +195,22 @@ static XML_TOKEN_T trdp_XMLNextToken (
         else if (ch == '<')
         {
             /* Tag start character */
-            ch = fgetc(pXML->infile);    /*lint !e160 Lint objects a GNU warning suppression macro - OK */
+            ch = trdp_XMLGetChar(pXML);    /*lint !e160 Lint objects a GNU warning suppression macro - OK */
 
             if (ch == '?') /* Skip processing instruction */
             {
-                while (!feof(pXML->infile) && (ch = fgetc(pXML->infile))) /*lint !e160 Lint objects a GNU warning
+                while (!trdp_XMLEof(pXML) && (ch = trdp_XMLGetChar(pXML))) /*lint !e160 Lint objects a GNU warning
                                                                             suppression macro - OK */
                 {
                     if (ch == '?')
                     {
-                        if ((ch = fgetc(pXML->infile)) == '>')
+                        if ((ch = trdp_XMLGetChar(pXML)) == '>')
                         {
                             break;
                         }
                         else
                         {
-                            (void) ungetc(ch, pXML->infile);
+                            (void) trdp_XMLUngetChar(pXML, ch);
                         }
                     }
                 }
@@ -125,14 +218,14 @@ static XML_TOKEN_T trdp_XMLNextToken (
             else if (ch == '!')
             {
                 /* Is it a comment? */
-                if (!feof(pXML->infile) && (ch = fgetc(pXML->infile)))
+                if (!trdp_XMLEof(pXML) && (ch = trdp_XMLGetChar(pXML)))
                 {
                     if (ch == '-')
                     {
-                        if ((ch = fgetc(pXML->infile) == '-'))
+                        if ((ch = trdp_XMLGetChar(pXML) == '-'))
                         {
                             int endTagCnt = 0;
-                            while (!feof(pXML->infile) && (ch = fgetc(pXML->infile))) /*lint !e160 Lint objects a GNU
+                            while (!trdp_XMLEof(pXML) && (ch = trdp_XMLGetChar(pXML))) /*lint !e160 Lint objects a GNU
                                                                                         warning suppression macro - OK
                                                                                         */
                             {
@@ -151,7 +244,7 @@ static XML_TOKEN_T trdp_XMLNextToken (
                                 }
                             }
                             /* Exit on unexpected end-of-file */
-                            if (endTagCnt != 2 && feof(pXML->infile))
+                            if (endTagCnt != 2 && trdp_XMLEof(pXML))
                             {
                                 pXML->error = TRDP_XML_PARSER_ERR;
                                 return TOK_EOF;
@@ -160,14 +253,14 @@ static XML_TOKEN_T trdp_XMLNextToken (
                     }
                     else
                     {
-                        while (!feof(pXML->infile) && (ch = fgetc(pXML->infile)) != '>')
+                        while (!trdp_XMLEof(pXML) && (ch = trdp_XMLGetChar(pXML)) != '>')
                         {
                             ;
                         }
                     }
                 }
                 /* Exit on unexpected end-of-file */
-                if (feof(pXML->infile))
+                if (trdp_XMLEof(pXML))
                 {
                     pXML->error = TRDP_XML_PARSER_ERR;
                     return TOK_EOF;
@@ -179,20 +272,20 @@ static XML_TOKEN_T trdp_XMLNextToken (
             }
             else
             {
-                (void) ungetc(ch, pXML->infile);
+                (void) trdp_XMLUngetChar(pXML, ch);
                 return TOK_OPEN;
             }
         }
         else if (ch == '/')
         {
-            ch = fgetc(pXML->infile); /*lint !e160 Lint objects a GNU warning suppression macro - OK */
+            ch = trdp_XMLGetChar(pXML); /*lint !e160 Lint objects a GNU warning suppression macro - OK */
             if (ch == '>')
             {
                 return TOK_CLOSE_EMPTY;
             }
             else
             {
-                (void) ungetc(ch, pXML->infile);
+                (void) trdp_XMLUngetChar(pXML, ch);
             }
         }
         else if (ch == '>')
@@ -208,8 +301,8 @@ static XML_TOKEN_T trdp_XMLNextToken (
             /* Unquoted identifier */
             p       = pXML->tokenValue;
             *(p++)  = (char) ch;
-            while ((!feof(pXML->infile)) &&
-                   ((ch = fgetc(pXML->infile)) != '<') /*lint !e160 Lint objects a GNU warning suppression macro - OK */
+            while ((!trdp_XMLEof(pXML)) &&
+                   ((ch = trdp_XMLGetChar(pXML)) != '<') /*lint !e160 Lint objects a GNU warning suppression macro - OK */
                    && (ch != '>')
                    && (ch != '=')
                    && (ch != '/')
@@ -225,7 +318,7 @@ static XML_TOKEN_T trdp_XMLNextToken (
 
             if ((ch == '<') || (ch == '>') || (ch == '=') || (ch == '/'))
             {
-                (void) ungetc(ch, pXML->infile);
+                (void) trdp_XMLUngetChar(pXML, ch);
             }
 
             return TOK_ID;
@@ -310,11 +403,69 @@ TRDP_ERR_T trdp_XMLOpen (
     XML_HANDLE_T    *pXML,
     const char      *file)
 {
-    if ((pXML->infile = fopen(file, "r+b")) == NULL)
+#ifdef POSIX
+    struct stat fileStat;
+    int         fd = open(file, O_RDONLY);
+
+    if (fd == -1)
+    {
+        return TRDP_IO_ERR;
+    }
+    if ((fstat(fd, &fileStat) == -1) || (fileStat.st_size > (off_t) 0x7FFFFFFF))
     {
+        (void) close(fd);
         return TRDP_IO_ERR;
     }
+    pXML->size      = (UINT32) fileStat.st_size;
+    pXML->pBuffer   = NULL;
+    pXML->mapped    = FALSE;
+    if (pXML->size > 0u)
+    {
+        /* The whole file is mapped, tokens are read without stdio and rewinding is free */
+        void *pMap = mmap(NULL, pXML->size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (pMap == MAP_FAILED)
+        {
+            (void) close(fd);
+            return TRDP_IO_ERR;
+        }
+        (void) madvise(pMap, pXML->size, MADV_SEQUENTIAL);
+        pXML->pBuffer   = (const UINT8 *) pMap;
+        pXML->mapped    = TRUE;
+    }
+    (void) close(fd);
+#else
+    FILE    *infile = fopen(file, "rb");
+    long    size;
+    UINT8   *pBuffer = NULL;
 
+    if (infile == NULL)
+    {
+        return TRDP_IO_ERR;
+    }
+    /* Read the whole file at once */
+    if ((fseek(infile, 0L, SEEK_END) != 0) || ((size = ftell(infile)) < 0L) || (fseek(infile, 0L, SEEK_SET) != 0))
+    {
+        (void) fclose(infile);
+        return TRDP_IO_ERR;
+    }
+    if (size > 0L)
+    {
+        pBuffer = (UINT8 *) malloc((size_t) size);
+        if ((pBuffer == NULL) || (fread(pBuffer, 1u, (size_t) size, infile) != (size_t) size))
+        {
+            free(pBuffer);
+            (void) fclose(infile);
+            return TRDP_IO_ERR;
+        }
+    }
+    (void) fclose(infile);
+    pXML->pBuffer   = pBuffer;
+    pXML->size      = (UINT32) size;
+    pXML->mapped    = FALSE;
+#endif
+
+    pXML->pos           = 0u;
+    pXML->eof           = FALSE;
     pXML->tagDepth      = 0;
     pXML->tagDepthSeek  = 0;
     pXML->error         = TRDP_NO_ERR;
@@ -331,16 +482,14 @@ TRDP_ERR_T trdp_XMLOpen (
 void trdp_XMLRewind (
     XML_HANDLE_T *pXML)
 {
-    if (pXML->infile == NULL)
+    if ((pXML->pBuffer == NULL) && (pXML->size != 0u))
     {
         pXML->error = TRDP_XML_PARSER_ERR;
     }
-    else if (fseek(pXML->infile, 0, SEEK_SET) == -1)
-    {
-        pXML->error = TRDP_IO_ERR;
-    }
     else
     {
+        pXML->pos           = 0u;
+        pXML->eof           = FALSE;
         pXML->tagDepth      = 0;
         pXML->tagDepthSeek  = 0;
         pXML->error         = TRDP_NO_ERR;
@@ -357,7 +506,17 @@ void trdp_XMLRewind (
 void trdp_XMLClose (
     XML_HANDLE_T *pXML)
 {
-    fclose(pXML->infile);
+    if (pXML->pBuffer != NULL)
+    {
+#ifdef POSIX
+        (void) munmap((void *) pXML->pBuffer, pXML->size);
+#else
+        free((void *) pXML->pBuffer);
+#endif
+    }
+    pXML->pBuffer   = NULL;
+    pXML->size      = 0u;
+    pXML->pos       = 0u;
 }
 
 /**********************************************************************************************************************/
@@ -427,41 +586,6 @@ int trdp_XMLSeekStartTag (
     return ret;
 }
 
-/**********************************************************************************************************************/
-/** Count a specific tag
- *
- *  @param[in]      pXML        Pointer to local data
- *  @param[in]      tag         Tag to count
- *
- *  @retval         0           if found
- *                  !=0         if not found
- */
-int trdp_XMLCountStartTag (
-    XML_HANDLE_T    *pXML,
-    const char      *tag)
-{
-    int             ret;
-    char            buf[MAX_TAG_LEN + 1u];
-    int             count = 0;
-
-    XML_HANDLE_T    safe        = *pXML;
-    off_t           last_read   = ftell(pXML->infile);
-
-    do
-    {
-        ret = trdp_XMLSeekStartTagAny(pXML, buf, sizeof(buf));
-        if (ret == 0 && strcmp(buf, tag) == 0)
-        {
-            count++;
-        }
-    }
-    while (ret == 0);
-
-    *pXML = safe;
-    fseek(pXML->infile, (long) last_read, SEEK_SET);
-    return count;
-}
-
 /**********************************************************************************************************************/
 /** Enter level in XML file
  *
@@ -529,3 +653,231 @@ XML_TOKEN_T trdp_XMLGetAttribute (
 
     return token;
 }
+
+/**********************************************************************************************************************/
+/** Create an empty arena.
+ *  The root object (e.g. the array returned to the application) is allocated by trdp_XMLArenaGrowRoot and
+ *  identifies the arena later on.
+ *
+ *  @retval         arena or NULL
+ */
+XML_ARENA_T *trdp_XMLArenaCreate (void)
+{
+    XML_ARENA_CHUNK_T   *pChunk = trdp_XMLArenaChunk(XML_ARENA_CHUNK_SIZE);
+    XML_ARENA_T         *pArena;
+
+    if (pChunk == NULL)
+    {
+        return NULL;
+    }
+    pArena          = (XML_ARENA_T *) XML_ARENA_CHUNK_DATA(pChunk);
+    pArena->pChunk  = pChunk;
+    pChunk->used    = XML_ARENA_ROUND((UINT32) sizeof(XML_ARENA_T));
+    return pArena;
+}
+
+/**********************************************************************************************************************/
+/** Get the arena of a root object.
+ *
+ *  @param[in]      pRoot       Root object returned by trdp_XMLArenaGrowRoot
+ *
+ *  @retval         arena or NULL if pRoot is not an arena root
+ */
+XML_ARENA_T *trdp_XMLArenaOfRoot (
+    const void *pRoot)
+{
+    const XML_ARENA_ROOT_T *pHeader;
+
+    if (pRoot == NULL)
+    {
+        return NULL;
+    }
+    pHeader = (const XML_ARENA_ROOT_T *) ((const UINT8 *) pRoot - XML_ARENA_ROOT_OFFSET);
+    return (pHeader->magic == XML_ARENA_MAGIC) ? pHeader->pArena : NULL;
+}
+
+/**********************************************************************************************************************/
+/** Allocate zeroed memory from an arena.
+ *  Allocations of a chunk size or more get a chunk of their own, which is linked behind the current chunk.
+ *  The rest of the current chunk is still used for the smaller allocations.
+ *
+ *  @param[in]      pArena      Arena
+ *  @param[in]      size        Size in bytes
+ *
+ *  @retval         pointer to the memory or NULL
+ */
+void *trdp_XMLArenaAlloc (
+    XML_ARENA_T *pArena,
+    UINT32      size)
+{
+    XML_ARENA_CHUNK_T   *pChunk;
+    UINT8               *p;
+
+    if (pArena == NULL)
+    {
+        return NULL;
+    }
+    size    = XML_ARENA_ROUND(size);
+    pChunk  = pArena->pChunk;
+    if (size > pChunk->size - pChunk->used)
+    {
+        pChunk = trdp_XMLArenaChunk(size);
+        if (pChunk == NULL)
+        {
+            return NULL;
+        }
+        if (size >= XML_ARENA_CHUNK_SIZE)
+        {
+            pChunk->pNext           = pArena->pChunk->pNext;
+            pArena->pChunk->pNext   = pChunk;
+        }
+        else
+        {
+            pChunk->pNext   = pArena->pChunk;
+            pArena->pChunk  = pChunk;
+        }
+    }
+    p = XML_ARENA_CHUNK_DATA(pChunk) + pChunk->used;
+    pChunk->used += size;
+    return p;   /* chunks are zeroed by vos_memAlloc */
+}
+
+/**********************************************************************************************************************/
+/** Grow memory allocated from an arena, e.g. an array while its items are parsed.
+ *  The memory is extended in place if it was the last allocation of the current chunk, otherwise it is moved.
+ *  A moved block is released if it had a chunk of its own, else it stays unused until the arena is freed.
+ *  The added memory is zeroed.
+ *
+ *  @param[in]      pArena      Arena
+ *  @param[in]      pOld        Memory to grow or NULL
+ *  @param[in]      oldSize     Size of pOld in bytes
+ *  @param[in]      newSize     New size in bytes
+ *
+ *  @retval         pointer to the memory or NULL, pOld is unchanged then
+ */
+void *trdp_XMLArenaGrow (
+    XML_ARENA_T *pArena,
+    void        *pOld,
+    UINT32      oldSize,
+    UINT32      newSize)
+{
+    XML_ARENA_CHUNK_T   *pChunk;
+    XML_ARENA_CHUNK_T   *pPrev;
+    UINT8               *p;
+
+    if ((pArena == NULL) || (pOld == NULL) || (oldSize == 0u))
+    {
+        return trdp_XMLArenaAlloc(pArena, newSize);
+    }
+    oldSize = XML_ARENA_ROUND(oldSize);
+    newSize = XML_ARENA_ROUND(newSize);
+    if (newSize <= oldSize)
+    {
+        return pOld;
+    }
+
+    pChunk = pArena->pChunk;
+    if (((UINT8 *) pOld + oldSize == XML_ARENA_CHUNK_DATA(pChunk) + pChunk->used) &&
+        (newSize - oldSize <= pChunk->size - pChunk->used))
+    {
+        pChunk->used += newSize - oldSize;
+        return pOld;
+    }
+
+    p = (UINT8 *) trdp_XMLArenaAlloc(pArena, newSize);
+    if (p == NULL)
+    {
+        return NULL;
+    }
+    memcpy(p, pOld, oldSize);
+
+    for (pPrev = pArena->pChunk, pChunk = pPrev->pNext; pChunk != NULL; pPrev = pChunk, pChunk = pChunk->pNext)
+    {
+        if ((XML_ARENA_CHUNK_DATA(pChunk) == (UINT8 *) pOld) && (pChunk->used == oldSize))
+        {
+            pPrev->pNext = pChunk->pNext;
+            vos_memFree(pChunk);
+            break;
+        }
+    }
+    return p;
+}
+
+/**********************************************************************************************************************/
+/** Grow the root object of an arena, allocate it if pRoot is NULL.
+ *
+ *  @param[in]      pArena      Arena
+ *  @param[in]      pRoot       Root object to grow or NULL
+ *  @param[in]      oldSize     Size of pRoot in bytes
+ *  @param[in]      newSize     New size in bytes
+ *
+ *  @retval         pointer to the root object or NULL, pRoot is unchanged then
+ */
+void *trdp_XMLArenaGrowRoot (
+    XML_ARENA_T *pArena,
+    void        *pRoot,
+    UINT32      oldSize,
+    UINT32      newSize)
+{
+    XML_ARENA_ROOT_T *pHeader = NULL;
+
+    if (pRoot != NULL)
+    {
+        pHeader = (XML_ARENA_ROOT_T *) ((UINT8 *) pRoot - XML_ARENA_ROOT_OFFSET);
+        oldSize += XML_ARENA_ROOT_OFFSET;
+    }
+    pHeader = (XML_ARENA_ROOT_T *) trdp_XMLArenaGrow(pArena, pHeader, oldSize, XML_ARENA_ROOT_OFFSET + newSize);
+    if (pHeader == NULL)
+    {
+        return NULL;
+    }
+    pHeader->magic  = XML_ARENA_MAGIC;
+    pHeader->pArena = pArena;
+    return (UINT8 *) pHeader + XML_ARENA_ROOT_OFFSET;
+}
+
+/**********************************************************************************************************************/
+/** Copy a string into an arena.
+ *
+ *  @param[in]      pArena      Arena
+ *  @param[in]      pStr        String
+ *
+ *  @retval         copy or NULL
+ */
+CHAR8 *trdp_XMLArenaStrDup (
+    XML_ARENA_T *pArena,
+    const CHAR8 *pStr)
+{
+    UINT32  len     = (UINT32) strlen(pStr) + 1u;
+    CHAR8   *pCopy  = (CHAR8 *) trdp_XMLArenaAlloc(pArena, len);
+
+    if (pCopy != NULL)
+    {
+        memcpy(pCopy, pStr, len);
+    }
+    return pCopy;
+}
+
+/**********************************************************************************************************************/
+/** Release an arena with all memory allocated from it.
+ *
+ *  @param[in]      pArena      Arena
+ */
+void trdp_XMLArenaFree (
+    XML_ARENA_T *pArena)
+{
+    XML_ARENA_CHUNK_T   *pChunk;
+    XML_ARENA_CHUNK_T   *pNext;
+
+    if (pArena == NULL)
+    {
+        return;
+    }
+    pChunk = pArena->pChunk;
+    while (pChunk != NULL)
+    {
+        pNext = pChunk->pNext;
+        vos_memFree(pChunk);    /* the first chunk holds the arena itself */
+        pChunk = pNext;
+    }
+}
@@ -67,7 +67,11 @@ typedef enum
 
 typedef struct XML_HANDLE
 {
-    FILE    *infile;
+    const UINT8 *pBuffer;       /* file contents, mapped or read in by trdp_XMLOpen */
+    UINT32      size;           /* file size */
+    UINT32      pos;            /* read position */
+    BOOL8       eof;            /* read past the end */
+    BOOL8       mapped;         /* pBuffer is a file mapping */
     char    tokenValue[MAX_TOK_LEN];
     int     tagDepth;
     int     tagDepthSeek;
@@ -75,6 +79,21 @@ typedef struct XML_HANDLE
     int     error;
 } XML_HANDLE_T, *TRDP_XML_HANDLE_T;
 
+/* Allocation arena for configuration data parsed from XML, released as a whole */
+#define XML_ARENA_CHUNK_SIZE    16384u      /* default chunk size, matches a VOS memory block size */
+
+typedef struct XML_ARENA_CHUNK
+{
+    struct XML_ARENA_CHUNK  *pNext;
+    UINT32                  size;           /* usable bytes behind the chunk header */
+    UINT32                  used;
+} XML_ARENA_CHUNK_T;
+
+typedef struct XML_ARENA
+{
+    XML_ARENA_CHUNK_T   *pChunk;            /* chunk allocated from, head of the chunk list */
+} XML_ARENA_T;
+
 /*******************************************************************************
  * GLOBAL FUNCTIONS
  */
@@ -82,9 +101,6 @@ typedef struct XML_HANDLE
 TRDP_ERR_T  trdp_XMLOpen (XML_HANDLE_T  *pXML,
                           const char    *file);
 void        trdp_XMLClose (XML_HANDLE_T *pXML);
-int         trdp_XMLCountStartTag (
-    XML_HANDLE_T    *pXML,
-    const char      *tag);
 int         trdp_XMLSeekStartTagAny (XML_HANDLE_T   *pXML,
                                      char           *tag,
                                      int            maxlen);
@@ -100,4 +116,20 @@ void    trdp_XMLRewind (XML_HANDLE_T *pXML);
 void    trdp_XMLEnter (XML_HANDLE_T *pXML);
 void    trdp_XMLLeave (XML_HANDLE_T *pXML);
 
+XML_ARENA_T *trdp_XMLArenaCreate (void);
+XML_ARENA_T *trdp_XMLArenaOfRoot (const void *pRoot);
+void        *trdp_XMLArenaAlloc (XML_ARENA_T    *pArena,
+                                 UINT32         size);
+void        *trdp_XMLArenaGrow (XML_ARENA_T *pArena,
+                                void        *pOld,
+                                UINT32      oldSize,
+                                UINT32      newSize);
+void        *trdp_XMLArenaGrowRoot (XML_ARENA_T *pArena,
+                                    void        *pRoot,
+                                    UINT32      oldSize,
+                                    UINT32      newSize);
+CHAR8       *trdp_XMLArenaStrDup (XML_ARENA_T   *pArena,
+                                  const CHAR8   *pStr);
+void        trdp_XMLArenaFree (XML_ARENA_T *pArena);
+
 #endif /* TRDP_XML_H */
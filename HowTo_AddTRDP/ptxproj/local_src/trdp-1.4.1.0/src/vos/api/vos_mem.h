@@ -17,6 +17,7 @@
  *
  * $Id: vos_mem.h 1631 2017-05-31 12:03:26Z bloehr $
  *
+ *      AG 2026-10-18: Lock-free SPSC/MPMC queue policies, inline payload queues (vos_queueCreateEx/ReceiveCopy)
  *      BL 2017-05-08: Compiler warnings, doxygen comment errors
  */
 
@@ -51,7 +52,9 @@ typedef enum
 {
     VOS_QUEUE_POLICY_OTHER,         /*  Default for the target system    */
     VOS_QUEUE_POLICY_FIFO,          /*  First in, first out              */
-    VOS_QUEUE_POLICY_LIFO           /*  Last in, first out               */
+    VOS_QUEUE_POLICY_LIFO,          /*  Last in, first out               */
+    VOS_QUEUE_POLICY_SPSC,          /*  Lock-free FIFO, single producer / single consumer   */
+    VOS_QUEUE_POLICY_MPMC           /*  Lock-free FIFO, multiple producers / consumers      */
 } VOS_QUEUE_POLICY_T;
 
 
@@ -173,6 +176,14 @@ EXT_DECL VOS_ERR_T vos_memCount(
     UINT32 blockSize[VOS_MEM_NBLOCKSIZES],
     UINT32 usedBlockSize[VOS_MEM_NBLOCKSIZES]);
 
+/**********************************************************************************************************************/
+/** Return the number of allocations since vos_memInit.
+ *
+ *  @retval         number of allocations (wraps around)
+ */
+
+EXT_DECL UINT32 vos_memAllocTotal (void);
+
 /**********************************************************************************************************************/
 /*  Sorting/Searching                                                                                                 */
 /**********************************************************************************************************************/
@@ -302,6 +313,31 @@ EXT_DECL VOS_ERR_T vos_queueCreate (
     VOS_QUEUE_T         *pQueueHandle );
 
 
+/**********************************************************************************************************************/
+/** Initialize a message queue with optional inline payload storage.
+ *  The lock-free policies (SPSC, MPMC) round maxNoOfMsg up to the next power of two and never block the sender.
+ *  If msgSize is not zero, each slot holds a copy of up to msgSize bytes and messages must be fetched with
+ *  vos_queueReceiveCopy(); no buffer must be kept alive by the sender. Inline storage needs a lock-free policy.
+ *
+ *  @param[in]      queueType       Queue policy
+ *  @param[in]      maxNoOfMsg      Maximum number of messages
+ *  @param[in]      msgSize         Size of the inline payload per message, 0 = queue pointers only
+ *  @param[out]     pQueueHandle    Handle of created queue
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_INIT_ERR    not supported
+ *  @retval         VOS_MEM_ERR     out of memory
+ *  @retval         VOS_QUEUE_ERR   error creating queue
+ */
+
+EXT_DECL VOS_ERR_T vos_queueCreateEx (
+    VOS_QUEUE_POLICY_T  queueType,
+    UINT32              maxNoOfMsg,
+    UINT32              msgSize,
+    VOS_QUEUE_T         *pQueueHandle );
+
+
 /**********************************************************************************************************************/
 /** Send a message.
  *
@@ -315,6 +351,7 @@ EXT_DECL VOS_ERR_T vos_queueCreate (
  *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
  *  @retval         VOS_INIT_ERR    not supported
  *  @retval         VOS_QUEUE_ERR   error creating queue
+ *  @retval         VOS_QUEUE_FULL_ERR  queue is full (not logged for the lock-free policies)
  */
 
 EXT_DECL VOS_ERR_T vos_queueSend (
@@ -345,6 +382,27 @@ EXT_DECL VOS_ERR_T vos_queueReceive (
     UINT32      usTimeout );
 
 
+/**********************************************************************************************************************/
+/** Get a message from a queue with inline payload storage.
+ *  The payload is copied out of the queue slot.
+ *
+ *  @param[in]      queueHandle     Queue handle
+ *  @param[out]     pData           Buffer to copy the message into
+ *  @param[in,out]  pSize           In: size of buffer (at least msgSize of the queue), out: size of message
+ *  @param[in]      usTimeout       Maximum time to wait for a message (in usec)
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_QUEUE_ERR   queue is empty
+ */
+
+EXT_DECL VOS_ERR_T vos_queueReceiveCopy (
+    VOS_QUEUE_T queueHandle,
+    UINT8       *pData,
+    UINT32      *pSize,
+    UINT32      usTimeout );
+
+
 /**********************************************************************************************************************/
 /** Destroy a message queue.
  *  Free all resources used by this queue
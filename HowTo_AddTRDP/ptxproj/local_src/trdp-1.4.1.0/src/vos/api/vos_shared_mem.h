@@ -62,7 +62,7 @@ typedef struct VOS_SHRD *VOS_SHRD_T;
 /**********************************************************************************************************************/
 /** Create a shared memory area or attach to existing one.
  *  The first call with the a specified key will create a shared memory area with the supplied size and will return
- *  a handle and a pointer to that area. If the area already exists, the area will be opened.
+ *  a handle and a pointer to that area. If the area already exists, the area will be opened, its content is kept.
  *    This function is not available in each target implementation.
  *
  *  @param[in]      pKey            Unique identifier (file name)
@@ -16,6 +16,8 @@
  *
  * $Id: vos_sock.h 1765 2018-10-04 12:18:54Z ahweiss $
  *
+ *      AG 2026-10-18: vos_sockSetFilter/vos_sockGetDrops (kernel socket filter, kernel drop count)
+ *      AG 2026-10-18: vos_sockJoinSourceMC/vos_sockLeaveSourceMC (source specific multicast)
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
  *      BL 2018-03-06: 64Bit endian swap added
  *      BL 2017-05-22: Ticket #122: Addendum for 64Bit compatibility (VOS_TIME_T -> VOS_TIMEVAL_T)
@@ -70,7 +72,7 @@ extern "C" {
 #define VOS_MAX_SOCKET_CNT  80      /**< The maximum number of concurrent usable sockets per application session */
 #endif
 #ifndef VOS_MAX_MULTICAST_CNT
-#define VOS_MAX_MULTICAST_CNT  20   /**< The maximum number of multicast groups one socket can join              */
+#define VOS_MAX_MULTICAST_CNT  20   /**< Obsolete: multicast groups joined per socket are not limited anymore    */
 #endif
 
 #else
@@ -79,7 +81,7 @@ extern "C" {
 #define VOS_MAX_SOCKET_CNT  4       /**< The maximum number of concurrent usable sockets per application session */
 #endif
 #ifndef VOS_MAX_MULTICAST_CNT
-#define VOS_MAX_MULTICAST_CNT  5    /**< The maximum number of multicast groups one socket can join              */
+#define VOS_MAX_MULTICAST_CNT  5    /**< Obsolete: multicast groups joined per socket are not limited anymore    */
 #endif
 
 #endif
@@ -105,6 +107,10 @@ extern "C" {
 #endif
 #endif
 
+#ifndef VOS_MAX_IOVEC_CNT           /**< The maximum number of buffers for one scatter/gather call */
+#define VOS_MAX_IOVEC_CNT   8
+#endif
+
 #define VOS_INVALID_SOCKET  -1      /**< Invalid socket number */
 
 #define VOS_INADDR_ANY      INADDR_ANY
@@ -144,6 +150,13 @@ typedef struct
     BOOL8           linkState;                  /**< link down (false) / link up (true) */
 } VOS_IF_REC_T;
 
+/** Buffer descriptor for scatter/gather (vectored) socket I/O */
+typedef struct
+{
+    const UINT8     *pBuffer;                   /**< pointer to the data            */
+    UINT32          size;                       /**< size of the data               */
+} VOS_IOVEC_T;
+
 /***********************************************************************************************************************
  * PROTOTYPES
  */
@@ -433,6 +446,88 @@ EXT_DECL VOS_ERR_T vos_sockLeaveMC (
     UINT32  mcAddress,
     UINT32  ipAddress);
 
+/**********************************************************************************************************************/
+/** Join a multicast group for a single source (source specific multicast).
+ *  Note: Some target systems might not support this option.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      mcAddress         multicast group to join
+ *  @param[in]      srcAddress        source to receive the group from
+ *  @param[in]      ipAddress         depicts interface on which to join, default 0 for any
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockJoinSourceMC (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  srcAddress,
+    UINT32  ipAddress);
+
+/**********************************************************************************************************************/
+/** Leave a source specific multicast membership.
+ *  Note: Some target systems might not support this option.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      mcAddress         multicast group to leave
+ *  @param[in]      srcAddress        source the group was joined for
+ *  @param[in]      ipAddress         depicts interface on which to leave, default 0 for any
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockLeaveSourceMC (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  srcAddress,
+    UINT32  ipAddress);
+
+/**********************************************************************************************************************/
+/** Filter received datagrams in the kernel.
+ *  Attaches a socket filter to a UDP socket which passes only datagrams carrying one of the given values
+ *  as 32 bit word in network byte order at the given offset of the payload. Shorter datagrams are dropped.
+ *  An already attached filter is replaced, with no values the filter is removed.
+ *  Note: Some target systems might not support this option.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[in]      offset            offset of the 32 bit word in the UDP payload
+ *  @param[in]      pValues           values to pass (host byte order), sorted ascending
+ *  @param[in]      noOfValues        number of values, 0 to remove the filter
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid, too many values
+ *  @retval         VOS_MEM_ERR       out of memory
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetFilter (
+    SOCKET          sock,
+    UINT32          offset,
+    const UINT32    *pValues,
+    UINT32          noOfValues);
+
+/**********************************************************************************************************************/
+/** Get the number of datagrams the kernel dropped for a socket.
+ *  Counts the datagrams rejected by the socket filter or not fitting into the receive buffer since the socket
+ *  was opened.
+ *  Note: Some target systems might not support this option.
+ *
+ *  @param[in]      sock              socket descriptor
+ *  @param[out]     pDrops            number of dropped datagrams
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_SOCK_ERR      option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockGetDrops (
+    SOCKET  sock,
+    UINT32  *pDrops);
+
 /**********************************************************************************************************************/
 /** Send UDP data.
  *  Send data to the given address and port.
@@ -584,6 +679,30 @@ EXT_DECL VOS_ERR_T vos_sockSendTCP (
     const UINT8 *pBuffer,
     UINT32      *pSize);
 
+/**********************************************************************************************************************/
+/** Send TCP data from several buffers (gather write).
+ *  The buffers are sent in the given order as one contiguous byte stream, without copying them into a common
+ *  buffer first. Partial sends are reported like with vos_sockSendTCP; the caller has to restart with the
+ *  remaining bytes.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pIoVec          array of buffer descriptors
+ *  @param[in]      ioVecCnt        number of buffer descriptors (max. VOS_MAX_IOVEC_CNT)
+ *  @param[out]     pSize           no of bytes sent
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be sent
+ *  @retval         VOS_NOCONN_ERR  no TCP connection
+ *  @retval         VOS_BLOCK_ERR   call would have blocked in blocking mode, data partially sent
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSendTCPv (
+    SOCKET              sock,
+    const VOS_IOVEC_T   *pIoVec,
+    UINT32              ioVecCnt,
+    UINT32              *pSize);
+
 /**********************************************************************************************************************/
 /** Receive TCP data.
  *  The caller must provide a sufficient sized buffer. If the supplied buffer is smaller than the bytes received, *pSize
@@ -16,6 +16,7 @@
  *
  * $Id: vos_thread.h 1763 2018-09-21 16:03:13Z ahweiss $
  *
+ *      AG 2026-10-18: Real-time thread options: CPU affinity, isolated cores, memory locking, stack pre-faulting
  *      BL 2017-05-22: Ticket #122: Addendum for 64Bit compatibility (VOS_TIME_T -> VOS_TIMEVAL_T)
  */
 
@@ -132,6 +133,20 @@ typedef struct VOS_SEMA *VOS_SEMA_T;
 /** Hidden thread handle definition    */
 typedef void *VOS_THREAD_T;
 
+/** Real-time option flags for vos_threadCreateEx()    */
+#define VOS_THREAD_OPT_LOCK_MEMORY  0x01u   /**< Lock all current and future pages of the process (no paging)    */
+#define VOS_THREAD_OPT_ISOLATE      0x02u   /**< Reserve the cores in cpuMask: the creating thread and all threads
+                                                 it creates later are moved off them                              */
+
+/** Real-time options for vos_threadCreateEx()    */
+typedef struct
+{
+    UINT64  cpuMask;                        /**< Cores the thread may run on (bit 0 = CPU 0), 0 = no restriction */
+    UINT32  flags;                          /**< VOS_THREAD_OPT_... flags                                        */
+    UINT32  stackPrefault;                  /**< Bytes of stack to touch before the thread function runs, 0 = none,
+                                                 limited to the stack size                                       */
+} VOS_THREAD_OPTIONS_T;
+
 
 /***********************************************************************************************************************
  * PROTOTYPES
@@ -193,6 +208,81 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
     VOS_THREAD_FUNC_T       pFunction,
     void                    *pArguments);
 
+/**********************************************************************************************************************/
+/** Create a thread with real-time options.
+ *  As vos_threadCreate(), the new thread can additionally be pinned to a set of cores, have its stack pre-faulted and
+ *  the process memory locked before it runs. Priorities of the FIFO and RR policies are limited to the range the
+ *  target supports.
+ *
+ *  @param[out]     pThread           Pointer to returned thread handle
+ *  @param[in]      pName             Pointer to name of the thread (optional)
+ *  @param[in]      policy            Scheduling policy (FIFO, Round Robin or other)
+ *  @param[in]      priority          Scheduling priority (1...255 (highest), default 0)
+ *  @param[in]      interval          Interval for cyclic threads in us (optional)
+ *  @param[in]      stackSize         Minimum stacksize, default 0: 16kB
+ *  @param[in]      pOptions          Pointer to real-time options, NULL = none
+ *  @param[in]      pFunction         Pointer to the thread function
+ *  @param[in]      pArguments        Pointer to the thread function parameters
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_INIT_ERR      module not initialised or option not supported
+ *  @retval         VOS_PARAM_ERR     parameter out of range/invalid
+ *  @retval         VOS_THREAD_ERR    thread creation error
+ */
+
+EXT_DECL VOS_ERR_T vos_threadCreateEx (
+    VOS_THREAD_T                *pThread,
+    const CHAR8                 *pName,
+    VOS_THREAD_POLICY_T         policy,
+    VOS_THREAD_PRIORITY_T       priority,
+    UINT32                      interval,
+    UINT32                      stackSize,
+    const VOS_THREAD_OPTIONS_T  *pOptions,
+    VOS_THREAD_FUNC_T           pFunction,
+    void                        *pArguments);
+
+/**********************************************************************************************************************/
+/** Restrict a thread to a set of cores.
+ *  Used to pin threads not created by VOS, e.g. the main thread running tlc_process().
+ *
+ *  @param[in]      thread            Thread handle (or NULL for the calling thread)
+ *  @param[in]      cpuMask           Cores the thread may run on (bit 0 = CPU 0)
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_INIT_ERR      not supported
+ *  @retval         VOS_PARAM_ERR     empty or invalid mask
+ *  @retval         VOS_THREAD_ERR    affinity could not be set
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetAffinity (
+    VOS_THREAD_T    thread,
+    UINT64          cpuMask);
+
+/**********************************************************************************************************************/
+/** Lock all current and future pages of the process into memory.
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_INIT_ERR      not supported
+ *  @retval         VOS_MEM_ERR       locking failed (e.g. missing privileges or RLIMIT_MEMLOCK)
+ */
+
+EXT_DECL VOS_ERR_T vos_threadLockMemory (
+    void);
+
+/**********************************************************************************************************************/
+/** Touch the next size bytes of the calling thread's stack.
+ *  Avoids page faults on first use of the stack in the cyclic path. The size is limited to the stack left below the
+ *  caller's frame, minus a reserve for the frames still to come.
+ *
+ *  @param[in]      size              Number of bytes to pre-fault
+ *
+ *  @retval         VOS_NO_ERR        no error
+ *  @retval         VOS_INIT_ERR      not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_threadPrefaultStack (
+    UINT32 size);
+
 /**********************************************************************************************************************/
 /** Cyclic thread functions.
  *  Wrapper for cyclic threads. The thread function will be called cyclically with interval.
@@ -18,6 +18,8 @@
  * $Id: vos_mem.c 1789 2018-11-09 08:15:22Z ahweiss $
  *
  * Changes:
+ *      AG 2026-10-19: vos_memAllocTotal: number of allocations since vos_memInit for benchmarks
+ *      AG 2026-10-18: Lock-free SPSC/MPMC queue policies with inline payload and eventfd wakeup
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
  *      BL 2016-07-06: Ticket #122 64Bit compatibility (+ compiler warnings)
  *      BL 2016-02-10: Debug print: tabs before size output
@@ -51,6 +53,13 @@
 #include <pthread.h>
 #endif
 
+#if defined(POSIX) && defined(__linux__)
+#include <poll.h>
+#include <time.h>
+#include <sys/eventfd.h>
+#define VOS_QUEUE_EVENTFD
+#endif
+
 #ifndef PTHREAD_MUTEX_INITIALIZER
 #define PTHREAD_MUTEX_INITIALIZER  0 /* Dummy */
 #endif
@@ -77,6 +86,7 @@ typedef struct
     UINT32  freeSize;             /* Size of free memory */
     UINT32  minFreeSize;          /* Size of free memory */
     UINT32  allocCnt;             /* No of allocated memory blocks */
+    UINT32  allocTotal;           /* No of allocations since init (wraps) */
     UINT32  allocErrCnt;          /* No of allocated memory errors */
     UINT32  freeErrCnt;           /* No of free memory errors */
     UINT32  blockCnt[VOS_MEM_NBLOCKSIZES];  /* D:o per block size */
@@ -113,6 +123,75 @@ typedef struct
     UINT32  queuReadErrCnt;      /* No of queue read errors */
 } VOS_STATISTIC;
 
+/* Lock-free queues need the GCC/clang __atomic builtins. Without them vos_queueCreateEx() refuses the SPSC/MPMC
+   policies, the plain accesses below are then never executed concurrently. */
+#if defined(__GNUC__) || defined(__clang__)
+#define VOS_QUEUE_LOCKFREE              1
+#define VOS_ATOMIC_LOAD(p, mo)          __atomic_load_n((p), (mo))
+#define VOS_ATOMIC_STORE(p, v, mo)      __atomic_store_n((p), (v), (mo))
+#define VOS_ATOMIC_ADD(p, v)            __atomic_add_fetch((p), (v), __ATOMIC_SEQ_CST)
+#define VOS_ATOMIC_SUB(p, v)            __atomic_sub_fetch((p), (v), __ATOMIC_SEQ_CST)
+#define VOS_ATOMIC_XCHG(p, v)           __atomic_exchange_n((p), (v), __ATOMIC_SEQ_CST)
+#define VOS_ATOMIC_CAS(p, pExp, v)      __atomic_compare_exchange_n((p), (pExp), (v), 1, \
+                                                                    __ATOMIC_RELAXED, __ATOMIC_RELAXED)
+#define VOS_ATOMIC_FENCE()              __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define VOS_MO_RELAXED                  __ATOMIC_RELAXED
+#define VOS_MO_ACQUIRE                  __ATOMIC_ACQUIRE
+#define VOS_MO_RELEASE                  __ATOMIC_RELEASE
+#else
+#define VOS_QUEUE_LOCKFREE              0
+#define VOS_ATOMIC_LOAD(p, mo)          (*(p))
+#define VOS_ATOMIC_STORE(p, v, mo)      (*(p) = (v))
+#define VOS_ATOMIC_ADD(p, v)            (*(p) += (v))
+#define VOS_ATOMIC_SUB(p, v)            (*(p) -= (v))
+#define VOS_ATOMIC_XCHG(p, v)           vos_atomicXchg((p), (v))
+#define VOS_ATOMIC_CAS(p, pExp, v)      ((*(p) == *(pExp)) ? ((*(p) = (v)), 1) : ((*(pExp) = *(p)), 0))
+#define VOS_ATOMIC_FENCE()
+#define VOS_MO_RELAXED                  0
+#define VOS_MO_ACQUIRE                  0
+#define VOS_MO_RELEASE                  0
+#endif
+
+#define VOS_CACHE_LINE_SIZE             64u
+#define VOS_RING_MAX_MSG                0x80000000u
+
+/* Lock-free ring slot, the inline payload (if any) follows */
+typedef struct
+{
+    UINT32  seq;                    /* Slot sequence number (MPMC only) */
+    UINT32  size;                   /* Size of message */
+    UINT8   *pData;                 /* Message pointer (pointer queues only) */
+} VOS_RING_SLOT_T;
+
+/* Lock-free ring, producer and consumer indices are kept on separate cache lines */
+typedef struct
+{
+    UINT32          mask;           /* No of slots - 1 */
+    UINT32          stride;         /* Size of one slot incl. inline payload */
+    UINT32          msgSize;        /* Inline payload size, 0 = pointer queue */
+    INT32           eventFd;        /* Wakeup for blocked receivers (Linux) */
+    UINT8           *pSlots;        /* Slot array, follows this header */
+    UINT8           pad0[VOS_CACHE_LINE_SIZE];
+    UINT32          tail;           /* Next slot to write */
+    UINT32          headCache;      /* Producer's copy of head (SPSC) */
+    UINT8           pad1[VOS_CACHE_LINE_SIZE];
+    UINT32          head;           /* Next slot to read */
+    UINT32          tailCache;      /* Consumer's copy of tail (SPSC) */
+    UINT8           pad2[VOS_CACHE_LINE_SIZE];
+    UINT32          waiters;        /* No of receivers about to block */
+    UINT32          wakePending;    /* A wakeup was signalled and not yet consumed */
+    UINT8           pad3[VOS_CACHE_LINE_SIZE];
+} VOS_RING_T;
+
+#if (VOS_QUEUE_LOCKFREE == 0)
+static UINT32 vos_atomicXchg (UINT32 *p, UINT32 v)
+{
+    UINT32 old = *p;
+    *p = v;
+    return old;
+}
+#endif
+
 /* Queue header struct */
 struct VOS_QUEUE
 {
@@ -124,6 +203,7 @@ struct VOS_QUEUE
     VOS_SEMA_T              semaphore;
     VOS_MUTEX_T             mutex;
     struct VOS_QUEUE_ELEM   *pQueue;
+    VOS_RING_T              *pRing;     /* Lock-free ring (SPSC/MPMC policy), NULL otherwise */
 };
 
 /* Queue element struct */
@@ -149,7 +229,7 @@ static MEM_CONTROL_T gMem =
         {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL},
         {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL}, {0L, NULL}
     },
-    {0, 0, 0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, VOS_MEM_PREALLOCATE}
+    {0, 0, 0, 0, 0, 0, {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0}, VOS_MEM_PREALLOCATE}
 };
 
 /***********************************************************************************************************************
@@ -194,6 +274,7 @@ EXT_DECL VOS_ERR_T vos_memInit (
     gMem.memCnt.freeSize    = size;
     gMem.memCnt.minFreeSize = size;
     gMem.memCnt.allocCnt    = 0;
+    gMem.memCnt.allocTotal  = 0;
     gMem.memCnt.allocErrCnt = 0;
     gMem.memCnt.freeErrCnt  = 0;
 
@@ -371,6 +452,7 @@ EXT_DECL UINT8 *vos_memAlloc (
         if (p != NULL)
         {
             memset(p, 0, size);
+            gMem.memCnt.allocTotal++;
         }
         vos_printLog(VOS_LOG_DBG, "vos_memAlloc() %p, size\t%u\n", (void *) p, size);
 
@@ -470,6 +552,7 @@ EXT_DECL UINT8 *vos_memAlloc (
                 gMem.memCnt.minFreeSize = gMem.memCnt.freeSize;
             }
             gMem.memCnt.allocCnt++;
+            gMem.memCnt.allocTotal++;
 
             /* Clear returned memory area to be compliant with malloc'ed version */
             memset((UINT8 *) pBlock + sizeof(MEM_BLOCK_T), 0, blockSize);
@@ -638,6 +721,19 @@ EXT_DECL VOS_ERR_T vos_memCount (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Return the number of allocations since vos_memInit.
+ *  Counts the successful calls of vos_memAlloc from the memory area and from the heap. The difference of two calls
+ *  gives the allocations of the code in between, e.g. allocations per operation in a benchmark.
+ *
+ *  @retval         number of allocations (wraps around)
+ */
+
+EXT_DECL UINT32 vos_memAllocTotal (void)
+{
+    return gMem.memCnt.allocTotal;
+}
+
 
 /**********************************************************************************************************************/
 /** Sort an array.
@@ -771,6 +867,451 @@ EXT_DECL void vos_strncat (
                                                                                                                */
 /**********************************************************************************************************************/
 
+/**********************************************************************************************************************/
+/** Store a message in a lock-free ring.
+ *
+ *  @param[in]      queueHandle     Queue handle
+ *  @param[in]      pData           Pointer to data to be sent
+ *  @param[in]      size            Size of data to be sent
+ *
+ *  @retval         TRUE            message queued
+ *  @retval         FALSE           queue full
+ */
+
+static BOOL8 vos_ringPut (
+    VOS_QUEUE_T queueHandle,
+    UINT8       *pData,
+    UINT32      size)
+{
+    VOS_RING_T      *pRing = queueHandle->pRing;
+    VOS_RING_SLOT_T *pSlot;
+    UINT32          pos;
+    UINT32          seq;
+
+    if (queueHandle->queueType == VOS_QUEUE_POLICY_SPSC)
+    {
+        pos = VOS_ATOMIC_LOAD(&pRing->tail, VOS_MO_RELAXED);
+        if ((pos - pRing->headCache) > pRing->mask)
+        {
+            pRing->headCache = VOS_ATOMIC_LOAD(&pRing->head, VOS_MO_ACQUIRE);
+            if ((pos - pRing->headCache) > pRing->mask)
+            {
+                return FALSE;
+            }
+        }
+        pSlot = (VOS_RING_SLOT_T *)(pRing->pSlots + (pos & pRing->mask) * pRing->stride);
+    }
+    else
+    {
+        /* MPMC: claim the slot whose sequence matches our position */
+        pos = VOS_ATOMIC_LOAD(&pRing->tail, VOS_MO_RELAXED);
+        for (;; )
+        {
+            pSlot   = (VOS_RING_SLOT_T *)(pRing->pSlots + (pos & pRing->mask) * pRing->stride);
+            seq     = VOS_ATOMIC_LOAD(&pSlot->seq, VOS_MO_ACQUIRE);
+            if (seq == pos)
+            {
+                if (VOS_ATOMIC_CAS(&pRing->tail, &pos, pos + 1u))
+                {
+                    break;
+                }
+            }
+            else if ((INT32)(seq - pos) < 0)
+            {
+                return FALSE;
+            }
+            else
+            {
+                pos = VOS_ATOMIC_LOAD(&pRing->tail, VOS_MO_RELAXED);
+            }
+        }
+    }
+
+    pSlot->size = size;
+    if (pRing->msgSize != 0u)
+    {
+        memcpy((UINT8 *)(pSlot + 1), pData, size);
+    }
+    else
+    {
+        pSlot->pData = pData;
+    }
+
+    if (queueHandle->queueType == VOS_QUEUE_POLICY_SPSC)
+    {
+        VOS_ATOMIC_STORE(&pRing->tail, pos + 1u, VOS_MO_RELEASE);
+    }
+    else
+    {
+        VOS_ATOMIC_STORE(&pSlot->seq, pos + 1u, VOS_MO_RELEASE);
+    }
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Fetch a message from a lock-free ring.
+ *
+ *  @param[in]      queueHandle     Queue handle
+ *  @param[out]     ppData          Message pointer (pointer queues)
+ *  @param[out]     pBuf            Buffer for the message copy (inline queues)
+ *  @param[out]     pSize           Size of message
+ *
+ *  @retval         TRUE            message fetched
+ *  @retval         FALSE           queue empty
+ */
+
+static BOOL8 vos_ringGet (
+    VOS_QUEUE_T queueHandle,
+    UINT8       * *ppData,
+    UINT8       *pBuf,
+    UINT32      *pSize)
+{
+    VOS_RING_T      *pRing = queueHandle->pRing;
+    VOS_RING_SLOT_T *pSlot;
+    UINT32          pos;
+    UINT32          seq;
+
+    if (queueHandle->queueType == VOS_QUEUE_POLICY_SPSC)
+    {
+        pos = VOS_ATOMIC_LOAD(&pRing->head, VOS_MO_RELAXED);
+        if (pos == pRing->tailCache)
+        {
+            pRing->tailCache = VOS_ATOMIC_LOAD(&pRing->tail, VOS_MO_ACQUIRE);
+            if (pos == pRing->tailCache)
+            {
+                return FALSE;
+            }
+        }
+        pSlot = (VOS_RING_SLOT_T *)(pRing->pSlots + (pos & pRing->mask) * pRing->stride);
+    }
+    else
+    {
+        pos = VOS_ATOMIC_LOAD(&pRing->head, VOS_MO_RELAXED);
+        for (;; )
+        {
+            pSlot   = (VOS_RING_SLOT_T *)(pRing->pSlots + (pos & pRing->mask) * pRing->stride);
+            seq     = VOS_ATOMIC_LOAD(&pSlot->seq, VOS_MO_ACQUIRE);
+            if (seq == pos + 1u)
+            {
+                if (VOS_ATOMIC_CAS(&pRing->head, &pos, pos + 1u))
+                {
+                    break;
+                }
+            }
+            else if ((INT32)(seq - (pos + 1u)) < 0)
+            {
+                return FALSE;
+            }
+            else
+            {
+                pos = VOS_ATOMIC_LOAD(&pRing->head, VOS_MO_RELAXED);
+            }
+        }
+    }
+
+    *pSize = pSlot->size;
+    if (pRing->msgSize != 0u)
+    {
+        memcpy(pBuf, (UINT8 *)(pSlot + 1), pSlot->size);
+    }
+    else
+    {
+        *ppData = pSlot->pData;
+    }
+
+    if (queueHandle->queueType == VOS_QUEUE_POLICY_SPSC)
+    {
+        VOS_ATOMIC_STORE(&pRing->head, pos + 1u, VOS_MO_RELEASE);
+    }
+    else
+    {
+        /* hand the slot back to the producers for the next round */
+        VOS_ATOMIC_STORE(&pSlot->seq, pos + pRing->mask + 1u, VOS_MO_RELEASE);
+    }
+    return TRUE;
+}
+
+/**********************************************************************************************************************/
+/** Wake blocked receivers of a lock-free ring.
+ *  The full fence pairs with the one implied by the waiter increment in vos_ringReceive(): either the receiver
+ *  sees the new message, or we see the waiter and signal it. Only one signal is outstanding at a time, senders
+ *  do not pay a system call per message while the receiver is still waking up.
+ *
+ *  @param[in]      queueHandle     Queue handle
+ */
+
+static void vos_ringWake (
+    VOS_QUEUE_T queueHandle)
+{
+    VOS_RING_T *pRing = queueHandle->pRing;
+
+    VOS_ATOMIC_FENCE();
+    if ((VOS_ATOMIC_LOAD(&pRing->waiters, VOS_MO_RELAXED) != 0u)
+        && (VOS_ATOMIC_XCHG(&pRing->wakePending, 1u) == 0u))
+    {
+#ifdef VOS_QUEUE_EVENTFD
+        UINT64 one = 1u;
+        (void) write(pRing->eventFd, &one, sizeof(one));
+#else
+        vos_semaGive(queueHandle->semaphore);
+#endif
+    }
+}
+
+/**********************************************************************************************************************/
+/** Send a message to a lock-free ring and wake a blocked receiver.
+ *
+ *  @param[in]      queueHandle     Queue handle
+ *  @param[in]      pData           Pointer to data to be sent
+ *  @param[in]      size            Size of data to be sent
+ *
+ *  @retval         VOS_NO_ERR          no error
+ *  @retval         VOS_QUEUE_FULL_ERR  queue is full
+ */
+
+static VOS_ERR_T vos_ringSend (
+    VOS_QUEUE_T queueHandle,
+    UINT8       *pData,
+    UINT32      size)
+{
+    if (vos_ringPut(queueHandle, pData, size) == FALSE)
+    {
+        return VOS_QUEUE_FULL_ERR;
+    }
+    vos_ringWake(queueHandle);
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Block until a sender signals the ring or the time is up.
+ *
+ *  @param[in]      queueHandle     Queue handle
+ *  @param[in]      usTimeout       Maximum time to wait (in usec), VOS_SEMA_WAIT_FOREVER to wait forever
+ */
+
+static void vos_ringWait (
+    VOS_QUEUE_T queueHandle,
+    UINT32      usTimeout)
+{
+#ifdef VOS_QUEUE_EVENTFD
+    struct pollfd   pfd;
+    struct timespec ts;
+    UINT64          cnt;
+
+    pfd.fd      = queueHandle->pRing->eventFd;
+    pfd.events  = POLLIN;
+    pfd.revents = 0;
+    ts.tv_sec   = (time_t) (usTimeout / 1000000u);
+    ts.tv_nsec  = (long) (usTimeout % 1000000u) * 1000;
+    if (ppoll(&pfd, 1, (usTimeout == VOS_SEMA_WAIT_FOREVER) ? NULL : &ts, NULL) > 0)
+    {
+        (void) read(pfd.fd, &cnt, sizeof(cnt));
+    }
+#else
+    (void) vos_semaTake(queueHandle->semaphore, usTimeout);
+#endif
+    /* allow the next sender to signal again */
+    (void) VOS_ATOMIC_XCHG(&queueHandle->pRing->wakePending, 0u);
+}
+
+/**********************************************************************************************************************/
+/** Receive a message from a lock-free ring, blocking up to usTimeout.
+ *
+ *  @param[in]      queueHandle     Queue handle
+ *  @param[out]     ppData          Message pointer (pointer queues)
+ *  @param[out]     pBuf            Buffer for the message copy (inline queues)
+ *  @param[out]     pSize           Size of message
+ *  @param[in]      usTimeout       Maximum time to wait for a message (in usec)
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_QUEUE_ERR   queue is empty
+ */
+
+static VOS_ERR_T vos_ringReceive (
+    VOS_QUEUE_T queueHandle,
+    UINT8       * *ppData,
+    UINT8       *pBuf,
+    UINT32      *pSize,
+    UINT32      usTimeout)
+{
+    VOS_RING_T      *pRing = queueHandle->pRing;
+    VOS_TIMEVAL_T   now;
+    VOS_TIMEVAL_T   end;
+    VOS_TIMEVAL_T   left;
+    UINT32          waitUs;
+    BOOL8           got;
+    BOOL8           slept = FALSE;
+
+    if (vos_ringGet(queueHandle, ppData, pBuf, pSize) == TRUE)
+    {
+        return VOS_NO_ERR;
+    }
+    if (usTimeout == 0u)
+    {
+        return VOS_QUEUE_ERR;
+    }
+
+    vos_getTime(&end);
+    left.tv_sec     = usTimeout / 1000000u;
+    left.tv_usec    = usTimeout % 1000000u;
+    vos_addTime(&end, &left);
+
+    for (;; )
+    {
+        waitUs = VOS_SEMA_WAIT_FOREVER;
+        (void) VOS_ATOMIC_ADD(&pRing->waiters, 1u);
+        got = vos_ringGet(queueHandle, ppData, pBuf, pSize);
+        if ((got == FALSE) && (usTimeout != VOS_SEMA_WAIT_FOREVER))
+        {
+            vos_getTime(&now);
+            if (vos_cmpTime(&now, &end) >= 0)
+            {
+                waitUs = 0u;
+            }
+            else
+            {
+                left = end;
+                vos_subTime(&left, &now);
+                waitUs = (UINT32) left.tv_sec * 1000000u + (UINT32) left.tv_usec;
+            }
+        }
+        if ((got == FALSE) && (waitUs != 0u))
+        {
+            vos_ringWait(queueHandle, waitUs);
+            slept = TRUE;
+        }
+        (void) VOS_ATOMIC_SUB(&pRing->waiters, 1u);
+        if (got == TRUE)
+        {
+            /* a signal may have been swallowed for several messages: pass it on to the other receivers */
+            if ((slept == TRUE)
+                && (VOS_ATOMIC_LOAD(&pRing->head, VOS_MO_RELAXED) != VOS_ATOMIC_LOAD(&pRing->tail, VOS_MO_RELAXED)))
+            {
+                vos_ringWake(queueHandle);
+            }
+            return VOS_NO_ERR;
+        }
+        if (waitUs == 0u)
+        {
+            return VOS_QUEUE_ERR;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Initialize a message queue with optional inline payload storage.
+ *  The lock-free policies (SPSC, MPMC) round maxNoOfMsg up to the next power of two and never block the sender.
+ *  If msgSize is not zero, each slot holds a copy of up to msgSize bytes and messages must be fetched with
+ *  vos_queueReceiveCopy(). Inline storage needs a lock-free policy.
+ *
+ *  @param[in]      queueType       Queue policy
+ *  @param[in]      maxNoOfMsg      Maximum number of messages
+ *  @param[in]      msgSize         Size of the inline payload per message, 0 = queue pointers only
+ *  @param[out]     pQueueHandle    Handle of created queue
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_INIT_ERR    not supported
+ *  @retval         VOS_MEM_ERR     out of memory
+ *  @retval         VOS_QUEUE_ERR   error creating queue
+ */
+
+EXT_DECL VOS_ERR_T vos_queueCreateEx (
+    VOS_QUEUE_POLICY_T  queueType,
+    UINT32              maxNoOfMsg,
+    UINT32              msgSize,
+    VOS_QUEUE_T         *pQueueHandle )
+{
+    VOS_QUEUE_T pQueue;
+    VOS_RING_T  *pRing;
+    UINT32      noOfSlots   = 1u;
+    UINT32      stride;
+    UINT32      i;
+
+    if ((queueType != VOS_QUEUE_POLICY_SPSC) && (queueType != VOS_QUEUE_POLICY_MPMC))
+    {
+        if (msgSize != 0u)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "vos_queueCreateEx() ERROR inline payload needs SPSC or MPMC policy\n");
+            return VOS_PARAM_ERR;
+        }
+        return vos_queueCreate(queueType, maxNoOfMsg, pQueueHandle);
+    }
+    if ((pQueueHandle == NULL)
+        || (maxNoOfMsg == 0u)
+        || (maxNoOfMsg > VOS_RING_MAX_MSG)
+        || (msgSize > 0x10000000u))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_queueCreateEx() ERROR invalid parameter\n");
+        return VOS_PARAM_ERR;
+    }
+    if (VOS_QUEUE_LOCKFREE == 0)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_queueCreateEx() ERROR lock-free queues not supported\n");
+        return VOS_INIT_ERR;
+    }
+
+    while (noOfSlots < maxNoOfMsg)
+    {
+        noOfSlots <<= 1;
+    }
+    stride = ((UINT32) sizeof(VOS_RING_SLOT_T) + msgSize + 7u) & ~7u;
+    if (((UINT64) noOfSlots * stride) > (0xFFFFFFFFu - sizeof(VOS_RING_T)))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_queueCreateEx() ERROR queue too large\n");
+        return VOS_PARAM_ERR;
+    }
+
+    pQueue = (VOS_QUEUE_T) vos_memAlloc(sizeof(struct VOS_QUEUE));
+    if (pQueue == NULL)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_queueCreateEx() ERROR could not allocate memory\n");
+        return VOS_MEM_ERR;
+    }
+    pRing = (VOS_RING_T *) vos_memAlloc((UINT32) sizeof(VOS_RING_T) + noOfSlots * stride);
+    if (pRing == NULL)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_queueCreateEx() ERROR could not allocate memory\n");
+        vos_memFree(pQueue);
+        return VOS_MEM_ERR;
+    }
+    pRing->mask     = noOfSlots - 1u;
+    pRing->stride   = stride;
+    pRing->msgSize  = msgSize;
+    pRing->pSlots   = (UINT8 *)(pRing + 1);
+    for (i = 0u; i < noOfSlots; i++)
+    {
+        ((VOS_RING_SLOT_T *)(pRing->pSlots + i * stride))->seq = i;
+    }
+
+#ifdef VOS_QUEUE_EVENTFD
+    pRing->eventFd = eventfd(0u, EFD_SEMAPHORE | EFD_NONBLOCK | EFD_CLOEXEC);
+    if (pRing->eventFd < 0)
+    {
+        vos_printLog(VOS_LOG_ERROR, "vos_queueCreateEx() ERROR could not create eventfd (%d)\n", errno);
+        vos_memFree(pRing);
+        vos_memFree(pQueue);
+        return VOS_QUEUE_ERR;
+    }
+#else
+    pRing->eventFd = -1;
+    if (vos_semaCreate(&pQueue->semaphore, VOS_SEMA_EMPTY) != VOS_NO_ERR)
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_queueCreateEx() ERROR could not create semaphore\n");
+        vos_memFree(pRing);
+        vos_memFree(pQueue);
+        return VOS_SEMA_ERR;
+    }
+#endif
+
+    pQueue->queueType   = queueType;
+    pQueue->maxNoOfMsg  = noOfSlots;
+    pQueue->pRing       = pRing;
+    pQueue->magicNumber = cQueueMagic;
+    *pQueueHandle       = pQueue;
+    return VOS_NO_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Initialize a message queue.
  *  Returns a handle for further calls
@@ -795,7 +1336,12 @@ EXT_DECL VOS_ERR_T vos_queueCreate (
     VOS_ERR_T retVal = VOS_UNKNOWN_ERR;
 
     /* Check parameters */
-    if ((queueType < VOS_QUEUE_POLICY_OTHER)
+    if ((queueType == VOS_QUEUE_POLICY_SPSC)
+        || (queueType == VOS_QUEUE_POLICY_MPMC))
+    {
+        retVal = vos_queueCreateEx(queueType, maxNoOfMsg, 0u, pQueueHandle);
+    }
+    else if ((queueType < VOS_QUEUE_POLICY_OTHER)
         || (queueType > VOS_QUEUE_POLICY_LIFO)
         || (pQueueHandle == NULL)
         || (maxNoOfMsg == 0))
@@ -906,6 +1452,18 @@ EXT_DECL VOS_ERR_T vos_queueSend (
         vos_printLogStr(VOS_LOG_ERROR, "vos_queueSend() ERROR invalid parameter\n");
         retVal = VOS_PARAM_ERR;
     }
+    else if (queueHandle->pRing != NULL)
+    {
+        if ((queueHandle->pRing->msgSize != 0u) && (size > queueHandle->pRing->msgSize))
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "vos_queueSend() ERROR message exceeds inline size\n");
+            retVal = VOS_PARAM_ERR;
+        }
+        else
+        {
+            retVal = vos_ringSend(queueHandle, pData, size);
+        }
+    }
     else
     {
         err = vos_mutexLock(queueHandle->mutex);
@@ -1017,6 +1575,20 @@ EXT_DECL VOS_ERR_T vos_queueReceive (
         vos_printLogStr(VOS_LOG_ERROR, "vos_queueReceive() ERROR invalid parameter\n");
         retVal = VOS_PARAM_ERR;
     }
+    else if (queueHandle->pRing != NULL)
+    {
+        *ppData = NULL;
+        *pSize  = 0u;
+        if (queueHandle->pRing->msgSize != 0u)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "vos_queueReceive() ERROR use vos_queueReceiveCopy() for inline queues\n");
+            retVal = VOS_PARAM_ERR;
+        }
+        else
+        {
+            retVal = vos_ringReceive(queueHandle, ppData, NULL, pSize, usTimeout);
+        }
+    }
     else
     {
         /* wait for semaphore indicating new message in queue */
@@ -1077,6 +1649,41 @@ EXT_DECL VOS_ERR_T vos_queueReceive (
     return retVal;
 }
 
+/**********************************************************************************************************************/
+/** Get a message from a queue with inline payload storage.
+ *  The payload is copied out of the queue slot.
+ *
+ *  @param[in]      queueHandle      Queue handle
+ *  @param[out]     pData            Buffer to copy the message into
+ *  @param[in,out]  pSize            In: size of buffer (at least msgSize of the queue), out: size of message
+ *  @param[in]      usTimeout        Maximum time to wait for a message (in usec)
+ *
+ *  @retval         VOS_NO_ERR       no error
+ *  @retval         VOS_PARAM_ERR    parameter out of range/invalid
+ *  @retval         VOS_QUEUE_ERR    queue is empty
+ */
+
+EXT_DECL VOS_ERR_T vos_queueReceiveCopy (
+    VOS_QUEUE_T queueHandle,
+    UINT8       *pData,
+    UINT32      *pSize,
+    UINT32      usTimeout )
+{
+    if ((queueHandle == (VOS_QUEUE_T) NULL)
+        || (queueHandle->magicNumber != cQueueMagic)
+        || (queueHandle->pRing == NULL)
+        || (queueHandle->pRing->msgSize == 0u)
+        || (pData == NULL)
+        || (pSize == NULL)
+        || (*pSize < queueHandle->pRing->msgSize))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_queueReceiveCopy() ERROR invalid parameter\n");
+        return VOS_PARAM_ERR;
+    }
+    *pSize = 0u;
+    return vos_ringReceive(queueHandle, NULL, pData, pSize, usTimeout);
+}
+
 /**********************************************************************************************************************/
 /** Destroy a message queue.
  *  Free all resources used by this queue
@@ -1101,6 +1708,18 @@ EXT_DECL VOS_ERR_T vos_queueDestroy (
         vos_printLogStr(VOS_LOG_ERROR, "vos_queueDestroy() ERROR invalid parameter\n");
         retVal = VOS_PARAM_ERR;
     }
+    else if (queueHandle->pRing != NULL)
+    {
+        queueHandle->magicNumber = 0;
+#ifdef VOS_QUEUE_EVENTFD
+        (void) close(queueHandle->pRing->eventFd);
+#else
+        vos_semaDelete(queueHandle->semaphore);
+#endif
+        vos_memFree(queueHandle->pRing);
+        vos_memFree(queueHandle);
+        retVal = VOS_NO_ERR;
+    }
     else
     {
         err = vos_mutexLock(queueHandle->mutex);
@@ -16,6 +16,7 @@
  *
  * $Id: vos_thread.c 1749 2018-07-19 16:38:21Z bloehr $
  *
+ *      AG 2026-10-18: vos_threadCreateEx and real-time thread options (not supported on this target)
  *      BL 2018-06-25: Ticket #202: vos_mutexTrylock return value
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
  */
@@ -353,6 +354,91 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Create a thread with real-time options.
+ *  Real-time options are not supported on this target, without options this is vos_threadCreate().
+ *
+ *  @param[out]     pThread         Pointer to returned thread handle
+ *  @param[in]      pName           Pointer to name of the thread (optional)
+ *  @param[in]      policy          Scheduling policy (FIFO, Round Robin or other)
+ *  @param[in]      priority        Scheduling priority (1...255 (highest), default 0)
+ *  @param[in]      interval        Interval for cyclic threads in us (optional)
+ *  @param[in]      stackSize       Minimum stacksize, default 0: 16kB
+ *  @param[in]      pOptions        Pointer to real-time options, NULL = none
+ *  @param[in]      pFunction       Pointer to the thread function
+ *  @param[in]      pArguments      Pointer to the thread function parameters
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_INIT_ERR    module not initialised or option not supported
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_THREAD_ERR  thread creation error
+ */
+
+EXT_DECL VOS_ERR_T vos_threadCreateEx (
+    VOS_THREAD_T                *pThread,
+    const CHAR8                 *pName,
+    VOS_THREAD_POLICY_T         policy,
+    VOS_THREAD_PRIORITY_T       priority,
+    UINT32                      interval,
+    UINT32                      stackSize,
+    const VOS_THREAD_OPTIONS_T  *pOptions,
+    VOS_THREAD_FUNC_T           pFunction,
+    void                        *pArguments)
+{
+    if ((pOptions != NULL)
+        && ((pOptions->cpuMask != 0u) || (pOptions->flags != 0u) || (pOptions->stackPrefault != 0u)))
+    {
+        vos_printLogStr(VOS_LOG_ERROR, "vos_threadCreateEx() real-time options not supported\n");
+        return VOS_INIT_ERR;
+    }
+    return vos_threadCreate(pThread, pName, policy, priority, interval, stackSize, pFunction, pArguments);
+}
+
+/**********************************************************************************************************************/
+/** Restrict a thread to a set of cores.
+ *  Not supported on this target.
+ *
+ *  @param[in]      thread          Thread handle (or NULL for the calling thread)
+ *  @param[in]      cpuMask         Cores the thread may run on (bit 0 = CPU 0)
+ *  @retval         VOS_INIT_ERR    not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetAffinity (
+    VOS_THREAD_T    thread,
+    UINT64          cpuMask)
+{
+    (void) thread;
+    (void) cpuMask;
+    return VOS_INIT_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Lock all current and future pages of the process into memory.
+ *  Not supported on this target.
+ *
+ *  @retval         VOS_INIT_ERR    not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_threadLockMemory (
+    void)
+{
+    return VOS_INIT_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Touch the next size bytes of the calling thread's stack.
+ *  Not supported on this target.
+ *
+ *  @param[in]      size            Number of bytes to pre-fault
+ *  @retval         VOS_INIT_ERR    not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_threadPrefaultStack (
+    UINT32 size)
+{
+    (void) size;
+    return VOS_INIT_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Terminate a thread.
  *  This call will terminate the thread with the given threadId and release all resources. Depending on the
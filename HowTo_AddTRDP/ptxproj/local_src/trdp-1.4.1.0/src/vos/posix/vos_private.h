@@ -47,6 +47,8 @@ extern "C" {
 #define VOS_EVOLUTION          0u
 #endif
 
+#define VOS_SHARED_KEY_LEN     256u    /**< max. length of a shared memory key including '\0' */
+
 struct VOS_MUTEX
 {
     UINT32          magicNo;
@@ -57,6 +59,10 @@ struct VOS_SHRD
 {
     INT32   fd;                     /* File descriptor */
     CHAR8   *sharedMemoryName;      /* shared memory Name */
+    UINT32  size;                   /* mapped size */
+    BOOL8   hugePage;               /* TRUE: area is a file in the hugetlbfs mount */
+    BOOL8   created;                /* TRUE: area created by this handle, removed on close */
+    CHAR8   key[VOS_SHARED_KEY_LEN];    /* storage of sharedMemoryName */
 };
 
 VOS_ERR_T   vos_mutexLocalCreate (struct VOS_MUTEX *pMutex);
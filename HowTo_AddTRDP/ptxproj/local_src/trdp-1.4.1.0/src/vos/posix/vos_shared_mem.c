@@ -16,6 +16,7 @@
  *
  * $Id: vos_shared_mem.c 1740 2018-06-20 16:03:12Z bloehr $
  *
+ *      AG 2026-10-19: An existing area is attached without clearing it, only the creator removes the area
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
  *      BL 2018-05-03: Ticket #193 Unused parameter warnings
  *      BL 2016-07-06: Ticket #122 64Bit compatibility (+ compiler warnings)
@@ -43,6 +44,10 @@
 #include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
+#ifdef __linux
+#include <sys/vfs.h>
+#include <linux/magic.h>
+#endif
 
 #include "vos_types.h"
 #include "vos_mem.h"
@@ -54,11 +59,97 @@
  * DEFINITIONS
  */
 
+/* hugetlbfs mount for shared memory areas of at least one huge page (Linux), can be predefined as CFLAG */
+#ifndef VOS_SHARED_HUGEPAGE_DIR
+#define VOS_SHARED_HUGEPAGE_DIR     "/dev/hugepages"
+#endif
+
+#define VOS_SHARED_PATH_LEN         256u
 
 /***********************************************************************************************************************
  *  LOCALS
  */
 
+#ifdef __linux
+/**********************************************************************************************************************/
+/** Get the file of a shared memory area in the hugetlbfs mount.
+ *
+ *  @param[in]      pKey               Unique identifier (file name)
+ *  @param[out]     pPath              Path of the file
+ *  @retval         TRUE               path complete
+ */
+static BOOL8 vos_sharedHugePagePath (
+    const CHAR8 *pKey,
+    CHAR8       *pPath)
+{
+    int len;
+
+    if (pKey == NULL)
+    {
+        return FALSE;
+    }
+    len = snprintf(pPath, VOS_SHARED_PATH_LEN, "%s/%s", VOS_SHARED_HUGEPAGE_DIR, (pKey[0] == '/') ? pKey + 1 : pKey);
+    return ((len > 0) && ((UINT32) len < VOS_SHARED_PATH_LEN)) ? TRUE : FALSE;
+}
+
+/**********************************************************************************************************************/
+/** Create or attach a shared memory area backed by huge pages.
+ *  Used when a hugetlbfs is mounted at VOS_SHARED_HUGEPAGE_DIR and the area fills at least one huge page.
+ *
+ *  @param[in]      pKey               Unique identifier (file name)
+ *  @param[in,out]  pSize              Size of the area, on return rounded up to whole huge pages
+ *  @param[out]     pCreated           TRUE if the file was created by this call
+ *  @retval         file descriptor or -1 to use normal pages
+ */
+static INT32 vos_sharedOpenHugePage (
+    const CHAR8 *pKey,
+    UINT32      *pSize,
+    BOOL8       *pCreated)
+{
+    struct statfs   fsStat;
+    CHAR8           path[VOS_SHARED_PATH_LEN];
+    UINT64          size;
+    INT32           fd;
+
+    if ((statfs(VOS_SHARED_HUGEPAGE_DIR, &fsStat) != 0)
+        || (fsStat.f_type != HUGETLBFS_MAGIC)
+        || (fsStat.f_bsize <= 0)
+        || ((UINT64) *pSize < (UINT64) fsStat.f_bsize)
+        || (vos_sharedHugePagePath(pKey, path) == FALSE))
+    {
+        return -1;
+    }
+    size = ((UINT64) *pSize + (UINT64) fsStat.f_bsize - 1u) / (UINT64) fsStat.f_bsize * (UINT64) fsStat.f_bsize;
+    if (size > 0xFFFFFFFFu)
+    {
+        return -1;
+    }
+
+    *pCreated   = TRUE;
+    fd          = open(path, O_CREAT | O_EXCL | O_RDWR, 0666);
+    if ((fd == -1) && (errno == EEXIST))
+    {
+        *pCreated   = FALSE;
+        fd          = open(path, O_RDWR);
+    }
+    if (fd == -1)
+    {
+        return -1;
+    }
+    if (ftruncate(fd, (off_t) size) == -1)
+    {
+        (void) close(fd);
+        if (*pCreated == TRUE)
+        {
+            (void) unlink(path);
+        }
+        return -1;
+    }
+    *pSize = (UINT32) size;
+    return fd;
+}
+#endif
+
 
 /***********************************************************************************************************************
  * GLOBAL FUNCTIONS
@@ -73,7 +164,9 @@
 /**********************************************************************************************************************/
 /** Create a shared memory area or attach to existing one.
  *  The first call with the a specified key will create a shared memory area with the supplied size and will return
- *  a handle and a pointer to that area. If the area already exists, the area will be attached.
+ *  a handle and a pointer to that area. If the area already exists, the area will be attached, its content is
+ *  kept and its size is returned (it is enlarged if smaller than requested). *pSize = 0 attaches an existing
+ *  area only.
  *    This function is not available in each target implementation.
  *
  *  @param[in]      pKey               Unique identifier (file name)
@@ -93,37 +186,101 @@ EXT_DECL VOS_ERR_T vos_sharedOpen (
     mode_t          PERMISSION  = 0666;      /* Shared Memory permission is rw-rw-rw- */
     static INT32    fd;                      /* Shared Memory file descriptor */
     struct    stat  sharedMemoryStat;        /* Shared Memory Stat */
+    BOOL8           hugePage    = FALSE;     /* area in hugetlbfs */
+    BOOL8           created     = FALSE;     /* area created by this call */
 
-    /* Shared Memory Open */
-    fd = shm_open(pKey, O_CREAT | O_RDWR, PERMISSION);
-    if (fd == -1)
+    if ((pKey == NULL) || (pHandle == NULL) || (ppMemoryArea == NULL) || (pSize == NULL)
+        || (strlen(pKey) >= VOS_SHARED_KEY_LEN))
     {
-        vos_printLogStr(VOS_LOG_ERROR, "Shared Memory Create failed\n");
-        return ret;
+        return VOS_PARAM_ERR;
     }
-    /* Shared Memory acquire */
-    if (ftruncate(fd, (off_t )*pSize) == -1)
+
+#ifdef __linux
     {
-        vos_printLogStr(VOS_LOG_ERROR, "Shared Memory Acquire failed\n");
-        return ret;
+        UINT32  hugePageSize    = *pSize;
+        CHAR8   path[VOS_SHARED_PATH_LEN];
+
+        /* Large areas on huge pages, if a hugetlbfs is mounted */
+        fd = vos_sharedOpenHugePage(pKey, &hugePageSize, &created);
+        if (fd != -1)
+        {
+            *ppMemoryArea = (UINT8 *) mmap(NULL, (size_t) hugePageSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+            if (*ppMemoryArea != MAP_FAILED)
+            {
+                *pSize      = hugePageSize;
+                hugePage    = TRUE;
+            }
+            else
+            {
+                /* Huge page pool exhausted: normal pages */
+                vos_printLog(VOS_LOG_WARNING, "Shared Memory %s: no huge pages, using normal pages\n", pKey);
+                (void) close(fd);
+                if ((created == TRUE) && (vos_sharedHugePagePath(pKey, path) == TRUE))
+                {
+                    (void) unlink(path);
+                }
+            }
+        }
     }
-    /* Get Shared Memory Stats */
-    (void) fstat(fd, &sharedMemoryStat);
-    if (sharedMemoryStat.st_size != (off_t )*pSize)
+#endif
+
+    if (hugePage == FALSE)
     {
-        vos_printLogStr(VOS_LOG_ERROR, "Shared Memory Size failed\n");
-        return ret;
-    }
+        /* Shared Memory Open, an existing area is attached */
+        created = TRUE;
+        fd      = shm_open(pKey, O_CREAT | O_EXCL | O_RDWR, PERMISSION);
+        if ((fd == -1) && (errno == EEXIST))
+        {
+            created = FALSE;
+            fd      = shm_open(pKey, O_RDWR, PERMISSION);
+        }
+        if (fd == -1)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "Shared Memory Create failed\n");
+            return ret;
+        }
+        if ((created == TRUE) && (*pSize == 0u))
+        {
+            /* Attach only, but there is no area */
+            (void) close(fd);
+            (void) shm_unlink(pKey);
+            return ret;
+        }
+        /* Shared Memory acquire, an attached area keeps its size unless it is too small */
+        (void) fstat(fd, &sharedMemoryStat);
+        if ((created == FALSE) && (sharedMemoryStat.st_size >= (off_t) *pSize))
+        {
+            *pSize = (UINT32) sharedMemoryStat.st_size;
+        }
+        else if (ftruncate(fd, (off_t )*pSize) == -1)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "Shared Memory Acquire failed\n");
+            (void) close(fd);
+            if (created == TRUE)
+            {
+                (void) shm_unlink(pKey);
+            }
+            return ret;
+        }
 
-    /* Mapping Shared Memory */
-    *ppMemoryArea = (UINT8*) mmap(NULL, (size_t) sharedMemoryStat.st_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
-    if (*ppMemoryArea == MAP_FAILED)
+        /* Mapping Shared Memory */
+        *ppMemoryArea = (UINT8 *) mmap(NULL, (size_t) *pSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (*ppMemoryArea == MAP_FAILED)
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "Shared Memory memory-mapping failed\n");
+            (void) close(fd);
+            if (created == TRUE)
+            {
+                (void) shm_unlink(pKey);
+            }
+            return ret;
+        }
+    }
+    /* Initialize Shared Memory, other users of an attached area keep their data */
+    if (created == TRUE)
     {
-        vos_printLogStr(VOS_LOG_ERROR, "Shared Memory memory-mapping failed\n");
-        return ret;
+        memset(*ppMemoryArea, 0, *pSize);
     }
-    /* Initialize Shared Memory */
-    memset(*ppMemoryArea, 0, sharedMemoryStat.st_size);
     /* Handle */
     *pHandle = (VOS_SHRD_T) vos_memAlloc(sizeof (struct VOS_SHRD));
     if (*pHandle == NULL)
@@ -133,7 +290,12 @@ EXT_DECL VOS_ERR_T vos_sharedOpen (
     }
     else
     {
-        (*pHandle)->fd = fd;
+        (*pHandle)->fd          = fd;
+        (*pHandle)->size        = *pSize;
+        (*pHandle)->hugePage    = hugePage;
+        (*pHandle)->created     = created;
+        vos_strncpy((*pHandle)->key, pKey, VOS_SHARED_KEY_LEN - 1u);
+        (*pHandle)->sharedMemoryName = (*pHandle)->key;
     }
 
     ret = VOS_NO_ERR;
@@ -156,17 +318,42 @@ EXT_DECL VOS_ERR_T vos_sharedClose (
     VOS_SHRD_T  handle,
     const UINT8 *pMemoryArea)
 {
-    pMemoryArea = pMemoryArea;
+    VOS_ERR_T ret = VOS_NO_ERR;
 
+    if (handle == NULL)
+    {
+        return VOS_PARAM_ERR;
+    }
+    if ((pMemoryArea != NULL) && (handle->size != 0u))
+    {
+        (void) munmap((void *) pMemoryArea, (size_t) handle->size);
+    }
     if (close(handle->fd) == -1)
     {
         vos_printLogStr(VOS_LOG_ERROR, "Shared Memory file close failed\n");
-        return VOS_MEM_ERR;
+        ret = VOS_MEM_ERR;
     }
-    if (shm_unlink(handle->sharedMemoryName) == -1)
+    else if (handle->created == FALSE)
+    {
+        ;   /* detached only */
+    }
+#ifdef __linux
+    else if (handle->hugePage == TRUE)
+    {
+        CHAR8 path[VOS_SHARED_PATH_LEN];
+
+        if ((vos_sharedHugePagePath(handle->sharedMemoryName, path) == FALSE) || (unlink(path) == -1))
+        {
+            vos_printLogStr(VOS_LOG_ERROR, "Shared Memory unLink failed\n");
+            ret = VOS_MEM_ERR;
+        }
+    }
+#endif
+    else if (shm_unlink(handle->sharedMemoryName) == -1)
     {
         vos_printLogStr(VOS_LOG_ERROR, "Shared Memory unLink failed\n");
-        return VOS_MEM_ERR;
+        ret = VOS_MEM_ERR;
     }
-    return VOS_NO_ERR;
+    vos_memFree(handle);
+    return ret;
 }
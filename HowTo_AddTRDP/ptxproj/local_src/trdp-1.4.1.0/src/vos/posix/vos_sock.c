@@ -16,6 +16,9 @@
  *
  * $Id: vos_sock.c 1749 2018-07-19 16:38:21Z bloehr $
  *
+ *      AG 2026-10-19: vos_sockJoinSourceMC: a membership already held is no error (as for vos_sockJoinMC)
+ *      AG 2026-10-18: vos_sockSetFilter/vos_sockGetDrops (classic BPF socket filter, kernel drop count)
+ *      AG 2026-10-18: vos_sockJoinSourceMC/vos_sockLeaveSourceMC (source specific multicast)
  *      BL 2018-07-13: Ticket #208: VOS socket options: QoS/ToS field priority handling needs update
  *      BL 2018-06-20: Ticket #184: Building with VS 2015: WIN64 and Windows threads (SOCKET instead of INT32)
  *      BL 2018-05-03: Ticket #194: Platform independent format specifiers in vos_printLog
@@ -48,12 +51,12 @@
 #include <sys/socket.h>
 #include <sys/ioctl.h>
 
-#ifdef INTEGRITY
-#   include <sys/uio.h>
-#endif
+#include <sys/uio.h>
 
 #ifdef __linux
 #   include <linux/if.h>
+#   include <linux/filter.h>
+#   include <linux/sock_diag.h>
 #   include <byteswap.h>
 #else
 #   include <net/if.h>
@@ -67,6 +70,7 @@
 
 #include "vos_utils.h"
 #include "vos_sock.h"
+#include "vos_mem.h"
 #include "vos_thread.h"
 #include "vos_private.h"
 
@@ -1048,6 +1052,339 @@ EXT_DECL VOS_ERR_T vos_sockLeaveMC (
     return result;
 }
 
+/**********************************************************************************************************************/
+/** Add or drop a source specific multicast membership.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      mcAddress       multicast group
+ *  @param[in]      srcAddress      source to receive the group from
+ *  @param[in]      ipAddress       depicts interface, default 0 for any
+ *  @param[in]      join            TRUE to add, FALSE to drop the membership
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_SOCK_ERR    option not supported
+ */
+static VOS_ERR_T vos_sockSourceMC (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  srcAddress,
+    UINT32  ipAddress,
+    BOOL8   join)
+{
+#ifdef IP_ADD_SOURCE_MEMBERSHIP
+    struct ip_mreq_source   mreq;
+    VOS_ERR_T               result  = VOS_NO_ERR;
+    const char              *optName = (join == TRUE) ? "IP_ADD_SOURCE_MEMBERSHIP" : "IP_DROP_SOURCE_MEMBERSHIP";
+
+    if (sock == -1)
+    {
+        result = VOS_PARAM_ERR;
+    }
+    /* Is this a multicast address and a unicast source? */
+    else if (IN_MULTICAST(mcAddress) && (srcAddress != 0u) && !IN_MULTICAST(srcAddress))
+    {
+        memset(&mreq, 0, sizeof(mreq));
+        mreq.imr_multiaddr.s_addr   = vos_htonl(mcAddress);
+        mreq.imr_sourceaddr.s_addr  = vos_htonl(srcAddress);
+        mreq.imr_interface.s_addr   = vos_htonl(ipAddress);
+
+        {
+            char    mcStr[16];
+            char    srcStr[16];
+
+            strncpy(mcStr, inet_ntoa(mreq.imr_multiaddr), sizeof(mcStr));
+            mcStr[sizeof(mcStr) - 1] = 0;
+            strncpy(srcStr, inet_ntoa(mreq.imr_sourceaddr), sizeof(srcStr));
+            srcStr[sizeof(srcStr) - 1] = 0;
+
+            vos_printLog(VOS_LOG_INFO, "%s MC: %s from source %s\n", (join == TRUE) ? "joining" : "leaving",
+                         mcStr, srcStr);
+        }
+
+        if ((setsockopt(sock, IPPROTO_IP, (join == TRUE) ? IP_ADD_SOURCE_MEMBERSHIP : IP_DROP_SOURCE_MEMBERSHIP,
+                        &mreq, sizeof(mreq)) == -1) &&
+            !((join == TRUE) && (errno == EADDRINUSE)))
+        {
+            char buff[VOS_MAX_ERR_STR_SIZE];
+            STRING_ERR(buff);
+            vos_printLog(VOS_LOG_ERROR, "setsockopt() %s failed (Err: %s)\n", optName, buff);
+            result = VOS_SOCK_ERR;
+        }
+    }
+    else
+    {
+        result = VOS_PARAM_ERR;
+    }
+
+    return result;
+#else
+    (void) sock;
+    (void) mcAddress;
+    (void) srcAddress;
+    (void) ipAddress;
+    (void) join;
+    vos_printLogStr(VOS_LOG_ERROR, "source specific multicast not supported\n");
+    return VOS_SOCK_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Join a multicast group for a single source (source specific multicast).
+ *  Datagrams of the group sent by other sources are dropped by the network stack.
+ *  Note: Some targeted systems might not support this option.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      mcAddress       multicast group to join
+ *  @param[in]      srcAddress      source to receive the group from
+ *  @param[in]      ipAddress       depicts interface on which to join, default 0 for any
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_SOCK_ERR    option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockJoinSourceMC (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  srcAddress,
+    UINT32  ipAddress)
+{
+    return vos_sockSourceMC(sock, mcAddress, srcAddress, ipAddress, TRUE);
+}
+
+/**********************************************************************************************************************/
+/** Leave a source specific multicast membership.
+ *  Note: Some targeted systems might not support this option.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      mcAddress       multicast group to leave
+ *  @param[in]      srcAddress      source the group was joined for
+ *  @param[in]      ipAddress       depicts interface on which to leave, default 0 for any
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_SOCK_ERR    option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockLeaveSourceMC (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  srcAddress,
+    UINT32  ipAddress)
+{
+    return vos_sockSourceMC(sock, mcAddress, srcAddress, ipAddress, FALSE);
+}
+
+#if defined(SO_ATTACH_FILTER) && defined(BPF_MAXINSNS)
+
+#define VOS_FILTER_LEAF_SIZE    4u              /**< values compared in a row at the leaves of the search tree */
+#define VOS_FILTER_UDP_HDR_SIZE 8u              /**< the filter of a UDP socket sees the UDP header            */
+#define VOS_FILTER_ACCEPT       0xFFFFFFFFu     /**< keep the whole datagram                                   */
+#define VOS_FILTER_DROP         0u
+
+/**********************************************************************************************************************/
+/** Compute the number of filter instructions needed to search the values.
+ *
+ *  @param[in]      noOfValues      number of values to search
+ *
+ *  @retval         number of instructions
+ */
+static UINT32 vos_sockFilterSize (
+    UINT32 noOfValues)
+{
+    UINT32 left = (noOfValues + 1u) / 2u;
+
+    if (noOfValues <= VOS_FILTER_LEAF_SIZE)
+    {
+        return 2u * noOfValues + 1u;
+    }
+    return 2u + vos_sockFilterSize(left) + vos_sockFilterSize(noOfValues - left);
+}
+
+/**********************************************************************************************************************/
+/** Generate the binary search over the sorted values.
+ *  Inner nodes jump to the upper half if the loaded word is greater than the last value of the lower half,
+ *  the leaves compare the remaining values one by one.
+ *
+ *  @param[out]     pCode           instruction buffer
+ *  @param[in]      pc              index of the first instruction to generate
+ *  @param[in]      pValues         sorted values
+ *  @param[in]      noOfValues      number of values
+ *
+ *  @retval         index of the instruction following the generated code
+ */
+static UINT32 vos_sockFilterGen (
+    struct sock_filter  *pCode,
+    UINT32              pc,
+    const UINT32        *pValues,
+    UINT32              noOfValues)
+{
+    UINT32  i;
+    UINT32  left = (noOfValues + 1u) / 2u;
+    UINT32  jumpPc;
+
+    if (noOfValues <= VOS_FILTER_LEAF_SIZE)
+    {
+        for (i = 0u; i < noOfValues; i++)
+        {
+            struct sock_filter cmp = BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, pValues[i], 0u, 1u);
+            struct sock_filter acc = BPF_STMT(BPF_RET | BPF_K, VOS_FILTER_ACCEPT);
+            pCode[pc++] = cmp;
+            pCode[pc++] = acc;
+        }
+        {
+            struct sock_filter drop = BPF_STMT(BPF_RET | BPF_K, VOS_FILTER_DROP);
+            pCode[pc++] = drop;
+        }
+        return pc;
+    }
+
+    {
+        /* greater than the lower half: take the unconditional (long) jump to the upper half */
+        struct sock_filter cmp = BPF_JUMP(BPF_JMP | BPF_JGT | BPF_K, pValues[left - 1u], 0u, 1u);
+        pCode[pc++] = cmp;
+    }
+    jumpPc  = pc++;
+    pc      = vos_sockFilterGen(pCode, pc, pValues, left);
+    {
+        struct sock_filter jump = BPF_STMT(BPF_JMP | BPF_JA, pc - jumpPc - 1u);
+        pCode[jumpPc] = jump;
+    }
+    return vos_sockFilterGen(pCode, pc, &pValues[left], noOfValues - left);
+}
+#endif
+
+/**********************************************************************************************************************/
+/** Filter received datagrams in the kernel.
+ *  Attaches a socket filter to a UDP socket which passes only datagrams carrying one of the given values
+ *  as 32 bit word in network byte order at the given offset of the payload. Shorter datagrams are dropped.
+ *  An already attached filter is replaced, with no values the filter is removed.
+ *  Note: Some targeted systems might not support this option.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      offset          offset of the 32 bit word in the UDP payload
+ *  @param[in]      pValues         values to pass (host byte order), sorted ascending
+ *  @param[in]      noOfValues      number of values, 0 to remove the filter
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error, too many values
+ *  @retval         VOS_MEM_ERR     out of memory
+ *  @retval         VOS_SOCK_ERR    option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetFilter (
+    SOCKET          sock,
+    UINT32          offset,
+    const UINT32    *pValues,
+    UINT32          noOfValues)
+{
+#if defined(SO_ATTACH_FILTER) && defined(BPF_MAXINSNS)
+    struct sock_fprog   prog;
+    struct sock_filter  *pCode;
+    UINT32              size;
+    VOS_ERR_T           result = VOS_NO_ERR;
+
+    if ((sock == -1) || ((pValues == NULL) && (noOfValues != 0u)))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    if (noOfValues == 0u)
+    {
+        if ((setsockopt(sock, SOL_SOCKET, SO_DETACH_FILTER, NULL, 0) == -1) && (errno != ENOENT))
+        {
+            char buff[VOS_MAX_ERR_STR_SIZE];
+            STRING_ERR(buff);
+            vos_printLog(VOS_LOG_ERROR, "setsockopt() SO_DETACH_FILTER failed (Err: %s)\n", buff);
+            return VOS_SOCK_ERR;
+        }
+        return VOS_NO_ERR;
+    }
+
+    /*  Load the word, then search it   */
+    size = 1u + vos_sockFilterSize(noOfValues);
+    if (size > BPF_MAXINSNS)
+    {
+        vos_printLog(VOS_LOG_WARNING, "socket filter for %u values too large\n", (unsigned int) noOfValues);
+        return VOS_PARAM_ERR;
+    }
+
+    pCode = (struct sock_filter *) vos_memAlloc(size * sizeof(struct sock_filter));
+    if (pCode == NULL)
+    {
+        return VOS_MEM_ERR;
+    }
+
+    {
+        struct sock_filter load = BPF_STMT(BPF_LD | BPF_W | BPF_ABS, VOS_FILTER_UDP_HDR_SIZE + offset);
+        pCode[0] = load;
+    }
+    (void) vos_sockFilterGen(pCode, 1u, pValues, noOfValues);
+
+    prog.len    = (unsigned short) size;
+    prog.filter = pCode;
+
+    if (setsockopt(sock, SOL_SOCKET, SO_ATTACH_FILTER, &prog, sizeof(prog)) == -1)
+    {
+        char buff[VOS_MAX_ERR_STR_SIZE];
+        STRING_ERR(buff);
+        vos_printLog(VOS_LOG_ERROR, "setsockopt() SO_ATTACH_FILTER failed (Err: %s)\n", buff);
+        result = VOS_SOCK_ERR;
+    }
+
+    vos_memFree(pCode);
+    return result;
+#else
+    (void) sock;
+    (void) offset;
+    (void) pValues;
+    (void) noOfValues;
+    return VOS_SOCK_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Get the number of datagrams the kernel dropped for a socket.
+ *  Counts the datagrams rejected by the socket filter or not fitting into the receive buffer since the socket
+ *  was opened.
+ *  Note: Some targeted systems might not support this option.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pDrops          number of dropped datagrams
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_SOCK_ERR    option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockGetDrops (
+    SOCKET  sock,
+    UINT32  *pDrops)
+{
+#if defined(SO_MEMINFO) && defined(__linux)
+    UINT32      memInfo[SK_MEMINFO_VARS];
+    socklen_t   len = sizeof(memInfo);
+
+    if ((sock == -1) || (pDrops == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    if ((getsockopt(sock, SOL_SOCKET, SO_MEMINFO, memInfo, &len) == -1) ||
+        (len <= SK_MEMINFO_DROPS * sizeof(UINT32)))
+    {
+        return VOS_SOCK_ERR;
+    }
+    *pDrops = memInfo[SK_MEMINFO_DROPS];
+    return VOS_NO_ERR;
+#else
+    (void) sock;
+    (void) pDrops;
+    return VOS_SOCK_ERR;
+#endif
+}
+
 /**********************************************************************************************************************/
 /** Send UDP data.
  *  Send data to the supplied address and port.
@@ -1551,6 +1888,100 @@ EXT_DECL VOS_ERR_T vos_sockSendTCP (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Send TCP data from several buffers (gather write).
+ *  The buffers are sent in the given order as one contiguous byte stream using writev(), without copying them into
+ *  a common buffer first.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pIoVec          array of buffer descriptors
+ *  @param[in]      ioVecCnt        number of buffer descriptors (max. VOS_MAX_IOVEC_CNT)
+ *  @param[out]     pSize           no of bytes sent
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be sent
+ *  @retval         VOS_NOCONN_ERR  no TCP connection
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode, data partially sent
+ */
+EXT_DECL VOS_ERR_T vos_sockSendTCPv (
+    SOCKET              sock,
+    const VOS_IOVEC_T   *pIoVec,
+    UINT32              ioVecCnt,
+    UINT32              *pSize)
+{
+    struct iovec    iov[VOS_MAX_IOVEC_CNT];
+    struct iovec    *pIov       = iov;
+    int             iovCnt      = 0;
+    ssize_t         sendSize    = 0;
+    UINT32          i;
+
+    if (sock == -1 || pIoVec == NULL || pSize == NULL || ioVecCnt > VOS_MAX_IOVEC_CNT)
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    *pSize = 0;
+
+    /* Skip empty buffers, writev() does not like them on every platform */
+    for (i = 0; i < ioVecCnt; i++)
+    {
+        if ((pIoVec[i].pBuffer != NULL) && (pIoVec[i].size > 0))
+        {
+            iov[iovCnt].iov_base    = (void *) pIoVec[i].pBuffer;
+            iov[iovCnt].iov_len     = (size_t) pIoVec[i].size;
+            iovCnt++;
+        }
+    }
+
+    /* Keep on sending until we got rid of all data or we received an unrecoverable error */
+    while (iovCnt > 0)
+    {
+        sendSize = writev(sock, pIov, iovCnt);
+        if (sendSize >= 0)
+        {
+            size_t sent = (size_t) sendSize;
+
+            *pSize += (UINT32) sendSize;
+
+            /* Advance over the completely sent buffers, adjust a partially sent one */
+            while ((iovCnt > 0) && (sent >= pIov->iov_len))
+            {
+                sent -= pIov->iov_len;
+                pIov++;
+                iovCnt--;
+            }
+            if (iovCnt > 0)
+            {
+                pIov->iov_base  = (UINT8 *) pIov->iov_base + sent;
+                pIov->iov_len   -= sent;
+            }
+        }
+        else if (errno == EWOULDBLOCK)
+        {
+            return VOS_BLOCK_ERR;
+        }
+        else if (errno != EINTR)
+        {
+            char buff[VOS_MAX_ERR_STR_SIZE];
+            STRING_ERR(buff);
+            vos_printLog(VOS_LOG_WARNING, "writev() failed (Err: %s)\n", buff);
+
+            if ((errno == ENOTCONN)
+                || (errno == ECONNREFUSED)
+                || (errno == EHOSTUNREACH))
+            {
+                return VOS_NOCONN_ERR;
+            }
+            else
+            {
+                return VOS_IO_ERR;
+            }
+        }
+    }
+    return VOS_NO_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Receive TCP data.
  *  The caller must provide a sufficient sized buffer. If the supplied buffer is smaller than the bytes received, *pSize
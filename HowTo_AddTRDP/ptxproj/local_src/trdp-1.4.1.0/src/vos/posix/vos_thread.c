@@ -16,6 +16,8 @@
  *
  * $Id: vos_thread.c 1749 2018-07-19 16:38:21Z bloehr $
  *
+ *      AG 2026-10-19: Stack pre-fault iterative and limited to the caller's stack, attributes destroyed on errors
+ *      AG 2026-10-18: vos_threadCreateEx: CPU affinity, isolated cores, mlockall, stack pre-faulting, priority range
  *      BL 2018-06-25: Ticket #202: vos_mutexTrylock return value
  *      BL 2018-05-03: Ticket #194: Platform independent format specifiers in vos_printLog
  *      BL 2018-04-18: Ticket #195: Invalid thread handle (SEGFAULT)
@@ -43,6 +45,9 @@
 #include <pthread.h>
 #include <semaphore.h>
 #include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <alloca.h>
 
 #ifdef __APPLE__
 #include <uuid/uuid.h>
@@ -69,6 +74,16 @@ const UINT32    cMutextMagic        = 0x1234FEDCu;
 
 int             vosThreadInitialised = FALSE;
 
+#define VOS_STACK_RESERVE   8192u       /* Stack left untouched by the pre-fault */
+
+/* Start parameters of threads needing work done in their own context before the thread function runs */
+typedef struct
+{
+    VOS_THREAD_FUNC_T   pFunction;
+    void                *pArguments;
+    UINT32              stackPrefault;
+} VOS_THREAD_START_T;
+
 /***********************************************************************************************************************
  *  LOCALS
  */
@@ -123,6 +138,106 @@ int sem_init (sem_t *pSema, int flags, unsigned int mode)
 #endif
 
 
+/**********************************************************************************************************************/
+/** Touch a stack region of the given size, one write per page.
+ *  The region is allocated in this frame and released on return; the writes go through a volatile pointer, so the
+ *  compiler cannot drop them.
+ *
+ *  @param[in]      size            Bytes to touch
+ */
+static void vos_prefaultRegion (
+    size_t size)
+{
+    volatile UINT8  *pRegion    = (volatile UINT8 *) alloca(size);
+    size_t          pageSize    = (size_t) getpagesize();
+    size_t          offset;
+
+    /* from the current frame downwards, in the direction the stack grows */
+    for (offset = size; offset > pageSize; offset -= pageSize)
+    {
+        pRegion[offset - 1u] = 0u;
+    }
+    pRegion[0] = 0u;
+}
+
+/**********************************************************************************************************************/
+/** Bytes of stack left below the caller's frame.
+ *
+ *  @retval         bytes left, 0 if unknown
+ */
+static size_t vos_stackLeft (
+    void)
+{
+    size_t      left = 0u;
+    UINT8       marker;
+#ifdef __linux__
+    pthread_attr_t  attr;
+    void            *pStackLow;
+    size_t          stackSize;
+
+    if (pthread_getattr_np(pthread_self(), &attr) == 0)
+    {
+        if ((pthread_attr_getstack(&attr, &pStackLow, &stackSize) == 0)
+            && ((UINT8 *) pStackLow < &marker))
+        {
+            left = (size_t) (&marker - (UINT8 *) pStackLow);
+        }
+        (void) pthread_attr_destroy(&attr);
+    }
+#else
+    struct rlimit   limit;
+
+    /* the depth already used is unknown here, the limit is the best bound available */
+    if ((getrlimit(RLIMIT_STACK, &limit) == 0) && (limit.rlim_cur != RLIM_INFINITY))
+    {
+        left = (size_t) limit.rlim_cur;
+    }
+    (void) marker;
+#endif
+    return left;
+}
+
+/**********************************************************************************************************************/
+/** Thread entry for threads with real-time options.
+ *
+ *  @param[in]      pArg            Pointer to VOS_THREAD_START_T, freed here
+ *  @retval         NULL
+ */
+static void *vos_threadStart (
+    void *pArg)
+{
+    VOS_THREAD_START_T start = *(VOS_THREAD_START_T *) pArg;
+
+    vos_memFree(pArg);
+    (void) vos_threadPrefaultStack(start.stackPrefault);
+    start.pFunction(start.pArguments);
+    return NULL;
+}
+
+#ifdef __linux__
+/**********************************************************************************************************************/
+/** Convert a CPU bit mask into a cpu_set_t.
+ *
+ *  @param[in]      cpuMask         Cores (bit 0 = CPU 0)
+ *  @param[out]     pSet            CPU set
+ */
+static void vos_maskToCpuSet (
+    UINT64      cpuMask,
+    cpu_set_t   *pSet)
+{
+    UINT32 cpu;
+
+    CPU_ZERO(pSet);
+    for (cpu = 0u; cpu < 64u; cpu++)
+    {
+        if ((cpuMask & ((UINT64) 1u << cpu)) != 0u)
+        {
+            CPU_SET(cpu, pSet);
+        }
+    }
+}
+#endif
+
 /***********************************************************************************************************************
  * GLOBAL FUNCTIONS
  */
@@ -261,41 +376,35 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
     VOS_THREAD_FUNC_T       pFunction,
     void                    *pArguments)
 {
-    pthread_t           hThread;
-    pthread_attr_t      threadAttrib;
+    return vos_threadCreateEx(pThread, pName, policy, priority, interval, stackSize, NULL, pFunction, pArguments);
+}
+
+/**********************************************************************************************************************/
+/** Set up the attributes of a new thread.
+ *
+ *  @param[in,out]  pThreadAttrib   Initialised thread attributes
+ *  @param[in]      pName           Name of the thread
+ *  @param[in]      policy          Scheduling policy
+ *  @param[in]      priority        Scheduling priority
+ *  @param[in]      stackSize       Minimum stacksize, default 0
+ *  @param[in]      pOptions        Pointer to real-time options, NULL = none
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_INIT_ERR    option not supported
+ *  @retval         VOS_THREAD_ERR  attribute could not be set
+ */
+static VOS_ERR_T vos_threadSetAttributes (
+    pthread_attr_t              *pThreadAttrib,
+    const CHAR8                 *pName,
+    VOS_THREAD_POLICY_T         policy,
+    VOS_THREAD_PRIORITY_T       priority,
+    UINT32                      stackSize,
+    const VOS_THREAD_OPTIONS_T  *pOptions)
+{
     struct sched_param  schedParam;  /* scheduling priority */
     int         retCode;
-
-    if (!vosThreadInitialised)
-    {
-        return VOS_INIT_ERR;
-    }
-
-    if ((pThread == NULL) || (pName == NULL))
-    {
-        return VOS_PARAM_ERR;
-    }
-
-    *pThread = NULL;
-    
-    if (interval > 0u)
-    {
-        vos_printLog(VOS_LOG_ERROR,
-                     "%s cyclic threads not implemented yet\n",
-                     pName);
-        return VOS_INIT_ERR;
-    }
-
-    /* Initialize thread attributes to default values */
-    retCode = pthread_attr_init(&threadAttrib);
-    if (retCode != 0)
-    {
-        vos_printLog(VOS_LOG_ERROR,
-                     "%s pthread_attr_init() failed (Err:%d)\n",
-                     pName,
-                     (int)retCode );
-        return VOS_THREAD_ERR;
-    }
+    size_t      effStackSize;
+    int         prioMin;
+    int         prioMax;
 
     /* Set the stack size */
     if (stackSize > PTHREAD_STACK_MIN)
@@ -304,12 +413,13 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
         {
             stackSize = ((stackSize / (UINT32)getpagesize()) + 1u) * (UINT32)getpagesize();
         }
-        retCode = pthread_attr_setstacksize(&threadAttrib, (size_t) stackSize);
+        effStackSize = (size_t) stackSize;
     }
     else
     {
-        retCode = pthread_attr_setstacksize(&threadAttrib, cDefaultStackSize);
+        effStackSize = cDefaultStackSize;
     }
+    retCode = pthread_attr_setstacksize(pThreadAttrib, effStackSize);
 
     if (retCode != 0)
     {
@@ -322,7 +432,7 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
     }
 
     /* Detached thread */
-    retCode = pthread_attr_setdetachstate(&threadAttrib,
+    retCode = pthread_attr_setdetachstate(pThreadAttrib,
                                           PTHREAD_CREATE_DETACHED);
     if (retCode != 0)
     {
@@ -337,7 +447,7 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
     /* Set the policy of the thread */
     if (policy != VOS_THREAD_POLICY_OTHER)
     {
-        retCode = pthread_attr_setschedpolicy(&threadAttrib, (INT32)policy);
+        retCode = pthread_attr_setschedpolicy(pThreadAttrib, (INT32)policy);
         if (retCode != 0)
         {
             vos_printLog(
@@ -350,9 +460,23 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
         }
     }
 
-    /* Set the scheduling priority of the thread */
+    /* Set the scheduling priority of the thread, real-time priorities limited to what the target supports */
     schedParam.sched_priority = priority;
-    retCode = pthread_attr_setschedparam(&threadAttrib, &schedParam);
+    if ((policy == VOS_THREAD_POLICY_FIFO) || (policy == VOS_THREAD_POLICY_RR))
+    {
+        prioMin = sched_get_priority_min((int)policy);
+        prioMax = sched_get_priority_max((int)policy);
+        if ((prioMax >= 0) && (schedParam.sched_priority > prioMax))
+        {
+            vos_printLog(VOS_LOG_WARNING, "%s priority %d limited to %d\n", pName, (int)priority, prioMax);
+            schedParam.sched_priority = prioMax;
+        }
+        else if ((prioMin >= 0) && (schedParam.sched_priority < prioMin))
+        {
+            schedParam.sched_priority = prioMin;
+        }
+    }
+    retCode = pthread_attr_setschedparam(pThreadAttrib, &schedParam);
     if (retCode != 0)
     {
         vos_printLog(
@@ -365,7 +489,7 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
     }
 
     /* Set inheritsched attribute of the thread */
-    retCode = pthread_attr_setinheritsched(&threadAttrib,
+    retCode = pthread_attr_setinheritsched(pThreadAttrib,
                                            PTHREAD_EXPLICIT_SCHED);
     if (retCode != 0)
     {
@@ -377,20 +501,190 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
         return VOS_THREAD_ERR;
     }
 
-    /* Create the thread */
-    retCode = pthread_create(&hThread, &threadAttrib, (void *(*)(
-                                                           void *))pFunction,
-                             pArguments);
+    if (pOptions != NULL)
+    {
+        /* Pin the thread before it runs */
+        if (pOptions->cpuMask != 0u)
+        {
+#ifdef __linux__
+            cpu_set_t cpuSet;
+
+            vos_maskToCpuSet(pOptions->cpuMask, &cpuSet);
+            retCode = pthread_attr_setaffinity_np(pThreadAttrib, sizeof(cpuSet), &cpuSet);
+            if (retCode != 0)
+            {
+                vos_printLog(VOS_LOG_ERROR,
+                             "%s pthread_attr_setaffinity_np() failed (Err:%d)\n",
+                             pName,
+                             (int)retCode );
+                return VOS_THREAD_ERR;
+            }
+#else
+            vos_printLog(VOS_LOG_ERROR, "%s CPU affinity not supported\n", pName);
+            return VOS_INIT_ERR;
+#endif
+        }
+    }
+    return VOS_NO_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Create a thread with real-time options.
+ *  As vos_threadCreate(), the new thread can additionally be pinned to a set of cores, have its stack pre-faulted and
+ *  the process memory locked before it runs. Priorities of the FIFO and RR policies are limited to the range the
+ *  target supports.
+ *
+ *  @param[out]     pThread         Pointer to returned thread handle
+ *  @param[in]      pName           Pointer to name of the thread (optional)
+ *  @param[in]      policy          Scheduling policy (FIFO, Round Robin or other)
+ *  @param[in]      priority        Scheduling priority (1...255 (highest), default 0)
+ *  @param[in]      interval        Interval for cyclic threads in us (optional)
+ *  @param[in]      stackSize       Minimum stacksize, default 0: 16kB
+ *  @param[in]      pOptions        Pointer to real-time options, NULL = none
+ *  @param[in]      pFunction       Pointer to the thread function
+ *  @param[in]      pArguments      Pointer to the thread function parameters
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_INIT_ERR    module not initialised or option not supported
+ *  @retval         VOS_PARAM_ERR   parameter out of range/invalid
+ *  @retval         VOS_MEM_ERR     memory could not be locked
+ *  @retval         VOS_THREAD_ERR  thread creation error
+ */
+
+EXT_DECL VOS_ERR_T vos_threadCreateEx (
+    VOS_THREAD_T                *pThread,
+    const CHAR8                 *pName,
+    VOS_THREAD_POLICY_T         policy,
+    VOS_THREAD_PRIORITY_T       priority,
+    UINT32                      interval,
+    UINT32                      stackSize,
+    const VOS_THREAD_OPTIONS_T  *pOptions,
+    VOS_THREAD_FUNC_T           pFunction,
+    void                        *pArguments)
+{
+    pthread_t           hThread;
+    pthread_attr_t      threadAttrib;
+    int         retCode;
+    VOS_ERR_T   err;
+    VOS_THREAD_START_T  *pStart = NULL;
+
+    if (!vosThreadInitialised)
+    {
+        return VOS_INIT_ERR;
+    }
+
+    if ((pThread == NULL) || (pName == NULL))
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    *pThread = NULL;
+    
+    if (interval > 0u)
+    {
+        vos_printLog(VOS_LOG_ERROR,
+                     "%s cyclic threads not implemented yet\n",
+                     pName);
+        return VOS_INIT_ERR;
+    }
+
+    /* Initialize thread attributes to default values */
+    retCode = pthread_attr_init(&threadAttrib);
     if (retCode != 0)
     {
         vos_printLog(VOS_LOG_ERROR,
-                     "%s pthread_create() failed (Err:%d)\n",
+                     "%s pthread_attr_init() failed (Err:%d)\n",
                      pName,
                      (int)retCode );
         return VOS_THREAD_ERR;
     }
 
-    *pThread = (VOS_THREAD_T) hThread;
+    /* From here on every path leaves through pthread_attr_destroy() */
+    err = vos_threadSetAttributes(&threadAttrib, pName, policy, priority, stackSize, pOptions);
+
+    if ((err == VOS_NO_ERR) && (pOptions != NULL))
+    {
+        if ((pOptions->flags & VOS_THREAD_OPT_LOCK_MEMORY) != 0u)
+        {
+            if (vos_threadLockMemory() != VOS_NO_ERR)
+            {
+                err = VOS_MEM_ERR;
+            }
+        }
+
+        if ((err == VOS_NO_ERR) && (pOptions->stackPrefault != 0u))
+        {
+            pStart = (VOS_THREAD_START_T *) vos_memAlloc(sizeof(VOS_THREAD_START_T));
+            if (pStart == NULL)
+            {
+                err = VOS_MEM_ERR;
+            }
+            else
+            {
+                pStart->pFunction       = pFunction;
+                pStart->pArguments      = pArguments;
+                pStart->stackPrefault   = pOptions->stackPrefault;     /* limited by the thread itself */
+            }
+        }
+    }
+
+    /* Create the thread */
+    if (err == VOS_NO_ERR)
+    {
+        if (pStart != NULL)
+        {
+            retCode = pthread_create(&hThread, &threadAttrib, vos_threadStart, pStart);
+        }
+        else
+        {
+            retCode = pthread_create(&hThread, &threadAttrib, (void *(*)(
+                                                                   void *))pFunction,
+                                     pArguments);
+        }
+        if (retCode != 0)
+        {
+            vos_printLog(VOS_LOG_ERROR,
+                         "%s pthread_create() failed (Err:%d)\n",
+                         pName,
+                         (int)retCode );
+            if (pStart != NULL)
+            {
+                vos_memFree(pStart);
+            }
+            err = VOS_THREAD_ERR;
+        }
+        else
+        {
+            *pThread = (VOS_THREAD_T) hThread;
+        }
+    }
+
+    /* Keep everybody else off the reserved cores */
+    if ((err == VOS_NO_ERR)
+        && (pOptions != NULL)
+        && (pOptions->cpuMask != 0u)
+        && ((pOptions->flags & VOS_THREAD_OPT_ISOLATE) != 0u))
+    {
+#ifdef __linux__
+        cpu_set_t   ownSet;
+        cpu_set_t   rtSet;
+        cpu_set_t   restSet;
+
+        vos_maskToCpuSet(pOptions->cpuMask, &rtSet);
+        if (pthread_getaffinity_np(pthread_self(), sizeof(ownSet), &ownSet) == 0)
+        {
+            CPU_XOR(&restSet, &ownSet, &rtSet);
+            CPU_AND(&restSet, &restSet, &ownSet);
+            if (CPU_COUNT(&restSet) == 0)
+            {
+                vos_printLog(VOS_LOG_WARNING, "%s no core left to isolate from\n", pName);
+            }
+            else if (pthread_setaffinity_np(pthread_self(), sizeof(restSet), &restSet) != 0)
+            {
+                vos_printLog(VOS_LOG_WARNING, "%s could not isolate cores\n", pName);
+            }
+        }
+#endif
+    }
 
     /* Destroy thread attributes */
     retCode = pthread_attr_destroy(&threadAttrib);
@@ -401,7 +695,105 @@ EXT_DECL VOS_ERR_T vos_threadCreate (
             "%s pthread_attr_destroy() failed (Err:%d)\n",
             pName,
             (int)retCode );
-        return VOS_THREAD_ERR;
+        if (err == VOS_NO_ERR)
+        {
+            err = VOS_THREAD_ERR;
+        }
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Restrict a thread to a set of cores.
+ *  Used to pin threads not created by VOS, e.g. the main thread running tlc_process().
+ *
+ *  @param[in]      thread          Thread handle (or NULL for the calling thread)
+ *  @param[in]      cpuMask         Cores the thread may run on (bit 0 = CPU 0)
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_INIT_ERR    not supported
+ *  @retval         VOS_PARAM_ERR   empty or invalid mask
+ *  @retval         VOS_THREAD_ERR  affinity could not be set
+ */
+
+EXT_DECL VOS_ERR_T vos_threadSetAffinity (
+    VOS_THREAD_T    thread,
+    UINT64          cpuMask)
+{
+#ifdef __linux__
+    cpu_set_t   cpuSet;
+    int         retCode;
+
+    if (cpuMask == 0u)
+    {
+        return VOS_PARAM_ERR;
+    }
+    vos_maskToCpuSet(cpuMask, &cpuSet);
+    retCode = pthread_setaffinity_np((thread == NULL) ? pthread_self() : (pthread_t) thread,
+                                     sizeof(cpuSet), &cpuSet);
+    if (retCode != 0)
+    {
+        vos_printLog(VOS_LOG_ERROR, "pthread_setaffinity_np() failed (Err:%d)\n", (int)retCode);
+        return (retCode == EINVAL) ? VOS_PARAM_ERR : VOS_THREAD_ERR;
+    }
+    return VOS_NO_ERR;
+#else
+    (void) thread;
+    (void) cpuMask;
+    return VOS_INIT_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Lock all current and future pages of the process into memory.
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_INIT_ERR    not supported
+ *  @retval         VOS_MEM_ERR     locking failed (e.g. missing privileges or RLIMIT_MEMLOCK)
+ */
+
+EXT_DECL VOS_ERR_T vos_threadLockMemory (
+    void)
+{
+#if defined(MCL_CURRENT) && defined(MCL_FUTURE)
+    static BOOL8 locked = FALSE;
+
+    if (locked == TRUE)
+    {
+        return VOS_NO_ERR;
+    }
+    if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+    {
+        vos_printLog(VOS_LOG_ERROR, "mlockall() failed (Err:%d)\n", errno);
+        return VOS_MEM_ERR;
+    }
+    locked = TRUE;
+    return VOS_NO_ERR;
+#else
+    return VOS_INIT_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Touch the next size bytes of the calling thread's stack.
+ *  Avoids page faults on first use of the stack in the cyclic path. The size is limited to the stack left below the
+ *  caller's frame, minus a reserve for the frames still to come.
+ *
+ *  @param[in]      size            Number of bytes to pre-fault
+ *  @retval         VOS_NO_ERR      no error
+ */
+
+EXT_DECL VOS_ERR_T vos_threadPrefaultStack (
+    UINT32 size)
+{
+    size_t left = vos_stackLeft();
+
+    if ((size_t) size + VOS_STACK_RESERVE > left)
+    {
+        size = (left > VOS_STACK_RESERVE) ? (UINT32) (left - VOS_STACK_RESERVE) : 0u;
+    }
+    if (size != 0u)
+    {
+        vos_prefaultRegion((size_t) size);
     }
     return VOS_NO_ERR;
 }
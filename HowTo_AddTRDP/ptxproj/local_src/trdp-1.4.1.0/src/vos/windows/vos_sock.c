@@ -17,6 +17,8 @@
  *
  * $Id: vos_sock.c 1817 2018-11-29 16:17:22Z ahweiss $*
  *
+ *      AG 2026-10-18: vos_sockSetFilter/vos_sockGetDrops (not supported)
+ *      AG 2026-10-18: vos_sockJoinSourceMC/vos_sockLeaveSourceMC (source specific multicast)
  *      SB 2018-07-20: Ticket #209: vos_getInterfaces returning incorrect "name" and "linkState" on windows (requires
  *                                  at least windows vista now).
  *      BL 2018-07-13: Ticket #208: VOS socket options: QoS/ToS field priority handling needs update
@@ -1062,6 +1064,172 @@ EXT_DECL VOS_ERR_T vos_sockLeaveMC (
     return result;
 }
 
+/**********************************************************************************************************************/
+/** Add or drop a source specific multicast membership.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      mcAddress       multicast group
+ *  @param[in]      srcAddress      source to receive the group from
+ *  @param[in]      ipAddress       depicts interface, default 0 for any
+ *  @param[in]      join            TRUE to add, FALSE to drop the membership
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_SOCK_ERR    option not supported
+ */
+static VOS_ERR_T vos_sockSourceMC (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  srcAddress,
+    UINT32  ipAddress,
+    BOOL8   join)
+{
+#ifdef IP_ADD_SOURCE_MEMBERSHIP
+    struct ip_mreq_source   mreq;
+    VOS_ERR_T               result  = VOS_NO_ERR;
+    const char              *optName = (join == TRUE) ? "IP_ADD_SOURCE_MEMBERSHIP" : "IP_DROP_SOURCE_MEMBERSHIP";
+
+    if (sock == (SOCKET)INVALID_SOCKET)
+    {
+        result = VOS_PARAM_ERR;
+    }
+    /* Is this a multicast address and a unicast source? */
+    else if (IN_MULTICAST(mcAddress) && (srcAddress != 0u) && !IN_MULTICAST(srcAddress))
+    {
+        memset(&mreq, 0, sizeof(mreq));
+        mreq.imr_multiaddr.s_addr   = vos_htonl(mcAddress);
+        mreq.imr_sourceaddr.s_addr  = vos_htonl(srcAddress);
+        mreq.imr_interface.s_addr   = vos_htonl(ipAddress);
+
+        {
+            char    mcStr[16];
+            char    srcStr[16];
+
+            (void) strcpy_s(mcStr, sizeof(mcStr), inet_ntoa(mreq.imr_multiaddr));
+            (void) strcpy_s(srcStr, sizeof(srcStr), inet_ntoa(mreq.imr_sourceaddr));
+
+            vos_printLog(VOS_LOG_INFO, "%s MC: %s from source %s\n", (join == TRUE) ? "joining" : "leaving",
+                         mcStr, srcStr);
+        }
+
+        if (setsockopt((SOCKET)sock, IPPROTO_IP, (join == TRUE) ? IP_ADD_SOURCE_MEMBERSHIP : IP_DROP_SOURCE_MEMBERSHIP,
+                       (const char *)&mreq, sizeof(mreq)) == SOCKET_ERROR)
+        {
+            int err = WSAGetLastError();
+
+            err = err;     /* for lint */
+            vos_printLog(VOS_LOG_ERROR, "setsockopt() %s failed (Err: %d)\n", optName, err);
+            result = VOS_SOCK_ERR;
+        }
+    }
+    else
+    {
+        result = VOS_PARAM_ERR;
+    }
+
+    return result;
+#else
+    (void) sock;
+    (void) mcAddress;
+    (void) srcAddress;
+    (void) ipAddress;
+    (void) join;
+    vos_printLogStr(VOS_LOG_ERROR, "source specific multicast not supported\n");
+    return VOS_SOCK_ERR;
+#endif
+}
+
+/**********************************************************************************************************************/
+/** Join a multicast group for a single source (source specific multicast).
+ *  Datagrams of the group sent by other sources are dropped by the network stack.
+ *  Note: Some targeted systems might not support this option.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      mcAddress       multicast group to join
+ *  @param[in]      srcAddress      source to receive the group from
+ *  @param[in]      ipAddress       depicts interface on which to join, default 0 for any
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_SOCK_ERR    option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockJoinSourceMC (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  srcAddress,
+    UINT32  ipAddress)
+{
+    return vos_sockSourceMC(sock, mcAddress, srcAddress, ipAddress, TRUE);
+}
+
+/**********************************************************************************************************************/
+/** Leave a source specific multicast membership.
+ *  Note: Some targeted systems might not support this option.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      mcAddress       multicast group to leave
+ *  @param[in]      srcAddress      source the group was joined for
+ *  @param[in]      ipAddress       depicts interface on which to leave, default 0 for any
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_SOCK_ERR    option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockLeaveSourceMC (
+    SOCKET  sock,
+    UINT32  mcAddress,
+    UINT32  srcAddress,
+    UINT32  ipAddress)
+{
+    return vos_sockSourceMC(sock, mcAddress, srcAddress, ipAddress, FALSE);
+}
+
+/**********************************************************************************************************************/
+/** Filter received datagrams in the kernel.
+ *  Socket filters are not supported on this target, received datagrams are filtered by the stack only.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      offset          offset of the 32 bit word in the UDP payload
+ *  @param[in]      pValues         values to pass (host byte order), sorted ascending
+ *  @param[in]      noOfValues      number of values, 0 to remove the filter
+ *
+ *  @retval         VOS_SOCK_ERR    option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockSetFilter (
+    SOCKET          sock,
+    UINT32          offset,
+    const UINT32    *pValues,
+    UINT32          noOfValues)
+{
+    (void) sock;
+    (void) offset;
+    (void) pValues;
+    (void) noOfValues;
+    return VOS_SOCK_ERR;
+}
+
+/**********************************************************************************************************************/
+/** Get the number of datagrams the kernel dropped for a socket.
+ *  Not supported on this target.
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[out]     pDrops          number of dropped datagrams
+ *
+ *  @retval         VOS_SOCK_ERR    option not supported
+ */
+
+EXT_DECL VOS_ERR_T vos_sockGetDrops (
+    SOCKET  sock,
+    UINT32  *pDrops)
+{
+    (void) sock;
+    (void) pDrops;
+    return VOS_SOCK_ERR;
+}
+
 /**********************************************************************************************************************/
 /** Send UDP data.
  *  Send data to the supplied address and port.
@@ -1559,6 +1727,52 @@ EXT_DECL VOS_ERR_T vos_sockSendTCP (
     return VOS_NO_ERR;
 }
 
+/**********************************************************************************************************************/
+/** Send TCP data from several buffers (gather write).
+ *  The buffers are sent in the given order as one contiguous byte stream.
+ *  No native gather write is used, the buffers are passed one by one to vos_sockSendTCP().
+ *
+ *  @param[in]      sock            socket descriptor
+ *  @param[in]      pIoVec          array of buffer descriptors
+ *  @param[in]      ioVecCnt        number of buffer descriptors (max. VOS_MAX_IOVEC_CNT)
+ *  @param[out]     pSize           no of bytes sent
+ *
+ *  @retval         VOS_NO_ERR      no error
+ *  @retval         VOS_PARAM_ERR   sock descriptor unknown, parameter error
+ *  @retval         VOS_IO_ERR      data could not be sent
+ *  @retval         VOS_NOCONN_ERR  no TCP connection
+ *  @retval         VOS_BLOCK_ERR   Call would have blocked in blocking mode, data partially sent
+ */
+EXT_DECL VOS_ERR_T vos_sockSendTCPv (
+    SOCKET              sock,
+    const VOS_IOVEC_T   *pIoVec,
+    UINT32              ioVecCnt,
+    UINT32              *pSize)
+{
+    VOS_ERR_T   err = VOS_NO_ERR;
+    UINT32      i;
+
+    if (pIoVec == NULL || pSize == NULL || ioVecCnt > VOS_MAX_IOVEC_CNT)
+    {
+        return VOS_PARAM_ERR;
+    }
+
+    *pSize = 0;
+
+    for (i = 0; (i < ioVecCnt) && (err == VOS_NO_ERR); i++)
+    {
+        UINT32 size = pIoVec[i].size;
+
+        if ((pIoVec[i].pBuffer == NULL) || (size == 0))
+        {
+            continue;
+        }
+        err     = vos_sockSendTCP(sock, pIoVec[i].pBuffer, &size);
+        *pSize  += size;
+    }
+    return err;
+}
+
 /**********************************************************************************************************************/
 /** Receive TCP data.
  *  The caller must provide a sufficient sized buffer. If the supplied buffer is smaller than the bytes received, *pSize
@@ -14,6 +14,8 @@
  *
  * $Id: LibraryTests.c 1804 2018-11-13 08:18:02Z ahweiss $
  *
+ *      AG 2026-10-18: Thread affinity / stack pre-fault tests
+ *      AG 2026-10-18: Queue tests for the lock-free policies
  *      BL 2017-05-22: Ticket #122: Addendum for 64Bit compatibility (VOS_TIME_T -> VOS_TIMEVAL_T)
  */
 
@@ -31,6 +33,7 @@
 #include <unistd.h>
 #include <sys/time.h>
 #include <sys/select.h>
+#include <sched.h>
 
 #ifndef _TCHAR
 #define _TCHAR char
@@ -300,6 +303,241 @@ int testInterfaces()
     return 0; /* all time tests succeeded */
 }
 
+#define QUEUE_TEST_MSGS     100000u
+
+typedef struct
+{
+    VOS_QUEUE_T queue;
+    UINT32      first;
+    UINT32      count;
+    VOS_SEMA_T  done;
+} QUEUE_TEST_ARG_T;
+
+static UINT32 gQueueTestMsg[2u * QUEUE_TEST_MSGS];
+
+static void queueProducer(void *pArg)
+{
+    QUEUE_TEST_ARG_T    *pTest = (QUEUE_TEST_ARG_T *) pArg;
+    UINT32              i;
+
+    for (i = pTest->first; i < pTest->first + pTest->count; i++)
+    {
+        gQueueTestMsg[i] = i;
+        while (vos_queueSend(pTest->queue, (UINT8 *) &gQueueTestMsg[i], sizeof(UINT32)) == VOS_QUEUE_FULL_ERR)
+        {
+            (void) vos_threadDelay(0u);
+        }
+    }
+    vos_semaGive(pTest->done);
+}
+
+int testQueues()
+{
+    VOS_QUEUE_POLICY_T  policies[] = {VOS_QUEUE_POLICY_FIFO, VOS_QUEUE_POLICY_SPSC, VOS_QUEUE_POLICY_MPMC};
+    UINT32              values[8];
+    VOS_QUEUE_T         queue;
+    UINT8               *pData;
+    UINT8               buf[16];
+    UINT32              size;
+    UINT32              i, p, n;
+    UINT64              sum;
+    VOS_THREAD_T        thread[2];
+    QUEUE_TEST_ARG_T    arg[2];
+
+    /* order, full and empty behaviour of all FIFO flavours */
+    for (p = 0; p < sizeof(policies) / sizeof(policies[0]); p++)
+    {
+        if (vos_queueCreate(policies[p], 8u, &queue) != VOS_NO_ERR)
+        {
+            printf("Queue policy %u: create failed\n", policies[p]);
+            return 1;
+        }
+        for (n = 0; n < 8u; n++)
+        {
+            values[n] = n;
+            if (vos_queueSend(queue, (UINT8 *) &values[n], sizeof(UINT32)) != VOS_NO_ERR)
+            {
+                break;
+            }
+        }
+        /* the legacy queue keeps one slot free */
+        if ((n < 7u) || (vos_queueSend(queue, (UINT8 *) &values[0], sizeof(UINT32)) != VOS_QUEUE_FULL_ERR))
+        {
+            printf("Queue policy %u: full condition not reported (%u)\n", policies[p], n);
+            return 1;
+        }
+        for (i = 0; i < n; i++)
+        {
+            if ((vos_queueReceive(queue, &pData, &size, 0u) != VOS_NO_ERR)
+                || (pData != (UINT8 *) &values[i]) || (size != sizeof(UINT32)))
+            {
+                printf("Queue policy %u: wrong element %u\n", policies[p], i);
+                return 1;
+            }
+        }
+        if (vos_queueReceive(queue, &pData, &size, 0u) != VOS_QUEUE_ERR)
+        {
+            printf("Queue policy %u: empty condition not reported\n", policies[p]);
+            return 1;
+        }
+        (void) vos_queueDestroy(queue);
+    }
+
+    /* inline payload is copied, the sender's buffer may be reused at once */
+    if (vos_queueCreateEx(VOS_QUEUE_POLICY_SPSC, 4u, 16u, &queue) != VOS_NO_ERR)
+    {
+        printf("Inline queue: create failed\n");
+        return 1;
+    }
+    memcpy(buf, "inline payload", 15u);
+    (void) vos_queueSend(queue, buf, 15u);
+    memset(buf, 0, sizeof(buf));
+    size = sizeof(buf);
+    if ((vos_queueReceiveCopy(queue, buf, &size, 1000u) != VOS_NO_ERR)
+        || (size != 15u) || (strcmp((char *) buf, "inline payload") != 0)
+        || (vos_queueReceive(queue, &pData, &size, 0u) != VOS_PARAM_ERR))
+    {
+        printf("Inline queue: wrong payload\n");
+        return 1;
+    }
+    size = sizeof(buf);
+    if (vos_queueReceiveCopy(queue, buf, &size, 1000u) != VOS_QUEUE_ERR)
+    {
+        printf("Inline queue: timeout not reported\n");
+        return 1;
+    }
+    (void) vos_queueDestroy(queue);
+
+    /* two producer threads against one blocking consumer */
+    if ((vos_threadInit() != VOS_NO_ERR)
+        || (vos_queueCreate(VOS_QUEUE_POLICY_MPMC, 64u, &queue) != VOS_NO_ERR))
+    {
+        printf("MPMC queue: create failed\n");
+        return 1;
+    }
+    for (p = 0; p < 2u; p++)
+    {
+        arg[p].queue    = queue;
+        arg[p].first    = p * QUEUE_TEST_MSGS;
+        arg[p].count    = QUEUE_TEST_MSGS;
+        if ((vos_semaCreate(&arg[p].done, VOS_SEMA_EMPTY) != VOS_NO_ERR)
+            || (vos_threadCreate(&thread[p], "queueProducer", VOS_THREAD_POLICY_OTHER, 0, 0, 0,
+                                 queueProducer, &arg[p]) != VOS_NO_ERR))
+        {
+            printf("MPMC queue: thread create failed\n");
+            return 1;
+        }
+    }
+    sum = 0u;
+    for (i = 0; i < 2u * QUEUE_TEST_MSGS; i++)
+    {
+        if (vos_queueReceive(queue, &pData, &size, 5000000u) != VOS_NO_ERR)
+        {
+            printf("MPMC queue: message %u lost\n", i);
+            return 1;
+        }
+        sum += *(UINT32 *) pData;
+    }
+    if (sum != (UINT64) QUEUE_TEST_MSGS * (2u * QUEUE_TEST_MSGS - 1u))
+    {
+        printf("MPMC queue: wrong checksum\n");
+        return 1;
+    }
+    for (p = 0; p < 2u; p++)
+    {
+        (void) vos_semaTake(arg[p].done, VOS_SEMA_WAIT_FOREVER);
+        vos_semaDelete(arg[p].done);
+    }
+    (void) vos_queueDestroy(queue);
+
+    return 0; /* all queue tests succeeded */
+}
+
+#ifdef __linux__
+static volatile int gThreadTestCpu = -1;
+
+static void threadOptionsFunc(void *pArg)
+{
+    gThreadTestCpu = sched_getcpu();
+    vos_semaGive((VOS_SEMA_T) pArg);
+}
+
+int testThreadOptions()
+{
+    VOS_THREAD_OPTIONS_T    options = {0};
+    VOS_THREAD_T            thread;
+    VOS_SEMA_T              done;
+    cpu_set_t               ownSet;
+    UINT64                  ownMask = 0u;
+    UINT32                  cpu;
+    int                     lastCpu = -1;
+
+    if ((vos_threadInit() != VOS_NO_ERR)
+        || (vos_semaCreate(&done, VOS_SEMA_EMPTY) != VOS_NO_ERR)
+        || (sched_getaffinity(0, sizeof(ownSet), &ownSet) != 0))
+    {
+        printf("Thread options: init failed\n");
+        return 1;
+    }
+    for (cpu = 0u; cpu < 64u; cpu++)
+    {
+        if (CPU_ISSET(cpu, &ownSet))
+        {
+            ownMask |= (UINT64) 1u << cpu;
+            lastCpu = (int) cpu;
+        }
+    }
+
+    /* pinned to the last usable core, with pre-faulted stack */
+    options.cpuMask         = (UINT64) 1u << lastCpu;
+    options.stackPrefault   = 1024u * 1024u;      /* more than the stack: limited internally */
+    if (vos_threadCreateEx(&thread, "pinned", VOS_THREAD_POLICY_OTHER, 0, 0, 64u * 1024u, &options,
+                           threadOptionsFunc, done) != VOS_NO_ERR)
+    {
+        printf("Thread options: create failed\n");
+        return 1;
+    }
+    (void) vos_semaTake(done, VOS_SEMA_WAIT_FOREVER);
+    if (gThreadTestCpu != lastCpu)
+    {
+        printf("Thread options: thread ran on CPU %d instead of %d\n", gThreadTestCpu, lastCpu);
+        return 1;
+    }
+
+    /* the calling thread can be pinned and released again */
+    if ((vos_threadSetAffinity(NULL, options.cpuMask) != VOS_NO_ERR)
+        || (sched_getcpu() != lastCpu)
+        || (vos_threadSetAffinity(NULL, ownMask) != VOS_NO_ERR)
+        || (vos_threadSetAffinity(NULL, 0u) != VOS_PARAM_ERR))
+    {
+        printf("Thread options: vos_threadSetAffinity failed\n");
+        return 1;
+    }
+
+    /* larger stack, pre-fault of twice its size must stop short of the guard page */
+    options.cpuMask         = 0u;
+    options.stackPrefault   = 2u * 1024u * 1024u;
+    gThreadTestCpu          = -1;
+    if ((vos_threadCreateEx(&thread, "prefault", VOS_THREAD_POLICY_OTHER, 0, 0, 1024u * 1024u, &options,
+                            threadOptionsFunc, done) != VOS_NO_ERR)
+        || (vos_semaTake(done, 5000000u) != VOS_NO_ERR)
+        || (gThreadTestCpu < 0))
+    {
+        printf("Thread options: 1MB stack pre-fault failed\n");
+        return 1;
+    }
+
+    /* the calling thread is limited to its own stack as well */
+    if (vos_threadPrefaultStack(0xFFFFFFFFu) != VOS_NO_ERR)
+    {
+        printf("Thread options: vos_threadPrefaultStack failed\n");
+        return 1;
+    }
+    vos_semaDelete(done);
+    return 0; /* all thread option tests succeeded */
+}
+#endif
+
 int main(int argc, char *argv[])
 {
     printf("Starting tests\n");
@@ -339,6 +577,20 @@ int main(int argc, char *argv[])
         return 1;
     }
 
+    if (testQueues())
+    {
+        printf("Queue testing failed\n");
+        return 1;
+    }
+
+#ifdef __linux__
+    if (testThreadOptions())
+    {
+        printf("Thread options testing failed\n");
+        return 1;
+    }
+#endif
+
     printf("All tests successfully finished.\n");
     return 0;
 }
@@ -0,0 +1,551 @@
+/**********************************************************************************************************************/
+/**
+ * @file            dnrStubTest.c
+ *
+ * @brief           Offline test of the asynchronous URI resolution of tau_dnr
+ *
+ * @details         A child process serves as TCN-DNS server (MD replier on TCN_DNS_REQ_COMID) and as standard DNS server
+ *                  (UDP) on 127.0.0.2. The parent resolves through both from 127.0.0.1:
+ *                  asynchronous and blocking resolution, cache hits, the reverse lookup, topocount change, TTL expiry,
+ *                  unknown URIs, cancelled resolutions and the batch resolution of a telegram configuration.
+ *                  Stub names: devN.stub -> 10.1.N/256.N%256, short.ttl -> 10.2.0.1 (DNS TTL 1 s), anything else
+ *                  is unknown.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/select.h>
+
+#include "trdp_if_light.h"
+#include "tau_dnr.h"
+#include "tau_tti.h"                        /* needed for TRDP_SHORT_VERSION */
+#include "tau_dnr_types.h"
+#include "vos_sock.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define CLIENT_IP           vos_dottedIP("127.0.0.1")
+#define SERVER_IP           vos_dottedIP("127.0.0.2")
+#define STUB_DNS_PORT       15353u
+#define STUB_DNS_TTL        300u
+#define NO_OF_URIS          300u        /* more than one TCN-DNS request can carry */
+#define LOOP_TIMEOUT_US     10000000u
+#define NO_OF_TELEGRAMS     150u        /* two URIs each, the batch needs two TCN-DNS requests */
+
+#define CHECK(cond, text)   do { if (!(cond)) { printf("*** FAILED: %s (line %d)\n", (text), __LINE__); \
+                                                gFailed++; } } while (0)
+
+typedef struct
+{
+    TRDP_IP_ADDR_T  ipAddr;
+    TRDP_ERR_T      result;
+    BOOL8           done;
+} RESULT_T;
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static int      gFailed;
+static RESULT_T gResults[NO_OF_URIS + 1u];
+static UINT32   gNoOfCallbacks;
+
+/**********************************************************************************************************************/
+static void dbgOut (
+    void        *pRefCon,
+    TRDP_LOG_T  category,
+    const CHAR8 *pTime,
+    const CHAR8 *pFile,
+    UINT16      LineNumber,
+    const CHAR8 *pMsgStr)
+{
+    const char *catStr[] = {"**Error:", "Warning:", "   Info:", "  Debug:", "   User:"};
+
+    if ((category == VOS_LOG_ERROR) || (category == VOS_LOG_USR))
+    {
+        printf("%s %s %s:%d %s", pTime, catStr[category], pFile, LineNumber, pMsgStr);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Name database of the stub servers
+ */
+static BOOL8 stubLookup (const CHAR8 *pUri, TRDP_IP_ADDR_T *pIpAddr, UINT32 *pTtl)
+{
+    unsigned int    n;
+    char            tail;
+
+    *pTtl = STUB_DNS_TTL;
+    if (vos_strnicmp(pUri, "short.ttl", TRDP_MAX_URI_HOST_LEN) == 0)
+    {
+        *pIpAddr    = vos_dottedIP("10.2.0.1");
+        *pTtl       = 1u;
+        return TRUE;
+    }
+    if ((sscanf(pUri, "dev%u.stu%c", &n, &tail) == 2) && (tail == 'b') && (n < 65536u))
+    {
+        *pIpAddr = 0x0A010000u | n;
+        return TRUE;
+    }
+    return FALSE;
+}
+
+/**********************************************************************************************************************/
+/** TCN-DNS stub: reply to every request
+ */
+static void stubMDCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    static TRDP_DNS_REPLY_T reply;
+    TRDP_DNS_REQUEST_T      *pRequest = (TRDP_DNS_REQUEST_T *) pData;
+    TRDP_IP_ADDR_T          ipAddr;
+    UINT32                  ttl;
+    UINT32                  i;
+
+    (void) pRefCon;
+    if ((pMsg->msgType != TRDP_MSG_MR) || (pData == NULL) ||
+        (dataSize < sizeof(TRDP_DNS_REQUEST_T) - 255u * sizeof(TCN_URI_T) - sizeof(TRDP_ETB_CTRL_VDP_T)))
+    {
+        return;
+    }
+    memset(&reply, 0, sizeof(reply));
+    reply.version.ver   = 1u;
+    reply.etbTopoCnt    = pRequest->etbTopoCnt;         /* echo the topocounts of the request */
+    reply.opTrnTopoCnt  = pRequest->opTrnTopoCnt;
+    reply.etbId         = pRequest->etbId;
+    reply.tcnUriCnt     = pRequest->tcnUriCnt;
+    for (i = 0u; i < pRequest->tcnUriCnt; i++)
+    {
+        memcpy(reply.tcnUriList[i].tcnUriStr, pRequest->tcnUriList[i].tcnUriStr, sizeof(reply.tcnUriList[i].tcnUriStr));
+        if (stubLookup(reply.tcnUriList[i].tcnUriStr, &ipAddr, &ttl) == TRUE)
+        {
+            reply.tcnUriList[i].tcnUriIpAddr = vos_htonl(ipAddr);
+        }
+        else
+        {
+            reply.tcnUriList[i].resolvState = -1;
+        }
+    }
+    (void) tlm_reply(appHandle, &pMsg->sessionId, TCN_DNS_REP_COMID, 0u, NULL, (UINT8 *) &reply,
+                     sizeof(reply) - (255u - reply.tcnUriCnt) * sizeof(TCN_URI_T));
+}
+
+/**********************************************************************************************************************/
+/** DNS stub: answer one query for an A record
+ */
+static void stubDnsAnswer (SOCKET sock)
+{
+    UINT8           packet[1500];
+    UINT32          size = sizeof(packet);
+    UINT32          srcIp;
+    UINT16          srcPort;
+    UINT32          offset = 12u;
+    CHAR8           name[TRDP_MAX_URI_HOST_LEN + 1u];
+    UINT32          len = 0u;
+    TRDP_IP_ADDR_T  ipAddr;
+    UINT32          ttl;
+
+    if ((vos_sockReceiveUDP(sock, packet, &size, &srcIp, &srcPort, NULL, FALSE) != VOS_NO_ERR) || (size < 12u))
+    {
+        return;
+    }
+    /* 3www6newtec2de0 -> www.newtec.de */
+    while ((offset < size) && (packet[offset] != 0u) && (len + packet[offset] + 1u < sizeof(name)))
+    {
+        if (len > 0u)
+        {
+            name[len++] = '.';
+        }
+        memcpy(&name[len], &packet[offset + 1u], packet[offset]);
+        len     += packet[offset];
+        offset  += packet[offset] + 1u;
+    }
+    name[len]   = '\0';
+    offset      += 5u;                                  /* zero label, type and class */
+    if (offset > size)
+    {
+        return;
+    }
+
+    packet[2] = 0x81u;                                  /* response, recursion desired */
+    packet[3] = 0x80u;                                  /* recursion available */
+    packet[6] = 0u;                                     /* no answer */
+    packet[7] = 0u;
+    packet[8] = packet[9] = packet[10] = packet[11] = 0u;
+    if (stubLookup(name, &ipAddr, &ttl) == TRUE)
+    {
+        UINT8 answer[16] = {0xC0u, 12u, 0u, 1u, 0u, 1u, 0u, 0u, 0u, 0u, 0u, 4u, 0u, 0u, 0u, 0u};
+
+        answer[6]   = (UINT8) (ttl >> 24u);
+        answer[7]   = (UINT8) (ttl >> 16u);
+        answer[8]   = (UINT8) (ttl >> 8u);
+        answer[9]   = (UINT8) ttl;
+        answer[12]  = (UINT8) (ipAddr >> 24u);
+        answer[13]  = (UINT8) (ipAddr >> 16u);
+        answer[14]  = (UINT8) (ipAddr >> 8u);
+        answer[15]  = (UINT8) ipAddr;
+        memcpy(&packet[offset], answer, sizeof(answer));
+        size        = offset + sizeof(answer);
+        packet[7]   = 1u;
+    }
+    else
+    {
+        packet[3]   |= 3u;                              /* name error */
+        size        = offset;
+    }
+    (void) vos_sockSendUDP(sock, packet, &size, srcIp, srcPort);
+}
+
+/**********************************************************************************************************************/
+/** Stub servers, run until killed
+ */
+static void stubServer (void)
+{
+    TRDP_APP_SESSION_T      appHandle;
+    TRDP_LIS_T              listenHandle;
+    TRDP_MEM_CONFIG_T       memConfig       = {NULL, 0, {0}};
+    TRDP_PROCESS_CONFIG_T   processConfig   = {"DnsStub", "", 0, 0, TRDP_OPTION_BLOCK};
+    VOS_SOCK_OPT_T          opts;
+    SOCKET                  dnsSock;
+
+    memset(&opts, 0, sizeof(opts));
+    opts.reuseAddrPort = TRUE;
+    if ((tlc_init(dbgOut, NULL, &memConfig) != TRDP_NO_ERR) ||
+        (tlc_openSession(&appHandle, SERVER_IP, 0, NULL, NULL, NULL, &processConfig) != TRDP_NO_ERR) ||
+        (tlm_addListener(appHandle, &listenHandle, NULL, stubMDCallback, TRUE, TCN_DNS_REQ_COMID, 0u, 0u,
+                         VOS_INADDR_ANY, VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK, NULL, NULL) != TRDP_NO_ERR) ||
+        (vos_sockOpenUDP(&dnsSock, &opts) != VOS_NO_ERR) ||
+        (vos_sockBind(dnsSock, SERVER_IP, STUB_DNS_PORT) != VOS_NO_ERR))
+    {
+        printf("*** stub server not started\n");
+        _exit(1);
+    }
+
+    for (;; )
+    {
+        TRDP_FDS_T  rfds;
+        INT32       noDesc = 0;
+        TRDP_TIME_T tv;
+        TRDP_TIME_T maxTv = {0, 10000};
+        INT32       rv;
+
+        FD_ZERO(&rfds);
+        (void) tlc_getInterval(appHandle, &tv, &rfds, &noDesc);
+        if (vos_cmpTime(&tv, &maxTv) > 0)
+        {
+            tv = maxTv;                                 /* replies are sent by the next tlc_process */
+        }
+        FD_SET(dnsSock, &rfds);
+        noDesc  = (dnsSock > noDesc) ? dnsSock : noDesc;
+        rv      = vos_select(noDesc + 1, &rfds, NULL, NULL, &tv);
+        if ((rv > 0) && FD_ISSET(dnsSock, &rfds))
+        {
+            stubDnsAnswer(dnsSock);
+            FD_CLR(dnsSock, &rfds);
+            rv--;
+        }
+        (void) tlc_process(appHandle, &rfds, &rv);
+    }
+}
+
+/**********************************************************************************************************************/
+static void resultCallback (
+    void                *pRefCon,
+    TRDP_APP_SESSION_T  appHandle,
+    const CHAR8         *pUri,
+    TRDP_IP_ADDR_T      ipAddr,
+    TRDP_ERR_T          result)
+{
+    RESULT_T *pResult = (RESULT_T *) pRefCon;
+
+    (void) appHandle;
+    (void) pUri;
+    pResult->ipAddr = ipAddr;
+    pResult->result = result;
+    pResult->done   = TRUE;
+    gNoOfCallbacks++;
+}
+
+/**********************************************************************************************************************/
+/** Process the session, and with it the resolver, until the given number of callbacks has arrived
+ */
+static void runUntil (TRDP_APP_SESSION_T appHandle, UINT32 noOfCallbacks)
+{
+    TRDP_TIME_T deadline;
+    TRDP_TIME_T now;
+    TRDP_TIME_T timeout = {LOOP_TIMEOUT_US / 1000000u, 0};
+
+    vos_getTime(&deadline);
+    vos_addTime(&deadline, &timeout);
+    do
+    {
+        TRDP_FDS_T  rfds;
+        INT32       noDesc = 0;
+        TRDP_TIME_T tv = {0, 100000};
+        INT32       rv;
+
+        FD_ZERO(&rfds);
+        (void) tlc_getInterval(appHandle, &tv, &rfds, &noDesc);
+        rv = vos_select(noDesc + 1, &rfds, NULL, NULL, &tv);
+        (void) tlc_process(appHandle, &rfds, &rv);
+        vos_getTime(&now);
+    }
+    while ((gNoOfCallbacks < noOfCallbacks) && (vos_cmpTime(&now, &deadline) < 0));
+}
+
+/**********************************************************************************************************************/
+/** Copy a URI into a buffer of the size tau_uri2Addr reads
+ */
+static const CHAR8 *toUri (TRDP_URI_T uri, const CHAR8 *pName)
+{
+    vos_strncpy(uri, pName, TRDP_MAX_URI_LEN);
+    return uri;
+}
+
+/**********************************************************************************************************************/
+static TRDP_IP_ADDR_T stubAddr (UINT32 n)
+{
+    return 0x0A010000u | n;
+}
+
+/**********************************************************************************************************************/
+/** Tests common to TCN-DNS and standard DNS
+ */
+static void testResolver (TRDP_APP_SESSION_T appHandle, UINT32 noOfUris)
+{
+    TRDP_URI_T      uri;
+    TRDP_IP_ADDR_T  ipAddr;
+    TRDP_ERR_T      err;
+    UINT32          i;
+    UINT32          hits = 0u;
+    RESULT_T        cancelled;
+
+    /* Asynchronous resolution of many URIs and an unknown one */
+    memset(gResults, 0, sizeof(gResults));
+    gNoOfCallbacks = 0u;
+    for (i = 0u; i < noOfUris; i++)
+    {
+        (void) snprintf(uri, sizeof(uri), "dev%u.stub", i);
+        err = tau_uri2AddrAsync(appHandle, &ipAddr, uri, resultCallback, &gResults[i]);
+        CHECK(err == TRDP_BLOCK_ERR, "asynchronous resolution not started");
+    }
+    err = tau_uri2AddrAsync(appHandle, &ipAddr, toUri(uri, "unknown.stub"), resultCallback, &gResults[noOfUris]);
+    CHECK(err == TRDP_BLOCK_ERR, "asynchronous resolution not started");
+    runUntil(appHandle, noOfUris + 1u);
+    CHECK(gNoOfCallbacks == noOfUris + 1u, "callbacks missing");
+    for (i = 0u; i < noOfUris; i++)
+    {
+        if ((gResults[i].done == TRUE) && (gResults[i].result == TRDP_NO_ERR) && (gResults[i].ipAddr == stubAddr(i)))
+        {
+            hits++;
+        }
+    }
+    CHECK(hits == noOfUris, "wrong asynchronous results");
+    CHECK((gResults[noOfUris].done == TRUE) && (gResults[noOfUris].result == TRDP_UNRESOLVED_ERR),
+          "unknown URI resolved");
+    printf("%u URIs resolved asynchronously\n", hits);
+
+    /* Now everything comes from the cache */
+    hits = 0u;
+    for (i = 0u; i < noOfUris; i++)
+    {
+        (void) snprintf(uri, sizeof(uri), "DEV%u.Stub", i);
+        if ((tau_uri2AddrAsync(appHandle, &ipAddr, uri, resultCallback, &gResults[i]) == TRDP_NO_ERR) &&
+            (ipAddr == stubAddr(i)))
+        {
+            hits++;
+        }
+    }
+    CHECK(hits == noOfUris, "cache misses");
+
+    /* Reverse lookup */
+    CHECK((tau_addr2Uri(appHandle, uri, stubAddr(5u)) == TRDP_NO_ERR) && (strcmp(uri, "dev5.stub") == 0),
+          "reverse lookup");
+    CHECK(tau_addr2Uri(appHandle, uri, vos_dottedIP("10.9.9.9")) == TRDP_UNRESOLVED_ERR, "reverse lookup of unknown");
+
+    /* Blocking resolution */
+    CHECK((tau_uri2Addr(appHandle, &ipAddr, toUri(uri, "dev1000.stub")) == TRDP_NO_ERR) && (ipAddr == stubAddr(1000u)),
+          "blocking resolution");
+    CHECK(tau_uri2Addr(appHandle, &ipAddr, toUri(uri, "nothing.stub")) == TRDP_UNRESOLVED_ERR,
+          "blocking resolution of unknown");
+
+    /* A cancelled resolution completes without callback */
+    memset(&cancelled, 0, sizeof(cancelled));
+    gNoOfCallbacks = 0u;
+    CHECK(tau_uri2AddrAsync(appHandle, &ipAddr, toUri(uri, "dev2000.stub"), resultCallback, &cancelled)
+          == TRDP_BLOCK_ERR, "asynchronous resolution not started");
+    memset(&gResults[0], 0, sizeof(gResults[0]));
+    CHECK(tau_uri2AddrAsync(appHandle, &ipAddr, toUri(uri, "dev2000.stub"), resultCallback, &gResults[0])
+          == TRDP_BLOCK_ERR, "asynchronous resolution not started");
+    CHECK(tau_uri2AddrCancel(appHandle, resultCallback, &cancelled) == TRDP_NO_ERR, "cancel");
+    runUntil(appHandle, 1u);
+    CHECK((gResults[0].done == TRUE) && (gResults[0].ipAddr == stubAddr(2000u)), "second resolution of same URI");
+    CHECK(cancelled.done == FALSE, "callback of cancelled resolution");
+}
+
+/**********************************************************************************************************************/
+/** Batch resolution of a telegram configuration
+ */
+static void testPreResolve (TRDP_APP_SESSION_T appHandle, UINT32 noOfTelegrams, UINT32 noOfRequests)
+{
+    static TRDP_URI_HOST_T  uris[2u * NO_OF_TELEGRAMS];
+    static TRDP_URI_HOST_T  ipUri = "10.0.0.1";
+    static TRDP_DEST_T      dest[NO_OF_TELEGRAMS];
+    static TRDP_SRC_T       src[NO_OF_TELEGRAMS];
+    static TRDP_EXCHG_PAR_T exchgPar[NO_OF_TELEGRAMS];
+    TRDP_STATISTICS_T       stats;
+    UINT32                  numSend;
+    UINT32                  unresolved = 0u;
+    UINT32                  hits = 0u;
+    TRDP_IP_ADDR_T          ipAddr;
+    UINT32                  i;
+
+    memset(dest, 0, sizeof(dest));
+    memset(src, 0, sizeof(src));
+    memset(exchgPar, 0, sizeof(exchgPar));
+    for (i = 0u; i < 2u * noOfTelegrams; i++)
+    {
+        (void) snprintf(uris[i], sizeof(uris[i]), "dev%u.stub", 3000u + i);
+    }
+    (void) snprintf(uris[0], sizeof(uris[0]), "missing.stub");
+    for (i = 0u; i < noOfTelegrams; i++)
+    {
+        dest[i].pUriHost        = &uris[2u * i];
+        src[i].pUriHost1        = &uris[2u * i + 1u];
+        src[i].pUriHost2        = &ipUri;               /* not asked for */
+        exchgPar[i].comId       = 1000u + i;
+        exchgPar[i].destCnt     = 1u;
+        exchgPar[i].pDest       = &dest[i];
+        exchgPar[i].srcCnt      = 1u;
+        exchgPar[i].pSrc        = &src[i];
+    }
+
+    (void) tlc_getStatistics(appHandle, &stats);
+    numSend = stats.udpMd.numSend;
+    CHECK(tau_dnrPreResolve(appHandle, noOfTelegrams, exchgPar, &unresolved) == TRDP_UNRESOLVED_ERR,
+          "batch resolution");
+    CHECK(unresolved == 1u, "unresolved URIs of the batch");
+    (void) tlc_getStatistics(appHandle, &stats);
+    CHECK(stats.udpMd.numSend - numSend == noOfRequests, "number of TCN-DNS requests of the batch");
+    for (i = 1u; i < 2u * noOfTelegrams; i++)
+    {
+        if ((tau_uri2AddrAsync(appHandle, &ipAddr, uris[i], NULL, NULL) == TRDP_NO_ERR) &&
+            (ipAddr == stubAddr(3000u + i)))
+        {
+            hits++;
+        }
+    }
+    CHECK(hits == 2u * noOfTelegrams - 1u, "batch results not cached");
+    printf("%u URIs resolved by batch\n", hits);
+
+    /* Only the unresolved URI is asked for again */
+    (void) tlc_getStatistics(appHandle, &stats);
+    numSend = stats.udpMd.numSend;
+    CHECK(tau_dnrPreResolve(appHandle, noOfTelegrams, exchgPar, &unresolved) == TRDP_UNRESOLVED_ERR,
+          "batch resolution");
+    CHECK(unresolved == 1u, "unresolved URIs of the batch");
+    (void) tlc_getStatistics(appHandle, &stats);
+    CHECK(stats.udpMd.numSend - numSend == ((noOfRequests > 0u) ? 1u : 0u), "second batch not answered from cache");
+}
+
+/**********************************************************************************************************************/
+int main (void)
+{
+    TRDP_APP_SESSION_T      appHandle;
+    TRDP_MEM_CONFIG_T       memConfig       = {NULL, 0, {0}};
+    TRDP_PROCESS_CONFIG_T   processConfig   = {"DnrClient", "", 0, 0, TRDP_OPTION_BLOCK};
+    TRDP_IP_ADDR_T          ipAddr;
+    TRDP_URI_T              uri;
+    pid_t                   pid;
+
+    pid = fork();
+    if (pid == 0)
+    {
+        stubServer();
+    }
+    if (pid < 0)
+    {
+        printf("fork failed\n");
+        return 1;
+    }
+    (void) vos_threadDelay(200000u);                    /* let the stubs start */
+
+    if ((tlc_init(dbgOut, NULL, &memConfig) != TRDP_NO_ERR) ||
+        (tlc_openSession(&appHandle, CLIENT_IP, 0, NULL, NULL, NULL, &processConfig) != TRDP_NO_ERR))
+    {
+        printf("*** session not opened\n");
+        (void) kill(pid, SIGTERM);
+        return 1;
+    }
+
+    /* TCN-DNS */
+    printf("TCN-DNS\n");
+    CHECK(tau_initDnr(appHandle, SERVER_IP, 0u, NULL, TRDP_DNR_OWN_THREAD) == TRDP_NO_ERR, "tau_initDnr");
+    testResolver(appHandle, NO_OF_URIS);
+    testPreResolve(appHandle, NO_OF_TELEGRAMS, 2u);
+
+    /* A new topocount invalidates the cache */
+    CHECK(tau_uri2AddrAsync(appHandle, &ipAddr, toUri(uri, "dev5.stub"), NULL, NULL) == TRDP_NO_ERR, "cache miss");
+    (void) tlc_setETBTopoCount(appHandle, 0x1234u);
+    CHECK(tau_uri2AddrAsync(appHandle, &ipAddr, toUri(uri, "dev5.stub"), NULL, NULL) == TRDP_BLOCK_ERR,
+          "outdated entry used");
+    CHECK((tau_uri2Addr(appHandle, &ipAddr, toUri(uri, "dev5.stub")) == TRDP_NO_ERR) && (ipAddr == stubAddr(5u)),
+          "resolution after topocount change");
+    CHECK(tau_uri2AddrAsync(appHandle, &ipAddr, toUri(uri, "dev5.stub"), NULL, NULL) == TRDP_NO_ERR, "cache miss");
+    (void) tlc_setETBTopoCount(appHandle, 0u);
+    tau_deInitDnr(appHandle);
+
+    /* standard DNS */
+    printf("standard DNS\n");
+    CHECK(tau_initDnr(appHandle, SERVER_IP, STUB_DNS_PORT, NULL, TRDP_DNR_STANDARD_DNS) == TRDP_NO_ERR,
+          "tau_initDnr");
+    testResolver(appHandle, 20u);
+    testPreResolve(appHandle, 20u, 0u);
+
+    /* TTL expiry */
+    CHECK((tau_uri2Addr(appHandle, &ipAddr, toUri(uri, "short.ttl")) == TRDP_NO_ERR)
+          && (ipAddr == vos_dottedIP("10.2.0.1")), "blocking resolution");
+    CHECK(tau_uri2AddrAsync(appHandle, &ipAddr, toUri(uri, "short.ttl"), NULL, NULL) == TRDP_NO_ERR, "cache miss");
+    (void) vos_threadDelay(1200000u);
+    CHECK(tau_uri2AddrAsync(appHandle, &ipAddr, toUri(uri, "short.ttl"), NULL, NULL) == TRDP_BLOCK_ERR,
+          "expired entry used");
+    CHECK(tau_addr2Uri(appHandle, uri, vos_dottedIP("10.2.0.1")) == TRDP_UNRESOLVED_ERR,
+          "reverse lookup of expired entry");
+    tau_deInitDnr(appHandle);
+
+    (void) kill(pid, SIGTERM);
+    (void) waitpid(pid, NULL, 0);
+    (void) tlc_closeSession(appHandle);
+    (void) tlc_terminate();
+
+    printf("%s\n", (gFailed == 0) ? "DNR stub test: Success" : "DNR stub test: FAILED");
+    return (gFailed == 0) ? 0 : 1;
+}
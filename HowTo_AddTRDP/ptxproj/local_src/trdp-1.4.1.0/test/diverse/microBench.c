@@ -0,0 +1,536 @@
+/**********************************************************************************************************************/
+/**
+ * @file            microBench.c
+ *
+ * @brief           Microbenchmarks of the TRDP hot path primitives
+ *
+ * @details         Measures marshalling and unmarshalling of the datasets of an XML configuration, the CRCs, the
+ *                  VOS memory allocator, the VOS queue policies and the lookup of subscriptions for received PDs.
+ *                  Each case is repeated until it ran for the minimum time, the result is printed as CSV with the
+ *                  time and the number of vos_memAlloc calls per operation.
+ *                  All data is generated from a fixed seed, so runs with the same arguments are comparable.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "trdp_if_light.h"
+#include "tau_marshall.h"
+#include "tau_xml.h"
+#include "trdp_utils.h"
+#include "vos_mem.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINITIONS
+ */
+
+#define BENCH_XML_FILE      "test/xml/example.xml"
+#define BENCH_SEED          0x5eed1234u
+#define BENCH_MIN_TIME_MS   200u
+#define BENCH_MEM_SIZE      (16u * 1024u * 1024u)
+#define BENCH_MAX_ITER      1000000000u
+#define BENCH_BUF_SIZE      (2u * TRDP_MAX_MD_DATA_SIZE)
+#define BENCH_NUM_SIZES     256u            /* random allocation sizes, power of 2 */
+#define BENCH_LIVE_BLOCKS   64u             /* blocks kept allocated by the random size case, power of 2 */
+#define BENCH_QUEUE_SIZE    64u
+#define BENCH_QUEUE_BATCH   16u
+#define BENCH_NUM_KEYS      1024u           /* lookup keys, power of 2 */
+#define BENCH_MAX_SUBS      4096u
+
+typedef void (*BENCH_FUNC_T)(void *pArg, UINT32 count);
+
+typedef struct
+{
+    UINT32          dsId;
+    UINT32          hostSize;
+    UINT32          wireSize;
+    TRDP_DATASET_T  *pDataset;              /* cached dataset pointer */
+} BENCH_DS_T;
+
+typedef struct
+{
+    const CHAR8         *pName;
+    VOS_QUEUE_POLICY_T  policy;
+    UINT32              msgSize;            /* 0: pass pointers */
+} BENCH_QUEUE_CASE_T;
+
+static const BENCH_QUEUE_CASE_T cQueueCases[] =
+{
+    {"FIFO pointer", VOS_QUEUE_POLICY_FIFO, 0u},
+    {"SPSC pointer", VOS_QUEUE_POLICY_SPSC, 0u},
+    {"SPSC inline", VOS_QUEUE_POLICY_SPSC, 32u},
+    {"MPMC pointer", VOS_QUEUE_POLICY_MPMC, 0u},
+    {"MPMC inline", VOS_QUEUE_POLICY_MPMC, 32u}
+};
+
+static const UINT32 cCrcSizes[]     = {64u, TRDP_MAX_PD_DATA_SIZE, TRDP_MAX_MD_DATA_SIZE};
+static const UINT32 cListSizes[]    = {16u, 256u, BENCH_MAX_SUBS};
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static UINT32           gSeed       = BENCH_SEED;
+static UINT32           gMinTimeUs  = BENCH_MIN_TIME_MS * 1000u;
+static FILE             *gOut;
+static volatile UINT32  gSink;              /* keeps the compiler from dropping results */
+
+static UINT8            gHost[BENCH_BUF_SIZE];
+static UINT8            gWire[BENCH_BUF_SIZE];
+static UINT8            gData[TRDP_MAX_MD_DATA_SIZE];
+static UINT32           gSizes[BENCH_NUM_SIZES];
+static void             *gLive[BENCH_LIVE_BLOCKS];
+static PD_ELE_T         gSubs[BENCH_MAX_SUBS];
+static TRDP_ADDRESSES_T gKeys[BENCH_NUM_KEYS];
+
+/* Arguments of the cases */
+static void             *gpRefCon;
+static UINT32           gCrcSize;
+static VOS_QUEUE_T      gQueue;
+static UINT32           gMsgSize;
+
+/**********************************************************************************************************************/
+/** Fixed seed pseudo random numbers (xorshift32)
+ */
+static UINT32 benchRand (void)
+{
+    gSeed   ^= gSeed << 13;
+    gSeed   ^= gSeed >> 17;
+    gSeed   ^= gSeed << 5;
+    return gSeed;
+}
+
+/**********************************************************************************************************************/
+static void fillRandom (UINT8 *pBuf, UINT32 size)
+{
+    UINT32 i;
+
+    for (i = 0u; i < size; i++)
+    {
+        pBuf[i] = (UINT8) benchRand();
+    }
+}
+
+/**********************************************************************************************************************/
+/** Run a case until it took the minimum time and print the result
+ */
+static void bench (const char *pGroup, const char *pName, UINT32 bytes, BENCH_FUNC_T func, void *pArg)
+{
+    UINT32          count = 1u;
+    UINT32          allocs;
+    UINT64          elapsed;
+    VOS_TIMEVAL_T   start, end;
+
+    func(pArg, 1u);                         /* warm up caches and lazy initialisation */
+    for (;;)
+    {
+        allocs = vos_memAllocTotal();
+        vos_getTime(&start);
+        func(pArg, count);
+        vos_getTime(&end);
+        allocs = vos_memAllocTotal() - allocs;
+        vos_subTime(&end, &start);
+        elapsed = (UINT64) end.tv_sec * 1000000u + (UINT64) end.tv_usec;
+
+        if ((elapsed >= gMinTimeUs) || (count >= BENCH_MAX_ITER / 100u))
+        {
+            break;
+        }
+        /* Aim 20% above the minimum time */
+        count = (elapsed < gMinTimeUs / 100u) ? count * 100u
+                : (UINT32) ((double) count * 1.2 * (double) gMinTimeUs / (double) elapsed) + 1u;
+    }
+    fprintf(gOut, "%s,%s,%u,%u,%.1f,%.2f,%.1f\n", pGroup, pName, bytes, count,
+            (double) elapsed * 1000.0 / (double) count,
+            (double) allocs / (double) count,
+            (elapsed != 0u) ? (double) bytes * (double) count / (double) elapsed : 0.0);
+    fflush(gOut);
+}
+
+/**********************************************************************************************************************/
+static void marshallCase (void *pArg, UINT32 count)
+{
+    BENCH_DS_T  *pDs = (BENCH_DS_T *) pArg;
+    UINT32      size = 0u;
+
+    while (count-- > 0u)
+    {
+        size = sizeof(gWire);
+        (void) tau_marshallDs(gpRefCon, pDs->dsId, gHost, pDs->hostSize, gWire, &size, &pDs->pDataset);
+    }
+    gSink = size;
+}
+
+/**********************************************************************************************************************/
+static void unmarshallCase (void *pArg, UINT32 count)
+{
+    BENCH_DS_T  *pDs = (BENCH_DS_T *) pArg;
+    UINT32      size = 0u;
+
+    while (count-- > 0u)
+    {
+        size = sizeof(gHost);
+        (void) tau_unmarshallDs(gpRefCon, pDs->dsId, gWire, pDs->wireSize, gHost, &size, &pDs->pDataset);
+    }
+    gSink = size;
+}
+
+/**********************************************************************************************************************/
+static void crc32Case (void *pArg, UINT32 count)
+{
+    UINT32 crc = 0u;
+
+    (void) pArg;
+    while (count-- > 0u)
+    {
+        crc ^= vos_crc32(0xFFFFFFFFu, gData, gCrcSize);
+    }
+    gSink = crc;
+}
+
+/**********************************************************************************************************************/
+static void sc32Case (void *pArg, UINT32 count)
+{
+    UINT32 crc = 0u;
+
+    (void) pArg;
+    while (count-- > 0u)
+    {
+        crc ^= vos_sc32(0xFFFFFFFFu, gData, gCrcSize);
+    }
+    gSink = crc;
+}
+
+/**********************************************************************************************************************/
+/** Allocate and free a PD sized block
+ */
+static void allocFixedCase (void *pArg, UINT32 count)
+{
+    (void) pArg;
+    while (count-- > 0u)
+    {
+        vos_memFree(vos_memAlloc(TRDP_MAX_PD_DATA_SIZE));
+    }
+}
+
+/**********************************************************************************************************************/
+/** Replace one of the live blocks by a block of random size
+ */
+static void allocRandomCase (void *pArg, UINT32 count)
+{
+    UINT32 i = 0u;
+
+    (void) pArg;
+    while (count-- > 0u)
+    {
+        UINT32 slot = i & (BENCH_LIVE_BLOCKS - 1u);
+
+        if (gLive[slot] != NULL)
+        {
+            vos_memFree(gLive[slot]);
+        }
+        gLive[slot] = vos_memAlloc(gSizes[i & (BENCH_NUM_SIZES - 1u)]);
+        i++;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Send a batch of messages and receive them
+ */
+static void queueCase (void *pArg, UINT32 count)
+{
+    UINT8   *pMsg;
+    UINT32  size;
+    UINT32  i;
+    UINT32  batch;
+
+    (void) pArg;
+    while (count > 0u)
+    {
+        batch = (count < BENCH_QUEUE_BATCH) ? count : BENCH_QUEUE_BATCH;
+        for (i = 0u; i < batch; i++)
+        {
+            (void) vos_queueSend(gQueue, &gData[i * 32u], (gMsgSize != 0u) ? gMsgSize : 32u);
+        }
+        for (i = 0u; i < batch; i++)
+        {
+            if (gMsgSize != 0u)
+            {
+                size = sizeof(gHost);
+                (void) vos_queueReceiveCopy(gQueue, gHost, &size, 0u);
+            }
+            else
+            {
+                (void) vos_queueReceive(gQueue, &pMsg, &size, 0u);
+            }
+        }
+        count -= batch;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Look up the subscription of received PDs
+ */
+static void lookupCase (void *pArg, UINT32 count)
+{
+    TRDP_ADDRESSES_T    *pKeys  = (TRDP_ADDRESSES_T *) pArg;
+    UINT32              found   = 0u;
+    UINT32              i       = 0u;
+
+    while (count-- > 0u)
+    {
+        found += (trdp_queueFindSubAddr(gSubs, &pKeys[i]) != NULL) ? 1u : 0u;
+        i = (i + 1u) & (BENCH_NUM_KEYS - 1u);
+    }
+    gSink = found;
+}
+
+/**********************************************************************************************************************/
+static void benchMarshall (const char *pXmlFile)
+{
+    TRDP_XML_DOC_HANDLE_T   docHandle;
+    UINT32                  numComId        = 0u;
+    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap  = NULL;
+    UINT32                  numDataset      = 0u;
+    apTRDP_DATASET_T        apDataset       = NULL;
+    BENCH_DS_T              ds;
+    char                    name[64];
+    UINT32                  i;
+
+    if ((tau_prepareXmlDoc(pXmlFile, &docHandle) != TRDP_NO_ERR)
+        || (tau_readXmlDatasetConfig(&docHandle, &numComId, &pComIdDsIdMap, &numDataset, &apDataset)
+            != TRDP_NO_ERR)
+        || (tau_initMarshall(&gpRefCon, numComId, pComIdDsIdMap, numDataset, apDataset) != TRDP_NO_ERR))
+    {
+        fprintf(stderr, "Cannot read the datasets of %s\n", pXmlFile);
+        return;
+    }
+    for (i = 0u; i < numDataset; i++)
+    {
+        ds.dsId     = apDataset[i]->id;
+        ds.pDataset = NULL;
+        ds.wireSize = sizeof(gWire);
+        fillRandom(gHost, sizeof(gHost));
+        if ((tau_marshallDs(gpRefCon, ds.dsId, gHost, sizeof(gHost), gWire, &ds.wireSize, &ds.pDataset)
+             != TRDP_NO_ERR)
+            || (tau_calcDatasetSize(gpRefCon, ds.dsId, gWire, ds.wireSize, &ds.hostSize, &ds.pDataset)
+                != TRDP_NO_ERR))
+        {
+            fprintf(stderr, "Dataset %u skipped\n", ds.dsId);
+            continue;
+        }
+        (void) snprintf(name, sizeof(name), "tau_marshallDs %u", ds.dsId);
+        bench("marshall", name, ds.wireSize, marshallCase, &ds);
+        (void) snprintf(name, sizeof(name), "tau_unmarshallDs %u", ds.dsId);
+        bench("marshall", name, ds.wireSize, unmarshallCase, &ds);
+    }
+    tau_freeXmlDatasetConfig(numComId, pComIdDsIdMap, numDataset, apDataset);
+    tau_freeXmlDoc(&docHandle);
+}
+
+/**********************************************************************************************************************/
+static void benchCrc (void)
+{
+    UINT32 i;
+
+    fillRandom(gData, sizeof(gData));
+    for (i = 0u; i < sizeof(cCrcSizes) / sizeof(cCrcSizes[0]); i++)
+    {
+        gCrcSize = cCrcSizes[i];
+        bench("crc", "vos_crc32", gCrcSize, crc32Case, NULL);
+        bench("crc", "vos_sc32", gCrcSize, sc32Case, NULL);
+    }
+}
+
+/**********************************************************************************************************************/
+static void benchMem (void)
+{
+    UINT32 i;
+
+    for (i = 0u; i < BENCH_NUM_SIZES; i++)
+    {
+        gSizes[i] = 16u + benchRand() % 2032u;
+    }
+    bench("mem", "vos_memAlloc/vos_memFree fixed", TRDP_MAX_PD_DATA_SIZE, allocFixedCase, NULL);
+    bench("mem", "vos_memAlloc/vos_memFree random", 0u, allocRandomCase, NULL);
+    for (i = 0u; i < BENCH_LIVE_BLOCKS; i++)
+    {
+        if (gLive[i] != NULL)
+        {
+            vos_memFree(gLive[i]);
+            gLive[i] = NULL;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+static void benchQueue (void)
+{
+    UINT32 i;
+
+    for (i = 0u; i < sizeof(cQueueCases) / sizeof(cQueueCases[0]); i++)
+    {
+        gMsgSize = cQueueCases[i].msgSize;
+        if (vos_queueCreateEx(cQueueCases[i].policy, BENCH_QUEUE_SIZE, gMsgSize, &gQueue) != VOS_NO_ERR)
+        {
+            fprintf(stderr, "%s: queue not available\n", cQueueCases[i].pName);
+            continue;
+        }
+        bench("queue", cQueueCases[i].pName, gMsgSize, queueCase, NULL);
+        (void) vos_queueDestroy(gQueue);
+    }
+}
+
+/**********************************************************************************************************************/
+/** Subscriptions of consecutive ComIds from one source, looked up in random order
+ */
+static void benchLookup (void)
+{
+    UINT32  i, j, listSize;
+    char    name[64];
+
+    for (i = 0u; i < sizeof(cListSizes) / sizeof(cListSizes[0]); i++)
+    {
+        listSize = cListSizes[i];
+        memset(gSubs, 0, sizeof(gSubs));
+        for (j = 0u; j < listSize; j++)
+        {
+            gSubs[j].addr.comId     = 10000u + j;
+            gSubs[j].addr.srcIpAddr = vos_dottedIP("10.0.1.1");
+            gSubs[j].pNext          = (j + 1u < listSize) ? &gSubs[j + 1u] : NULL;
+        }
+        for (j = 0u; j < BENCH_NUM_KEYS; j++)
+        {
+            gKeys[j].comId      = 10000u + benchRand() % listSize;
+            gKeys[j].srcIpAddr  = vos_dottedIP("10.0.1.1");
+        }
+        (void) snprintf(name, sizeof(name), "trdp_queueFindSubAddr hit %u", listSize);
+        bench("lookup", name, 0u, lookupCase, gKeys);
+
+        for (j = 0u; j < BENCH_NUM_KEYS; j++)
+        {
+            gKeys[j].comId = 20000u + benchRand() % listSize;
+        }
+        (void) snprintf(name, sizeof(name), "trdp_queueFindSubAddr miss %u", listSize);
+        bench("lookup", name, 0u, lookupCase, gKeys);
+    }
+}
+
+/**********************************************************************************************************************/
+static void usage (const char *appName)
+{
+    printf("Usage of %s\n", appName);
+    printf("Microbenchmarks of marshalling, CRC, memory allocator, queues and PD subscription lookup.\n"
+           "Prints CSV: group,case,bytes,iterations,ns_per_op,allocs_per_op,mbyte_per_s\n"
+           "Arguments are:\n"
+           "-x <file>     XML file with the datasets to marshall, default " BENCH_XML_FILE "\n"
+           "-g <group>    run only this group: marshall, crc, mem, queue, lookup\n"
+           "-t <ms>       minimum time per case, default %u\n"
+           "-s <seed>     seed of the random data, default 0x%08x\n"
+           "-m <bytes>    size of the memory pool, 0 for heap memory, default %u\n"
+           "-o <file>     output file, default stdout\n"
+           "-h            print usage\n", BENCH_MIN_TIME_MS, BENCH_SEED, BENCH_MEM_SIZE);
+}
+
+/**********************************************************************************************************************/
+int main (int argc, char *argv[])
+{
+    TRDP_MEM_CONFIG_T   memConfig   = {NULL, BENCH_MEM_SIZE, {0}};
+    const char          *pXmlFile   = BENCH_XML_FILE;
+    const char          *pGroup     = NULL;
+    int                 ch;
+
+    gOut = stdout;
+    while ((ch = getopt(argc, argv, "x:g:t:s:m:o:h?")) != -1)
+    {
+        switch (ch)
+        {
+           case 'x':
+               pXmlFile = optarg;
+               break;
+           case 'g':
+               pGroup = optarg;
+               break;
+           case 't':
+               gMinTimeUs = (UINT32) strtoul(optarg, NULL, 10) * 1000u;
+               break;
+           case 's':
+               gSeed = (UINT32) strtoul(optarg, NULL, 0);
+               break;
+           case 'm':
+               memConfig.size = (UINT32) strtoul(optarg, NULL, 10);
+               break;
+           case 'o':
+               gOut = fopen(optarg, "w");
+               if (gOut == NULL)
+               {
+                   printf("Cannot open %s\n", optarg);
+                   return 1;
+               }
+               break;
+           case 'h':
+           case '?':
+           default:
+               usage(argv[0]);
+               return 1;
+        }
+    }
+    if (gSeed == 0u)
+    {
+        gSeed = BENCH_SEED;                 /* xorshift stays at 0 */
+    }
+
+    /*  No log function: logging is not part of the measurement  */
+    if (tlc_init(NULL, NULL, &memConfig) != TRDP_NO_ERR)
+    {
+        printf("tlc_init failed\n");
+        return 1;
+    }
+
+    fprintf(gOut, "group,case,bytes,iterations,ns_per_op,allocs_per_op,mbyte_per_s\n");
+    if ((pGroup == NULL) || (strcmp(pGroup, "marshall") == 0))
+    {
+        benchMarshall(pXmlFile);
+    }
+    if ((pGroup == NULL) || (strcmp(pGroup, "crc") == 0))
+    {
+        benchCrc();
+    }
+    if ((pGroup == NULL) || (strcmp(pGroup, "mem") == 0))
+    {
+        benchMem();
+    }
+    if ((pGroup == NULL) || (strcmp(pGroup, "queue") == 0))
+    {
+        benchQueue();
+    }
+    if ((pGroup == NULL) || (strcmp(pGroup, "lookup") == 0))
+    {
+        benchLookup();
+    }
+
+    (void) tlc_terminate();
+    if (gOut != stdout)
+    {
+        (void) fclose(gOut);
+    }
+    return 0;
+}
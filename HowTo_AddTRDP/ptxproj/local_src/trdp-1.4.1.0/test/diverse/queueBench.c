@@ -0,0 +1,240 @@
+/**********************************************************************************************************************/
+/**
+ * @file            queueBench.c
+ *
+ * @brief           Throughput and latency of the VOS queue policies
+ *
+ * @details         One or more producer threads pass time stamped messages through a queue to a blocking consumer.
+ *                  The mutex/semaphore FIFO is compared with the lock-free SPSC and MPMC rings, with pointer and
+ *                  inline payload storage.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vos_types.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+#include "vos_mem.h"
+
+/***********************************************************************************************************************
+ * DEFINITIONS
+ */
+
+#define BENCH_DEFAULT_MSGS  1000000u
+#define BENCH_QUEUE_SIZE    1024u
+#define BENCH_MAX_PRODUCER  4u
+#define BENCH_TIMEOUT       5000000u        /* consumer gives up after 5s without message */
+
+typedef struct
+{
+    VOS_TIMEVAL_T   sent;
+    UINT32          seq;
+} BENCH_MSG_T;
+
+typedef struct
+{
+    VOS_QUEUE_T     queue;
+    BENCH_MSG_T     *pMsg;                  /* message buffers of this producer (pointer queues) */
+    UINT32          count;
+    UINT32          fullCnt;
+    VOS_SEMA_T      done;                   /* given when the producer returns */
+} BENCH_PRODUCER_T;
+
+typedef struct
+{
+    const CHAR8         *pName;
+    VOS_QUEUE_POLICY_T  policy;
+    UINT32              msgSize;            /* 0: pass pointers */
+    UINT32              noOfProducers;
+} BENCH_CASE_T;
+
+static const BENCH_CASE_T cBenchCases[] =
+{
+    {"FIFO (mutex)   1:1", VOS_QUEUE_POLICY_FIFO, 0u, 1u},
+    {"SPSC pointer   1:1", VOS_QUEUE_POLICY_SPSC, 0u, 1u},
+    {"SPSC inline    1:1", VOS_QUEUE_POLICY_SPSC, sizeof(BENCH_MSG_T), 1u},
+    {"FIFO (mutex)   4:1", VOS_QUEUE_POLICY_FIFO, 0u, 4u},
+    {"MPMC pointer   4:1", VOS_QUEUE_POLICY_MPMC, 0u, 4u},
+    {"MPMC inline    4:1", VOS_QUEUE_POLICY_MPMC, sizeof(BENCH_MSG_T), 4u}
+};
+
+/**********************************************************************************************************************/
+static void producer (void *pArg)
+{
+    BENCH_PRODUCER_T    *pProd = (BENCH_PRODUCER_T *) pArg;
+    BENCH_MSG_T         local;
+    BENCH_MSG_T         *pMsg;
+    UINT32              i;
+
+    for (i = 0u; i < pProd->count; i++)
+    {
+        pMsg = (pProd->pMsg != NULL) ? &pProd->pMsg[i] : &local;
+        pMsg->seq = i;
+        vos_getTime(&pMsg->sent);
+        while (vos_queueSend(pProd->queue, (UINT8 *) pMsg, sizeof(BENCH_MSG_T)) == VOS_QUEUE_FULL_ERR)
+        {
+            pProd->fullCnt++;
+            (void) vos_threadDelay(0u);
+        }
+    }
+    vos_semaGive(pProd->done);
+}
+
+/**********************************************************************************************************************/
+static int runCase (const BENCH_CASE_T *pCase, UINT32 noOfMsgs)
+{
+    BENCH_PRODUCER_T    prod[BENCH_MAX_PRODUCER];
+    VOS_THREAD_T        thread;
+    VOS_QUEUE_T         queue;
+    BENCH_MSG_T         msg;
+    BENCH_MSG_T         *pMsg;
+    UINT32              size;
+    UINT32              perProducer = noOfMsgs / pCase->noOfProducers;
+    UINT32              total       = perProducer * pCase->noOfProducers;
+    UINT32              fullCnt     = 0u;
+    UINT32              i;
+    VOS_TIMEVAL_T       start, now, delta;
+    UINT64              latSum      = 0u;
+    UINT64              latMax      = 0u;
+    UINT64              lat;
+    UINT64              elapsed;
+    VOS_ERR_T           err;
+
+    if (vos_queueCreateEx(pCase->policy, BENCH_QUEUE_SIZE, pCase->msgSize, &queue) != VOS_NO_ERR)
+    {
+        printf("%s: queue not available\n", pCase->pName);
+        return 1;
+    }
+
+    vos_getTime(&start);
+    for (i = 0u; i < pCase->noOfProducers; i++)
+    {
+        prod[i].queue   = queue;
+        prod[i].count   = perProducer;
+        prod[i].fullCnt = 0u;
+        prod[i].pMsg    = NULL;
+        if (vos_semaCreate(&prod[i].done, VOS_SEMA_EMPTY) != VOS_NO_ERR)
+        {
+            printf("%s: semaphore create failed\n", pCase->pName);
+            return 1;
+        }
+        if (pCase->msgSize == 0u)
+        {
+            prod[i].pMsg = (BENCH_MSG_T *) vos_memAlloc(perProducer * sizeof(BENCH_MSG_T));
+            if (prod[i].pMsg == NULL)
+            {
+                printf("%s: out of memory\n", pCase->pName);
+                return 1;
+            }
+        }
+    }
+    for (i = 0u; i < pCase->noOfProducers; i++)
+    {
+        if (vos_threadCreate(&thread, "producer", VOS_THREAD_POLICY_OTHER, 0, 0u, 0u, producer, &prod[i])
+            != VOS_NO_ERR)
+        {
+            printf("%s: thread create failed\n", pCase->pName);
+            return 1;
+        }
+    }
+
+    for (i = 0u; i < total; i++)
+    {
+        if (pCase->msgSize != 0u)
+        {
+            size    = sizeof(msg);
+            err     = vos_queueReceiveCopy(queue, (UINT8 *) &msg, &size, BENCH_TIMEOUT);
+            pMsg    = &msg;
+        }
+        else
+        {
+            err = vos_queueReceive(queue, (UINT8 * *) &pMsg, &size, BENCH_TIMEOUT);
+        }
+        if (err != VOS_NO_ERR)
+        {
+            printf("%s: receive failed after %u messages (%d)\n", pCase->pName, i, err);
+            return 1;
+        }
+        vos_getTime(&now);
+        delta = now;
+        vos_subTime(&delta, &pMsg->sent);
+        lat = (UINT64) delta.tv_sec * 1000000u + (UINT64) delta.tv_usec;
+        latSum += lat;
+        if (lat > latMax)
+        {
+            latMax = lat;
+        }
+    }
+    delta = now;
+    vos_subTime(&delta, &start);
+    elapsed = (UINT64) delta.tv_sec * 1000000u + (UINT64) delta.tv_usec;
+
+    for (i = 0u; i < pCase->noOfProducers; i++)
+    {
+        (void) vos_semaTake(prod[i].done, VOS_SEMA_WAIT_FOREVER);
+        vos_semaDelete(prod[i].done);
+        fullCnt += prod[i].fullCnt;
+        if (prod[i].pMsg != NULL)
+        {
+            vos_memFree(prod[i].pMsg);
+        }
+    }
+    (void) vos_queueDestroy(queue);
+
+    printf("%s  %10.0f msg/s  latency avg %8.1f us  max %8llu us  full %u\n",
+           pCase->pName,
+           (elapsed != 0u) ? (double) total * 1000000.0 / (double) elapsed : 0.0,
+           (double) latSum / (double) total,
+           (unsigned long long) latMax,
+           fullCnt);
+    return 0;
+}
+
+/**********************************************************************************************************************/
+int main (int argc, char *argv[])
+{
+    UINT32  noOfMsgs = BENCH_DEFAULT_MSGS;
+    UINT32  i;
+    int     rc = 0;
+
+    if (argc > 1)
+    {
+        noOfMsgs = (UINT32) strtoul(argv[1], NULL, 10);
+        if (noOfMsgs < BENCH_MAX_PRODUCER)
+        {
+            printf("usage: %s [number of messages]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (vos_threadInit() != VOS_NO_ERR)
+    {
+        printf("vos_threadInit failed\n");
+        return 1;
+    }
+
+    printf("queue policy        throughput          latency (send to receive)\n");
+    for (i = 0u; i < sizeof(cBenchCases) / sizeof(cBenchCases[0]); i++)
+    {
+        rc |= runCase(&cBenchCases[i], noOfMsgs);
+    }
+
+    vos_threadTerm();
+    return rc;
+}
@@ -0,0 +1,711 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdpBench.c
+ *
+ * @brief           PD and MD throughput and latency benchmark
+ *
+ * @details         A sending and a receiving session, each processed by its own thread, exchange PD telegrams
+ *                  (publisher / subscriber) and MD requests (caller / replier). For every combination of the swept
+ *                  parameters one line of CSV is written to stdout:
+ *                  PD: number of telegrams, dataset size and cycle time,
+ *                  MD: payload size with a fixed number of outstanding requests.
+ *                  The sender writes a time stamp into each telegram immediately before tlc_process, the receiver
+ *                  computes the latency in its callback (PD: one way, MD: round trip). The send jitter is taken
+ *                  from the lateness histograms of the publishers (TRDP_OPTION_HISTOGRAMS). Lost are PDs missed
+ *                  by the subscribers (sequence counter gaps) and MD requests without reply. The CPU time is that
+ *                  of the whole process, i.e. of both sessions, per received packet.
+ *                  By default both sessions use loopback addresses. For a veth pair, the receiving session can be
+ *                  put into a network namespace (Linux, needs CAP_SYS_ADMIN), e.g.:
+ *                      ip netns add trdpb
+ *                      ip link add vethA type veth peer name vethB netns trdpb
+ *                      ip addr add 10.99.0.1/24 dev vethA; ip link set vethA up
+ *                      ip -n trdpb addr add 10.99.0.2/24 dev vethB; ip -n trdpb link set vethB up
+ *                      trdp-bench -o 10.99.0.1 -t 10.99.0.2 -n trdpb
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/select.h>
+#include <sys/resource.h>
+#ifdef LINUX
+#include <sched.h>
+#endif
+
+#include "trdp_if_light.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define BENCH_PD_COMID      20000u
+#define BENCH_MD_COMID      21000u
+#define BENCH_MAX_LIST      8u
+#define BENCH_MAX_TELEGRAMS 256u
+#define BENCH_MAX_SAMPLES   (1u << 20)
+#define BENCH_MEM_SIZE      (16u * 1024u * 1024u)
+#define BENCH_WARMUP_US     200000u
+#define BENCH_POLL_US       10000u          /* longest select() timeout, the stop flag is checked this often */
+#define BENCH_REPLY_TO_US   100000u         /* a lost request or reply is counted after this time */
+#define BENCH_STAMP_SIZE    8u              /* seconds and microseconds, host byte order */
+
+typedef enum
+{
+    BENCH_PD_PUB,
+    BENCH_PD_SUB,
+    BENCH_MD_CALLER,
+    BENCH_MD_REPLIER
+} BENCH_ROLE_T;
+
+typedef struct
+{
+    UINT32  value[BENCH_MAX_LIST];
+    UINT32  count;
+} BENCH_LIST_T;
+
+/** Parameters of one case */
+typedef struct
+{
+    UINT32  telegrams;                      /* PD: number of ComIds */
+    UINT32  size;                           /* PD dataset / MD payload size */
+    UINT32  cycle;                          /* PD cycle time in us */
+    UINT32  window;                         /* MD: outstanding requests */
+} BENCH_CASE_T;
+
+/** One end of the communication, processed by its own thread */
+typedef struct
+{
+    BENCH_ROLE_T        role;
+    TRDP_IP_ADDR_T      ownIp;
+    TRDP_IP_ADDR_T      peerIp;
+    const char          *pNetNs;            /* network namespace to enter, NULL = none */
+    const BENCH_CASE_T  *pCase;
+    TRDP_APP_SESSION_T  appHandle;
+    TRDP_PUB_T          pub[BENCH_MAX_TELEGRAMS];
+    TRDP_SUB_T          sub[BENCH_MAX_TELEGRAMS];
+    TRDP_LIS_T          lis;
+    UINT32              outstanding;        /* MD caller: requests without reply, replier: replies queued */
+    TRDP_ERR_T          err;                /* result of the setup */
+    VOS_SEMA_T          ready;              /* given after the setup */
+    VOS_SEMA_T          done;               /* given after the session is closed */
+    volatile BOOL8      stop;
+} BENCH_END_T;
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static UINT8            gData[TRDP_MAX_MD_DATA_SIZE];
+static UINT32           *gSamples;          /* latencies in us of the measuring window */
+static volatile UINT32  gNumSamples;
+static volatile UINT32  gNumRcvd;
+static volatile UINT32  gNumSent;           /* MD requests sent in the measuring window */
+static volatile UINT32  gNumTimeout;
+static volatile BOOL8   gMeasure;
+
+/**********************************************************************************************************************/
+static void dbgOut (
+    void        *pRefCon,
+    TRDP_LOG_T  category,
+    const CHAR8 *pTime,
+    const CHAR8 *pFile,
+    UINT16      LineNumber,
+    const CHAR8 *pMsgStr)
+{
+    (void) pRefCon;
+    if (category == VOS_LOG_ERROR)
+    {
+        fprintf(stderr, "%s **Error: %s:%d %s", pTime, pFile, LineNumber, pMsgStr);
+    }
+}
+
+/**********************************************************************************************************************/
+static void usage (const char *appName)
+{
+    printf("Usage of %s\n", appName);
+    printf("PD and MD throughput and latency benchmark, writes CSV to stdout.\n"
+           "Arguments are:\n"
+           "-o <own IP>     IP address of the sending session, default 127.0.0.1\n"
+           "-t <target IP>  IP address of the receiving session, default 127.0.0.2\n"
+           "-n <netns>      network namespace of the receiving session (Linux)\n"
+           "-d <ms>         measuring time per case, default 1000\n"
+           "-N <list>       PD: numbers of telegrams, default 1,16,64\n"
+           "-s <list>       PD: dataset sizes, default 64,1432\n"
+           "-c <list>       PD: cycle times in us (>= 10000), default 10000,100000\n"
+           "-m <list>       MD: payload sizes, default 64,1024,16384,65000\n"
+           "-w <n>          MD: outstanding requests, default 1\n"
+           "-P              PD only\n"
+           "-M              MD only\n"
+           "-h              print usage\n"
+           "<list> is a comma separated list of up to %u values\n", BENCH_MAX_LIST);
+}
+
+/**********************************************************************************************************************/
+/** Parse a comma separated list
+ */
+static int parseList (const char *pArg, BENCH_LIST_T *pList, UINT32 max)
+{
+    char *pEnd;
+
+    pList->count = 0u;
+    do
+    {
+        unsigned long value = strtoul(pArg, &pEnd, 10);
+
+        if ((pEnd == pArg) || (value == 0u) || (value > max) || (pList->count >= BENCH_MAX_LIST))
+        {
+            return 1;
+        }
+        pList->value[pList->count++] = (UINT32) value;
+        pArg = pEnd + 1;
+    }
+    while (*pEnd == ',');
+    return (*pEnd == '\0') ? 0 : 1;
+}
+
+/**********************************************************************************************************************/
+/** Record the latency from the time stamp in a received packet
+ */
+static void record (const UINT8 *pData, UINT32 dataSize)
+{
+    TRDP_TIME_T now;
+    TRDP_TIME_T sent;
+    UINT32      stamp[2];
+
+    if (!gMeasure || (pData == NULL) || (dataSize < BENCH_STAMP_SIZE))
+    {
+        return;
+    }
+    vos_getTime(&now);
+    memcpy(stamp, pData, BENCH_STAMP_SIZE);
+    sent.tv_sec     = stamp[0];
+    sent.tv_usec    = (INT32) stamp[1];
+    vos_subTime(&now, &sent);
+    if (gNumSamples < BENCH_MAX_SAMPLES)
+    {
+        gSamples[gNumSamples++] = (UINT32) now.tv_sec * 1000000u + (UINT32) now.tv_usec;
+    }
+    gNumRcvd++;
+}
+
+/**********************************************************************************************************************/
+static void stampData (UINT8 *pData)
+{
+    TRDP_TIME_T now;
+    UINT32      value[2];
+
+    vos_getTime(&now);
+    value[0]    = (UINT32) now.tv_sec;
+    value[1]    = (UINT32) now.tv_usec;
+    memcpy(pData, value, BENCH_STAMP_SIZE);
+}
+
+/**********************************************************************************************************************/
+static void pdCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    (void) pRefCon;
+    (void) appHandle;
+    if (pMsg->resultCode == TRDP_NO_ERR)
+    {
+        record(pData, dataSize);
+    }
+}
+
+/**********************************************************************************************************************/
+static void mdCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    BENCH_END_T *pEnd = (BENCH_END_T *) pMsg->pUserRef;
+
+    (void) pRefCon;
+    if (pEnd->role == BENCH_MD_REPLIER)
+    {
+        if ((pMsg->resultCode == TRDP_NO_ERR) && (pMsg->msgType == TRDP_MSG_MR))
+        {
+            (void) tlm_reply(appHandle, &pMsg->sessionId, pMsg->comId, 0u, NULL, pData, dataSize);
+            pEnd->outstanding++;
+        }
+        return;
+    }
+    if ((pMsg->resultCode == TRDP_NO_ERR) && (pMsg->msgType == TRDP_MSG_MP))
+    {
+        record(pData, dataSize);
+        pEnd->outstanding--;
+    }
+    else if (pMsg->resultCode == TRDP_REPLYTO_ERR)
+    {
+        gNumTimeout += gMeasure ? 1u : 0u;
+        pEnd->outstanding--;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Open the session of an end and set up its telegrams
+ */
+static TRDP_ERR_T setup (BENCH_END_T *pEnd)
+{
+    TRDP_PROCESS_CONFIG_T   processConfig   = {"Bench", "", 0, 0, TRDP_OPTION_BLOCK | TRDP_OPTION_HISTOGRAMS};
+    const BENCH_CASE_T      *pCase          = pEnd->pCase;
+    TRDP_ERR_T              err;
+    UINT32                  i;
+
+    err = tlc_openSession(&pEnd->appHandle, pEnd->ownIp, 0u, NULL, NULL, NULL, &processConfig);
+    for (i = 0u; (err == TRDP_NO_ERR) && (i < pCase->telegrams); i++)
+    {
+        if (pEnd->role == BENCH_PD_PUB)
+        {
+            err = tlp_publish(pEnd->appHandle, &pEnd->pub[i], NULL, NULL, BENCH_PD_COMID + i, 0u, 0u,
+                              pEnd->ownIp, pEnd->peerIp, pCase->cycle, 0u, TRDP_FLAGS_NONE, NULL,
+                              gData, pCase->size);
+        }
+        else if (pEnd->role == BENCH_PD_SUB)
+        {
+            err = tlp_subscribe(pEnd->appHandle, &pEnd->sub[i], NULL, pdCallback, BENCH_PD_COMID + i, 0u, 0u,
+                                0u, 0u, 0u, TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB, 100u * pCase->cycle,
+                                TRDP_TO_DEFAULT);
+        }
+    }
+    if ((err == TRDP_NO_ERR) && (pEnd->role == BENCH_MD_REPLIER))
+    {
+        err = tlm_addListener(pEnd->appHandle, &pEnd->lis, pEnd, mdCallback, TRUE, BENCH_MD_COMID, 0u, 0u,
+                              0u, 0u, 0u, TRDP_FLAGS_CALLBACK, NULL, NULL);
+    }
+    return err;
+}
+
+/**********************************************************************************************************************/
+/** Work of the sender immediately before tlc_process
+ *  PD: time stamp the published data, MD: send requests up to the window
+ */
+static void sendWork (BENCH_END_T *pEnd)
+{
+    const BENCH_CASE_T  *pCase = pEnd->pCase;
+    UINT32              i;
+
+    if (pEnd->role == BENCH_PD_PUB)
+    {
+        for (i = 0u; i < pCase->telegrams; i++)
+        {
+            stampData(gData);
+            (void) tlp_put(pEnd->appHandle, pEnd->pub[i], gData, pCase->size);
+        }
+    }
+    else if (pEnd->role == BENCH_MD_CALLER)
+    {
+        while (pEnd->outstanding < pCase->window)
+        {
+            TRDP_UUID_T sessionId;
+
+            stampData(gData);
+            if (tlm_request(pEnd->appHandle, pEnd, mdCallback, &sessionId, BENCH_MD_COMID, 0u, 0u, pEnd->ownIp,
+                            pEnd->peerIp, TRDP_FLAGS_CALLBACK, 1u, BENCH_REPLY_TO_US, NULL, gData, pCase->size,
+                            NULL, NULL) != TRDP_NO_ERR)
+            {
+                break;
+            }
+            pEnd->outstanding++;
+            gNumSent += gMeasure ? 1u : 0u;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Thread of one end: setup, process until stopped, close
+ */
+static void endThread (void *pArg)
+{
+    BENCH_END_T *pEnd = (BENCH_END_T *) pArg;
+
+#ifdef LINUX
+    if (pEnd->pNetNs != NULL)
+    {
+        char    path[256];
+        int     fd;
+
+        (void) snprintf(path, sizeof(path), "/var/run/netns/%s", pEnd->pNetNs);
+        fd = open(path, O_RDONLY);
+        if ((fd < 0) || (setns(fd, CLONE_NEWNET) != 0))
+        {
+            fprintf(stderr, "Cannot enter network namespace %s\n", pEnd->pNetNs);
+            pEnd->err = TRDP_PARAM_ERR;
+            vos_semaGive(pEnd->ready);
+            vos_semaGive(pEnd->done);
+            return;
+        }
+        (void) close(fd);
+    }
+#endif
+
+    pEnd->err = setup(pEnd);
+    vos_semaGive(pEnd->ready);
+
+    while ((pEnd->err == TRDP_NO_ERR) && !pEnd->stop)
+    {
+        TRDP_FDS_T  rfds;
+        INT32       noDesc  = 0;
+        TRDP_TIME_T tv;
+        TRDP_TIME_T maxTv   = {0, BENCH_POLL_US};
+        INT32       rv;
+
+        FD_ZERO(&rfds);
+        (void) tlc_getInterval(pEnd->appHandle, &tv, &rfds, &noDesc);
+        if (vos_cmpTime(&tv, &maxTv) > 0)
+        {
+            tv = maxTv;
+        }
+        /*  Queued MD is sent by the next tlc_process, do not wait for the poll time   */
+        if (((pEnd->role == BENCH_MD_CALLER) && (pEnd->outstanding < pEnd->pCase->window)) ||
+            ((pEnd->role == BENCH_MD_REPLIER) && (pEnd->outstanding > 0u)))
+        {
+            vos_clearTime(&tv);
+        }
+        rv = vos_select(noDesc + 1, &rfds, NULL, NULL, &tv);
+        sendWork(pEnd);
+        if (pEnd->role == BENCH_MD_REPLIER)
+        {
+            pEnd->outstanding = 0u;
+        }
+        (void) tlc_process(pEnd->appHandle, &rfds, &rv);
+    }
+    if (pEnd->appHandle != NULL)
+    {
+        (void) tlc_closeSession(pEnd->appHandle);
+    }
+    vos_semaGive(pEnd->done);
+}
+
+/**********************************************************************************************************************/
+/** Stop an end and wait until its session is closed
+ */
+static void stopEnd (BENCH_END_T *pEnd)
+{
+    pEnd->stop = TRUE;
+    (void) vos_semaTake(pEnd->done, VOS_SEMA_WAIT_FOREVER);
+    vos_semaDelete(pEnd->ready);
+    vos_semaDelete(pEnd->done);
+}
+
+/**********************************************************************************************************************/
+/** Start an end and wait until its telegrams are set up
+ */
+static int startEnd (BENCH_END_T *pEnd)
+{
+    VOS_THREAD_T thread;
+
+    if ((vos_semaCreate(&pEnd->ready, VOS_SEMA_EMPTY) != VOS_NO_ERR) ||
+        (vos_semaCreate(&pEnd->done, VOS_SEMA_EMPTY) != VOS_NO_ERR) ||
+        (vos_threadCreate(&thread, "benchEnd", VOS_THREAD_POLICY_OTHER, 0, 0u, 0u, endThread, pEnd) != VOS_NO_ERR))
+    {
+        fprintf(stderr, "Cannot start thread\n");
+        exit(1);
+    }
+    (void) vos_semaTake(pEnd->ready, VOS_SEMA_WAIT_FOREVER);
+    if (pEnd->err != TRDP_NO_ERR)
+    {
+        fprintf(stderr, "Setup failed (Err: %d)\n", pEnd->err);
+        stopEnd(pEnd);
+        return 1;
+    }
+    return 0;
+}
+
+/**********************************************************************************************************************/
+static UINT64 cpuTime (void)
+{
+    struct rusage usage;
+
+    (void) getrusage(RUSAGE_SELF, &usage);
+    return (UINT64) (usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000000u
+           + (UINT64) (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1000u;
+}
+
+/**********************************************************************************************************************/
+static int cmpU32 (const void *pA, const void *pB)
+{
+    UINT32 a = *(const UINT32 *) pA;
+    UINT32 b = *(const UINT32 *) pB;
+
+    return (a > b) - (a < b);
+}
+
+/**********************************************************************************************************************/
+/** Percentile of the sorted latency samples
+ */
+static UINT32 percentile (UINT32 permille)
+{
+    UINT32 rank;
+
+    if (gNumSamples == 0u)
+    {
+        return 0u;
+    }
+    rank = (UINT32) (((UINT64) gNumSamples * permille + 999u) / 1000u);
+    return gSamples[(rank > 0u) ? rank - 1u : 0u];
+}
+
+/**********************************************************************************************************************/
+/** Sum of the send lateness histograms of all publishers
+ */
+static void lateness (BENCH_END_T *pEnd, TRDP_HISTOGRAM_T *pSum)
+{
+    TRDP_HISTOGRAM_T    hist;
+    UINT32              i;
+    UINT32              j;
+
+    memset(pSum, 0, sizeof(TRDP_HISTOGRAM_T));
+    for (i = 0u; i < pEnd->pCase->telegrams; i++)
+    {
+        if (tlc_getPubHistogram(pEnd->appHandle, pEnd->pub[i], TRDP_HIST_SND_LATENESS, &hist) != TRDP_NO_ERR)
+        {
+            continue;
+        }
+        pSum->count += hist.count;
+        pSum->max   = (hist.max > pSum->max) ? hist.max : pSum->max;
+        for (j = 0u; j < TRDP_HIST_BUCKETS; j++)
+        {
+            pSum->bucket[j] += hist.bucket[j];
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+/** Run one case and write its CSV line
+ */
+static int runCase (
+    const BENCH_CASE_T  *pCase,
+    BOOL8               isPd,
+    TRDP_IP_ADDR_T      ownIp,
+    TRDP_IP_ADDR_T      targetIp,
+    const char          *pNetNs,
+    UINT32              durationMs)
+{
+    static BENCH_END_T  sender;
+    static BENCH_END_T  receiver;
+    TRDP_STATISTICS_T   stats;
+    TRDP_HISTOGRAM_T    jitterStart;
+    TRDP_HISTOGRAM_T    jitterEnd;
+    TRDP_TIME_T         start;
+    TRDP_TIME_T         end;
+    UINT64              cpu;
+    UINT64              elapsed;
+    UINT32              sent;
+    UINT32              rcvd;
+    UINT32              missed;
+    UINT32              i;
+
+    memset(&sender, 0, sizeof(sender));
+    memset(&receiver, 0, sizeof(receiver));
+    sender.role         = isPd ? BENCH_PD_PUB : BENCH_MD_CALLER;
+    sender.ownIp        = ownIp;
+    sender.peerIp       = targetIp;
+    sender.pCase        = pCase;
+    receiver.role       = isPd ? BENCH_PD_SUB : BENCH_MD_REPLIER;
+    receiver.ownIp      = targetIp;
+    receiver.peerIp     = ownIp;
+    receiver.pNetNs     = pNetNs;
+    receiver.pCase      = pCase;
+    gMeasure            = FALSE;
+
+    if (startEnd(&receiver) != 0)
+    {
+        return 1;
+    }
+    if (startEnd(&sender) != 0)
+    {
+        stopEnd(&receiver);
+        return 1;
+    }
+    (void) vos_threadDelay(BENCH_WARMUP_US);
+
+    /*  Measuring window    */
+    (void) tlc_getStatistics(sender.appHandle, &stats);
+    sent        = stats.pd.numSend;
+    (void) tlc_getStatistics(receiver.appHandle, &stats);
+    missed      = stats.pd.numMissed;
+    lateness(&sender, &jitterStart);
+    gNumSamples = 0u;
+    gNumRcvd    = 0u;
+    gNumSent    = 0u;
+    gNumTimeout = 0u;
+    cpu         = cpuTime();
+    vos_getTime(&start);
+    gMeasure    = TRUE;
+    (void) vos_threadDelay(durationMs * 1000u);
+    gMeasure    = FALSE;
+    vos_getTime(&end);
+    cpu         = cpuTime() - cpu;
+    rcvd        = gNumRcvd;
+    (void) tlc_getStatistics(sender.appHandle, &stats);
+    sent        = isPd ? stats.pd.numSend - sent : gNumSent;
+    (void) tlc_getStatistics(receiver.appHandle, &stats);
+    missed      = isPd ? stats.pd.numMissed - missed : gNumTimeout;
+    lateness(&sender, &jitterEnd);
+
+    stopEnd(&sender);
+    stopEnd(&receiver);
+
+    vos_subTime(&end, &start);
+    elapsed = (UINT64) end.tv_sec * 1000000u + (UINT64) end.tv_usec;
+    qsort(gSamples, gNumSamples, sizeof(UINT32), cmpU32);
+    jitterEnd.count -= jitterStart.count;
+    for (i = 0u; i < TRDP_HIST_BUCKETS; i++)
+    {
+        jitterEnd.bucket[i] -= jitterStart.bucket[i];
+    }
+
+    printf("%s,%u,%u,%u,%u,%llu,%u,%u,%u,%.0f,%.0f,%u,%u,%u,%u,%u,%u,%u\n",
+           isPd ? "pd" : "md", pCase->telegrams, pCase->size, pCase->cycle, pCase->window,
+           (unsigned long long) (elapsed / 1000u), sent, rcvd,
+           missed,
+           (elapsed != 0u) ? (double) rcvd * 1000000.0 / (double) elapsed : 0.0,
+           (rcvd != 0u) ? (double) cpu / (double) rcvd : 0.0,
+           percentile(500u), percentile(990u), percentile(999u), (gNumSamples != 0u) ? gSamples[gNumSamples - 1u] : 0u,
+           tlc_getHistogramPercentile(&jitterEnd, 500u), tlc_getHistogramPercentile(&jitterEnd, 990u),
+           (jitterEnd.count != 0u) ? jitterEnd.max : 0u);
+    fflush(stdout);
+    return 0;
+}
+
+/**********************************************************************************************************************/
+int main (int argc, char *argv[])
+{
+    TRDP_IP_ADDR_T      ownIp       = vos_dottedIP("127.0.0.1");
+    TRDP_IP_ADDR_T      targetIp    = vos_dottedIP("127.0.0.2");
+    const char          *pNetNs     = NULL;
+    UINT32              durationMs  = 1000u;
+    UINT32              window      = 1u;
+    BOOL8               doPd        = TRUE;
+    BOOL8               doMd        = TRUE;
+    BENCH_LIST_T        telegrams   = {{1u, 16u, 64u}, 3u};
+    BENCH_LIST_T        sizes       = {{64u, 1432u}, 2u};
+    BENCH_LIST_T        cycles      = {{10000u, 100000u}, 2u};
+    BENCH_LIST_T        mdSizes     = {{64u, 1024u, 16384u, 65000u}, 4u};
+    BENCH_CASE_T        benchCase   = {0u, 0u, 0u, 0u};
+    TRDP_MEM_CONFIG_T   memConfig   = {NULL, BENCH_MEM_SIZE, {0}};
+    UINT32              i, j, k;
+    int                 rc          = 0;
+    int                 ch;
+
+    while ((ch = getopt(argc, argv, "o:t:n:d:N:s:c:m:w:PMh?")) != -1)
+    {
+        int err = 0;
+
+        switch (ch)
+        {
+           case 'o':
+               ownIp = vos_dottedIP(optarg);
+               break;
+           case 't':
+               targetIp = vos_dottedIP(optarg);
+               break;
+           case 'n':
+               pNetNs = optarg;
+               break;
+           case 'd':
+               durationMs = (UINT32) strtoul(optarg, NULL, 10);
+               err = (durationMs == 0u);
+               break;
+           case 'N':
+               err = parseList(optarg, &telegrams, BENCH_MAX_TELEGRAMS);
+               break;
+           case 's':
+               err = parseList(optarg, &sizes, TRDP_MAX_PD_DATA_SIZE);
+               break;
+           case 'c':
+               err = parseList(optarg, &cycles, 10000000u);
+               break;
+           case 'm':
+               err = parseList(optarg, &mdSizes, TRDP_MAX_MD_DATA_SIZE);
+               break;
+           case 'w':
+               window = (UINT32) strtoul(optarg, NULL, 10);
+               err = (window == 0u);
+               break;
+           case 'P':
+               doMd = FALSE;
+               break;
+           case 'M':
+               doPd = FALSE;
+               break;
+           case 'h':
+           case '?':
+           default:
+               err = 1;
+               break;
+        }
+        if (err != 0)
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+    if ((ownIp == VOS_INADDR_ANY) || (targetIp == VOS_INADDR_ANY) || (ownIp == targetIp))
+    {
+        fprintf(stderr, "Two different IP addresses are needed\n");
+        return 1;
+    }
+
+    gSamples = (UINT32 *) malloc(BENCH_MAX_SAMPLES * sizeof(UINT32));
+    if ((gSamples == NULL) || (tlc_init(dbgOut, NULL, &memConfig) != TRDP_NO_ERR))
+    {
+        fprintf(stderr, "Initialisation failed\n");
+        return 1;
+    }
+
+    printf("kind,telegrams,size,cycle_us,window,duration_ms,sent,received,lost,pkt_per_s,cpu_ns_per_pkt,"
+           "lat_p50_us,lat_p99_us,lat_p999_us,lat_max_us,jitter_p50_us,jitter_p99_us,jitter_max_us\n");
+    for (i = 0u; doPd && (i < telegrams.count); i++)
+    {
+        for (j = 0u; j < sizes.count; j++)
+        {
+            for (k = 0u; k < cycles.count; k++)
+            {
+                benchCase.telegrams = telegrams.value[i];
+                benchCase.size      = (sizes.value[j] < BENCH_STAMP_SIZE) ? BENCH_STAMP_SIZE : sizes.value[j];
+                benchCase.cycle     = cycles.value[k];
+                benchCase.window    = 0u;
+                rc |= runCase(&benchCase, TRUE, ownIp, targetIp, pNetNs, durationMs);
+            }
+        }
+    }
+    for (i = 0u; doMd && (i < mdSizes.count); i++)
+    {
+        benchCase.telegrams = 1u;
+        benchCase.size      = (mdSizes.value[i] < BENCH_STAMP_SIZE) ? BENCH_STAMP_SIZE : mdSizes.value[i];
+        benchCase.cycle     = 0u;
+        benchCase.window    = window;
+        rc |= runCase(&benchCase, FALSE, ownIp, targetIp, pNetNs, durationMs);
+    }
+
+    (void) tlc_terminate();
+    free(gSamples);
+    return rc;
+}
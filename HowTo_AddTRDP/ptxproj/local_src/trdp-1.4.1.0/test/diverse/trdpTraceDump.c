@@ -0,0 +1,204 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdpTraceDump.c
+ *
+ * @brief           Dump the trace ring of a TRDP session as Chrome trace JSON
+ *
+ * @details         Attaches to the shared memory area given to tlc_startTrace and writes the events in the
+ *                  Trace Event Format read by chrome://tracing and Perfetto: the phases of tlc_process and the
+ *                  user callbacks as duration events, packets and timeouts as instant events.
+ *                  Without -t the events in the ring are dumped once, with -t the ring is followed for the given
+ *                  time so that more events than the ring holds are recorded.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "trdp_if_light.h"
+#include "vos_shared_mem.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define CHUNK_EVENTS    1024u
+#define POLL_US         10000u
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static const char *cPhaseNames[] =
+{
+    "tlc_process", "PD send", "PD timeouts", "MD send", "PD receive", "MD receive", "MD timeouts", "statistics"
+};
+
+static const char *cEventNames[] =
+{
+    "", "", "", "PD sent", "PD received", "PD timeout", "MD sent", "MD received", "MD timeout", "callback", "callback"
+};
+
+/**********************************************************************************************************************/
+static void usage (const char *appName)
+{
+    printf("Usage of %s\n", appName);
+    printf("Dump the trace of a TRDP session (started with tlc_startTrace) as Chrome trace JSON.\n"
+           "Arguments are:\n"
+           "-o <file>     output file, default stdout\n"
+           "-t <seconds>  follow the trace for this time, default: dump the ring once\n"
+           "-h            print usage\n"
+           "<key>         name of the trace area\n");
+}
+
+/**********************************************************************************************************************/
+/** Write one event
+ */
+static void writeEvent (FILE *pOut, const TRDP_TRACE_EVENT_T *pEvent, int *pFirst)
+{
+    unsigned long long ts = (unsigned long long) pEvent->sec * 1000000ull + pEvent->usec;
+
+    fprintf(pOut, "%s\n", (*pFirst) ? "" : ",");
+    *pFirst = 0;
+    switch (pEvent->type)
+    {
+       case TRDP_TRACE_BEGIN:
+       case TRDP_TRACE_END:
+           fprintf(pOut, "{\"name\":\"%s\",\"cat\":\"phase\",\"ph\":\"%s\",\"ts\":%llu,\"pid\":1,\"tid\":1}",
+                   (pEvent->phase < (sizeof(cPhaseNames) / sizeof(cPhaseNames[0]))) ? cPhaseNames[pEvent->phase]
+                   : "phase",
+                   (pEvent->type == TRDP_TRACE_BEGIN) ? "B" : "E", ts);
+           break;
+       case TRDP_TRACE_CB_BEGIN:
+       case TRDP_TRACE_CB_END:
+           fprintf(pOut, "{\"name\":\"callback\",\"cat\":\"callback\",\"ph\":\"%s\",\"ts\":%llu,\"pid\":1,\"tid\":1,"
+                   "\"args\":{\"comId\":%u}}",
+                   (pEvent->type == TRDP_TRACE_CB_BEGIN) ? "B" : "E", ts, pEvent->comId);
+           break;
+       default:
+           fprintf(pOut, "{\"name\":\"%s\",\"cat\":\"packet\",\"ph\":\"i\",\"s\":\"t\",\"ts\":%llu,\"pid\":1,"
+                   "\"tid\":1,\"args\":{\"comId\":%u,\"size\":%u}}",
+                   (pEvent->type < (sizeof(cEventNames) / sizeof(cEventNames[0]))) ? cEventNames[pEvent->type]
+                   : "event",
+                   ts, pEvent->comId, pEvent->size);
+           break;
+    }
+}
+
+/**********************************************************************************************************************/
+int main (int argc, char *argv[])
+{
+    VOS_SHRD_T          handle;
+    UINT8               *pArea;
+    UINT32              areaSize    = 0u;   /* attach only */
+    FILE                *pOut       = stdout;
+    const char          *pKey       = NULL;
+    UINT32              follow      = 0u;
+    UINT32              next        = 0u;
+    UINT32              lostTotal   = 0u;
+    UINT32              count       = 0u;
+    int                 first       = 1;
+    TRDP_TIME_T         deadline;
+    TRDP_TIME_T         now;
+    TRDP_TRACE_EVENT_T  *pEvents;
+    int                 ch;
+
+    while ((ch = getopt(argc, argv, "o:t:h?")) != -1)
+    {
+        switch (ch)
+        {
+           case 'o':
+               pOut = fopen(optarg, "w");
+               if (pOut == NULL)
+               {
+                   printf("Cannot open %s\n", optarg);
+                   return 1;
+               }
+               break;
+           case 't':
+               follow = (UINT32) strtoul(optarg, NULL, 10);
+               break;
+           case 'h':
+           case '?':
+           default:
+               usage(argv[0]);
+               return 1;
+        }
+    }
+    if (optind != argc - 1)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+    pKey = argv[optind];
+
+    pEvents = (TRDP_TRACE_EVENT_T *) malloc(CHUNK_EVENTS * sizeof(TRDP_TRACE_EVENT_T));
+    if ((pEvents == NULL) || (tlc_init(NULL, NULL, NULL) != TRDP_NO_ERR)
+        || (vos_sharedOpen(pKey, &handle, &pArea, &areaSize) != VOS_NO_ERR))
+    {
+        printf("Cannot attach to the trace area %s\n", pKey);
+        return 1;
+    }
+
+    vos_getTime(&deadline);
+    deadline.tv_sec += (long) follow;
+
+    fprintf(pOut, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[");
+    do
+    {
+        UINT32      noOfEvents  = CHUNK_EVENTS;
+        UINT32      lost        = 0u;
+        TRDP_ERR_T  err         = tlc_readTrace(pArea, areaSize, &next, pEvents, &noOfEvents, &lost);
+        UINT32      i;
+
+        if (err == TRDP_PARAM_ERR)
+        {
+            fprintf(stderr, "No valid trace in %s\n", pKey);
+            break;
+        }
+        for (i = 0u; i < noOfEvents; i++)
+        {
+            writeEvent(pOut, &pEvents[i], &first);
+        }
+        count       += noOfEvents;
+        lostTotal   += lost;
+        if (noOfEvents < CHUNK_EVENTS)
+        {
+            if (follow == 0u)
+            {
+                break;
+            }
+            (void) vos_threadDelay(POLL_US);
+        }
+        vos_getTime(&now);
+    }
+    while ((follow == 0u) || (vos_cmpTime(&now, &deadline) < 0));
+    fprintf(pOut, "\n],\"otherData\":{\"events\":%u,\"lost\":%u}}\n", count, lostTotal);
+
+    if (pOut != stdout)
+    {
+        (void) fclose(pOut);
+    }
+    (void) vos_sharedClose(handle, pArea);
+    (void) tlc_terminate();
+    free(pEvents);
+    return 0;
+}
@@ -0,0 +1,743 @@
+/**********************************************************************************************************************/
+/**
+ * @file            ttiCacheTest.c
+ *
+ * @brief           Offline test of the TTI cache and its change notification
+ *
+ * @details         A child process simulates the TTDB manager (ECSP) on 127.0.0.2: it publishes the operational train
+ *                  directory status info (PD 100) and answers the train directory, consist info, network directory
+ *                  and operational train directory requests. On SIGUSR1 the train changes its topology (the last
+ *                  consist is replaced by the next one) and the ECSP sends the operational train directory
+ *                  notification (MD 101).
+ *                  The parent accesses the TTI from 127.0.0.1 (own function ID 1 in consist 1) and checks the
+ *                  getters, the notifications and that only the changed consist info is requested again. Finally
+ *                  the prefetch has to bring all data of the next topology before the getters are called.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <sys/select.h>
+
+#include "trdp_if_light.h"
+#include "tau_dnr.h"
+#include "tau_tti.h"
+#include "iec61375-2-3.h"
+#include "vos_sock.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINES
+ */
+
+#define CLIENT_IP           vos_dottedIP("127.0.0.1")
+#define ECSP_IP             vos_dottedIP("127.0.0.2")
+#define HOSTS_FILE          "/tmp/ttiCacheTest.hosts"
+#define NO_OF_CST           4u
+#define VEH_PER_CST         2u
+#define LOOP_TIMEOUT_US     5000000u
+#define SETTLE_TIME_US      500000u
+#define STATUS_INFO_SIZE    72u
+
+#define CHECK(cond, text)   do { if (!(cond)) { printf("*** FAILED: %s (line %d)\n", (text), __LINE__); \
+                                                gFailed++; } } while (0)
+
+/***********************************************************************************************************************
+ * LOCALS
+ */
+
+static int                  gFailed;
+static UINT32               gEvents[TRDP_TTI_EVENT_TTDB_COMPLETE + 1];
+static UINT16               gCompleteCstCnt;
+static UINT8                gLastCstUUID[sizeof(TRDP_UUID_T)];
+static volatile sig_atomic_t gSwitch;
+
+/* The API takes full size labels */
+static TRDP_LABEL_T         gCst01      = "CST01";
+static TRDP_LABEL_T         gCst02      = "CST02";
+static TRDP_LABEL_T         gCst02lc    = "cst02";
+static TRDP_LABEL_T         gCst03      = "CST03";
+static TRDP_LABEL_T         gCst04      = "CST04";
+static TRDP_LABEL_T         gCst05      = "CST05";
+static TRDP_LABEL_T         gCst06      = "CST06";
+static TRDP_LABEL_T         gVeh02      = "VEH02.2";
+static TRDP_LABEL_T         gVeh03lc    = "veh03.2";
+
+/**********************************************************************************************************************/
+static void dbgOut (
+    void        *pRefCon,
+    TRDP_LOG_T  category,
+    const CHAR8 *pTime,
+    const CHAR8 *pFile,
+    UINT16      LineNumber,
+    const CHAR8 *pMsgStr)
+{
+    const char *catStr[] = {"**Error:", "Warning:", "   Info:", "  Debug:", "   User:"};
+
+    (void) pRefCon;
+    if ((category == VOS_LOG_ERROR) || (category == VOS_LOG_USR))
+    {
+        printf("%s %s %s:%d %s", pTime, catStr[category], pFile, LineNumber, pMsgStr);
+    }
+}
+
+/***********************************************************************************************************************
+ * Simulated TTDB manager
+ */
+
+/** Consist numbers of the train, each topology change replaces the last consist (4, 5, 6...) */
+static UINT8 stubCstNo (UINT32 topo, UINT32 pos)
+{
+    return (UINT8) ((pos == NO_OF_CST - 1u) ? NO_OF_CST + topo : pos + 1u);
+}
+
+static void stubUUID (UINT8 *pUUID, UINT32 cstNo)
+{
+    memset(pUUID, 0x55, sizeof(TRDP_UUID_T));
+    pUUID[0]    = (UINT8) (0x10u + cstNo);
+    pUUID[15]   = (UINT8) cstNo;
+}
+
+static UINT32 put16 (UINT8 *p, UINT32 val)
+{
+    p[0]    = (UINT8) (val >> 8u);
+    p[1]    = (UINT8) val;
+    return 2u;
+}
+
+static UINT32 put32 (UINT8 *p, UINT32 val)
+{
+    p[0]    = (UINT8) (val >> 24u);
+    p[1]    = (UINT8) (val >> 16u);
+    p[2]    = (UINT8) (val >> 8u);
+    p[3]    = (UINT8) val;
+    return 4u;
+}
+
+static UINT32 putLabel (UINT8 *p, const char *pFormat, UINT32 n)
+{
+    char label[TRDP_MAX_LABEL_LEN + 1u];
+
+    memset(p, 0, TRDP_MAX_LABEL_LEN);
+    (void) snprintf(label, sizeof(label), pFormat, n);
+    memcpy(p, label, strlen(label));
+    return TRDP_MAX_LABEL_LEN;
+}
+
+/** Operational train directory status info (PD 100) */
+static UINT32 stubStatusInfo (UINT8 *p, UINT32 topo)
+{
+    memset(p, 0, STATUS_INFO_SIZE);
+    p[0]    = 1u;
+    p[5]    = 2u;                                       /* confirmed */
+    p[6]    = 2u;                                       /* valid */
+    (void) putLabel(&p[8], "IC%u", 346u);
+    (void) putLabel(&p[24], "tcnopen.org", 0u);
+    (void) put32(&p[40], 0x40000u + topo);              /* opTrnTopoCnt */
+    (void) put32(&p[44], vos_sc32(0xFFFFFFFFu, p, 44u));
+    (void) put32(&p[48], 0x30000u + topo);              /* etbTopoCnt */
+    p[52]   = 1u;                                       /* ownOpCstNo */
+    p[53]   = 1u;                                       /* ownTrnCstNo */
+    return STATUS_INFO_SIZE;
+}
+
+/** Operational train directory (MD 101 / 109) */
+static UINT32 stubOpTrnDir (UINT8 *p, UINT32 topo)
+{
+    UINT32  pos = 8u;
+    UINT32  i, j;
+
+    memset(p, 0, 8u);
+    p[0]    = 1u;
+    p[3]    = 1u;
+    p[7]    = NO_OF_CST;
+    for (i = 0u; i < NO_OF_CST; i++)
+    {
+        stubUUID(&p[pos], stubCstNo(topo, i));
+        p[pos + 16u]    = (UINT8) (i + 1u);                             /* opCstNo */
+        p[pos + 17u]    = (UINT8) ((stubCstNo(topo, i) & 1u) ? 1u : 2u); /* opCstOrient */
+        p[pos + 18u]    = (UINT8) (i + 1u);                             /* trnCstNo */
+        p[pos + 19u]    = 0u;
+        pos += 20u;
+    }
+    p[pos++]    = 0u;
+    p[pos++]    = 0u;
+    p[pos++]    = 0u;
+    p[pos++]    = NO_OF_CST * VEH_PER_CST;
+    for (i = 0u; i < NO_OF_CST; i++)
+    {
+        for (j = 0u; j < VEH_PER_CST; j++)
+        {
+            if (j == 0u)
+            {
+                pos += putLabel(&p[pos], "CST%02u", stubCstNo(topo, i));
+            }
+            else
+            {
+                pos += putLabel(&p[pos], "VEH%02u.2", stubCstNo(topo, i));
+            }
+            memset(&p[pos], 0, 8u);
+            p[pos]      = (UINT8) (i * VEH_PER_CST + j + 1u);           /* opVehNo */
+            p[pos + 3u] = p[pos];                                       /* trnVehNo */
+            p[pos + 4u] = (UINT8) ((j == 0u) ? 1u : 2u);                /* vehOrient */
+            p[pos + 5u] = (UINT8) (i + 1u);                             /* ownOpCstNo */
+            pos += 8u;
+        }
+    }
+    pos += put32(&p[pos], 0x40000u + topo);
+    return pos;
+}
+
+/** Train directory (MD 103) */
+static UINT32 stubTrnDir (UINT8 *p, UINT32 topo)
+{
+    UINT32  pos = 4u;
+    UINT32  i;
+
+    p[0]    = 1u;
+    p[1]    = 0u;
+    p[2]    = 1u;
+    p[3]    = NO_OF_CST;
+    for (i = 0u; i < NO_OF_CST; i++)
+    {
+        stubUUID(&p[pos], stubCstNo(topo, i));
+        (void) put32(&p[pos + 16u], 0x1000u + stubCstNo(topo, i));     /* cstTopoCnt */
+        p[pos + 20u]    = (UINT8) (i + 1u);                             /* trnCstNo */
+        p[pos + 21u]    = 1u;
+        p[pos + 22u]    = 0u;
+        p[pos + 23u]    = 0u;
+        pos += 24u;
+    }
+    pos += put32(&p[pos], 0x50000u + topo);
+    return pos;
+}
+
+/** Train network directory (MD 107) */
+static UINT32 stubTrnNetDir (UINT8 *p, UINT32 topo)
+{
+    UINT32  pos = 4u;
+    UINT32  i;
+
+    (void) put16(&p[0], 0u);
+    (void) put16(&p[2], NO_OF_CST);
+    for (i = 0u; i < NO_OF_CST; i++)
+    {
+        stubUUID(&p[pos], stubCstNo(topo, i));
+        (void) put32(&p[pos + 16u], 0x00010101u * (i + 1u));
+        pos += 20u;
+    }
+    pos += put32(&p[pos], 0x30000u + topo);
+    return pos;
+}
+
+/** Consist info (MD 105) */
+static UINT32 stubCstInfo (UINT8 *p, UINT32 cstNo)
+{
+    UINT32  pos;
+    UINT32  fctCnt = (cstNo == 1u) ? 2u : 1u;
+    UINT32  i;
+
+    memset(p, 0, 76u);
+    p[0]    = 1u;
+    p[2]    = 1u;
+    (void) putLabel(&p[4], "CST%02u", cstNo);
+    (void) putLabel(&p[20], "Type%u", cstNo);
+    (void) putLabel(&p[36], "tcnopen.org", 0u);
+    stubUUID(&p[52], cstNo);
+    p[72]   = 1u;
+    (void) put16(&p[74], 4u);
+    pos     = 76u;
+    pos     += put32(&p[pos], 0xC0000000u | cstNo);       /* cstProp */
+
+    pos += put16(&p[pos], 0u);                          /* ETB list */
+    pos += put16(&p[pos], 1u);
+    p[pos++]    = 0u;
+    p[pos++]    = 1u;
+    pos += put16(&p[pos], 0u);
+
+    pos += put16(&p[pos], 0u);                          /* vehicle list */
+    pos += put16(&p[pos], VEH_PER_CST);
+    for (i = 0u; i < VEH_PER_CST; i++)
+    {
+        pos += putLabel(&p[pos], (i == 0u) ? "CST%02u" : "VEH%02u.2", cstNo);
+        pos += putLabel(&p[pos], "VehType%u", i);
+        p[pos++]    = 1u;
+        p[pos++]    = (UINT8) (i + 1u);
+        p[pos++]    = (UINT8) ((i == 0u) ? 2u : 1u);
+        p[pos++]    = 0u;
+        p[pos++]    = 1u;
+        p[pos++]    = 0u;
+        pos += put16(&p[pos], (i == 0u) ? 8u : 0u);
+        if (i == 0u)
+        {
+            pos += put32(&p[pos], 0xA0000000u | cstNo);
+            pos += put32(&p[pos], 0xB0000000u | cstNo);
+        }
+    }
+
+    pos += put16(&p[pos], 0u);                          /* function list */
+    pos += put16(&p[pos], fctCnt);
+    for (i = 0u; i < fctCnt; i++)
+    {
+        pos += putLabel(&p[pos], "dev%u", (cstNo == 1u) ? i + 1u : 0x100u + cstNo);
+        pos += put16(&p[pos], (cstNo == 1u) ? i + 1u : 0x100u + cstNo);
+        p[pos++]    = 0u;
+        p[pos++]    = 0u;
+        p[pos++]    = (UINT8) ((cstNo == 1u) && (i == 0u) ? 2u : 1u);    /* dev1 lives in the second vehicle */
+        p[pos++]    = 0u;
+        p[pos++]    = 0u;
+        p[pos++]    = 0u;
+    }
+
+    pos += put16(&p[pos], 0u);                          /* closed train list */
+    pos += put16(&p[pos], 0u);
+    pos += put32(&p[pos], 0x1000u + cstNo);             /* cstTopoCnt */
+    return pos;
+}
+
+/**********************************************************************************************************************/
+/** ECSP stub: reply to the TTDB requests
+ */
+static void stubMDCallback (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    static UINT8    reply[4096];
+    UINT32          topo    = *(const UINT32 *) pMsg->pUserRef;
+    UINT32          size    = 0u;
+    UINT32          i;
+
+    (void) pRefCon;
+    if (pMsg->msgType != TRDP_MSG_MR)
+    {
+        return;
+    }
+    switch (pMsg->comId)
+    {
+        case TTDB_TRN_DIR_REQ_COMID:
+            size = stubTrnDir(reply, topo);
+            break;
+        case TTDB_NET_DIR_REQ_COMID:
+            size = stubTrnNetDir(reply, topo);
+            break;
+        case TTDB_OP_DIR_INFO_REQ_COMID:
+            size = stubOpTrnDir(reply, topo);
+            break;
+        case TTDB_STAT_CST_REQ_COMID:
+            for (i = 0u; (i < NO_OF_CST) && (pData != NULL) && (dataSize >= sizeof(TRDP_UUID_T)); i++)
+            {
+                UINT8 uuid[sizeof(TRDP_UUID_T)];
+
+                stubUUID(uuid, stubCstNo(topo, i));
+                if (memcmp(uuid, pData, sizeof(uuid)) == 0)
+                {
+                    size = stubCstInfo(reply, stubCstNo(topo, i));
+                }
+            }
+            break;
+        default:
+            break;
+    }
+    if (size > 0u)
+    {
+        (void) tlm_reply(appHandle, &pMsg->sessionId, pMsg->comId + 1u, 0u, NULL, reply, size);
+    }
+}
+
+static void stubSignal (int sig)
+{
+    (void) sig;
+    gSwitch = 1;
+}
+
+/**********************************************************************************************************************/
+/** Simulated TTDB manager, run until killed
+ */
+static void stubServer (void)
+{
+    static UINT32           topo;
+    static const UINT32     reqComId[] = {TTDB_TRN_DIR_REQ_COMID, TTDB_STAT_CST_REQ_COMID, TTDB_NET_DIR_REQ_COMID,
+                                          TTDB_OP_DIR_INFO_REQ_COMID};
+    TRDP_APP_SESSION_T      appHandle;
+    TRDP_LIS_T              listenHandle;
+    TRDP_PUB_T              pubHandle;
+    TRDP_MEM_CONFIG_T       memConfig       = {NULL, 0, {0}};
+    TRDP_PROCESS_CONFIG_T   processConfig   = {"TTDBStub", "", 0, 0, TRDP_OPTION_BLOCK};
+    UINT8                   data[2048];
+    UINT32                  i;
+
+    (void) signal(SIGUSR1, stubSignal);
+    if ((tlc_init(dbgOut, NULL, &memConfig) != TRDP_NO_ERR) ||
+        (tlc_openSession(&appHandle, ECSP_IP, 0, NULL, NULL, NULL, &processConfig) != TRDP_NO_ERR) ||
+        (tlp_publish(appHandle, &pubHandle, NULL, NULL, TTDB_STATUS_COMID, 0u, 0u, ECSP_IP,
+                     vos_dottedIP(TTDB_STATUS_DEST_IP), 100000u, 0u, TRDP_FLAGS_NONE, NULL,
+                     data, stubStatusInfo(data, topo)) != TRDP_NO_ERR))
+    {
+        printf("*** TTDB stub not started\n");
+        _exit(1);
+    }
+    (void) tlc_setETBTopoCount(appHandle, 0x30000u + topo);
+    (void) tlc_setOpTrainTopoCount(appHandle, 0x40000u + topo);
+    for (i = 0u; i < sizeof(reqComId) / sizeof(reqComId[0]); i++)
+    {
+        if (tlm_addListener(appHandle, &listenHandle, &topo, stubMDCallback, TRUE, reqComId[i], 0u, 0u,
+                            VOS_INADDR_ANY, VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK,
+                            NULL, NULL) != TRDP_NO_ERR)
+        {
+            printf("*** TTDB stub not started\n");
+            _exit(1);
+        }
+    }
+
+    for (;; )
+    {
+        TRDP_FDS_T  rfds;
+        INT32       noDesc = 0;
+        TRDP_TIME_T tv;
+        TRDP_TIME_T maxTv = {0, 10000};
+        INT32       rv;
+
+        if (gSwitch != 0)
+        {
+            gSwitch = 0;
+            topo++;
+            (void) tlc_setETBTopoCount(appHandle, 0x30000u + topo);
+            (void) tlc_setOpTrainTopoCount(appHandle, 0x40000u + topo);
+            (void) tlp_put(appHandle, pubHandle, data, stubStatusInfo(data, topo));
+            (void) tlm_notify(appHandle, NULL, NULL, TTDB_OP_DIR_INFO_COMID, 0u, 0u, ECSP_IP,
+                              vos_dottedIP(TTDB_OP_DIR_INFO_IP), TRDP_FLAGS_NONE, NULL,
+                              data, stubOpTrnDir(data, topo), NULL, NULL);
+        }
+        FD_ZERO(&rfds);
+        (void) tlc_getInterval(appHandle, &tv, &rfds, &noDesc);
+        if (vos_cmpTime(&tv, &maxTv) > 0)
+        {
+            tv = maxTv;                                 /* replies are sent by the next tlc_process */
+        }
+        rv = vos_select(noDesc + 1, &rfds, NULL, NULL, &tv);
+        (void) tlc_process(appHandle, &rfds, &rv);
+    }
+}
+
+/***********************************************************************************************************************
+ * TTI client
+ */
+
+static void ttiEvent (
+    void                *pRefCon,
+    TRDP_APP_SESSION_T  appHandle,
+    TRDP_TTI_EVENT_T    event,
+    const TRDP_UUID_T   cstUUID)
+{
+    (void) pRefCon;
+    (void) appHandle;
+    gEvents[event]++;
+    if (event == TRDP_TTI_EVENT_CST_INFO)
+    {
+        memcpy(gLastCstUUID, cstUUID, sizeof(gLastCstUUID));
+    }
+    else if ((event == TRDP_TTI_EVENT_TTDB_COMPLETE) &&
+             (tau_getTrnCstCnt(appHandle, &gCompleteCstCnt) != TRDP_NO_ERR))
+    {
+        gCompleteCstCnt = 0u;
+    }
+}
+
+/**********************************************************************************************************************/
+/** Process the session, and with it the resolver, until the given number of events has arrived or the time is over
+ */
+static void runUntil (TRDP_APP_SESSION_T appHandle, TRDP_TTI_EVENT_T event, UINT32 noOfEvents, UINT32 timeoutUs)
+{
+    TRDP_TIME_T deadline;
+    TRDP_TIME_T now;
+    TRDP_TIME_T timeout = {timeoutUs / 1000000u, timeoutUs % 1000000u};
+
+    vos_getTime(&deadline);
+    vos_addTime(&deadline, &timeout);
+    do
+    {
+        TRDP_FDS_T  rfds;
+        INT32       noDesc = 0;
+        TRDP_TIME_T tv;
+        TRDP_TIME_T maxTv = {0, 10000};
+        INT32       rv;
+
+        FD_ZERO(&rfds);
+        (void) tlc_getInterval(appHandle, &tv, &rfds, &noDesc);
+        if (vos_cmpTime(&tv, &maxTv) > 0)
+        {
+            tv = maxTv;                                 /* requests queued by callbacks */
+        }
+        rv = vos_select(noDesc + 1, &rfds, NULL, NULL, &tv);
+        (void) tlc_process(appHandle, &rfds, &rv);
+        vos_getTime(&now);
+    }
+    while ((gEvents[event] < noOfEvents) && (vos_cmpTime(&now, &deadline) < 0));
+}
+
+static UINT32 mdSent (TRDP_APP_SESSION_T appHandle)
+{
+    TRDP_STATISTICS_T stats;
+
+    (void) tlc_getStatistics(appHandle, &stats);
+    return stats.udpMd.numSend;
+}
+
+/**********************************************************************************************************************/
+/** Directories and consist infos of the first topology
+ */
+static void testGetters (TRDP_APP_SESSION_T appHandle)
+{
+    TRDP_OP_TRAIN_DIR_STATUS_INFO_T statusInfo;
+    TRDP_OP_TRAIN_DIR_STATE_T       opTrnState;
+    static TRDP_OP_TRAIN_DIR_T      opTrnDir;
+    static TRDP_TRAIN_DIR_T         trnDir;
+    TRDP_CONSIST_INFO_T             cstInfo;
+    TRDP_VEHICLE_INFO_T             vehInfo;
+    TRDP_FUNCTION_INFO_T            fctInfo[4];
+    TRDP_LABEL_T                    devId, vehId, cstId;
+    UINT8                           uuid[sizeof(TRDP_UUID_T)];
+    UINT8                           vehOrient, cstOrient;
+    UINT16                          cnt;
+    UINT32                          numSend;
+
+    /* PD 100 */
+    runUntil(appHandle, TRDP_TTI_EVENT_OP_TRN_STATE, 1u, LOOP_TIMEOUT_US);
+    CHECK(gEvents[TRDP_TTI_EVENT_OP_TRN_STATE] >= 1u, "no status info event");
+    CHECK((tau_getOpTrnDirectoryStatusInfo(appHandle, &statusInfo) == TRDP_NO_ERR) &&
+          (statusInfo.ownTrnCstNo == 1u) && (statusInfo.etbTopoCnt == 0x30000u) &&
+          (statusInfo.state.opTrnTopoCnt == 0x40000u), "status info");
+
+    /* The train directory brings the consist infos, outstanding requests are not repeated */
+    numSend = mdSent(appHandle);
+    CHECK(tau_getTrDirectory(appHandle, &trnDir) == TRDP_NODATA_ERR, "train directory available too early");
+    CHECK(tau_getTrnCstCnt(appHandle, &cnt) == TRDP_NODATA_ERR, "train directory available too early");
+    CHECK(mdSent(appHandle) - numSend == 1u, "request repeated");
+    runUntil(appHandle, TRDP_TTI_EVENT_CST_INFO, NO_OF_CST, LOOP_TIMEOUT_US);
+    CHECK(gEvents[TRDP_TTI_EVENT_TRN_DIR] == 1u, "train directory event");
+    CHECK(gEvents[TRDP_TTI_EVENT_CST_INFO] == NO_OF_CST, "consist info events");
+    CHECK(mdSent(appHandle) - numSend == 1u + NO_OF_CST, "number of requests");
+    CHECK((tau_getTrDirectory(appHandle, &trnDir) == TRDP_NO_ERR) && (trnDir.cstCnt == NO_OF_CST) &&
+          (trnDir.trnTopoCnt == 0x50000u) && (trnDir.cstList[1].cstTopoCnt == 0x1002u), "train directory");
+    CHECK((tau_getTrnCstCnt(appHandle, &cnt) == TRDP_NO_ERR) && (cnt == NO_OF_CST), "consist count");
+
+    /* Operational train directory */
+    CHECK(tau_getOpTrDirectory(appHandle, &opTrnState, &opTrnDir) == TRDP_NODATA_ERR,
+          "operational directory available too early");
+    runUntil(appHandle, TRDP_TTI_EVENT_OP_TRN_DIR, 1u, LOOP_TIMEOUT_US);
+    CHECK((tau_getOpTrDirectory(appHandle, &opTrnState, &opTrnDir) == TRDP_NO_ERR) &&
+          (opTrnDir.opCstCnt == NO_OF_CST) && (opTrnDir.opVehCnt == NO_OF_CST * VEH_PER_CST) &&
+          (opTrnDir.opTrnTopoCnt == 0x40000u), "operational directory");
+    CHECK((tau_getTrnVehCnt(appHandle, &cnt) == TRDP_NO_ERR) && (cnt == NO_OF_CST * VEH_PER_CST), "vehicle count");
+
+    /* Consist infos from the cache, labels are case insensitive */
+    numSend = mdSent(appHandle);
+    CHECK((tau_getCstInfo(appHandle, &cstInfo, gCst02lc) == TRDP_NO_ERR) &&
+          (cstInfo.vehCnt == VEH_PER_CST) && (cstInfo.fctCnt == 1u) && (cstInfo.etbCnt == 1u) &&
+          (cstInfo.cstTopoCnt == 0x1002u) && (cstInfo.cstProp.len == 4u) &&
+          (strcmp(cstInfo.pVehInfoList[1].vehId, "VEH02.2") == 0) &&
+          (cstInfo.pVehInfoList[0].vehProp.len == 8u) &&
+          (cstInfo.pFctInfoList[0].fctId == 0x102u), "consist info");
+    CHECK((tau_getCstVehCnt(appHandle, &cnt, gCst03) == TRDP_NO_ERR) && (cnt == VEH_PER_CST), "vehicle count");
+    CHECK((tau_getCstFctCnt(appHandle, &cnt, NULL) == TRDP_NO_ERR) && (cnt == 2u), "function count");
+    CHECK((tau_getCstFctInfo(appHandle, fctInfo, NULL, 4u) == TRDP_NO_ERR) &&
+          (fctInfo[1].fctId == 2u) && (strcmp(fctInfo[1].fctName, "dev2") == 0), "function info");
+    CHECK((tau_getVehInfo(appHandle, &vehInfo, gVeh03lc, gCst03) == TRDP_NO_ERR) &&
+          (vehInfo.cstVehNo == 2u), "vehicle info");
+    CHECK(tau_getVehInfo(appHandle, &vehInfo, gVeh02, gCst03) == TRDP_PARAM_ERR, "vehicle of other consist");
+    CHECK((tau_getVehInfo(appHandle, &vehInfo, NULL, NULL) == TRDP_NO_ERR) &&
+          (strcmp(vehInfo.vehId, "VEH01.2") == 0), "own vehicle info");
+    stubUUID(uuid, 4u);
+    CHECK((tau_getStaticCstInfo(appHandle, &cstInfo, uuid) == TRDP_NO_ERR) &&
+          (strcmp(cstInfo.cstId, "CST04") == 0), "static consist info");
+    CHECK((tau_getVehOrient(appHandle, &vehOrient, &cstOrient, gCst02, gCst02) == TRDP_NO_ERR) &&
+          (vehOrient == 1u) && (cstOrient == 2u), "vehicle orientation");
+    CHECK((tau_getVehOrient(appHandle, &vehOrient, &cstOrient, NULL, NULL) == TRDP_NO_ERR) &&
+          (vehOrient == 2u) && (cstOrient == 1u), "own vehicle orientation");
+    CHECK(mdSent(appHandle) == numSend, "cached data requested");
+
+    /* Who am I */
+    CHECK(tau_getOwnIds(appHandle, &devId, &vehId, &cstId) == TRDP_NODATA_ERR, "network directory too early");
+    runUntil(appHandle, TRDP_TTI_EVENT_TRN_NET_DIR, 1u, LOOP_TIMEOUT_US);
+    CHECK((tau_getOwnIds(appHandle, &devId, &vehId, &cstId) == TRDP_NO_ERR) &&
+          (strcmp(devId, "dev1") == 0) && (strcmp(vehId, "VEH01.2") == 0) && (strcmp(cstId, "CST01") == 0),
+          "own IDs");
+}
+
+/**********************************************************************************************************************/
+/** Topology change: only the new consist info is requested
+ */
+static void testTopologyChange (TRDP_APP_SESSION_T appHandle, pid_t pid)
+{
+    TRDP_CONSIST_INFO_T cstInfo;
+    TRDP_VEHICLE_INFO_T *pVehList;
+    static TRDP_TRAIN_DIR_T trnDir;
+    UINT8               uuid[sizeof(TRDP_UUID_T)];
+    UINT32              numSend;
+
+    CHECK(tau_getCstInfo(appHandle, &cstInfo, gCst01) == TRDP_NO_ERR, "consist info");
+    pVehList = cstInfo.pVehInfoList;
+
+    memset(gEvents, 0, sizeof(gEvents));
+    numSend = mdSent(appHandle);
+    (void) kill(pid, SIGUSR1);
+    runUntil(appHandle, TRDP_TTI_EVENT_OP_TRN_DIR, 1u, LOOP_TIMEOUT_US);
+    CHECK(gEvents[TRDP_TTI_EVENT_OP_TRN_DIR] == 1u, "operational directory notification");
+    runUntil(appHandle, TRDP_TTI_EVENT_OP_TRN_STATE, 1u, LOOP_TIMEOUT_US);
+    CHECK(gEvents[TRDP_TTI_EVENT_OP_TRN_STATE] >= 1u, "status info event");
+
+    CHECK(tau_getTrDirectory(appHandle, &trnDir) == TRDP_NODATA_ERR, "outdated train directory");
+    runUntil(appHandle, TRDP_TTI_EVENT_CST_INFO, 1u, LOOP_TIMEOUT_US);
+    runUntil(appHandle, TRDP_TTI_EVENT_CST_INFO, 2u, SETTLE_TIME_US);   /* wait for unexpected ones */
+    CHECK(gEvents[TRDP_TTI_EVENT_TRN_DIR] == 1u, "train directory event");
+    CHECK(gEvents[TRDP_TTI_EVENT_CST_INFO] == 1u, "consist info events");
+    stubUUID(uuid, 5u);
+    CHECK(memcmp(gLastCstUUID, uuid, sizeof(uuid)) == 0, "new consist");
+    CHECK(mdSent(appHandle) - numSend == 2u, "consist infos requested again");
+
+    CHECK((tau_getCstInfo(appHandle, &cstInfo, gCst05) == TRDP_NO_ERR) && (cstInfo.cstTopoCnt == 0x1005u),
+          "new consist info");
+    CHECK((tau_getCstInfo(appHandle, &cstInfo, gCst01) == TRDP_NO_ERR) && (cstInfo.pVehInfoList == pVehList),
+          "unchanged consist info replaced");
+    CHECK(tau_getCstInfo(appHandle, &cstInfo, gCst04) == TRDP_NODATA_ERR, "removed consist info");
+    stubUUID(uuid, 4u);
+    numSend = mdSent(appHandle);
+    CHECK(tau_getStaticCstInfo(appHandle, &cstInfo, uuid) == TRDP_NODATA_ERR, "removed consist info");
+    CHECK(mdSent(appHandle) - numSend == 1u, "consist info not requested");
+}
+
+/**********************************************************************************************************************/
+/** Prefetch: a topology change brings all directories and consist infos without calling a getter
+ */
+static void testPrefetch (TRDP_APP_SESSION_T appHandle, pid_t pid)
+{
+    TRDP_OP_TRAIN_DIR_STATE_T   opTrnState;
+    static TRDP_OP_TRAIN_DIR_T  opTrnDir;
+    static TRDP_TRAIN_DIR_T     trnDir;
+    TRDP_CONSIST_INFO_T         cstInfo;
+    TRDP_LABEL_T                devId, vehId, cstId;
+    UINT8                       uuid[sizeof(TRDP_UUID_T)];
+    UINT32                      numSend;
+    UINT32                      i;
+
+    /* Only the network directory of the current topology is missing */
+    memset(gEvents, 0, sizeof(gEvents));
+    numSend = mdSent(appHandle);
+    CHECK(tau_setTTIprefetch(appHandle, TRUE) == TRDP_NO_ERR, "tau_setTTIprefetch");
+    runUntil(appHandle, TRDP_TTI_EVENT_TTDB_COMPLETE, 1u, LOOP_TIMEOUT_US);
+    CHECK(gEvents[TRDP_TTI_EVENT_TTDB_COMPLETE] == 1u, "prefetch of the current topology not complete");
+    CHECK(mdSent(appHandle) - numSend == 1u, "prefetch of the current topology");
+
+    memset(gEvents, 0, sizeof(gEvents));
+    gCompleteCstCnt = 0u;
+    numSend = mdSent(appHandle);
+    (void) kill(pid, SIGUSR1);
+    runUntil(appHandle, TRDP_TTI_EVENT_TTDB_COMPLETE, 1u, LOOP_TIMEOUT_US);
+    runUntil(appHandle, TRDP_TTI_EVENT_TTDB_COMPLETE, 2u, SETTLE_TIME_US);
+    CHECK(gEvents[TRDP_TTI_EVENT_TTDB_COMPLETE] == 1u, "prefetch complete event");
+    CHECK(gCompleteCstCnt == NO_OF_CST, "getter called from the complete event");
+    CHECK(gEvents[TRDP_TTI_EVENT_CST_INFO] == 1u, "consist info events");
+    stubUUID(uuid, 6u);
+    CHECK(memcmp(gLastCstUUID, uuid, sizeof(uuid)) == 0, "new consist");
+
+    /* 102, 104 and 106, the operational directory is requested if PD 100 comes before MD 101 */
+    CHECK((mdSent(appHandle) - numSend >= 3u) && (mdSent(appHandle) - numSend <= 4u), "prefetch requests");
+
+    /* Everything is cached now */
+    numSend = mdSent(appHandle);
+    CHECK((tau_getTrDirectory(appHandle, &trnDir) == TRDP_NO_ERR) && (trnDir.trnTopoCnt == 0x50002u),
+          "prefetched train directory");
+    CHECK((tau_getOpTrDirectory(appHandle, &opTrnState, &opTrnDir) == TRDP_NO_ERR) &&
+          (opTrnDir.opTrnTopoCnt == 0x40002u), "prefetched operational directory");
+    for (i = 0u; i < NO_OF_CST; i++)
+    {
+        CHECK(tau_getStaticCstInfo(appHandle, &cstInfo, trnDir.cstList[i].cstUUID) == TRDP_NO_ERR,
+              "prefetched consist info");
+    }
+    CHECK((tau_getCstInfo(appHandle, &cstInfo, gCst06) == TRDP_NO_ERR) && (cstInfo.cstTopoCnt == 0x1006u),
+          "prefetched consist info");
+    CHECK((tau_getOwnIds(appHandle, &devId, &vehId, &cstId) == TRDP_NO_ERR) && (strcmp(cstId, "CST01") == 0),
+          "own IDs");
+    CHECK(mdSent(appHandle) == numSend, "prefetched data requested");
+    CHECK(tau_setTTIprefetch(appHandle, FALSE) == TRDP_NO_ERR, "tau_setTTIprefetch");
+}
+
+/**********************************************************************************************************************/
+int main (void)
+{
+    TRDP_APP_SESSION_T      appHandle;
+    TRDP_MEM_CONFIG_T       memConfig       = {NULL, 0, {0}};
+    TRDP_PROCESS_CONFIG_T   processConfig   = {"TTIClient", "", 0, 0, TRDP_OPTION_BLOCK};
+    FILE                    *fp;
+    pid_t                   pid;
+
+    fp = fopen(HOSTS_FILE, "w");
+    if (fp == NULL)
+    {
+        printf("hosts file not written\n");
+        return 1;
+    }
+    fprintf(fp, "127.0.0.2 %s\n127.0.0.2 %s\n", TTDB_TRN_DIR_REQ_URI, TTDB_NET_DIR_REQ_URI);
+    fclose(fp);
+
+    pid = fork();
+    if (pid == 0)
+    {
+        stubServer();
+    }
+    if (pid < 0)
+    {
+        printf("fork failed\n");
+        return 1;
+    }
+    (void) vos_threadDelay(200000u);                    /* let the stub start */
+
+    if ((tlc_init(dbgOut, NULL, &memConfig) != TRDP_NO_ERR) ||
+        (tlc_openSession(&appHandle, CLIENT_IP, 0, NULL, NULL, NULL, &processConfig) != TRDP_NO_ERR))
+    {
+        printf("*** session not opened\n");
+        (void) kill(pid, SIGTERM);
+        return 1;
+    }
+    CHECK(tau_initDnr(appHandle, ECSP_IP, 0u, HOSTS_FILE, TRDP_DNR_COMMON_THREAD) == TRDP_NO_ERR, "tau_initDnr");
+    CHECK(tau_initTTIaccess(appHandle, NULL, ECSP_IP, NULL) == TRDP_NO_ERR, "tau_initTTIaccess");
+    CHECK(tau_setTTIcallback(appHandle, ttiEvent, NULL) == TRDP_NO_ERR, "tau_setTTIcallback");
+
+    testGetters(appHandle);
+    testTopologyChange(appHandle, pid);
+    testPrefetch(appHandle, pid);
+
+    tau_deInitTTI(appHandle);
+    tau_deInitDnr(appHandle);
+    (void) kill(pid, SIGTERM);
+    (void) waitpid(pid, NULL, 0);
+    (void) tlc_closeSession(appHandle);
+    (void) tlc_terminate();
+    (void) remove(HOSTS_FILE);
+
+    printf("%s\n", (gFailed == 0) ? "TTI cache test: Success" : "TTI cache test: FAILED");
+    return (gFailed == 0) ? 0 : 1;
+}
@@ -0,0 +1,150 @@
+/**********************************************************************************************************************/
+/**
+ * @file            dualSubnetRxTest.c
+ *
+ * @brief           Copy check of the ladder dual subnet receive
+ *
+ * @details         Feeds the telegrams of one publisher, as received on Subnet1 and Subnet2, to
+ *                  tau_checkDualSubnetRx() and checks that every update reaches the Traffic Store exactly once and
+ *                  in order. The sequence counters of the two subnets are unrelated: equal, far apart, drifting.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifdef TRDP_OPTION_LADDER
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "vos_types.h"
+#include "tau_ladder.h"
+
+/***********************************************************************************************************************
+ * DEFINITIONS
+ */
+
+#define TEST_UPDATES            200u
+#define TEST_DATA_SIZE          32u
+
+typedef struct
+{
+    TAU_DUAL_RX_T   dualRx;
+    UINT32          written;            /* updates written to the Traffic Store */
+    UINT32          lastValue;          /* value of the last update written */
+    UINT32          dropped;            /* copies and repeats */
+    UINT32          restarts;
+    int             outOfOrder;
+} TEST_RX_T;
+
+/**********************************************************************************************************************/
+/* Receive the telegram carrying value on a subnet */
+static void receive (TEST_RX_T *pRx, UINT32 subnetIndex, UINT32 seqCount, UINT32 value)
+{
+    UINT8 data[TEST_DATA_SIZE];
+
+    memset(data, 0, sizeof(data));
+    memcpy(data, &value, sizeof(value));
+    switch (tau_checkDualSubnetRx(&pRx->dualRx, subnetIndex, seqCount, data, sizeof(data)))
+    {
+        case TAU_DUAL_RX_RESTART:
+            pRx->restarts++;
+            /* FALLTHRU */
+        case TAU_DUAL_RX_UPDATE:
+            if ((pRx->written != 0u) && (value <= pRx->lastValue))
+            {
+                pRx->outOfOrder = 1;
+            }
+            pRx->written++;
+            pRx->lastValue = value;
+            break;
+        default:
+            pRx->dropped++;
+            break;
+    }
+}
+
+/**********************************************************************************************************************/
+/* One publisher, both subnets, seqOffset between the counters, Subnet2 lagging lag updates behind */
+static int runCase (const CHAR8 *pName, UINT32 seq1, UINT32 seq2, UINT32 lag, BOOL8 repeat)
+{
+    TEST_RX_T   rx;
+    UINT32      i;
+
+    memset(&rx, 0, sizeof(rx));
+    for (i = 0u; i < TEST_UPDATES + lag; i++)
+    {
+        if (i < TEST_UPDATES)
+        {
+            receive(&rx, 0u, seq1 + i, i + 1u);
+            if (repeat == TRUE)
+            {
+                receive(&rx, 0u, seq1 + i, i + 1u);
+            }
+        }
+        if (i >= lag)
+        {
+            receive(&rx, 1u, seq2 + i - lag, i - lag + 1u);
+        }
+    }
+    printf("%-28s written %4u  dropped %4u  restarts %u\n", pName, rx.written, rx.dropped, rx.restarts);
+    if ((rx.written != TEST_UPDATES) || (rx.outOfOrder != 0) || (rx.restarts != 0u))
+    {
+        printf("### %s: every update must be written once, in order\n", pName);
+        return 1;
+    }
+    return 0;
+}
+
+/**********************************************************************************************************************/
+int main (void)
+{
+    TEST_RX_T   rx;
+    int         rc = 0;
+
+    rc |= runCase("equal counters", 100u, 100u, 0u, FALSE);
+    rc |= runCase("counters 5000 apart", 100u, 5100u, 0u, FALSE);
+    rc |= runCase("counters wrapping apart", 0xFFFFFFF0u, 7u, 0u, FALSE);
+    rc |= runCase("Subnet2 3 updates behind", 100u, 100u, 3u, FALSE);
+    rc |= runCase("apart and 10 behind", 100u, 40000u, 10u, FALSE);
+    rc |= runCase("repeats on Subnet1", 100u, 900u, 2u, TRUE);
+
+    /* The same data updated again is written again, its copy is dropped once */
+    memset(&rx, 0, sizeof(rx));
+    receive(&rx, 0u, 10u, 1u);
+    receive(&rx, 1u, 70u, 1u);
+    receive(&rx, 1u, 71u, 1u);
+    receive(&rx, 0u, 11u, 1u);
+    if ((rx.written != 2u) || (rx.dropped != 2u))
+    {
+        printf("### unchanged data: %u written, %u dropped\n", rx.written, rx.dropped);
+        rc = 1;
+    }
+
+    /* A restart is detected on the subnet it happened on only */
+    memset(&rx, 0, sizeof(rx));
+    receive(&rx, 0u, 1000u, 1u);
+    receive(&rx, 1u, 50u, 1u);
+    receive(&rx, 0u, 1u, 2u);
+    receive(&rx, 1u, 51u, 2u);
+    if ((rx.written != 2u) || (rx.restarts != 1u))
+    {
+        printf("### restart: %u written, %u restarts\n", rx.written, rx.restarts);
+        rc = 1;
+    }
+
+    printf("%s\n", (rc == 0) ? "Dual subnet receive test: Success" : "Dual subnet receive test: FAILED");
+    return rc;
+}
+#endif /* TRDP_OPTION_LADDER */
@@ -0,0 +1,251 @@
+/**********************************************************************************************************************/
+/**
+ * @file            linkMonitorTest.c
+ *
+ * @brief           Subnet switchover latency of the ladder link monitor
+ *
+ * @details         Two veth pairs stand in for the Subnet1 and Subnet2 interfaces. The Subnet1 link is taken down
+ *                  repeatedly, and the test measures how long it takes until the posted link loss has moved the
+ *                  network context to Subnet2. The test takes the place of TAULpdMainThread, the only thread
+ *                  switching the context. Needs CAP_NET_ADMIN and the ip tool, e.g. run as root in a scratch
+ *                  network namespace.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifdef TRDP_OPTION_LADDER
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <net/if.h>
+
+#include "vos_types.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+#include "tau_ladder.h"
+
+/***********************************************************************************************************************
+ * DEFINITIONS
+ */
+
+#define TEST_IF_SUBNET1         "tlmA"
+#define TEST_IF_SUBNET2         "tlmB"
+#define TEST_DEFAULT_LOOPS      20u
+#define TEST_POLL_INTERVAL      50u         /* us */
+#define TEST_TIMEOUT            1000000u    /* us until a switchover counts as missed */
+
+/**********************************************************************************************************************/
+static int setLink (const CHAR8 *pIfName, BOOL8 up)
+{
+    struct ifreq    ifr;
+    int             sock = socket(AF_INET, SOCK_DGRAM, 0);
+    int             rc = -1;
+
+    if (sock == -1)
+    {
+        return -1;
+    }
+    memset(&ifr, 0, sizeof(ifr));
+    strncpy(ifr.ifr_name, pIfName, IFNAMSIZ - 1);
+    if (ioctl(sock, SIOCGIFFLAGS, &ifr) == 0)
+    {
+        if (up == TRUE)
+        {
+            ifr.ifr_flags |= IFF_UP;
+        }
+        else
+        {
+            ifr.ifr_flags &= ~IFF_UP;
+        }
+        rc = ioctl(sock, SIOCSIFFLAGS, &ifr);
+    }
+    close(sock);
+    return rc;
+}
+
+/**********************************************************************************************************************/
+/* Wait until the monitored link state of a subnet is as expected, returns the time it took in us */
+static UINT32 waitLink (UINT32 subnetId, BOOL8 up)
+{
+    BOOL8   linkUpDown = !up;
+    UINT32  waited;
+
+    for (waited = 0u; waited < TEST_TIMEOUT; waited += TEST_POLL_INTERVAL)
+    {
+        if ((tau_checkLinkUpDown(subnetId, &linkUpDown) == TRDP_NO_ERR) && (linkUpDown == up))
+        {
+            return waited;
+        }
+        (void) vos_threadDelay(TEST_POLL_INTERVAL);
+    }
+    return TEST_TIMEOUT;
+}
+
+/**********************************************************************************************************************/
+static void removeLinks (void)
+{
+    (void) system("ip link del " TEST_IF_SUBNET1 " 2>/dev/null");
+    (void) system("ip link del " TEST_IF_SUBNET2 " 2>/dev/null");
+}
+
+/**********************************************************************************************************************/
+static int createLinks (void)
+{
+    removeLinks();
+    if ((system("ip link add " TEST_IF_SUBNET1 " type veth peer name " TEST_IF_SUBNET1 "p") != 0)
+        || (system("ip link add " TEST_IF_SUBNET2 " type veth peer name " TEST_IF_SUBNET2 "p") != 0)
+        || (system("ip link set " TEST_IF_SUBNET1 "p up") != 0)
+        || (system("ip link set " TEST_IF_SUBNET2 "p up") != 0)
+        || (setLink(TEST_IF_SUBNET1, TRUE) != 0)
+        || (setLink(TEST_IF_SUBNET2, TRUE) != 0))
+    {
+        return 1;
+    }
+    return 0;
+}
+
+/**********************************************************************************************************************/
+int main (int argc, char *argv[])
+{
+    VOS_TIMEVAL_T   start, delta;
+    UINT32          loops   = TEST_DEFAULT_LOOPS;
+    UINT32          subnetId;
+    BOOL8           linkUpDown;
+    UINT32          i;
+    UINT64          lat;
+    UINT64          latSum  = 0u;
+    UINT64          latMin  = TEST_TIMEOUT;
+    UINT64          latMax  = 0u;
+    UINT32          missed  = 0u;
+    int             rc      = 0;
+
+    if (argc > 1)
+    {
+        loops = (UINT32) strtoul(argv[1], NULL, 10);
+        if (loops == 0u)
+        {
+            printf("usage: %s [number of link losses]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (vos_threadInit() != VOS_NO_ERR)
+    {
+        printf("vos_threadInit failed\n");
+        return 1;
+    }
+    if (createLinks() != 0)
+    {
+        printf("creating veth pairs failed (root and the ip tool are needed)\n");
+        removeLinks();
+        return 1;
+    }
+
+    if ((tau_setLinkIfName(SUBNET1, TEST_IF_SUBNET1) != TRDP_NO_ERR)
+        || (tau_setLinkIfName(SUBNET2, TEST_IF_SUBNET2) != TRDP_NO_ERR)
+        || (tau_startLinkMonitor() != TRDP_NO_ERR))
+    {
+        printf("link monitor not started\n");
+        removeLinks();
+        return 1;
+    }
+    if ((waitLink(SUBNET1, TRUE) == TEST_TIMEOUT) || (waitLink(SUBNET2, TRUE) == TEST_TIMEOUT))
+    {
+        printf("links did not come up\n");
+        rc = 1;
+        loops = 0u;
+    }
+
+    for (i = 0u; i < loops; i++)
+    {
+        (void) tau_setNetworkContext(SUBNET1);
+        (void) tau_takeLinkDownEvent();
+        vos_getTime(&start);
+        (void) setLink(TEST_IF_SUBNET1, FALSE);
+
+        /* As TAULpdMainThread: the link is only checked once the monitor posted a loss */
+        do
+        {
+            if ((tau_takeLinkDownEvent() == TRUE)
+                && (tau_checkLinkUpDown(SUBNET1, &linkUpDown) == TRDP_NO_ERR)
+                && (linkUpDown == FALSE))
+            {
+                (void) tau_setNetworkContext(SUBNET2);
+            }
+            (void) tau_getNetworkContext(&subnetId);
+            vos_getTime(&delta);
+            vos_subTime(&delta, &start);
+            lat = (UINT64) delta.tv_sec * 1000000u + (UINT64) delta.tv_usec;
+            if (subnetId == SUBNET2)
+            {
+                break;
+            }
+            (void) vos_threadDelay(TEST_POLL_INTERVAL);
+        }
+        while (lat < TEST_TIMEOUT);
+
+        if (lat >= TEST_TIMEOUT)
+        {
+            missed++;
+        }
+        else
+        {
+            latSum += lat;
+            latMin  = (lat < latMin) ? lat : latMin;
+            latMax  = (lat > latMax) ? lat : latMax;
+        }
+
+        (void) setLink(TEST_IF_SUBNET1, TRUE);
+        if (waitLink(SUBNET1, TRUE) == TEST_TIMEOUT)
+        {
+            printf("Subnet1 link did not come back\n");
+            missed++;
+            break;
+        }
+    }
+
+    if (loops > 0u)
+    {
+        printf("%u link losses, switchover min %llu us  avg %.1f us  max %llu us  missed %u\n",
+               loops,
+               (unsigned long long) latMin,
+               (missed < loops) ? (double) latSum / (double) (loops - missed) : 0.0,
+               (unsigned long long) latMax,
+               missed);
+    }
+    if (missed != 0u)
+    {
+        rc = 1;
+    }
+
+    /* Without the monitor the interface flags are polled again */
+    (void) tau_closeCheckLinkUpDown();
+    (void) setLink(TEST_IF_SUBNET2, FALSE);
+    if (waitLink(SUBNET2, FALSE) != 0u)
+    {
+        printf("polled link state wrong\n");
+        rc = 1;
+    }
+    (void) tau_closeCheckLinkUpDown();
+
+    removeLinks();
+    vos_threadTerm();
+    printf("%s\n", (rc == 0) ? "Link monitor test: Success" : "Link monitor test: FAILED");
+    return rc;
+}
+#endif /* TRDP_OPTION_LADDER */
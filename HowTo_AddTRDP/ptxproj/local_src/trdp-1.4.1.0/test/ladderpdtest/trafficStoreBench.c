@@ -0,0 +1,323 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trafficStoreBench.c
+ *
+ * @brief           Multi-process read/write benchmark of the ladder Traffic Store
+ *
+ * @details         Writer processes update their own telegrams while reader processes copy random telegrams out of
+ *                  the Traffic Store. The per-telegram sequence locks are compared with one global lock, as taken by
+ *                  tau_lockTrafficStore(). The global lock is a process shared mutex here, the VOS mutex of the
+ *                  Traffic Store does not exclude other processes.
+ *                  Every telegram is filled with one repeated counter value, readers count torn copies.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifdef TRDP_OPTION_LADDER
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "vos_types.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+#include "tau_ladder.h"
+
+/***********************************************************************************************************************
+ * DEFINITIONS
+ */
+
+#define BENCH_TELEGRAMS         16u
+#define BENCH_TELEGRAM_SIZE     1024u       /* bytes per telegram, telegrams are placed back to back */
+#define BENCH_MAX_PROCESSES     16u
+#define BENCH_DEFAULT_WRITERS   2u
+#define BENCH_DEFAULT_READERS   2u
+#define BENCH_DEFAULT_SECONDS   2u
+
+typedef enum
+{
+    BENCH_GLOBAL_LOCK   = 0,
+    BENCH_SEQLOCK       = 1
+} BENCH_MODE_T;
+
+typedef struct
+{
+    UINT64  ops;
+    UINT64  torn;
+    UINT64  maxLatency;                     /* longest single access in us */
+} BENCH_STATS_T;
+
+/* Shared between all benchmark processes */
+typedef struct
+{
+    volatile UINT32 stop;
+    pthread_mutex_t globalLock;             /* stands in for the Traffic Store mutex */
+    BENCH_STATS_T   writer[BENCH_MAX_PROCESSES];
+    BENCH_STATS_T   reader[BENCH_MAX_PROCESSES];
+} BENCH_SHARED_T;
+
+static BENCH_SHARED_T *pShared = NULL;
+
+/**********************************************************************************************************************/
+static UINT64 elapsedUs (const VOS_TIMEVAL_T *pStart)
+{
+    VOS_TIMEVAL_T now;
+
+    vos_getTime(&now);
+    vos_subTime(&now, pStart);
+    return (UINT64) now.tv_sec * 1000000u + (UINT64) now.tv_usec;
+}
+
+/**********************************************************************************************************************/
+static void writeTelegram (BENCH_MODE_T mode, UINT16 offset, const UINT8 *pData)
+{
+    if (mode == BENCH_SEQLOCK)
+    {
+        (void) tau_writeTrafficStore(offset, pData, BENCH_TELEGRAM_SIZE);
+    }
+    else
+    {
+        (void) pthread_mutex_lock(&pShared->globalLock);
+        memcpy(pTrafficStoreAddr + offset, pData, BENCH_TELEGRAM_SIZE);
+        (void) pthread_mutex_unlock(&pShared->globalLock);
+    }
+}
+
+/**********************************************************************************************************************/
+static void readTelegram (BENCH_MODE_T mode, UINT16 offset, UINT8 *pData)
+{
+    if (mode == BENCH_SEQLOCK)
+    {
+        (void) tau_readTrafficStore(offset, pData, BENCH_TELEGRAM_SIZE);
+    }
+    else
+    {
+        (void) pthread_mutex_lock(&pShared->globalLock);
+        memcpy(pData, pTrafficStoreAddr + offset, BENCH_TELEGRAM_SIZE);
+        (void) pthread_mutex_unlock(&pShared->globalLock);
+    }
+}
+
+/**********************************************************************************************************************/
+static void writer (BENCH_MODE_T mode, UINT32 index, UINT32 noOfWriters)
+{
+    UINT32          data[BENCH_TELEGRAM_SIZE / sizeof(UINT32)];
+    BENCH_STATS_T   *pStats = &pShared->writer[index];
+    VOS_TIMEVAL_T   start;
+    UINT32          telegram = index;
+    UINT32          counter = 0u;
+    UINT32          i;
+    UINT64          lat;
+
+    while (pShared->stop == 0u)
+    {
+        counter++;
+        for (i = 0u; i < sizeof(data) / sizeof(UINT32); i++)
+        {
+            data[i] = counter;
+        }
+        vos_getTime(&start);
+        writeTelegram(mode, (UINT16) (telegram * BENCH_TELEGRAM_SIZE), (UINT8 *) data);
+        lat = elapsedUs(&start);
+        if (lat > pStats->maxLatency)
+        {
+            pStats->maxLatency = lat;
+        }
+        pStats->ops++;
+
+        /* each writer owns every noOfWriters-th telegram */
+        telegram += noOfWriters;
+        if (telegram >= BENCH_TELEGRAMS)
+        {
+            telegram = index;
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+static void reader (BENCH_MODE_T mode, UINT32 index)
+{
+    UINT32          data[BENCH_TELEGRAM_SIZE / sizeof(UINT32)];
+    BENCH_STATS_T   *pStats = &pShared->reader[index];
+    VOS_TIMEVAL_T   start;
+    UINT32          seed = 12345u + index;
+    UINT32          i;
+    UINT64          lat;
+
+    while (pShared->stop == 0u)
+    {
+        seed = seed * 1103515245u + 12345u;
+        vos_getTime(&start);
+        readTelegram(mode, (UINT16) (((seed >> 16) % BENCH_TELEGRAMS) * BENCH_TELEGRAM_SIZE), (UINT8 *) data);
+        lat = elapsedUs(&start);
+        if (lat > pStats->maxLatency)
+        {
+            pStats->maxLatency = lat;
+        }
+        pStats->ops++;
+        for (i = 1u; i < sizeof(data) / sizeof(UINT32); i++)
+        {
+            if (data[i] != data[0])
+            {
+                pStats->torn++;
+                break;
+            }
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+static int runMode (BENCH_MODE_T mode, UINT32 noOfWriters, UINT32 noOfReaders, UINT32 seconds)
+{
+    pid_t   pid[2u * BENCH_MAX_PROCESSES];
+    UINT32  noOfProcesses = 0u;
+    UINT32  i;
+    UINT64  writes = 0u, reads = 0u, torn = 0u, maxWrite = 0u, maxRead = 0u;
+    int     rc = 0;
+
+    memset(pShared->writer, 0, sizeof(pShared->writer));
+    memset(pShared->reader, 0, sizeof(pShared->reader));
+    memset(pTrafficStoreAddr, 0, BENCH_TELEGRAMS * BENCH_TELEGRAM_SIZE);
+    pShared->stop = 0u;
+
+    for (i = 0u; i < noOfWriters + noOfReaders; i++)
+    {
+        pid[noOfProcesses] = fork();
+        if (pid[noOfProcesses] == 0)
+        {
+            if (i < noOfWriters)
+            {
+                writer(mode, i, noOfWriters);
+            }
+            else
+            {
+                reader(mode, i - noOfWriters);
+            }
+            _exit(0);
+        }
+        if (pid[noOfProcesses] < 0)
+        {
+            printf("fork failed\n");
+            rc = 1;
+            break;
+        }
+        noOfProcesses++;
+    }
+
+    (void) vos_threadDelay(seconds * 1000000u);
+    pShared->stop = 1u;
+    for (i = 0u; i < noOfProcesses; i++)
+    {
+        (void) waitpid(pid[i], NULL, 0);
+    }
+
+    for (i = 0u; i < noOfWriters; i++)
+    {
+        writes  += pShared->writer[i].ops;
+        maxWrite = (pShared->writer[i].maxLatency > maxWrite) ? pShared->writer[i].maxLatency : maxWrite;
+    }
+    for (i = 0u; i < noOfReaders; i++)
+    {
+        reads   += pShared->reader[i].ops;
+        torn    += pShared->reader[i].torn;
+        maxRead  = (pShared->reader[i].maxLatency > maxRead) ? pShared->reader[i].maxLatency : maxRead;
+    }
+    printf("%-16s %12.0f %12.0f %10llu %10llu %8llu\n",
+           (mode == BENCH_SEQLOCK) ? "seqlock" : "global lock",
+           (double) writes / (double) seconds,
+           (double) reads / (double) seconds,
+           (unsigned long long) maxWrite,
+           (unsigned long long) maxRead,
+           (unsigned long long) torn);
+    if (torn != 0u)
+    {
+        rc = 1;
+    }
+    return rc;
+}
+
+/**********************************************************************************************************************/
+int main (int argc, char *argv[])
+{
+    pthread_mutexattr_t attr;
+    UINT32              noOfWriters = BENCH_DEFAULT_WRITERS;
+    UINT32              noOfReaders = BENCH_DEFAULT_READERS;
+    UINT32              seconds     = BENCH_DEFAULT_SECONDS;
+    int                 ch;
+    int                 rc = 0;
+
+    while ((ch = getopt(argc, argv, "w:r:s:h?")) != -1)
+    {
+        switch (ch)
+        {
+            case 'w':
+                noOfWriters = (UINT32) strtoul(optarg, NULL, 10);
+                break;
+            case 'r':
+                noOfReaders = (UINT32) strtoul(optarg, NULL, 10);
+                break;
+            case 's':
+                seconds = (UINT32) strtoul(optarg, NULL, 10);
+                break;
+            default:
+                printf("usage: %s [-w writers] [-r readers] [-s seconds]\n", argv[0]);
+                return 1;
+        }
+    }
+    if ((noOfWriters == 0u) || (noOfWriters > BENCH_TELEGRAMS) || (noOfWriters > BENCH_MAX_PROCESSES)
+        || (noOfReaders > BENCH_MAX_PROCESSES) || (seconds == 0u))
+    {
+        printf("1..%u writers, 0..%u readers and at least one second, please\n", BENCH_MAX_PROCESSES,
+               BENCH_MAX_PROCESSES);
+        return 1;
+    }
+
+    if ((vos_threadInit() != VOS_NO_ERR) || (tau_ladder_init() != TRDP_NO_ERR))
+    {
+        printf("Traffic Store not available\n");
+        return 1;
+    }
+
+    pShared = (BENCH_SHARED_T *) mmap(NULL, sizeof(BENCH_SHARED_T), PROT_READ | PROT_WRITE,
+                                      MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+    if (pShared == MAP_FAILED)
+    {
+        printf("mmap failed\n");
+        return 1;
+    }
+    (void) pthread_mutexattr_init(&attr);
+    (void) pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+    (void) pthread_mutex_init(&pShared->globalLock, &attr);
+    (void) pthread_mutexattr_destroy(&attr);
+
+    printf("%u writer and %u reader processes, %u telegrams of %u bytes, %u s per run\n",
+           noOfWriters, noOfReaders, BENCH_TELEGRAMS, BENCH_TELEGRAM_SIZE, seconds);
+    printf("Traffic Store         writes/s      reads/s  max wr us  max rd us     torn\n");
+    rc |= runMode(BENCH_GLOBAL_LOCK, noOfWriters, noOfReaders, seconds);
+    rc |= runMode(BENCH_SEQLOCK, noOfWriters, noOfReaders, seconds);
+
+    (void) pthread_mutex_destroy(&pShared->globalLock);
+    (void) munmap(pShared, sizeof(BENCH_SHARED_T));
+    (void) tau_ladder_terminate();
+    vos_threadTerm();
+    return rc;
+}
+#endif /* TRDP_OPTION_LADDER */
@@ -0,0 +1,246 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trafficStoreNotifyTest.c
+ *
+ * @brief           Change notification of the ladder Traffic Store
+ *
+ * @details         A writer process updates a noise telegram in group 1 continuously and a timestamped telegram in
+ *                  group 2 once per period. The consumer waits for group 2 with tau_waitTrafficStore() and, for
+ *                  comparison, polls the update counter of the telegram every millisecond. Reported are the
+ *                  latencies from write to wake up and the wake ups without a group 2 change.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#ifdef TRDP_OPTION_LADDER
+/***********************************************************************************************************************
+ * INCLUDES
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <signal.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+
+#include "vos_types.h"
+#include "vos_thread.h"
+#include "vos_utils.h"
+#include "tau_ladder.h"
+
+/***********************************************************************************************************************
+ * DEFINITIONS
+ */
+
+#define TEST_NOISE_OFFSET       0u          /* group 1, written continuously */
+#define TEST_NOISE_GROUP        1u
+#define TEST_EVENT_OFFSET       1024u       /* group 2, written once per period */
+#define TEST_EVENT_GROUP        2u
+#define TEST_IDLE_GROUP         3u          /* never written */
+#define TEST_TELEGRAM_SIZE      64u
+#define TEST_PERIOD             2000u       /* us between two group 2 writes */
+#define TEST_POLL_INTERVAL      1000u       /* us, polling consumer */
+#define TEST_DEFAULT_EVENTS     500u
+#define TEST_TIMEOUT            100000u     /* us */
+
+typedef struct
+{
+    UINT64  latSum;
+    UINT64  latMax;
+    UINT32  events;
+    UINT32  spurious;
+} TEST_STATS_T;
+
+/**********************************************************************************************************************/
+static UINT64 nowUs (void)
+{
+    VOS_TIMEVAL_T now;
+
+    vos_getTime(&now);
+    return (UINT64) now.tv_sec * 1000000u + (UINT64) now.tv_usec;
+}
+
+/**********************************************************************************************************************/
+static void writer (void)
+{
+    UINT8   noise[TEST_TELEGRAM_SIZE];
+    UINT64  stamp;
+    UINT64  next = nowUs() + TEST_PERIOD;
+
+    memset(noise, 0, sizeof(noise));
+    for (;;)
+    {
+        noise[0]++;
+        (void) tau_writeTrafficStore(TEST_NOISE_OFFSET, noise, sizeof(noise));
+        if (nowUs() >= next)
+        {
+            stamp = nowUs();
+            (void) tau_writeTrafficStore(TEST_EVENT_OFFSET, (UINT8 *) &stamp, sizeof(stamp));
+            next += TEST_PERIOD;
+        }
+        (void) vos_threadDelay(50u);
+    }
+}
+
+/**********************************************************************************************************************/
+static void record (TEST_STATS_T *pStats)
+{
+    UINT64  stamp;
+    UINT64  lat;
+
+    (void) tau_readTrafficStore(TEST_EVENT_OFFSET, (UINT8 *) &stamp, sizeof(stamp));
+    lat = nowUs() - stamp;
+    pStats->latSum += lat;
+    pStats->latMax  = (lat > pStats->latMax) ? lat : pStats->latMax;
+    pStats->events++;
+}
+
+/**********************************************************************************************************************/
+static int waitEvents (UINT32 noOfEvents, TEST_STATS_T *pStats)
+{
+    TRAFFIC_STORE_NOTIFY_T  notify;
+    UINT32                  changedMask;
+    TRDP_ERR_T              err;
+
+    (void) tau_initTrafficStoreNotify(&notify);
+    while (pStats->events < noOfEvents)
+    {
+        err = tau_waitTrafficStore(&notify, 1u << TEST_EVENT_GROUP, TEST_TIMEOUT, &changedMask);
+        if (err != TRDP_NO_ERR)
+        {
+            printf("tau_waitTrafficStore() returned %d\n", err);
+            return 1;
+        }
+        if (changedMask != (1u << TEST_EVENT_GROUP))
+        {
+            pStats->spurious++;
+            continue;
+        }
+        record(pStats);
+    }
+    return 0;
+}
+
+/**********************************************************************************************************************/
+static int pollEvents (UINT32 noOfEvents, TEST_STATS_T *pStats)
+{
+    UINT32  lastCount;
+    UINT32  count;
+
+    (void) tau_getTrafficStoreUpdateCount(TEST_EVENT_OFFSET, &lastCount);
+    while (pStats->events < noOfEvents)
+    {
+        (void) vos_threadDelay(TEST_POLL_INTERVAL);
+        (void) tau_getTrafficStoreUpdateCount(TEST_EVENT_OFFSET, &count);
+        if (count == lastCount)
+        {
+            pStats->spurious++;
+            continue;
+        }
+        lastCount = count;
+        record(pStats);
+    }
+    return 0;
+}
+
+/**********************************************************************************************************************/
+static void printStats (const CHAR8 *pName, const TEST_STATS_T *pStats)
+{
+    printf("%-12s %8u %12.1f %10llu %10u\n",
+           pName,
+           pStats->events,
+           (pStats->events != 0u) ? (double) pStats->latSum / (double) pStats->events : 0.0,
+           (unsigned long long) pStats->latMax,
+           pStats->spurious);
+}
+
+/**********************************************************************************************************************/
+int main (int argc, char *argv[])
+{
+    TRAFFIC_STORE_NOTIFY_T  notify;
+    TEST_STATS_T            waitStats;
+    TEST_STATS_T            pollStats;
+    UINT32                  noOfEvents = TEST_DEFAULT_EVENTS;
+    UINT64                  start;
+    pid_t                   pid;
+    int                     rc = 0;
+
+    if (argc > 1)
+    {
+        noOfEvents = (UINT32) strtoul(argv[1], NULL, 10);
+        if (noOfEvents == 0u)
+        {
+            printf("usage: %s [number of events]\n", argv[0]);
+            return 1;
+        }
+    }
+    if ((vos_threadInit() != VOS_NO_ERR) || (tau_ladder_init() != TRDP_NO_ERR))
+    {
+        printf("Traffic Store not available\n");
+        return 1;
+    }
+    if ((tau_setTrafficStoreNotifyGroup(TEST_NOISE_OFFSET, TEST_TELEGRAM_SIZE, TEST_NOISE_GROUP) != TRDP_NO_ERR)
+        || (tau_setTrafficStoreNotifyGroup(TEST_EVENT_OFFSET, TEST_TELEGRAM_SIZE, TEST_EVENT_GROUP) != TRDP_NO_ERR)
+        || (tau_setTrafficStoreNotifyGroup(0u, 1u, TRAFFIC_STORE_NOTIFY_GROUPS) != TRDP_PARAM_ERR))
+    {
+        printf("tau_setTrafficStoreNotifyGroup() failed\n");
+        rc = 1;
+    }
+
+    /* Nothing is written to the idle group, the wait must time out */
+    (void) tau_initTrafficStoreNotify(&notify);
+    start = nowUs();
+    if ((tau_waitTrafficStore(&notify, 1u << TEST_IDLE_GROUP, TEST_TIMEOUT / 10u, NULL) != TRDP_TIMEOUT_ERR)
+        || (nowUs() - start < TEST_TIMEOUT / 10u))
+    {
+        printf("idle group did not time out\n");
+        rc = 1;
+    }
+
+    pid = fork();
+    if (pid == 0)
+    {
+        writer();
+        _exit(0);
+    }
+    if (pid < 0)
+    {
+        printf("fork failed\n");
+        return 1;
+    }
+
+    memset(&waitStats, 0, sizeof(waitStats));
+    memset(&pollStats, 0, sizeof(pollStats));
+    rc |= waitEvents(noOfEvents, &waitStats);
+    rc |= pollEvents(noOfEvents, &pollStats);
+    (void) kill(pid, SIGTERM);
+    (void) waitpid(pid, NULL, 0);
+
+    printf("%u events of group %u, %u us apart, group %u written every 50 us\n",
+           noOfEvents, TEST_EVENT_GROUP, TEST_PERIOD, TEST_NOISE_GROUP);
+    printf("consumer       events  avg lat us  max lat us  no change\n");
+    printStats("futex wait", &waitStats);
+    printStats("1 ms poll", &pollStats);
+    if (waitStats.spurious != 0u)
+    {
+        printf("woken without change of group %u\n", TEST_EVENT_GROUP);
+        rc = 1;
+    }
+
+    (void) tau_ladder_terminate();
+    vos_threadTerm();
+    printf("%s\n", (rc == 0) ? "Traffic Store notify test: Success" : "Traffic Store notify test: FAILED");
+    return rc;
+}
+#endif /* TRDP_OPTION_LADDER */
@@ -37,6 +37,7 @@
 #endif
 
 #include "trdp_if_light.h"
+#include "vos_shared_mem.h"
 #include "vos_sock.h"
 #include "vos_utils.h"
 
@@ -2078,8 +2079,1623 @@ static int test16 ()
     CLEANUP;
 }
 
+/**********************************************************************************************************************/
+/** test17 TCP MD Request - Reply with user data sent in place (TRDP_FLAGS_STREAM)
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+
+#define                 TEST17_COMID            1700u
+#define                 TEST17_DATA_LEN         (63 * 1024)
+
+static int gTest17Replies;
+
+static void  test17CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    TRDP_ERR_T err;
+
+    if (pMsg->resultCode != TRDP_NO_ERR)
+    {
+        fprintf(gFp, "->> Error %d (ComId %u)\n", pMsg->resultCode, pMsg->comId);
+        gFailed = 1;
+    }
+    else if ((pMsg->msgType == TRDP_MSG_MR) &&
+             (pMsg->comId == TEST17_COMID))
+    {
+        if ((dataSize != TEST17_DATA_LEN) || (memcmp(pData, dataBuffer1, TEST17_DATA_LEN) != 0))
+        {
+            fprintf(gFp, "### Request data corrupted (%u bytes)\n", dataSize);
+            gFailed = 1;
+        }
+        fprintf(gFp, "->> Sending reply\n");
+        err = tlm_reply(appHandle, &pMsg->sessionId, TEST17_COMID, 0u, NULL,
+                        (UINT8 *)dataBuffer2, TEST17_DATA_LEN);
+
+        IF_ERROR("tlm_reply");
+    }
+    else if ((pMsg->msgType == TRDP_MSG_MP) &&
+             (pMsg->comId == TEST17_COMID))
+    {
+        if ((dataSize != TEST17_DATA_LEN) || (memcmp(pData, dataBuffer2, TEST17_DATA_LEN) != 0))
+        {
+            fprintf(gFp, "### Reply data corrupted (%u bytes)\n", dataSize);
+            gFailed = 1;
+        }
+        fprintf(gFp, "->> Reply received\n");
+        gTest17Replies++;
+    }
+    else
+    {
+        fprintf(gFp, "->> Unsolicited Message received (type = %0xhx)\n", pMsg->msgType);
+        gFailed = 1;
+    }
+end:
+    return;
+}
+
+static int test17 ()
+{
+    PREPARE("TCP MD Request - Reply, user data sent in place", "test"); /* allocates appHandle1, appHandle2, failed = 0,
+                                                                          err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        int i;
+        TRDP_UUID_T sessionId1;
+        TRDP_LIS_T listenHandle;
+
+        gTest17Replies = 0;
+
+        err = tlm_addListener(appHandle2, &listenHandle, NULL, test17CBFunction,
+                              TRUE,
+                              TEST17_COMID, 0u, 0u, 0u,
+                              VOS_INADDR_ANY, VOS_INADDR_ANY,
+                              TRDP_FLAGS_CALLBACK | TRDP_FLAGS_TCP | TRDP_FLAGS_STREAM, NULL, NULL);
+        IF_ERROR("tlm_addListener");
+        fprintf(gFp, "->> MD TCP Listener set up\n");
+
+        for (i = 0; i < 5; i++)
+        {
+            err = tlm_request(appHandle1, NULL, test17CBFunction, &sessionId1,
+                              TEST17_COMID, 0u, 0u,
+                              0u, gSession2.ifaceIP,
+                              TRDP_FLAGS_CALLBACK | TRDP_FLAGS_TCP | TRDP_FLAGS_STREAM, 1u, 1000000u, NULL,
+                              (UINT8 *)dataBuffer1, TEST17_DATA_LEN,
+                              NULL, NULL);
+
+            IF_ERROR("tlm_request");
+            fprintf(gFp, "->> MD TCP Request sent\n");
+
+            vos_threadDelay(500000u);
+        }
+
+        vos_threadDelay(1000000u);
+
+        if (gTest17Replies != 5)
+        {
+            fprintf(gFp, "### %d of 5 replies received\n", gTest17Replies);
+            gFailed = 1;
+        }
+
+        err = tlm_delListener(appHandle2, listenHandle);
+        IF_ERROR("tlm_delListener");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test18 TCP MD Request - Reply, several requests pipelined on one pooled TCP connection
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+
+#define                 TEST18_COMID            1800u
+#define                 TEST18_REQUESTS         3
+
+static int gTest18Replies;
+
+static void  test18CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    TRDP_ERR_T err;
+
+    if (pMsg->resultCode != TRDP_NO_ERR)
+    {
+        fprintf(gFp, "->> Error %d (ComId %u)\n", pMsg->resultCode, pMsg->comId);
+        gFailed = 1;
+    }
+    else if ((pMsg->msgType == TRDP_MSG_MR) &&
+             (pMsg->comId == TEST18_COMID))
+    {
+        fprintf(gFp, "->> Sending reply\n");
+        err = tlm_reply(appHandle, &pMsg->sessionId, TEST18_COMID, 0u, NULL,
+                        (UINT8 *)dataBuffer2, 1024u);
+
+        IF_ERROR("tlm_reply");
+    }
+    else if ((pMsg->msgType == TRDP_MSG_MP) &&
+             (pMsg->comId == TEST18_COMID))
+    {
+        fprintf(gFp, "->> Reply received\n");
+        gTest18Replies++;
+    }
+    else
+    {
+        fprintf(gFp, "->> Unsolicited Message received (type = %0xhx)\n", pMsg->msgType);
+        gFailed = 1;
+    }
+end:
+    return;
+}
+
+static int test18 ()
+{
+    PREPARE("TCP MD Request - Reply, pipelined on one pooled connection", "test"); /* allocates appHandle1, appHandle2,
+                                                                                     failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        int i;
+        TRDP_UUID_T sessionId1;
+        TRDP_LIS_T listenHandle;
+        TRDP_MD_CONFIG_T mdConfig;
+        TRDP_TCP_POOL_STATISTICS_T poolStats;
+
+        gTest18Replies = 0;
+
+        memset(&mdConfig, 0, sizeof(mdConfig));
+        mdConfig.sendParam.retries  = TRDP_MD_DEFAULT_RETRIES;
+        mdConfig.maxTcpPipeline     = TEST18_REQUESTS;
+        err = tlc_configSession(appHandle1, NULL, NULL, &mdConfig, NULL);
+        IF_ERROR("tlc_configSession");
+
+        err = tlm_addListener(appHandle2, &listenHandle, NULL, test18CBFunction,
+                              TRUE,
+                              TEST18_COMID, 0u, 0u, 0u,
+                              VOS_INADDR_ANY, VOS_INADDR_ANY,
+                              TRDP_FLAGS_CALLBACK | TRDP_FLAGS_TCP, NULL, NULL);
+        IF_ERROR("tlm_addListener");
+        fprintf(gFp, "->> MD TCP Listener set up\n");
+
+        /* send all requests at once, they should share one connection */
+        for (i = 0; i < TEST18_REQUESTS; i++)
+        {
+            err = tlm_request(appHandle1, NULL, test18CBFunction, &sessionId1,
+                              TEST18_COMID, 0u, 0u,
+                              0u, gSession2.ifaceIP,
+                              TRDP_FLAGS_CALLBACK | TRDP_FLAGS_TCP, 1u, 1000000u, NULL,
+                              (UINT8 *)dataBuffer1, 1024u,
+                              NULL, NULL);
+
+            IF_ERROR("tlm_request");
+            fprintf(gFp, "->> MD TCP Request sent\n");
+        }
+
+        vos_threadDelay(1000000u);
+
+        if (gTest18Replies != TEST18_REQUESTS)
+        {
+            fprintf(gFp, "### %d of %d replies received\n", gTest18Replies, TEST18_REQUESTS);
+            gFailed = 1;
+        }
+
+        err = tlc_getTcpPoolStatistics(appHandle1, &poolStats);
+        IF_ERROR("tlc_getTcpPoolStatistics");
+        fprintf(gFp, "->> Pool: open %u, idle %u, connects %u, reused %u, pipelined %u\n",
+                poolStats.numOpen, poolStats.numIdle, poolStats.numConnect, poolStats.numReuse,
+                poolStats.numPipelined);
+
+        if ((poolStats.numConnect != 1u) || (poolStats.numOpen != 1u) ||
+            (poolStats.numPipelined != TEST18_REQUESTS - 1u))
+        {
+            fprintf(gFp, "### Requests were not pipelined on one connection\n");
+            gFailed = 1;
+        }
+
+        err = tlm_delListener(appHandle2, listenHandle);
+        IF_ERROR("tlm_delListener");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+
+/**********************************************************************************************************************/
+/** test19 TCP MD Request - Reply with several hundred peers (socket pool beyond VOS_MAX_SOCKET_CNT)
+ *  The peers are simulated by one TCP listener on all loopback addresses, which returns each request as reply.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+
+#define                 TEST19_COMID            1900u
+#define                 TEST19_PEERS            300
+#define                 TEST19_DATA_LEN         64u
+#define                 TEST19_HEADER_LEN       116u    /* MD header incl. FCS */
+#define                 TEST19_MSG_LEN          (TEST19_HEADER_LEN + TEST19_DATA_LEN)
+
+static int gTest19Replies;
+
+static void  test19CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    if (pMsg->resultCode != TRDP_NO_ERR)
+    {
+        fprintf(gFp, "->> Error %d (ComId %u)\n", pMsg->resultCode, pMsg->comId);
+        gFailed = 1;
+    }
+    else if ((pMsg->msgType == TRDP_MSG_MP) &&
+             (pMsg->comId == TEST19_COMID))
+    {
+        if ((dataSize != TEST19_DATA_LEN) || (memcmp(pData, dataBuffer1, TEST19_DATA_LEN) != 0))
+        {
+            fprintf(gFp, "### Reply data corrupted (%u bytes)\n", dataSize);
+            gFailed = 1;
+        }
+        gTest19Replies++;
+    }
+    else
+    {
+        fprintf(gFp, "->> Unsolicited Message received (type = %0xhx)\n", pMsg->msgType);
+        gFailed = 1;
+    }
+}
+
+/*  Return a received request as reply (message type 'Mp', new header FCS) */
+static int test19Echo (
+    SOCKET sock)
+{
+    UINT8   buffer[TEST19_MSG_LEN];
+    UINT32  size = TEST19_MSG_LEN;
+    UINT32  fcs;
+
+    if ((vos_sockReceiveTCP(sock, buffer, &size) != VOS_NO_ERR) || (size != TEST19_MSG_LEN))
+    {
+        return 1;
+    }
+    buffer[6]   = 'M';
+    buffer[7]   = 'p';
+    fcs         = vos_crc32(INITFCS, buffer, TEST19_HEADER_LEN - 4u);
+    fcs         = MAKE_LE(fcs);
+    memcpy(&buffer[TEST19_HEADER_LEN - 4u], &fcs, 4u);
+    return (vos_sockSendTCP(sock, buffer, &size) != VOS_NO_ERR) ? 1 : 0;
+}
+
+static int test19 ()
+{
+    PREPARE("TCP MD Request - Reply, several hundred peers", "test"); /* allocates appHandle1, appHandle2,
+                                                                        failed = 0, err */
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        int i, loops, noOfPeers = 0;
+        TRDP_UUID_T sessionId1;
+        SOCKET listenSock = VOS_INVALID_SOCKET;
+        SOCKET peerSock[TEST19_PEERS];
+        VOS_SOCK_OPT_T sockOpt;
+        TRDP_TCP_POOL_STATISTICS_T poolStats;
+
+        gTest19Replies = 0;
+
+        /* The peers: one listener for all addresses */
+        memset(&sockOpt, 0, sizeof(sockOpt));
+        sockOpt.reuseAddrPort   = TRUE;
+        sockOpt.nonBlocking     = TRUE;
+        if ((vos_sockOpenTCP(&listenSock, &sockOpt) != VOS_NO_ERR) ||
+            (vos_sockBind(listenSock, 0u, TRDP_MD_TCP_PORT) != VOS_NO_ERR) ||
+            (vos_sockListen(listenSock, TEST19_PEERS) != VOS_NO_ERR))
+        {
+            fprintf(gFp, "### Peer listener could not be opened\n");
+            gFailed = 1;
+        }
+
+        /* One request to each peer (127.0.1.1, 127.0.2.1, ...) opens one connection each */
+        for (i = 0; (i < TEST19_PEERS) && (gFailed == 0); i++)
+        {
+            err = tlm_request(appHandle1, NULL, test19CBFunction, &sessionId1,
+                              TEST19_COMID, 0u, 0u,
+                              0u, 0x7F000001u | ((UINT32)(i + 1) << 8),
+                              TRDP_FLAGS_CALLBACK | TRDP_FLAGS_TCP, 1u, 5000000u, NULL,
+                              (UINT8 *)dataBuffer1, TEST19_DATA_LEN,
+                              NULL, NULL);
+
+            IF_ERROR("tlm_request");
+        }
+        fprintf(gFp, "->> %d MD TCP Requests sent\n", i);
+
+        /* Serve the peers until all replies arrived */
+        for (loops = 0; (loops < 1000) && (gTest19Replies < TEST19_PEERS) && (gFailed == 0); loops++)
+        {
+            VOS_FDS_T       rfds;
+            VOS_TIMEVAL_T   tv = {0, 10000};
+            SOCKET          highDesc = listenSock;
+
+            FD_ZERO(&rfds);
+            FD_SET(listenSock, &rfds);
+            for (i = 0; i < noOfPeers; i++)
+            {
+                FD_SET(peerSock[i], &rfds);
+                if (peerSock[i] > highDesc)
+                {
+                    highDesc = peerSock[i];
+                }
+            }
+            if (vos_select(highDesc + 1, &rfds, NULL, NULL, &tv) <= 0)
+            {
+                continue;
+            }
+            for (i = 0; i < noOfPeers; i++)
+            {
+                if (FD_ISSET(peerSock[i], &rfds) && (test19Echo(peerSock[i]) != 0))
+                {
+                    fprintf(gFp, "### Peer %d could not reply\n", i);
+                    gFailed = 1;
+                }
+            }
+            if (FD_ISSET(listenSock, &rfds))
+            {
+                SOCKET          newSock = VOS_INVALID_SOCKET;
+                TRDP_IP_ADDR_T  ip      = 0u;
+                UINT16          port    = 0u;
+
+                while ((noOfPeers < TEST19_PEERS) &&
+                       (vos_sockAccept(listenSock, &newSock, &ip, &port) == VOS_NO_ERR) &&
+                       (newSock != VOS_INVALID_SOCKET))
+                {
+                    sockOpt.nonBlocking = FALSE;
+                    (void) vos_sockSetOptions(newSock, &sockOpt);
+                    peerSock[noOfPeers++] = newSock;
+                    newSock = VOS_INVALID_SOCKET;
+                }
+            }
+        }
+
+        if (gTest19Replies != TEST19_PEERS)
+        {
+            fprintf(gFp, "### %d of %d replies received (%d peers connected)\n", gTest19Replies, TEST19_PEERS,
+                    noOfPeers);
+            gFailed = 1;
+        }
+
+        err = tlc_getTcpPoolStatistics(appHandle1, &poolStats);
+        IF_ERROR("tlc_getTcpPoolStatistics");
+        fprintf(gFp, "->> Pool: open %u, idle %u, connects %u\n",
+                poolStats.numOpen, poolStats.numIdle, poolStats.numConnect);
+
+        if ((poolStats.numConnect != TEST19_PEERS) || (poolStats.numOpen != TEST19_PEERS))
+        {
+            fprintf(gFp, "### Expected one open connection per peer\n");
+            gFailed = 1;
+        }
+
+        for (i = 0; i < noOfPeers; i++)
+        {
+            (void) vos_sockClose(peerSock[i]);
+        }
+        if (listenSock != VOS_INVALID_SOCKET)
+        {
+            (void) vos_sockClose(listenSock);
+        }
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+
+
+/**********************************************************************************************************************/
+/** test20
+ *  PD multicast: more groups than one socket could join before, source specific join (kernel filter)
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST20_GROUPS       40
+#define TEST20_COMID        20000u
+#define TEST20_MCDEST       0xEF000500u
+#define TEST20_INTERVAL     100000u
+
+/*  Process a session without own thread for the given time */
+static void test20Process (
+    TRDP_APP_SESSION_T  appHandle,
+    UINT32              duration)
+{
+    TRDP_TIME_T now, end, interval = {0u, 0u};
+
+    interval.tv_sec     = duration / 1000000u;
+    interval.tv_usec    = duration % 1000000u;
+    vos_getTime(&end);
+    vos_addTime(&end, &interval);
+
+    do
+    {
+        TRDP_FDS_T  rfds;
+        INT32       noDesc = 0;
+        INT32       rv;
+        TRDP_TIME_T tv;
+        TRDP_TIME_T max_tv = {0u, 20000};
+
+        FD_ZERO(&rfds);
+        (void) tlc_getInterval(appHandle, &tv, &rfds, &noDesc);
+        if (vos_cmpTime(&tv, &max_tv) > 0)
+        {
+            tv = max_tv;
+        }
+        rv = vos_select(noDesc + 1, &rfds, NULL, NULL, &tv);
+        (void) tlc_process(appHandle, &rfds, &rv);
+        vos_getTime(&now);
+    }
+    while (vos_cmpTime(&now, &end) < 0);
+}
+
+static int test20 ()
+{
+    PREPARE("PD multicast joins and source filter", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_SUB_T              subHandle[TEST20_GROUPS];
+        TRDP_PUB_T              pubHandle1  = NULL;
+        TRDP_PUB_T              pubHandle2  = NULL;
+        TRDP_APP_SESSION_T      appHandle3  = NULL;
+        TRDP_SUB_T              ssmHandle;
+        TRDP_PROCESS_CONFIG_T   processConfig = {"Test20", "", 0u, 0u, TRDP_OPTION_MC_SOURCE_FILTER};
+        TRDP_STATISTICS_T       stats;
+        TRDP_PD_INFO_T          pdInfo;
+        UINT8                   data[TRDP_MAX_PD_DATA_SIZE];
+        UINT32                  dataSize;
+        int                     i;
+
+        /*  Subscribe to all groups, they do not fit on one socket of the former fixed size  */
+        for (i = 0; i < TEST20_GROUPS; i++)
+        {
+            err = tlp_subscribe(appHandle2, &subHandle[i], NULL, NULL,
+                                TEST20_COMID + (UINT32) i + 1u, 0u, 0u,
+                                0u, 0u,
+                                TEST20_MCDEST + (UINT32) i + 1u,
+                                TRDP_FLAGS_DEFAULT, TEST20_INTERVAL * 10u, TRDP_TO_DEFAULT);
+            IF_ERROR("tlp_subscribe");
+        }
+
+        err = tlp_publish(appHandle1, &pubHandle1, NULL, NULL, TEST20_COMID + 1u, 0u, 0u, 0u,
+                          TEST20_MCDEST + 1u, TEST20_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL,
+                          (UINT8 *) "First group", 12u);
+        IF_ERROR("tlp_publish");
+        err = tlp_publish(appHandle1, &pubHandle2, NULL, NULL, TEST20_COMID + TEST20_GROUPS, 0u, 0u, 0u,
+                          TEST20_MCDEST + TEST20_GROUPS, TEST20_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL,
+                          (UINT8 *) "Last group", 11u);
+        IF_ERROR("tlp_publish");
+
+        vos_threadDelay(1000000u);
+
+        dataSize = sizeof(data);
+        err = tlp_get(appHandle2, subHandle[0], &pdInfo, data, &dataSize);
+        IF_ERROR("tlp_get first group");
+        dataSize = sizeof(data);
+        err = tlp_get(appHandle2, subHandle[TEST20_GROUPS - 1], &pdInfo, data, &dataSize);
+        IF_ERROR("tlp_get last group");
+
+        err = tlc_getStatistics(appHandle2, &stats);
+        IF_ERROR("tlc_getStatistics");
+        fprintf(gFp, "->> %u subscriptions, %u joins\n", stats.pd.numSubs, stats.numJoin);
+        if (stats.numJoin != TEST20_GROUPS)
+        {
+            FAILED("Expected one join per group");
+        }
+
+        for (i = 0; i < TEST20_GROUPS; i++)
+        {
+            err = tlp_unsubscribe(appHandle2, subHandle[i]);
+            IF_ERROR("tlp_unsubscribe");
+        }
+        err = tlc_getStatistics(appHandle2, &stats);
+        IF_ERROR("tlc_getStatistics");
+        if (stats.numJoin != 0u)
+        {
+            FAILED("Groups still joined after unsubscribing");
+        }
+
+        /*  Only the last group is sent from now on  */
+        err = tlp_unpublish(appHandle1, pubHandle1);
+        IF_ERROR("tlp_unpublish");
+
+        /*  A session joining for the subscribed source only: a foreign publisher is dropped by the kernel  */
+        err = tlc_openSession(&appHandle3, gSession2.ifaceIP, 0u, NULL, NULL, NULL, &processConfig);
+        IF_ERROR("tlc_openSession");
+
+        err = tlp_subscribe(appHandle3, &ssmHandle, NULL, NULL,
+                            TEST20_COMID + TEST20_GROUPS, 0u, 0u,
+                            gSession2.ifaceIP, 0u,
+                            TEST20_MCDEST + TEST20_GROUPS,
+                            TRDP_FLAGS_DEFAULT, TEST20_INTERVAL * 10u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe (source filter)");
+        test20Process(appHandle3, 1000000u);
+
+        err = tlc_getStatistics(appHandle3, &stats);
+        IF_ERROR("tlc_getStatistics");
+        fprintf(gFp, "->> Foreign source: %u received, %u joins\n", stats.pd.numRcv, stats.numJoin);
+        if ((stats.pd.numRcv != 0u) || (stats.numJoin != 1u))
+        {
+            FAILED("Packets of a foreign source were not filtered");
+        }
+
+        /*  Switch to the real publisher  */
+        err = tlp_resubscribe(appHandle3, ssmHandle, 0u, 0u, gSession1.ifaceIP, 0u, TEST20_MCDEST + TEST20_GROUPS);
+        IF_ERROR("tlp_resubscribe");
+        test20Process(appHandle3, 1000000u);
+
+        dataSize = sizeof(data);
+        err = tlp_get(appHandle3, ssmHandle, &pdInfo, data, &dataSize);
+        IF_ERROR("tlp_get (source filter)");
+        err = tlc_getStatistics(appHandle3, &stats);
+        IF_ERROR("tlc_getStatistics");
+        fprintf(gFp, "->> Subscribed source: %u received, %u joins\n", stats.pd.numRcv, stats.numJoin);
+        if (stats.numJoin != 1u)
+        {
+            FAILED("Expected one join");
+        }
+
+        err = tlp_unsubscribe(appHandle3, ssmHandle);
+        IF_ERROR("tlp_unsubscribe");
+        err = tlc_closeSession(appHandle3);
+        IF_ERROR("tlc_closeSession");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+
+/**********************************************************************************************************************/
+/** test21
+ *  PD socket filter: packets of not subscribed ComIds are dropped by the kernel
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST21_COMID        21000u
+#define TEST21_MCDEST       0xEF000601u
+#define TEST21_INTERVAL     100000u
+
+static int test21 ()
+{
+    PREPARE("PD kernel socket filter", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T              pubHandle1  = NULL;
+        TRDP_PUB_T              pubHandle2  = NULL;
+        TRDP_SUB_T              subHandle2  = NULL;
+        TRDP_SUB_T              subHandle3  = NULL;
+        TRDP_SUB_T              subHandle3b = NULL;
+        TRDP_APP_SESSION_T      appHandle3  = NULL;
+        TRDP_PROCESS_CONFIG_T   processConfig = {"Test21", "", 0u, 0u, TRDP_OPTION_PD_KERNEL_FILTER};
+        TRDP_STATISTICS_T       stats;
+        TRDP_PD_INFO_T          pdInfo;
+        UINT8                   data[TRDP_MAX_PD_DATA_SIZE];
+        UINT32                  dataSize;
+
+        /*  Two ComIds on one group, only the first one is subscribed  */
+        err = tlp_publish(appHandle1, &pubHandle1, NULL, NULL, TEST21_COMID + 1u, 0u, 0u, 0u,
+                          TEST21_MCDEST, TEST21_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL,
+                          (UINT8 *) "Subscribed", 11u);
+        IF_ERROR("tlp_publish");
+        err = tlp_publish(appHandle1, &pubHandle2, NULL, NULL, TEST21_COMID + 2u, 0u, 0u, 0u,
+                          TEST21_MCDEST, TEST21_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL,
+                          (UINT8 *) "Not subscribed", 15u);
+        IF_ERROR("tlp_publish");
+
+        /*  Without filter: the stack drops the packets it did not subscribe   */
+        err = tlp_subscribe(appHandle2, &subHandle2, NULL, NULL, TEST21_COMID + 1u, 0u, 0u, 0u, 0u,
+                            TEST21_MCDEST, TRDP_FLAGS_DEFAULT, TEST21_INTERVAL * 10u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+
+        /*  With filter: the kernel drops them */
+        err = tlc_openSession(&appHandle3, gSession2.ifaceIP, 0u, NULL, NULL, NULL, &processConfig);
+        IF_ERROR("tlc_openSession");
+        err = tlp_subscribe(appHandle3, &subHandle3, NULL, NULL, TEST21_COMID + 1u, 0u, 0u, 0u, 0u,
+                            TEST21_MCDEST, TRDP_FLAGS_DEFAULT, TEST21_INTERVAL * 10u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe (filtered)");
+
+        test20Process(appHandle3, 1000000u);
+
+        dataSize = sizeof(data);
+        err = tlp_get(appHandle3, subHandle3, &pdInfo, data, &dataSize);
+        IF_ERROR("tlp_get (filtered)");
+
+        err = tlc_getStatistics(appHandle2, &stats);
+        IF_ERROR("tlc_getStatistics");
+        fprintf(gFp, "->> No filter: %u received, %u dropped by the stack\n", stats.pd.numRcv, stats.pd.numNoSubs);
+        if (stats.pd.numNoSubs == 0u)
+        {
+            FAILED("Packets without subscription not counted");
+        }
+
+        err = tlc_getStatistics(appHandle3, &stats);
+        IF_ERROR("tlc_getStatistics");
+        fprintf(gFp, "->> Filter for %u ComIds: %u received, %u dropped by the stack, %u dropped by the kernel\n",
+                stats.pdFilter.numComIds, stats.pd.numRcv, stats.pd.numNoSubs, stats.pdFilter.numKernelDrop);
+        if ((stats.pd.numNoSubs != 0u) || (stats.pdFilter.numKernelDrop == 0u) || (stats.pdFilter.numComIds != 2u))
+        {
+            FAILED("Packets without subscription not dropped by the kernel");
+        }
+
+        /*  Subscribing the second ComId updates the filter    */
+        err = tlp_subscribe(appHandle3, &subHandle3b, NULL, NULL, TEST21_COMID + 2u, 0u, 0u, 0u, 0u,
+                            TEST21_MCDEST, TRDP_FLAGS_DEFAULT, TEST21_INTERVAL * 10u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe (filtered)");
+
+        test20Process(appHandle3, 1000000u);
+
+        dataSize = sizeof(data);
+        err = tlp_get(appHandle3, subHandle3b, &pdInfo, data, &dataSize);
+        IF_ERROR("tlp_get (second ComId)");
+
+        /*  Unsubscribing removes the first one    */
+        err = tlp_unsubscribe(appHandle3, subHandle3);
+        IF_ERROR("tlp_unsubscribe");
+        err = tlc_getStatistics(appHandle3, &stats);
+        IF_ERROR("tlc_getStatistics");
+        if ((stats.pd.numNoSubs != 0u) || (stats.pdFilter.numComIds != 2u))
+        {
+            FAILED("Filter not updated");
+        }
+
+        err = tlp_unsubscribe(appHandle3, subHandle3b);
+        IF_ERROR("tlp_unsubscribe");
+        err = tlc_closeSession(appHandle3);
+        IF_ERROR("tlc_closeSession");
+        err = tlp_unsubscribe(appHandle2, subHandle2);
+        IF_ERROR("tlp_unsubscribe");
+        err = tlp_unpublish(appHandle1, pubHandle1);
+        IF_ERROR("tlp_unpublish");
+        err = tlp_unpublish(appHandle1, pubHandle2);
+        IF_ERROR("tlp_unpublish");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+
+/**********************************************************************************************************************/
+/** test22
+ *  Statistics export: a reader attached to the shared memory ring follows the snapshots while the session thread
+ *  exports them, ring limits, publisher/subscription counts and removal of the area
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST22_KEY          "/trdpApiTest22"
+#define TEST22_COMID        22000u
+#define TEST22_INTERVAL     10000u
+#define TEST22_EXPORT       20000u
+#define TEST22_SLOTS        4u
+#define TEST22_COMIDS       8u
+
+/*  Return the counters of a ComId in a snapshot */
+static const TRDP_COMID_STATISTICS_T *test22FindComId (
+    const TRDP_COMID_STATISTICS_T   *pComIdStats,
+    UINT32                          numComIds,
+    UINT32                          comId)
+{
+    UINT32 i;
+
+    for (i = 0u; i < numComIds; i++)
+    {
+        if (pComIdStats[i].comId == comId)
+        {
+            return &pComIdStats[i];
+        }
+    }
+    return NULL;
+}
+
+static int test22 ()
+{
+    PREPARE("Statistics export", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T                      pubHandle   = NULL;
+        TRDP_SUB_T                      subHandle   = NULL;
+        VOS_SHRD_T                      shrdHandle  = NULL;
+        UINT8                           *pArea      = NULL;
+        UINT32                          areaSize    = 0u;   /* attach only */
+        TRDP_STATISTICS_T               stats1, stats2;
+        TRDP_COMID_STATISTICS_T         comIds1[TEST22_COMIDS], comIds2[TEST22_COMIDS];
+        const TRDP_COMID_STATISTICS_T   *pCnt1, *pCnt2;
+        UINT32                          snap1 = 0u, snap2 = 0u, snapNo;
+        UINT32                          num1 = TEST22_COMIDS, num2 = TEST22_COMIDS;
+        UINT32                          numPub, numSubs;
+
+        /*  The session publishes and subscribes itself, the statistics telegrams count as well    */
+        err = tlc_getStatistics(appHandle1, &stats1);
+        IF_ERROR("tlc_getStatistics");
+        numPub  = stats1.pd.numPub;
+        numSubs = stats1.pd.numSubs;
+
+        err = tlp_publish(appHandle1, &pubHandle, NULL, NULL, TEST22_COMID, 0u, 0u, gSession1.ifaceIP,
+                          gSession1.ifaceIP, TEST22_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL,
+                          (UINT8 *) "Exported", 9u);
+        IF_ERROR("tlp_publish");
+        err = tlp_subscribe(appHandle1, &subHandle, NULL, NULL, TEST22_COMID, 0u, 0u, 0u, 0u, 0u,
+                            TRDP_FLAGS_DEFAULT, TEST22_INTERVAL * 10u, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+        err = tlc_startStatisticsExport(appHandle1, TEST22_KEY, TEST22_EXPORT, TEST22_SLOTS, TEST22_COMIDS);
+        IF_ERROR("tlc_startStatisticsExport");
+        vos_threadDelay(200000u);
+
+        /*  Attach like a monitoring process and follow the snapshots the session thread writes  */
+        if (vos_sharedOpen(TEST22_KEY, &shrdHandle, &pArea, &areaSize) != VOS_NO_ERR)
+        {
+            FAILED("Export area not found");
+        }
+        err = tlc_readStatisticsExport(pArea, areaSize, &snap1, &stats1, &num1, comIds1);
+        IF_ERROR("tlc_readStatisticsExport");
+        vos_threadDelay(200000u);
+        err = tlc_readStatisticsExport(pArea, areaSize, &snap2, &stats2, &num2, comIds2);
+        IF_ERROR("tlc_readStatisticsExport");
+
+        fprintf(gFp, "->> Snapshots %u..%u, %u publishers, %u subscriptions\n", snap1, snap2, stats2.pd.numPub,
+                stats2.pd.numSubs);
+        if ((snap2 - snap1 < 5u) || (snap2 - snap1 > 11u))
+        {
+            FAILED("Snapshots do not follow the export interval");
+        }
+        if ((stats2.pd.numPub != numPub + 1u) || (stats2.pd.numSubs != numSubs + 1u))
+        {
+            FAILED("Wrong publisher or subscription count");
+        }
+        if (stats2.pd.numSend <= stats1.pd.numSend)
+        {
+            FAILED("Send counter does not grow");
+        }
+        pCnt1   = test22FindComId(comIds1, num1, TEST22_COMID);
+        pCnt2   = test22FindComId(comIds2, num2, TEST22_COMID);
+        if ((pCnt1 == NULL) || (pCnt2 == NULL))
+        {
+            FAILED("ComId not counted");
+        }
+        fprintf(gFp, "->> ComId %u: %u sent, %u received\n", TEST22_COMID, pCnt2->pdNumSend, pCnt2->pdNumRcv);
+        if ((pCnt2->pdNumSend < pCnt1->pdNumSend + 15u) || (pCnt2->pdNumRcv < pCnt1->pdNumRcv + 15u) ||
+            (pCnt2->pdNumRcv > stats2.pd.numRcv))
+        {
+            FAILED("ComId counters do not grow");
+        }
+
+        /*  Ring limits */
+        snapNo  = snap2 - TEST22_SLOTS + 2u;
+        num1    = TEST22_COMIDS;
+        err     = tlc_readStatisticsExport(pArea, areaSize, &snapNo, &stats1, &num1, comIds1);
+        IF_ERROR("tlc_readStatisticsExport (older slot)");
+        snapNo  = snap2 - TEST22_SLOTS;
+        if (tlc_readStatisticsExport(pArea, areaSize, &snapNo, &stats1, &num1, comIds1) != TRDP_NODATA_ERR)
+        {
+            FAILED("Overwritten snapshot read");
+        }
+        snapNo  = snap2 + 100u;
+        if (tlc_readStatisticsExport(pArea, areaSize, &snapNo, &stats1, &num1, comIds1) != TRDP_NODATA_ERR)
+        {
+            FAILED("Future snapshot read");
+        }
+        snapNo  = 0u;
+        num1    = 0u;
+        if (tlc_readStatisticsExport(pArea, areaSize, &snapNo, &stats1, &num1, NULL) != TRDP_MEM_ERR)
+        {
+            FAILED("ComId counters returned without room");
+        }
+        if (tlc_readStatisticsExport(pArea, 16u, &snapNo, &stats1, &num1, NULL) != TRDP_PARAM_ERR)
+        {
+            FAILED("Short area accepted");
+        }
+
+        /*  Publisher and subscription counts survive a reset and follow unpublish  */
+        err = tlc_resetStatistics(appHandle1);
+        IF_ERROR("tlc_resetStatistics");
+        err = tlc_getStatistics(appHandle1, &stats1);
+        IF_ERROR("tlc_getStatistics");
+        if ((stats1.pd.numPub != numPub + 1u) || (stats1.pd.numSubs != numSubs + 1u))
+        {
+            FAILED("Counts lost by reset");
+        }
+        err = tlp_unpublish(appHandle1, pubHandle);
+        IF_ERROR("tlp_unpublish");
+        vos_threadDelay(3u * TEST22_EXPORT);
+        snapNo  = 0u;
+        num1    = TEST22_COMIDS;
+        err     = tlc_readStatisticsExport(pArea, areaSize, &snapNo, &stats1, &num1, comIds1);
+        IF_ERROR("tlc_readStatisticsExport");
+        if (stats1.pd.numPub != numPub)
+        {
+            FAILED("Unpublish not exported");
+        }
+        (void) vos_sharedClose(shrdHandle, pArea);
+
+        /*  The exporter removes the area   */
+        if (tlc_startStatisticsExport(appHandle1, TEST22_KEY, 0u, 2u, 1u) != TRDP_PARAM_ERR)
+        {
+            FAILED("Export started twice");
+        }
+        err = tlc_stopStatisticsExport(appHandle1);
+        IF_ERROR("tlc_stopStatisticsExport");
+        if (tlc_stopStatisticsExport(appHandle1) != TRDP_NODATA_ERR)
+        {
+            FAILED("Export stopped twice");
+        }
+        areaSize = 0u;
+        if (vos_sharedOpen(TEST22_KEY, &shrdHandle, &pArea, &areaSize) == VOS_NO_ERR)
+        {
+            (void) vos_sharedClose(shrdHandle, pArea);
+            FAILED("Export area not removed");
+        }
+        err = tlp_unsubscribe(appHandle1, subHandle);
+        IF_ERROR("tlp_unsubscribe");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+
+/**********************************************************************************************************************/
+/** test23
+ *  Timing histograms: bucket layout and percentiles, publisher and subscription histograms and the histogram
+ *  telegram pulled with TRDP_STATISTICS_PULL_COMID
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST23_COMID        23000u
+#define TEST23_MCDEST       0xEF000701u
+#define TEST23_INTERVAL     10000u
+#define TEST23_CB_TIME      200u
+
+/*  Callback which takes some time */
+static void test23CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    TRDP_TIME_T start, now;
+    TRDP_TIME_T spent = {0, TEST23_CB_TIME};
+
+    (void) pRefCon;
+    (void) appHandle;
+    (void) pMsg;
+    (void) pData;
+    (void) dataSize;
+    vos_getTime(&start);
+    vos_addTime(&start, &spent);
+    do
+    {
+        vos_getTime(&now);
+    }
+    while (vos_cmpTime(&now, &start) < 0);
+}
+
+/*  Return the bucket a value is counted in */
+static UINT32 test23BucketOf (
+    UINT32 value)
+{
+    UINT32 i = 1u;
+
+    while ((i < TRDP_HIST_BUCKETS) && (tlc_getHistogramBucketStart(i) <= value))
+    {
+        i++;
+    }
+    return i - 1u;
+}
+
+static int test23 ()
+{
+    PREPARE("Timing histograms", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T              pubHandle   = NULL;
+        TRDP_PUB_T              pubHandle1  = NULL;
+        TRDP_SUB_T              subHandle   = NULL;
+        TRDP_SUB_T              histHandle  = NULL;
+        TRDP_APP_SESSION_T      appHandle3  = NULL;
+        TRDP_PROCESS_CONFIG_T   processConfig = {"Test23", "", 0u, 0u, TRDP_OPTION_HISTOGRAMS};
+        TRDP_HISTOGRAM_T        hist;
+        TRDP_HIST_STATISTICS_T  reply;
+        TRDP_PD_INFO_T          pdInfo;
+        UINT32                  request[2];
+        UINT32                  dataSize;
+        UINT32                  median;
+        UINT32                  sum = 0u;
+        UINT32                  i;
+
+        /*  Bucket layout: exact up to 8us, then 4 buckets per power of 2   */
+        if ((tlc_getHistogramBucketStart(0u) != 0u) || (tlc_getHistogramBucketStart(3u) != 3u) ||
+            (tlc_getHistogramBucketStart(4u) != 4u) || (tlc_getHistogramBucketStart(8u) != 8u) ||
+            (tlc_getHistogramBucketStart(9u) != 10u) ||
+            (tlc_getHistogramBucketStart(TRDP_HIST_BUCKETS - 1u) != 0xE0000000u))
+        {
+            FAILED("Wrong bucket layout");
+        }
+        for (i = 1u; i < TRDP_HIST_BUCKETS; i++)
+        {
+            if (tlc_getHistogramBucketStart(i) <= tlc_getHistogramBucketStart(i - 1u))
+            {
+                FAILED("Buckets not ascending");
+            }
+        }
+
+        /*  90 values of 1000us (bucket 896..1023), 10 values of 50000us  */
+        memset(&hist, 0, sizeof(hist));
+        hist.count  = 100u;
+        hist.min    = 1000u;
+        hist.max    = 50000u;
+        hist.bucket[test23BucketOf(1000u)]  = 90u;
+        hist.bucket[test23BucketOf(50000u)] = 10u;
+        if ((tlc_getHistogramBucketStart(test23BucketOf(1000u)) != 896u) ||
+            (tlc_getHistogramPercentile(&hist, 0u) != 1000u) ||
+            (tlc_getHistogramPercentile(&hist, 500u) != 1023u) ||
+            (tlc_getHistogramPercentile(&hist, 900u) != 1023u) ||
+            (tlc_getHistogramPercentile(&hist, 910u) != 50000u) ||
+            (tlc_getHistogramPercentile(&hist, 1000u) != 50000u))
+        {
+            FAILED("Wrong percentiles");
+        }
+        hist.count = 0u;
+        if ((tlc_getHistogramPercentile(&hist, 500u) != 0u) || (tlc_getHistogramPercentile(NULL, 500u) != 0u))
+        {
+            FAILED("Percentile of an empty histogram");
+        }
+
+        /*  The session with histograms sends to itself, both callbacks take some time  */
+        err = tlc_openSession(&appHandle3, gSession2.ifaceIP, 0u, NULL, NULL, NULL, &processConfig);
+        IF_ERROR("tlc_openSession");
+        err = tlp_publish(appHandle3, &pubHandle, NULL, test23CBFunction, TEST23_COMID, 0u, 0u, 0u,
+                          TEST23_MCDEST, TEST23_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL,
+                          (UINT8 *) "Histogram", 10u);
+        IF_ERROR("tlp_publish");
+        err = tlp_subscribe(appHandle3, &subHandle, NULL, test23CBFunction, TEST23_COMID, 0u, 0u, 0u, 0u,
+                            TEST23_MCDEST, TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB, TEST23_INTERVAL * 10u,
+                            TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+        test20Process(appHandle3, 600000u);
+
+        err = tlc_getSubsHistogram(appHandle3, subHandle, TRDP_HIST_RCV_INTERVAL, &hist);
+        IF_ERROR("tlc_getSubsHistogram");
+        for (i = 0u; i < TRDP_HIST_BUCKETS; i++)
+        {
+            sum += hist.bucket[i];
+        }
+        median = tlc_getHistogramPercentile(&hist, 500u);
+        fprintf(gFp, "->> Receive interval: %u values, min %uus, median %uus, max %uus\n",
+                hist.count, hist.min, median, hist.max);
+        if ((hist.count < 40u) || (sum != hist.count) || (hist.min > hist.max) ||
+            (median < TEST23_INTERVAL * 8u / 10u) || (median > TEST23_INTERVAL * 13u / 10u))
+        {
+            FAILED("Wrong receive interval histogram");
+        }
+        err = tlc_getSubsHistogram(appHandle3, subHandle, TRDP_HIST_CALLBACK, &hist);
+        IF_ERROR("tlc_getSubsHistogram");
+        if ((hist.count < 40u) || (hist.min < TEST23_CB_TIME))
+        {
+            FAILED("Wrong subscription callback histogram");
+        }
+        err = tlc_getPubHistogram(appHandle3, pubHandle, TRDP_HIST_SND_LATENESS, &hist);
+        IF_ERROR("tlc_getPubHistogram");
+        fprintf(gFp, "->> Send lateness: %u values, median %uus\n", hist.count,
+                tlc_getHistogramPercentile(&hist, 500u));
+        if ((hist.count < 40u) || (tlc_getHistogramPercentile(&hist, 500u) >= TEST23_INTERVAL))
+        {
+            FAILED("Wrong send lateness histogram");
+        }
+        err = tlc_getPubHistogram(appHandle3, pubHandle, TRDP_HIST_CALLBACK, &hist);
+        IF_ERROR("tlc_getPubHistogram");
+        if ((hist.count < 40u) || (hist.min < TEST23_CB_TIME))
+        {
+            FAILED("Wrong publisher callback histogram");
+        }
+
+        if ((tlc_getPubHistogram(appHandle3, pubHandle, TRDP_HIST_RCV_INTERVAL, &hist) != TRDP_PARAM_ERR) ||
+            (tlc_getSubsHistogram(appHandle3, subHandle, TRDP_HIST_SND_LATENESS, &hist) != TRDP_PARAM_ERR) ||
+            (tlc_getSubsHistogram(appHandle3, subHandle, TRDP_HIST_CALLBACK, NULL) != TRDP_PARAM_ERR))
+        {
+            FAILED("Wrong histogram kind accepted");
+        }
+        if ((tlc_getPubHistogram(appHandle3, (TRDP_PUB_T) subHandle, TRDP_HIST_CALLBACK, &hist) != TRDP_NOPUB_ERR) ||
+            (tlc_getSubsHistogram(appHandle3, (TRDP_SUB_T) pubHandle, TRDP_HIST_CALLBACK, &hist) != TRDP_NOSUB_ERR))
+        {
+            FAILED("Wrong element accepted");
+        }
+
+        /*  Pull the histogram telegram of the subscription. Request and reply use the group, it is joined by this
+            session only, while a unicast request could be delivered to the other session on the same address   */
+        err = tlp_subscribe(appHandle3, &histHandle, NULL, NULL, TRDP_HIST_STATISTICS_COMID, 0u, 0u, 0u, 0u,
+                            TEST23_MCDEST, TRDP_FLAGS_DEFAULT, TRDP_TIMER_FOREVER, TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+        request[0]  = vos_htonl(TEST23_COMID);
+        request[1]  = vos_htonl(0u);            /* subscription */
+        err = tlp_request(appHandle3, histHandle, TRDP_STATISTICS_PULL_COMID, 0u, 0u, 0u, TEST23_MCDEST, 0u,
+                          TRDP_FLAGS_DEFAULT, NULL, (const UINT8 *) request, sizeof(request),
+                          TRDP_HIST_STATISTICS_COMID, TEST23_MCDEST);
+        IF_ERROR("tlp_request");
+        test20Process(appHandle3, 100000u);
+
+        memset(&reply, 0, sizeof(reply));
+        dataSize = sizeof(reply);
+        err = tlp_get(appHandle3, histHandle, &pdInfo, (UINT8 *) &reply, &dataSize);
+        IF_ERROR("tlp_get (histogram telegram)");
+        fprintf(gFp, "->> Histogram telegram of ComId %u: status %u, %u intervals, %u callbacks\n",
+                vos_ntohl(reply.comId), vos_ntohl(reply.status), vos_ntohl(reply.cycle.count),
+                vos_ntohl(reply.callback.count));
+        if ((dataSize != sizeof(TRDP_HIST_STATISTICS_T)) || (vos_ntohl(reply.comId) != TEST23_COMID) ||
+            (vos_ntohl(reply.role) != 0u) || (vos_ntohl(reply.status) != 0u) ||
+            (vos_ntohl(reply.cycle.count) < 40u) || (vos_ntohl(reply.callback.count) < 40u))
+        {
+            FAILED("Wrong histogram telegram");
+        }
+
+        /*  Unknown element  */
+        request[0]  = vos_htonl(TEST23_COMID + 1u);
+        request[1]  = vos_htonl(1u);            /* publisher */
+        err = tlp_request(appHandle3, histHandle, TRDP_STATISTICS_PULL_COMID, 0u, 0u, 0u, TEST23_MCDEST, 0u,
+                          TRDP_FLAGS_DEFAULT, NULL, (const UINT8 *) request, sizeof(request),
+                          TRDP_HIST_STATISTICS_COMID, TEST23_MCDEST);
+        IF_ERROR("tlp_request");
+        test20Process(appHandle3, 100000u);
+        dataSize = sizeof(reply);
+        err = tlp_get(appHandle3, histHandle, &pdInfo, (UINT8 *) &reply, &dataSize);
+        IF_ERROR("tlp_get (histogram telegram)");
+        if ((vos_ntohl(reply.comId) != TEST23_COMID + 1u) || (vos_ntohl(reply.status) != 1u))
+        {
+            FAILED("Unknown element not reported");
+        }
+
+        /*  A session without the option keeps no histograms   */
+        err = tlp_publish(appHandle1, &pubHandle1, NULL, NULL, TEST23_COMID, 0u, 0u, 0u, TEST23_MCDEST,
+                          TEST23_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL, (UINT8 *) "Histogram", 10u);
+        IF_ERROR("tlp_publish");
+        if (tlc_getPubHistogram(appHandle1, pubHandle1, TRDP_HIST_SND_LATENESS, &hist) != TRDP_NODATA_ERR)
+        {
+            FAILED("Histograms kept without TRDP_OPTION_HISTOGRAMS");
+        }
+
+        err = tlp_unpublish(appHandle1, pubHandle1);
+        IF_ERROR("tlp_unpublish");
+        err = tlc_closeSession(appHandle3);
+        IF_ERROR("tlc_closeSession");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+
+/**********************************************************************************************************************/
+/** test24
+ *  Trace of tlc_process: event order and nesting of the phases, ring overwrite and removal of the area
+ *  (tracepoints are only compiled in with TRACE=1)
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST24_KEY          "/trdpApiTest24"
+#define TEST24_COMID        24000u
+#define TEST24_MCDEST       0xEF000801u
+#define TEST24_INTERVAL     10000u
+#define TEST24_EVENTS       4096u
+#define TEST24_SMALL_RING   64u
+
+#if TRDP_TRACE
+static TRDP_TRACE_EVENT_T gTest24Events[TEST24_EVENTS];
+
+static void test24CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    (void) pRefCon;
+    (void) appHandle;
+    (void) pMsg;
+    (void) pData;
+    (void) dataSize;
+}
+#endif
+
+static int test24 ()
+{
+    PREPARE("Trace of tlc_process", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+#if TRDP_TRACE
+        TRDP_PUB_T              pubHandle   = NULL;
+        TRDP_SUB_T              subHandle   = NULL;
+        TRDP_APP_SESSION_T      appHandle3  = NULL;
+        TRDP_PROCESS_CONFIG_T   processConfig = {"Test24", "", 0u, 0u, TRDP_OPTION_NONE};
+        VOS_SHRD_T              shrdHandle  = NULL;
+        UINT8                   *pArea      = NULL;
+        UINT32                  areaSize    = 0u;
+        UINT32                  next        = 0u;
+        UINT32                  num         = TEST24_EVENTS;
+        UINT32                  lost        = 1u;
+        UINT32                  depth       = 0u;
+        UINT32                  process     = 0u;
+        UINT32                  sent        = 0u;
+        UINT32                  rcvd        = 0u;
+        UINT32                  cbs         = 0u;
+        UINT32                  i;
+        int                     ordered     = TRUE;
+        int                     nested      = TRUE;
+
+        /*  The traced session is processed by this thread only  */
+        err = tlc_openSession(&appHandle3, gSession2.ifaceIP, 0u, NULL, NULL, NULL, &processConfig);
+        IF_ERROR("tlc_openSession");
+        err = tlp_publish(appHandle3, &pubHandle, NULL, test24CBFunction, TEST24_COMID, 0u, 0u, 0u,
+                          TEST24_MCDEST, TEST24_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL,
+                          (UINT8 *) dataBuffer1, 32u);
+        IF_ERROR("tlp_publish");
+        err = tlp_subscribe(appHandle3, &subHandle, NULL, test24CBFunction, TEST24_COMID, 0u, 0u, 0u, 0u,
+                            TEST24_MCDEST, TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB, TEST24_INTERVAL * 10u,
+                            TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+        test20Process(appHandle3, 50000u);
+
+        /*  Trace 200ms  */
+        if (tlc_startTrace(appHandle3, NULL, TEST24_EVENTS) != TRDP_PARAM_ERR)
+        {
+            FAILED("Trace without key started");
+        }
+        err = tlc_startTrace(appHandle3, TEST24_KEY, TEST24_EVENTS);
+        IF_ERROR("tlc_startTrace");
+        if (tlc_startTrace(appHandle3, TEST24_KEY, TEST24_EVENTS) != TRDP_PARAM_ERR)
+        {
+            FAILED("Trace started twice");
+        }
+        test20Process(appHandle3, 200000u);
+
+        if (vos_sharedOpen(TEST24_KEY, &shrdHandle, &pArea, &areaSize) != VOS_NO_ERR)
+        {
+            FAILED("Trace area not found");
+        }
+        err = tlc_readTrace(pArea, areaSize, &next, gTest24Events, &num, &lost);
+        IF_ERROR("tlc_readTrace");
+        for (i = 0u; i < num; i++)
+        {
+            const TRDP_TRACE_EVENT_T *pEv = &gTest24Events[i];
+
+            if ((i > 0u) && ((pEv->sec < gTest24Events[i - 1u].sec) ||
+                             ((pEv->sec == gTest24Events[i - 1u].sec) && (pEv->usec < gTest24Events[i - 1u].usec))))
+            {
+                ordered = FALSE;
+            }
+            switch (pEv->type)
+            {
+               case TRDP_TRACE_BEGIN:
+                   if ((pEv->phase == TRDP_TRACE_PROCESS) != (depth == 0u))
+                   {
+                       nested = FALSE;
+                   }
+                   depth++;
+                   break;
+               case TRDP_TRACE_END:
+                   if ((depth == 0u) || ((pEv->phase == TRDP_TRACE_PROCESS) != (depth == 1u)))
+                   {
+                       nested = FALSE;
+                   }
+                   depth--;
+                   process += (pEv->phase == TRDP_TRACE_PROCESS) ? 1u : 0u;
+                   break;
+               case TRDP_TRACE_PD_SENT:
+                   sent += ((pEv->comId == TEST24_COMID) && (pEv->size > 16u)) ? 1u : 0u;
+                   break;
+               case TRDP_TRACE_PD_RECEIVED:
+                   rcvd += ((pEv->comId == TEST24_COMID) && (pEv->size > 16u)) ? 1u : 0u;
+                   break;
+               case TRDP_TRACE_CB_BEGIN:
+                   nested = nested && (depth == 2u) && (pEv->comId == TEST24_COMID);
+                   break;
+               case TRDP_TRACE_CB_END:
+                   cbs++;
+                   break;
+               default:
+                   break;
+            }
+        }
+        fprintf(gFp, "->> %u events, %u lost: %u tlc_process calls, %u sent, %u received, %u callbacks\n",
+                num, lost, process, sent, rcvd, cbs);
+        if ((lost != 0u) || (num <= 100u) || (num >= TEST24_EVENTS) || (next != num))
+        {
+            FAILED("Wrong number of events");
+        }
+        if (!ordered || !nested || (depth != 0u))
+        {
+            FAILED("Events not ordered or phases not nested");
+        }
+        if ((process < 20u) || (sent < 15u) || (sent > 25u) || (rcvd < 15u) || (rcvd > sent) ||
+            (cbs < rcvd + sent))
+        {
+            FAILED("Wrong number of traced calls, packets or callbacks");
+        }
+        num = TEST24_EVENTS;
+        if (tlc_readTrace(pArea, areaSize, &next, gTest24Events, &num, &lost) != TRDP_NODATA_ERR)
+        {
+            FAILED("Events read twice");
+        }
+        if (tlc_readTrace(pArea, 8u, &next, gTest24Events, &num, &lost) != TRDP_PARAM_ERR)
+        {
+            FAILED("Short area accepted");
+        }
+        (void) vos_sharedClose(shrdHandle, pArea);
+
+        err = tlc_stopTrace(appHandle3);
+        IF_ERROR("tlc_stopTrace");
+        if (tlc_stopTrace(appHandle3) != TRDP_NODATA_ERR)
+        {
+            FAILED("Trace stopped twice");
+        }
+        areaSize = 0u;
+        if (vos_sharedOpen(TEST24_KEY, &shrdHandle, &pArea, &areaSize) == VOS_NO_ERR)
+        {
+            (void) vos_sharedClose(shrdHandle, pArea);
+            FAILED("Trace area not removed");
+        }
+
+        /*  A ring overwritten before it is read: the oldest events are lost    */
+        err = tlc_startTrace(appHandle3, TEST24_KEY, TEST24_SMALL_RING - 1u);
+        IF_ERROR("tlc_startTrace");
+        test20Process(appHandle3, 100000u);
+        areaSize = 0u;
+        if (vos_sharedOpen(TEST24_KEY, &shrdHandle, &pArea, &areaSize) != VOS_NO_ERR)
+        {
+            FAILED("Trace area not found");
+        }
+        next    = 0u;
+        num     = TEST24_EVENTS;
+        err     = tlc_readTrace(pArea, areaSize, &next, gTest24Events, &num, &lost);
+        IF_ERROR("tlc_readTrace");
+        if ((((const TRDP_TRACE_HDR_T *) pArea)->noOfEvents != TEST24_SMALL_RING) ||
+            (num != TEST24_SMALL_RING) || (lost == 0u) || (next != lost + num))
+        {
+            FAILED("Ring not overwritten");
+        }
+        (void) vos_sharedClose(shrdHandle, pArea);
+
+        /*  The session removes the area on close   */
+        err = tlc_closeSession(appHandle3);
+        IF_ERROR("tlc_closeSession");
+        areaSize = 0u;
+        if (vos_sharedOpen(TEST24_KEY, &shrdHandle, &pArea, &areaSize) == VOS_NO_ERR)
+        {
+            (void) vos_sharedClose(shrdHandle, pArea);
+            FAILED("Trace area not removed on close");
+        }
+#else
+        fprintf(gFp, "->> Tracepoints not compiled in (TRACE=1)\n");
+#endif
+    }
 
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+
+/**********************************************************************************************************************/
+/** test25
+ *  Processing budget of tlc_process: slow PD callbacks defer MD and statistics work without losing PDs or
+ *  notifications, callbacks slower than the PD cycle overrun the interval
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST25_PD_COMID     25000u
+#define TEST25_MD_COMID     25001u
+#define TEST25_MCDEST       0xEF000901u
+#define TEST25_INTERVAL     10000u
+#define TEST25_BUDGET       1000u
+#define TEST25_SLOW_CB      3000u
+#define TEST25_OVERRUN_CB   15000u
+#define TEST25_NOTIFIES     20u
+
+static UINT32   gTest25CbDelay;
+static UINT32   gTest25MdRcvd;
+
+/*  PD callback, takes gTest25CbDelay us for received packets */
+static void test25PDCBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_PD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    (void) pRefCon;
+    (void) appHandle;
+    (void) pData;
+    (void) dataSize;
+    if ((pMsg->resultCode == TRDP_NO_ERR) && (gTest25CbDelay != 0u))
+    {
+        (void) vos_threadDelay(gTest25CbDelay);
+    }
+}
+
+static void test25MDCBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    (void) pRefCon;
+    (void) appHandle;
+    (void) pData;
+    (void) dataSize;
+    if ((pMsg->resultCode == TRDP_NO_ERR) && (pMsg->comId == TEST25_MD_COMID))
+    {
+        gTest25MdRcvd++;
+    }
+}
+
+static int test25 ()
+{
+    PREPARE("tlc_process budget", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        TRDP_PUB_T              pubHandle   = NULL;
+        TRDP_SUB_T              subHandle   = NULL;
+        TRDP_LIS_T              lisHandle   = NULL;
+        TRDP_APP_SESSION_T      appHandle3  = NULL;
+        TRDP_PROCESS_CONFIG_T   processConfig = {"Test25", "", 0u, 0u, TRDP_OPTION_NONE};
+        TRDP_STATISTICS_T       stats;
+        UINT32                  sum = 0u;
+        UINT32                  i;
+
+        gTest25CbDelay  = 0u;
+        gTest25MdRcvd   = 0u;
+
+        /*  The session sends PD and MD to a group only it has joined  */
+        err = tlc_openSession(&appHandle3, gSession2.ifaceIP, 0u, NULL, NULL, NULL, &processConfig);
+        IF_ERROR("tlc_openSession");
+        err = tlp_publish(appHandle3, &pubHandle, NULL, test25PDCBFunction, TEST25_PD_COMID, 0u, 0u, 0u,
+                          TEST25_MCDEST, TEST25_INTERVAL, 0u, TRDP_FLAGS_DEFAULT, NULL,
+                          (UINT8 *) dataBuffer1, 32u);
+        IF_ERROR("tlp_publish");
+        err = tlp_subscribe(appHandle3, &subHandle, NULL, test25PDCBFunction, TEST25_PD_COMID, 0u, 0u, 0u, 0u,
+                            TEST25_MCDEST, TRDP_FLAGS_CALLBACK | TRDP_FLAGS_FORCE_CB, TEST25_INTERVAL * 20u,
+                            TRDP_TO_DEFAULT);
+        IF_ERROR("tlp_subscribe");
+        err = tlm_addListener(appHandle3, &lisHandle, NULL, test25MDCBFunction, TRUE, TEST25_MD_COMID, 0u, 0u,
+                              0u, 0u, TEST25_MCDEST, TRDP_FLAGS_CALLBACK, NULL, NULL);
+        IF_ERROR("tlm_addListener");
+        if (tlc_setProcessBudget(NULL, TEST25_BUDGET) != TRDP_NOINIT_ERR)
+        {
+            FAILED("Budget of an invalid session set");
+        }
+
+        /*  Without budget: time is accounted, nothing is deferred   */
+        test20Process(appHandle3, 100000u);
+        err = tlc_getStatistics(appHandle3, &stats);
+        IF_ERROR("tlc_getStatistics");
+        for (i = 1u; i < TRDP_PROCESS_PHASES; i++)
+        {
+            sum += stats.process.phaseTime[i];
+        }
+        fprintf(gFp, "->> No budget: %u cycles, %uus in tlc_process, %uus in its phases\n",
+                stats.process.numCycles, stats.process.phaseTime[TRDP_TRACE_PROCESS], sum);
+        if ((stats.process.budget != 0u) || (stats.process.numCycles < 10u) ||
+            (stats.process.numDeferred != 0u) || (stats.process.numOverBudget != 0u))
+        {
+            FAILED("Wrong cycle counters without budget");
+        }
+        if ((sum > stats.process.phaseTime[TRDP_TRACE_PROCESS]) ||
+            (stats.process.phaseMax[TRDP_TRACE_PROCESS] > stats.process.phaseTime[TRDP_TRACE_PROCESS]))
+        {
+            FAILED("Phase times exceed the time in tlc_process");
+        }
+
+        /*  Slow PD callbacks exceed the budget: MD is deferred, PD is not, nothing is lost   */
+        err = tlc_setProcessBudget(appHandle3, TEST25_BUDGET);
+        IF_ERROR("tlc_setProcessBudget");
+        err = tlc_resetStatistics(appHandle3);
+        IF_ERROR("tlc_resetStatistics");
+        gTest25CbDelay = TEST25_SLOW_CB;
+        for (i = 0u; i < TEST25_NOTIFIES; i++)
+        {
+            err = tlm_notify(appHandle3, NULL, NULL, TEST25_MD_COMID, 0u, 0u, 0u, TEST25_MCDEST,
+                             TRDP_FLAGS_DEFAULT, NULL, (UINT8 *) dataBuffer1, 32u, NULL, NULL);
+            IF_ERROR("tlm_notify");
+            test20Process(appHandle3, TEST25_INTERVAL);
+        }
+        gTest25CbDelay = 0u;
+        test20Process(appHandle3, 50000u);
+        err = tlc_getStatistics(appHandle3, &stats);
+        IF_ERROR("tlc_getStatistics");
+        fprintf(gFp, "->> Budget %uus: %u cycles, %u over budget, %u deferred, %u PD sent, %u MD received\n",
+                stats.process.budget, stats.process.numCycles, stats.process.numOverBudget,
+                stats.process.numDeferred, stats.pd.numSend, gTest25MdRcvd);
+        if ((stats.process.budget != TEST25_BUDGET) || (stats.process.numOverBudget < TEST25_NOTIFIES / 2u))
+        {
+            FAILED("Budget not exceeded");
+        }
+        if ((stats.process.numDeferred < TEST25_NOTIFIES / 2u) ||
+            (stats.process.numDeferred > stats.process.numCycles / 2u + 1u))
+        {
+            FAILED("Work not deferred or deferred twice in a row");
+        }
+        if (stats.process.phaseMax[TRDP_TRACE_PD_RECEIVE] < TEST25_SLOW_CB)
+        {
+            FAILED("Callback time not accounted to PD receive");
+        }
+        if ((stats.pd.numSend < TEST25_NOTIFIES + 3u) || (gTest25MdRcvd != TEST25_NOTIFIES))
+        {
+            FAILED("PD not sent in time or MD lost");
+        }
+
+        /*  Callbacks slower than the PD cycle overrun the interval   */
+        err = tlc_setProcessBudget(appHandle3, 0u);
+        IF_ERROR("tlc_setProcessBudget");
+        err = tlc_resetStatistics(appHandle3);
+        IF_ERROR("tlc_resetStatistics");
+        gTest25CbDelay = TEST25_OVERRUN_CB;
+        test20Process(appHandle3, 100000u);
+        gTest25CbDelay = 0u;
+        err = tlc_getStatistics(appHandle3, &stats);
+        IF_ERROR("tlc_getStatistics");
+        fprintf(gFp, "->> Slow callbacks: %u overruns\n", stats.process.numOverrun);
+        if ((stats.process.numOverrun == 0u) || (stats.process.numDeferred != 0u) ||
+            (stats.process.numOverBudget != 0u))
+        {
+            FAILED("Overrun not counted or budget still active");
+        }
+
+        err = tlc_closeSession(appHandle3);
+        IF_ERROR("tlc_closeSession");
+    }
 
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
+
+/**********************************************************************************************************************/
+/** test26
+ *  UDP MD Request - Reply, the replier echoes the request: the reply data points into the received request buffer,
+ *  which trdp_mdReply may free only after the reply is copied. Freed too early, the reply carries the zeroed or
+ *  reused buffer instead.
+ *
+ *  @retval         0        no error
+ *  @retval         1        some error
+ */
+#define TEST26_COMID        26000u
+#define TEST26_DATA_LEN     1024u
+#define TEST26_REQUESTS     20
+
+static int      gTest26Replies;
+static UINT8    gTest26Request[TEST26_DATA_LEN];
+
+static void test26CBFunction (
+    void                    *pRefCon,
+    TRDP_APP_SESSION_T      appHandle,
+    const TRDP_MD_INFO_T    *pMsg,
+    UINT8                   *pData,
+    UINT32                  dataSize)
+{
+    TRDP_ERR_T err;
+
+    (void) pRefCon;
+    if (pMsg->resultCode != TRDP_NO_ERR)
+    {
+        fprintf(gFp, "->> Error %d (ComId %u)\n", pMsg->resultCode, pMsg->comId);
+        gFailed = 1;
+    }
+    else if ((pMsg->msgType == TRDP_MSG_MR) && (pMsg->comId == TEST26_COMID))
+    {
+        /* Reply with the received data, in place */
+        err = tlm_reply(appHandle, &pMsg->sessionId, TEST26_COMID, 0u, NULL, pData, dataSize);
+        IF_ERROR("tlm_reply");
+    }
+    else if ((pMsg->msgType == TRDP_MSG_MP) && (pMsg->comId == TEST26_COMID))
+    {
+        if ((dataSize != TEST26_DATA_LEN) || (memcmp(pData, gTest26Request, TEST26_DATA_LEN) != 0))
+        {
+            fprintf(gFp, "### Echoed data corrupted (%u bytes)\n", dataSize);
+            gFailed = 1;
+        }
+        gTest26Replies++;
+    }
+    else
+    {
+        fprintf(gFp, "->> Unsolicited Message received (type = %0xhx)\n", pMsg->msgType);
+        gFailed = 1;
+    }
+end:
+    return;
+}
+
+static int test26 ()
+{
+    PREPARE("UDP MD Request - Reply, reply echoes the request data", "test");
+
+    /* ------------------------- test code starts here --------------------------- */
+
+    {
+        int                 i;
+        UINT32              j;
+        TRDP_UUID_T         sessionId1;
+        TRDP_LIS_T          listenHandle;
+
+        gTest26Replies = 0;
+
+        err = tlm_addListener(appHandle2, &listenHandle, NULL, test26CBFunction, TRUE, TEST26_COMID, 0u, 0u, 0u,
+                              VOS_INADDR_ANY, VOS_INADDR_ANY, TRDP_FLAGS_CALLBACK, NULL, NULL);
+        IF_ERROR("tlm_addListener");
+
+        /*  New data for every request, a stale buffer cannot pass for the echo   */
+        for (i = 0; i < TEST26_REQUESTS; i++)
+        {
+            for (j = 0u; j < TEST26_DATA_LEN; j++)
+            {
+                gTest26Request[j] = (UINT8) (i + j);
+            }
+            err = tlm_request(appHandle1, NULL, test26CBFunction, &sessionId1, TEST26_COMID, 0u, 0u,
+                              0u, gSession2.ifaceIP, TRDP_FLAGS_CALLBACK, 1u, 1000000u, NULL,
+                              gTest26Request, TEST26_DATA_LEN, NULL, NULL);
+            IF_ERROR("tlm_request");
+            vos_threadDelay(100000u);
+        }
+
+        fprintf(gFp, "->> %d of %d replies received\n", gTest26Replies, TEST26_REQUESTS);
+        if (gTest26Replies != TEST26_REQUESTS)
+        {
+            FAILED("Replies missing");
+        }
+
+        err = tlm_delListener(appHandle2, listenHandle);
+        IF_ERROR("tlm_delListener");
+    }
+
+    /* ------------------------- test code ends here --------------------------- */
+
+    CLEANUP;
+}
 
 /**********************************************************************************************************************/
 /* This array holds pointers to the m-th test (m = 1 will execute test1...)                                           */
@@ -2103,6 +3719,16 @@ test_func_t *testArray[] =
     test14,  /* Publish & Subscribe, Callback */
     test15, /* MD Request - Reply / Reuse of TCP connection */
     test16, /* MD Request - Reply / UDP */
+    test17, /* TCP MD Request - Reply / user data sent in place */
+    test18, /* TCP MD Request - Reply / pipelined on one pooled connection */
+    test19, /* TCP MD Request - Reply / several hundred peers */
+    test20, /* PD multicast joins / source specific multicast */
+    test21, /* PD kernel socket filter for subscribed ComIds */
+    test22, /* Statistics export into a shared memory ring */
+    test23, /* Timing histograms and histogram telegram */
+    test24, /* Trace of tlc_process (TRACE=1) */
+    test25, /* Processing budget and time accounting of tlc_process */
+    test26, /* UDP MD Request - Reply / reply echoes the request data */
     NULL
 };
 
@@ -0,0 +1,448 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp-cfgimg-test.c
+ *
+ * @brief           Test of the binary configuration image
+ *
+ * @details         Builds the image of an XML configuration file and compares everything read out of the image with
+ *                  the results of tau_readXmlDeviceConfig, tau_readXmlInterfaceConfig and tau_readXmlDatasetConfig.
+ *                  A corrupted copy of the image must be rejected. Finally the time to read the whole configuration
+ *                  from XML and from the image is measured.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "tau_xml.h"
+#include "tau_cfgimg.h"
+#include "vos_mem.h"
+#include "vos_utils.h"
+
+/***********************************************************************************************************************
+ * DEFINITIONS
+ */
+
+#define TEST_IMAGE_FILE     "trdp-cfgimg-test.img"
+#define TEST_LOOPS          100u
+
+#define CHECK(cond, what)  do { if (!(cond)) { printf("  mismatch: %s\n", what); gErrors++; } } while (0)
+
+/** Everything read out of one configuration */
+typedef struct
+{
+    TRDP_MEM_CONFIG_T       memConfig;
+    TRDP_DBG_CONFIG_T       dbgConfig;
+    UINT32                  trafficStoreSize;
+    UINT32                  numComPar;
+    TRDP_COM_PAR_T          *pComPar;
+    UINT32                  numIfConfig;
+    TRDP_IF_CONFIG_T        *pIfConfig;
+    UINT32                  numComId;
+    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap;
+    UINT32                  numDataset;
+    apTRDP_DATASET_T        apDataset;
+} TEST_CONFIG_T;
+
+static UINT32 gErrors = 0u;
+
+/**********************************************************************************************************************/
+static UINT64 nowUs (void)
+{
+    VOS_TIMEVAL_T now;
+
+    vos_getTime(&now);
+    return (UINT64) now.tv_sec * 1000000u + (UINT64) now.tv_usec;
+}
+
+/**********************************************************************************************************************/
+static int sameString (const void *p1, const void *p2)
+{
+    if ((p1 == NULL) || (p2 == NULL))
+    {
+        return p1 == p2;
+    }
+    return strcmp((const char *) p1, (const char *) p2) == 0;
+}
+
+/**********************************************************************************************************************/
+static int sameData (const void *p1, const void *p2, size_t size)
+{
+    if ((p1 == NULL) || (p2 == NULL))
+    {
+        return p1 == p2;
+    }
+    return memcmp(p1, p2, size) == 0;
+}
+
+/**********************************************************************************************************************/
+static void compareTelegrams (UINT32 num, const TRDP_EXCHG_PAR_T *pXml, const TRDP_EXCHG_PAR_T *pImg)
+{
+    UINT32 i, j;
+
+    for (i = 0u; i < num; i++)
+    {
+        CHECK(pXml[i].comId == pImg[i].comId, "telegram comId");
+        CHECK(pXml[i].datasetId == pImg[i].datasetId, "telegram datasetId");
+        CHECK(pXml[i].comParId == pImg[i].comParId, "telegram comParId");
+        CHECK(pXml[i].type == pImg[i].type, "telegram type");
+        CHECK(pXml[i].create == pImg[i].create, "telegram create");
+        CHECK(sameData(pXml[i].pMdPar, pImg[i].pMdPar, sizeof(TRDP_MD_PAR_T)), "telegram MD parameters");
+        CHECK(sameData(pXml[i].pPdPar, pImg[i].pPdPar, sizeof(TRDP_PD_PAR_T)), "telegram PD parameters");
+        CHECK(pXml[i].destCnt == pImg[i].destCnt, "telegram destCnt");
+        CHECK(pXml[i].srcCnt == pImg[i].srcCnt, "telegram srcCnt");
+        for (j = 0u; (j < pXml[i].destCnt) && (pXml[i].pDest != NULL) && (pImg[i].pDest != NULL); j++)
+        {
+            CHECK(pXml[i].pDest[j].id == pImg[i].pDest[j].id, "destination id");
+            CHECK(sameData(pXml[i].pDest[j].pSdtPar, pImg[i].pDest[j].pSdtPar, sizeof(TRDP_SDT_PAR_T)),
+                  "destination SDT parameters");
+            CHECK(sameString(pXml[i].pDest[j].pUriUser, pImg[i].pDest[j].pUriUser), "destination URI user");
+            CHECK(sameString(pXml[i].pDest[j].pUriHost, pImg[i].pDest[j].pUriHost), "destination URI host");
+        }
+        for (j = 0u; (j < pXml[i].srcCnt) && (pXml[i].pSrc != NULL) && (pImg[i].pSrc != NULL); j++)
+        {
+            CHECK(pXml[i].pSrc[j].id == pImg[i].pSrc[j].id, "source id");
+            CHECK(sameData(pXml[i].pSrc[j].pSdtPar, pImg[i].pSrc[j].pSdtPar, sizeof(TRDP_SDT_PAR_T)),
+                  "source SDT parameters");
+            CHECK(sameString(pXml[i].pSrc[j].pUriUser, pImg[i].pSrc[j].pUriUser), "source URI user");
+            CHECK(sameString(pXml[i].pSrc[j].pUriHost1, pImg[i].pSrc[j].pUriHost1), "source URI host 1");
+            CHECK(sameString(pXml[i].pSrc[j].pUriHost2, pImg[i].pSrc[j].pUriHost2), "source URI host 2");
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+static void compareConfig (const TEST_CONFIG_T *pXml, const TEST_CONFIG_T *pImg)
+{
+    UINT32 i, j;
+
+    CHECK(pXml->memConfig.size == pImg->memConfig.size, "memory size");
+    CHECK(memcmp(pXml->memConfig.prealloc, pImg->memConfig.prealloc, sizeof(pXml->memConfig.prealloc)) == 0,
+          "memory prealloc");
+    CHECK(pXml->dbgConfig.option == pImg->dbgConfig.option, "debug option");
+    CHECK(pXml->dbgConfig.maxFileSize == pImg->dbgConfig.maxFileSize, "debug file size");
+    CHECK(strcmp(pXml->dbgConfig.fileName, pImg->dbgConfig.fileName) == 0, "debug file name");
+    CHECK(pXml->trafficStoreSize == pImg->trafficStoreSize, "traffic store size");
+    CHECK(pXml->numComPar == pImg->numComPar, "numComPar");
+    CHECK(sameData(pXml->pComPar, pImg->pComPar, pXml->numComPar * sizeof(TRDP_COM_PAR_T)), "com parameters");
+    CHECK(pXml->numIfConfig == pImg->numIfConfig, "numIfConfig");
+    CHECK(sameData(pXml->pIfConfig, pImg->pIfConfig, pXml->numIfConfig * sizeof(TRDP_IF_CONFIG_T)),
+          "interface parameters");
+    CHECK(pXml->numComId == pImg->numComId, "numComId");
+    CHECK(sameData(pXml->pComIdDsIdMap, pImg->pComIdDsIdMap, pXml->numComId * sizeof(TRDP_COMID_DSID_MAP_T)),
+          "ComId map");
+    CHECK(pXml->numDataset == pImg->numDataset, "numDataset");
+    for (i = 0u; (i < pXml->numDataset) && (i < pImg->numDataset); i++)
+    {
+        const TRDP_DATASET_T *pDsXml = pXml->apDataset[i];
+        const TRDP_DATASET_T *pDsImg = pImg->apDataset[i];
+
+        CHECK((pDsXml->id == pDsImg->id) && (pDsXml->numElement == pDsImg->numElement), "dataset");
+        for (j = 0u; (j < pDsXml->numElement) && (j < pDsImg->numElement); j++)
+        {
+            CHECK(pDsXml->pElement[j].type == pDsImg->pElement[j].type, "element type");
+            CHECK(pDsXml->pElement[j].size == pDsImg->pElement[j].size, "element size");
+            CHECK(pDsXml->pElement[j].scale == pDsImg->pElement[j].scale, "element scale");
+            CHECK(pDsXml->pElement[j].offset == pDsImg->pElement[j].offset, "element offset");
+            CHECK(sameString(pDsXml->pElement[j].name, pDsImg->pElement[j].name), "element name");
+            CHECK(sameString(pDsXml->pElement[j].unit, pDsImg->pElement[j].unit), "element unit");
+        }
+    }
+}
+
+/**********************************************************************************************************************/
+static TRDP_ERR_T readXml (const TRDP_XML_DOC_HANDLE_T *pDocHnd, TEST_CONFIG_T *pCfg)
+{
+    TRDP_ERR_T result;
+
+    memset(pCfg, 0, sizeof(*pCfg));
+    result = tau_readXmlDeviceConfig(pDocHnd, &pCfg->memConfig, &pCfg->dbgConfig, &pCfg->numComPar, &pCfg->pComPar,
+                                     &pCfg->numIfConfig, &pCfg->pIfConfig);
+    if (result == TRDP_NO_ERR)
+    {
+        result = tau_readXmlTrafficStoreConfig(pDocHnd, &pCfg->trafficStoreSize);
+    }
+    if (result == TRDP_NO_ERR)
+    {
+        result = tau_readXmlDatasetConfig(pDocHnd, &pCfg->numComId, &pCfg->pComIdDsIdMap, &pCfg->numDataset,
+                                          &pCfg->apDataset);
+    }
+    return result;
+}
+
+/**********************************************************************************************************************/
+static void freeXml (TEST_CONFIG_T *pCfg)
+{
+    if (pCfg->pComPar != NULL)
+    {
+        vos_memFree(pCfg->pComPar);
+    }
+    if (pCfg->pIfConfig != NULL)
+    {
+        vos_memFree(pCfg->pIfConfig);
+    }
+    tau_freeXmlDatasetConfig(pCfg->numComId, pCfg->pComIdDsIdMap, pCfg->numDataset, pCfg->apDataset);
+}
+
+/**********************************************************************************************************************/
+static TRDP_ERR_T readImage (const TRDP_CFG_IMAGE_HANDLE_T *pImgHnd, TEST_CONFIG_T *pCfg)
+{
+    TRDP_ERR_T result;
+
+    memset(pCfg, 0, sizeof(*pCfg));
+    result = tau_readCfgImageDeviceConfig(pImgHnd, &pCfg->memConfig, &pCfg->dbgConfig, &pCfg->numComPar,
+                                          &pCfg->pComPar, &pCfg->numIfConfig, &pCfg->pIfConfig);
+    if (result == TRDP_NO_ERR)
+    {
+        result = tau_readCfgImageTrafficStoreConfig(pImgHnd, &pCfg->trafficStoreSize);
+    }
+    if (result == TRDP_NO_ERR)
+    {
+        result = tau_readCfgImageDatasetConfig(pImgHnd, &pCfg->numComId, &pCfg->pComIdDsIdMap, &pCfg->numDataset,
+                                               &pCfg->apDataset);
+    }
+    return result;
+}
+
+/**********************************************************************************************************************/
+/* Complete start-up read of the configuration via XML, as done by an application */
+static TRDP_ERR_T startupXml (const char *pFileName)
+{
+    TRDP_XML_DOC_HANDLE_T   docHandle;
+    TEST_CONFIG_T           cfg;
+    TRDP_PROCESS_CONFIG_T   processConfig;
+    TRDP_PD_CONFIG_T        pdConfig;
+    TRDP_MD_CONFIG_T        mdConfig;
+    UINT32                  numExchgPar;
+    TRDP_EXCHG_PAR_T        *pExchgPar;
+    UINT32                  i;
+    TRDP_ERR_T              result = tau_prepareXmlDoc(pFileName, &docHandle);
+
+    if (result != TRDP_NO_ERR)
+    {
+        return result;
+    }
+    result = readXml(&docHandle, &cfg);
+    for (i = 0u; (result == TRDP_NO_ERR) && (i < cfg.numIfConfig); i++)
+    {
+        result = tau_readXmlInterfaceConfig(&docHandle, cfg.pIfConfig[i].ifName, &processConfig, &pdConfig,
+                                            &mdConfig, &numExchgPar, &pExchgPar);
+        if (result == TRDP_NO_ERR)
+        {
+            tau_freeTelegrams(numExchgPar, pExchgPar);
+        }
+    }
+    freeXml(&cfg);
+    tau_freeXmlDoc(&docHandle);
+    return result;
+}
+
+/**********************************************************************************************************************/
+/* Complete start-up read of the configuration via the image */
+static TRDP_ERR_T startupImage (const char *pImageFile)
+{
+    TRDP_CFG_IMAGE_HANDLE_T imgHandle;
+    TEST_CONFIG_T           cfg;
+    TRDP_PROCESS_CONFIG_T   processConfig;
+    TRDP_PD_CONFIG_T        pdConfig;
+    TRDP_MD_CONFIG_T        mdConfig;
+    UINT32                  numExchgPar;
+    TRDP_EXCHG_PAR_T        *pExchgPar;
+    UINT32                  i;
+    TRDP_ERR_T              result = tau_loadCfgImage(pImageFile, &imgHandle);
+
+    if (result != TRDP_NO_ERR)
+    {
+        return result;
+    }
+    result = readImage(&imgHandle, &cfg);
+    for (i = 0u; (result == TRDP_NO_ERR) && (i < cfg.numIfConfig); i++)
+    {
+        result = tau_readCfgImageInterfaceConfig(&imgHandle, cfg.pIfConfig[i].ifName, &processConfig, &pdConfig,
+                                                 &mdConfig, &numExchgPar, &pExchgPar);
+    }
+    tau_freeCfgImage(&imgHandle);
+    return result;
+}
+
+/**********************************************************************************************************************/
+/* A copy of the image with one byte changed must not load */
+static void checkCorruption (const char *pImageFile)
+{
+    TRDP_CFG_IMAGE_HANDLE_T imgHandle;
+    const char              *pCopy = TEST_IMAGE_FILE ".bad";
+    FILE                    *pFile;
+    UINT8                   *pBuf;
+    long                    size;
+
+    pFile = fopen(pImageFile, "rb");
+    if ((pFile == NULL) || (fseek(pFile, 0L, SEEK_END) != 0) || ((size = ftell(pFile)) <= 64L))
+    {
+        printf("  image not readable\n");
+        gErrors++;
+        if (pFile != NULL)
+        {
+            (void) fclose(pFile);
+        }
+        return;
+    }
+    rewind(pFile);
+    pBuf = (UINT8 *) malloc((size_t) size);
+    if ((pBuf == NULL) || (fread(pBuf, 1u, (size_t) size, pFile) != (size_t) size))
+    {
+        printf("  image not readable\n");
+        gErrors++;
+        (void) fclose(pFile);
+        free(pBuf);
+        return;
+    }
+    (void) fclose(pFile);
+
+    pBuf[size / 2] ^= 0x10u;
+    pFile = fopen(pCopy, "wb");
+    if (pFile != NULL)
+    {
+        (void) fwrite(pBuf, 1u, (size_t) size, pFile);
+        (void) fclose(pFile);
+    }
+    CHECK(tau_loadCfgImage(pCopy, &imgHandle) == TRDP_CRC_ERR, "corrupted image not detected");
+
+    /* truncated image */
+    pFile = fopen(pCopy, "wb");
+    if (pFile != NULL)
+    {
+        (void) fwrite(pBuf, 1u, (size_t) size - 8u, pFile);
+        (void) fclose(pFile);
+    }
+    CHECK(tau_loadCfgImage(pCopy, &imgHandle) == TRDP_PARAM_ERR, "truncated image not detected");
+    (void) remove(pCopy);
+    free(pBuf);
+}
+
+/***********************************************************************************************************************
+    Test configuration image
+***********************************************************************************************************************/
+int main (int argc, char *argv[])
+{
+    TRDP_XML_DOC_HANDLE_T   docHandle;
+    TRDP_CFG_IMAGE_HANDLE_T imgHandle;
+    TEST_CONFIG_T           xmlCfg;
+    TEST_CONFIG_T           imgCfg;
+    const char              *pImageFile = TEST_IMAGE_FILE;
+    UINT32                  i;
+    UINT64                  start, xmlTime, imgTime;
+
+    printf("TRDP configuration image test program\n");
+    if ((argc != 2) && (argc != 3))
+    {
+        printf("usage: %s <xmlfilename> [imagefilename]\n", argv[0]);
+        return 1;
+    }
+    if (argc == 3)
+    {
+        pImageFile = argv[2];
+    }
+
+    if (tau_prepareXmlDoc(argv[1], &docHandle) != TRDP_NO_ERR)
+    {
+        printf("Failed to parse XML document\n");
+        return 1;
+    }
+    if (tau_buildCfgImage(&docHandle, pImageFile) != TRDP_NO_ERR)
+    {
+        printf("Failed to build configuration image\n");
+        return 1;
+    }
+    if (tau_loadCfgImage(pImageFile, &imgHandle) != TRDP_NO_ERR)
+    {
+        printf("Failed to load configuration image\n");
+        return 1;
+    }
+
+    /*  Device and dataset configuration    */
+    if ((readXml(&docHandle, &xmlCfg) != TRDP_NO_ERR) || (readImage(&imgHandle, &imgCfg) != TRDP_NO_ERR))
+    {
+        printf("Failed to read configuration\n");
+        return 1;
+    }
+    compareConfig(&xmlCfg, &imgCfg);
+
+    /*  Interfaces and telegrams    */
+    for (i = 0u; i < xmlCfg.numIfConfig; i++)
+    {
+        TRDP_PROCESS_CONFIG_T   processXml, processImg;
+        TRDP_PD_CONFIG_T        pdXml, pdImg;
+        TRDP_MD_CONFIG_T        mdXml, mdImg;
+        UINT32                  numXml = 0u, numImg = 0u;
+        TRDP_EXCHG_PAR_T        *pXml = NULL, *pImg = NULL;
+
+        memset(&processXml, 0, sizeof(processXml));
+        memset(&processImg, 0, sizeof(processImg));
+        memset(&pdXml, 0, sizeof(pdXml));
+        memset(&pdImg, 0, sizeof(pdImg));
+        memset(&mdXml, 0, sizeof(mdXml));
+        memset(&mdImg, 0, sizeof(mdImg));
+        CHECK(tau_readXmlInterfaceConfig(&docHandle, xmlCfg.pIfConfig[i].ifName, &processXml, &pdXml, &mdXml,
+                                         &numXml, &pXml) == TRDP_NO_ERR, "XML interface");
+        CHECK(tau_readCfgImageInterfaceConfig(&imgHandle, xmlCfg.pIfConfig[i].ifName, &processImg, &pdImg, &mdImg,
+                                              &numImg, &pImg) == TRDP_NO_ERR, "image interface");
+        CHECK(memcmp(&processXml, &processImg, sizeof(processXml)) == 0, "process configuration");
+        CHECK(memcmp(&pdXml, &pdImg, sizeof(pdXml)) == 0, "PD configuration");
+        CHECK(memcmp(&mdXml, &mdImg, sizeof(mdXml)) == 0, "MD configuration");
+        CHECK(numXml == numImg, "number of telegrams");
+        if ((numXml == numImg) && (pXml != NULL) && (pImg != NULL))
+        {
+            compareTelegrams(numXml, pXml, pImg);
+        }
+        printf("  interface %s: %u telegrams\n", xmlCfg.pIfConfig[i].ifName, numImg);
+        tau_freeTelegrams(numXml, pXml);
+    }
+    {
+        UINT32              numExchgPar;
+        TRDP_EXCHG_PAR_T    *pExchgPar;
+
+        CHECK(tau_readCfgImageInterfaceConfig(&imgHandle, "no-such-if", NULL, NULL, NULL, &numExchgPar,
+                                              &pExchgPar) == TRDP_PARAM_ERR, "unknown interface accepted");
+    }
+    printf("  %u com parameters, %u datasets, %u ComId mappings\n",
+           imgCfg.numComPar, imgCfg.numDataset, imgCfg.numComId);
+
+    freeXml(&xmlCfg);
+    tau_freeCfgImage(&imgHandle);
+    tau_freeXmlDoc(&docHandle);
+
+    checkCorruption(pImageFile);
+
+    /*  Start-up time   */
+    start = nowUs();
+    for (i = 0u; i < TEST_LOOPS; i++)
+    {
+        CHECK(startupXml(argv[1]) == TRDP_NO_ERR, "XML start-up");
+    }
+    xmlTime = nowUs() - start;
+    start   = nowUs();
+    for (i = 0u; i < TEST_LOOPS; i++)
+    {
+        CHECK(startupImage(pImageFile) == TRDP_NO_ERR, "image start-up");
+    }
+    imgTime = nowUs() - start;
+    printf("  configuration read: XML %.1f us, image %.1f us\n",
+           (double) xmlTime / TEST_LOOPS, (double) imgTime / TEST_LOOPS);
+
+    if (argc == 2)
+    {
+        (void) remove(pImageFile);
+    }
+    printf("%s\n", (gErrors == 0u) ? "Configuration image test: Success" : "Configuration image test: FAILED");
+    return (gErrors == 0u) ? 0 : 1;
+}
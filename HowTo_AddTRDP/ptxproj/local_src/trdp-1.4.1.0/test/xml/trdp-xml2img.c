@@ -0,0 +1,79 @@
+/**********************************************************************************************************************/
+/**
+ * @file            trdp-xml2img.c
+ *
+ * @brief           Precompile an XML configuration into a binary configuration image
+ *
+ * @details         Reads the XML configuration file with the tau_xml functions and writes the image with
+ *                  tau_buildCfgImage. The image is loaded again to check it before the tool returns.
+ *                  The tool has to be built for the target (byte order, pointer size and stack version), images
+ *                  of other builds are rejected by tau_loadCfgImage.
+ *
+ * @note            Project: TCNOpen TRDP prototype stack
+ *
+ * @author          Bernd Loehr, NewTec GmbH
+ *
+ * @remarks This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0.
+ *          If a copy of the MPL was not distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *          Copyright NewTec GmbH, 2026. All rights reserved.
+ *
+ * $Id$
+ *
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <stdlib.h>
+#include "tau_xml.h"
+#include "tau_cfgimg.h"
+
+/***********************************************************************************************************************
+    Build configuration image
+***********************************************************************************************************************/
+int main (int argc, char *argv[])
+{
+    TRDP_XML_DOC_HANDLE_T   docHandle;
+    TRDP_CFG_IMAGE_HANDLE_T imgHandle;
+    TRDP_COM_PAR_T          *pComPar;
+    TRDP_IF_CONFIG_T        *pIfConfig;
+    UINT32                  numComPar;
+    UINT32                  numIfConfig;
+    UINT32                  numComId;
+    TRDP_COMID_DSID_MAP_T   *pComIdDsIdMap;
+    UINT32                  numDataset;
+    apTRDP_DATASET_T        apDataset;
+    TRDP_ERR_T              result;
+
+    if (argc != 3)
+    {
+        printf("usage: %s <xmlfilename> <imagefilename>\n", argv[0]);
+        return 1;
+    }
+
+    result = tau_prepareXmlDoc(argv[1], &docHandle);
+    if (result != TRDP_NO_ERR)
+    {
+        printf("Failed to parse XML document %s\n", argv[1]);
+        return 1;
+    }
+    result = tau_buildCfgImage(&docHandle, argv[2]);
+    tau_freeXmlDoc(&docHandle);
+    if (result != TRDP_NO_ERR)
+    {
+        printf("Failed to build configuration image %s (%d)\n", argv[2], result);
+        return 1;
+    }
+
+    result = tau_loadCfgImage(argv[2], &imgHandle);
+    if (result != TRDP_NO_ERR)
+    {
+        printf("Configuration image %s not loadable (%d)\n", argv[2], result);
+        return 1;
+    }
+    (void) tau_readCfgImageDeviceConfig(&imgHandle, NULL, NULL, &numComPar, &pComPar, &numIfConfig, &pIfConfig);
+    (void) tau_readCfgImageDatasetConfig(&imgHandle, &numComId, &pComIdDsIdMap, &numDataset, &apDataset);
+    printf("%s: %u com parameters, %u interfaces, %u datasets, %u ComId mappings\n",
+           argv[2], numComPar, numIfConfig, numDataset, numComId);
+    tau_freeCfgImage(&imgHandle);
+    return 0;
+}